@@ -1409,6 +1409,20 @@ struct RTC_EXPORT PeerConnectionFactoryDependencies final {
   rtc::Thread* network_thread = nullptr;
   rtc::Thread* worker_thread = nullptr;
   rtc::Thread* signaling_thread = nullptr;
+  // Number of network threads created by the factory when `network_thread` is
+  // null. Each PeerConnection runs its transports on one of them, so that
+  // packet processing for many PeerConnections can use several cores. Values
+  // above 1 are ignored if `socket_factory`, `packet_socket_factory`,
+  // `network_manager` or `sctp_factory` is set, since those are bound to a
+  // single thread.
+  int num_network_threads = 1;
+  // Number of ECDSA and RSA certificates the factory keeps generated ahead of
+  // time for PeerConnections created without a certificate or
+  // `cert_generator`, so that they do not wait for key generation. Zero
+  // disables pooling for that key type. The pool is refilled in the
+  // background on the network thread.
+  int certificate_pool_size = 0;
+  int rsa_certificate_pool_size = 0;
   rtc::SocketFactory* socket_factory = nullptr;
   // The `packet_socket_factory` will only be used if CreatePeerConnection is
   // called without a `port_allocator`.
@@ -48,6 +48,7 @@
 #include "logging/rtc_event_log/events/rtc_event_video_send_stream_config.h"
 #include "logging/rtc_event_log/rtc_stream_config.h"
 #include "modules/congestion_controller/include/receive_side_congestion_controller.h"
+#include "modules/congestion_controller/include/transport_feedback_coalescer.h"
 #include "modules/rtp_rtcp/include/flexfec_receiver.h"
 #include "modules/rtp_rtcp/include/rtp_header_extension_map.h"
 #include "modules/rtp_rtcp/source/byte_io.h"
@@ -133,6 +134,17 @@ TaskQueueBase* GetCurrentTaskQueueOrThread() {
   return current;
 }
 
+RtpTransportFeedbackGenerator::RtcpSender FeedbackSender(
+    PacketRouter* packet_router,
+    TransportFeedbackCoalescer* coalescer) {
+  RtpTransportFeedbackGenerator::RtcpSender feedback_sender =
+      absl::bind_front(&PacketRouter::SendCombinedRtcpPacket, packet_router);
+  if (coalescer) {
+    return coalescer->WrapFeedbackSender(std::move(feedback_sender));
+  }
+  return feedback_sender;
+}
+
 }  // namespace
 
 namespace internal {
@@ -667,8 +679,8 @@ Call::Call(const CallConfig& config,
       receive_stats_(&env_.clock()),
       send_stats_(&env_.clock()),
       receive_side_cc_(env_,
-                       absl::bind_front(&PacketRouter::SendCombinedRtcpPacket,
-                                        transport_send->packet_router()),
+                       FeedbackSender(transport_send->packet_router(),
+                                      config.transport_feedback_coalescer),
                        absl::bind_front(&PacketRouter::SendRemb,
                                         transport_send->packet_router()),
                        /*network_state_estimator=*/nullptr),
@@ -691,11 +703,17 @@ Call::Call(const CallConfig& config,
 
   call_stats_->RegisterStatsObserver(&receive_side_cc_);
 
-  ReceiveSideCongestionController* receive_side_cc = &receive_side_cc_;
-  receive_side_cc_periodic_task_ = RepeatingTaskHandle::Start(
-      worker_thread_,
-      [receive_side_cc] { return receive_side_cc->MaybeProcess(); },
-      TaskQueueBase::DelayPrecision::kLow, &env_.clock());
+  if (config_.transport_feedback_coalescer) {
+    RTC_DCHECK_EQ(config_.transport_feedback_coalescer->task_queue(),
+                  worker_thread_);
+    config_.transport_feedback_coalescer->AddController(&receive_side_cc_);
+  } else {
+    ReceiveSideCongestionController* receive_side_cc = &receive_side_cc_;
+    receive_side_cc_periodic_task_ = RepeatingTaskHandle::Start(
+        worker_thread_,
+        [receive_side_cc] { return receive_side_cc->MaybeProcess(); },
+        TaskQueueBase::DelayPrecision::kLow, &env_.clock());
+  }
 }
 
 Call::~Call() {
@@ -707,6 +725,9 @@ Call::~Call() {
   RTC_CHECK(audio_receive_streams_.empty());
   RTC_CHECK(video_receive_streams_.empty());
 
+  if (config_.transport_feedback_coalescer) {
+    config_.transport_feedback_coalescer->RemoveController(&receive_side_cc_);
+  }
   receive_side_cc_periodic_task_.Stop();
   call_stats_->DeregisterStatsObserver(&receive_side_cc_);
   send_stats_.SetFirstPacketTime(transport_send_->GetFirstPacketTime());
@@ -1032,8 +1053,8 @@ FlexfecReceiveStream* Call::CreateFlexfecReceiveStream(
   // OnRtpPacket until the constructor is finished and the object is
   // in a valid state, since OnRtpPacket runs on the same thread.
   FlexfecReceiveStreamImpl* receive_stream = new FlexfecReceiveStreamImpl(
-      &env_.clock(), std::move(config), &video_receiver_controller_,
-      call_stats_->AsRtcpRttStats());
+      &env_.clock(), env_.field_trials(), std::move(config),
+      &video_receiver_controller_, call_stats_->AsRtcpRttStats());
 
   // TODO(bugs.webrtc.org/11993): Set this up asynchronously on the network
   // thread.
@@ -24,6 +24,8 @@
 namespace webrtc {
 
 class AudioProcessing;
+class SharedPacer;
+class TransportFeedbackCoalescer;
 
 struct CallConfig {
   // If `network_task_queue` is set to nullptr, Call will assume that network
@@ -71,9 +73,19 @@ struct CallConfig {
   Metronome* decode_metronome = nullptr;
   Metronome* encode_metronome = nullptr;
 
+  // Sends the receive side feedback of this call together with that of other
+  // calls sharing the coalescer, which must run on the worker thread of all of
+  // them and outlive them. If null, the call sends feedback on its own.
+  TransportFeedbackCoalescer* transport_feedback_coalescer = nullptr;
+
   // The burst interval of the pacer, see TaskQueuePacedSender constructor.
   absl::optional<TimeDelta> pacer_burst_interval;
 
+  // Paces the packets of this call from the same timer as those of other calls
+  // sharing the pacer, which must run on the worker thread of all of them and
+  // outlive them. If null, the call runs a pacer timer of its own.
+  SharedPacer* shared_pacer = nullptr;
+
   // Enables send packet batching from the egress RTP sender.
   bool enable_send_packet_batching = false;
 };
@@ -18,9 +18,11 @@
 
 #include "api/array_view.h"
 #include "api/call/transport.h"
+#include "api/field_trials_view.h"
 #include "api/rtp_parameters.h"
 #include "call/rtp_stream_receiver_controller_interface.h"
 #include "modules/rtp_rtcp/include/flexfec_receiver.h"
+#include "modules/rtp_rtcp/include/reed_solomon_fec_receiver.h"
 #include "modules/rtp_rtcp/source/rtp_packet_received.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
@@ -60,16 +62,14 @@ bool FlexfecReceiveStream::Config::IsCompleteAndEnabled() const {
 
 namespace {
 
+// Returns true if a receiver can be created for `config`.
 // TODO(brandtr): Update this function when we support multistream protection.
-std::unique_ptr<FlexfecReceiver> MaybeCreateFlexfecReceiver(
-    Clock* clock,
-    const FlexfecReceiveStream::Config& config,
-    RecoveredPacketReceiver* recovered_packet_receiver) {
+bool IsSupportedConfig(const FlexfecReceiveStream::Config& config) {
   if (config.payload_type < 0) {
     RTC_LOG(LS_WARNING)
         << "Invalid FlexFEC payload type given. "
            "This FlexfecReceiveStream will therefore be useless.";
-    return nullptr;
+    return false;
   }
   RTC_DCHECK_GE(config.payload_type, 0);
   RTC_DCHECK_LE(config.payload_type, 127);
@@ -77,13 +77,13 @@ std::unique_ptr<FlexfecReceiver> MaybeCreateFlexfecReceiver(
     RTC_LOG(LS_WARNING)
         << "Invalid FlexFEC SSRC given. "
            "This FlexfecReceiveStream will therefore be useless.";
-    return nullptr;
+    return false;
   }
   if (config.protected_media_ssrcs.empty()) {
     RTC_LOG(LS_WARNING)
         << "No protected media SSRC supplied. "
            "This FlexfecReceiveStream will therefore be useless.";
-    return nullptr;
+    return false;
   }
 
   if (config.protected_media_ssrcs.size() > 1) {
@@ -92,14 +92,44 @@ std::unique_ptr<FlexfecReceiver> MaybeCreateFlexfecReceiver(
            "media streams, but our implementation currently only "
            "supports protecting a single media stream. "
            "To avoid confusion, disabling FlexFEC completely.";
-    return nullptr;
+    return false;
   }
   RTC_DCHECK_EQ(1U, config.protected_media_ssrcs.size());
+  return true;
+}
+
+// The sender sends Reed-Solomon FEC packets instead of FlexFEC ones when it
+// has the same trial enabled.
+bool UseReedSolomonFec(const FieldTrialsView& field_trials) {
+  return field_trials.IsEnabled("WebRTC-ReedSolomonFec");
+}
+
+std::unique_ptr<FlexfecReceiver> MaybeCreateFlexfecReceiver(
+    Clock* clock,
+    const FieldTrialsView& field_trials,
+    const FlexfecReceiveStream::Config& config,
+    RecoveredPacketReceiver* recovered_packet_receiver) {
+  if (UseReedSolomonFec(field_trials) || !IsSupportedConfig(config)) {
+    return nullptr;
+  }
   return std::unique_ptr<FlexfecReceiver>(new FlexfecReceiver(
       clock, config.rtp.remote_ssrc, config.protected_media_ssrcs[0],
       recovered_packet_receiver));
 }
 
+std::unique_ptr<ReedSolomonFecReceiver> MaybeCreateReedSolomonFecReceiver(
+    Clock* clock,
+    const FieldTrialsView& field_trials,
+    const FlexfecReceiveStream::Config& config,
+    RecoveredPacketReceiver* recovered_packet_receiver) {
+  if (!UseReedSolomonFec(field_trials) || !IsSupportedConfig(config)) {
+    return nullptr;
+  }
+  return std::make_unique<ReedSolomonFecReceiver>(
+      clock, config.rtp.remote_ssrc, config.protected_media_ssrcs[0],
+      recovered_packet_receiver);
+}
+
 std::unique_ptr<ModuleRtpRtcpImpl2> CreateRtpRtcpModule(
     Clock* clock,
     ReceiveStatistics* receive_statistics,
@@ -120,13 +150,21 @@ std::unique_ptr<ModuleRtpRtcpImpl2> CreateRtpRtcpModule(
 
 FlexfecReceiveStreamImpl::FlexfecReceiveStreamImpl(
     Clock* clock,
+    const FieldTrialsView& field_trials,
     Config config,
     RecoveredPacketReceiver* recovered_packet_receiver,
     RtcpRttStats* rtt_stats)
     : remote_ssrc_(config.rtp.remote_ssrc),
       payload_type_(config.payload_type),
-      receiver_(
-          MaybeCreateFlexfecReceiver(clock, config, recovered_packet_receiver)),
+      receiver_(MaybeCreateFlexfecReceiver(clock,
+                                           field_trials,
+                                           config,
+                                           recovered_packet_receiver)),
+      reed_solomon_receiver_(
+          MaybeCreateReedSolomonFecReceiver(clock,
+                                            field_trials,
+                                            config,
+                                            recovered_packet_receiver)),
       rtp_receive_statistics_(ReceiveStatistics::Create(clock)),
       rtp_rtcp_(CreateRtpRtcpModule(clock,
                                     rtp_receive_statistics_.get(),
@@ -150,7 +188,7 @@ void FlexfecReceiveStreamImpl::RegisterWithTransport(
   RTC_DCHECK_RUN_ON(&packet_sequence_checker_);
   RTC_DCHECK(!rtp_stream_receiver_);
 
-  if (!receiver_)
+  if (!receiver_ && !reed_solomon_receiver_)
     return;
 
   // TODO(nisse): OnRtpPacket in this class delegates all real work to
@@ -168,10 +206,13 @@ void FlexfecReceiveStreamImpl::UnregisterFromTransport() {
 
 void FlexfecReceiveStreamImpl::OnRtpPacket(const RtpPacketReceived& packet) {
   RTC_DCHECK_RUN_ON(&packet_sequence_checker_);
-  if (!receiver_)
+  if (receiver_) {
+    receiver_->OnRtpPacket(packet);
+  } else if (reed_solomon_receiver_) {
+    reed_solomon_receiver_->OnRtpPacket(packet);
+  } else {
     return;
-
-  receiver_->OnRtpPacket(packet);
+  }
 
   // Do not report media packets in the RTCP RRs generated by `rtp_rtcp_`.
   if (packet.Ssrc() == remote_ssrc()) {
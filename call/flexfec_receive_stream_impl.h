@@ -22,9 +22,11 @@
 
 namespace webrtc {
 
+class FieldTrialsView;
 class FlexfecReceiver;
 class ReceiveStatistics;
 class RecoveredPacketReceiver;
+class ReedSolomonFecReceiver;
 class RtcpRttStats;
 class RtpPacketReceived;
 class RtpRtcp;
@@ -33,7 +35,10 @@ class RtpStreamReceiverInterface;
 
 class FlexfecReceiveStreamImpl : public FlexfecReceiveStream {
  public:
+  // With the "WebRTC-ReedSolomonFec" field trial, the stream expects the FEC
+  // packets of ReedSolomonFecSender instead of FlexFEC ones.
   FlexfecReceiveStreamImpl(Clock* clock,
+                           const FieldTrialsView& field_trials,
                            Config config,
                            RecoveredPacketReceiver* recovered_packet_receiver,
                            RtcpRttStats* rtt_stats);
@@ -83,8 +88,9 @@ class FlexfecReceiveStreamImpl : public FlexfecReceiveStream {
   // disabled.
   int payload_type_ RTC_GUARDED_BY(packet_sequence_checker_) = -1;
 
-  // Erasure code interfacing.
+  // Erasure code interfacing. At most one of these is set.
   const std::unique_ptr<FlexfecReceiver> receiver_;
+  const std::unique_ptr<ReedSolomonFecReceiver> reed_solomon_receiver_;
 
   // RTCP reporting.
   const std::unique_ptr<ReceiveStatistics> rtp_receive_statistics_;
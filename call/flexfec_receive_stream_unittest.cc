@@ -14,19 +14,24 @@
 #include <memory>
 #include <vector>
 
+#include "absl/strings/string_view.h"
 #include "api/array_view.h"
 #include "api/call/transport.h"
 #include "api/rtp_headers.h"
 #include "api/rtp_parameters.h"
 #include "call/flexfec_receive_stream_impl.h"
 #include "call/rtp_stream_receiver_controller.h"
+#include "modules/rtp_rtcp/include/reed_solomon_fec_sender.h"
 #include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
 #include "modules/rtp_rtcp/mocks/mock_recovered_packet_receiver.h"
 #include "modules/rtp_rtcp/mocks/mock_rtcp_rtt_stats.h"
 #include "modules/rtp_rtcp/source/byte_io.h"
 #include "modules/rtp_rtcp/source/rtp_header_extensions.h"
 #include "modules/rtp_rtcp/source/rtp_packet_received.h"
+#include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
 #include "rtc_base/thread.h"
+#include "system_wrappers/include/clock.h"
+#include "test/explicit_key_value_config.h"
 #include "test/gmock.h"
 #include "test/gtest.h"
 #include "test/mock_transport.h"
@@ -36,6 +41,7 @@ namespace webrtc {
 namespace {
 
 using ::testing::_;
+using ::testing::AllOf;
 using ::testing::Eq;
 using ::testing::Property;
 
@@ -85,17 +91,19 @@ TEST(FlexfecReceiveStreamConfigTest, IsCompleteAndEnabled) {
 
 class FlexfecReceiveStreamTest : public ::testing::Test {
  protected:
-  FlexfecReceiveStreamTest()
-      : config_(CreateDefaultConfig(&rtcp_send_transport_)) {
+  explicit FlexfecReceiveStreamTest(absl::string_view field_trials = "")
+      : field_trials_(field_trials),
+        config_(CreateDefaultConfig(&rtcp_send_transport_)) {
     receive_stream_ = std::make_unique<FlexfecReceiveStreamImpl>(
-        Clock::GetRealTimeClock(), config_, &recovered_packet_receiver_,
-        &rtt_stats_);
+        Clock::GetRealTimeClock(), field_trials_, config_,
+        &recovered_packet_receiver_, &rtt_stats_);
     receive_stream_->RegisterWithTransport(&rtp_stream_receiver_controller_);
   }
 
   ~FlexfecReceiveStreamTest() { receive_stream_->UnregisterFromTransport(); }
 
   rtc::AutoThread main_thread_;
+  test::ExplicitKeyValueConfig field_trials_;
   MockTransport rtcp_send_transport_;
   FlexfecReceiveStream::Config config_;
   MockRecoveredPacketReceiver recovered_packet_receiver_;
@@ -151,4 +159,45 @@ TEST_F(FlexfecReceiveStreamTest, RecoversPacket) {
   receive_stream_->UnregisterFromTransport();
 }
 
+class ReedSolomonFlexfecReceiveStreamTest : public FlexfecReceiveStreamTest {
+ protected:
+  ReedSolomonFlexfecReceiveStreamTest()
+      : FlexfecReceiveStreamTest("WebRTC-ReedSolomonFec/Enabled/") {}
+};
+
+TEST_F(ReedSolomonFlexfecReceiveStreamTest, RecoversPacket) {
+  constexpr uint8_t kMediaPlType = 107;
+  constexpr uint16_t kMediaSeqNum = 2;
+  const uint32_t media_ssrc = config_.protected_media_ssrcs[0];
+  SimulatedClock clock(1);
+  ReedSolomonFecSender sender(kFlexfecPlType, config_.rtp.remote_ssrc,
+                              media_ssrc, /*mid=*/"",
+                              /*rtp_header_extensions=*/{},
+                              /*extension_sizes=*/{}, /*rtp_state=*/nullptr,
+                              &clock);
+  FecProtectionParams params;
+  params.fec_rate = 255;
+  params.max_fec_frames = 1;
+  params.fec_mask_type = kFecMaskBursty;
+  sender.SetProtectionParameters(params, params);
+
+  RtpPacketToSend media_packet(nullptr);
+  media_packet.SetPayloadType(kMediaPlType);
+  media_packet.SetSequenceNumber(kMediaSeqNum);
+  media_packet.SetSsrc(media_ssrc);
+  media_packet.SetMarker(true);
+  media_packet.AllocatePayload(4);
+  sender.AddPacketAndGenerateFec(media_packet);
+  std::vector<std::unique_ptr<RtpPacketToSend>> fec_packets =
+      sender.GetFecPackets();
+  ASSERT_FALSE(fec_packets.empty());
+
+  // The media packet is lost and recovered from the FEC packet.
+  EXPECT_CALL(recovered_packet_receiver_,
+              OnRecoveredPacket(AllOf(
+                  Property(&RtpPacketReceived::SequenceNumber, kMediaSeqNum),
+                  Property(&RtpPacketReceived::payload_size, Eq(4u)))));
+  receive_stream_->OnRtpPacket(ParsePacket(fec_packets[0]->Buffer()));
+}
+
 }  // namespace webrtc
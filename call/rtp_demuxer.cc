@@ -151,7 +151,7 @@ bool RtpDemuxer::AddSink(const RtpDemuxerCriteria& criteria,
   }
 
   for (uint32_t ssrc : criteria.ssrcs()) {
-    sink_by_ssrc_.emplace(ssrc, sink);
+    sink_by_ssrc_.Emplace(ssrc, sink);
   }
 
   for (uint8_t payload_type : criteria.payload_types()) {
@@ -159,6 +159,7 @@ bool RtpDemuxer::AddSink(const RtpDemuxerCriteria& criteria,
   }
 
   RefreshKnownMids();
+  last_sink_ = nullptr;
 
   RTC_DLOG(LS_INFO) << "Added sink = " << sink << " for criteria "
                     << criteria.ToString();
@@ -205,11 +206,11 @@ bool RtpDemuxer::CriteriaWouldConflict(
   }
 
   for (uint32_t ssrc : criteria.ssrcs()) {
-    const auto sink_by_ssrc = sink_by_ssrc_.find(ssrc);
-    if (sink_by_ssrc != sink_by_ssrc_.end()) {
+    RtpPacketSinkInterface* const* sink_by_ssrc = sink_by_ssrc_.Find(ssrc);
+    if (sink_by_ssrc != nullptr) {
       RTC_LOG(LS_INFO) << criteria.ToString()
                        << " would conflict with existing sink = "
-                       << sink_by_ssrc->second << " binding by SSRC=" << ssrc;
+                       << *sink_by_ssrc << " binding by SSRC=" << ssrc;
       return true;
     }
   }
@@ -246,12 +247,17 @@ void RtpDemuxer::AddSink(absl::string_view rsid, RtpPacketSinkInterface* sink) {
 
 bool RtpDemuxer::RemoveSink(const RtpPacketSinkInterface* sink) {
   RTC_DCHECK(sink);
-  size_t num_removed = RemoveFromMapByValue(&sink_by_mid_, sink) +
-                       RemoveFromMapByValue(&sink_by_ssrc_, sink) +
-                       RemoveFromMultimapByValue(&sinks_by_pt_, sink) +
-                       RemoveFromMapByValue(&sink_by_mid_and_rsid_, sink) +
-                       RemoveFromMapByValue(&sink_by_rsid_, sink);
+  size_t num_removed =
+      RemoveFromMapByValue(&sink_by_mid_, sink) +
+      sink_by_ssrc_.EraseIf([&](uint32_t ssrc,
+                                RtpPacketSinkInterface* sink_by_ssrc) {
+        return sink_by_ssrc == sink;
+      }) +
+      RemoveFromMultimapByValue(&sinks_by_pt_, sink) +
+      RemoveFromMapByValue(&sink_by_mid_and_rsid_, sink) +
+      RemoveFromMapByValue(&sink_by_rsid_, sink);
   RefreshKnownMids();
+  last_sink_ = nullptr;
   return num_removed > 0;
 }
 
@@ -259,11 +265,12 @@ flat_set<uint32_t> RtpDemuxer::GetSsrcsForSink(
     const RtpPacketSinkInterface* sink) const {
   flat_set<uint32_t> ssrcs;
   if (sink) {
-    for (const auto& it : sink_by_ssrc_) {
-      if (it.second == sink) {
-        ssrcs.insert(it.first);
-      }
-    }
+    sink_by_ssrc_.ForEach(
+        [&](uint32_t ssrc, RtpPacketSinkInterface* sink_by_ssrc) {
+          if (sink_by_ssrc == sink) {
+            ssrcs.insert(ssrc);
+          }
+        });
   }
   return ssrcs;
 }
@@ -279,6 +286,33 @@ bool RtpDemuxer::OnRtpPacket(const RtpPacketReceived& packet) {
 
 RtpPacketSinkInterface* RtpDemuxer::ResolveSink(
     const RtpPacketReceived& packet) {
+  const uint32_t ssrc = packet.Ssrc();
+  const bool has_ids = (use_mid_ && packet.HasExtension<RtpMid>()) ||
+                       packet.HasExtension<RepairedRtpStreamId>() ||
+                       packet.HasExtension<RtpStreamId>();
+  if (!has_ids && last_sink_ != nullptr && ssrc == last_ssrc_) {
+    return last_sink_;
+  }
+
+  RtpPacketSinkInterface* sink = ResolveSinkUncached(packet);
+  if (has_ids) {
+    // The IDs may have been learned for the SSRC.
+    if (ssrc == last_ssrc_) {
+      last_sink_ = nullptr;
+    }
+  } else if (sink != nullptr) {
+    // Without IDs, the sink only depends on the SSRC once it is bound to it.
+    RtpPacketSinkInterface* const* sink_by_ssrc = sink_by_ssrc_.Find(ssrc);
+    if (sink_by_ssrc != nullptr && *sink_by_ssrc == sink) {
+      last_ssrc_ = ssrc;
+      last_sink_ = sink;
+    }
+  }
+  return sink;
+}
+
+RtpPacketSinkInterface* RtpDemuxer::ResolveSinkUncached(
+    const RtpPacketReceived& packet) {
   // See the BUNDLE spec for high level reference to this algorithm:
   // https://tools.ietf.org/html/draft-ietf-mmusic-sdp-bundle-negotiation-38#section-10.2
 
@@ -309,10 +343,7 @@ RtpPacketSinkInterface* RtpDemuxer::ResolveSink(
   } else {
     // If the packet does not include a MID header extension, check if there is
     // a latched MID for the SSRC.
-    const auto it = mid_by_ssrc_.find(ssrc);
-    if (it != mid_by_ssrc_.end()) {
-      mid = &it->second;
-    }
+    mid = mid_by_ssrc_.Find(ssrc);
   }
 
   std::string* rsid = nullptr;
@@ -322,10 +353,7 @@ RtpPacketSinkInterface* RtpDemuxer::ResolveSink(
   } else {
     // If the packet does not include an RRID/RSID header extension, check if
     // there is a latched RSID for the SSRC.
-    const auto it = rsid_by_ssrc_.find(ssrc);
-    if (it != rsid_by_ssrc_.end()) {
-      rsid = &it->second;
-    }
+    rsid = rsid_by_ssrc_.Find(ssrc);
   }
 
   // If MID and/or RSID is specified, prioritize that for demuxing the packet.
@@ -367,9 +395,9 @@ RtpPacketSinkInterface* RtpDemuxer::ResolveSink(
 
   // We trust signaled SSRC more than payload type which is likely to conflict
   // between streams.
-  const auto ssrc_sink_it = sink_by_ssrc_.find(ssrc);
-  if (ssrc_sink_it != sink_by_ssrc_.end()) {
-    return ssrc_sink_it->second;
+  RtpPacketSinkInterface* const* sink_by_ssrc = sink_by_ssrc_.Find(ssrc);
+  if (sink_by_ssrc != nullptr) {
+    return *sink_by_ssrc;
   }
 
   // Legacy senders will only signal payload type, support that as last resort.
@@ -436,16 +464,17 @@ void RtpDemuxer::AddSsrcSinkBinding(uint32_t ssrc,
     return;
   }
 
-  auto result = sink_by_ssrc_.emplace(ssrc, sink);
-  auto it = result.first;
-  bool inserted = result.second;
+  auto [sink_by_ssrc, inserted] = sink_by_ssrc_.Emplace(ssrc, sink);
   if (inserted) {
     RTC_DLOG(LS_INFO) << "Added sink = " << sink
                       << " binding with SSRC=" << ssrc;
-  } else if (it->second != sink) {
+  } else if (*sink_by_ssrc != sink) {
     RTC_DLOG(LS_INFO) << "Updated sink = " << sink
                       << " binding with SSRC=" << ssrc;
-    it->second = sink;
+    *sink_by_ssrc = sink;
+    if (ssrc == last_ssrc_) {
+      last_sink_ = nullptr;
+    }
   }
 }
 
@@ -17,6 +17,7 @@
 #include <vector>
 
 #include "absl/strings/string_view.h"
+#include "call/ssrc_map.h"
 #include "rtc_base/containers/flat_map.h"
 #include "rtc_base/containers/flat_set.h"
 
@@ -168,6 +169,8 @@ class RtpDemuxer {
   // Will record any SSRC<->ID associations along the way.
   // If the packet should be dropped, this method returns null.
   RtpPacketSinkInterface* ResolveSink(const RtpPacketReceived& packet);
+  // As ResolveSink, without looking at the previous packet.
+  RtpPacketSinkInterface* ResolveSinkUncached(const RtpPacketReceived& packet);
 
   // Used by the ResolveSink algorithm.
   RtpPacketSinkInterface* ResolveSinkByMid(absl::string_view mid,
@@ -192,7 +195,7 @@ class RtpDemuxer {
   // SSRC mapping which receives all MID, payload type, or RSID to SSRC bindings
   // discovered when demuxing packets).
   flat_map<std::string, RtpPacketSinkInterface*> sink_by_mid_;
-  flat_map<uint32_t, RtpPacketSinkInterface*> sink_by_ssrc_;
+  SsrcMap<RtpPacketSinkInterface*> sink_by_ssrc_;
   std::multimap<uint8_t, RtpPacketSinkInterface*> sinks_by_pt_;
   flat_map<std::pair<std::string, std::string>, RtpPacketSinkInterface*>
       sink_by_mid_and_rsid_;
@@ -207,8 +210,14 @@ class RtpDemuxer {
   // received.
   // This is stored separately from the sink mappings because if a sink is
   // removed we want to still remember these associations.
-  flat_map<uint32_t, std::string> mid_by_ssrc_;
-  flat_map<uint32_t, std::string> rsid_by_ssrc_;
+  SsrcMap<std::string> mid_by_ssrc_;
+  SsrcMap<std::string> rsid_by_ssrc_;
+
+  // The sink the SSRC of the previous packet was resolved to, for when the
+  // next packet is of the same SSRC and has no MID or RSID, as is common.
+  // Reset by any change that could resolve that SSRC differently.
+  uint32_t last_ssrc_ = 0;
+  RtpPacketSinkInterface* last_sink_ = nullptr;
 
   // Adds a binding from the SSRC to the given sink.
   void AddSsrcSinkBinding(uint32_t ssrc, RtpPacketSinkInterface* sink);
@@ -0,0 +1,71 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <cstdint>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "call/rtp_demuxer.h"
+#include "call/rtp_packet_sink_interface.h"
+#include "modules/rtp_rtcp/source/rtp_packet_received.h"
+#include "rtc_base/random.h"
+
+namespace webrtc {
+namespace {
+
+constexpr int kNumStreams = 10000;
+constexpr int kNumPackets = 1 << 16;
+
+class CountingSink : public RtpPacketSinkInterface {
+ public:
+  void OnRtpPacket(const RtpPacketReceived& packet) override { ++num_packets; }
+
+  int num_packets = 0;
+};
+
+// Demuxes packets of 10000 streams, each bound to its own sink by SSRC. The
+// packets come in bursts of `state.range(0)` packets of a stream, as video
+// frames do, from streams in random order. Reports the time per packet.
+void BM_DemuxBySsrc(benchmark::State& state) {
+  const int burst_length = state.range(0);
+  Random random(0x1234);
+  RtpDemuxer demuxer;
+  std::vector<CountingSink> sinks(kNumStreams);
+  std::vector<uint32_t> ssrcs(kNumStreams);
+  for (int i = 0; i < kNumStreams; ++i) {
+    ssrcs[i] = random.Rand<uint32_t>();
+    demuxer.AddSink(ssrcs[i], &sinks[i]);
+  }
+
+  std::vector<RtpPacketReceived> packets(kNumPackets);
+  for (int i = 0; i < kNumPackets; i += burst_length) {
+    const uint32_t ssrc = ssrcs[random.Rand(kNumStreams - 1)];
+    for (int j = i; j < i + burst_length && j < kNumPackets; ++j) {
+      packets[j].SetSsrc(ssrc);
+      packets[j].SetSequenceNumber(j);
+    }
+  }
+
+  int i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(demuxer.OnRtpPacket(packets[i]));
+    i = (i + 1) % kNumPackets;
+  }
+  state.SetItemsProcessed(state.iterations());
+
+  for (CountingSink& sink : sinks) {
+    demuxer.RemoveSink(&sink);
+  }
+}
+
+BENCHMARK(BM_DemuxBySsrc)->Arg(1)->Arg(8);
+
+}  // namespace
+}  // namespace webrtc
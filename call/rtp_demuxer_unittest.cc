@@ -13,6 +13,7 @@
 #include <memory>
 #include <set>
 #include <string>
+#include <vector>
 
 #include "absl/strings/string_view.h"
 #include "call/test/mock_rtp_packet_sink_interface.h"
@@ -1238,6 +1239,68 @@ TEST_F(RtpDemuxerTest, PacketWithMidAndUnknownRsidIsNotRoutedByPayloadType) {
   EXPECT_FALSE(demuxer_.OnRtpPacket(*packet));
 }
 
+TEST_F(RtpDemuxerTest, RepeatedSsrcFollowsNewMidBinding) {
+  constexpr uint32_t ssrc = 10;
+  MockRtpPacketSink sink1;
+  MockRtpPacketSink sink2;
+  AddSinkOnlyMid("a", &sink1);
+  AddSinkOnlyMid("b", &sink2);
+
+  InSequence sequence;
+  auto packet1 = CreatePacketWithSsrcMid(ssrc, "a");
+  auto packet2 = CreatePacketWithSsrc(ssrc);
+  auto packet3 = CreatePacketWithSsrcMid(ssrc, "b");
+  auto packet4 = CreatePacketWithSsrc(ssrc);
+  EXPECT_CALL(sink1, OnRtpPacket(SamePacketAs(*packet1)));
+  EXPECT_CALL(sink1, OnRtpPacket(SamePacketAs(*packet2)));
+  EXPECT_CALL(sink2, OnRtpPacket(SamePacketAs(*packet3)));
+  EXPECT_CALL(sink2, OnRtpPacket(SamePacketAs(*packet4)));
+  EXPECT_TRUE(demuxer_.OnRtpPacket(*packet1));
+  EXPECT_TRUE(demuxer_.OnRtpPacket(*packet2));
+  EXPECT_TRUE(demuxer_.OnRtpPacket(*packet3));
+  EXPECT_TRUE(demuxer_.OnRtpPacket(*packet4));
+}
+
+TEST_F(RtpDemuxerTest, RepeatedSsrcDroppedAfterMidSinkRemoved) {
+  constexpr uint32_t ssrc = 10;
+  MockRtpPacketSink ssrc_sink;
+  MockRtpPacketSink mid_sink;
+  AddSinkOnlySsrc(ssrc, &ssrc_sink);
+  AddSinkOnlyMid("a", &mid_sink);
+
+  InSequence sequence;
+  auto packet1 = CreatePacketWithSsrcMid(ssrc, "a");
+  auto packet2 = CreatePacketWithSsrc(ssrc);
+  auto packet3 = CreatePacketWithSsrc(ssrc);
+  EXPECT_CALL(ssrc_sink, OnRtpPacket).Times(0);
+  EXPECT_CALL(mid_sink, OnRtpPacket(SamePacketAs(*packet1)));
+  EXPECT_CALL(mid_sink, OnRtpPacket(SamePacketAs(*packet2)));
+  EXPECT_TRUE(demuxer_.OnRtpPacket(*packet1));
+  EXPECT_TRUE(demuxer_.OnRtpPacket(*packet2));
+
+  // The MID stays latched to the SSRC, and no sink has it anymore.
+  RemoveSink(&mid_sink);
+  EXPECT_FALSE(demuxer_.OnRtpPacket(*packet3));
+}
+
+TEST_F(RtpDemuxerTest, ManySinksBySsrc) {
+  constexpr uint32_t kNumSinks = 5000;
+  std::vector<NiceMock<MockRtpPacketSink>> sinks(kNumSinks);
+  for (uint32_t i = 0; i < kNumSinks; ++i) {
+    ASSERT_TRUE(AddSinkOnlySsrc(i * 7919, &sinks[i]));
+  }
+  for (uint32_t i = 0; i < kNumSinks; i += 2) {
+    ASSERT_TRUE(RemoveSink(&sinks[i]));
+  }
+
+  for (uint32_t i = 0; i < kNumSinks; ++i) {
+    auto packet = CreatePacketWithSsrc(i * 7919);
+    EXPECT_CALL(sinks[i], OnRtpPacket).Times(i % 2);
+    EXPECT_EQ(demuxer_.OnRtpPacket(*packet), i % 2 == 1);
+    EXPECT_EQ(demuxer_.GetSsrcsForSink(&sinks[i]).size(), i % 2);
+  }
+}
+
 TEST_F(RtpDemuxerTest, MidMustNotExceedMaximumLength) {
   MockRtpPacketSink sink1;
   std::string mid1(BaseRtpStringExtension::kMaxValueSizeBytes + 1, 'a');
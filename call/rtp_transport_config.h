@@ -22,6 +22,8 @@
 
 namespace webrtc {
 
+class SharedPacer;
+
 struct RtpTransportConfig {
   Environment env;
 
@@ -38,6 +40,10 @@ struct RtpTransportConfig {
 
   // The burst interval of the pacer, see TaskQueuePacedSender constructor.
   absl::optional<TimeDelta> pacer_burst_interval;
+
+  // Schedules the pacer together with those of other transports, see
+  // TaskQueuePacedSender constructor. If null, the pacer runs on its own.
+  SharedPacer* shared_pacer = nullptr;
 };
 }  // namespace webrtc
 
@@ -80,7 +80,8 @@ RtpTransportControllerSend::RtpTransportControllerSend(
              &packet_router_,
              env_.field_trials(),
              TimeDelta::Millis(5),
-             3),
+             3,
+             config.shared_pacer),
       observer_(nullptr),
       controller_factory_override_(config.network_controller_factory),
       controller_factory_fallback_(
@@ -238,6 +239,10 @@ RtpPacketSender* RtpTransportControllerSend::packet_sender() {
   return &pacer_;
 }
 
+RtpPacketToSendPool* RtpTransportControllerSend::packet_pool() {
+  return &packet_pool_;
+}
+
 void RtpTransportControllerSend::SetAllocatedSendBitrateLimits(
     BitrateAllocationLimits limits) {
   RTC_DCHECK_RUN_ON(&sequence_checker_);
@@ -37,6 +37,7 @@
 #include "modules/pacing/rtp_packet_pacer.h"
 #include "modules/pacing/task_queue_paced_sender.h"
 #include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
+#include "modules/rtp_rtcp/source/rtp_packet_to_send_pool.h"
 #include "rtc_base/network_route.h"
 #include "rtc_base/race_checker.h"
 #include "rtc_base/task_utils/repeating_task.h"
@@ -78,6 +79,7 @@ class RtpTransportControllerSend final
 
   NetworkStateEstimateObserver* network_state_estimate_observer() override;
   RtpPacketSender* packet_sender() override;
+  RtpPacketToSendPool* packet_pool() override;
 
   void SetAllocatedSendBitrateLimits(BitrateAllocationLimits limits) override;
   void ReconfigureBandwidthEstimation(
@@ -151,6 +153,8 @@ class RtpTransportControllerSend final
   const Environment env_;
   SequenceChecker sequence_checker_;
   TaskQueueBase* task_queue_;
+  // Declared before the pacer and the RTP senders, which hold packets from it.
+  RtpPacketToSendPool packet_pool_;
   PacketRouter packet_router_;
 
   std::vector<std::unique_ptr<RtpVideoSenderInterface>> video_rtp_senders_
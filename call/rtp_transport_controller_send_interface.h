@@ -46,6 +46,7 @@ class Transport;
 class PacketRouter;
 class RtpVideoSenderInterface;
 class RtpPacketSender;
+class RtpPacketToSendPool;
 class RtpRtcpInterface;
 
 struct RtpSenderObservers {
@@ -117,6 +118,10 @@ class RtpTransportControllerSendInterface {
 
   virtual RtpPacketSender* packet_sender() = 0;
 
+  // Pool that the RTP modules sending through this transport recycle their
+  // outgoing packets with.
+  virtual RtpPacketToSendPool* packet_pool() = 0;
+
   // SetAllocatedSendBitrateLimits sets bitrates limits imposed by send codec
   // settings.
   virtual void SetAllocatedSendBitrateLimits(
@@ -25,6 +25,7 @@
 #include "api/video_codecs/video_codec.h"
 #include "call/rtp_transport_controller_send_interface.h"
 #include "modules/pacing/packet_router.h"
+#include "modules/rtp_rtcp/include/reed_solomon_fec_sender.h"
 #include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
 #include "modules/rtp_rtcp/source/rtp_rtcp_impl2.h"
 #include "modules/rtp_rtcp/source/rtp_sender.h"
@@ -168,6 +169,15 @@ std::unique_ptr<VideoFecGenerator> MaybeCreateFecGenerator(
     }
 
     RTC_DCHECK_EQ(1U, rtp.flexfec.protected_media_ssrcs.size());
+    // Both ends must enable the trial, since the Reed-Solomon FEC packets are
+    // sent on the FlexFEC stream in a format only ReedSolomonFecReceiver
+    // understands.
+    if (trials.IsEnabled("WebRTC-ReedSolomonFec")) {
+      return std::make_unique<ReedSolomonFecSender>(
+          rtp.flexfec.payload_type, rtp.flexfec.ssrc,
+          rtp.flexfec.protected_media_ssrcs[0], rtp.mid, rtp.extensions,
+          RTPSender::FecExtensionSizes(), rtp_state, clock);
+    }
     return std::make_unique<FlexfecSender>(
         rtp.flexfec.payload_type, rtp.flexfec.ssrc,
         rtp.flexfec.protected_media_ssrcs[0], rtp.mid, rtp.extensions,
@@ -220,6 +230,7 @@ std::vector<RtpStreamSender> CreateRtpStreamSenders(
   configuration.report_block_data_observer =
       observers.report_block_data_observer;
   configuration.paced_sender = transport->packet_sender();
+  configuration.packet_pool = transport->packet_pool();
   configuration.send_bitrate_observer = observers.bitrate_observer;
   configuration.send_packet_observer = observers.send_packet_observer;
   configuration.event_log = event_log;
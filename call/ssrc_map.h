@@ -0,0 +1,161 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef CALL_SSRC_MAP_H_
+#define CALL_SSRC_MAP_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <utility>
+#include <vector>
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+// Map from SSRC to `Value`, for lookups on every received packet. Uses open
+// addressing with linear probing, so that a lookup usually touches a single
+// cache line, whatever the number of SSRCs.
+template <typename Value>
+class SsrcMap {
+ public:
+  SsrcMap() : slots_(kMinCapacity) {}
+
+  bool empty() const { return size_ == 0; }
+  size_t size() const { return size_; }
+
+  // Returns the value of `ssrc`, or null if there is none.
+  Value* Find(uint32_t ssrc) {
+    for (size_t i = Index(ssrc);; i = Next(i)) {
+      Slot& slot = slots_[i];
+      if (!slot.occupied) {
+        return nullptr;
+      }
+      if (slot.ssrc == ssrc) {
+        return &slot.value;
+      }
+    }
+  }
+  const Value* Find(uint32_t ssrc) const {
+    return const_cast<SsrcMap*>(this)->Find(ssrc);
+  }
+
+  // Inserts `value` for `ssrc` if there is no value for it yet. Returns the
+  // value of `ssrc`, and whether it was inserted.
+  std::pair<Value*, bool> Emplace(uint32_t ssrc, Value value) {
+    if (Value* existing = Find(ssrc)) {
+      return {existing, false};
+    }
+    if (2 * (size_ + 1) > slots_.size()) {
+      Rehash(2 * slots_.size());
+    }
+    size_t i = Index(ssrc);
+    while (slots_[i].occupied) {
+      i = Next(i);
+    }
+    Slot& slot = slots_[i];
+    slot.occupied = true;
+    slot.ssrc = ssrc;
+    slot.value = std::move(value);
+    ++size_;
+    return {&slot.value, true};
+  }
+
+  // Returns the value of `ssrc`, inserting a default one if there is none.
+  Value& operator[](uint32_t ssrc) { return *Emplace(ssrc, Value()).first; }
+
+  // Removes the value of `ssrc`. Returns whether there was one.
+  bool Erase(uint32_t ssrc) {
+    size_t i = Index(ssrc);
+    while (slots_[i].occupied && slots_[i].ssrc != ssrc) {
+      i = Next(i);
+    }
+    if (!slots_[i].occupied) {
+      return false;
+    }
+    // Move back the entries that follow in the probe sequence, so that they
+    // remain reachable without tombstones.
+    for (size_t j = Next(i); slots_[j].occupied; j = Next(j)) {
+      const size_t home = Index(slots_[j].ssrc);
+      // Move the entry unless its home is cyclically in (i, j].
+      if (i <= j ? (home <= i || home > j) : (home <= i && home > j)) {
+        slots_[i].ssrc = slots_[j].ssrc;
+        slots_[i].value = std::move(slots_[j].value);
+        i = j;
+      }
+    }
+    slots_[i].occupied = false;
+    slots_[i].value = Value();
+    --size_;
+    return true;
+  }
+
+  // Removes the entries for which `predicate(ssrc, value)` is true. Returns
+  // the number removed.
+  template <typename Predicate>
+  size_t EraseIf(Predicate predicate) {
+    std::vector<uint32_t> ssrcs;
+    ForEach([&](uint32_t ssrc, const Value& value) {
+      if (predicate(ssrc, value)) {
+        ssrcs.push_back(ssrc);
+      }
+    });
+    for (uint32_t ssrc : ssrcs) {
+      Erase(ssrc);
+    }
+    return ssrcs.size();
+  }
+
+  // Calls `function(ssrc, value)` for every entry, in no particular order.
+  template <typename Function>
+  void ForEach(Function function) const {
+    for (const Slot& slot : slots_) {
+      if (slot.occupied) {
+        function(slot.ssrc, slot.value);
+      }
+    }
+  }
+
+ private:
+  static constexpr size_t kMinCapacity = 16;
+
+  struct Slot {
+    bool occupied = false;
+    uint32_t ssrc = 0;
+    Value value = Value();
+  };
+
+  size_t Index(uint32_t ssrc) const {
+    // Fibonacci hashing, as SSRCs are sometimes chosen in sequence.
+    return (size_t{ssrc} * 0x9E3779B97F4A7C15ull >> 32) & (slots_.size() - 1);
+  }
+  size_t Next(size_t i) const { return (i + 1) & (slots_.size() - 1); }
+
+  void Rehash(size_t capacity) {
+    RTC_DCHECK_EQ(capacity & (capacity - 1), 0);
+    std::vector<Slot> slots(capacity);
+    slots_.swap(slots);
+    size_ = 0;
+    for (Slot& slot : slots) {
+      if (slot.occupied) {
+        Emplace(slot.ssrc, std::move(slot.value));
+      }
+    }
+  }
+
+  // Never more than half full, so that probe sequences stay short.
+  std::vector<Slot> slots_;
+  size_t size_ = 0;
+};
+
+}  // namespace webrtc
+
+#endif  // CALL_SSRC_MAP_H_
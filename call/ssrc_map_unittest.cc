@@ -0,0 +1,123 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "call/ssrc_map.h"
+
+#include <cstdint>
+#include <map>
+#include <string>
+
+#include "rtc_base/random.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::Pair;
+using ::testing::Pointee;
+using ::testing::UnorderedElementsAre;
+
+TEST(SsrcMapTest, IsEmptyInitially) {
+  SsrcMap<int> map;
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(map.size(), 0u);
+  EXPECT_EQ(map.Find(0), nullptr);
+}
+
+TEST(SsrcMapTest, FindsEmplacedValues) {
+  SsrcMap<std::string> map;
+  auto [value, inserted] = map.Emplace(0, "zero");
+  EXPECT_TRUE(inserted);
+  EXPECT_EQ(*value, "zero");
+  map.Emplace(0xffffffff, "max");
+
+  EXPECT_EQ(map.size(), 2u);
+  EXPECT_THAT(map.Find(0), Pointee(std::string("zero")));
+  EXPECT_THAT(map.Find(0xffffffff), Pointee(std::string("max")));
+  EXPECT_EQ(map.Find(1), nullptr);
+}
+
+TEST(SsrcMapTest, EmplaceKeepsExistingValue) {
+  SsrcMap<int> map;
+  map.Emplace(1, 10);
+  auto [value, inserted] = map.Emplace(1, 20);
+  EXPECT_FALSE(inserted);
+  EXPECT_EQ(*value, 10);
+  EXPECT_EQ(map.size(), 1u);
+}
+
+TEST(SsrcMapTest, SubscriptInsertsDefaultValue) {
+  SsrcMap<int> map;
+  EXPECT_EQ(map[1], 0);
+  map[1] = 5;
+  EXPECT_THAT(map.Find(1), Pointee(5));
+  EXPECT_EQ(map.size(), 1u);
+}
+
+TEST(SsrcMapTest, Erases) {
+  SsrcMap<int> map;
+  map.Emplace(1, 10);
+  map.Emplace(2, 20);
+  EXPECT_TRUE(map.Erase(1));
+  EXPECT_FALSE(map.Erase(1));
+  EXPECT_EQ(map.Find(1), nullptr);
+  EXPECT_THAT(map.Find(2), Pointee(20));
+  EXPECT_EQ(map.size(), 1u);
+}
+
+TEST(SsrcMapTest, ErasesIf) {
+  SsrcMap<int> map;
+  for (uint32_t ssrc = 0; ssrc < 100; ++ssrc) {
+    map.Emplace(ssrc, ssrc % 3);
+  }
+  EXPECT_EQ(map.EraseIf([](uint32_t ssrc, int value) { return value != 0; }),
+            66u);
+  EXPECT_EQ(map.size(), 34u);
+  map.ForEach([](uint32_t ssrc, int value) { EXPECT_EQ(ssrc % 3, 0u); });
+}
+
+TEST(SsrcMapTest, VisitsAllEntries) {
+  SsrcMap<int> map;
+  map.Emplace(7, 70);
+  map.Emplace(8, 80);
+  std::map<uint32_t, int> entries;
+  map.ForEach([&](uint32_t ssrc, int value) { entries[ssrc] = value; });
+  EXPECT_THAT(entries, UnorderedElementsAre(Pair(7, 70), Pair(8, 80)));
+}
+
+TEST(SsrcMapTest, MatchesStdMapUnderRandomOperations) {
+  Random random(0x1234);
+  SsrcMap<uint32_t> map;
+  std::map<uint32_t, uint32_t> reference;
+  for (int i = 0; i < 100000; ++i) {
+    // Few distinct SSRCs, so that all operations hit existing entries often.
+    const uint32_t ssrc = random.Rand(2000) * 0x10001;
+    if (random.Rand(2) == 0) {
+      EXPECT_EQ(map.Erase(ssrc), reference.erase(ssrc) == 1);
+    } else {
+      EXPECT_EQ(map.Emplace(ssrc, i).second,
+                reference.emplace(ssrc, i).second);
+    }
+    ASSERT_EQ(map.size(), reference.size());
+  }
+  for (const auto& [ssrc, value] : reference) {
+    EXPECT_THAT(map.Find(ssrc), Pointee(value));
+  }
+  size_t num_entries = 0;
+  map.ForEach([&](uint32_t ssrc, uint32_t value) {
+    EXPECT_EQ(reference.at(ssrc), value);
+    ++num_entries;
+  });
+  EXPECT_EQ(num_entries, reference.size());
+}
+
+}  // namespace
+}  // namespace webrtc
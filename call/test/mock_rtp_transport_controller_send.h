@@ -61,6 +61,7 @@ class MockRtpTransportControllerSend
               (),
               (override));
   MOCK_METHOD(RtpPacketSender*, packet_sender, (), (override));
+  MOCK_METHOD(RtpPacketToSendPool*, packet_pool, (), (override));
   MOCK_METHOD(void,
               SetAllocatedSendBitrateLimits,
               (BitrateAllocationLimits),
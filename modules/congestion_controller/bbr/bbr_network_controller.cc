@@ -0,0 +1,509 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/congestion_controller/bbr/bbr_network_controller.h"
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+namespace bbr {
+namespace {
+constexpr DataRate kDefaultStartingRate = DataRate::KilobitsPerSec(300);
+constexpr TimeDelta kInitialRtt = TimeDelta::Millis(100);
+
+// 2 / ln(2), the lowest gain that doubles the delivery rate every round.
+constexpr double kStartupGain = 2.885;
+constexpr double kDrainGain = 1 / kStartupGain;
+constexpr double kCwndGain = 2;
+// Probes for more bandwidth for a min RTT, drains the queue this built for a
+// min RTT, and then cruises at the estimated bandwidth for six min RTTs.
+constexpr std::array<double, 8> kPacingGainCycle = {1.25, 0.75, 1, 1,
+                                                    1,    1,    1, 1};
+constexpr int kGainCycleLength = kPacingGainCycle.size();
+// Long enough that the max bandwidth is refreshed by a probe before it
+// expires.
+constexpr int64_t kBandwidthWindowLength = kGainCycleLength + 2;
+constexpr int64_t kExtraAckedWindowRounds = 10;
+
+// Startup ends after three rounds that do not grow the bandwidth by 25 %.
+constexpr double kStartupGrowthTarget = 1.25;
+constexpr int kStartupRoundsWithoutGrowth = 3;
+
+constexpr TimeDelta kMinRttExpiry = TimeDelta::Seconds(10);
+constexpr TimeDelta kProbeRttDuration = TimeDelta::Millis(200);
+// As in BBRv2, only halves the data in flight to keep the rate up.
+constexpr double kProbeRttCwndGain = 0.5;
+constexpr DataSize kMinCongestionWindow = DataSize::Bytes(4 * 1200);
+
+// Rounds with more loss than this lower the bounds by `kBeta`.
+constexpr double kLossThreshold = 0.02;
+constexpr double kBeta = 0.7;
+
+// Delivery rates are measured over a min RTT, within these limits. The lower
+// limit covers the feedback interval on short RTTs.
+constexpr TimeDelta kMinSampleInterval = TimeDelta::Millis(25);
+constexpr TimeDelta kMaxSampleInterval = TimeDelta::Millis(250);
+
+constexpr uint64_t kRandomSeed = 100;
+}  // namespace
+
+BbrNetworkController::BbrNetworkController(NetworkControllerConfig config)
+    : default_starting_rate_(
+          config.constraints.starting_rate.value_or(kDefaultStartingRate)),
+      min_rate_(DataRate::Zero()),
+      max_rate_(DataRate::PlusInfinity()),
+      starting_rate_(default_starting_rate_),
+      max_bandwidth_(kBandwidthWindowLength, DataRate::Zero()),
+      max_extra_acked_(kExtraAckedWindowRounds, DataSize::Zero()),
+      random_(kRandomSeed) {
+  UpdateConstraints(config.constraints);
+}
+
+BbrNetworkController::~BbrNetworkController() {}
+
+void BbrNetworkController::Reset() {
+  mode_ = Mode::kStartup;
+  delivery_rate_sampler_.Reset();
+  max_bandwidth_ = WindowedFilter<DataRate, MaxFilter<DataRate>>(
+      kBandwidthWindowLength, DataRate::Zero());
+  bandwidth_lo_ = DataRate::PlusInfinity();
+  inflight_hi_ = DataSize::PlusInfinity();
+  round_max_delivery_rate_ = DataRate::Zero();
+  data_in_flight_ = DataSize::Zero();
+  cwnd_limited_ = false;
+  max_extra_acked_ = WindowedFilter<DataSize, MaxFilter<DataSize>>(
+      kExtraAckedWindowRounds, DataSize::Zero());
+  extra_acked_epoch_start_ = Timestamp::MinusInfinity();
+  extra_acked_epoch_size_ = DataSize::Zero();
+  min_rtt_ = TimeDelta::PlusInfinity();
+  min_rtt_time_ = Timestamp::MinusInfinity();
+  min_rtt_expired_ = false;
+  round_count_ = 0;
+  bandwidth_epoch_ = 0;
+  round_start_ = false;
+  round_end_send_time_ = Timestamp::MinusInfinity();
+  lost_packets_in_round_ = 0;
+  received_packets_in_round_ = 0;
+  loss_rate_ = 0;
+  full_bandwidth_ = DataRate::Zero();
+  rounds_without_growth_ = 0;
+  full_bandwidth_reached_ = false;
+  cycle_index_ = 0;
+  cycle_start_time_ = Timestamp::MinusInfinity();
+  probe_rtt_done_time_ = Timestamp::PlusInfinity();
+  probe_rtt_min_rtt_ = TimeDelta::PlusInfinity();
+}
+
+void BbrNetworkController::UpdateConstraints(
+    const TargetRateConstraints& constraints) {
+  if (constraints.min_data_rate) {
+    min_rate_ = *constraints.min_data_rate;
+  }
+  if (constraints.max_data_rate) {
+    max_rate_ = *constraints.max_data_rate;
+  }
+  if (constraints.starting_rate) {
+    starting_rate_ = *constraints.starting_rate;
+  }
+  max_rate_ = std::max(min_rate_, max_rate_);
+}
+
+NetworkControlUpdate BbrNetworkController::OnNetworkAvailability(
+    NetworkAvailability msg) {
+  network_available_ = msg.network_available;
+  if (!network_available_) {
+    return NetworkControlUpdate();
+  }
+  return CreateRateUpdate(msg.at_time);
+}
+
+NetworkControlUpdate BbrNetworkController::OnNetworkRouteChange(
+    NetworkRouteChange msg) {
+  // The model of the previous path does not apply to the new one.
+  UpdateConstraints(msg.constraints);
+  if (!msg.constraints.starting_rate) {
+    starting_rate_ = default_starting_rate_;
+  }
+  Reset();
+  return CreateRateUpdate(msg.at_time);
+}
+
+NetworkControlUpdate BbrNetworkController::OnProcessInterval(
+    ProcessInterval msg) {
+  if (!network_available_) {
+    return NetworkControlUpdate();
+  }
+  round_start_ = false;
+  UpdateMode(msg.at_time);
+  return CreateRateUpdate(msg.at_time);
+}
+
+NetworkControlUpdate BbrNetworkController::OnSentPacket(SentPacket msg) {
+  last_send_time_ = msg.send_time;
+  data_in_flight_ = msg.data_in_flight;
+  if (data_in_flight_ + msg.size > CongestionWindow()) {
+    cwnd_limited_ = true;
+  }
+  return NetworkControlUpdate();
+}
+
+NetworkControlUpdate BbrNetworkController::OnTargetRateConstraints(
+    TargetRateConstraints msg) {
+  UpdateConstraints(msg);
+  return CreateRateUpdate(msg.at_time);
+}
+
+NetworkControlUpdate BbrNetworkController::OnTransportPacketsFeedback(
+    TransportPacketsFeedback msg) {
+  if (msg.packet_feedbacks.empty()) {
+    return NetworkControlUpdate();
+  }
+  data_in_flight_ = msg.data_in_flight;
+  UpdateRound(msg);
+  UpdateMinRtt(msg);
+  UpdateBandwidth(msg);
+  UpdateExtraAcked(msg);
+  if (round_start_) {
+    UpdateLossBounds();
+    CheckFullBandwidthReached();
+  }
+  UpdateMode(msg.feedback_time);
+  return CreateRateUpdate(msg.feedback_time);
+}
+
+void BbrNetworkController::UpdateRound(const TransportPacketsFeedback& msg) {
+  round_start_ = false;
+  Timestamp last_acked_send_time = Timestamp::MinusInfinity();
+  for (const PacketResult& packet : msg.packet_feedbacks) {
+    if (packet.IsReceived()) {
+      ++received_packets_in_round_;
+    } else {
+      ++lost_packets_in_round_;
+    }
+    last_acked_send_time =
+        std::max(last_acked_send_time, packet.sent_packet.send_time);
+  }
+  if (last_acked_send_time > round_end_send_time_) {
+    round_start_ = true;
+    ++round_count_;
+    if (mode_ != Mode::kProbeBw) {
+      ++bandwidth_epoch_;
+    }
+    round_end_send_time_ = std::max(last_send_time_, last_acked_send_time);
+  }
+}
+
+void BbrNetworkController::UpdateMinRtt(const TransportPacketsFeedback& msg) {
+  // The last packet sent before the feedback waited the least for it.
+  TimeDelta rtt = TimeDelta::PlusInfinity();
+  for (const PacketResult& packet : msg.packet_feedbacks) {
+    if (packet.IsReceived()) {
+      rtt = std::min(rtt, msg.feedback_time - packet.sent_packet.send_time);
+    }
+  }
+  if (rtt.IsInfinite()) {
+    return;
+  }
+  if (mode_ == Mode::kProbeRtt) {
+    probe_rtt_min_rtt_ = std::min(probe_rtt_min_rtt_, rtt);
+  }
+  if (rtt <= min_rtt_) {
+    min_rtt_ = rtt;
+    min_rtt_time_ = msg.feedback_time;
+  } else if (mode_ != Mode::kProbeRtt &&
+             msg.feedback_time - min_rtt_time_ > kMinRttExpiry) {
+    // Keeps the expired min RTT until probed, as the RTT measured with a queue
+    // would overestimate the bandwidth delay product.
+    min_rtt_expired_ = true;
+  }
+}
+
+void BbrNetworkController::UpdateBandwidth(
+    const TransportPacketsFeedback& msg) {
+  const std::vector<PacketResult> received_packets = msg.SortedByReceiveTime();
+  absl::optional<DeliveryRateSampler::Sample> sample =
+      delivery_rate_sampler_.OnPacketsReceived(received_packets,
+                                               SampleInterval());
+  if (!sample) {
+    return;
+  }
+  round_max_delivery_rate_ =
+      std::max(round_max_delivery_rate_, sample->delivery_rate);
+  // App limited samples may be below the bottleneck bandwidth, so they may
+  // only raise the estimate. Samples while the congestion window limited the
+  // sender are not app limited, and let a stale max expire.
+  const bool is_app_limited = sample->is_app_limited && !cwnd_limited_;
+  cwnd_limited_ = false;
+  if (!is_app_limited || !max_bandwidth_.HasSample() ||
+      sample->delivery_rate >= max_bandwidth_.GetBest()) {
+    max_bandwidth_.Update(sample->delivery_rate, bandwidth_epoch_);
+  }
+}
+
+void BbrNetworkController::UpdateExtraAcked(
+    const TransportPacketsFeedback& msg) {
+  DataSize acked = DataSize::Zero();
+  for (const PacketResult& packet : msg.packet_feedbacks) {
+    if (packet.IsReceived()) {
+      acked += packet.sent_packet.size;
+    }
+  }
+  // Starts a new epoch whenever the acknowledged data falls behind the
+  // bandwidth estimate, so that the extra data is measured from the last time
+  // feedback was on time.
+  DataSize expected = DataSize::Zero();
+  if (extra_acked_epoch_start_.IsFinite()) {
+    expected =
+        BandwidthEstimate() * (msg.feedback_time - extra_acked_epoch_start_);
+  }
+  if (extra_acked_epoch_start_.IsInfinite() ||
+      extra_acked_epoch_size_ <= expected) {
+    extra_acked_epoch_start_ = msg.feedback_time;
+    extra_acked_epoch_size_ = DataSize::Zero();
+    expected = DataSize::Zero();
+  }
+  extra_acked_epoch_size_ += acked;
+  max_extra_acked_.Update(extra_acked_epoch_size_ - expected, round_count_);
+}
+
+void BbrNetworkController::UpdateLossBounds() {
+  const int64_t packets = lost_packets_in_round_ + received_packets_in_round_;
+  loss_rate_ = packets > 0
+                   ? static_cast<double>(lost_packets_in_round_) / packets
+                   : 0.0;
+  if (loss_rate_ > kLossThreshold) {
+    // The bandwidth is lowered to what the last round delivered, but by no
+    // more than `kBeta` per round.
+    bandwidth_lo_ =
+        std::max(round_max_delivery_rate_, BandwidthEstimate() * kBeta);
+    if (IsProbing()) {
+      inflight_hi_ =
+          std::max(data_in_flight_, BandwidthDelayProduct() * kBeta);
+    }
+    if (mode_ == Mode::kStartup) {
+      full_bandwidth_reached_ = true;
+    }
+  }
+  lost_packets_in_round_ = 0;
+  received_packets_in_round_ = 0;
+  round_max_delivery_rate_ = DataRate::Zero();
+}
+
+void BbrNetworkController::CheckFullBandwidthReached() {
+  if (full_bandwidth_reached_ || !max_bandwidth_.HasSample()) {
+    return;
+  }
+  // Probing beyond the max rate would only pad.
+  if (BandwidthEstimate() >= max_rate_) {
+    full_bandwidth_reached_ = true;
+    return;
+  }
+  if (max_bandwidth_.GetBest() >= full_bandwidth_ * kStartupGrowthTarget) {
+    full_bandwidth_ = max_bandwidth_.GetBest();
+    rounds_without_growth_ = 0;
+    return;
+  }
+  if (++rounds_without_growth_ >= kStartupRoundsWithoutGrowth) {
+    full_bandwidth_reached_ = true;
+  }
+}
+
+void BbrNetworkController::UpdateMode(Timestamp at_time) {
+  if (mode_ == Mode::kStartup && full_bandwidth_reached_) {
+    mode_ = Mode::kDrain;
+  }
+  if (mode_ == Mode::kDrain && data_in_flight_ <= BandwidthDelayProduct()) {
+    EnterProbeBw(at_time);
+  }
+  if (mode_ == Mode::kProbeBw) {
+    const bool full_length = at_time - cycle_start_time_ > SampleInterval();
+    // The phase that drains the queue ends early once it is drained.
+    if (full_length || (PacingGain() < 1 &&
+                        data_in_flight_ <= BandwidthDelayProduct())) {
+      AdvanceCycle(at_time);
+    }
+  }
+
+  if (min_rtt_expired_) {
+    min_rtt_expired_ = false;
+    mode_ = Mode::kProbeRtt;
+    probe_rtt_done_time_ = Timestamp::PlusInfinity();
+    probe_rtt_min_rtt_ = TimeDelta::PlusInfinity();
+  }
+  if (mode_ == Mode::kProbeRtt) {
+    if (probe_rtt_done_time_.IsInfinite()) {
+      // Starts timing once the data in flight is down to the window.
+      if (data_in_flight_ <= CongestionWindow()) {
+        probe_rtt_done_time_ = at_time + kProbeRttDuration;
+      }
+    } else if (at_time >= probe_rtt_done_time_) {
+      if (probe_rtt_min_rtt_.IsFinite()) {
+        min_rtt_ = probe_rtt_min_rtt_;
+      }
+      min_rtt_time_ = at_time;
+      if (full_bandwidth_reached_) {
+        EnterProbeBw(at_time);
+      } else {
+        mode_ = Mode::kStartup;
+      }
+    }
+  }
+}
+
+void BbrNetworkController::EnterProbeBw(Timestamp at_time) {
+  mode_ = Mode::kProbeBw;
+  // Starts at a random phase, other than the one that drains the queue, so
+  // that flows sharing a bottleneck do not probe at the same time.
+  cycle_index_ = random_.Rand(0, kGainCycleLength - 2);
+  if (cycle_index_ >= 1) {
+    ++cycle_index_;
+  }
+  cycle_start_time_ = at_time;
+}
+
+void BbrNetworkController::AdvanceCycle(Timestamp at_time) {
+  cycle_index_ = (cycle_index_ + 1) % kGainCycleLength;
+  cycle_start_time_ = at_time;
+  ++bandwidth_epoch_;
+  if (cycle_index_ == 0) {
+    // Probing lets the loss of this round set new bounds.
+    bandwidth_lo_ = DataRate::PlusInfinity();
+    inflight_hi_ = DataSize::PlusInfinity();
+  }
+}
+
+TimeDelta BbrNetworkController::SampleInterval() const {
+  return std::min(std::max(min_rtt_.IsFinite() ? min_rtt_ : kInitialRtt,
+                           kMinSampleInterval),
+                  kMaxSampleInterval);
+}
+
+DataRate BbrNetworkController::BandwidthEstimate() const {
+  const DataRate max_bandwidth = max_bandwidth_.HasSample()
+                                     ? max_bandwidth_.GetBest()
+                                     : starting_rate_;
+  return std::min(max_bandwidth, bandwidth_lo_);
+}
+
+DataSize BbrNetworkController::BandwidthDelayProduct() const {
+  if (min_rtt_.IsInfinite()) {
+    return DataSize::PlusInfinity();
+  }
+  return BandwidthEstimate() * min_rtt_;
+}
+
+double BbrNetworkController::PacingGain() const {
+  switch (mode_) {
+    case Mode::kStartup:
+      return kStartupGain;
+    case Mode::kDrain:
+      return kDrainGain;
+    case Mode::kProbeBw:
+      return kPacingGainCycle[cycle_index_];
+    case Mode::kProbeRtt:
+      return 1;
+  }
+  RTC_DCHECK_NOTREACHED();
+  return 1;
+}
+
+DataSize BbrNetworkController::CongestionWindow() const {
+  const DataSize bandwidth_delay_product = BandwidthDelayProduct();
+  if (bandwidth_delay_product.IsInfinite()) {
+    return DataSize::PlusInfinity();
+  }
+  double gain = kCwndGain;
+  if (mode_ == Mode::kStartup || mode_ == Mode::kDrain) {
+    gain = kStartupGain;
+  } else if (mode_ == Mode::kProbeRtt) {
+    gain = kProbeRttCwndGain;
+  }
+  DataSize congestion_window = bandwidth_delay_product * gain;
+  if (mode_ != Mode::kProbeRtt && max_extra_acked_.HasSample()) {
+    congestion_window += max_extra_acked_.GetBest();
+  }
+  return std::max(std::min(congestion_window, inflight_hi_),
+                  kMinCongestionWindow);
+}
+
+bool BbrNetworkController::IsProbing() const {
+  return PacingGain() > 1;
+}
+
+NetworkControlUpdate BbrNetworkController::CreateRateUpdate(
+    Timestamp at_time) const {
+  const DataRate bandwidth = BandwidthEstimate();
+  const DataRate target_rate = std::min(std::max(bandwidth, min_rate_),
+                                        max_rate_);
+  const TimeDelta rtt = min_rtt_.IsFinite() ? min_rtt_ : kInitialRtt;
+  NetworkControlUpdate update;
+
+  TargetTransferRate target_rate_msg;
+  target_rate_msg.at_time = at_time;
+  target_rate_msg.network_estimate.at_time = at_time;
+  target_rate_msg.network_estimate.bandwidth = bandwidth;
+  target_rate_msg.network_estimate.round_trip_time = rtt;
+  target_rate_msg.network_estimate.loss_rate_ratio = loss_rate_;
+  target_rate_msg.network_estimate.bwe_period = rtt * kGainCycleLength;
+  target_rate_msg.target_rate = target_rate;
+  target_rate_msg.stable_target_rate = target_rate;
+  update.target_rate = target_rate_msg;
+
+  // While probing, padding fills up to the pacing rate, but never above the
+  // max rate.
+  const DataRate pacing_rate = std::max(bandwidth * PacingGain(), min_rate_);
+  const DataRate padding_rate =
+      IsProbing() ? std::min(pacing_rate, max_rate_) : DataRate::Zero();
+  PacerConfig pacer_config;
+  pacer_config.at_time = at_time;
+  pacer_config.time_window = TimeDelta::Seconds(1);
+  pacer_config.data_window = pacing_rate * pacer_config.time_window;
+  pacer_config.pad_window = padding_rate * pacer_config.time_window;
+  update.pacer_config = pacer_config;
+
+  update.congestion_window = CongestionWindow();
+  return update;
+}
+
+NetworkControlUpdate BbrNetworkController::OnStreamsConfig(StreamsConfig msg) {
+  return NetworkControlUpdate();
+}
+
+NetworkControlUpdate BbrNetworkController::OnRemoteBitrateReport(
+    RemoteBitrateReport msg) {
+  return NetworkControlUpdate();
+}
+
+NetworkControlUpdate BbrNetworkController::OnRoundTripTimeUpdate(
+    RoundTripTimeUpdate msg) {
+  return NetworkControlUpdate();
+}
+
+NetworkControlUpdate BbrNetworkController::OnTransportLossReport(
+    TransportLossReport msg) {
+  return NetworkControlUpdate();
+}
+
+NetworkControlUpdate BbrNetworkController::OnReceivedPacket(
+    ReceivedPacket msg) {
+  return NetworkControlUpdate();
+}
+
+NetworkControlUpdate BbrNetworkController::OnNetworkStateEstimate(
+    NetworkStateEstimate msg) {
+  return NetworkControlUpdate();
+}
+
+}  // namespace bbr
+}  // namespace webrtc
@@ -0,0 +1,166 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_CONGESTION_CONTROLLER_BBR_BBR_NETWORK_CONTROLLER_H_
+#define MODULES_CONGESTION_CONTROLLER_BBR_BBR_NETWORK_CONTROLLER_H_
+
+#include <stdint.h>
+
+#include "absl/types/optional.h"
+#include "api/transport/network_control.h"
+#include "api/transport/network_types.h"
+#include "api/units/data_rate.h"
+#include "api/units/data_size.h"
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "modules/congestion_controller/bbr/delivery_rate_sampler.h"
+#include "modules/congestion_controller/bbr/windowed_filter.h"
+#include "rtc_base/random.h"
+
+namespace webrtc {
+namespace bbr {
+
+// BBR (Bottleneck Bandwidth and Round-trip propagation time) is a model based
+// congestion control algorithm. It estimates the bottleneck bandwidth as the
+// max recent delivery rate and the propagation delay as the min
+// RTT. It paces at gains of the bandwidth that cycle between probing for more
+// bandwidth and draining the queue this built, and bounds the data in flight
+// to a multiple of the bandwidth delay product. As in BBRv2, a round with loss
+// above a threshold lowers the bandwidth and data in flight bounds until the
+// next probe.
+//
+// Media senders rarely have more data than the encoder target, so the pacer
+// is asked to pad up to the pacing rate while probing. Delivery rates of
+// packets that the network did not spread out only raise the bandwidth
+// estimate, as they are limited by the sender.
+class BbrNetworkController : public NetworkControllerInterface {
+ public:
+  enum class Mode {
+    // Doubles the sending rate every round until the bandwidth stops growing.
+    kStartup,
+    // Drains the queue built in startup.
+    kDrain,
+    // Cycles the pacing gain to probe for bandwidth and drain the queue.
+    kProbeBw,
+    // Lowers the data in flight to measure the min RTT without a queue.
+    kProbeRtt
+  };
+
+  explicit BbrNetworkController(NetworkControllerConfig config);
+  ~BbrNetworkController() override;
+
+  // NetworkControllerInterface
+  NetworkControlUpdate OnNetworkAvailability(NetworkAvailability msg) override;
+  NetworkControlUpdate OnNetworkRouteChange(NetworkRouteChange msg) override;
+  NetworkControlUpdate OnProcessInterval(ProcessInterval msg) override;
+  NetworkControlUpdate OnSentPacket(SentPacket msg) override;
+  NetworkControlUpdate OnTargetRateConstraints(
+      TargetRateConstraints msg) override;
+  NetworkControlUpdate OnTransportPacketsFeedback(
+      TransportPacketsFeedback msg) override;
+
+  // Not used by BBR, which measures the RTT and loss from transport feedback.
+  NetworkControlUpdate OnStreamsConfig(StreamsConfig msg) override;
+  NetworkControlUpdate OnRemoteBitrateReport(RemoteBitrateReport msg) override;
+  NetworkControlUpdate OnRoundTripTimeUpdate(RoundTripTimeUpdate msg) override;
+  NetworkControlUpdate OnTransportLossReport(TransportLossReport msg) override;
+  NetworkControlUpdate OnReceivedPacket(ReceivedPacket msg) override;
+  NetworkControlUpdate OnNetworkStateEstimate(
+      NetworkStateEstimate msg) override;
+
+  Mode mode() const { return mode_; }
+
+ private:
+  void Reset();
+  void UpdateConstraints(const TargetRateConstraints& constraints);
+
+  void UpdateRound(const TransportPacketsFeedback& msg);
+  void UpdateMinRtt(const TransportPacketsFeedback& msg);
+  void UpdateBandwidth(const TransportPacketsFeedback& msg);
+  void UpdateExtraAcked(const TransportPacketsFeedback& msg);
+  void UpdateLossBounds();
+  void CheckFullBandwidthReached();
+  void UpdateMode(Timestamp at_time);
+  void EnterProbeBw(Timestamp at_time);
+  void AdvanceCycle(Timestamp at_time);
+
+  // Delivery rates are measured over this interval, and the phases of the gain
+  // cycle last at least as long, so that every phase is measured.
+  TimeDelta SampleInterval() const;
+  DataRate BandwidthEstimate() const;
+  // Infinite until the min RTT has been measured.
+  DataSize BandwidthDelayProduct() const;
+  double PacingGain() const;
+  DataSize CongestionWindow() const;
+  bool IsProbing() const;
+  NetworkControlUpdate CreateRateUpdate(Timestamp at_time) const;
+
+  const DataRate default_starting_rate_;
+  DataRate min_rate_;
+  DataRate max_rate_;
+  DataRate starting_rate_;
+  bool network_available_ = true;
+
+  Mode mode_ = Mode::kStartup;
+  DeliveryRateSampler delivery_rate_sampler_;
+  // Max delivery rate over the last epochs.
+  WindowedFilter<DataRate, MaxFilter<DataRate>> max_bandwidth_;
+  // Advances every round, and in ProbeBw every phase of the gain cycle. A
+  // queue lengthens the rounds but not the phases, so a max bandwidth that
+  // built the queue still expires within a few cycles.
+  int64_t bandwidth_epoch_ = 0;
+  // Lowered by loss, and reset when probing for more bandwidth.
+  DataRate bandwidth_lo_ = DataRate::PlusInfinity();
+  DataSize inflight_hi_ = DataSize::PlusInfinity();
+  DataRate round_max_delivery_rate_ = DataRate::Zero();
+  DataSize data_in_flight_ = DataSize::Zero();
+  // Set when a packet is sent up to the congestion window, until the next
+  // delivery rate sample.
+  bool cwnd_limited_ = false;
+
+  // Data acknowledged beyond what the bandwidth estimate explains, since
+  // feedback acknowledges packets in batches. Added to the congestion window
+  // so that the sender keeps sending while waiting for feedback.
+  WindowedFilter<DataSize, MaxFilter<DataSize>> max_extra_acked_;
+  Timestamp extra_acked_epoch_start_ = Timestamp::MinusInfinity();
+  DataSize extra_acked_epoch_size_ = DataSize::Zero();
+
+  TimeDelta min_rtt_ = TimeDelta::PlusInfinity();
+  Timestamp min_rtt_time_ = Timestamp::MinusInfinity();
+  // Set when the min RTT has not been lowered for a while, to probe for it.
+  bool min_rtt_expired_ = false;
+
+  // A round ends when a packet sent after the end of the previous round is
+  // acknowledged.
+  int64_t round_count_ = 0;
+  bool round_start_ = false;
+  Timestamp round_end_send_time_ = Timestamp::MinusInfinity();
+  Timestamp last_send_time_ = Timestamp::MinusInfinity();
+  int64_t lost_packets_in_round_ = 0;
+  int64_t received_packets_in_round_ = 0;
+  double loss_rate_ = 0;
+
+  DataRate full_bandwidth_ = DataRate::Zero();
+  int rounds_without_growth_ = 0;
+  bool full_bandwidth_reached_ = false;
+
+  int cycle_index_ = 0;
+  Timestamp cycle_start_time_ = Timestamp::MinusInfinity();
+
+  Timestamp probe_rtt_done_time_ = Timestamp::PlusInfinity();
+  // Replaces the min RTT when probing ends.
+  TimeDelta probe_rtt_min_rtt_ = TimeDelta::PlusInfinity();
+  Random random_;
+};
+
+}  // namespace bbr
+}  // namespace webrtc
+
+#endif  // MODULES_CONGESTION_CONTROLLER_BBR_BBR_NETWORK_CONTROLLER_H_
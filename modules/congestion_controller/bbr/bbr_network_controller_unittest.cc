@@ -0,0 +1,201 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/congestion_controller/bbr/bbr_network_controller.h"
+
+#include <algorithm>
+#include <deque>
+#include <memory>
+
+#include "api/environment/environment_factory.h"
+#include "modules/congestion_controller/bbr/bbr_factory.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+#include "test/scenario/scenario.h"
+
+using ::testing::AllOf;
+using ::testing::Field;
+using ::testing::Ge;
+using ::testing::Le;
+using ::testing::Matcher;
+using ::testing::Property;
+
+namespace webrtc {
+namespace test {
+namespace {
+
+const DataRate kInitialBitrate = DataRate::KilobitsPerSec(300);
+const Timestamp kDefaultStartTime = Timestamp::Millis(10000000);
+const DataSize kPacketSize = DataSize::Bytes(1200);
+
+constexpr double kDataRateMargin = 0.20;
+constexpr double kMinDataRateFactor = 1 - kDataRateMargin;
+constexpr double kMaxDataRateFactor = 1 + kDataRateMargin;
+inline Matcher<TargetTransferRate> TargetRateCloseTo(DataRate rate) {
+  DataRate min_data_rate = rate * kMinDataRateFactor;
+  DataRate max_data_rate = rate * kMaxDataRateFactor;
+  return Field(&TargetTransferRate::target_rate,
+               AllOf(Ge(min_data_rate), Le(max_data_rate)));
+}
+
+NetworkControllerConfig CreateConfig(const Environment& env) {
+  NetworkControllerConfig config(env);
+  config.constraints.at_time = kDefaultStartTime;
+  config.constraints.min_data_rate = DataRate::Zero();
+  config.constraints.max_data_rate = 20 * kInitialBitrate;
+  config.constraints.starting_rate = kInitialBitrate;
+  return config;
+}
+
+// Sends at the pacing rate of the controller over a link with a fixed
+// capacity and no loss, and reports every packet in feedback a round trip
+// later.
+class FixedCapacityLink {
+ public:
+  FixedCapacityLink(bbr::BbrNetworkController* controller,
+                    DataRate capacity,
+                    TimeDelta rtt)
+      : controller_(controller), capacity_(capacity), rtt_(rtt) {}
+
+  void RunFor(TimeDelta duration) {
+    const TimeDelta kStep = TimeDelta::Millis(5);
+    for (Timestamp end = now_ + duration; now_ < end; now_ += kStep) {
+      Apply(controller_->OnProcessInterval({.at_time = now_}));
+      budget_ = std::min(budget_ + pacing_rate_ * kStep,
+                         std::max(pacing_rate_ * kStep, kPacketSize));
+      while (budget_ >= kPacketSize && in_flight_ < congestion_window_) {
+        budget_ -= kPacketSize;
+        SendPacket();
+      }
+      TransportPacketsFeedback feedback;
+      feedback.feedback_time = now_;
+      while (!sent_packets_.empty() &&
+             sent_packets_.front().receive_time + rtt_ / 2 <= now_) {
+        feedback.packet_feedbacks.push_back(sent_packets_.front());
+        sent_packets_.pop_front();
+        in_flight_ -= kPacketSize;
+      }
+      feedback.data_in_flight = in_flight_;
+      Apply(controller_->OnTransportPacketsFeedback(feedback));
+    }
+  }
+
+  DataRate target_rate() const { return target_rate_; }
+
+ private:
+  void SendPacket() {
+    PacketResult packet;
+    packet.sent_packet.send_time = now_;
+    packet.sent_packet.size = kPacketSize;
+    packet.sent_packet.sequence_number = sequence_number_++;
+    link_free_time_ = std::max(link_free_time_, now_) + kPacketSize / capacity_;
+    packet.receive_time = link_free_time_ + rtt_ / 2;
+    sent_packets_.push_back(packet);
+    in_flight_ += kPacketSize;
+    packet.sent_packet.data_in_flight = in_flight_;
+    Apply(controller_->OnSentPacket(packet.sent_packet));
+  }
+
+  void Apply(const NetworkControlUpdate& update) {
+    if (update.target_rate) {
+      target_rate_ = update.target_rate->target_rate;
+    }
+    if (update.pacer_config) {
+      pacing_rate_ = update.pacer_config->data_rate();
+    }
+    if (update.congestion_window) {
+      congestion_window_ = *update.congestion_window;
+    }
+  }
+
+  bbr::BbrNetworkController* const controller_;
+  const DataRate capacity_;
+  const TimeDelta rtt_;
+  Timestamp now_ = kDefaultStartTime;
+  Timestamp link_free_time_ = kDefaultStartTime;
+  DataRate target_rate_ = kInitialBitrate;
+  DataRate pacing_rate_ = kInitialBitrate;
+  DataSize congestion_window_ = DataSize::PlusInfinity();
+  DataSize budget_ = DataSize::Zero();
+  DataSize in_flight_ = DataSize::Zero();
+  int64_t sequence_number_ = 0;
+  std::deque<PacketResult> sent_packets_;
+};
+
+}  // namespace
+
+TEST(BbrNetworkControllerTest, SendsConfigurationOnFirstProcess) {
+  Environment env = CreateEnvironment();
+  bbr::BbrNetworkController controller(CreateConfig(env));
+
+  NetworkControlUpdate update =
+      controller.OnProcessInterval({.at_time = kDefaultStartTime});
+  EXPECT_THAT(*update.target_rate, TargetRateCloseTo(kInitialBitrate));
+  EXPECT_THAT(*update.pacer_config,
+              Property(&PacerConfig::data_rate, Ge(kInitialBitrate)));
+  EXPECT_TRUE(update.congestion_window);
+}
+
+TEST(BbrNetworkControllerTest, ProbesBandwidthAfterStartup) {
+  Environment env = CreateEnvironment();
+  bbr::BbrNetworkController controller(CreateConfig(env));
+  EXPECT_EQ(controller.mode(), bbr::BbrNetworkController::Mode::kStartup);
+
+  const DataRate kCapacity = DataRate::KilobitsPerSec(2000);
+  FixedCapacityLink link(&controller, kCapacity, TimeDelta::Millis(50));
+  link.RunFor(TimeDelta::Seconds(5));
+  EXPECT_EQ(controller.mode(), bbr::BbrNetworkController::Mode::kProbeBw);
+  EXPECT_GE(link.target_rate(), kCapacity * kMinDataRateFactor);
+  EXPECT_LE(link.target_rate(), kCapacity * kMaxDataRateFactor);
+}
+
+TEST(BbrNetworkControllerTest, UpdatesTargetSendRate) {
+  BbrNetworkControllerFactory factory;
+  Scenario s("bbr_unit/updates_rate", false);
+  CallClientConfig config;
+  config.transport.cc_factory = &factory;
+  config.transport.rates.min_rate = DataRate::KilobitsPerSec(10);
+  config.transport.rates.max_rate = DataRate::KilobitsPerSec(1500);
+  config.transport.rates.start_rate = DataRate::KilobitsPerSec(300);
+  auto send_net = s.CreateMutableSimulationNode([](NetworkSimulationConfig* c) {
+    c->bandwidth = DataRate::KilobitsPerSec(500);
+    c->delay = TimeDelta::Millis(100);
+  });
+  auto ret_net = s.CreateMutableSimulationNode(
+      [](NetworkSimulationConfig* c) { c->delay = TimeDelta::Millis(100); });
+
+  auto* client = s.CreateClient("send", config);
+  auto* route = s.CreateRoutes(client, {send_net->node()},
+                               s.CreateClient("return", CallClientConfig()),
+                               {ret_net->node()});
+  VideoStreamConfig video;
+  video.stream.use_rtx = false;
+  s.CreateVideoStream(route->forward(), video);
+  s.RunFor(TimeDelta::Seconds(20));
+  EXPECT_NEAR(client->target_rate().kbps(), 500, 100);
+  send_net->UpdateConfig([](NetworkSimulationConfig* c) {
+    c->bandwidth = DataRate::KilobitsPerSec(800);
+    c->delay = TimeDelta::Millis(100);
+  });
+  s.RunFor(TimeDelta::Seconds(20));
+  EXPECT_NEAR(client->target_rate().kbps(), 800, 150);
+  send_net->UpdateConfig([](NetworkSimulationConfig* c) {
+    c->bandwidth = DataRate::KilobitsPerSec(200);
+    c->delay = TimeDelta::Millis(200);
+  });
+  ret_net->UpdateConfig(
+      [](NetworkSimulationConfig* c) { c->delay = TimeDelta::Millis(200); });
+  s.RunFor(TimeDelta::Seconds(20));
+  EXPECT_LE(client->target_rate().kbps(), 250);
+  EXPECT_GT(client->target_rate().kbps(), 100);
+}
+
+}  // namespace test
+}  // namespace webrtc
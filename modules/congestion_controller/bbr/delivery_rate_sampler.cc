@@ -0,0 +1,73 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/congestion_controller/bbr/delivery_rate_sampler.h"
+
+#include <algorithm>
+
+namespace webrtc {
+namespace bbr {
+
+DeliveryRateSampler::DeliveryRateSampler() = default;
+DeliveryRateSampler::~DeliveryRateSampler() = default;
+
+absl::optional<DeliveryRateSampler::Sample>
+DeliveryRateSampler::OnPacketsReceived(
+    rtc::ArrayView<const PacketResult> received_packets,
+    TimeDelta interval) {
+  for (const PacketResult& packet : received_packets) {
+    total_received_ += packet.sent_packet.size;
+    // Packets reported out of order across feedback are counted as received
+    // with the latest packet, which keeps the history sorted.
+    Timestamp receive_time = packet.receive_time;
+    if (!received_packets_.empty()) {
+      receive_time =
+          std::max(receive_time, received_packets_.back().receive_time);
+    }
+    received_packets_.push_back(
+        {packet.sent_packet.send_time, receive_time, total_received_});
+  }
+  if (received_packets_.empty()) {
+    return absl::nullopt;
+  }
+
+  // Keeps the latest packet received at least `interval` before the last one,
+  // as the start of the sample.
+  const ReceivedPacket& last = received_packets_.back();
+  const Timestamp interval_start = last.receive_time - interval;
+  while (received_packets_.size() > 1 &&
+         received_packets_[1].receive_time <= interval_start) {
+    received_packets_.pop_front();
+  }
+  const ReceivedPacket& first = received_packets_.front();
+  if (first.receive_time > interval_start) {
+    return absl::nullopt;
+  }
+
+  // The first packet is excluded, as it was received at the start of the
+  // interval.
+  const DataSize delivered = last.total_received - first.total_received;
+  const TimeDelta receive_duration = last.receive_time - first.receive_time;
+  const TimeDelta send_duration = last.send_time - first.send_time;
+  const TimeDelta duration = std::max(receive_duration, send_duration);
+  if (duration <= TimeDelta::Zero()) {
+    return absl::nullopt;
+  }
+  return Sample{.delivery_rate = delivered / duration,
+                .is_app_limited = receive_duration <= send_duration};
+}
+
+void DeliveryRateSampler::Reset() {
+  received_packets_.clear();
+  total_received_ = DataSize::Zero();
+}
+
+}  // namespace bbr
+}  // namespace webrtc
@@ -0,0 +1,68 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_CONGESTION_CONTROLLER_BBR_DELIVERY_RATE_SAMPLER_H_
+#define MODULES_CONGESTION_CONTROLLER_BBR_DELIVERY_RATE_SAMPLER_H_
+
+#include <deque>
+
+#include "absl/types/optional.h"
+#include "api/array_view.h"
+#include "api/transport/network_types.h"
+#include "api/units/data_rate.h"
+#include "api/units/data_size.h"
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+
+namespace webrtc {
+namespace bbr {
+
+// Measures the rate at which the network delivers packets from the send and
+// receive times in transport feedback. Each sample covers the packets received
+// during the last interval, and is the received size divided by the longer of
+// the receive and send durations of those packets, so that neither bursts at
+// the sender nor at the receiver overestimate the rate.
+class DeliveryRateSampler {
+ public:
+  struct Sample {
+    DataRate delivery_rate;
+    // True if the packets were received no slower than they were sent. The
+    // rate is then limited by the sender, and only shows that the network can
+    // take at least this rate.
+    bool is_app_limited;
+  };
+
+  DeliveryRateSampler();
+  ~DeliveryRateSampler();
+
+  // Adds `received_packets`, which must be sorted by receive time, and returns
+  // a sample over the packets received in the last `interval`. Returns nullopt
+  // if less than `interval` of packets has been received.
+  absl::optional<Sample> OnPacketsReceived(
+      rtc::ArrayView<const PacketResult> received_packets,
+      TimeDelta interval);
+  void Reset();
+
+ private:
+  struct ReceivedPacket {
+    Timestamp send_time;
+    Timestamp receive_time;
+    // Including this packet.
+    DataSize total_received;
+  };
+
+  std::deque<ReceivedPacket> received_packets_;
+  DataSize total_received_ = DataSize::Zero();
+};
+
+}  // namespace bbr
+}  // namespace webrtc
+
+#endif  // MODULES_CONGESTION_CONTROLLER_BBR_DELIVERY_RATE_SAMPLER_H_
@@ -0,0 +1,110 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/congestion_controller/bbr/delivery_rate_sampler.h"
+
+#include <vector>
+
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace bbr {
+namespace test {
+namespace {
+const DataSize kPacketSize = DataSize::Bytes(1000);
+const TimeDelta kInterval = TimeDelta::Millis(100);
+const Timestamp kStartTime = Timestamp::Seconds(1);
+
+// Packets sent every `send_delta` and received every `receive_delta`.
+std::vector<PacketResult> CreatePackets(int count,
+                                        TimeDelta send_delta,
+                                        TimeDelta receive_delta) {
+  std::vector<PacketResult> packets;
+  for (int i = 0; i < count; ++i) {
+    PacketResult packet;
+    packet.sent_packet.send_time = kStartTime + send_delta * i;
+    packet.sent_packet.size = kPacketSize;
+    packet.receive_time =
+        kStartTime + TimeDelta::Millis(50) + receive_delta * i;
+    packets.push_back(packet);
+  }
+  return packets;
+}
+}  // namespace
+
+TEST(BbrDeliveryRateSamplerTest, NoSampleBeforeInterval) {
+  DeliveryRateSampler sampler;
+  EXPECT_FALSE(sampler.OnPacketsReceived(
+      CreatePackets(10, TimeDelta::Millis(5), TimeDelta::Millis(5)),
+      kInterval));
+}
+
+TEST(BbrDeliveryRateSamplerTest, MeasuresReceiveRateOfQueuedPackets) {
+  DeliveryRateSampler sampler;
+  // Sent at 8 Mbps, and spread out to 800 kbps by the network.
+  absl::optional<DeliveryRateSampler::Sample> sample =
+      sampler.OnPacketsReceived(
+          CreatePackets(50, TimeDelta::Millis(1), TimeDelta::Millis(10)),
+          kInterval);
+  ASSERT_TRUE(sample);
+  EXPECT_EQ(sample->delivery_rate, DataRate::KilobitsPerSec(800));
+  EXPECT_FALSE(sample->is_app_limited);
+}
+
+TEST(BbrDeliveryRateSamplerTest, MeasuresSendRateOfPacketsReceivedInBursts) {
+  DeliveryRateSampler sampler;
+  // Sent at 800 kbps, and received in a burst.
+  std::vector<PacketResult> packets =
+      CreatePackets(50, TimeDelta::Millis(10), TimeDelta::Millis(10));
+  for (size_t i = 0; i < packets.size(); ++i) {
+    packets[i].receive_time = packets[i - i % 10].receive_time;
+  }
+  absl::optional<DeliveryRateSampler::Sample> sample =
+      sampler.OnPacketsReceived(packets, kInterval);
+  ASSERT_TRUE(sample);
+  EXPECT_LE(sample->delivery_rate, DataRate::KilobitsPerSec(800));
+  EXPECT_TRUE(sample->is_app_limited);
+}
+
+TEST(BbrDeliveryRateSamplerTest, SamplesOnlyLastInterval) {
+  DeliveryRateSampler sampler;
+  sampler.OnPacketsReceived(
+      CreatePackets(50, TimeDelta::Millis(1), TimeDelta::Millis(10)),
+      kInterval);
+  // The next packets are received four times as fast.
+  std::vector<PacketResult> packets;
+  for (int i = 0; i < 60; ++i) {
+    PacketResult packet;
+    packet.sent_packet.send_time = kStartTime + TimeDelta::Millis(50 + i);
+    packet.sent_packet.size = kPacketSize;
+    packet.receive_time =
+        kStartTime + TimeDelta::Millis(540) + TimeDelta::Micros(2500) * (i + 1);
+    packets.push_back(packet);
+  }
+  absl::optional<DeliveryRateSampler::Sample> sample =
+      sampler.OnPacketsReceived(packets, kInterval);
+  ASSERT_TRUE(sample);
+  EXPECT_EQ(sample->delivery_rate, DataRate::KilobitsPerSec(3200));
+}
+
+TEST(BbrDeliveryRateSamplerTest, ResetClearsHistory) {
+  DeliveryRateSampler sampler;
+  sampler.OnPacketsReceived(
+      CreatePackets(50, TimeDelta::Millis(1), TimeDelta::Millis(10)),
+      kInterval);
+  sampler.Reset();
+  EXPECT_FALSE(sampler.OnPacketsReceived(
+      CreatePackets(5, TimeDelta::Millis(1), TimeDelta::Millis(10)),
+      kInterval));
+}
+
+}  // namespace test
+}  // namespace bbr
+}  // namespace webrtc
@@ -0,0 +1,111 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_CONGESTION_CONTROLLER_BBR_WINDOWED_FILTER_H_
+#define MODULES_CONGESTION_CONTROLLER_BBR_WINDOWED_FILTER_H_
+
+#include <stdint.h>
+
+namespace webrtc {
+namespace bbr {
+
+template <class T>
+struct MaxFilter {
+  bool operator()(const T& lhs, const T& rhs) const { return lhs >= rhs; }
+};
+
+template <class T>
+struct MinFilter {
+  bool operator()(const T& lhs, const T& rhs) const { return lhs <= rhs; }
+};
+
+// Tracks the best (by `Compare`) sample seen within a window of time, e.g.
+// the max delivery rate over the last rounds. Uses Kathleen Nichols' algorithm,
+// which keeps the best, second best and third best samples of successively
+// more recent parts of the window. Updates are O(1) and no history is kept,
+// but the result is an approximation when samples are not monotonic. `time` is
+// any monotonic counter, such as a round count.
+template <class T, class Compare>
+class WindowedFilter {
+ public:
+  // `zero_value` is only used to initialize the samples, as `T` may not be
+  // default constructible.
+  WindowedFilter(int64_t window_length, T zero_value)
+      : window_length_(window_length),
+        estimates_{{zero_value, 0}, {zero_value, 0}, {zero_value, 0}} {}
+
+  // Updates the filter with `new_sample` taken at `new_time`, which must not
+  // be earlier than the time of previous samples.
+  void Update(T new_sample, int64_t new_time) {
+    if (!has_sample_ || Compare()(new_sample, estimates_[0].sample) ||
+        new_time - estimates_[2].time > window_length_) {
+      Reset(new_sample, new_time);
+      return;
+    }
+    if (Compare()(new_sample, estimates_[1].sample)) {
+      estimates_[1] = {new_sample, new_time};
+      estimates_[2] = estimates_[1];
+    } else if (Compare()(new_sample, estimates_[2].sample)) {
+      estimates_[2] = {new_sample, new_time};
+    }
+
+    // Expires the best estimate, and promotes the second and third best.
+    if (new_time - estimates_[0].time > window_length_) {
+      estimates_[0] = estimates_[1];
+      estimates_[1] = estimates_[2];
+      estimates_[2] = {new_sample, new_time};
+      // The second best may have expired too.
+      if (new_time - estimates_[0].time > window_length_) {
+        estimates_[0] = estimates_[1];
+        estimates_[1] = estimates_[2];
+      }
+      return;
+    }
+    // If the best estimate has been the only one for a quarter of the window,
+    // the new sample becomes the second and third best, so that they cover
+    // the more recent parts of the window.
+    if (estimates_[1].sample == estimates_[0].sample &&
+        new_time - estimates_[1].time > window_length_ / 4) {
+      estimates_[2] = estimates_[1] = {new_sample, new_time};
+      return;
+    }
+    // Likewise for the third best after half of the window.
+    if (estimates_[2].sample == estimates_[1].sample &&
+        new_time - estimates_[2].time > window_length_ / 2) {
+      estimates_[2] = {new_sample, new_time};
+    }
+  }
+
+  // Forgets all previous samples and starts over with `new_sample`.
+  void Reset(T new_sample, int64_t new_time) {
+    has_sample_ = true;
+    estimates_[0] = estimates_[1] = estimates_[2] = {new_sample, new_time};
+  }
+
+  bool HasSample() const { return has_sample_; }
+  // Must not be called before the first update.
+  T GetBest() const { return estimates_[0].sample; }
+
+ private:
+  struct Sample {
+    T sample;
+    int64_t time;
+  };
+
+  int64_t window_length_;
+  bool has_sample_ = false;
+  // Best, second best and third best samples.
+  Sample estimates_[3];
+};
+
+}  // namespace bbr
+}  // namespace webrtc
+
+#endif  // MODULES_CONGESTION_CONTROLLER_BBR_WINDOWED_FILTER_H_
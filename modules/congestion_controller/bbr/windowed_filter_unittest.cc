@@ -0,0 +1,72 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/congestion_controller/bbr/windowed_filter.h"
+
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace bbr {
+namespace test {
+namespace {
+constexpr int64_t kWindowLength = 10;
+}  // namespace
+
+TEST(BbrWindowedFilterTest, KeepsMaxWithinWindow) {
+  WindowedFilter<int, MaxFilter<int>> filter(kWindowLength, 0);
+  EXPECT_FALSE(filter.HasSample());
+  filter.Update(100, 0);
+  EXPECT_TRUE(filter.HasSample());
+  for (int64_t time = 1; time <= kWindowLength; ++time) {
+    filter.Update(50, time);
+    EXPECT_EQ(filter.GetBest(), 100);
+  }
+}
+
+TEST(BbrWindowedFilterTest, ExpiresMaxAfterWindow) {
+  WindowedFilter<int, MaxFilter<int>> filter(kWindowLength, 0);
+  filter.Update(100, 0);
+  for (int64_t time = 1; time <= kWindowLength + 1; ++time) {
+    filter.Update(50, time);
+  }
+  EXPECT_EQ(filter.GetBest(), 50);
+}
+
+TEST(BbrWindowedFilterTest, PromotesSecondBestOnExpiry) {
+  WindowedFilter<int, MaxFilter<int>> filter(kWindowLength, 0);
+  filter.Update(100, 0);
+  filter.Update(80, kWindowLength / 2);
+  for (int64_t time = kWindowLength / 2 + 1; time <= kWindowLength + 1;
+       ++time) {
+    filter.Update(50, time);
+  }
+  EXPECT_EQ(filter.GetBest(), 80);
+}
+
+TEST(BbrWindowedFilterTest, NewBestReplacesAllSamples) {
+  WindowedFilter<int, MaxFilter<int>> filter(kWindowLength, 0);
+  filter.Update(100, 0);
+  filter.Update(200, 1);
+  filter.Update(50, kWindowLength + 1);
+  EXPECT_EQ(filter.GetBest(), 200);
+}
+
+TEST(BbrWindowedFilterTest, KeepsMinWithinWindow) {
+  WindowedFilter<int, MinFilter<int>> filter(kWindowLength, 0);
+  filter.Update(10, 0);
+  filter.Update(20, kWindowLength);
+  EXPECT_EQ(filter.GetBest(), 10);
+  filter.Update(30, kWindowLength + 1);
+  EXPECT_EQ(filter.GetBest(), 20);
+}
+
+}  // namespace test
+}  // namespace bbr
+}  // namespace webrtc
@@ -13,6 +13,7 @@
 #include <algorithm>
 #include <cmath>
 #include <cstddef>
+#include <cstdint>
 #include <cstdlib>
 #include <limits>
 #include <vector>
@@ -83,29 +84,32 @@ PacketResultsSummary GetPacketResultsSummary(
   return packet_results_summary;
 }
 
+// Rates are in bps, and infinite if not valid. Selects rather than branches,
+// so that loops over candidates vectorize.
 double GetLossProbability(double inherent_loss,
-                          DataRate loss_limited_bandwidth,
-                          DataRate sending_rate) {
-  if (inherent_loss < 0.0 || inherent_loss > 1.0) {
-    RTC_LOG(LS_WARNING) << "The inherent loss must be in [0,1]: "
-                        << inherent_loss;
-    inherent_loss = std::min(std::max(inherent_loss, 0.0), 1.0);
-  }
-  if (!sending_rate.IsFinite()) {
-    RTC_LOG(LS_WARNING) << "The sending rate must be finite: "
-                        << ToString(sending_rate);
-  }
-  if (!loss_limited_bandwidth.IsFinite()) {
-    RTC_LOG(LS_WARNING) << "The loss limited bandwidth must be finite: "
-                        << ToString(loss_limited_bandwidth);
-  }
-
-  double loss_probability = inherent_loss;
-  if (IsValid(sending_rate) && IsValid(loss_limited_bandwidth) &&
-      (sending_rate > loss_limited_bandwidth)) {
-    loss_probability += (1 - inherent_loss) *
-                        (sending_rate - loss_limited_bandwidth) / sending_rate;
-  }
+                          double loss_limited_bandwidth_bps,
+                          double sending_rate_bps) {
+  inherent_loss = std::min(std::max(inherent_loss, 0.0), 1.0);
+  const bool sending_above_bandwidth =
+      std::isfinite(sending_rate_bps) &&
+      std::isfinite(loss_limited_bandwidth_bps) &&
+      sending_rate_bps > loss_limited_bandwidth_bps;
+  const double rate_above_bandwidth_bps =
+      sending_rate_bps - loss_limited_bandwidth_bps;
+  const double excess_rate_bps =
+      sending_above_bandwidth ? rate_above_bandwidth_bps * (1 - inherent_loss)
+                              : 0.0;
+  // Rounded half away from zero to whole bps, as a DataRate would be, without
+  // a call to std::llround.
+  const double whole_excess_rate_bps =
+      static_cast<double>(static_cast<int64_t>(excess_rate_bps));
+  const double rounded_excess_rate_bps =
+      whole_excess_rate_bps +
+      (excess_rate_bps - whole_excess_rate_bps >= 0.5 ? 1.0 : 0.0);
+  const double loss_probability =
+      inherent_loss + (sending_above_bandwidth
+                           ? rounded_excess_rate_bps / sending_rate_bps
+                           : 0.0);
   return std::min(std::max(loss_probability, 1.0e-6), 1.0 - 1.0e-6);
 }
 
@@ -248,15 +252,15 @@ void LossBasedBweV2::UpdateBandwidthEstimate(
                           .state = LossBasedState::kDelayBasedEstimate};
   }
 
+  const std::vector<ChannelParameters> candidates = GetCandidates(in_alr);
+  EvaluateCandidates(candidates);
   ChannelParameters best_candidate = current_best_estimate_;
   double objective_max = std::numeric_limits<double>::lowest();
-  for (ChannelParameters candidate : GetCandidates(in_alr)) {
-    NewtonsMethodUpdate(candidate);
-
-    const double candidate_objective = GetObjective(candidate);
-    if (candidate_objective > objective_max) {
-      objective_max = candidate_objective;
-      best_candidate = candidate;
+  for (size_t i = 0; i < candidates.size(); ++i) {
+    if (candidate_batch_.objective[i] > objective_max) {
+      objective_max = candidate_batch_.objective[i];
+      best_candidate = candidates[i];
+      best_candidate.inherent_loss = candidate_batch_.inherent_loss[i];
     }
   }
   if (best_candidate.loss_limited_bandwidth <
@@ -928,56 +932,6 @@ std::vector<LossBasedBweV2::ChannelParameters> LossBasedBweV2::GetCandidates(
   return candidates;
 }
 
-LossBasedBweV2::Derivatives LossBasedBweV2::GetDerivatives(
-    const ChannelParameters& channel_parameters) const {
-  Derivatives derivatives;
-
-  for (const Observation& observation : observations_) {
-    if (!observation.IsInitialized()) {
-      continue;
-    }
-
-    double loss_probability = GetLossProbability(
-        channel_parameters.inherent_loss,
-        channel_parameters.loss_limited_bandwidth, observation.sending_rate);
-
-    double temporal_weight =
-        temporal_weights_[(num_observations_ - 1) - observation.id];
-    if (config_->use_byte_loss_rate) {
-      derivatives.first +=
-          temporal_weight *
-          ((ToKiloBytes(observation.lost_size) / loss_probability) -
-           (ToKiloBytes(observation.size - observation.lost_size) /
-            (1.0 - loss_probability)));
-      derivatives.second -=
-          temporal_weight *
-          ((ToKiloBytes(observation.lost_size) /
-            std::pow(loss_probability, 2)) +
-           (ToKiloBytes(observation.size - observation.lost_size) /
-            std::pow(1.0 - loss_probability, 2)));
-    } else {
-      derivatives.first +=
-          temporal_weight *
-          ((observation.num_lost_packets / loss_probability) -
-           (observation.num_received_packets / (1.0 - loss_probability)));
-      derivatives.second -=
-          temporal_weight *
-          ((observation.num_lost_packets / std::pow(loss_probability, 2)) +
-           (observation.num_received_packets /
-            std::pow(1.0 - loss_probability, 2)));
-    }
-  }
-
-  if (derivatives.second >= 0.0) {
-    RTC_LOG(LS_ERROR) << "The second derivative is mathematically guaranteed "
-                         "to be negative but is "
-                      << derivatives.second << ".";
-    derivatives.second = -1.0e-6;
-  }
-
-  return derivatives;
-}
-
 double LossBasedBweV2::GetFeasibleInherentLoss(
     const ChannelParameters& channel_parameters) const {
   return std::min(
@@ -1006,9 +960,10 @@ double LossBasedBweV2::AdjustBiasFactor(double loss_rate,
                    loss_rate));
 }
 
-double LossBasedBweV2::GetHighBandwidthBias(DataRate bandwidth) const {
+double LossBasedBweV2::GetHighBandwidthBias(
+    DataRate bandwidth,
+    double average_reported_loss_ratio) const {
   if (IsValid(bandwidth)) {
-    const double average_reported_loss_ratio = GetAverageReportedLossRatio();
     return AdjustBiasFactor(average_reported_loss_ratio,
                             config_->higher_bandwidth_bias_factor) *
                bandwidth.kbps() +
@@ -1019,46 +974,6 @@ double LossBasedBweV2::GetHighBandwidthBias(DataRate bandwidth) const {
   return 0.0;
 }
 
-double LossBasedBweV2::GetObjective(
-    const ChannelParameters& channel_parameters) const {
-  double objective = 0.0;
-
-  const double high_bandwidth_bias =
-      GetHighBandwidthBias(channel_parameters.loss_limited_bandwidth);
-
-  for (const Observation& observation : observations_) {
-    if (!observation.IsInitialized()) {
-      continue;
-    }
-
-    double loss_probability = GetLossProbability(
-        channel_parameters.inherent_loss,
-        channel_parameters.loss_limited_bandwidth, observation.sending_rate);
-
-    double temporal_weight =
-        temporal_weights_[(num_observations_ - 1) - observation.id];
-    if (config_->use_byte_loss_rate) {
-      objective +=
-          temporal_weight *
-          ((ToKiloBytes(observation.lost_size) * std::log(loss_probability)) +
-           (ToKiloBytes(observation.size - observation.lost_size) *
-            std::log(1.0 - loss_probability)));
-      objective +=
-          temporal_weight * high_bandwidth_bias * ToKiloBytes(observation.size);
-    } else {
-      objective +=
-          temporal_weight *
-          ((observation.num_lost_packets * std::log(loss_probability)) +
-           (observation.num_received_packets *
-            std::log(1.0 - loss_probability)));
-      objective +=
-          temporal_weight * high_bandwidth_bias * observation.num_packets;
-    }
-  }
-
-  return objective;
-}
-
 DataRate LossBasedBweV2::GetSendingRate(
     DataRate instantaneous_sending_rate) const {
   if (num_observations_ <= 0) {
@@ -1120,18 +1035,168 @@ void LossBasedBweV2::CalculateTemporalWeights() {
   }
 }
 
-void LossBasedBweV2::NewtonsMethodUpdate(
-    ChannelParameters& channel_parameters) const {
-  if (num_observations_ <= 0) {
-    return;
+void LossBasedBweV2::EvaluateCandidates(
+    rtc::ArrayView<const ChannelParameters> candidates) {
+  FillObservationBatch();
+  const double average_reported_loss_ratio = GetAverageReportedLossRatio();
+  CandidateBatch& batch = candidate_batch_;
+  const size_t num_candidates = candidates.size();
+  batch.inherent_loss.resize(num_candidates);
+  batch.inherent_loss_upper_bound.resize(num_candidates);
+  batch.bandwidth_bps.resize(num_candidates);
+  batch.first_derivative.resize(num_candidates);
+  batch.second_derivative.resize(num_candidates);
+  batch.high_bandwidth_bias.resize(num_candidates);
+  batch.objective.resize(num_candidates);
+  batch.inherent_loss_probability.resize(num_candidates);
+  batch.log_inherent_loss_probability.resize(num_candidates);
+  batch.log_inherent_no_loss_probability.resize(num_candidates);
+  for (size_t i = 0; i < num_candidates; ++i) {
+    const ChannelParameters& candidate = candidates[i];
+    if (candidate.inherent_loss < 0.0 || candidate.inherent_loss > 1.0) {
+      RTC_LOG(LS_WARNING) << "The inherent loss must be in [0,1]: "
+                          << candidate.inherent_loss;
+    }
+    if (!candidate.loss_limited_bandwidth.IsFinite()) {
+      RTC_LOG(LS_WARNING) << "The loss limited bandwidth must be finite: "
+                          << ToString(candidate.loss_limited_bandwidth);
+    }
+    batch.inherent_loss[i] = candidate.inherent_loss;
+    batch.inherent_loss_upper_bound[i] =
+        GetInherentLossUpperBound(candidate.loss_limited_bandwidth);
+    batch.bandwidth_bps[i] = candidate.loss_limited_bandwidth.bps<double>();
+    batch.high_bandwidth_bias[i] = GetHighBandwidthBias(
+        candidate.loss_limited_bandwidth, average_reported_loss_ratio);
+  }
+
+  // Newton's method on the inherent loss of each candidate.
+  if (num_observations_ > 0) {
+    for (int i = 0; i < config_->newton_iterations; ++i) {
+      ComputeDerivatives();
+      for (size_t j = 0; j < num_candidates; ++j) {
+        batch.inherent_loss[j] -= config_->newton_step_size *
+                                  batch.first_derivative[j] /
+                                  batch.second_derivative[j];
+        batch.inherent_loss[j] =
+            std::min(std::max(batch.inherent_loss[j],
+                              config_->inherent_loss_lower_bound),
+                     batch.inherent_loss_upper_bound[j]);
+      }
+    }
   }
+  ComputeObjectives();
+}
 
-  for (int i = 0; i < config_->newton_iterations; ++i) {
-    const Derivatives derivatives = GetDerivatives(channel_parameters);
-    channel_parameters.inherent_loss -=
-        config_->newton_step_size * derivatives.first / derivatives.second;
-    channel_parameters.inherent_loss =
-        GetFeasibleInherentLoss(channel_parameters);
+void LossBasedBweV2::FillObservationBatch() {
+  ObservationBatch& batch = observation_batch_;
+  batch.temporal_weight.clear();
+  batch.sending_rate_bps.clear();
+  batch.lost.clear();
+  batch.received.clear();
+  batch.total.clear();
+  for (const Observation& observation : observations_) {
+    if (!observation.IsInitialized()) {
+      continue;
+    }
+    if (!observation.sending_rate.IsFinite()) {
+      RTC_LOG(LS_WARNING) << "The sending rate must be finite: "
+                          << ToString(observation.sending_rate);
+    }
+    batch.temporal_weight.push_back(
+        temporal_weights_[(num_observations_ - 1) - observation.id]);
+    batch.sending_rate_bps.push_back(observation.sending_rate.bps<double>());
+    if (config_->use_byte_loss_rate) {
+      batch.lost.push_back(ToKiloBytes(observation.lost_size));
+      batch.received.push_back(
+          ToKiloBytes(observation.size - observation.lost_size));
+      batch.total.push_back(ToKiloBytes(observation.size));
+    } else {
+      batch.lost.push_back(observation.num_lost_packets);
+      batch.received.push_back(observation.num_received_packets);
+      batch.total.push_back(observation.num_packets);
+    }
+  }
+}
+
+// The loops below run over the candidates innermost. Each candidate then
+// accumulates over the observations in the same order as a loop over one
+// candidate would, and the candidates are independent of each other, so the
+// compiler may vectorize without changing any result.
+void LossBasedBweV2::ComputeDerivatives() {
+  const ObservationBatch& observations = observation_batch_;
+  CandidateBatch& candidates = candidate_batch_;
+  const size_t num_candidates = candidates.inherent_loss.size();
+  absl::c_fill(candidates.first_derivative, 0.0);
+  absl::c_fill(candidates.second_derivative, 0.0);
+  for (size_t i = 0; i < observations.temporal_weight.size(); ++i) {
+    const double temporal_weight = observations.temporal_weight[i];
+    const double sending_rate_bps = observations.sending_rate_bps[i];
+    const double lost = observations.lost[i];
+    const double received = observations.received[i];
+    for (size_t j = 0; j < num_candidates; ++j) {
+      const double loss_probability =
+          GetLossProbability(candidates.inherent_loss[j],
+                             candidates.bandwidth_bps[j], sending_rate_bps);
+      candidates.first_derivative[j] +=
+          temporal_weight *
+          ((lost / loss_probability) - (received / (1.0 - loss_probability)));
+      candidates.second_derivative[j] -=
+          temporal_weight * ((lost / std::pow(loss_probability, 2)) +
+                             (received / std::pow(1.0 - loss_probability, 2)));
+    }
+  }
+
+  for (double& second_derivative : candidates.second_derivative) {
+    if (second_derivative >= 0.0) {
+      RTC_LOG(LS_ERROR) << "The second derivative is mathematically "
+                           "guaranteed to be negative but is "
+                        << second_derivative << ".";
+      second_derivative = -1.0e-6;
+    }
+  }
+}
+
+void LossBasedBweV2::ComputeObjectives() {
+  const ObservationBatch& observations = observation_batch_;
+  CandidateBatch& candidates = candidate_batch_;
+  const size_t num_candidates = candidates.inherent_loss.size();
+  absl::c_fill(candidates.objective, 0.0);
+  // A candidate has its inherent loss as loss probability at all sending rates
+  // up to its bandwidth, so the logarithms of that are computed once.
+  for (size_t j = 0; j < num_candidates; ++j) {
+    candidates.inherent_loss_probability[j] = GetLossProbability(
+        candidates.inherent_loss[j], candidates.bandwidth_bps[j], 0.0);
+    candidates.log_inherent_loss_probability[j] =
+        std::log(candidates.inherent_loss_probability[j]);
+    candidates.log_inherent_no_loss_probability[j] =
+        std::log(1.0 - candidates.inherent_loss_probability[j]);
+  }
+  for (size_t i = 0; i < observations.temporal_weight.size(); ++i) {
+    const double temporal_weight = observations.temporal_weight[i];
+    const double sending_rate_bps = observations.sending_rate_bps[i];
+    const double lost = observations.lost[i];
+    const double received = observations.received[i];
+    const double total = observations.total[i];
+    for (size_t j = 0; j < num_candidates; ++j) {
+      const double loss_probability =
+          GetLossProbability(candidates.inherent_loss[j],
+                             candidates.bandwidth_bps[j], sending_rate_bps);
+      double log_loss_probability;
+      double log_no_loss_probability;
+      if (loss_probability == candidates.inherent_loss_probability[j]) {
+        log_loss_probability = candidates.log_inherent_loss_probability[j];
+        log_no_loss_probability =
+            candidates.log_inherent_no_loss_probability[j];
+      } else {
+        log_loss_probability = std::log(loss_probability);
+        log_no_loss_probability = std::log(1.0 - loss_probability);
+      }
+      candidates.objective[j] +=
+          temporal_weight * ((lost * log_loss_probability) +
+                             (received * log_no_loss_probability));
+      candidates.objective[j] +=
+          temporal_weight * candidates.high_bandwidth_bias[j] * total;
+    }
   }
 }
 
@@ -128,11 +128,6 @@ class LossBasedBweV2 {
     bool pace_at_loss_based_estimate = false;
   };
 
-  struct Derivatives {
-    double first = 0.0;
-    double second = 0.0;
-  };
-
   struct Observation {
     bool IsInitialized() const { return id != -1; }
 
@@ -145,6 +140,32 @@ class LossBasedBweV2 {
     int id = -1;
   };
 
+  // The initialized observations in the order of `observations_`, with one
+  // array per field, so that all candidates are evaluated in one pass.
+  struct ObservationBatch {
+    std::vector<double> temporal_weight;
+    std::vector<double> sending_rate_bps;
+    // In packets, or in kilobytes if `use_byte_loss_rate` is set.
+    std::vector<double> lost;
+    std::vector<double> received;
+    std::vector<double> total;
+  };
+
+  // The candidates with one array per field.
+  struct CandidateBatch {
+    std::vector<double> inherent_loss;
+    std::vector<double> inherent_loss_upper_bound;
+    std::vector<double> bandwidth_bps;
+    std::vector<double> first_derivative;
+    std::vector<double> second_derivative;
+    std::vector<double> high_bandwidth_bias;
+    std::vector<double> objective;
+    // The loss probability when sending below the bandwidth, and logarithms.
+    std::vector<double> inherent_loss_probability;
+    std::vector<double> log_inherent_loss_probability;
+    std::vector<double> log_inherent_no_loss_probability;
+  };
+
   struct PartialObservation {
     int num_packets = 0;
     int num_lost_packets = 0;
@@ -173,13 +194,12 @@ class LossBasedBweV2 {
   double GetAverageReportedByteLossRatio() const;
   std::vector<ChannelParameters> GetCandidates(bool in_alr) const;
   DataRate GetCandidateBandwidthUpperBound() const;
-  Derivatives GetDerivatives(const ChannelParameters& channel_parameters) const;
   double GetFeasibleInherentLoss(
       const ChannelParameters& channel_parameters) const;
   double GetInherentLossUpperBound(DataRate bandwidth) const;
   double AdjustBiasFactor(double loss_rate, double bias_factor) const;
-  double GetHighBandwidthBias(DataRate bandwidth) const;
-  double GetObjective(const ChannelParameters& channel_parameters) const;
+  double GetHighBandwidthBias(DataRate bandwidth,
+                              double average_reported_loss_ratio) const;
   DataRate GetSendingRate(DataRate instantaneous_sending_rate) const;
   DataRate GetInstantUpperBound() const;
   void CalculateInstantUpperBound();
@@ -187,7 +207,13 @@ class LossBasedBweV2 {
   void CalculateInstantLowerBound();
 
   void CalculateTemporalWeights();
-  void NewtonsMethodUpdate(ChannelParameters& channel_parameters) const;
+
+  // Evaluates all `candidates` at once: runs Newton's method on their
+  // inherent loss and computes their objective, into `candidate_batch_`.
+  void EvaluateCandidates(rtc::ArrayView<const ChannelParameters> candidates);
+  void FillObservationBatch();
+  void ComputeDerivatives();
+  void ComputeObjectives();
 
   // Returns false if no observation was created.
   bool PushBackObservation(rtc::ArrayView<const PacketResult> packet_results);
@@ -208,6 +234,8 @@ class LossBasedBweV2 {
   absl::optional<DataRate> cached_instant_lower_bound_;
   std::vector<double> instant_upper_bound_temporal_weights_;
   std::vector<double> temporal_weights_;
+  ObservationBatch observation_batch_;
+  CandidateBatch candidate_batch_;
   Timestamp recovering_after_loss_timestamp_ = Timestamp::MinusInfinity();
   DataRate bandwidth_limit_in_current_window_ = DataRate::PlusInfinity();
   DataRate min_bitrate_ = DataRate::KilobitsPerSec(1);
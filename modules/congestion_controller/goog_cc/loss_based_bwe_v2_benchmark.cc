@@ -0,0 +1,82 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <string>
+#include <vector>
+
+#include "absl/strings/str_cat.h"
+#include "api/transport/network_types.h"
+#include "api/units/data_rate.h"
+#include "api/units/data_size.h"
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "benchmark/benchmark.h"
+#include "modules/congestion_controller/goog_cc/loss_based_bwe_v2.h"
+#include "test/explicit_key_value_config.h"
+
+namespace webrtc {
+namespace {
+
+constexpr int kPacketsPerObservation = 20;
+constexpr TimeDelta kPacketInterval = TimeDelta::Millis(20);
+
+// Updates the estimate with one full observation of 5 % loss per iteration,
+// with `state.range(0)` candidate factors, `state.range(1)` Newton iterations
+// and byte loss rate if `state.range(2)` is set. The observation window is
+// full throughout.
+void BM_UpdateBandwidthEstimate(benchmark::State& state) {
+  const int num_candidate_factors = state.range(0);
+  std::string candidate_factors;
+  for (int i = 0; i < num_candidate_factors; ++i) {
+    absl::StrAppend(&candidate_factors, i == 0 ? "" : "|",
+                    1.1 - 0.05 * i);
+  }
+  test::ExplicitKeyValueConfig field_trials(absl::StrCat(
+      "WebRTC-Bwe-LossBasedBweV2/Enabled:true,CandidateFactors:",
+      candidate_factors, ",NewtonIterations:", state.range(1),
+      ",UseByteLossRate:", state.range(2) != 0 ? "true" : "false", "/"));
+  LossBasedBweV2 loss_based_bwe(&field_trials);
+  loss_based_bwe.SetMinMaxBitrate(DataRate::KilobitsPerSec(10),
+                                  DataRate::KilobitsPerSec(10000));
+  loss_based_bwe.SetBandwidthEstimate(DataRate::KilobitsPerSec(1000));
+  loss_based_bwe.SetAcknowledgedBitrate(DataRate::KilobitsPerSec(900));
+
+  std::vector<PacketResult> packet_results(kPacketsPerObservation);
+  Timestamp now = Timestamp::Seconds(100);
+  auto update = [&] {
+    for (size_t i = 0; i < packet_results.size(); ++i) {
+      PacketResult& packet = packet_results[i];
+      packet.sent_packet.size = DataSize::Bytes(1000);
+      packet.sent_packet.send_time = now;
+      packet.receive_time = i == 0 ? Timestamp::PlusInfinity()
+                                   : now + TimeDelta::Millis(30);
+      now += kPacketInterval;
+    }
+    loss_based_bwe.UpdateBandwidthEstimate(packet_results,
+                                           DataRate::KilobitsPerSec(2000),
+                                           /*in_alr=*/false);
+  };
+  // Fills the observation window.
+  for (int i = 0; i < 100; ++i) {
+    update();
+  }
+
+  for (auto _ : state) {
+    update();
+  }
+  benchmark::DoNotOptimize(loss_based_bwe.GetLossBasedResult());
+}
+
+BENCHMARK(BM_UpdateBandwidthEstimate)
+    ->ArgsProduct({{3, 9}, {1, 4}, {0, 1}})
+    ->ArgNames({"factors", "newton", "byte_loss"});
+
+}  // namespace
+}  // namespace webrtc
@@ -10,14 +10,18 @@
 
 #include "modules/congestion_controller/goog_cc/loss_based_bwe_v2.h"
 
+#include <cstdint>
+#include <iterator>
 #include <string>
 #include <vector>
 
+#include "api/field_trials_view.h"
 #include "api/transport/network_types.h"
 #include "api/units/data_rate.h"
 #include "api/units/data_size.h"
 #include "api/units/time_delta.h"
 #include "api/units/timestamp.h"
+#include "rtc_base/random.h"
 #include "rtc_base/strings/string_builder.h"
 #include "test/explicit_key_value_config.h"
 #include "test/gtest.h"
@@ -33,6 +37,48 @@ constexpr TimeDelta kDelayedIncreaseWindow = TimeDelta::Millis(300);
 constexpr double kMaxIncreaseFactor = 1.5;
 constexpr int kPacketSize = 15'000;
 
+// Runs `num_updates` updates with feedback, acknowledged bitrates and delay
+// based estimates drawn from a fixed seed, with a loss rate that changes now
+// and then. Returns the loss based estimate after each update.
+std::vector<int64_t> EstimatesForRandomFeedback(const FieldTrialsView& config,
+                                                int num_updates) {
+  Random random(/*seed=*/0x2024);
+  LossBasedBweV2 loss_based_bandwidth_estimator(&config);
+  loss_based_bandwidth_estimator.SetMinMaxBitrate(
+      /*min_bitrate=*/DataRate::KilobitsPerSec(10),
+      /*max_bitrate=*/DataRate::KilobitsPerSec(10000));
+  loss_based_bandwidth_estimator.SetBandwidthEstimate(
+      DataRate::KilobitsPerSec(1000));
+  Timestamp now = Timestamp::Seconds(100);
+  double loss_rate = 0.05;
+  std::vector<int64_t> estimates;
+  for (int i = 0; i < num_updates; ++i) {
+    if (random.Rand(10) == 0) {
+      loss_rate = 0.01 * random.Rand(15);
+    }
+    std::vector<PacketResult> feedback(10 + random.Rand(20));
+    for (PacketResult& packet : feedback) {
+      packet.sent_packet.size = DataSize::Bytes(100 + random.Rand(1100));
+      packet.sent_packet.send_time = now;
+      now += TimeDelta::Micros(5000 + random.Rand(10000));
+      packet.receive_time = random.Rand<double>() < loss_rate
+                                ? Timestamp::PlusInfinity()
+                                : now + TimeDelta::Millis(30);
+    }
+    loss_based_bandwidth_estimator.SetAcknowledgedBitrate(
+        DataRate::KilobitsPerSec(100 + random.Rand(3000)));
+    loss_based_bandwidth_estimator.UpdateBandwidthEstimate(
+        feedback,
+        /*delay_based_estimate=*/
+        DataRate::KilobitsPerSec(200 + random.Rand(4000)),
+        /*in_alr=*/random.Rand(4) == 0);
+    estimates.push_back(
+        loss_based_bandwidth_estimator.GetLossBasedResult()
+            .bandwidth_estimate.bps());
+  }
+  return estimates;
+}
+
 class LossBasedBweV2Test : public ::testing::TestWithParam<bool> {
  protected:
   std::string Config(bool enabled, bool valid) {
@@ -1812,5 +1858,49 @@ TEST_F(LossBasedBweV2Test, PaceAtLossBasedEstimate) {
   EXPECT_TRUE(loss_based_bandwidth_estimator.PaceAtLossBasedEstimate());
 }
 
+// The estimates below were recorded with the implementation that evaluated one
+// candidate at a time. Estimates are whole bps, so one bps is allowed for
+// floating point differences between platforms.
+TEST_F(LossBasedBweV2Test, MatchesRecordedEstimatesWithDefaultConfig) {
+  const int64_t kRecordedEstimates[] = {
+      2657000, 2952000, 2118000, 3176000, 2051000, 1000000, 1000000, 1000000,
+      1000000, 1000000, 1000000, 1000000, 1000000, 376000, 376000, 773000,
+      773000, 1000000, 1000000, 1000000, 1000000, 1000000, 1000000, 1000000,
+      1000000, 1000000, 1000000, 1000000, 1000000, 1000000, 1000000, 1000000,
+      987307, 927410, 927410, 843751, 843751, 982990, 982990, 904574, 904574,
+      843173, 843173, 807000, 763918, 763918, 745347, 745347, 768108, 791198,
+      791198, 801500, 801500, 809021, 414000, 414000, 936301, 936301, 936301,
+      950000};
+  ExplicitKeyValueConfig key_value_config(
+      "WebRTC-Bwe-LossBasedBweV2/Enabled:true/");
+  std::vector<int64_t> estimates = EstimatesForRandomFeedback(
+      key_value_config, std::size(kRecordedEstimates));
+  for (size_t i = 0; i < estimates.size(); ++i) {
+    EXPECT_NEAR(estimates[i], kRecordedEstimates[i], 1) << "Update " << i;
+  }
+}
+
+TEST_F(LossBasedBweV2Test, MatchesRecordedEstimatesWithManyCandidates) {
+  const int64_t kRecordedEstimates[] = {
+      2657000, 2952000, 2118000, 3176000, 2051000, 1300000, 1300000, 1300000,
+      1510000, 1510000, 1690000, 1690000, 1690000, 376000, 376000, 773000,
+      773000, 1232489, 1232489, 1467054, 1467054, 1175230, 1175230, 1263309,
+      1263309, 1147031, 1137067, 1137067, 1154244, 1154244, 1072673, 1072673,
+      1048816, 948760, 948760, 863564, 863564, 1028674, 1028674, 912834, 912834,
+      872889, 872889, 807000, 822369, 822369, 800034, 800034, 843367, 861421,
+      861421, 839964, 839964, 805315, 414000, 414000, 938895, 938895, 938895,
+      1187500};
+  ExplicitKeyValueConfig key_value_config(
+      "WebRTC-Bwe-LossBasedBweV2/Enabled:true,UseByteLossRate:true,"
+      "NewtonIterations:4,CandidateFactors:1.3|1.1|1.0|0.95|0.9|0.8,"
+      "HigherBwBiasFactor:0.01,HigherLogBwBiasFactor:0.001,"
+      "ObservationWindowSize:40/");
+  std::vector<int64_t> estimates = EstimatesForRandomFeedback(
+      key_value_config, std::size(kRecordedEstimates));
+  for (size_t i = 0; i < estimates.size(); ++i) {
+    EXPECT_NEAR(estimates[i], kRecordedEstimates[i], 1) << "Update " << i;
+  }
+}
+
 }  // namespace
 }  // namespace webrtc
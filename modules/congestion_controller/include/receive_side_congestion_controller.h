@@ -60,6 +60,10 @@ class ReceiveSideCongestionController : public CallStatsObserver {
 
   void SetTransportOverhead(DataSize overhead_per_packet);
 
+  // Splits transport-wide feedback into packets of at most
+  // `max_feedback_size`.
+  void SetMaxTransportFeedbackSize(DataSize max_feedback_size);
+
   // Returns latest receive side bandwidth estimation.
   // Returns zero if receive side bandwidth estimation is unavailable.
   DataRate LatestReceiveSideEstimate() const;
@@ -0,0 +1,100 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_CONGESTION_CONTROLLER_INCLUDE_TRANSPORT_FEEDBACK_COALESCER_H_
+#define MODULES_CONGESTION_CONTROLLER_INCLUDE_TRANSPORT_FEEDBACK_COALESCER_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "api/task_queue/task_queue_base.h"
+#include "api/units/data_rate.h"
+#include "api/units/data_size.h"
+#include "api/units/time_delta.h"
+#include "modules/remote_bitrate_estimator/rtp_transport_feedback_generator.h"
+#include "rtc_base/rate_statistics.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/task_utils/repeating_task.h"
+#include "rtc_base/thread_annotations.h"
+#include "system_wrappers/include/clock.h"
+
+namespace webrtc {
+
+class ReceiveSideCongestionController;
+
+// Runs the periodic feedback of many ReceiveSideCongestionControllers, e.g.
+// one per Call on a server receiving from many senders, from a single task on
+// a shared task queue. Instead of one wakeup per controller and feedback
+// interval, all feedback that is due is built and sent in the same tick.
+class TransportFeedbackCoalescer {
+ public:
+  struct Config {
+    // Period of the shared task. Feedback is sent up to this much later than
+    // a controller would send it on its own.
+    TimeDelta tick_interval = TimeDelta::Millis(50);
+    // Transport feedback larger than this is split into several packets.
+    DataSize max_feedback_size = DataSize::PlusInfinity();
+  };
+
+  struct Stats {
+    int64_t ticks = 0;
+    // Feedback sent through senders from WrapFeedbackSender, including remote
+    // estimates sent along with transport feedback.
+    int64_t feedback_messages = 0;
+    DataSize feedback_size = DataSize::Zero();
+    // Feedback rate over the last second.
+    DataRate feedback_rate = DataRate::Zero();
+  };
+
+  // Controllers are added and removed, and ticks run, on `task_queue`.
+  TransportFeedbackCoalescer(TaskQueueBase* task_queue,
+                             Clock* clock,
+                             Config config);
+  TransportFeedbackCoalescer(const TransportFeedbackCoalescer&) = delete;
+  TransportFeedbackCoalescer& operator=(const TransportFeedbackCoalescer&) =
+      delete;
+  ~TransportFeedbackCoalescer();
+
+  TaskQueueBase* task_queue() const { return task_queue_; }
+
+  // Returns `feedback_sender` wrapped to count what it sends in the stats.
+  // The returned sender must not be used after the coalescer is destroyed.
+  RtpTransportFeedbackGenerator::RtcpSender WrapFeedbackSender(
+      RtpTransportFeedbackGenerator::RtcpSender feedback_sender);
+
+  // Processes `controller` on every tick until it is removed, which must
+  // happen before it is destroyed.
+  void AddController(ReceiveSideCongestionController* controller);
+  void RemoveController(ReceiveSideCongestionController* controller);
+
+  Stats GetStats() const;
+
+ private:
+  TimeDelta Tick();
+  void OnFeedbackSent(DataSize size);
+
+  TaskQueueBase* const task_queue_;
+  Clock* const clock_;
+  const Config config_;
+
+  std::vector<ReceiveSideCongestionController*> controllers_
+      RTC_GUARDED_BY(task_queue_);
+  RepeatingTaskHandle tick_task_ RTC_GUARDED_BY(task_queue_);
+
+  // Feedback may also be sent on request while packets are received, which
+  // may happen on another thread.
+  mutable Mutex stats_lock_;
+  Stats stats_ RTC_GUARDED_BY(stats_lock_);
+  RateStatistics feedback_rate_ RTC_GUARDED_BY(stats_lock_);
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_CONGESTION_CONTROLLER_INCLUDE_TRANSPORT_FEEDBACK_COALESCER_H_
@@ -169,4 +169,10 @@ void ReceiveSideCongestionController::SetTransportOverhead(
       overhead_per_packet);
 }
 
+void ReceiveSideCongestionController::SetMaxTransportFeedbackSize(
+    DataSize max_feedback_size) {
+  transport_sequence_number_feedback_generator_.SetMaxFeedbackSize(
+      max_feedback_size);
+}
+
 }  // namespace webrtc
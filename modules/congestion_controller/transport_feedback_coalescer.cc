@@ -0,0 +1,123 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/congestion_controller/include/transport_feedback_coalescer.h"
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "absl/algorithm/container.h"
+#include "absl/types/optional.h"
+#include "modules/congestion_controller/include/receive_side_congestion_controller.h"
+#include "modules/rtp_rtcp/source/rtcp_packet.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+namespace {
+
+constexpr int64_t kFeedbackRateWindowMs = 1000;
+
+}  // namespace
+
+TransportFeedbackCoalescer::TransportFeedbackCoalescer(
+    TaskQueueBase* task_queue,
+    Clock* clock,
+    Config config)
+    : task_queue_(task_queue),
+      clock_(clock),
+      config_(config),
+      feedback_rate_(kFeedbackRateWindowMs, RateStatistics::kBpsScale) {
+  RTC_DCHECK(task_queue_);
+  RTC_DCHECK(config_.tick_interval.IsFinite());
+  RTC_DCHECK_GT(config_.tick_interval, TimeDelta::Zero());
+}
+
+TransportFeedbackCoalescer::~TransportFeedbackCoalescer() {
+  RTC_DCHECK_RUN_ON(task_queue_);
+  RTC_DCHECK(controllers_.empty());
+  tick_task_.Stop();
+}
+
+RtpTransportFeedbackGenerator::RtcpSender
+TransportFeedbackCoalescer::WrapFeedbackSender(
+    RtpTransportFeedbackGenerator::RtcpSender feedback_sender) {
+  return [this, feedback_sender = std::move(feedback_sender)](
+             std::vector<std::unique_ptr<rtcp::RtcpPacket>> packets) {
+    size_t size = 0;
+    for (const std::unique_ptr<rtcp::RtcpPacket>& packet : packets) {
+      size += packet->BlockLength();
+    }
+    OnFeedbackSent(DataSize::Bytes(size));
+    feedback_sender(std::move(packets));
+  };
+}
+
+void TransportFeedbackCoalescer::AddController(
+    ReceiveSideCongestionController* controller) {
+  RTC_DCHECK_RUN_ON(task_queue_);
+  RTC_DCHECK(!absl::c_linear_search(controllers_, controller));
+  controller->SetMaxTransportFeedbackSize(config_.max_feedback_size);
+  controllers_.push_back(controller);
+  if (!tick_task_.Running()) {
+    tick_task_ = RepeatingTaskHandle::Start(
+        task_queue_, [this] { return Tick(); },
+        TaskQueueBase::DelayPrecision::kLow, clock_);
+  }
+}
+
+void TransportFeedbackCoalescer::RemoveController(
+    ReceiveSideCongestionController* controller) {
+  RTC_DCHECK_RUN_ON(task_queue_);
+  auto it = absl::c_find(controllers_, controller);
+  RTC_DCHECK(it != controllers_.end());
+  if (it == controllers_.end()) {
+    return;
+  }
+  // Order doesn't matter, all controllers are processed in the same tick.
+  *it = controllers_.back();
+  controllers_.pop_back();
+  if (controllers_.empty()) {
+    tick_task_.Stop();
+  }
+}
+
+TransportFeedbackCoalescer::Stats TransportFeedbackCoalescer::GetStats()
+    const {
+  MutexLock lock(&stats_lock_);
+  Stats stats = stats_;
+  absl::optional<int64_t> rate_bps =
+      feedback_rate_.Rate(clock_->TimeInMilliseconds());
+  stats.feedback_rate = DataRate::BitsPerSec(rate_bps.value_or(0));
+  return stats;
+}
+
+TimeDelta TransportFeedbackCoalescer::Tick() {
+  RTC_DCHECK_RUN_ON(task_queue_);
+  {
+    MutexLock lock(&stats_lock_);
+    ++stats_.ticks;
+  }
+  // Each controller only sends the feedback that is due, and otherwise returns
+  // early. The time until it is due again is ignored in favor of the tick.
+  for (ReceiveSideCongestionController* controller : controllers_) {
+    controller->MaybeProcess();
+  }
+  return config_.tick_interval;
+}
+
+void TransportFeedbackCoalescer::OnFeedbackSent(DataSize size) {
+  MutexLock lock(&stats_lock_);
+  ++stats_.feedback_messages;
+  stats_.feedback_size += size;
+  feedback_rate_.Update(size.bytes(), clock_->TimeInMilliseconds());
+}
+
+}  // namespace webrtc
@@ -0,0 +1,161 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/congestion_controller/include/transport_feedback_coalescer.h"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "api/environment/environment.h"
+#include "api/environment/environment_factory.h"
+#include "api/media_types.h"
+#include "api/units/data_rate.h"
+#include "api/units/data_size.h"
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "modules/congestion_controller/include/receive_side_congestion_controller.h"
+#include "modules/rtp_rtcp/include/rtp_header_extension_map.h"
+#include "modules/rtp_rtcp/source/rtcp_packet.h"
+#include "modules/rtp_rtcp/source/rtp_header_extensions.h"
+#include "modules/rtp_rtcp/source/rtp_packet_received.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+#include "test/time_controller/simulated_time_controller.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::AtLeast;
+using ::testing::MockFunction;
+
+using RtcpPackets = std::vector<std::unique_ptr<rtcp::RtcpPacket>>;
+
+class ReceiveSide {
+ public:
+  ReceiveSide(const Environment& env, TransportFeedbackCoalescer& coalescer)
+      : controller_(env,
+                    coalescer.WrapFeedbackSender(
+                        feedback_sender_.AsStdFunction()),
+                    remb_sender_.AsStdFunction(),
+                    /*network_state_estimator=*/nullptr) {
+    extensions_.Register<TransportSequenceNumber>(1);
+  }
+
+  void ReceivePackets(Timestamp arrival_time, int num_packets) {
+    for (int i = 0; i < num_packets; ++i) {
+      RtpPacketReceived packet(&extensions_, arrival_time);
+      packet.SetSsrc(0x1234);
+      packet.SetExtension<TransportSequenceNumber>(sequence_number_++);
+      controller_.OnReceivedPacket(packet, MediaType::VIDEO);
+    }
+  }
+
+  ReceiveSideCongestionController& controller() { return controller_; }
+  MockFunction<void(RtcpPackets)>& feedback_sender() {
+    return feedback_sender_;
+  }
+
+ private:
+  MockFunction<void(RtcpPackets)> feedback_sender_;
+  MockFunction<void(uint64_t, std::vector<uint32_t>)> remb_sender_;
+  RtpHeaderExtensionMap extensions_;
+  uint16_t sequence_number_ = 0;
+  ReceiveSideCongestionController controller_;
+};
+
+class TransportFeedbackCoalescerTest : public ::testing::Test {
+ protected:
+  explicit TransportFeedbackCoalescerTest(
+      TransportFeedbackCoalescer::Config config = {})
+      : time_controller_(Timestamp::Seconds(1000)),
+        env_(CreateEnvironment(time_controller_.GetClock())),
+        coalescer_(time_controller_.GetMainThread(),
+                   time_controller_.GetClock(),
+                   config) {}
+
+  Timestamp Now() { return time_controller_.GetClock()->CurrentTime(); }
+
+  GlobalSimulatedTimeController time_controller_;
+  const Environment env_;
+  TransportFeedbackCoalescer coalescer_;
+};
+
+TEST_F(TransportFeedbackCoalescerTest, SendsFeedbackOfAllControllers) {
+  ReceiveSide first(env_, coalescer_);
+  ReceiveSide second(env_, coalescer_);
+  coalescer_.AddController(&first.controller());
+  coalescer_.AddController(&second.controller());
+
+  first.ReceivePackets(Now(), 10);
+  second.ReceivePackets(Now(), 10);
+  EXPECT_CALL(first.feedback_sender(), Call).Times(AtLeast(1));
+  EXPECT_CALL(second.feedback_sender(), Call).Times(AtLeast(1));
+  time_controller_.AdvanceTime(TimeDelta::Millis(200));
+
+  TransportFeedbackCoalescer::Stats stats = coalescer_.GetStats();
+  EXPECT_GE(stats.feedback_messages, 2);
+  EXPECT_GT(stats.feedback_size, DataSize::Zero());
+  EXPECT_GT(stats.feedback_rate, DataRate::Zero());
+  // One tick when the first controller is added, then one every 50 ms.
+  EXPECT_EQ(stats.ticks, 5);
+
+  coalescer_.RemoveController(&first.controller());
+  coalescer_.RemoveController(&second.controller());
+}
+
+TEST_F(TransportFeedbackCoalescerTest, StopsProcessingRemovedController) {
+  ReceiveSide first(env_, coalescer_);
+  ReceiveSide second(env_, coalescer_);
+  coalescer_.AddController(&first.controller());
+  coalescer_.AddController(&second.controller());
+  coalescer_.RemoveController(&first.controller());
+
+  first.ReceivePackets(Now(), 10);
+  second.ReceivePackets(Now(), 10);
+  EXPECT_CALL(first.feedback_sender(), Call).Times(0);
+  EXPECT_CALL(second.feedback_sender(), Call).Times(AtLeast(1));
+  time_controller_.AdvanceTime(TimeDelta::Millis(200));
+
+  coalescer_.RemoveController(&second.controller());
+  const int64_t ticks = coalescer_.GetStats().ticks;
+  time_controller_.AdvanceTime(TimeDelta::Millis(200));
+  EXPECT_EQ(coalescer_.GetStats().ticks, ticks);
+}
+
+class TransportFeedbackCoalescerMaxSizeTest
+    : public TransportFeedbackCoalescerTest {
+ protected:
+  static constexpr DataSize kMaxFeedbackSize = DataSize::Bytes(40);
+
+  TransportFeedbackCoalescerMaxSizeTest()
+      : TransportFeedbackCoalescerTest(
+            {.max_feedback_size = kMaxFeedbackSize}) {}
+};
+
+TEST_F(TransportFeedbackCoalescerMaxSizeTest, SplitsLargeFeedback) {
+  ReceiveSide receive_side(env_, coalescer_);
+  coalescer_.AddController(&receive_side.controller());
+
+  receive_side.ReceivePackets(Now(), 100);
+  EXPECT_CALL(receive_side.feedback_sender(), Call)
+      .Times(AtLeast(2))
+      .WillRepeatedly([&](RtcpPackets packets) {
+        for (const auto& packet : packets) {
+          EXPECT_LE(DataSize::Bytes(packet->BlockLength()), kMaxFeedbackSize);
+        }
+      });
+  time_controller_.AdvanceTime(TimeDelta::Millis(200));
+
+  coalescer_.RemoveController(&receive_side.controller());
+}
+
+}  // namespace
+}  // namespace webrtc
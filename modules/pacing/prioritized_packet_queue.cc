@@ -79,64 +79,7 @@ DataSize PrioritizedPacketQueue::QueuedPacket::PacketSize() const {
 }
 
 PrioritizedPacketQueue::StreamQueue::StreamQueue(Timestamp creation_time)
-    : last_enqueue_time_(creation_time), num_keyframe_packets_(0) {}
-
-bool PrioritizedPacketQueue::StreamQueue::EnqueuePacket(QueuedPacket packet,
-                                                        int priority_level) {
-  if (packet.packet->is_key_frame()) {
-    ++num_keyframe_packets_;
-  }
-  bool first_packet_at_level = packets_[priority_level].empty();
-  packets_[priority_level].push_back(std::move(packet));
-  return first_packet_at_level;
-}
-
-PrioritizedPacketQueue::QueuedPacket
-PrioritizedPacketQueue::StreamQueue::DequeuePacket(int priority_level) {
-  RTC_DCHECK(!packets_[priority_level].empty());
-  QueuedPacket packet = std::move(packets_[priority_level].front());
-  packets_[priority_level].pop_front();
-  if (packet.packet->is_key_frame()) {
-    RTC_DCHECK_GT(num_keyframe_packets_, 0);
-    --num_keyframe_packets_;
-  }
-  return packet;
-}
-
-bool PrioritizedPacketQueue::StreamQueue::HasPacketsAtPrio(
-    int priority_level) const {
-  return !packets_[priority_level].empty();
-}
-
-bool PrioritizedPacketQueue::StreamQueue::IsEmpty() const {
-  for (const std::deque<QueuedPacket>& queue : packets_) {
-    if (!queue.empty()) {
-      return false;
-    }
-  }
-  return true;
-}
-
-Timestamp PrioritizedPacketQueue::StreamQueue::LeadingPacketEnqueueTime(
-    int priority_level) const {
-  RTC_DCHECK(!packets_[priority_level].empty());
-  return packets_[priority_level].begin()->enqueue_time;
-}
-
-Timestamp PrioritizedPacketQueue::StreamQueue::LastEnqueueTime() const {
-  return last_enqueue_time_;
-}
-
-std::array<std::deque<PrioritizedPacketQueue::QueuedPacket>,
-           PrioritizedPacketQueue::kNumPriorityLevels>
-PrioritizedPacketQueue::StreamQueue::DequeueAll() {
-  std::array<std::deque<QueuedPacket>, kNumPriorityLevels> packets_by_prio;
-  for (int i = 0; i < kNumPriorityLevels; ++i) {
-    packets_by_prio[i].swap(packets_[i]);
-  }
-  num_keyframe_packets_ = 0;
-  return packets_by_prio;
-}
+    : last_enqueue_time(creation_time) {}
 
 PrioritizedPacketQueue::PrioritizedPacketQueue(
     Timestamp creation_time,
@@ -156,15 +99,8 @@ PrioritizedPacketQueue::PrioritizedPacketQueue(
 
 void PrioritizedPacketQueue::Push(Timestamp enqueue_time,
                                   std::unique_ptr<RtpPacketToSend> packet) {
-  StreamQueue* stream_queue;
-  auto [it, inserted] = streams_.emplace(packet->Ssrc(), nullptr);
-  if (inserted) {
-    it->second = std::make_unique<StreamQueue>(enqueue_time);
-  }
-  stream_queue = it->second.get();
+  StreamQueue* stream_queue = GetOrCreateStream(packet->Ssrc(), enqueue_time);
 
-  auto enqueue_time_iterator =
-      enqueue_times_.insert(enqueue_times_.end(), enqueue_time);
   RTC_DCHECK(packet->packet_type().has_value());
   RtpPacketMediaType packet_type = packet->packet_type().value();
   int prio_level =
@@ -174,9 +110,18 @@ void PrioritizedPacketQueue::Push(Timestamp enqueue_time,
   PurgeOldPacketsAtPriorityLevel(prio_level, enqueue_time);
   RTC_DCHECK_GE(prio_level, 0);
   RTC_DCHECK_LT(prio_level, kNumPriorityLevels);
-  QueuedPacket queued_packed = {.packet = std::move(packet),
-                                .enqueue_time = enqueue_time,
-                                .enqueue_time_iterator = enqueue_time_iterator};
+
+  int index = first_free_packet_;
+  if (index != kNoPacket) {
+    first_free_packet_ = packets_[index].next_in_stream;
+  } else {
+    index = static_cast<int>(packets_.size());
+    packets_.emplace_back();
+  }
+  QueuedPacket& queued_packet = packets_[index];
+  queued_packet.packet = std::move(packet);
+  queued_packet.original_enqueue_time = enqueue_time;
+  queued_packet.stream = stream_queue;
   // In order to figure out how much time a packet has spent in the queue
   // while not in a paused state, we subtract the total amount of time the
   // queue has been paused so far, and when the packet is popped we subtract
@@ -184,15 +129,16 @@ void PrioritizedPacketQueue::Push(Timestamp enqueue_time,
   // way we subtract the total amount of time the packet has spent in the
   // queue while in a paused state.
   UpdateAverageQueueTime(enqueue_time);
-  queued_packed.enqueue_time -= pause_time_sum_;
+  queued_packet.enqueue_time = enqueue_time - pause_time_sum_;
   ++size_packets_;
   ++size_packets_per_media_type_[static_cast<size_t>(packet_type)];
-  size_payload_ += queued_packed.PacketSize();
+  size_payload_ += queued_packet.PacketSize();
 
-  if (stream_queue->EnqueuePacket(std::move(queued_packed), prio_level)) {
-    // Number packets at `prio_level` for this steam is now non-zero.
-    streams_by_prio_[prio_level].push_back(stream_queue);
+  if (queued_packet.packet->is_key_frame()) {
+    ++stream_queue->num_keyframe_packets;
   }
+  stream_queue->last_enqueue_time = enqueue_time;
+  LinkPacket(index, prio_level);
   if (top_active_prio_level_ < 0 || prio_level < top_active_prio_level_) {
     top_active_prio_level_ = prio_level;
   }
@@ -201,7 +147,10 @@ void PrioritizedPacketQueue::Push(Timestamp enqueue_time,
   if (enqueue_time - last_culling_time_ > kTimeout) {
     for (auto it = streams_.begin(); it != streams_.end();) {
       if (it->second->IsEmpty() &&
-          it->second->LastEnqueueTime() + kTimeout < enqueue_time) {
+          it->second->last_enqueue_time + kTimeout < enqueue_time) {
+        if (it->second.get() == last_stream_) {
+          last_stream_ = nullptr;
+        }
         streams_.erase(it++);
       } else {
         ++it;
@@ -217,16 +166,15 @@ std::unique_ptr<RtpPacketToSend> PrioritizedPacketQueue::Pop() {
   }
 
   RTC_DCHECK_GE(top_active_prio_level_, 0);
-  StreamQueue& stream_queue = *streams_by_prio_[top_active_prio_level_].front();
-  QueuedPacket packet = stream_queue.DequeuePacket(top_active_prio_level_);
+  PriorityLevel& level = levels_[top_active_prio_level_];
+  StreamQueue& stream_queue = *level.next_stream;
+  // Move on to the next stream in the ring, which is this stream again if it
+  // is the only one.
+  level.next_stream = stream_queue.levels[top_active_prio_level_].next;
+  QueuedPacket packet =
+      ReleasePacket(UnlinkFirstPacket(stream_queue, top_active_prio_level_));
   DequeuePacketInternal(packet);
-
-  // Remove StreamQueue from head of fifo-queue for this prio level, and
-  // and add it to the end if it still has packets.
-  streams_by_prio_[top_active_prio_level_].pop_front();
-  if (stream_queue.HasPacketsAtPrio(top_active_prio_level_)) {
-    streams_by_prio_[top_active_prio_level_].push_back(&stream_queue);
-  } else {
+  if (!stream_queue.HasPacketsAtPrio(top_active_prio_level_)) {
     MaybeUpdateTopPrioLevel();
   }
 
@@ -254,11 +202,10 @@ Timestamp PrioritizedPacketQueue::LeadingPacketEnqueueTime(
     RtpPacketMediaType type) const {
   RTC_DCHECK(type != RtpPacketMediaType::kRetransmission);
   const int priority_level = GetPriorityForType(type, absl::nullopt);
-  if (streams_by_prio_[priority_level].empty()) {
+  if (levels_[priority_level].next_stream == nullptr) {
     return Timestamp::MinusInfinity();
   }
-  return streams_by_prio_[priority_level].front()->LeadingPacketEnqueueTime(
-      priority_level);
+  return LeadingPacketEnqueueTimeAtLevel(priority_level);
 }
 
 Timestamp PrioritizedPacketQueue::LeadingPacketEnqueueTimeForRetransmission()
@@ -266,11 +213,7 @@ Timestamp PrioritizedPacketQueue::LeadingPacketEnqueueTimeForRetransmission()
   if (!prioritize_audio_retransmission_) {
     const int priority_level =
         GetPriorityForType(RtpPacketMediaType::kRetransmission, absl::nullopt);
-    if (streams_by_prio_[priority_level].empty()) {
-      return Timestamp::PlusInfinity();
-    }
-    return streams_by_prio_[priority_level].front()->LeadingPacketEnqueueTime(
-        priority_level);
+    return LeadingPacketEnqueueTimeAtLevel(priority_level);
   }
   const int audio_priority_level =
       GetPriorityForType(RtpPacketMediaType::kRetransmission,
@@ -278,25 +221,18 @@ Timestamp PrioritizedPacketQueue::LeadingPacketEnqueueTimeForRetransmission()
   const int video_priority_level =
       GetPriorityForType(RtpPacketMediaType::kRetransmission,
                          RtpPacketToSend::OriginalType::kVideo);
-
-  Timestamp next_audio =
-      streams_by_prio_[audio_priority_level].empty()
-          ? Timestamp::PlusInfinity()
-          : streams_by_prio_[audio_priority_level]
-                .front()
-                ->LeadingPacketEnqueueTime(audio_priority_level);
-  Timestamp next_video =
-      streams_by_prio_[video_priority_level].empty()
-          ? Timestamp::PlusInfinity()
-          : streams_by_prio_[video_priority_level]
-                .front()
-                ->LeadingPacketEnqueueTime(video_priority_level);
-  return std::min(next_audio, next_video);
+  return std::min(LeadingPacketEnqueueTimeAtLevel(audio_priority_level),
+                  LeadingPacketEnqueueTimeAtLevel(video_priority_level));
 }
 
 Timestamp PrioritizedPacketQueue::OldestEnqueueTime() const {
-  return enqueue_times_.empty() ? Timestamp::MinusInfinity()
-                                : enqueue_times_.front();
+  Timestamp oldest = Timestamp::PlusInfinity();
+  for (const PriorityLevel& level : levels_) {
+    if (level.oldest != kNoPacket) {
+      oldest = std::min(oldest, packets_[level.oldest].original_enqueue_time);
+    }
+  }
+  return oldest.IsFinite() ? oldest : Timestamp::MinusInfinity();
 }
 
 TimeDelta PrioritizedPacketQueue::AverageQueueTime() const {
@@ -331,40 +267,14 @@ void PrioritizedPacketQueue::SetPauseState(bool paused, Timestamp now) {
 void PrioritizedPacketQueue::RemovePacketsForSsrc(uint32_t ssrc) {
   auto kv = streams_.find(ssrc);
   if (kv != streams_.end()) {
-    // Dequeue all packets from the queue for this SSRC.
+    // Dequeue all packets from the queue for this SSRC. The stream leaves the
+    // round-robin ring of each level as its last packet there is unlinked.
     StreamQueue& queue = *kv->second;
-    std::array<std::deque<QueuedPacket>, kNumPriorityLevels> packets_by_prio =
-        queue.DequeueAll();
     for (int i = 0; i < kNumPriorityLevels; ++i) {
-      std::deque<QueuedPacket>& packet_queue = packets_by_prio[i];
-      if (packet_queue.empty()) {
-        continue;
-      }
-
-      // First erase all packets at this prio level.
-      while (!packet_queue.empty()) {
-        QueuedPacket packet = std::move(packet_queue.front());
-        packet_queue.pop_front();
+      while (queue.HasPacketsAtPrio(i)) {
+        QueuedPacket packet = ReleasePacket(UnlinkFirstPacket(queue, i));
         DequeuePacketInternal(packet);
       }
-
-      // Next, deregister this `StreamQueue` from the round-robin tables.
-      RTC_DCHECK(!streams_by_prio_[i].empty());
-      if (streams_by_prio_[i].size() == 1) {
-        // This is the last and only queue that had packets for this prio level.
-        // Update the global top prio level if neccessary.
-        RTC_DCHECK(streams_by_prio_[i].front() == &queue);
-        streams_by_prio_[i].pop_front();
-      } else {
-        // More than stream had packets at this prio level, filter this one out.
-        std::deque<StreamQueue*> filtered_queue;
-        for (StreamQueue* queue_ptr : streams_by_prio_[i]) {
-          if (queue_ptr != &queue) {
-            filtered_queue.push_back(queue_ptr);
-          }
-        }
-        streams_by_prio_[i].swap(filtered_queue);
-      }
     }
   }
   MaybeUpdateTopPrioLevel();
@@ -373,11 +283,127 @@ void PrioritizedPacketQueue::RemovePacketsForSsrc(uint32_t ssrc) {
 bool PrioritizedPacketQueue::HasKeyframePackets(uint32_t ssrc) const {
   auto it = streams_.find(ssrc);
   if (it != streams_.end()) {
-    return it->second->has_keyframe_packets();
+    return it->second->num_keyframe_packets > 0;
   }
   return false;
 }
 
+PrioritizedPacketQueue::StreamQueue* PrioritizedPacketQueue::GetOrCreateStream(
+    uint32_t ssrc,
+    Timestamp now) {
+  if (last_stream_ != nullptr && last_ssrc_ == ssrc) {
+    return last_stream_;
+  }
+  auto [it, inserted] = streams_.emplace(ssrc, nullptr);
+  if (inserted) {
+    it->second = std::make_unique<StreamQueue>(now);
+  }
+  last_ssrc_ = ssrc;
+  last_stream_ = it->second.get();
+  return last_stream_;
+}
+
+void PrioritizedPacketQueue::LinkPacket(int index, int priority_level) {
+  QueuedPacket& packet = packets_[index];
+  StreamQueue& stream = *packet.stream;
+  StreamQueue::Level& stream_level = stream.levels[priority_level];
+  PriorityLevel& level = levels_[priority_level];
+
+  packet.next_in_stream = kNoPacket;
+  if (stream_level.last == kNoPacket) {
+    stream_level.first = index;
+    // First packet of the stream at this level. Add the stream last in the
+    // ring, i.e. right before the next stream to send from.
+    if (level.next_stream == nullptr) {
+      stream_level.prev = &stream;
+      stream_level.next = &stream;
+      level.next_stream = &stream;
+    } else {
+      StreamQueue* next = level.next_stream;
+      StreamQueue* prev = next->levels[priority_level].prev;
+      stream_level.prev = prev;
+      stream_level.next = next;
+      prev->levels[priority_level].next = &stream;
+      next->levels[priority_level].prev = &stream;
+    }
+  } else {
+    packets_[stream_level.last].next_in_stream = index;
+  }
+  stream_level.last = index;
+  ++stream.num_packets;
+
+  packet.older_at_level = level.newest;
+  packet.newer_at_level = kNoPacket;
+  if (level.newest != kNoPacket) {
+    packets_[level.newest].newer_at_level = index;
+  } else {
+    level.oldest = index;
+  }
+  level.newest = index;
+}
+
+int PrioritizedPacketQueue::UnlinkFirstPacket(StreamQueue& stream,
+                                              int priority_level) {
+  StreamQueue::Level& stream_level = stream.levels[priority_level];
+  PriorityLevel& level = levels_[priority_level];
+  const int index = stream_level.first;
+  RTC_DCHECK_NE(index, kNoPacket);
+  QueuedPacket& packet = packets_[index];
+
+  stream_level.first = packet.next_in_stream;
+  if (stream_level.first == kNoPacket) {
+    stream_level.last = kNoPacket;
+    // Last packet of the stream at this level, remove the stream from the
+    // ring.
+    if (stream_level.next == &stream) {
+      level.next_stream = nullptr;
+    } else {
+      stream_level.prev->levels[priority_level].next = stream_level.next;
+      stream_level.next->levels[priority_level].prev = stream_level.prev;
+      if (level.next_stream == &stream) {
+        level.next_stream = stream_level.next;
+      }
+    }
+    stream_level.prev = nullptr;
+    stream_level.next = nullptr;
+  }
+  --stream.num_packets;
+  if (packet.packet->is_key_frame()) {
+    RTC_DCHECK_GT(stream.num_keyframe_packets, 0);
+    --stream.num_keyframe_packets;
+  }
+
+  if (packet.older_at_level != kNoPacket) {
+    packets_[packet.older_at_level].newer_at_level = packet.newer_at_level;
+  } else {
+    level.oldest = packet.newer_at_level;
+  }
+  if (packet.newer_at_level != kNoPacket) {
+    packets_[packet.newer_at_level].older_at_level = packet.older_at_level;
+  } else {
+    level.newest = packet.older_at_level;
+  }
+  return index;
+}
+
+PrioritizedPacketQueue::QueuedPacket PrioritizedPacketQueue::ReleasePacket(
+    int index) {
+  QueuedPacket packet = std::move(packets_[index]);
+  packets_[index].stream = nullptr;
+  packets_[index].next_in_stream = first_free_packet_;
+  first_free_packet_ = index;
+  return packet;
+}
+
+Timestamp PrioritizedPacketQueue::LeadingPacketEnqueueTimeAtLevel(
+    int priority_level) const {
+  const StreamQueue* stream = levels_[priority_level].next_stream;
+  if (stream == nullptr) {
+    return Timestamp::PlusInfinity();
+  }
+  return packets_[stream->levels[priority_level].first].enqueue_time;
+}
+
 void PrioritizedPacketQueue::DequeuePacketInternal(QueuedPacket& packet) {
   --size_packets_;
   RTC_DCHECK(packet.packet->packet_type().has_value());
@@ -404,21 +430,18 @@ void PrioritizedPacketQueue::DequeuePacketInternal(QueuedPacket& packet) {
   packet.packet->set_time_in_send_queue(time_in_non_paused_state);
 
   RTC_DCHECK(size_packets_ > 0 || queue_time_sum_ == TimeDelta::Zero());
-
-  RTC_CHECK(packet.enqueue_time_iterator != enqueue_times_.end());
-  enqueue_times_.erase(packet.enqueue_time_iterator);
 }
 
 void PrioritizedPacketQueue::MaybeUpdateTopPrioLevel() {
   if (top_active_prio_level_ != -1 &&
-      !streams_by_prio_[top_active_prio_level_].empty()) {
+      levels_[top_active_prio_level_].next_stream != nullptr) {
     return;
   }
   // No stream queues have packets at top_active_prio_level_, find top priority
   // that is not empty.
   for (int i = 0; i < kNumPriorityLevels; ++i) {
     PurgeOldPacketsAtPriorityLevel(i, last_update_time_);
-    if (!streams_by_prio_[i].empty()) {
+    if (levels_[i].next_stream != nullptr) {
       top_active_prio_level_ = i;
       break;
     }
@@ -438,26 +461,21 @@ void PrioritizedPacketQueue::PurgeOldPacketsAtPriorityLevel(int prio_level,
     return;
   }
 
-  std::deque<StreamQueue*>& queues = streams_by_prio_[prio_level];
-  auto iter = queues.begin();
-  while (iter != queues.end()) {
-    StreamQueue* queue_ptr = *iter;
-    while (queue_ptr->HasPacketsAtPrio(prio_level) &&
-           (now - queue_ptr->LeadingPacketEnqueueTime(prio_level)) >
-               time_to_live) {
-      QueuedPacket packet = queue_ptr->DequeuePacket(prio_level);
-      RTC_LOG(LS_INFO) << "Dropping old packet on SSRC: "
-                       << packet.packet->Ssrc()
-                       << " seq:" << packet.packet->SequenceNumber()
-                       << " time in queue:" << (now - packet.enqueue_time).ms()
-                       << " ms";
-      DequeuePacketInternal(packet);
-    }
-    if (!queue_ptr->HasPacketsAtPrio(prio_level)) {
-      iter = queues.erase(iter);
-    } else {
-      ++iter;
-    }
+  // Packets expire in the order they were pushed, so only the oldest packets
+  // at the level need to be checked.
+  PriorityLevel& level = levels_[prio_level];
+  while (level.oldest != kNoPacket &&
+         (now - packets_[level.oldest].enqueue_time) > time_to_live) {
+    // The oldest packet at the level is also the first of its stream.
+    StreamQueue& stream = *packets_[level.oldest].stream;
+    RTC_DCHECK_EQ(stream.levels[prio_level].first, level.oldest);
+    QueuedPacket packet = ReleasePacket(UnlinkFirstPacket(stream, prio_level));
+    RTC_LOG(LS_INFO) << "Dropping old packet on SSRC: "
+                     << packet.packet->Ssrc()
+                     << " seq:" << packet.packet->SequenceNumber()
+                     << " time in queue:" << (now - packet.enqueue_time).ms()
+                     << " ms";
+    DequeuePacketInternal(packet);
   }
 }
 
@@ -12,12 +12,12 @@
 #define MODULES_PACING_PRIORITIZED_PACKET_QUEUE_H_
 
 #include <stddef.h>
+#include <stdint.h>
 
 #include <array>
-#include <deque>
-#include <list>
 #include <memory>
 #include <unordered_map>
+#include <vector>
 
 #include "absl/container/inlined_vector.h"
 #include "api/units/data_size.h"
@@ -102,46 +102,77 @@ class PrioritizedPacketQueue {
 
  private:
   static constexpr int kNumPriorityLevels = 5;
+  // Index into `packets_` that refers to no packet.
+  static constexpr int kNoPacket = -1;
 
+  struct StreamQueue;
+
+  // A slot in `packets_`. Queued packets are linked into two lists: the
+  // packets of the same stream and priority level, and all the packets of the
+  // same priority level, both in enqueue order. Free slots are linked through
+  // `next_in_stream`.
   class QueuedPacket {
    public:
     DataSize PacketSize() const;
 
     std::unique_ptr<RtpPacketToSend> packet;
-    Timestamp enqueue_time;
-    std::list<Timestamp>::iterator enqueue_time_iterator;
+    // Enqueue time, minus the time the queue was paused before it.
+    Timestamp enqueue_time = Timestamp::MinusInfinity();
+    // Enqueue time as given to Push().
+    Timestamp original_enqueue_time = Timestamp::MinusInfinity();
+    StreamQueue* stream = nullptr;
+    int next_in_stream = kNoPacket;
+    int older_at_level = kNoPacket;
+    int newer_at_level = kNoPacket;
   };
 
-  // Class containing packets for an RTP stream.
-  // For each priority level, packets are simply stored in a fifo queue.
-  class StreamQueue {
-   public:
-    explicit StreamQueue(Timestamp creation_time);
-    StreamQueue(StreamQueue&&) = default;
-    StreamQueue& operator=(StreamQueue&&) = default;
+  // Packets of an RTP stream. For each priority level, packets are linked in
+  // a fifo queue, and streams with packets are linked in a round-robin ring.
+  struct StreamQueue {
+    struct Level {
+      int first = kNoPacket;
+      int last = kNoPacket;
+      // Neighbours in the ring of streams with packets at this level.
+      StreamQueue* prev = nullptr;
+      StreamQueue* next = nullptr;
+    };
 
+    explicit StreamQueue(Timestamp creation_time);
     StreamQueue(const StreamQueue&) = delete;
     StreamQueue& operator=(const StreamQueue&) = delete;
 
-    // Enqueue packet at the given priority level. Returns true if the packet
-    // count for that priority level went from zero to non-zero.
-    bool EnqueuePacket(QueuedPacket packet, int priority_level);
+    bool HasPacketsAtPrio(int priority_level) const {
+      return levels[priority_level].first != kNoPacket;
+    }
+    bool IsEmpty() const { return num_packets == 0; }
 
-    QueuedPacket DequeuePacket(int priority_level);
+    std::array<Level, kNumPriorityLevels> levels;
+    Timestamp last_enqueue_time;
+    int num_packets = 0;
+    int num_keyframe_packets = 0;
+  };
 
-    bool HasPacketsAtPrio(int priority_level) const;
-    bool IsEmpty() const;
-    Timestamp LeadingPacketEnqueueTime(int priority_level) const;
-    Timestamp LastEnqueueTime() const;
-    bool has_keyframe_packets() const { return num_keyframe_packets_ > 0; }
+  struct PriorityLevel {
+    // Next stream to send from in the ring of streams with packets at this
+    // level, or null if there are none.
+    StreamQueue* next_stream = nullptr;
+    // Packets at this level in enqueue order, which is also the order they
+    // expire in.
+    int oldest = kNoPacket;
+    int newest = kNoPacket;
+  };
 
-    std::array<std::deque<QueuedPacket>, kNumPriorityLevels> DequeueAll();
+  StreamQueue* GetOrCreateStream(uint32_t ssrc, Timestamp now);
 
-   private:
-    std::deque<QueuedPacket> packets_[kNumPriorityLevels];
-    Timestamp last_enqueue_time_;
-    int num_keyframe_packets_;
-  };
+  // Links the packet at `index` last in the queues of its stream and level.
+  void LinkPacket(int index, int priority_level);
+  // Unlinks and returns the first packet of `stream` at `priority_level`.
+  int UnlinkFirstPacket(StreamQueue& stream, int priority_level);
+  // Returns the packet at `index` and frees its slot.
+  QueuedPacket ReleasePacket(int index);
+  // Enqueue time of the next packet Pop() returns at `priority_level`, or
+  // Timestamp::PlusInfinity() if there is none.
+  Timestamp LeadingPacketEnqueueTimeAtLevel(int priority_level) const;
 
   // Remove the packet from the internal state, e.g. queue time / size etc.
   void DequeuePacketInternal(QueuedPacket& packet);
@@ -178,18 +209,19 @@ class PrioritizedPacketQueue {
 
   // Map from SSRC to packet queues for the associated RTP stream.
   std::unordered_map<uint32_t, std::unique_ptr<StreamQueue>> streams_;
+  // Stream of the last pushed packet, as packets often come in bursts of a
+  // stream.
+  uint32_t last_ssrc_ = 0;
+  StreamQueue* last_stream_ = nullptr;
 
-  // For each priority level, a queue of StreamQueues which have at least one
-  // packet pending for that prio level.
-  std::deque<StreamQueue*> streams_by_prio_[kNumPriorityLevels];
+  std::array<PriorityLevel, kNumPriorityLevels> levels_;
 
-  // The first index into `stream_by_prio_` that is non-empty.
+  // The first index into `levels_` that has packets.
   int top_active_prio_level_;
 
-  // Ordered list of enqueue times. Additions are always increasing and added to
-  // the end. QueuedPacket instances have a iterators into this list for fast
-  // removal.
-  std::list<Timestamp> enqueue_times_;
+  // Slots for queued packets, reused through a free list.
+  std::vector<QueuedPacket> packets_;
+  int first_free_packet_ = kNoPacket;
 };
 
 }  // namespace webrtc
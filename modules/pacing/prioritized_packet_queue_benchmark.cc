@@ -0,0 +1,80 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "benchmark/benchmark.h"
+#include "modules/pacing/prioritized_packet_queue.h"
+#include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
+#include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
+
+namespace webrtc {
+namespace {
+
+constexpr int kPacketsPerStream = 8;
+constexpr size_t kPayloadSize = 1000;
+
+std::unique_ptr<RtpPacketToSend> CreatePacket() {
+  auto packet = std::make_unique<RtpPacketToSend>(/*extensions=*/nullptr);
+  packet->SetPayloadSize(kPayloadSize);
+  return packet;
+}
+
+// Pushes and pops packets of `state.range(0)` streams, with `kPacketsPerStream`
+// packets of each stream in the queue. Every eighth packet is a
+// retransmission. With `state.range(1)` set, packets have a time to live,
+// which the queue checks on every push. Reports the time to push and pop a
+// packet.
+void BM_PushPop(benchmark::State& state) {
+  const int num_streams = state.range(0);
+  PacketQueueTTL ttl;
+  if (state.range(1) != 0) {
+    ttl.video = TimeDelta::Seconds(2);
+    ttl.video_retransmission = TimeDelta::Seconds(2);
+  }
+  Timestamp now = Timestamp::Seconds(1000);
+  PrioritizedPacketQueue queue(now, /*prioritize_audio_retransmission=*/false,
+                               ttl);
+
+  int64_t sequence_number = 0;
+  auto push = [&](std::unique_ptr<RtpPacketToSend> packet) {
+    const uint32_t ssrc = sequence_number % num_streams;
+    packet->SetSsrc(ssrc);
+    packet->SetSequenceNumber(sequence_number);
+    packet->set_packet_type(sequence_number % 8 == 7
+                                ? RtpPacketMediaType::kRetransmission
+                                : RtpPacketMediaType::kVideo);
+    ++sequence_number;
+    queue.Push(now, std::move(packet));
+  };
+  for (int i = 0; i < num_streams * kPacketsPerStream; ++i) {
+    push(CreatePacket());
+  }
+
+  for (auto _ : state) {
+    now += TimeDelta::Micros(10);
+    queue.UpdateAverageQueueTime(now);
+    std::unique_ptr<RtpPacketToSend> packet = queue.Pop();
+    push(std::move(packet));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_PushPop)
+    ->ArgsProduct({{1, 10, 200}, {0, 1}})
+    ->ArgNames({"streams", "ttl"});
+
+}  // namespace
+}  // namespace webrtc
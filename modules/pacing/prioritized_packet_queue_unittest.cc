@@ -430,6 +430,35 @@ TEST(PrioritizedPacketQueue, ClearPacketsAffectsOnlySpecifiedSsrc) {
   EXPECT_TRUE(queue.Empty());
 }
 
+TEST(PrioritizedPacketQueue, KeepsRoundRobinOrderWhenRemovingStream) {
+  Timestamp now = Timestamp::Zero();
+  PrioritizedPacketQueue queue(now);
+
+  // Two packets each of streams 1, 2 and 3, interleaved.
+  for (uint16_t seq = 0; seq < 6; ++seq) {
+    queue.Push(now, CreatePacket(RtpPacketMediaType::kVideo, seq,
+                                 /*ssrc=*/1 + seq % 3));
+  }
+  EXPECT_EQ(queue.Pop()->SequenceNumber(), 0);
+  queue.RemovePacketsForSsrc(/*ssrc=*/2);
+  EXPECT_EQ(queue.SizeInPackets(), 3);
+
+  // Stream 2 was next, followed by stream 3 and then stream 1.
+  EXPECT_EQ(queue.Pop()->SequenceNumber(), 2);
+  EXPECT_EQ(queue.Pop()->SequenceNumber(), 3);
+  EXPECT_EQ(queue.Pop()->SequenceNumber(), 5);
+  EXPECT_TRUE(queue.Empty());
+
+  // Removed and refilled streams rejoin the ring last.
+  queue.Push(now, CreatePacket(RtpPacketMediaType::kVideo, /*seq=*/6,
+                               /*ssrc=*/2));
+  queue.Push(now, CreatePacket(RtpPacketMediaType::kVideo, /*seq=*/7,
+                               /*ssrc=*/1));
+  EXPECT_EQ(queue.Pop()->SequenceNumber(), 6);
+  EXPECT_EQ(queue.Pop()->SequenceNumber(), 7);
+  EXPECT_TRUE(queue.Empty());
+}
+
 TEST(PrioritizedPacketQueue, ReportsKeyframePackets) {
   Timestamp now = Timestamp::Zero();
   PrioritizedPacketQueue queue(now);
@@ -542,6 +571,38 @@ TEST(PrioritizedPacketQueue, SendsNewVideoPacketAfterPurgingLastOldRtxPacket) {
   EXPECT_EQ(queue.SizeInPackets(), 0);
 }
 
+TEST(PrioritizedPacketQueue, DropsOldPacketsOfAllStreams) {
+  Timestamp now = Timestamp::Zero();
+  PacketQueueTTL ttls;
+  ttls.video = TimeDelta::Millis(500);
+  PrioritizedPacketQueue queue(now, /*prioritize_audio_retransmission=*/false,
+                               ttls);
+
+  // Old packets of 100 streams, then new packets of every other stream.
+  for (uint16_t seq = 0; seq < 100; ++seq) {
+    queue.Push(now, CreatePacket(RtpPacketMediaType::kVideo, seq,
+                                 /*ssrc=*/seq, /*is_key_frame=*/true));
+  }
+  now += TimeDelta::Millis(300);
+  for (uint16_t seq = 100; seq < 150; ++seq) {
+    queue.Push(now, CreatePacket(RtpPacketMediaType::kVideo, seq,
+                                 /*ssrc=*/2 * (seq - 100)));
+  }
+  EXPECT_EQ(queue.SizeInPackets(), 150);
+
+  now += TimeDelta::Millis(300);
+  queue.Push(now, CreatePacket(RtpPacketMediaType::kVideo, /*seq=*/150,
+                               /*ssrc=*/1));
+  EXPECT_EQ(queue.SizeInPackets(), 51);
+  EXPECT_EQ(queue.OldestEnqueueTime(), Timestamp::Millis(300));
+  EXPECT_FALSE(queue.HasKeyframePackets(/*ssrc=*/0));
+
+  for (uint16_t seq = 100; seq <= 150; ++seq) {
+    EXPECT_EQ(queue.Pop()->SequenceNumber(), seq);
+  }
+  EXPECT_TRUE(queue.Empty());
+}
+
 TEST(PrioritizedPacketQueue,
      SendsPacketsAfterTttlIfPrioHigherThanPushedPackets) {
   Timestamp now = Timestamp::Zero();
@@ -0,0 +1,253 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/pacing/shared_pacer.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "absl/algorithm/container.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/trace_event.h"
+
+namespace webrtc {
+namespace {
+
+// Queue delays are kept in an array up to this many milliseconds, and in a map
+// beyond.
+constexpr uint32_t kQueueDelayLongTailMs = 100;
+
+absl::optional<TimeDelta> QueueDelayPercentile(
+    rtc::HistogramPercentileCounter& counter,
+    float fraction) {
+  absl::optional<uint32_t> delay_ms = counter.GetPercentile(fraction);
+  if (!delay_ms) {
+    return absl::nullopt;
+  }
+  return TimeDelta::Millis(*delay_ms);
+}
+
+}  // namespace
+
+SharedPacer::Entry::Entry(Client* client, int id)
+    : client(client), id(id), queue_delay_ms(kQueueDelayLongTailMs) {}
+
+SharedPacer::SharedPacer(TaskQueueBase* task_queue,
+                         Clock* clock,
+                         Config config)
+    : task_queue_(task_queue), clock_(clock), config_(config) {
+  RTC_DCHECK(task_queue_);
+  RTC_DCHECK(config_.coalescing_window.IsFinite());
+  RTC_DCHECK_GT(config_.coalescing_window, TimeDelta::Zero());
+}
+
+SharedPacer::~SharedPacer() {
+  RTC_DCHECK_RUN_ON(task_queue_);
+  RTC_DCHECK(entries_.empty());
+}
+
+void SharedPacer::AddClient(Client* client) {
+  RTC_DCHECK_RUN_ON(task_queue_);
+  auto [it, inserted] =
+      entries_.emplace(client, std::make_unique<Entry>(client, next_id_));
+  RTC_DCHECK(inserted);
+  if (inserted) {
+    ++next_id_;
+  }
+}
+
+void SharedPacer::RemoveClient(Client* client) {
+  RTC_DCHECK_RUN_ON(task_queue_);
+  auto it = entries_.find(client);
+  RTC_DCHECK(it != entries_.end());
+  if (it == entries_.end()) {
+    return;
+  }
+  if (it->second->queue_index != kNotScheduled) {
+    Remove(it->second.get());
+  }
+  entries_.erase(it);
+  // A wakeup in flight for this client only is left to find nothing due.
+}
+
+void SharedPacer::Schedule(Client* client, Timestamp process_time) {
+  RTC_DCHECK_RUN_ON(task_queue_);
+  RTC_DCHECK(process_time.IsFinite());
+  Entry& entry = GetEntry(client);
+  const Timestamp previous_time = entry.process_time;
+  entry.process_time = process_time;
+  if (entry.queue_index == kNotScheduled) {
+    Push(&entry);
+  } else if (process_time < previous_time) {
+    SiftUp(entry.queue_index);
+  } else {
+    SiftDown(entry.queue_index);
+  }
+  MaybeScheduleWakeup();
+}
+
+void SharedPacer::OnPacketSent(Client* client, TimeDelta queue_delay) {
+  RTC_DCHECK_RUN_ON(task_queue_);
+  Entry& entry = GetEntry(client);
+  ++entry.packets_sent;
+  entry.queue_delay_ms.Add(
+      static_cast<uint32_t>(std::max<int64_t>(queue_delay.ms(), 0)));
+}
+
+SharedPacer::Stats SharedPacer::GetStats() const {
+  RTC_DCHECK_RUN_ON(task_queue_);
+  Stats stats;
+  stats.wakeups = wakeups_;
+  stats.pacer_runs = pacer_runs_;
+  stats.pacers.reserve(entries_.size());
+  for (const auto& [client, entry] : entries_) {
+    PacerStats pacer_stats;
+    pacer_stats.id = entry->id;
+    pacer_stats.packets_sent = entry->packets_sent;
+    pacer_stats.queue_delay_p50 =
+        QueueDelayPercentile(entry->queue_delay_ms, 0.5f);
+    pacer_stats.queue_delay_p95 =
+        QueueDelayPercentile(entry->queue_delay_ms, 0.95f);
+    pacer_stats.queue_delay_p99 =
+        QueueDelayPercentile(entry->queue_delay_ms, 0.99f);
+    stats.pacers.push_back(std::move(pacer_stats));
+  }
+  absl::c_sort(stats.pacers, [](const PacerStats& a, const PacerStats& b) {
+    return a.id < b.id;
+  });
+  return stats;
+}
+
+// RTC_RUN_ON(task_queue_)
+SharedPacer::Entry& SharedPacer::GetEntry(Client* client) {
+  auto it = entries_.find(client);
+  RTC_CHECK(it != entries_.end());
+  return *it->second;
+}
+
+// RTC_RUN_ON(task_queue_)
+void SharedPacer::Push(Entry* entry) {
+  queue_.push_back(entry);
+  entry->queue_index = queue_.size() - 1;
+  SiftUp(entry->queue_index);
+}
+
+// RTC_RUN_ON(task_queue_)
+void SharedPacer::Remove(Entry* entry) {
+  const size_t index = entry->queue_index;
+  RTC_DCHECK_LT(index, queue_.size());
+  entry->queue_index = kNotScheduled;
+  Entry* last = queue_.back();
+  queue_.pop_back();
+  if (last == entry) {
+    return;
+  }
+  Place(last, index);
+  SiftUp(index);
+  SiftDown(last->queue_index);
+}
+
+// RTC_RUN_ON(task_queue_)
+void SharedPacer::SiftUp(size_t index) {
+  Entry* entry = queue_[index];
+  while (index > 0) {
+    const size_t parent = (index - 1) / 2;
+    if (queue_[parent]->process_time <= entry->process_time) {
+      break;
+    }
+    Place(queue_[parent], index);
+    index = parent;
+  }
+  Place(entry, index);
+}
+
+// RTC_RUN_ON(task_queue_)
+void SharedPacer::SiftDown(size_t index) {
+  Entry* entry = queue_[index];
+  while (true) {
+    size_t child = 2 * index + 1;
+    if (child >= queue_.size()) {
+      break;
+    }
+    if (child + 1 < queue_.size() &&
+        queue_[child + 1]->process_time < queue_[child]->process_time) {
+      ++child;
+    }
+    if (entry->process_time <= queue_[child]->process_time) {
+      break;
+    }
+    Place(queue_[child], index);
+    index = child;
+  }
+  Place(entry, index);
+}
+
+// RTC_RUN_ON(task_queue_)
+void SharedPacer::Place(Entry* entry, size_t index) {
+  queue_[index] = entry;
+  entry->queue_index = index;
+}
+
+// RTC_RUN_ON(task_queue_)
+void SharedPacer::MaybeScheduleWakeup() {
+  if (processing_ || queue_.empty()) {
+    return;
+  }
+  // Align the wakeup to the coalescing window, so that it also serves all
+  // pacers due later in the same window.
+  const int64_t window_us = config_.coalescing_window.us();
+  const int64_t process_time_us = queue_.front()->process_time.us();
+  const Timestamp wakeup_time = Timestamp::Micros(
+      (process_time_us + window_us - 1) / window_us * window_us);
+
+  // A wakeup in flight that is early enough serves this one too. Otherwise,
+  // the one in flight is retired.
+  if (next_wakeup_time_.IsFinite() && next_wakeup_time_ <= wakeup_time) {
+    return;
+  }
+  next_wakeup_time_ = wakeup_time;
+  const TimeDelta delay =
+      std::max(wakeup_time - clock_->CurrentTime(), TimeDelta::Zero());
+  task_queue_->PostDelayedHighPrecisionTask(
+      SafeTask(safety_.flag(),
+               [this, wakeup_time] {
+                 RTC_DCHECK_RUN_ON(task_queue_);
+                 OnWakeup(wakeup_time);
+               }),
+      delay.RoundUpTo(TimeDelta::Millis(1)));
+}
+
+// RTC_RUN_ON(task_queue_)
+void SharedPacer::OnWakeup(Timestamp wakeup_time) {
+  if (wakeup_time != next_wakeup_time_) {
+    return;
+  }
+  TRACE_EVENT0(TRACE_DISABLED_BY_DEFAULT("webrtc"), "SharedPacer::OnWakeup");
+  next_wakeup_time_ = Timestamp::MinusInfinity();
+  ++wakeups_;
+
+  // Pacers schedule their next process time after now, so each one runs at
+  // most once per wakeup.
+  RTC_DCHECK(!processing_);
+  processing_ = true;
+  const Timestamp now = clock_->CurrentTime();
+  while (!queue_.empty() && queue_.front()->process_time <= now) {
+    Entry* entry = queue_.front();
+    const Timestamp process_time = entry->process_time;
+    Remove(entry);
+    entry->process_time = Timestamp::PlusInfinity();
+    ++pacer_runs_;
+    entry->client->OnScheduledProcess(process_time);
+  }
+  processing_ = false;
+  MaybeScheduleWakeup();
+}
+
+}  // namespace webrtc
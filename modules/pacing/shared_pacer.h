@@ -0,0 +1,148 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_PACING_SHARED_PACER_H_
+#define MODULES_PACING_SHARED_PACER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "absl/types/optional.h"
+#include "api/task_queue/pending_task_safety_flag.h"
+#include "api/task_queue/task_queue_base.h"
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "rtc_base/numerics/histogram_percentile_counter.h"
+#include "rtc_base/thread_annotations.h"
+#include "system_wrappers/include/clock.h"
+
+namespace webrtc {
+
+// Schedules the processing of many pacers, e.g. one per PeerConnection on a
+// server hosting many calls, from a single timer on a shared task queue.
+// Pacers wait in one queue ordered by process time, and all pacers due in the
+// same coalescing window are processed in one wakeup. Wakeups then scale with
+// time rather than with the number of pacers. A server running calls on
+// several worker threads uses one SharedPacer per thread.
+class SharedPacer {
+ public:
+  // A pacer processed by the shared pacer.
+  class Client {
+   public:
+    // Called when the process time last given to Schedule() is due.
+    virtual void OnScheduledProcess(Timestamp scheduled_process_time) = 0;
+
+   protected:
+    virtual ~Client() = default;
+  };
+
+  struct Config {
+    // Wakeups are aligned to multiples of this interval. A pacer is processed
+    // up to this much later than its process time.
+    TimeDelta coalescing_window = TimeDelta::Millis(1);
+  };
+
+  struct PacerStats {
+    // Pacers are numbered in the order they were added.
+    int id = 0;
+    int64_t packets_sent = 0;
+    // Percentiles of the time packets spent in the pacer queue, with
+    // millisecond resolution. Unset until a packet was sent.
+    absl::optional<TimeDelta> queue_delay_p50;
+    absl::optional<TimeDelta> queue_delay_p95;
+    absl::optional<TimeDelta> queue_delay_p99;
+  };
+
+  struct Stats {
+    int64_t wakeups = 0;
+    // Times a pacer was processed, several per wakeup when coalesced.
+    int64_t pacer_runs = 0;
+    // Stats of the pacers currently added, ordered by id.
+    std::vector<PacerStats> pacers;
+  };
+
+  // Clients are added, scheduled and processed on `task_queue`.
+  SharedPacer(TaskQueueBase* task_queue, Clock* clock, Config config);
+  SharedPacer(const SharedPacer&) = delete;
+  SharedPacer& operator=(const SharedPacer&) = delete;
+  ~SharedPacer();
+
+  TaskQueueBase* task_queue() const { return task_queue_; }
+
+  // `client` must be removed before it is destroyed.
+  void AddClient(Client* client);
+  void RemoveClient(Client* client);
+
+  // Processes `client` at `process_time`, replacing the time it was scheduled
+  // at before, if any.
+  void Schedule(Client* client, Timestamp process_time);
+
+  // Records that `client` sent a packet that waited `queue_delay` in its
+  // queue.
+  void OnPacketSent(Client* client, TimeDelta queue_delay);
+
+  Stats GetStats() const;
+
+ private:
+  static constexpr size_t kNotScheduled = static_cast<size_t>(-1);
+
+  struct Entry {
+    explicit Entry(Client* client, int id);
+
+    Client* const client;
+    const int id;
+    Timestamp process_time = Timestamp::PlusInfinity();
+    // Position in `queue_`, or kNotScheduled.
+    size_t queue_index = kNotScheduled;
+    int64_t packets_sent = 0;
+    rtc::HistogramPercentileCounter queue_delay_ms;
+  };
+
+  Entry& GetEntry(Client* client) RTC_RUN_ON(task_queue_);
+
+  // Binary min-heap on process time, tracking the position of each entry.
+  void Push(Entry* entry) RTC_RUN_ON(task_queue_);
+  void Remove(Entry* entry) RTC_RUN_ON(task_queue_);
+  void SiftUp(size_t index) RTC_RUN_ON(task_queue_);
+  void SiftDown(size_t index) RTC_RUN_ON(task_queue_);
+  void Place(Entry* entry, size_t index) RTC_RUN_ON(task_queue_);
+
+  void MaybeScheduleWakeup() RTC_RUN_ON(task_queue_);
+  void OnWakeup(Timestamp wakeup_time) RTC_RUN_ON(task_queue_);
+
+  TaskQueueBase* const task_queue_;
+  Clock* const clock_;
+  const Config config_;
+
+  std::map<Client*, std::unique_ptr<Entry>> entries_
+      RTC_GUARDED_BY(task_queue_);
+  std::vector<Entry*> queue_ RTC_GUARDED_BY(task_queue_);
+  int next_id_ RTC_GUARDED_BY(task_queue_) = 0;
+
+  // Time of the only valid wakeup task in flight, or MinusInfinity if none.
+  Timestamp next_wakeup_time_ RTC_GUARDED_BY(task_queue_) =
+      Timestamp::MinusInfinity();
+  // Clients reschedule themselves while they are processed. The wakeup is
+  // scheduled once they are all done.
+  bool processing_ RTC_GUARDED_BY(task_queue_) = false;
+
+  int64_t wakeups_ RTC_GUARDED_BY(task_queue_) = 0;
+  int64_t pacer_runs_ RTC_GUARDED_BY(task_queue_) = 0;
+
+  ScopedTaskSafety safety_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_PACING_SHARED_PACER_H_
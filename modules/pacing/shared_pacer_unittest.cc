@@ -0,0 +1,195 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/pacing/shared_pacer.h"
+
+#include <memory>
+#include <vector>
+
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+#include "test/time_controller/simulated_time_controller.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::Optional;
+
+// A multiple of the coalescing windows used below.
+constexpr Timestamp kStartTime = Timestamp::Seconds(1000);
+
+class FakeClient : public SharedPacer::Client {
+ public:
+  FakeClient(SharedPacer* shared_pacer, Clock* clock)
+      : shared_pacer_(shared_pacer), clock_(clock) {
+    shared_pacer_->AddClient(this);
+  }
+  ~FakeClient() override { shared_pacer_->RemoveClient(this); }
+
+  // Reschedules itself `interval` after every run, if set.
+  void set_interval(TimeDelta interval) { interval_ = interval; }
+
+  void OnScheduledProcess(Timestamp scheduled_process_time) override {
+    run_times.push_back(clock_->CurrentTime());
+    scheduled_times.push_back(scheduled_process_time);
+    if (interval_.IsFinite()) {
+      shared_pacer_->Schedule(this, clock_->CurrentTime() + interval_);
+    }
+  }
+
+  std::vector<Timestamp> run_times;
+  std::vector<Timestamp> scheduled_times;
+
+ private:
+  SharedPacer* const shared_pacer_;
+  Clock* const clock_;
+  TimeDelta interval_ = TimeDelta::PlusInfinity();
+};
+
+class SharedPacerTest : public ::testing::Test {
+ protected:
+  SharedPacerTest()
+      : time_controller_(kStartTime),
+        shared_pacer_(time_controller_.GetMainThread(),
+                      time_controller_.GetClock(),
+                      SharedPacer::Config()) {}
+
+  GlobalSimulatedTimeController time_controller_;
+  SharedPacer shared_pacer_;
+};
+
+TEST_F(SharedPacerTest, ProcessesClientAtScheduledTime) {
+  FakeClient client(&shared_pacer_, time_controller_.GetClock());
+  shared_pacer_.Schedule(&client, kStartTime + TimeDelta::Millis(10));
+
+  time_controller_.AdvanceTime(TimeDelta::Millis(9));
+  EXPECT_TRUE(client.run_times.empty());
+  time_controller_.AdvanceTime(TimeDelta::Millis(1));
+  EXPECT_THAT(client.run_times,
+              ElementsAre(kStartTime + TimeDelta::Millis(10)));
+  EXPECT_THAT(client.scheduled_times,
+              ElementsAre(kStartTime + TimeDelta::Millis(10)));
+
+  time_controller_.AdvanceTime(TimeDelta::Seconds(1));
+  EXPECT_EQ(client.run_times.size(), 1u);
+}
+
+TEST_F(SharedPacerTest, RescheduleReplacesProcessTime) {
+  FakeClient client(&shared_pacer_, time_controller_.GetClock());
+  shared_pacer_.Schedule(&client, kStartTime + TimeDelta::Millis(10));
+  shared_pacer_.Schedule(&client, kStartTime + TimeDelta::Millis(5));
+  shared_pacer_.Schedule(&client, kStartTime + TimeDelta::Millis(20));
+
+  time_controller_.AdvanceTime(TimeDelta::Seconds(1));
+  EXPECT_THAT(client.scheduled_times,
+              ElementsAre(kStartTime + TimeDelta::Millis(20)));
+}
+
+TEST_F(SharedPacerTest, ProcessesClientsInOrderOfProcessTime) {
+  std::vector<std::unique_ptr<FakeClient>> clients;
+  for (int i = 0; i < 10; ++i) {
+    clients.push_back(std::make_unique<FakeClient>(
+        &shared_pacer_, time_controller_.GetClock()));
+    shared_pacer_.Schedule(clients.back().get(),
+                           kStartTime + TimeDelta::Millis(50 - 5 * i));
+  }
+
+  time_controller_.AdvanceTime(TimeDelta::Seconds(1));
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_THAT(clients[i]->run_times,
+                ElementsAre(kStartTime + TimeDelta::Millis(50 - 5 * i)));
+  }
+  EXPECT_EQ(shared_pacer_.GetStats().wakeups, 10);
+}
+
+TEST_F(SharedPacerTest, CoalescesWakeupsWithinWindow) {
+  SharedPacer::Config config;
+  config.coalescing_window = TimeDelta::Millis(5);
+  SharedPacer shared_pacer(time_controller_.GetMainThread(),
+                           time_controller_.GetClock(), config);
+  std::vector<std::unique_ptr<FakeClient>> clients;
+  for (int i = 0; i < 100; ++i) {
+    clients.push_back(std::make_unique<FakeClient>(
+        &shared_pacer, time_controller_.GetClock()));
+    // Spread over [kStartTime + 1ms, kStartTime + 5ms].
+    shared_pacer.Schedule(clients.back().get(),
+                          kStartTime + TimeDelta::Micros(1000 + 40 * i));
+  }
+
+  time_controller_.AdvanceTime(TimeDelta::Millis(100));
+  for (const auto& client : clients) {
+    EXPECT_THAT(client->run_times,
+                ElementsAre(kStartTime + TimeDelta::Millis(5)));
+  }
+  SharedPacer::Stats stats = shared_pacer.GetStats();
+  EXPECT_EQ(stats.wakeups, 1);
+  EXPECT_EQ(stats.pacer_runs, 100);
+  clients.clear();
+}
+
+TEST_F(SharedPacerTest, WakeupsScaleWithTimeNotClients) {
+  SharedPacer::Config config;
+  config.coalescing_window = TimeDelta::Millis(5);
+  SharedPacer shared_pacer(time_controller_.GetMainThread(),
+                           time_controller_.GetClock(), config);
+  std::vector<std::unique_ptr<FakeClient>> clients;
+  for (int i = 0; i < 500; ++i) {
+    clients.push_back(std::make_unique<FakeClient>(
+        &shared_pacer, time_controller_.GetClock()));
+    clients.back()->set_interval(TimeDelta::Millis(5));
+    shared_pacer.Schedule(clients.back().get(),
+                          kStartTime + TimeDelta::Micros(1000 + 8 * i));
+  }
+
+  // Runs every 5 ms from kStartTime + 5 ms on.
+  time_controller_.AdvanceTime(TimeDelta::Millis(998));
+  SharedPacer::Stats stats = shared_pacer.GetStats();
+  EXPECT_EQ(stats.wakeups, 199);
+  EXPECT_EQ(stats.pacer_runs, 500 * 199);
+  clients.clear();
+}
+
+TEST_F(SharedPacerTest, RemovedClientIsNotProcessed) {
+  auto removed = std::make_unique<FakeClient>(&shared_pacer_,
+                                              time_controller_.GetClock());
+  FakeClient kept(&shared_pacer_, time_controller_.GetClock());
+  shared_pacer_.Schedule(removed.get(), kStartTime + TimeDelta::Millis(5));
+  shared_pacer_.Schedule(&kept, kStartTime + TimeDelta::Millis(10));
+  removed.reset();
+
+  time_controller_.AdvanceTime(TimeDelta::Seconds(1));
+  EXPECT_THAT(kept.run_times, ElementsAre(kStartTime + TimeDelta::Millis(10)));
+}
+
+TEST_F(SharedPacerTest, ReportsQueueDelayPercentilesPerClient) {
+  FakeClient first(&shared_pacer_, time_controller_.GetClock());
+  FakeClient second(&shared_pacer_, time_controller_.GetClock());
+  for (int i = 1; i <= 100; ++i) {
+    shared_pacer_.OnPacketSent(&first, TimeDelta::Millis(i));
+  }
+  shared_pacer_.OnPacketSent(&second, TimeDelta::Millis(3));
+
+  SharedPacer::Stats stats = shared_pacer_.GetStats();
+  ASSERT_EQ(stats.pacers.size(), 2u);
+  EXPECT_EQ(stats.pacers[0].id, 0);
+  EXPECT_EQ(stats.pacers[0].packets_sent, 100);
+  EXPECT_THAT(stats.pacers[0].queue_delay_p50, Optional(TimeDelta::Millis(50)));
+  EXPECT_THAT(stats.pacers[0].queue_delay_p95, Optional(TimeDelta::Millis(95)));
+  EXPECT_THAT(stats.pacers[0].queue_delay_p99, Optional(TimeDelta::Millis(99)));
+  EXPECT_EQ(stats.pacers[1].id, 1);
+  EXPECT_EQ(stats.pacers[1].packets_sent, 1);
+  EXPECT_THAT(stats.pacers[1].queue_delay_p99, Optional(TimeDelta::Millis(3)));
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -23,16 +23,65 @@ namespace webrtc {
 
 const int TaskQueuePacedSender::kNoPacketHoldback = -1;
 
+TaskQueuePacedSender::QueueDelayReporter::QueueDelayReporter(
+    PacingController::PacketSender* packet_sender,
+    SharedPacer* shared_pacer,
+    SharedPacer::Client* client)
+    : packet_sender_(packet_sender),
+      shared_pacer_(shared_pacer),
+      client_(client) {}
+
+void TaskQueuePacedSender::QueueDelayReporter::SendPacket(
+    std::unique_ptr<RtpPacketToSend> packet,
+    const PacedPacketInfo& cluster_info) {
+  // Padding and FEC are generated when sent, and never wait in the queue.
+  if (packet->time_in_send_queue()) {
+    shared_pacer_->OnPacketSent(client_, *packet->time_in_send_queue());
+  }
+  packet_sender_->SendPacket(std::move(packet), cluster_info);
+}
+
+std::vector<std::unique_ptr<RtpPacketToSend>>
+TaskQueuePacedSender::QueueDelayReporter::FetchFec() {
+  return packet_sender_->FetchFec();
+}
+
+std::vector<std::unique_ptr<RtpPacketToSend>>
+TaskQueuePacedSender::QueueDelayReporter::GeneratePadding(DataSize size) {
+  return packet_sender_->GeneratePadding(size);
+}
+
+void TaskQueuePacedSender::QueueDelayReporter::OnBatchComplete() {
+  packet_sender_->OnBatchComplete();
+}
+
+void TaskQueuePacedSender::QueueDelayReporter::OnAbortedRetransmissions(
+    uint32_t ssrc,
+    rtc::ArrayView<const uint16_t> sequence_numbers) {
+  packet_sender_->OnAbortedRetransmissions(ssrc, sequence_numbers);
+}
+
+absl::optional<uint32_t>
+TaskQueuePacedSender::QueueDelayReporter::GetRtxSsrcForMedia(
+    uint32_t ssrc) const {
+  return packet_sender_->GetRtxSsrcForMedia(ssrc);
+}
+
 TaskQueuePacedSender::TaskQueuePacedSender(
     Clock* clock,
     PacingController::PacketSender* packet_sender,
     const FieldTrialsView& field_trials,
     TimeDelta max_hold_back_window,
-    int max_hold_back_window_in_packets)
+    int max_hold_back_window_in_packets,
+    SharedPacer* shared_pacer)
     : clock_(clock),
       max_hold_back_window_(max_hold_back_window),
       max_hold_back_window_in_packets_(max_hold_back_window_in_packets),
-      pacing_controller_(clock, packet_sender, field_trials),
+      shared_pacer_(shared_pacer),
+      queue_delay_reporter_(packet_sender, shared_pacer, this),
+      pacing_controller_(clock,
+                         shared_pacer ? &queue_delay_reporter_ : packet_sender,
+                         field_trials),
       next_process_time_(Timestamp::MinusInfinity()),
       is_started_(false),
       is_shutdown_(false),
@@ -40,11 +89,18 @@ TaskQueuePacedSender::TaskQueuePacedSender(
       include_overhead_(false),
       task_queue_(TaskQueueBase::Current()) {
   RTC_DCHECK_GE(max_hold_back_window_, PacingController::kMinSleepTime);
+  if (shared_pacer_) {
+    RTC_DCHECK_EQ(shared_pacer_->task_queue(), task_queue_);
+    shared_pacer_->AddClient(this);
+  }
 }
 
 TaskQueuePacedSender::~TaskQueuePacedSender() {
   RTC_DCHECK_RUN_ON(task_queue_);
   is_shutdown_ = true;
+  if (shared_pacer_) {
+    shared_pacer_->RemoveClient(this);
+  }
 }
 
 void TaskQueuePacedSender::SetSendBurstInterval(TimeDelta burst_interval) {
@@ -184,6 +240,11 @@ void TaskQueuePacedSender::OnStatsUpdated(const Stats& stats) {
   current_stats_ = stats;
 }
 
+void TaskQueuePacedSender::OnScheduledProcess(
+    Timestamp scheduled_process_time) {
+  MaybeProcessPackets(scheduled_process_time);
+}
+
 // RTC_RUN_ON(task_queue_)
 void TaskQueuePacedSender::MaybeScheduleProcessPackets() {
   if (!processing_packets_)
@@ -264,12 +325,18 @@ void TaskQueuePacedSender::MaybeProcessPackets(
   // schedule a new one. Previous in flight task will be retired.
   if (next_process_time_.IsMinusInfinity() ||
       next_process_time_ > next_send_time) {
-    // Prefer low precision if allowed and not probing.
-    task_queue_->PostDelayedHighPrecisionTask(
-        SafeTask(
-            safety_.flag(),
-            [this, next_send_time]() { MaybeProcessPackets(next_send_time); }),
-        time_to_next_process.RoundUpTo(TimeDelta::Millis(1)));
+    if (shared_pacer_) {
+      // Replaces the process time scheduled before, if any.
+      shared_pacer_->Schedule(this, next_send_time);
+    } else {
+      // Prefer low precision if allowed and not probing.
+      task_queue_->PostDelayedHighPrecisionTask(
+          SafeTask(safety_.flag(),
+                   [this, next_send_time]() {
+                     MaybeProcessPackets(next_send_time);
+                   }),
+          time_to_next_process.RoundUpTo(TimeDelta::Millis(1)));
+    }
     next_process_time_ = next_send_time;
   }
 }
@@ -18,6 +18,7 @@
 #include <vector>
 
 #include "absl/types/optional.h"
+#include "api/array_view.h"
 #include "api/field_trials_view.h"
 #include "api/sequence_checker.h"
 #include "api/task_queue/pending_task_safety_flag.h"
@@ -26,6 +27,7 @@
 #include "api/units/timestamp.h"
 #include "modules/pacing/pacing_controller.h"
 #include "modules/pacing/rtp_packet_pacer.h"
+#include "modules/pacing/shared_pacer.h"
 #include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
 #include "rtc_base/experiments/field_trial_parser.h"
 #include "rtc_base/numerics/exp_filter.h"
@@ -34,7 +36,9 @@
 namespace webrtc {
 class Clock;
 
-class TaskQueuePacedSender : public RtpPacketPacer, public RtpPacketSender {
+class TaskQueuePacedSender : public RtpPacketPacer,
+                             public RtpPacketSender,
+                             private SharedPacer::Client {
  public:
   static const int kNoPacketHoldback;
 
@@ -47,11 +51,16 @@ class TaskQueuePacedSender : public RtpPacketPacer, public RtpPacketSender {
   //
   // The taskqueue used when constructing a TaskQueuePacedSender will also be
   // used for pacing.
+  //
+  // If `shared_pacer` is set, it schedules the processing of this pacer
+  // together with others instead of a delayed task of its own. It must run on
+  // the same task queue and outlive this pacer.
   TaskQueuePacedSender(Clock* clock,
                        PacingController::PacketSender* packet_sender,
                        const FieldTrialsView& field_trials,
                        TimeDelta max_hold_back_window,
-                       int max_hold_back_window_in_packets);
+                       int max_hold_back_window_in_packets,
+                       SharedPacer* shared_pacer = nullptr);
 
   ~TaskQueuePacedSender() override;
 
@@ -132,6 +141,34 @@ class TaskQueuePacedSender : public RtpPacketPacer, public RtpPacketSender {
   void OnStatsUpdated(const Stats& stats);
 
  private:
+  // Forwards packets to the sender given to the constructor, and reports the
+  // time they spent in the queue to the shared pacer.
+  class QueueDelayReporter : public PacingController::PacketSender {
+   public:
+    QueueDelayReporter(PacingController::PacketSender* packet_sender,
+                       SharedPacer* shared_pacer,
+                       SharedPacer::Client* client);
+
+    void SendPacket(std::unique_ptr<RtpPacketToSend> packet,
+                    const PacedPacketInfo& cluster_info) override;
+    std::vector<std::unique_ptr<RtpPacketToSend>> FetchFec() override;
+    std::vector<std::unique_ptr<RtpPacketToSend>> GeneratePadding(
+        DataSize size) override;
+    void OnBatchComplete() override;
+    void OnAbortedRetransmissions(
+        uint32_t ssrc,
+        rtc::ArrayView<const uint16_t> sequence_numbers) override;
+    absl::optional<uint32_t> GetRtxSsrcForMedia(uint32_t ssrc) const override;
+
+   private:
+    PacingController::PacketSender* const packet_sender_;
+    SharedPacer* const shared_pacer_;
+    SharedPacer::Client* const client_;
+  };
+
+  // Implements SharedPacer::Client.
+  void OnScheduledProcess(Timestamp scheduled_process_time) override;
+
   // Call in response to state updates that could warrant sending out packets.
   // Protected against re-entry from packet sent receipts.
   void MaybeScheduleProcessPackets() RTC_RUN_ON(task_queue_);
@@ -152,6 +189,8 @@ class TaskQueuePacedSender : public RtpPacketPacer, public RtpPacketSender {
   const TimeDelta max_hold_back_window_;
   const int max_hold_back_window_in_packets_;
 
+  SharedPacer* const shared_pacer_;
+  QueueDelayReporter queue_delay_reporter_;
   PacingController pacing_controller_ RTC_GUARDED_BY(task_queue_);
 
   // We want only one (valid) delayed process task in flight at a time.
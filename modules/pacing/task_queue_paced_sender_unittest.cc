@@ -27,6 +27,7 @@
 #include "api/units/time_delta.h"
 #include "modules/pacing/pacing_controller.h"
 #include "modules/pacing/packet_router.h"
+#include "modules/pacing/shared_pacer.h"
 #include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
 #include "test/gmock.h"
 #include "test/gtest.h"
@@ -34,10 +35,13 @@
 #include "test/time_controller/simulated_time_controller.h"
 
 using ::testing::_;
+using ::testing::AllOf;
 using ::testing::AtLeast;
 using ::testing::AtMost;
+using ::testing::Gt;
 using ::testing::Lt;
 using ::testing::NiceMock;
+using ::testing::Optional;
 using ::testing::Return;
 using ::testing::SaveArg;
 
@@ -765,5 +769,58 @@ TEST(TaskQueuePacedSenderTest, Stats) {
   EXPECT_TRUE(pacer.ExpectedQueueTime().IsZero());
 }
 
+TEST(TaskQueuePacedSenderTest, PacesPacketsOfSeveralPacersWithSharedPacer) {
+  static constexpr int kNumPacers = 10;
+  static constexpr size_t kPacketsToSend = 42;
+  GlobalSimulatedTimeController time_controller(Timestamp::Millis(1234));
+  ScopedKeyValueConfig trials;
+  SharedPacer::Config config;
+  config.coalescing_window = TimeDelta::Millis(5);
+  SharedPacer shared_pacer(time_controller.GetMainThread(),
+                           time_controller.GetClock(), config);
+  std::vector<std::unique_ptr<MockPacketRouter>> packet_routers;
+  std::vector<std::unique_ptr<TaskQueuePacedSender>> pacers;
+  std::vector<size_t> packets_sent(kNumPacers);
+  for (int i = 0; i < kNumPacers; ++i) {
+    packet_routers.push_back(std::make_unique<NiceMock<MockPacketRouter>>());
+    ON_CALL(*packet_routers.back(), SendPacket)
+        .WillByDefault([&packets_sent, i] { ++packets_sent[i]; });
+    pacers.push_back(std::make_unique<TaskQueuePacedSender>(
+        time_controller.GetClock(), packet_routers.back().get(), trials,
+        PacingController::kMinSleepTime,
+        TaskQueuePacedSender::kNoPacketHoldback, &shared_pacer));
+    pacers.back()->SetPacingRates(
+        DataRate::BitsPerSec(kDefaultPacketSize * 8 * kPacketsToSend),
+        DataRate::Zero());
+    pacers.back()->EnsureStarted();
+    pacers.back()->EnqueuePackets(
+        GeneratePackets(RtpPacketMediaType::kVideo, kPacketsToSend));
+  }
+
+  // Each pacer sends its packets over close to 1s, as it would on its own.
+  time_controller.AdvanceTime(TimeDelta::Millis(900));
+  for (int i = 0; i < kNumPacers; ++i) {
+    EXPECT_LT(packets_sent[i], kPacketsToSend);
+  }
+  time_controller.AdvanceTime(TimeDelta::Millis(150));
+  for (int i = 0; i < kNumPacers; ++i) {
+    EXPECT_EQ(packets_sent[i], kPacketsToSend);
+  }
+
+  // The pacers were processed together, at most once per coalescing window.
+  SharedPacer::Stats stats = shared_pacer.GetStats();
+  EXPECT_LE(stats.wakeups, 1050 / 5 + 1);
+  EXPECT_GE(stats.pacer_runs, kNumPacers * stats.wakeups / 2);
+  ASSERT_EQ(stats.pacers.size(), size_t{kNumPacers});
+  for (const SharedPacer::PacerStats& pacer_stats : stats.pacers) {
+    EXPECT_EQ(pacer_stats.packets_sent, int64_t{kPacketsToSend});
+    // Packets were all enqueued at once, and sent evenly over a second.
+    EXPECT_THAT(pacer_stats.queue_delay_p50,
+                Optional(AllOf(Gt(TimeDelta::Millis(400)),
+                               Lt(TimeDelta::Millis(600)))));
+  }
+  pacers.clear();
+}
+
 }  // namespace test
 }  // namespace webrtc
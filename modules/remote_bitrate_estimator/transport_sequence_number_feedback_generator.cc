@@ -34,6 +34,11 @@ constexpr TimeDelta kBackWindow = TimeDelta::Millis(500);
 constexpr TimeDelta kMinInterval = TimeDelta::Millis(50);
 constexpr TimeDelta kMaxInterval = TimeDelta::Millis(250);
 constexpr TimeDelta kDefaultInterval = TimeDelta::Millis(100);
+// Fits the first received packet of a feedback message, even when it follows
+// the most missing packets MaybeBuildFeedbackPacket reports: the header, five
+// status chunks for 0x7FFE missing packets and the received one, and a two
+// byte delta.
+constexpr DataSize kMinFeedbackSize = DataSize::Bytes(20 + 5 * 2 + 2);
 
 TimeDelta GetAbsoluteSendTimeDelta(uint32_t new_sendtime,
                                    uint32_t previous_sendtime) {
@@ -61,6 +66,7 @@ TransportSequenceNumberFeedbackGenenerator::
       media_ssrc_(0),
       feedback_packet_count_(0),
       packet_overhead_(DataSize::Zero()),
+      max_feedback_size_(DataSize::PlusInfinity()),
       send_interval_(kDefaultInterval),
       send_periodic_feedback_(true),
       previous_abs_send_time_(0),
@@ -208,6 +214,12 @@ void TransportSequenceNumberFeedbackGenenerator::SetTransportOverhead(
   packet_overhead_ = overhead_per_packet;
 }
 
+void TransportSequenceNumberFeedbackGenenerator::SetMaxFeedbackSize(
+    DataSize max_feedback_size) {
+  MutexLock lock(&lock_);
+  max_feedback_size_ = std::max(max_feedback_size, kMinFeedbackSize);
+}
+
 void TransportSequenceNumberFeedbackGenenerator::SendPeriodicFeedbacks() {
   // `periodic_window_start_seq_` is the first sequence number to include in
   // the current feedback packet. Some older may still be in the map, in case
@@ -312,6 +324,9 @@ TransportSequenceNumberFeedbackGenenerator::MaybeBuildFeedbackPacket(
       feedback_packet =
           std::make_unique<rtcp::TransportFeedback>(include_timestamps);
       feedback_packet->SetMediaSsrc(media_ssrc_);
+      if (max_feedback_size_.IsFinite()) {
+        feedback_packet->SetMaxSize(max_feedback_size_.bytes());
+      }
 
       // It should be possible to add `seq` to this new `feedback_packet`,
       // If difference between `seq` and `begin_sequence_number_inclusive`,
@@ -56,6 +56,11 @@ class TransportSequenceNumberFeedbackGenenerator
 
   void SetTransportOverhead(DataSize overhead_per_packet) override;
 
+  // Splits feedback into several packets rather than exceeding
+  // `max_feedback_size` in one. Feedback is capped only by the format limit
+  // by default.
+  void SetMaxFeedbackSize(DataSize max_feedback_size);
+
  private:
   void MaybeCullOldPackets(int64_t sequence_number, Timestamp arrival_time)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(&lock_);
@@ -93,6 +98,7 @@ class TransportSequenceNumberFeedbackGenenerator
   uint8_t feedback_packet_count_ RTC_GUARDED_BY(&lock_);
   SeqNumUnwrapper<uint16_t> unwrapper_ RTC_GUARDED_BY(&lock_);
   DataSize packet_overhead_ RTC_GUARDED_BY(&lock_);
+  DataSize max_feedback_size_ RTC_GUARDED_BY(&lock_);
 
   // The next sequence number that should be the start sequence number during
   // periodic reporting. Will be absl::nullopt before the first seen packet.
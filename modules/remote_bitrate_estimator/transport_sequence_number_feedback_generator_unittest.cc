@@ -31,6 +31,7 @@ namespace webrtc {
 namespace {
 
 using ::testing::_;
+using ::testing::AtLeast;
 using ::testing::ElementsAre;
 using ::testing::Invoke;
 using ::testing::MockFunction;
@@ -223,6 +224,37 @@ TEST_F(TransportSequenceNumberFeedbackGeneneratorTest,
   Process();
 }
 
+TEST_F(TransportSequenceNumberFeedbackGeneneratorTest,
+       SplitsFeedbackLargerThanMaxFeedbackSize) {
+  static constexpr DataSize kMaxFeedbackSize = DataSize::Bytes(40);
+  static constexpr int kNumPackets = 50;
+  feedback_generator_.SetMaxFeedbackSize(kMaxFeedbackSize);
+  for (int i = 0; i < kNumPackets; ++i) {
+    IncomingPacket(kBaseSeq + i, kBaseTime + TimeDelta::Millis(i));
+  }
+
+  std::vector<uint16_t> reported_sequence_numbers;
+  EXPECT_CALL(feedback_sender_, Call)
+      .Times(AtLeast(2))
+      .WillRepeatedly(
+          [&](std::vector<std::unique_ptr<rtcp::RtcpPacket>> feedback_packets) {
+            ASSERT_THAT(feedback_packets, SizeIs(1));
+            EXPECT_LE(DataSize::Bytes(feedback_packets[0]->BlockLength()),
+                      kMaxFeedbackSize);
+            for (uint16_t sequence_number :
+                 SequenceNumbers(*static_cast<rtcp::TransportFeedback*>(
+                     feedback_packets[0].get()))) {
+              reported_sequence_numbers.push_back(sequence_number);
+            }
+          });
+
+  Process();
+  ASSERT_THAT(reported_sequence_numbers, SizeIs(kNumPackets));
+  for (int i = 0; i < kNumPackets; ++i) {
+    EXPECT_EQ(reported_sequence_numbers[i], kBaseSeq + i);
+  }
+}
+
 TEST_F(TransportSequenceNumberFeedbackGeneneratorTest,
        SendsFragmentedFeedback) {
   static constexpr TimeDelta kTooLargeDelta =
@@ -59,6 +59,10 @@ class ReceiveStatistics : public ReceiveStatisticsProvider,
   // Returns a thread-safe instance of ReceiveStatistics.
   // https://chromium.googlesource.com/chromium/src/+/lkgr/docs/threading_and_tasks.md#threading-lexicon
   static std::unique_ptr<ReceiveStatistics> Create(Clock* clock);
+  // Returns a thread-safe instance of ReceiveStatistics where incoming packets
+  // of known SSRCs are accounted without waiting for other SSRCs or for RTCP
+  // report generation. Meant for receivers of many SSRCs.
+  static std::unique_ptr<ReceiveStatistics> CreateConcurrent(Clock* clock);
   // Returns a thread-compatible instance of ReceiveStatistics.
   static std::unique_ptr<ReceiveStatistics> CreateThreadCompatible(
       Clock* clock);
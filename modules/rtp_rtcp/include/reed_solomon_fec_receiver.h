@@ -0,0 +1,101 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_RTP_RTCP_INCLUDE_REED_SOLOMON_FEC_RECEIVER_H_
+#define MODULES_RTP_RTCP_INCLUDE_REED_SOLOMON_FEC_RECEIVER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <limits>
+#include <map>
+#include <vector>
+
+#include "api/sequence_checker.h"
+#include "api/units/timestamp.h"
+#include "modules/rtp_rtcp/include/recovered_packet_receiver.h"
+#include "modules/rtp_rtcp/include/rtp_header_extension_map.h"
+#include "modules/rtp_rtcp/source/reed_solomon_fec_packet.h"
+#include "modules/rtp_rtcp/source/rtp_packet_received.h"
+#include "modules/rtp_rtcp/source/ulpfec_receiver.h"
+#include "rtc_base/copy_on_write_buffer.h"
+#include "rtc_base/numerics/sequence_number_unwrapper.h"
+#include "rtc_base/system/no_unique_address.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+class Clock;
+
+// Receiver of the FEC packets of ReedSolomonFecSender. Like FlexfecReceiver,
+// only the recovered media packets are returned through the callback.
+class ReedSolomonFecReceiver {
+ public:
+  ReedSolomonFecReceiver(Clock* clock,
+                         uint32_t ssrc,
+                         uint32_t protected_media_ssrc,
+                         RecoveredPacketReceiver* recovered_packet_receiver);
+  ~ReedSolomonFecReceiver();
+
+  // Inserts a received packet (can be either media or FEC), and recovers the
+  // missing media packets of the blocks that have received enough packets.
+  void OnRtpPacket(const RtpPacketReceived& packet);
+
+  // Returns a counter describing the added and recovered packets.
+  FecPacketCounter GetPacketCounter() const;
+
+ private:
+  struct Block {
+    ReedSolomonFecHeader header;
+    // Received parity shards, indexed by FEC index. Empty if not received.
+    std::vector<rtc::CopyOnWriteBuffer> parity;
+    int num_parity = 0;
+    size_t parity_bytes = 0;
+  };
+
+  void AddMediaPacket(const RtpPacketReceived& packet);
+  void AddFecPacket(const RtpPacketReceived& packet);
+  // Recovers the missing media packets of the block starting at
+  // `seq_num_base`, if possible. Erases the block once it is complete.
+  void MaybeRecover(int64_t seq_num_base);
+  void PruneHistory(int64_t newest_seq_num);
+  void EraseBlock(std::map<int64_t, Block>::iterator it);
+
+  // Config.
+  const uint32_t ssrc_;
+  const uint32_t protected_media_ssrc_;
+  RecoveredPacketReceiver* const recovered_packet_receiver_;
+
+  // Received media packets and incomplete blocks, by unwrapped media sequence
+  // number.
+  RtpSequenceNumberUnwrapper seq_num_unwrapper_
+      RTC_GUARDED_BY(sequence_checker_);
+  std::map<int64_t, rtc::CopyOnWriteBuffer> media_packets_
+      RTC_GUARDED_BY(sequence_checker_);
+  std::map<int64_t, Block> blocks_ RTC_GUARDED_BY(sequence_checker_);
+  // Sum of the parity shard sizes of `blocks_`.
+  size_t parity_bytes_ RTC_GUARDED_BY(sequence_checker_) = 0;
+  // Packets before this are no longer in the history.
+  int64_t history_start_ RTC_GUARDED_BY(sequence_checker_) =
+      std::numeric_limits<int64_t>::min();
+  RtpHeaderExtensionMap extensions_ RTC_GUARDED_BY(sequence_checker_);
+
+  // Logging and stats.
+  Clock* const clock_;
+  Timestamp last_recovered_packet_ RTC_GUARDED_BY(sequence_checker_) =
+      Timestamp::MinusInfinity();
+  FecPacketCounter packet_counter_ RTC_GUARDED_BY(sequence_checker_);
+
+  RTC_NO_UNIQUE_ADDRESS SequenceChecker sequence_checker_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_RTP_RTCP_INCLUDE_REED_SOLOMON_FEC_RECEIVER_H_
@@ -0,0 +1,128 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_RTP_RTCP_INCLUDE_REED_SOLOMON_FEC_SENDER_H_
+#define MODULES_RTP_RTCP_INCLUDE_REED_SOLOMON_FEC_SENDER_H_
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
+#include "api/array_view.h"
+#include "api/rtp_parameters.h"
+#include "api/units/data_rate.h"
+#include "api/units/timestamp.h"
+#include "modules/include/module_fec_types.h"
+#include "modules/rtp_rtcp/include/rtp_header_extension_map.h"
+#include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
+#include "modules/rtp_rtcp/source/rtp_header_extension_size.h"
+#include "modules/rtp_rtcp/source/video_fec_generator.h"
+#include "rtc_base/bitrate_tracker.h"
+#include "rtc_base/buffer.h"
+#include "rtc_base/copy_on_write_buffer.h"
+#include "rtc_base/random.h"
+#include "rtc_base/synchronization/mutex.h"
+
+namespace webrtc {
+
+class Clock;
+class RtpPacketToSend;
+
+// Alternative to FlexfecSender that protects media packets with a
+// Reed-Solomon erasure code instead of XOR parity. Any N lost media packets
+// of a block protected by N FEC packets can be recovered, which XOR masks
+// can't do for bursts of consecutive losses. The FEC packets are sent on the
+// FlexFEC SSRC, in the format of reed_solomon_fec_packet.h, which only
+// ReedSolomonFecReceiver understands. RtpVideoSender and
+// FlexfecReceiveStreamImpl use them instead of FlexfecSender and
+// FlexfecReceiver when the "WebRTC-ReedSolomonFec" field trial is enabled,
+// which must be the case on both ends.
+//
+// Note that this class is not thread safe, and thus requires external
+// synchronization, like FlexfecSender.
+class ReedSolomonFecSender : public VideoFecGenerator {
+ public:
+  // The largest block of media packets that is protected by one set of FEC
+  // packets.
+  static constexpr size_t kMaxMediaPackets = 128;
+
+  ReedSolomonFecSender(int payload_type,
+                       uint32_t ssrc,
+                       uint32_t protected_media_ssrc,
+                       absl::string_view mid,
+                       const std::vector<RtpExtension>& rtp_header_extensions,
+                       rtc::ArrayView<const RtpExtensionSize> extension_sizes,
+                       const RtpState* rtp_state,
+                       Clock* clock);
+  ~ReedSolomonFecSender() override;
+
+  // Sent on its own SSRC and without RED, as FlexFEC.
+  FecType GetFecType() const override { return FecType::kFlexFec; }
+  absl::optional<uint32_t> FecSsrc() override { return ssrc_; }
+
+  // Sets the FEC rate and max frames sent before FEC packets are sent. The
+  // mask type is ignored.
+  void SetProtectionParameters(const FecProtectionParams& delta_params,
+                               const FecProtectionParams& key_params) override;
+
+  // Adds a media packet to the current block. Once it ends a frame and enough
+  // frames are protected, the FEC packets of the block are generated.
+  void AddPacketAndGenerateFec(const RtpPacketToSend& packet) override;
+
+  std::vector<std::unique_ptr<RtpPacketToSend>> GetFecPackets() override;
+
+  size_t MaxPacketOverhead() const override;
+
+  DataRate CurrentFecRate() const override;
+
+  absl::optional<RtpState> GetRtpState() override;
+
+ private:
+  void GenerateFec(int fec_rate);
+  void ResetState();
+
+  // Utility.
+  Clock* const clock_;
+  Random random_;
+  Timestamp last_generated_packet_ = Timestamp::MinusInfinity();
+
+  // Config.
+  const int payload_type_;
+  const uint32_t timestamp_offset_;
+  const uint32_t ssrc_;
+  const uint32_t protected_media_ssrc_;
+  const std::string mid_;
+  const RtpHeaderExtensionMap rtp_header_extension_map_;
+  const size_t header_extensions_size_;
+  // Sequence number of next packet to generate.
+  uint16_t seq_num_;
+
+  // Block of media packets that are being protected.
+  FecProtectionParams delta_params_;
+  FecProtectionParams key_params_;
+  std::vector<rtc::CopyOnWriteBuffer> media_packets_;
+  uint16_t seq_num_base_ = 0;
+  int num_protected_frames_ = 0;
+  bool media_contains_keyframe_ = false;
+  // FEC header and parity shard of the FEC packets to send.
+  std::vector<rtc::Buffer> fec_payloads_;
+
+  mutable Mutex mutex_;
+  absl::optional<std::pair<FecProtectionParams, FecProtectionParams>>
+      pending_params_ RTC_GUARDED_BY(mutex_);
+  BitrateTracker fec_bitrate_ RTC_GUARDED_BY(mutex_);
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_RTP_RTCP_INCLUDE_REED_SOLOMON_FEC_SENDER_H_
@@ -0,0 +1,101 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/fec_xor.h"
+
+#if defined(WEBRTC_HAS_NEON)
+#include <arm_neon.h>
+#endif
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#include <emmintrin.h>
+#endif
+#include <string.h>
+
+#include "system_wrappers/include/cpu_features_wrapper.h"
+
+namespace webrtc {
+namespace {
+
+using XorFunction = void (*)(const uint8_t* src, size_t length, uint8_t* dst);
+
+XorFunction SelectXorFunction() {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (GetCPUInfo(kAVX2)) {
+    return &fec_xor_internal::XorBytes_AVX2;
+  }
+  if (GetCPUInfo(kSSE2)) {
+    return &fec_xor_internal::XorBytes_SSE2;
+  }
+  return &fec_xor_internal::XorBytes_C;
+#elif defined(WEBRTC_HAS_NEON)
+  return &fec_xor_internal::XorBytes_NEON;
+#else
+  return &fec_xor_internal::XorBytes_C;
+#endif
+}
+
+}  // namespace
+
+void XorBytes(const uint8_t* src, size_t length, uint8_t* dst) {
+  static const XorFunction xor_function = SelectXorFunction();
+  xor_function(src, length, dst);
+}
+
+namespace fec_xor_internal {
+
+void XorBytes_C(const uint8_t* src, size_t length, uint8_t* dst) {
+  size_t i = 0;
+  for (; i + 8 <= length; i += 8) {
+    uint64_t s;
+    uint64_t d;
+    memcpy(&s, src + i, 8);
+    memcpy(&d, dst + i, 8);
+    d ^= s;
+    memcpy(dst + i, &d, 8);
+  }
+  for (; i < length; ++i) {
+    dst[i] ^= src[i];
+  }
+}
+
+#if defined(WEBRTC_HAS_NEON)
+void XorBytes_NEON(const uint8_t* src, size_t length, uint8_t* dst) {
+  size_t i = 0;
+  for (; i + 32 <= length; i += 32) {
+    const uint8x16_t s0 = vld1q_u8(src + i);
+    const uint8x16_t s1 = vld1q_u8(src + i + 16);
+    const uint8x16_t d0 = vld1q_u8(dst + i);
+    const uint8x16_t d1 = vld1q_u8(dst + i + 16);
+    vst1q_u8(dst + i, veorq_u8(d0, s0));
+    vst1q_u8(dst + i + 16, veorq_u8(d1, s1));
+  }
+  for (; i + 16 <= length; i += 16) {
+    vst1q_u8(dst + i, veorq_u8(vld1q_u8(dst + i), vld1q_u8(src + i)));
+  }
+  XorBytes_C(src + i, length - i, dst + i);
+}
+#endif
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+void XorBytes_SSE2(const uint8_t* src, size_t length, uint8_t* dst) {
+  size_t i = 0;
+  for (; i + 16 <= length; i += 16) {
+    const __m128i s =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    const __m128i d =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_xor_si128(d, s));
+  }
+  XorBytes_C(src + i, length - i, dst + i);
+}
+#endif
+
+}  // namespace fec_xor_internal
+}  // namespace webrtc
@@ -0,0 +1,47 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_RTP_RTCP_SOURCE_FEC_XOR_H_
+#define MODULES_RTP_RTCP_SOURCE_FEC_XOR_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Defines WEBRTC_ARCH_X86_FAMILY, used below.
+#include "rtc_base/system/arch.h"
+
+namespace webrtc {
+
+// XORs `length` bytes of `src` into `dst`, using the fastest implementation
+// the CPU supports. Neither buffer needs to be aligned.
+void XorBytes(const uint8_t* src, size_t length, uint8_t* dst);
+
+namespace fec_xor_internal {
+
+// Portable implementation, XORing eight bytes at a time.
+void XorBytes_C(const uint8_t* src, size_t length, uint8_t* dst);
+
+#if defined(WEBRTC_HAS_NEON)
+// Implementation optimized for NEON.
+void XorBytes_NEON(const uint8_t* src, size_t length, uint8_t* dst);
+#endif
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+// Implementation optimized for SSE2.
+void XorBytes_SSE2(const uint8_t* src, size_t length, uint8_t* dst);
+
+// Implementation optimized for AVX2.
+void XorBytes_AVX2(const uint8_t* src, size_t length, uint8_t* dst);
+#endif
+
+}  // namespace fec_xor_internal
+}  // namespace webrtc
+
+#endif  // MODULES_RTP_RTCP_SOURCE_FEC_XOR_H_
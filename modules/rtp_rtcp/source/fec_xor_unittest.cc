@@ -0,0 +1,88 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/fec_xor.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "rtc_base/random.h"
+#include "system_wrappers/include/cpu_features_wrapper.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::ElementsAreArray;
+
+using XorFunction = void (*)(const uint8_t* src, size_t length, uint8_t* dst);
+
+std::vector<uint8_t> RandomBytes(Random& random, size_t size) {
+  std::vector<uint8_t> bytes(size);
+  for (uint8_t& byte : bytes) {
+    byte = random.Rand<uint8_t>();
+  }
+  return bytes;
+}
+
+// Checks `xor_function` against a byte by byte XOR, for all lengths that
+// exercise the vector loops and the remainder, and for unaligned buffers.
+void ExpectXorsLikeScalarLoop(XorFunction xor_function) {
+  Random random(0x1234);
+  for (size_t offset = 0; offset < 4; ++offset) {
+    for (size_t length = 0; length <= 100; ++length) {
+      const std::vector<uint8_t> src = RandomBytes(random, offset + length);
+      std::vector<uint8_t> dst = RandomBytes(random, offset + length + 1);
+      std::vector<uint8_t> expected = dst;
+      for (size_t i = 0; i < length; ++i) {
+        expected[offset + i] ^= src[offset + i];
+      }
+
+      xor_function(src.data() + offset, length, dst.data() + offset);
+      EXPECT_THAT(dst, ElementsAreArray(expected))
+          << "offset " << offset << ", length " << length;
+    }
+  }
+}
+
+TEST(FecXorTest, XorBytes) {
+  ExpectXorsLikeScalarLoop(&XorBytes);
+}
+
+TEST(FecXorTest, XorBytes_C) {
+  ExpectXorsLikeScalarLoop(&fec_xor_internal::XorBytes_C);
+}
+
+#if defined(WEBRTC_HAS_NEON)
+TEST(FecXorTest, XorBytes_NEON) {
+  ExpectXorsLikeScalarLoop(&fec_xor_internal::XorBytes_NEON);
+}
+#endif
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+TEST(FecXorTest, XorBytes_SSE2) {
+  if (!GetCPUInfo(kSSE2)) {
+    GTEST_SKIP() << "SSE2 is not supported.";
+  }
+  ExpectXorsLikeScalarLoop(&fec_xor_internal::XorBytes_SSE2);
+}
+
+TEST(FecXorTest, XorBytes_AVX2) {
+  if (!GetCPUInfo(kAVX2)) {
+    GTEST_SKIP() << "AVX2 is not supported.";
+  }
+  ExpectXorsLikeScalarLoop(&fec_xor_internal::XorBytes_AVX2);
+}
+#endif
+
+}  // namespace
+}  // namespace webrtc
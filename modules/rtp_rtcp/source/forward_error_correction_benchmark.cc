@@ -0,0 +1,180 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+
+#include "benchmark/benchmark.h"
+#include "modules/include/module_fec_types.h"
+#include "modules/rtp_rtcp/source/byte_io.h"
+#include "modules/rtp_rtcp/source/fec_test_helper.h"
+#include "modules/rtp_rtcp/source/forward_error_correction.h"
+#include "rtc_base/random.h"
+
+namespace webrtc {
+namespace {
+
+constexpr uint32_t kMediaSsrc = 0x1234;
+constexpr uint32_t kFlexfecSsrc = 0x5678;
+constexpr uint32_t kPacketSize = 1200;
+constexpr int kNumMediaPackets = 12;
+// 50% protection, i.e. 6 FEC packets for the 12 media packets.
+constexpr uint8_t kProtectionFactor = 128;
+
+enum class FecType { kUlpfec, kFlexfec };
+
+std::unique_ptr<ForwardErrorCorrection> CreateFec(FecType fec_type) {
+  return fec_type == FecType::kUlpfec
+             ? ForwardErrorCorrection::CreateUlpfec(kMediaSsrc)
+             : ForwardErrorCorrection::CreateFlexfec(kFlexfecSsrc, kMediaSsrc);
+}
+
+ForwardErrorCorrection::PacketList CreateMediaPackets() {
+  Random random(0x5eed);
+  test::fec::MediaPacketGenerator generator(kPacketSize, kPacketSize,
+                                            kMediaSsrc, &random);
+  return generator.ConstructMediaPackets(kNumMediaPackets,
+                                         /*start_seq_num=*/1000);
+}
+
+std::unique_ptr<ForwardErrorCorrection::ReceivedPacket> CreateReceivedPacket(
+    const ForwardErrorCorrection::Packet& packet,
+    bool is_fec,
+    uint32_t ssrc,
+    uint16_t seq_num) {
+  auto received_packet =
+      std::make_unique<ForwardErrorCorrection::ReceivedPacket>();
+  received_packet->pkt = new ForwardErrorCorrection::Packet();
+  received_packet->pkt->data = packet.data;
+  received_packet->is_fec = is_fec;
+  received_packet->ssrc = ssrc;
+  received_packet->seq_num = seq_num;
+  return received_packet;
+}
+
+// Passes the media packets, except every third, and then the FEC packets to
+// `decoder`. The packets are copied first since the decoder may modify them.
+size_t DecodeFec(
+    FecType fec_type,
+    const ForwardErrorCorrection::PacketList& media_packets,
+    const std::list<ForwardErrorCorrection::Packet*>& fec_packets,
+    ForwardErrorCorrection& decoder,
+    ForwardErrorCorrection::RecoveredPacketList& recovered_packets) {
+  size_t num_recovered_packets = 0;
+  uint16_t seq_num = 0;
+  int index = 0;
+  for (const auto& media_packet : media_packets) {
+    seq_num =
+        ByteReader<uint16_t>::ReadBigEndian(media_packet->data.cdata() + 2);
+    if (index++ % 3 == 1) {
+      continue;
+    }
+    std::unique_ptr<ForwardErrorCorrection::ReceivedPacket> received_packet =
+        CreateReceivedPacket(*media_packet, /*is_fec=*/false, kMediaSsrc,
+                             seq_num);
+    num_recovered_packets +=
+        decoder.DecodeFec(*received_packet, &recovered_packets)
+            .num_recovered_packets;
+  }
+  const uint32_t fec_ssrc =
+      fec_type == FecType::kUlpfec ? kMediaSsrc : kFlexfecSsrc;
+  for (const ForwardErrorCorrection::Packet* fec_packet : fec_packets) {
+    std::unique_ptr<ForwardErrorCorrection::ReceivedPacket> received_packet =
+        CreateReceivedPacket(*fec_packet, /*is_fec=*/true, fec_ssrc,
+                             ++seq_num);
+    num_recovered_packets +=
+        decoder.DecodeFec(*received_packet, &recovered_packets)
+            .num_recovered_packets;
+  }
+  return num_recovered_packets;
+}
+
+// Protects 12 media packets of 1200 bytes with 6 FEC packets.
+void BM_EncodeFec(benchmark::State& state,
+                  FecType fec_type,
+                  FecMaskType mask_type) {
+  std::unique_ptr<ForwardErrorCorrection> fec = CreateFec(fec_type);
+  const ForwardErrorCorrection::PacketList media_packets =
+      CreateMediaPackets();
+  std::list<ForwardErrorCorrection::Packet*> fec_packets;
+
+  for (auto _ : state) {
+    fec_packets.clear();
+    fec->EncodeFec(media_packets, kProtectionFactor,
+                   /*num_important_packets=*/0,
+                   /*use_unequal_protection=*/false, mask_type, &fec_packets);
+    benchmark::DoNotOptimize(fec_packets);
+  }
+  state.SetBytesProcessed(state.iterations() * kNumMediaPackets * kPacketSize);
+}
+
+// Receives the packets of BM_EncodeFec with every third media packet lost,
+// and recovers what the FEC packets allow.
+void BM_DecodeFec(benchmark::State& state,
+                  FecType fec_type,
+                  FecMaskType mask_type) {
+  const ForwardErrorCorrection::PacketList media_packets =
+      CreateMediaPackets();
+  std::unique_ptr<ForwardErrorCorrection> encoder = CreateFec(fec_type);
+  std::list<ForwardErrorCorrection::Packet*> fec_packets;
+  encoder->EncodeFec(media_packets, kProtectionFactor,
+                     /*num_important_packets=*/0,
+                     /*use_unequal_protection=*/false, mask_type,
+                     &fec_packets);
+
+  size_t num_recovered_packets = 0;
+  for (auto _ : state) {
+    std::unique_ptr<ForwardErrorCorrection> decoder = CreateFec(fec_type);
+    ForwardErrorCorrection::RecoveredPacketList recovered_packets;
+    num_recovered_packets += DecodeFec(fec_type, media_packets, fec_packets,
+                                       *decoder, recovered_packets);
+  }
+  state.SetBytesProcessed(state.iterations() * kNumMediaPackets * kPacketSize);
+  state.counters["recovered"] = benchmark::Counter(
+      num_recovered_packets, benchmark::Counter::kAvgIterations);
+}
+
+BENCHMARK_CAPTURE(BM_EncodeFec,
+                  UlpfecRandom,
+                  FecType::kUlpfec,
+                  kFecMaskRandom);
+BENCHMARK_CAPTURE(BM_EncodeFec,
+                  UlpfecBursty,
+                  FecType::kUlpfec,
+                  kFecMaskBursty);
+BENCHMARK_CAPTURE(BM_EncodeFec,
+                  FlexfecRandom,
+                  FecType::kFlexfec,
+                  kFecMaskRandom);
+BENCHMARK_CAPTURE(BM_EncodeFec,
+                  FlexfecBursty,
+                  FecType::kFlexfec,
+                  kFecMaskBursty);
+BENCHMARK_CAPTURE(BM_DecodeFec,
+                  UlpfecRandom,
+                  FecType::kUlpfec,
+                  kFecMaskRandom);
+BENCHMARK_CAPTURE(BM_DecodeFec,
+                  UlpfecBursty,
+                  FecType::kUlpfec,
+                  kFecMaskBursty);
+BENCHMARK_CAPTURE(BM_DecodeFec,
+                  FlexfecRandom,
+                  FecType::kFlexfec,
+                  kFecMaskRandom);
+BENCHMARK_CAPTURE(BM_DecodeFec,
+                  FlexfecBursty,
+                  FecType::kFlexfec,
+                  kFecMaskBursty);
+
+}  // namespace
+}  // namespace webrtc
@@ -0,0 +1,147 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/galois_field.h"
+
+#if defined(WEBRTC_HAS_NEON) && defined(WEBRTC_ARCH_64_BITS)
+#include <arm_neon.h>
+#endif
+
+#include "modules/rtp_rtcp/source/fec_xor.h"
+#include "rtc_base/checks.h"
+#include "system_wrappers/include/cpu_features_wrapper.h"
+
+namespace webrtc {
+namespace {
+
+constexpr int kFieldPolynomial = 0x11d;
+
+struct Tables {
+  // Twice the period of the generator, so that the sum of two logarithms can
+  // be looked up without reducing it modulo 255.
+  uint8_t exp[2 * 255];
+  uint8_t log[256];
+};
+
+constexpr Tables MakeTables() {
+  Tables tables{};
+  int x = 1;
+  for (int i = 0; i < 255; ++i) {
+    tables.exp[i] = static_cast<uint8_t>(x);
+    tables.exp[i + 255] = static_cast<uint8_t>(x);
+    tables.log[x] = static_cast<uint8_t>(i);
+    x <<= 1;
+    if (x & 0x100) {
+      x ^= kFieldPolynomial;
+    }
+  }
+  return tables;
+}
+
+constexpr Tables kTables = MakeTables();
+
+using MultiplyAddFunction = void (*)(uint8_t coefficient,
+                                     const uint8_t* src,
+                                     size_t length,
+                                     uint8_t* dst);
+
+MultiplyAddFunction SelectMultiplyAddFunction() {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (GetCPUInfo(kAVX2)) {
+    return &galois_field_internal::Gf256MultiplyAdd_AVX2;
+  }
+  return &galois_field_internal::Gf256MultiplyAdd_C;
+#elif defined(WEBRTC_HAS_NEON) && defined(WEBRTC_ARCH_64_BITS)
+  return &galois_field_internal::Gf256MultiplyAdd_NEON;
+#else
+  return &galois_field_internal::Gf256MultiplyAdd_C;
+#endif
+}
+
+}  // namespace
+
+uint8_t Gf256Multiply(uint8_t a, uint8_t b) {
+  if (a == 0 || b == 0) {
+    return 0;
+  }
+  return kTables.exp[kTables.log[a] + kTables.log[b]];
+}
+
+uint8_t Gf256Inverse(uint8_t a) {
+  RTC_DCHECK_NE(a, 0);
+  return kTables.exp[255 - kTables.log[a]];
+}
+
+void Gf256MultiplyAdd(uint8_t coefficient,
+                      const uint8_t* src,
+                      size_t length,
+                      uint8_t* dst) {
+  if (coefficient == 0) {
+    return;
+  }
+  if (coefficient == 1) {
+    XorBytes(src, length, dst);
+    return;
+  }
+  static const MultiplyAddFunction multiply_add = SelectMultiplyAddFunction();
+  multiply_add(coefficient, src, length, dst);
+}
+
+namespace galois_field_internal {
+
+void Gf256MultiplyAdd_C(uint8_t coefficient,
+                        const uint8_t* src,
+                        size_t length,
+                        uint8_t* dst) {
+  uint8_t products[256];
+  for (int i = 0; i < 256; ++i) {
+    products[i] = Gf256Multiply(coefficient, i);
+  }
+  for (size_t i = 0; i < length; ++i) {
+    dst[i] ^= products[src[i]];
+  }
+}
+
+void Gf256NibbleProducts(uint8_t coefficient,
+                         uint8_t low_products[16],
+                         uint8_t high_products[16]) {
+  for (int i = 0; i < 16; ++i) {
+    low_products[i] = Gf256Multiply(coefficient, i);
+    high_products[i] = Gf256Multiply(coefficient, i << 4);
+  }
+}
+
+#if defined(WEBRTC_HAS_NEON) && defined(WEBRTC_ARCH_64_BITS)
+void Gf256MultiplyAdd_NEON(uint8_t coefficient,
+                           const uint8_t* src,
+                           size_t length,
+                           uint8_t* dst) {
+  uint8_t low_products[16];
+  uint8_t high_products[16];
+  Gf256NibbleProducts(coefficient, low_products, high_products);
+  const uint8x16_t low_table = vld1q_u8(low_products);
+  const uint8x16_t high_table = vld1q_u8(high_products);
+  const uint8x16_t low_mask = vdupq_n_u8(0x0f);
+  size_t i = 0;
+  for (; i + 16 <= length; i += 16) {
+    const uint8x16_t s = vld1q_u8(src + i);
+    const uint8x16_t product =
+        veorq_u8(vqtbl1q_u8(low_table, vandq_u8(s, low_mask)),
+                 vqtbl1q_u8(high_table, vshrq_n_u8(s, 4)));
+    vst1q_u8(dst + i, veorq_u8(vld1q_u8(dst + i), product));
+  }
+  for (; i < length; ++i) {
+    dst[i] ^= Gf256Multiply(coefficient, src[i]);
+  }
+}
+#endif
+
+}  // namespace galois_field_internal
+}  // namespace webrtc
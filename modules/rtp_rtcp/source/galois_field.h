@@ -0,0 +1,68 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_RTP_RTCP_SOURCE_GALOIS_FIELD_H_
+#define MODULES_RTP_RTCP_SOURCE_GALOIS_FIELD_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Defines WEBRTC_ARCH_X86_FAMILY, used below.
+#include "rtc_base/system/arch.h"
+
+namespace webrtc {
+
+// Arithmetic in GF(2^8), with the field polynomial x^8 + x^4 + x^3 + x^2 + 1
+// that is commonly used for Reed-Solomon codes. Addition is XOR.
+uint8_t Gf256Multiply(uint8_t a, uint8_t b);
+// `a` must not be zero.
+uint8_t Gf256Inverse(uint8_t a);
+
+// Computes `dst[i] ^= coefficient * src[i]` for `length` bytes, using the
+// fastest implementation the CPU supports.
+void Gf256MultiplyAdd(uint8_t coefficient,
+                      const uint8_t* src,
+                      size_t length,
+                      uint8_t* dst);
+
+namespace galois_field_internal {
+
+// Portable implementation, using a product table for `coefficient`.
+void Gf256MultiplyAdd_C(uint8_t coefficient,
+                        const uint8_t* src,
+                        size_t length,
+                        uint8_t* dst);
+
+// Fills the products of `coefficient` and the 16 values of the low and of the
+// high nibble of a byte, for the table lookup implementations below.
+void Gf256NibbleProducts(uint8_t coefficient,
+                         uint8_t low_products[16],
+                         uint8_t high_products[16]);
+
+#if defined(WEBRTC_HAS_NEON) && defined(WEBRTC_ARCH_64_BITS)
+// Implementation optimized for NEON on ARM64, which has 16 byte table lookups.
+void Gf256MultiplyAdd_NEON(uint8_t coefficient,
+                           const uint8_t* src,
+                           size_t length,
+                           uint8_t* dst);
+#endif
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+// Implementation optimized for AVX2.
+void Gf256MultiplyAdd_AVX2(uint8_t coefficient,
+                           const uint8_t* src,
+                           size_t length,
+                           uint8_t* dst);
+#endif
+
+}  // namespace galois_field_internal
+}  // namespace webrtc
+
+#endif  // MODULES_RTP_RTCP_SOURCE_GALOIS_FIELD_H_
@@ -0,0 +1,53 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <immintrin.h>
+
+#include "modules/rtp_rtcp/source/galois_field.h"
+
+namespace webrtc {
+namespace galois_field_internal {
+
+// Multiplies 32 bytes at a time by looking up the products of their low and
+// high nibbles with `coefficient`, and adding (XORing) the two.
+void Gf256MultiplyAdd_AVX2(uint8_t coefficient,
+                           const uint8_t* src,
+                           size_t length,
+                           uint8_t* dst) {
+  uint8_t low_products[16];
+  uint8_t high_products[16];
+  Gf256NibbleProducts(coefficient, low_products, high_products);
+  // The byte shuffle looks up within each 128 bit lane.
+  const __m256i low_table = _mm256_broadcastsi128_si256(
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(low_products)));
+  const __m256i high_table = _mm256_broadcastsi128_si256(
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(high_products)));
+  const __m256i low_mask = _mm256_set1_epi8(0x0f);
+  size_t i = 0;
+  for (; i + 32 <= length; i += 32) {
+    const __m256i s =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+    const __m256i low = _mm256_and_si256(s, low_mask);
+    const __m256i high = _mm256_and_si256(_mm256_srli_epi64(s, 4), low_mask);
+    const __m256i product =
+        _mm256_xor_si256(_mm256_shuffle_epi8(low_table, low),
+                         _mm256_shuffle_epi8(high_table, high));
+    const __m256i d =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i),
+                        _mm256_xor_si256(d, product));
+  }
+  for (; i < length; ++i) {
+    dst[i] ^= Gf256Multiply(coefficient, src[i]);
+  }
+}
+
+}  // namespace galois_field_internal
+}  // namespace webrtc
@@ -0,0 +1,118 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/galois_field.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "rtc_base/random.h"
+#include "system_wrappers/include/cpu_features_wrapper.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::ElementsAreArray;
+
+using MultiplyAddFunction = void (*)(uint8_t coefficient,
+                                     const uint8_t* src,
+                                     size_t length,
+                                     uint8_t* dst);
+
+// Multiplication by shift and add, reducing by the field polynomial.
+uint8_t MultiplySlowly(uint8_t a, uint8_t b) {
+  uint8_t product = 0;
+  for (int bit = 0; bit < 8; ++bit) {
+    if (b & (1 << bit)) {
+      product ^= a;
+    }
+    a = (a << 1) ^ ((a & 0x80) ? 0x1d : 0);
+  }
+  return product;
+}
+
+std::vector<uint8_t> RandomBytes(Random& random, size_t size) {
+  std::vector<uint8_t> bytes(size);
+  for (uint8_t& byte : bytes) {
+    byte = random.Rand<uint8_t>();
+  }
+  return bytes;
+}
+
+// Checks `multiply_add` against byte by byte multiplication, for all lengths
+// that exercise the vector loops and the remainder, and for unaligned buffers.
+void ExpectMultipliesAddsLikeScalarLoop(MultiplyAddFunction multiply_add) {
+  Random random(0x1234);
+  for (int coefficient : {0, 1, 2, 0x1d, 0x80, 0xff}) {
+    for (size_t offset = 0; offset < 4; ++offset) {
+      for (size_t length = 0; length <= 100; ++length) {
+        const std::vector<uint8_t> src = RandomBytes(random, offset + length);
+        std::vector<uint8_t> dst = RandomBytes(random, offset + length + 1);
+        std::vector<uint8_t> expected = dst;
+        for (size_t i = 0; i < length; ++i) {
+          expected[offset + i] ^= MultiplySlowly(coefficient, src[offset + i]);
+        }
+
+        multiply_add(coefficient, src.data() + offset, length,
+                     dst.data() + offset);
+        EXPECT_THAT(dst, ElementsAreArray(expected))
+            << "coefficient " << coefficient << ", offset " << offset
+            << ", length " << length;
+      }
+    }
+  }
+}
+
+TEST(GaloisFieldTest, MultiplyMatchesShiftAndAdd) {
+  for (int a = 0; a < 256; ++a) {
+    for (int b = 0; b < 256; ++b) {
+      ASSERT_EQ(Gf256Multiply(a, b), MultiplySlowly(a, b))
+          << "a " << a << ", b " << b;
+    }
+  }
+}
+
+TEST(GaloisFieldTest, InverseTimesValueIsOne) {
+  for (int a = 1; a < 256; ++a) {
+    EXPECT_EQ(Gf256Multiply(a, Gf256Inverse(a)), 1) << "a " << a;
+  }
+}
+
+TEST(GaloisFieldTest, MultiplyAdd) {
+  ExpectMultipliesAddsLikeScalarLoop(&Gf256MultiplyAdd);
+}
+
+TEST(GaloisFieldTest, MultiplyAdd_C) {
+  ExpectMultipliesAddsLikeScalarLoop(
+      &galois_field_internal::Gf256MultiplyAdd_C);
+}
+
+#if defined(WEBRTC_HAS_NEON) && defined(WEBRTC_ARCH_64_BITS)
+TEST(GaloisFieldTest, MultiplyAdd_NEON) {
+  ExpectMultipliesAddsLikeScalarLoop(
+      &galois_field_internal::Gf256MultiplyAdd_NEON);
+}
+#endif
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+TEST(GaloisFieldTest, MultiplyAdd_AVX2) {
+  if (!GetCPUInfo(kAVX2)) {
+    GTEST_SKIP() << "AVX2 is not supported.";
+  }
+  ExpectMultipliesAddsLikeScalarLoop(
+      &galois_field_internal::Gf256MultiplyAdd_AVX2);
+}
+#endif
+
+}  // namespace
+}  // namespace webrtc
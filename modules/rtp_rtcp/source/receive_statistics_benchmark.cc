@@ -0,0 +1,102 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "modules/rtp_rtcp/include/receive_statistics.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/report_block.h"
+#include "modules/rtp_rtcp/source/rtp_packet_received.h"
+#include "rtc_base/platform_thread.h"
+#include "system_wrappers/include/clock.h"
+
+namespace webrtc {
+namespace {
+
+constexpr uint32_t kNumSsrcs = 500;
+// 50000 packets per second.
+constexpr int64_t kPacketIntervalUs = 20;
+constexpr size_t kPacketSize = 1200;
+constexpr size_t kMaxReportBlocks = 31;
+
+using CreateFunction = std::unique_ptr<ReceiveStatistics> (*)(Clock* clock);
+
+// Receives packets of 500 SSRCs in turn, at 50000 packets per second of
+// simulated time. With `state.range(0)` set, one thread makes RTCP report
+// blocks and another reads the stats of every SSRC meanwhile, as fast as they
+// can. Reports the time to account a packet.
+void BM_OnRtpPacket(benchmark::State& state, CreateFunction create) {
+  const bool with_readers = state.range(0) != 0;
+  SimulatedClock clock(1'000'000);
+  std::unique_ptr<ReceiveStatistics> statistics = create(&clock);
+  std::vector<RtpPacketReceived> packets(kNumSsrcs);
+  for (uint32_t ssrc = 0; ssrc < kNumSsrcs; ++ssrc) {
+    packets[ssrc].SetSsrc(ssrc);
+    packets[ssrc].SetPayloadSize(kPacketSize - kRtpHeaderSize);
+    packets[ssrc].set_payload_type_frequency(90000);
+    // Create the statistician before the readers start.
+    statistics->OnRtpPacket(packets[ssrc]);
+  }
+
+  std::atomic<bool> done(false);
+  std::atomic<int64_t> num_report_blocks(0);
+  std::vector<rtc::PlatformThread> readers;
+  if (with_readers) {
+    readers.push_back(rtc::PlatformThread::SpawnJoinable(
+        [&] {
+          while (!done.load(std::memory_order_relaxed)) {
+            num_report_blocks +=
+                statistics->RtcpReportBlocks(kMaxReportBlocks).size();
+          }
+        },
+        "RtcpReports"));
+    readers.push_back(rtc::PlatformThread::SpawnJoinable(
+        [&] {
+          while (!done.load(std::memory_order_relaxed)) {
+            for (uint32_t ssrc = 0; ssrc < kNumSsrcs; ++ssrc) {
+              benchmark::DoNotOptimize(
+                  statistics->GetStatistician(ssrc)->GetStats());
+            }
+          }
+        },
+        "Stats"));
+  }
+
+  uint32_t ssrc = 0;
+  for (auto _ : state) {
+    RtpPacketReceived& packet = packets[ssrc];
+    packet.SetSequenceNumber(packet.SequenceNumber() + 1);
+    packet.SetTimestamp(packet.Timestamp() + 3000);
+    statistics->OnRtpPacket(packet);
+    clock.AdvanceTimeMicroseconds(kPacketIntervalUs);
+    ssrc = ssrc + 1 < kNumSsrcs ? ssrc + 1 : 0;
+  }
+  done.store(true);
+  readers.clear();
+  state.SetItemsProcessed(state.iterations());
+  state.counters["report_blocks"] = num_report_blocks.load();
+}
+
+BENCHMARK_CAPTURE(BM_OnRtpPacket, WithMutex, &ReceiveStatistics::Create)
+    ->Arg(0)
+    ->Arg(1)
+    ->UseRealTime();
+BENCHMARK_CAPTURE(BM_OnRtpPacket,
+                  Concurrent,
+                  &ReceiveStatistics::CreateConcurrent)
+    ->Arg(0)
+    ->Arg(1)
+    ->UseRealTime();
+
+}  // namespace
+}  // namespace webrtc
@@ -29,6 +29,9 @@ namespace webrtc {
 namespace {
 constexpr TimeDelta kStatisticsTimeout = TimeDelta::Seconds(8);
 constexpr TimeDelta kStatisticsProcessInterval = TimeDelta::Seconds(1);
+// Capacity of the first hash table of ReceiveStatisticsConcurrent, which is
+// doubled whenever it becomes half full.
+constexpr int kInitialLog2TableCapacity = 4;
 
 TimeDelta UnixEpochDelta(Clock& clock) {
   Timestamp now = clock.CurrentTime();
@@ -37,6 +40,57 @@ TimeDelta UnixEpochDelta(Clock& clock) {
                            rtc::kNtpJan1970Millisecs);
 }
 
+void AppendReportBlock(uint32_t ssrc,
+                       const RtcpReportSource& source,
+                       RtcpReportState& state,
+                       std::vector<rtcp::ReportBlock>& report_blocks) {
+  if (source.num_starts != state.num_starts) {
+    // The stream (re)started since the last report.
+    state.num_starts = source.num_starts;
+    state.last_report_seq_max = source.start_seq_max;
+  }
+
+  report_blocks.emplace_back();
+  rtcp::ReportBlock& stats = report_blocks.back();
+  stats.SetMediaSsrc(ssrc);
+  // Calculate fraction lost.
+  int64_t exp_since_last = source.received_seq_max - state.last_report_seq_max;
+  RTC_DCHECK_GE(exp_since_last, 0);
+
+  int32_t lost_since_last =
+      source.cumulative_loss - state.last_report_cumulative_loss;
+  if (exp_since_last > 0 && lost_since_last > 0) {
+    // Scale 0 to 255, where 255 is 100% loss.
+    stats.SetFractionLost(255 * lost_since_last / exp_since_last);
+  }
+
+  int packets_lost = source.cumulative_loss + state.cumulative_loss_rtcp_offset;
+  if (packets_lost < 0) {
+    // Clamp to zero. Work around to accommodate for senders that misbehave with
+    // negative cumulative loss.
+    packets_lost = 0;
+    state.cumulative_loss_rtcp_offset = -source.cumulative_loss;
+  }
+  if (packets_lost > 0x7fffff) {
+    // Packets lost is a 24 bit signed field, and thus should be clamped, as
+    // described in https://datatracker.ietf.org/doc/html/rfc3550#appendix-A.3
+    if (!state.cumulative_loss_is_capped) {
+      state.cumulative_loss_is_capped = true;
+      RTC_LOG(LS_WARNING) << "Cumulative loss reached maximum value for ssrc "
+                          << ssrc;
+    }
+    packets_lost = 0x7fffff;
+  }
+  stats.SetCumulativeLost(packets_lost);
+  stats.SetExtHighestSeqNum(source.received_seq_max);
+  // Note: internal jitter value is in Q4 and needs to be scaled by 1/16.
+  stats.SetJitter(source.jitter_q4 >> 4);
+
+  // Only for report blocks in RTCP SR and RR.
+  state.last_report_cumulative_loss = source.cumulative_loss;
+  state.last_report_seq_max = source.received_seq_max;
+}
+
 }  // namespace
 
 StreamStatistician::~StreamStatistician() {}
@@ -50,15 +104,13 @@ StreamStatisticianImpl::StreamStatisticianImpl(uint32_t ssrc,
       incoming_bitrate_(/*max_window_size=*/kStatisticsProcessInterval),
       max_reordering_threshold_(max_reordering_threshold),
       enable_retransmit_detection_(false),
-      cumulative_loss_is_capped_(false),
       jitter_q4_(0),
       cumulative_loss_(0),
-      cumulative_loss_rtcp_offset_(0),
       last_received_timestamp_(0),
       received_seq_first_(-1),
       received_seq_max_(-1),
-      last_report_cumulative_loss_(0),
-      last_report_seq_max_(-1),
+      num_starts_(0),
+      start_seq_max_(-1),
       last_payload_type_frequency_(0) {}
 
 StreamStatisticianImpl::~StreamStatisticianImpl() = default;
@@ -80,9 +132,10 @@ bool StreamStatisticianImpl::UpdateOutOfOrder(const RtpPacketReceived& packet,
       // `cumulative_loss_`, for the two packets interpreted as a stream reset.
       //
       // Fraction loss for the next report may get a bit off, since we don't
-      // update last_report_seq_max_ and last_report_cumulative_loss_ in a
+      // update the last reported sequence number and cumulative loss in a
       // consistent way.
-      last_report_seq_max_ = sequence_number - 2;
+      ++num_starts_;
+      start_seq_max_ = sequence_number - 2;
       received_seq_max_ = sequence_number - 2;
       return false;
     }
@@ -126,7 +179,8 @@ void StreamStatisticianImpl::UpdateCounters(const RtpPacketReceived& packet) {
 
   if (!ReceivedRtpPacket()) {
     received_seq_first_ = sequence_number;
-    last_report_seq_max_ = sequence_number - 1;
+    ++num_starts_;
+    start_seq_max_ = sequence_number - 1;
     received_seq_max_ = sequence_number - 1;
     receive_counters_.first_packet_time = now;
   } else if (UpdateOutOfOrder(packet, sequence_number, now)) {
@@ -242,45 +296,17 @@ void StreamStatisticianImpl::MaybeAppendReportBlockAndReset(
     // Not active.
     return;
   }
+  AppendReportBlock(ssrc_, GetReportSource(), report_state_, report_blocks);
+}
 
-  report_blocks.emplace_back();
-  rtcp::ReportBlock& stats = report_blocks.back();
-  stats.SetMediaSsrc(ssrc_);
-  // Calculate fraction lost.
-  int64_t exp_since_last = received_seq_max_ - last_report_seq_max_;
-  RTC_DCHECK_GE(exp_since_last, 0);
-
-  int32_t lost_since_last = cumulative_loss_ - last_report_cumulative_loss_;
-  if (exp_since_last > 0 && lost_since_last > 0) {
-    // Scale 0 to 255, where 255 is 100% loss.
-    stats.SetFractionLost(255 * lost_since_last / exp_since_last);
-  }
-
-  int packets_lost = cumulative_loss_ + cumulative_loss_rtcp_offset_;
-  if (packets_lost < 0) {
-    // Clamp to zero. Work around to accommodate for senders that misbehave with
-    // negative cumulative loss.
-    packets_lost = 0;
-    cumulative_loss_rtcp_offset_ = -cumulative_loss_;
-  }
-  if (packets_lost > 0x7fffff) {
-    // Packets lost is a 24 bit signed field, and thus should be clamped, as
-    // described in https://datatracker.ietf.org/doc/html/rfc3550#appendix-A.3
-    if (!cumulative_loss_is_capped_) {
-      cumulative_loss_is_capped_ = true;
-      RTC_LOG(LS_WARNING) << "Cumulative loss reached maximum value for ssrc "
-                          << ssrc_;
-    }
-    packets_lost = 0x7fffff;
-  }
-  stats.SetCumulativeLost(packets_lost);
-  stats.SetExtHighestSeqNum(received_seq_max_);
-  // Note: internal jitter value is in Q4 and needs to be scaled by 1/16.
-  stats.SetJitter(jitter_q4_ >> 4);
-
-  // Only for report blocks in RTCP SR and RR.
-  last_report_cumulative_loss_ = cumulative_loss_;
-  last_report_seq_max_ = received_seq_max_;
+RtcpReportSource StreamStatisticianImpl::GetReportSource() const {
+  RtcpReportSource source;
+  source.cumulative_loss = cumulative_loss_;
+  source.received_seq_max = received_seq_max_;
+  source.jitter_q4 = jitter_q4_;
+  source.num_starts = num_starts_;
+  source.start_seq_max = start_seq_max_;
+  return source;
 }
 
 absl::optional<int> StreamStatisticianImpl::GetFractionLostInPercent() const {
@@ -340,6 +366,11 @@ std::unique_ptr<ReceiveStatistics> ReceiveStatistics::Create(Clock* clock) {
       });
 }
 
+std::unique_ptr<ReceiveStatistics> ReceiveStatistics::CreateConcurrent(
+    Clock* clock) {
+  return std::make_unique<ReceiveStatisticsConcurrent>(clock);
+}
+
 std::unique_ptr<ReceiveStatistics> ReceiveStatistics::CreateThreadCompatible(
     Clock* clock) {
   return std::make_unique<ReceiveStatisticsImpl>(
@@ -424,4 +455,188 @@ std::vector<rtcp::ReportBlock> ReceiveStatisticsImpl::RtcpReportBlocks(
   return result;
 }
 
+StreamStatisticianConcurrent::StreamStatisticianConcurrent(
+    uint32_t ssrc,
+    Clock* clock,
+    int max_reordering_threshold)
+    : ssrc_(ssrc),
+      clock_(clock),
+      impl_(ssrc, clock, max_reordering_threshold) {}
+
+StreamStatisticianConcurrent::~StreamStatisticianConcurrent() = default;
+
+RtpReceiveStats StreamStatisticianConcurrent::GetStats() const {
+  return snapshot_.Load().stats;
+}
+
+absl::optional<int> StreamStatisticianConcurrent::GetFractionLostInPercent()
+    const {
+  return snapshot_.Load().fraction_lost_in_percent;
+}
+
+StreamDataCounters StreamStatisticianConcurrent::GetReceiveStreamDataCounters()
+    const {
+  return snapshot_.Load().counters;
+}
+
+uint32_t StreamStatisticianConcurrent::BitrateReceived() const {
+  // The bitrate depends on the current time, so it can't be published with
+  // the packets. Stats are polled rarely enough for this to not hold up the
+  // packets.
+  MutexLock lock(&update_lock_);
+  return impl_.BitrateReceived();
+}
+
+void StreamStatisticianConcurrent::MaybeAppendReportBlockAndReset(
+    std::vector<rtcp::ReportBlock>& report_blocks) {
+  MutexLock lock(&report_lock_);
+  const Snapshot snapshot = snapshot_.Load();
+  if (!snapshot.last_receive_time.has_value() ||
+      clock_->CurrentTime() - *snapshot.last_receive_time >=
+          kStatisticsTimeout) {
+    // Not active.
+    return;
+  }
+  AppendReportBlock(ssrc_, snapshot.report_source, report_state_,
+                    report_blocks);
+}
+
+void StreamStatisticianConcurrent::SetMaxReorderingThreshold(
+    int max_reordering_threshold) {
+  MutexLock lock(&update_lock_);
+  impl_.SetMaxReorderingThreshold(max_reordering_threshold);
+}
+
+void StreamStatisticianConcurrent::EnableRetransmitDetection(bool enable) {
+  MutexLock lock(&update_lock_);
+  impl_.EnableRetransmitDetection(enable);
+}
+
+void StreamStatisticianConcurrent::UpdateCounters(
+    const RtpPacketReceived& packet) {
+  MutexLock lock(&update_lock_);
+  impl_.UpdateCounters(packet);
+  Snapshot snapshot;
+  snapshot.stats = impl_.GetStats();
+  snapshot.counters = impl_.GetReceiveStreamDataCounters();
+  snapshot.fraction_lost_in_percent = impl_.GetFractionLostInPercent();
+  snapshot.last_receive_time = impl_.last_receive_time();
+  snapshot.report_source = impl_.GetReportSource();
+  snapshot_.Store(snapshot);
+}
+
+ReceiveStatisticsConcurrent::Table::Table(int log2_capacity)
+    : log2_capacity(log2_capacity),
+      entries(new std::atomic<StreamStatisticianConcurrent*>[
+          size_t{1} << log2_capacity]()) {}
+
+StreamStatisticianConcurrent* ReceiveStatisticsConcurrent::Table::Find(
+    uint32_t ssrc) const {
+  const size_t mask = (size_t{1} << log2_capacity) - 1;
+  // Fibonacci hashing, as SSRCs may be chosen in sequence.
+  for (size_t i = (ssrc * 2654435769u) >> (32 - log2_capacity);;
+       i = (i + 1) & mask) {
+    StreamStatisticianConcurrent* statistician =
+        entries[i].load(std::memory_order_acquire);
+    if (statistician == nullptr || statistician->ssrc() == ssrc) {
+      return statistician;
+    }
+  }
+}
+
+void ReceiveStatisticsConcurrent::Table::Insert(
+    StreamStatisticianConcurrent* statistician) {
+  const size_t mask = (size_t{1} << log2_capacity) - 1;
+  size_t i = (statistician->ssrc() * 2654435769u) >> (32 - log2_capacity);
+  while (entries[i].load(std::memory_order_relaxed) != nullptr) {
+    i = (i + 1) & mask;
+  }
+  entries[i].store(statistician, std::memory_order_release);
+}
+
+ReceiveStatisticsConcurrent::ReceiveStatisticsConcurrent(Clock* clock)
+    : clock_(clock),
+      max_reordering_threshold_(kDefaultMaxReorderingThreshold) {
+  tables_.push_back(std::make_unique<Table>(kInitialLog2TableCapacity));
+  table_.store(tables_.back().get(), std::memory_order_release);
+}
+
+ReceiveStatisticsConcurrent::~ReceiveStatisticsConcurrent() = default;
+
+void ReceiveStatisticsConcurrent::OnRtpPacket(const RtpPacketReceived& packet) {
+  StreamStatisticianConcurrent* statistician =
+      table_.load(std::memory_order_acquire)->Find(packet.Ssrc());
+  if (statistician == nullptr) {
+    statistician = GetOrCreateStatistician(packet.Ssrc());
+  }
+  statistician->UpdateCounters(packet);
+}
+
+StreamStatistician* ReceiveStatisticsConcurrent::GetStatistician(
+    uint32_t ssrc) const {
+  return table_.load(std::memory_order_acquire)->Find(ssrc);
+}
+
+StreamStatisticianConcurrent*
+ReceiveStatisticsConcurrent::GetOrCreateStatistician(uint32_t ssrc) {
+  MutexLock lock(&lock_);
+  const Table* table = tables_.back().get();
+  if (StreamStatisticianConcurrent* statistician = table->Find(ssrc)) {
+    // Created by another thread since the lookup.
+    return statistician;
+  }
+  statisticians_.push_back(std::make_unique<StreamStatisticianConcurrent>(
+      ssrc, clock_, max_reordering_threshold_));
+  StreamStatisticianConcurrent* statistician = statisticians_.back().get();
+  if (2 * statisticians_.size() <= (size_t{1} << table->log2_capacity)) {
+    tables_.back()->Insert(statistician);
+    return statistician;
+  }
+  // Too full for short probe sequences; replace by a table twice as large.
+  auto larger_table = std::make_unique<Table>(table->log2_capacity + 1);
+  for (const auto& existing : statisticians_) {
+    larger_table->Insert(existing.get());
+  }
+  table_.store(larger_table.get(), std::memory_order_release);
+  tables_.push_back(std::move(larger_table));
+  return statistician;
+}
+
+void ReceiveStatisticsConcurrent::SetMaxReorderingThreshold(
+    int max_reordering_threshold) {
+  MutexLock lock(&lock_);
+  max_reordering_threshold_ = max_reordering_threshold;
+  for (const auto& statistician : statisticians_) {
+    statistician->SetMaxReorderingThreshold(max_reordering_threshold);
+  }
+}
+
+void ReceiveStatisticsConcurrent::SetMaxReorderingThreshold(
+    uint32_t ssrc,
+    int max_reordering_threshold) {
+  GetOrCreateStatistician(ssrc)->SetMaxReorderingThreshold(
+      max_reordering_threshold);
+}
+
+void ReceiveStatisticsConcurrent::EnableRetransmitDetection(uint32_t ssrc,
+                                                            bool enable) {
+  GetOrCreateStatistician(ssrc)->EnableRetransmitDetection(enable);
+}
+
+std::vector<rtcp::ReportBlock> ReceiveStatisticsConcurrent::RtcpReportBlocks(
+    size_t max_blocks) {
+  MutexLock lock(&lock_);
+  std::vector<rtcp::ReportBlock> result;
+  result.reserve(std::min(max_blocks, statisticians_.size()));
+
+  size_t idx = 0;
+  for (size_t i = 0; i < statisticians_.size() && result.size() < max_blocks;
+       ++i) {
+    idx = (last_returned_idx_ + i + 1) % statisticians_.size();
+    statisticians_[idx]->MaybeAppendReportBlockAndReset(result);
+  }
+  last_returned_idx_ = idx;
+  return result;
+}
+
 }  // namespace webrtc
@@ -12,6 +12,7 @@
 #define MODULES_RTP_RTCP_SOURCE_RECEIVE_STATISTICS_IMPL_H_
 
 #include <algorithm>
+#include <atomic>
 #include <functional>
 #include <memory>
 #include <utility>
@@ -26,6 +27,7 @@
 #include "rtc_base/containers/flat_map.h"
 #include "rtc_base/numerics/sequence_number_unwrapper.h"
 #include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/synchronization/seq_lock.h"
 #include "rtc_base/thread_annotations.h"
 
 namespace webrtc {
@@ -41,6 +43,31 @@ class StreamStatisticianImplInterface : public StreamStatistician {
   virtual void UpdateCounters(const RtpPacketReceived& packet) = 0;
 };
 
+// Receive state of a stream that its RTCP report blocks are made from.
+struct RtcpReportSource {
+  int32_t cumulative_loss = 0;
+  int64_t received_seq_max = -1;
+  uint32_t jitter_q4 = 0;
+  // Number of times the stream started or restarted, and the highest sequence
+  // number before the latest (re)start. The loss of the next report is counted
+  // from there.
+  int num_starts = 0;
+  int64_t start_seq_max = -1;
+};
+
+// State carried from one RTCP report block of a stream to the next.
+struct RtcpReportState {
+  int num_starts = 0;
+  // Counter values when we sent the last report.
+  int32_t last_report_cumulative_loss = 0;
+  int64_t last_report_seq_max = -1;
+  // Offset added to outgoing rtcp reports, to make ensure that the reported
+  // cumulative loss is non-negative. Reports with negative values confuse some
+  // senders, in particular, our own loss-based bandwidth estimator.
+  int32_t cumulative_loss_rtcp_offset = 0;
+  bool cumulative_loss_is_capped = false;
+};
+
 // Thread-compatible implementation of StreamStatisticianImplInterface.
 class StreamStatisticianImpl : public StreamStatisticianImplInterface {
  public:
@@ -63,6 +90,13 @@ class StreamStatisticianImpl : public StreamStatisticianImplInterface {
   // Updates StreamStatistician for incoming packets.
   void UpdateCounters(const RtpPacketReceived& packet) override;
 
+  // For statisticians that make the report blocks apart from the packet
+  // accounting.
+  RtcpReportSource GetReportSource() const;
+  absl::optional<Timestamp> last_receive_time() const {
+    return last_receive_time_;
+  }
+
  private:
   bool IsRetransmitOfOldPacket(const RtpPacketReceived& packet,
                                Timestamp now) const;
@@ -84,17 +118,12 @@ class StreamStatisticianImpl : public StreamStatisticianImplInterface {
   // In number of packets or sequence numbers.
   int max_reordering_threshold_;
   bool enable_retransmit_detection_;
-  bool cumulative_loss_is_capped_;
 
   // Stats on received RTP packets.
   uint32_t jitter_q4_;
   // Cumulative loss according to RFC 3550, which may be negative (and often is,
   // if packets are reordered and there are non-RTX retransmissions).
   int32_t cumulative_loss_;
-  // Offset added to outgoing rtcp reports, to make ensure that the reported
-  // cumulative loss is non-negative. Reports with negative values confuse some
-  // senders, in particular, our own loss-based bandwidth estimator.
-  int32_t cumulative_loss_rtcp_offset_;
 
   absl::optional<Timestamp> last_receive_time_;
   uint32_t last_received_timestamp_;
@@ -104,13 +133,13 @@ class StreamStatisticianImpl : public StreamStatisticianImplInterface {
   // Assume that the other side restarted when there are two sequential packets
   // with large jump from received_seq_max_.
   absl::optional<uint16_t> received_seq_out_of_order_;
+  int num_starts_;
+  int64_t start_seq_max_;
 
   // Current counter values.
   StreamDataCounters receive_counters_;
 
-  // Counter values when we sent the last report.
-  int32_t last_report_cumulative_loss_;
-  int64_t last_report_seq_max_;
+  RtcpReportState report_state_;
 
   // The sample frequency of the last received packet.
   int last_payload_type_frequency_;
@@ -164,6 +193,53 @@ class StreamStatisticianLocked : public StreamStatisticianImplInterface {
   StreamStatisticianImpl impl_ RTC_GUARDED_BY(&stream_lock_);
 };
 
+// Thread-safe implementation of StreamStatisticianImplInterface where packet
+// accounting never waits for report generation or for stats to be read.
+// Packets are accounted in a StreamStatisticianImpl under a lock that only
+// the packet path and configuration take. The result is published after each
+// packet through a sequence lock, from which reports and stats are made.
+class StreamStatisticianConcurrent : public StreamStatisticianImplInterface {
+ public:
+  StreamStatisticianConcurrent(uint32_t ssrc,
+                               Clock* clock,
+                               int max_reordering_threshold);
+  ~StreamStatisticianConcurrent() override;
+
+  uint32_t ssrc() const { return ssrc_; }
+
+  // Implements StreamStatistician
+  RtpReceiveStats GetStats() const override;
+  absl::optional<int> GetFractionLostInPercent() const override;
+  StreamDataCounters GetReceiveStreamDataCounters() const override;
+  uint32_t BitrateReceived() const override;
+
+  // Implements StreamStatisticianImplInterface
+  void MaybeAppendReportBlockAndReset(
+      std::vector<rtcp::ReportBlock>& report_blocks) override;
+  void SetMaxReorderingThreshold(int max_reordering_threshold) override;
+  void EnableRetransmitDetection(bool enable) override;
+  void UpdateCounters(const RtpPacketReceived& packet) override;
+
+ private:
+  struct Snapshot {
+    RtpReceiveStats stats;
+    StreamDataCounters counters;
+    absl::optional<int> fraction_lost_in_percent;
+    absl::optional<Timestamp> last_receive_time;
+    RtcpReportSource report_source;
+  };
+
+  const uint32_t ssrc_;
+  Clock* const clock_;
+
+  mutable Mutex update_lock_;
+  StreamStatisticianImpl impl_ RTC_GUARDED_BY(update_lock_);
+  SeqLock<Snapshot> snapshot_;
+
+  Mutex report_lock_;
+  RtcpReportState report_state_ RTC_GUARDED_BY(report_lock_);
+};
+
 // Thread-compatible implementation.
 class ReceiveStatisticsImpl : public ReceiveStatistics {
  public:
@@ -248,5 +324,56 @@ class ReceiveStatisticsLocked : public ReceiveStatistics {
   ReceiveStatisticsImpl impl_ RTC_GUARDED_BY(&receive_statistics_lock_);
 };
 
+// Thread-safe implementation where the packets of known streams are accounted
+// without taking a lock shared with other streams or with report generation.
+// The statisticians are found through a hash table that is read without
+// locking, and replaced by a larger copy as it fills up.
+class ReceiveStatisticsConcurrent : public ReceiveStatistics {
+ public:
+  explicit ReceiveStatisticsConcurrent(Clock* clock);
+  ~ReceiveStatisticsConcurrent() override;
+
+  // Implements ReceiveStatisticsProvider.
+  std::vector<rtcp::ReportBlock> RtcpReportBlocks(size_t max_blocks) override;
+
+  // Implements RtpPacketSinkInterface
+  void OnRtpPacket(const RtpPacketReceived& packet) override;
+
+  // Implements ReceiveStatistics.
+  StreamStatistician* GetStatistician(uint32_t ssrc) const override;
+  void SetMaxReorderingThreshold(int max_reordering_threshold) override;
+  void SetMaxReorderingThreshold(uint32_t ssrc,
+                                 int max_reordering_threshold) override;
+  void EnableRetransmitDetection(uint32_t ssrc, bool enable) override;
+
+ private:
+  // Open addressing hash table with linear probing. Entries are only added.
+  struct Table {
+    explicit Table(int log2_capacity);
+
+    StreamStatisticianConcurrent* Find(uint32_t ssrc) const;
+    // Must not be called concurrently with itself.
+    void Insert(StreamStatisticianConcurrent* statistician);
+
+    const int log2_capacity;
+    std::unique_ptr<std::atomic<StreamStatisticianConcurrent*>[]> entries;
+  };
+
+  StreamStatisticianConcurrent* GetOrCreateStatistician(uint32_t ssrc);
+
+  Clock* const clock_;
+  std::atomic<const Table*> table_;
+
+  Mutex lock_;
+  // All tables, the last of which is `table_`. The replaced ones are kept, as
+  // lookups may still be reading them.
+  std::vector<std::unique_ptr<Table>> tables_ RTC_GUARDED_BY(lock_);
+  std::vector<std::unique_ptr<StreamStatisticianConcurrent>> statisticians_
+      RTC_GUARDED_BY(lock_);
+  // The index within `statisticians_` that was last returned.
+  size_t last_returned_idx_ RTC_GUARDED_BY(lock_) = 0;
+  int max_reordering_threshold_ RTC_GUARDED_BY(lock_);
+};
+
 }  // namespace webrtc
 #endif  // MODULES_RTP_RTCP_SOURCE_RECEIVE_STATISTICS_IMPL_H_
@@ -10,12 +10,15 @@
 
 #include "modules/rtp_rtcp/include/receive_statistics.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cstdint>
 #include <memory>
 #include <vector>
 
 #include "api/units/time_delta.h"
 #include "modules/rtp_rtcp/source/rtp_packet_received.h"
+#include "rtc_base/platform_thread.h"
 #include "rtc_base/random.h"
 #include "system_wrappers/include/clock.h"
 #include "test/gmock.h"
@@ -90,13 +93,26 @@ uint32_t GetJitter(const ReceiveStatistics& stats) {
   return stats.GetStatistician(kSsrc1)->GetStats().jitter;
 }
 
-class ReceiveStatisticsTest : public ::testing::TestWithParam<bool> {
+enum class Implementation { kWithMutex, kWithoutMutex, kConcurrent };
+
+std::unique_ptr<ReceiveStatistics> CreateReceiveStatistics(
+    Implementation implementation,
+    Clock* clock) {
+  switch (implementation) {
+    case Implementation::kWithMutex:
+      return ReceiveStatistics::Create(clock);
+    case Implementation::kWithoutMutex:
+      return ReceiveStatistics::CreateThreadCompatible(clock);
+    case Implementation::kConcurrent:
+      return ReceiveStatistics::CreateConcurrent(clock);
+  }
+}
+
+class ReceiveStatisticsTest : public ::testing::TestWithParam<Implementation> {
  public:
   ReceiveStatisticsTest()
       : clock_(0),
-        receive_statistics_(
-            GetParam() ? ReceiveStatistics::Create(&clock_)
-                       : ReceiveStatistics::CreateThreadCompatible(&clock_)) {
+        receive_statistics_(CreateReceiveStatistics(GetParam(), &clock_)) {
     packet1_ = CreateRtpPacket(kSsrc1, kPacketSize1);
     packet2_ = CreateRtpPacket(kSsrc2, kPacketSize2);
   }
@@ -108,12 +124,22 @@ class ReceiveStatisticsTest : public ::testing::TestWithParam<bool> {
   RtpPacketReceived packet2_;
 };
 
-INSTANTIATE_TEST_SUITE_P(All,
-                         ReceiveStatisticsTest,
-                         ::testing::Bool(),
-                         [](::testing::TestParamInfo<bool> info) {
-                           return info.param ? "WithMutex" : "WithoutMutex";
-                         });
+INSTANTIATE_TEST_SUITE_P(
+    All,
+    ReceiveStatisticsTest,
+    ::testing::Values(Implementation::kWithMutex,
+                      Implementation::kWithoutMutex,
+                      Implementation::kConcurrent),
+    [](::testing::TestParamInfo<Implementation> info) {
+      switch (info.param) {
+        case Implementation::kWithMutex:
+          return "WithMutex";
+        case Implementation::kWithoutMutex:
+          return "WithoutMutex";
+        case Implementation::kConcurrent:
+          return "Concurrent";
+      }
+    });
 
 TEST_P(ReceiveStatisticsTest, TwoIncomingSsrcs) {
   receive_statistics_->OnRtpPacket(packet1_);
@@ -631,6 +657,80 @@ TEST_P(ReceiveStatisticsTest, SimpleJitterComputation) {
             statistician->GetStats().interarrival_jitter);
 }
 
+TEST_P(ReceiveStatisticsTest, ManySsrcs) {
+  constexpr uint32_t kNumSsrcs = 500;
+  for (int i = 0; i < 3; ++i) {
+    for (uint32_t ssrc = 1; ssrc <= kNumSsrcs; ++ssrc) {
+      RtpPacketReceived packet = CreateRtpPacket(ssrc, kPacketSize1);
+      // Lose the second packet of every stream.
+      packet.SetSequenceNumber(2 * i);
+      receive_statistics_->OnRtpPacket(packet);
+    }
+  }
+
+  EXPECT_EQ(receive_statistics_->GetStatistician(kNumSsrcs + 1), nullptr);
+  for (uint32_t ssrc = 1; ssrc <= kNumSsrcs; ++ssrc) {
+    StreamStatistician* statistician =
+        receive_statistics_->GetStatistician(ssrc);
+    ASSERT_NE(statistician, nullptr);
+    EXPECT_EQ(statistician->GetStats().packet_counter.packets, 3u);
+    EXPECT_EQ(statistician->GetStats().packets_lost, 2);
+  }
+  std::vector<uint32_t> reported_ssrcs;
+  for (uint32_t i = 0; i < kNumSsrcs; i += 31) {
+    for (const rtcp::ReportBlock& report_block :
+         receive_statistics_->RtcpReportBlocks(31)) {
+      EXPECT_EQ(report_block.cumulative_lost(), 2);
+      reported_ssrcs.push_back(report_block.source_ssrc());
+    }
+  }
+  EXPECT_THAT(reported_ssrcs, SizeIs(kNumSsrcs + 31 - kNumSsrcs % 31));
+  std::sort(reported_ssrcs.begin(), reported_ssrcs.end());
+  reported_ssrcs.erase(
+      std::unique(reported_ssrcs.begin(), reported_ssrcs.end()),
+      reported_ssrcs.end());
+  EXPECT_THAT(reported_ssrcs, SizeIs(kNumSsrcs));
+}
+
+TEST(ReceiveStatisticsConcurrentTest, AccountsPacketsWhileMakingReports) {
+  constexpr uint32_t kNumSsrcs = 100;
+  constexpr int kNumPacketsPerSsrc = 1000;
+  SimulatedClock clock(0);
+  std::unique_ptr<ReceiveStatistics> statistics =
+      ReceiveStatistics::CreateConcurrent(&clock);
+  std::atomic<bool> done(false);
+  auto receiver = rtc::PlatformThread::SpawnJoinable(
+      [&] {
+        RtpPacketReceived packet = CreateRtpPacket(kSsrc1, kPacketSize1);
+        for (int i = 0; i < kNumPacketsPerSsrc; ++i) {
+          for (uint32_t ssrc = 1; ssrc <= kNumSsrcs; ++ssrc) {
+            packet.SetSsrc(ssrc);
+            // Lose every tenth packet.
+            packet.SetSequenceNumber(i + i / 9);
+            statistics->OnRtpPacket(packet);
+          }
+        }
+        done.store(true);
+      },
+      "Receiver");
+
+  // Report blocks are consistent with some point in the packet sequence.
+  while (!done.load()) {
+    for (const rtcp::ReportBlock& report_block :
+         statistics->RtcpReportBlocks(31)) {
+      EXPECT_LE(report_block.cumulative_lost(),
+                static_cast<int>(report_block.extended_high_seq_num() / 10));
+    }
+  }
+  receiver.Finalize();
+
+  for (uint32_t ssrc = 1; ssrc <= kNumSsrcs; ++ssrc) {
+    RtpReceiveStats stats = statistics->GetStatistician(ssrc)->GetStats();
+    EXPECT_EQ(stats.packet_counter.packets, size_t{kNumPacketsPerSsrc});
+    EXPECT_EQ(stats.packets_lost, (kNumPacketsPerSsrc - 1) / 9);
+  }
+}
+
 TEST(ReviseJitterTest, AllPacketsHaveSamePayloadTypeFrequency) {
   SimulatedClock clock(0);
   std::unique_ptr<ReceiveStatistics> statistics =
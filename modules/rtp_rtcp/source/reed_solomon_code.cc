@@ -0,0 +1,161 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/reed_solomon_code.h"
+
+#include <string.h>
+
+#include <utility>
+#include <vector>
+
+#include "modules/rtp_rtcp/source/galois_field.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+namespace {
+
+uint8_t Coefficient(int num_data, int parity_index, int data_index) {
+  // Field addition is XOR, and x_j = num_data + j is never equal to y_i = i.
+  return Gf256Inverse(static_cast<uint8_t>((num_data + parity_index) ^
+                                           data_index));
+}
+
+// Inverts the `size` x `size` row-major `matrix` in place, by Gauss-Jordan
+// elimination. Returns false if it is singular.
+bool Invert(std::vector<uint8_t>& matrix, int size) {
+  std::vector<uint8_t> inverse(size * size, 0);
+  for (int i = 0; i < size; ++i) {
+    inverse[i * size + i] = 1;
+  }
+  for (int column = 0; column < size; ++column) {
+    int pivot = column;
+    while (pivot < size && matrix[pivot * size + column] == 0) {
+      ++pivot;
+    }
+    if (pivot == size) {
+      return false;
+    }
+    if (pivot != column) {
+      for (int k = 0; k < size; ++k) {
+        std::swap(matrix[pivot * size + k], matrix[column * size + k]);
+        std::swap(inverse[pivot * size + k], inverse[column * size + k]);
+      }
+    }
+    const uint8_t scale = Gf256Inverse(matrix[column * size + column]);
+    for (int k = 0; k < size; ++k) {
+      matrix[column * size + k] =
+          Gf256Multiply(matrix[column * size + k], scale);
+      inverse[column * size + k] =
+          Gf256Multiply(inverse[column * size + k], scale);
+    }
+    for (int row = 0; row < size; ++row) {
+      const uint8_t factor = matrix[row * size + column];
+      if (row == column || factor == 0) {
+        continue;
+      }
+      for (int k = 0; k < size; ++k) {
+        matrix[row * size + k] ^=
+            Gf256Multiply(factor, matrix[column * size + k]);
+        inverse[row * size + k] ^=
+            Gf256Multiply(factor, inverse[column * size + k]);
+      }
+    }
+  }
+  matrix = std::move(inverse);
+  return true;
+}
+
+}  // namespace
+
+void ReedSolomonCode::Encode(rtc::ArrayView<const uint8_t* const> data,
+                             size_t length,
+                             rtc::ArrayView<uint8_t* const> parity) {
+  const int num_data = data.size();
+  RTC_DCHECK_GT(num_data, 0);
+  RTC_DCHECK_LE(num_data + parity.size(), kMaxShards);
+  for (size_t j = 0; j < parity.size(); ++j) {
+    memset(parity[j], 0, length);
+    for (int i = 0; i < num_data; ++i) {
+      Gf256MultiplyAdd(Coefficient(num_data, j, i), data[i], length,
+                       parity[j]);
+    }
+  }
+}
+
+bool ReedSolomonCode::Recover(rtc::ArrayView<uint8_t* const> data,
+                              rtc::ArrayView<const int> missing,
+                              rtc::ArrayView<const uint8_t* const> parity,
+                              size_t length) {
+  const int num_data = data.size();
+  const int num_missing = missing.size();
+  RTC_DCHECK_LE(num_data + parity.size(), kMaxShards);
+  if (num_missing == 0) {
+    return true;
+  }
+
+  // Use the first received parity shards, one per missing data shard.
+  std::vector<int> parity_indices;
+  for (size_t j = 0; j < parity.size(); ++j) {
+    if (static_cast<int>(parity_indices.size()) == num_missing) {
+      break;
+    }
+    if (parity[j] != nullptr) {
+      parity_indices.push_back(j);
+    }
+  }
+  if (static_cast<int>(parity_indices.size()) < num_missing) {
+    return false;
+  }
+
+  std::vector<bool> is_missing(num_data, false);
+  for (int index : missing) {
+    RTC_DCHECK_GE(index, 0);
+    RTC_DCHECK_LT(index, num_data);
+    is_missing[index] = true;
+  }
+
+  // Subtracting the received data shards from each parity shard leaves the
+  // sum of only the missing data shards, times their coefficients.
+  std::vector<uint8_t> syndromes(num_missing * length);
+  for (int r = 0; r < num_missing; ++r) {
+    uint8_t* syndrome = &syndromes[r * length];
+    memcpy(syndrome, parity[parity_indices[r]], length);
+    for (int i = 0; i < num_data; ++i) {
+      if (!is_missing[i]) {
+        Gf256MultiplyAdd(Coefficient(num_data, parity_indices[r], i), data[i],
+                         length, syndrome);
+      }
+    }
+  }
+
+  // Solve for the missing data shards with the inverse of the coefficients.
+  std::vector<uint8_t> matrix(num_missing * num_missing);
+  for (int r = 0; r < num_missing; ++r) {
+    for (int c = 0; c < num_missing; ++c) {
+      matrix[r * num_missing + c] =
+          Coefficient(num_data, parity_indices[r], missing[c]);
+    }
+  }
+  if (!Invert(matrix, num_missing)) {
+    RTC_DCHECK_NOTREACHED() << "Square Cauchy matrices are invertible.";
+    return false;
+  }
+  for (int c = 0; c < num_missing; ++c) {
+    uint8_t* shard = data[missing[c]];
+    memset(shard, 0, length);
+    for (int r = 0; r < num_missing; ++r) {
+      Gf256MultiplyAdd(matrix[c * num_missing + r], &syndromes[r * length],
+                       length, shard);
+    }
+  }
+  return true;
+}
+
+}  // namespace webrtc
@@ -0,0 +1,53 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_RTP_RTCP_SOURCE_REED_SOLOMON_CODE_H_
+#define MODULES_RTP_RTCP_SOURCE_REED_SOLOMON_CODE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "api/array_view.h"
+
+namespace webrtc {
+
+// Systematic Reed-Solomon erasure code over GF(2^8). `num_data` data shards
+// are protected by `num_parity` parity shards of the same length, and any
+// `num_parity` lost data shards can be recovered from the others and as many
+// received parity shards, regardless of which were lost.
+//
+// Parity shard j is the sum of the data shards i multiplied by 1 / (x_j + y_i)
+// with x_j = num_data + j and y_i = i. Since all x_j and y_i are distinct
+// field elements, this is a Cauchy matrix, whose square submatrices are all
+// invertible.
+class ReedSolomonCode {
+ public:
+  // The elements of the Cauchy matrix must be distinct field elements.
+  static constexpr int kMaxShards = 256;
+
+  // Computes the parity shards of `data`. All shards are `length` bytes.
+  static void Encode(rtc::ArrayView<const uint8_t* const> data,
+                     size_t length,
+                     rtc::ArrayView<uint8_t* const> parity);
+
+  // Recovers the data shards whose indices are in `missing` into their
+  // buffers in `data`, from the other data shards and the parity shards.
+  // Parity shards that were lost are null. Returns false, leaving the missing
+  // shards unspecified, if fewer parity shards than missing data shards were
+  // received.
+  static bool Recover(rtc::ArrayView<uint8_t* const> data,
+                      rtc::ArrayView<const int> missing,
+                      rtc::ArrayView<const uint8_t* const> parity,
+                      size_t length);
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_RTP_RTCP_SOURCE_REED_SOLOMON_CODE_H_
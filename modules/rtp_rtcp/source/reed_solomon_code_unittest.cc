@@ -0,0 +1,140 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/reed_solomon_code.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "rtc_base/random.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::ElementsAreArray;
+
+constexpr size_t kShardLength = 50;
+
+class Shards {
+ public:
+  Shards(Random& random, int num_data, int num_parity)
+      : data_(num_data, std::vector<uint8_t>(kShardLength)),
+        parity_(num_parity, std::vector<uint8_t>(kShardLength)) {
+    for (std::vector<uint8_t>& shard : data_) {
+      for (uint8_t& byte : shard) {
+        byte = random.Rand<uint8_t>();
+      }
+    }
+    std::vector<const uint8_t*> data;
+    for (const std::vector<uint8_t>& shard : data_) {
+      data.push_back(shard.data());
+    }
+    std::vector<uint8_t*> parity;
+    for (std::vector<uint8_t>& shard : parity_) {
+      parity.push_back(shard.data());
+    }
+    ReedSolomonCode::Encode(data, kShardLength, parity);
+  }
+
+  // Erases the data shards `missing` and the parity shards `lost_parity`,
+  // and checks that the data shards are restored if they are recovered.
+  bool Recover(const std::vector<int>& missing,
+               const std::vector<int>& lost_parity) {
+    std::vector<std::vector<uint8_t>> received = data_;
+    std::vector<uint8_t*> data;
+    for (std::vector<uint8_t>& shard : received) {
+      data.push_back(shard.data());
+    }
+    for (int index : missing) {
+      std::fill(received[index].begin(), received[index].end(), 0xaa);
+    }
+    std::vector<const uint8_t*> parity;
+    for (const std::vector<uint8_t>& shard : parity_) {
+      parity.push_back(shard.data());
+    }
+    for (int index : lost_parity) {
+      parity[index] = nullptr;
+    }
+    if (!ReedSolomonCode::Recover(data, missing, parity, kShardLength)) {
+      return false;
+    }
+    for (size_t i = 0; i < data_.size(); ++i) {
+      EXPECT_THAT(received[i], ElementsAreArray(data_[i])) << "shard " << i;
+    }
+    return true;
+  }
+
+ private:
+  std::vector<std::vector<uint8_t>> data_;
+  std::vector<std::vector<uint8_t>> parity_;
+};
+
+TEST(ReedSolomonCodeTest, RecoversWithoutLoss) {
+  Random random(0x1234);
+  Shards shards(random, 10, 4);
+  EXPECT_TRUE(shards.Recover({}, {}));
+}
+
+TEST(ReedSolomonCodeTest, RecoversAsManyDataShardsAsParityShards) {
+  Random random(0x1234);
+  Shards shards(random, 10, 4);
+  EXPECT_TRUE(shards.Recover({3}, {}));
+  EXPECT_TRUE(shards.Recover({0, 1, 2, 3}, {}));
+  EXPECT_TRUE(shards.Recover({6, 7, 8, 9}, {}));
+  EXPECT_TRUE(shards.Recover({0, 4, 5, 9}, {}));
+}
+
+TEST(ReedSolomonCodeTest, RecoversWithAnyParityShards) {
+  Random random(0x1234);
+  Shards shards(random, 10, 4);
+  EXPECT_TRUE(shards.Recover({2, 3}, {0, 1}));
+  EXPECT_TRUE(shards.Recover({2, 3}, {1, 2}));
+  EXPECT_TRUE(shards.Recover({2, 3}, {0, 3}));
+  EXPECT_TRUE(shards.Recover({5}, {0, 1, 2}));
+}
+
+TEST(ReedSolomonCodeTest, DoesNotRecoverMoreDataShardsThanParityShards) {
+  Random random(0x1234);
+  Shards shards(random, 10, 4);
+  EXPECT_FALSE(shards.Recover({0, 1, 2, 3, 4}, {}));
+  EXPECT_FALSE(shards.Recover({0, 1, 2}, {3, 2}));
+}
+
+TEST(ReedSolomonCodeTest, RecoversRandomLossesOfLargestCode) {
+  Random random(0x1234);
+  constexpr int kNumData = 200;
+  constexpr int kNumParity = ReedSolomonCode::kMaxShards - kNumData;
+  Shards shards(random, kNumData, kNumParity);
+  for (int trial = 0; trial < 5; ++trial) {
+    // Lose a random set of data shards, and as many parity shards as could
+    // be spared.
+    std::vector<bool> lost(kNumData, false);
+    std::vector<int> missing;
+    while (static_cast<int>(missing.size()) < kNumParity / 2) {
+      int index = random.Rand(kNumData - 1);
+      if (!lost[index]) {
+        lost[index] = true;
+        missing.push_back(index);
+      }
+    }
+    std::vector<int> lost_parity;
+    for (int j = 0; j < kNumParity - kNumParity / 2; ++j) {
+      lost_parity.push_back(2 * j);
+    }
+    EXPECT_TRUE(shards.Recover(missing, lost_parity));
+  }
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -0,0 +1,131 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "api/rtp_parameters.h"
+#include "benchmark/benchmark.h"
+#include "modules/include/module_fec_types.h"
+#include "modules/rtp_rtcp/include/flexfec_receiver.h"
+#include "modules/rtp_rtcp/include/flexfec_sender.h"
+#include "modules/rtp_rtcp/include/recovered_packet_receiver.h"
+#include "modules/rtp_rtcp/include/reed_solomon_fec_receiver.h"
+#include "modules/rtp_rtcp/include/reed_solomon_fec_sender.h"
+#include "modules/rtp_rtcp/source/rtp_packet_received.h"
+#include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
+#include "rtc_base/random.h"
+#include "system_wrappers/include/clock.h"
+
+namespace webrtc {
+namespace {
+
+constexpr int kFecPayloadType = 123;
+constexpr int kMediaPayloadType = 96;
+constexpr uint32_t kMediaSsrc = 0x1234;
+constexpr uint32_t kFecSsrc = 0x5678;
+constexpr size_t kPacketSize = 1200;
+constexpr int kNumMediaPackets = 12;
+// 50% protection, i.e. 6 FEC packets for the 12 media packets of each frame.
+constexpr int kProtectionFactor = 128;
+
+class NullRecoveredPacketReceiver : public RecoveredPacketReceiver {
+ public:
+  void OnRecoveredPacket(const RtpPacketReceived& packet) override {}
+};
+
+std::vector<RtpPacketToSend> CreateFrame() {
+  Random random(0x5eed);
+  std::vector<RtpPacketToSend> packets;
+  for (int i = 0; i < kNumMediaPackets; ++i) {
+    RtpPacketToSend& packet = packets.emplace_back(nullptr);
+    packet.SetPayloadType(kMediaPayloadType);
+    packet.SetSsrc(kMediaSsrc);
+    packet.SetMarker(i == kNumMediaPackets - 1);
+    uint8_t* payload = packet.AllocatePayload(kPacketSize - kRtpHeaderSize);
+    for (size_t j = 0; j < kPacketSize - kRtpHeaderSize; ++j) {
+      payload[j] = random.Rand<uint8_t>();
+    }
+  }
+  return packets;
+}
+
+// Sends frames of 12 media packets of 1200 bytes, each protected by 6 FEC
+// packets, and loses a burst of `state.range(0)` of the 18 packets of every
+// frame. Reports the share of the lost media packets that are recovered, and
+// the time to protect and recover a frame.
+template <typename FecSender, typename FecReceiver>
+void ProtectAndRecover(benchmark::State& state, FecMaskType mask_type) {
+  const int burst_length = state.range(0);
+  SimulatedClock clock(1);
+  Random random(0x1234);
+  FecSender sender(kFecPayloadType, kFecSsrc, kMediaSsrc, /*mid=*/"",
+                   /*rtp_header_extensions=*/{},
+                   /*extension_sizes=*/{}, /*rtp_state=*/nullptr, &clock);
+  FecProtectionParams params;
+  params.fec_rate = kProtectionFactor;
+  params.max_fec_frames = 1;
+  params.fec_mask_type = mask_type;
+  sender.SetProtectionParameters(params, params);
+  NullRecoveredPacketReceiver recovered_packet_receiver;
+  FecReceiver receiver(&clock, kFecSsrc, kMediaSsrc,
+                       &recovered_packet_receiver);
+
+  std::vector<RtpPacketToSend> frame = CreateFrame();
+  uint16_t seq_num = 0;
+  int num_lost_media_packets = 0;
+  std::vector<RtpPacketReceived> received_packets;
+  for (auto _ : state) {
+    received_packets.clear();
+    for (RtpPacketToSend& packet : frame) {
+      packet.SetSequenceNumber(seq_num++);
+      sender.AddPacketAndGenerateFec(packet);
+      received_packets.emplace_back().Parse(packet.Buffer());
+    }
+    for (const auto& fec_packet : sender.GetFecPackets()) {
+      received_packets.emplace_back().Parse(fec_packet->Buffer());
+    }
+
+    const int burst_start = random.Rand(
+        0, static_cast<int>(received_packets.size()) - burst_length);
+    for (int i = 0; i < static_cast<int>(received_packets.size()); ++i) {
+      if (i >= burst_start && i < burst_start + burst_length) {
+        num_lost_media_packets += i < kNumMediaPackets ? 1 : 0;
+        continue;
+      }
+      receiver.OnRtpPacket(received_packets[i]);
+    }
+  }
+  state.SetBytesProcessed(state.iterations() * kNumMediaPackets * kPacketSize);
+  state.counters["recovered"] =
+      num_lost_media_packets > 0
+          ? static_cast<double>(
+                receiver.GetPacketCounter().num_recovered_packets) /
+                num_lost_media_packets
+          : 1.0;
+}
+
+void BM_Flexfec(benchmark::State& state, FecMaskType mask_type) {
+  ProtectAndRecover<FlexfecSender, FlexfecReceiver>(state, mask_type);
+}
+
+void BM_ReedSolomonFec(benchmark::State& state) {
+  ProtectAndRecover<ReedSolomonFecSender, ReedSolomonFecReceiver>(
+      state, kFecMaskBursty);
+}
+
+BENCHMARK_CAPTURE(BM_Flexfec, Random, kFecMaskRandom)->Arg(1)->Arg(3)->Arg(6);
+BENCHMARK_CAPTURE(BM_Flexfec, Bursty, kFecMaskBursty)->Arg(1)->Arg(3)->Arg(6);
+BENCHMARK(BM_ReedSolomonFec)->Arg(1)->Arg(3)->Arg(6);
+
+}  // namespace
+}  // namespace webrtc
@@ -0,0 +1,82 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/reed_solomon_fec_packet.h"
+
+#include <string.h>
+
+#include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
+#include "modules/rtp_rtcp/source/byte_io.h"
+#include "modules/rtp_rtcp/source/reed_solomon_code.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+absl::optional<ReedSolomonFecHeader> ReedSolomonFecHeader::Parse(
+    rtc::ArrayView<const uint8_t> payload) {
+  if (payload.size() < kSize) {
+    return absl::nullopt;
+  }
+  ReedSolomonFecHeader header;
+  header.seq_num_base = ByteReader<uint16_t>::ReadBigEndian(&payload[0]);
+  header.num_media_packets = payload[2];
+  header.num_fec_packets = payload[3];
+  header.fec_index = payload[4];
+  header.shard_length = ByteReader<uint16_t>::ReadBigEndian(&payload[6]);
+  if (header.num_media_packets == 0 || header.num_fec_packets == 0 ||
+      header.fec_index >= header.num_fec_packets ||
+      header.num_media_packets + header.num_fec_packets >
+          ReedSolomonCode::kMaxShards ||
+      header.shard_length < kRtpHeaderSize ||
+      payload.size() != kSize + header.shard_length) {
+    return absl::nullopt;
+  }
+  return header;
+}
+
+void ReedSolomonFecHeader::Write(uint8_t* payload) const {
+  ByteWriter<uint16_t>::WriteBigEndian(&payload[0], seq_num_base);
+  payload[2] = num_media_packets;
+  payload[3] = num_fec_packets;
+  payload[4] = fec_index;
+  payload[5] = 0;
+  ByteWriter<uint16_t>::WriteBigEndian(&payload[6], shard_length);
+}
+
+void MediaPacketToShard(rtc::ArrayView<const uint8_t> packet,
+                        rtc::ArrayView<uint8_t> shard) {
+  RTC_DCHECK_GE(packet.size(), kRtpHeaderSize);
+  RTC_DCHECK_LE(packet.size(), shard.size());
+  memcpy(shard.data(), packet.data(), packet.size());
+  memset(shard.data() + packet.size(), 0, shard.size() - packet.size());
+  ByteWriter<uint16_t>::WriteBigEndian(&shard[2],
+                                       packet.size() - kRtpHeaderSize);
+  ByteWriter<uint32_t>::WriteBigEndian(&shard[8], 0);
+}
+
+rtc::CopyOnWriteBuffer ShardToMediaPacket(rtc::ArrayView<const uint8_t> shard,
+                                          uint16_t seq_num,
+                                          uint32_t ssrc) {
+  if (shard.size() < kRtpHeaderSize) {
+    return rtc::CopyOnWriteBuffer();
+  }
+  const size_t size =
+      kRtpHeaderSize + ByteReader<uint16_t>::ReadBigEndian(&shard[2]);
+  if (size > shard.size()) {
+    return rtc::CopyOnWriteBuffer();
+  }
+  rtc::CopyOnWriteBuffer packet(shard.data(), size);
+  uint8_t* data = packet.MutableData();
+  ByteWriter<uint16_t>::WriteBigEndian(&data[2], seq_num);
+  ByteWriter<uint32_t>::WriteBigEndian(&data[8], ssrc);
+  return packet;
+}
+
+}  // namespace webrtc
@@ -0,0 +1,66 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_RTP_RTCP_SOURCE_REED_SOLOMON_FEC_PACKET_H_
+#define MODULES_RTP_RTCP_SOURCE_REED_SOLOMON_FEC_PACKET_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "absl/types/optional.h"
+#include "api/array_view.h"
+#include "rtc_base/copy_on_write_buffer.h"
+
+namespace webrtc {
+
+// Reed-Solomon FEC packets protect a block of media packets with consecutive
+// sequence numbers of a single stream. Each carries one parity shard of the
+// block, computed by ReedSolomonCode, after this header:
+//
+//    0                   1                   2                   3
+//    0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1
+//   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//   |         SN base               |  num media    |  num FEC      |
+//   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//   |  FEC index    |   reserved    |        shard length           |
+//   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//
+// The data shard of a media packet is the packet, with the sequence number
+// replaced by the length of the packet after the 12 byte RTP header and with
+// the SSRC zeroed, padded with zeros to the shard length. The sequence number
+// and SSRC are known when recovering the packet.
+struct ReedSolomonFecHeader {
+  static constexpr size_t kSize = 8;
+
+  static absl::optional<ReedSolomonFecHeader> Parse(
+      rtc::ArrayView<const uint8_t> payload);
+  void Write(uint8_t* payload) const;
+
+  uint16_t seq_num_base = 0;
+  uint8_t num_media_packets = 0;
+  uint8_t num_fec_packets = 0;
+  uint8_t fec_index = 0;
+  uint16_t shard_length = 0;
+};
+
+// Writes the data shard of `packet` to `shard`. `packet` must be at least a
+// full RTP header and at most `shard_length` bytes.
+void MediaPacketToShard(rtc::ArrayView<const uint8_t> packet,
+                        rtc::ArrayView<uint8_t> shard);
+
+// Restores the media packet with `seq_num` and `ssrc` from its data shard.
+// Returns an empty buffer if the shard is not valid.
+rtc::CopyOnWriteBuffer ShardToMediaPacket(rtc::ArrayView<const uint8_t> shard,
+                                          uint16_t seq_num,
+                                          uint32_t ssrc);
+
+}  // namespace webrtc
+
+#endif  // MODULES_RTP_RTCP_SOURCE_REED_SOLOMON_FEC_PACKET_H_
@@ -0,0 +1,283 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/include/reed_solomon_fec_receiver.h"
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+#include "api/units/time_delta.h"
+#include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
+#include "modules/rtp_rtcp/source/reed_solomon_code.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+#include "system_wrappers/include/clock.h"
+
+namespace webrtc {
+
+namespace {
+
+// Media packets and blocks further back than this from the newest media
+// packet are forgotten. Room for two blocks of the largest size.
+constexpr int64_t kHistorySize = 2 * ReedSolomonCode::kMaxShards;
+
+// Upper bounds on the incomplete blocks that are kept, and on the parity
+// bytes they hold, so that FEC packets of blocks that never complete can't
+// grow the state without limit. The oldest blocks are dropped first.
+constexpr size_t kMaxBlocks = 64;
+constexpr size_t kMaxParityBytes = 2 * 1024 * 1024;
+
+// Logging constants.
+constexpr TimeDelta kPacketLogInterval = TimeDelta::Seconds(10);
+
+}  // namespace
+
+ReedSolomonFecReceiver::ReedSolomonFecReceiver(
+    Clock* clock,
+    uint32_t ssrc,
+    uint32_t protected_media_ssrc,
+    RecoveredPacketReceiver* recovered_packet_receiver)
+    : ssrc_(ssrc),
+      protected_media_ssrc_(protected_media_ssrc),
+      recovered_packet_receiver_(recovered_packet_receiver),
+      clock_(clock) {
+  // It's OK to create this object on a different thread/task queue than
+  // the one used during main operation.
+  sequence_checker_.Detach();
+}
+
+ReedSolomonFecReceiver::~ReedSolomonFecReceiver() = default;
+
+void ReedSolomonFecReceiver::OnRtpPacket(const RtpPacketReceived& packet) {
+  RTC_DCHECK_RUN_ON(&sequence_checker_);
+  // Recovered packets are already in `media_packets_`, and may come from
+  // MaybeRecover in this object.
+  if (packet.recovered())
+    return;
+
+  if (packet.Ssrc() == ssrc_) {
+    AddFecPacket(packet);
+  } else if (packet.Ssrc() == protected_media_ssrc_) {
+    AddMediaPacket(packet);
+  }
+}
+
+FecPacketCounter ReedSolomonFecReceiver::GetPacketCounter() const {
+  RTC_DCHECK_RUN_ON(&sequence_checker_);
+  return packet_counter_;
+}
+
+void ReedSolomonFecReceiver::AddMediaPacket(const RtpPacketReceived& packet) {
+  const int64_t seq_num = seq_num_unwrapper_.Unwrap(packet.SequenceNumber());
+  ++packet_counter_.num_packets;
+  PruneHistory(seq_num);
+  if (seq_num < history_start_ || media_packets_.count(seq_num) > 0) {
+    return;
+  }
+
+  // As the sender, which protects the packets before the mutable extensions
+  // are set, use a copy with these filled with zeros.
+  RtpPacketReceived packet_copy(packet);
+  packet_copy.ZeroMutableExtensions();
+  media_packets_.emplace(seq_num, packet_copy.Buffer());
+  extensions_ = packet.extension_manager();
+
+  // Blocks that may protect this packet.
+  std::vector<int64_t> seq_num_bases;
+  for (auto it = blocks_.lower_bound(seq_num - ReedSolomonCode::kMaxShards);
+       it != blocks_.end() && it->first <= seq_num; ++it) {
+    if (seq_num < it->first + it->second.header.num_media_packets) {
+      seq_num_bases.push_back(it->first);
+    }
+  }
+  for (int64_t seq_num_base : seq_num_bases) {
+    MaybeRecover(seq_num_base);
+  }
+}
+
+void ReedSolomonFecReceiver::AddFecPacket(const RtpPacketReceived& packet) {
+  absl::optional<ReedSolomonFecHeader> header =
+      ReedSolomonFecHeader::Parse(packet.payload());
+  if (!header) {
+    RTC_LOG(LS_WARNING) << "Invalid Reed-Solomon FEC packet, discarding.";
+    return;
+  }
+  ++packet_counter_.num_packets;
+  ++packet_counter_.num_fec_packets;
+
+  const int64_t seq_num_base =
+      seq_num_unwrapper_.PeekUnwrap(header->seq_num_base);
+  const int64_t last_seq_num = seq_num_base + header->num_media_packets - 1;
+  if (seq_num_base < history_start_) {
+    return;
+  }
+  if (history_start_ != std::numeric_limits<int64_t>::min() &&
+      last_seq_num >
+          history_start_ + kHistorySize + ReedSolomonCode::kMaxShards) {
+    // Media packets are sent before the FEC packets protecting them, so a
+    // block can't be more than one block ahead of the newest media packet.
+    RTC_LOG(LS_WARNING) << "Reed-Solomon FEC packet protects media packets "
+                           "far ahead of the received ones, discarding.";
+    return;
+  }
+  PruneHistory(last_seq_num);
+
+  auto [it, inserted] = blocks_.try_emplace(seq_num_base);
+  Block& block = it->second;
+  if (inserted) {
+    block.header = *header;
+    block.parity.resize(header->num_fec_packets);
+    if (blocks_.size() > kMaxBlocks) {
+      if (blocks_.begin() == it) {
+        EraseBlock(it);
+        return;
+      }
+      EraseBlock(blocks_.begin());
+    }
+  } else if (block.header.num_media_packets != header->num_media_packets ||
+             block.header.num_fec_packets != header->num_fec_packets ||
+             block.header.shard_length != header->shard_length) {
+    RTC_LOG(LS_WARNING) << "Reed-Solomon FEC packet does not match the other "
+                           "packets of its block, discarding.";
+    return;
+  }
+  rtc::CopyOnWriteBuffer& parity = block.parity[header->fec_index];
+  if (!parity.empty()) {
+    return;
+  }
+  while (parity_bytes_ + header->shard_length > kMaxParityBytes &&
+         blocks_.begin() != it) {
+    EraseBlock(blocks_.begin());
+  }
+  if (parity_bytes_ + header->shard_length > kMaxParityBytes) {
+    RTC_LOG(LS_WARNING) << "Reed-Solomon FEC block too large, discarding.";
+    EraseBlock(it);
+    return;
+  }
+  parity = packet.Buffer().Slice(
+      packet.headers_size() + ReedSolomonFecHeader::kSize,
+      header->shard_length);
+  ++block.num_parity;
+  block.parity_bytes += header->shard_length;
+  parity_bytes_ += header->shard_length;
+
+  MaybeRecover(seq_num_base);
+}
+
+void ReedSolomonFecReceiver::MaybeRecover(int64_t seq_num_base) {
+  auto block_it = blocks_.find(seq_num_base);
+  RTC_DCHECK(block_it != blocks_.end());
+  const Block& block = block_it->second;
+  const int num_media_packets = block.header.num_media_packets;
+  const size_t shard_length = block.header.shard_length;
+
+  std::vector<int> missing;
+  for (int i = 0; i < num_media_packets; ++i) {
+    if (media_packets_.count(seq_num_base + i) == 0) {
+      missing.push_back(i);
+    }
+  }
+  if (missing.empty()) {
+    EraseBlock(block_it);
+    return;
+  }
+  if (static_cast<int>(missing.size()) > block.num_parity) {
+    return;
+  }
+
+  std::vector<uint8_t> shards(num_media_packets * shard_length);
+  std::vector<uint8_t*> data(num_media_packets);
+  for (int i = 0; i < num_media_packets; ++i) {
+    data[i] = &shards[i * shard_length];
+    auto media_it = media_packets_.find(seq_num_base + i);
+    if (media_it == media_packets_.end()) {
+      continue;
+    }
+    if (media_it->second.size() > shard_length) {
+      RTC_LOG(LS_WARNING) << "Media packet larger than the Reed-Solomon FEC "
+                             "shards protecting it, discarding the block.";
+      EraseBlock(block_it);
+      return;
+    }
+    MediaPacketToShard(media_it->second,
+                       rtc::ArrayView<uint8_t>(data[i], shard_length));
+  }
+  std::vector<const uint8_t*> parity(block.parity.size(), nullptr);
+  for (size_t j = 0; j < parity.size(); ++j) {
+    if (!block.parity[j].empty()) {
+      parity[j] = block.parity[j].cdata();
+    }
+  }
+  const bool recovered =
+      ReedSolomonCode::Recover(data, missing, parity, shard_length);
+  EraseBlock(block_it);
+  if (!recovered) {
+    return;
+  }
+
+  std::vector<rtc::CopyOnWriteBuffer> recovered_packets;
+  for (int i : missing) {
+    rtc::CopyOnWriteBuffer recovered_packet = ShardToMediaPacket(
+        rtc::ArrayView<const uint8_t>(data[i], shard_length),
+        static_cast<uint16_t>(seq_num_base + i), protected_media_ssrc_);
+    if (recovered_packet.empty()) {
+      continue;
+    }
+    media_packets_.emplace(seq_num_base + i, recovered_packet);
+    recovered_packets.push_back(std::move(recovered_packet));
+  }
+
+  // Return recovered packets through callback, once the state is updated,
+  // since OnRecoveredPacket may end up here again.
+  for (const rtc::CopyOnWriteBuffer& recovered_packet : recovered_packets) {
+    RtpPacketReceived parsed_packet(&extensions_);
+    if (!parsed_packet.Parse(recovered_packet)) {
+      continue;
+    }
+    ++packet_counter_.num_recovered_packets;
+    parsed_packet.set_recovered(true);
+    parsed_packet.set_payload_type_frequency(kVideoPayloadTypeFrequency);
+    recovered_packet_receiver_->OnRecoveredPacket(parsed_packet);
+
+    // Periodically log the recovered packets at LS_INFO.
+    Timestamp now = clock_->CurrentTime();
+    bool should_log_periodically =
+        now - last_recovered_packet_ > kPacketLogInterval;
+    if (RTC_LOG_CHECK_LEVEL(LS_VERBOSE) || should_log_periodically) {
+      rtc::LoggingSeverity level =
+          should_log_periodically ? rtc::LS_INFO : rtc::LS_VERBOSE;
+      RTC_LOG_V(level) << "Recovered media packet with SSRC: "
+                       << parsed_packet.Ssrc() << " seq "
+                       << parsed_packet.SequenceNumber()
+                       << " from Reed-Solomon FEC stream with SSRC: " << ssrc_;
+      if (should_log_periodically) {
+        last_recovered_packet_ = now;
+      }
+    }
+  }
+}
+
+void ReedSolomonFecReceiver::PruneHistory(int64_t newest_seq_num) {
+  history_start_ = std::max(history_start_, newest_seq_num - kHistorySize);
+  media_packets_.erase(media_packets_.begin(),
+                       media_packets_.lower_bound(history_start_));
+  while (!blocks_.empty() && blocks_.begin()->first < history_start_) {
+    EraseBlock(blocks_.begin());
+  }
+}
+
+void ReedSolomonFecReceiver::EraseBlock(std::map<int64_t, Block>::iterator it) {
+  RTC_DCHECK_GE(parity_bytes_, it->second.parity_bytes);
+  parity_bytes_ -= it->second.parity_bytes;
+  blocks_.erase(it);
+}
+
+}  // namespace webrtc
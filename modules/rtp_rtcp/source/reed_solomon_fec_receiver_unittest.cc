@@ -0,0 +1,244 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/include/reed_solomon_fec_receiver.h"
+
+#include <memory>
+#include <set>
+#include <vector>
+
+#include "api/rtp_parameters.h"
+#include "modules/rtp_rtcp/include/reed_solomon_fec_sender.h"
+#include "modules/rtp_rtcp/mocks/mock_recovered_packet_receiver.h"
+#include "modules/rtp_rtcp/source/rtp_packet_received.h"
+#include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
+#include "rtc_base/random.h"
+#include "system_wrappers/include/clock.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::Invoke;
+
+constexpr int kFecPayloadType = 123;
+constexpr int kMediaPayloadType = 96;
+constexpr uint32_t kMediaSsrc = 1234;
+constexpr uint32_t kFecSsrc = 5678;
+const char kNoMid[] = "";
+const std::vector<RtpExtension> kNoRtpHeaderExtensions;
+const std::vector<RtpExtensionSize> kNoRtpHeaderExtensionSizes;
+
+RtpPacketReceived ToReceived(const RtpPacketToSend& packet) {
+  RtpPacketReceived received;
+  EXPECT_TRUE(received.Parse(packet.Buffer()));
+  return received;
+}
+
+class ReedSolomonFecReceiverTest : public ::testing::Test {
+ protected:
+  ReedSolomonFecReceiverTest()
+      : clock_(1),
+        random_(0x1234),
+        sender_(kFecPayloadType,
+                kFecSsrc,
+                kMediaSsrc,
+                kNoMid,
+                kNoRtpHeaderExtensions,
+                kNoRtpHeaderExtensionSizes,
+                /*rtp_state=*/nullptr,
+                &clock_),
+        receiver_(&clock_, kFecSsrc, kMediaSsrc, &recovered_packet_receiver_) {
+    FecProtectionParams params;
+    params.fec_rate = 128;
+    params.max_fec_frames = 1;
+    params.fec_mask_type = kFecMaskBursty;
+    sender_.SetProtectionParameters(params, params);
+  }
+
+  // Packetizes a frame of `num_packets` media packets of random sizes, starting
+  // at `seq_num`, and protects it with FEC packets.
+  void SendFrame(uint16_t seq_num, int num_packets) {
+    media_packets_.clear();
+    fec_packets_.clear();
+    for (int i = 0; i < num_packets; ++i) {
+      RtpPacketToSend packet(nullptr);
+      packet.SetPayloadType(kMediaPayloadType);
+      packet.SetSequenceNumber(seq_num + i);
+      packet.SetTimestamp(1000);
+      packet.SetSsrc(kMediaSsrc);
+      packet.SetMarker(i + 1 == num_packets);
+      const size_t payload_size = random_.Rand(100, 1200);
+      uint8_t* payload = packet.AllocatePayload(payload_size);
+      for (size_t j = 0; j < payload_size; ++j) {
+        payload[j] = random_.Rand<uint8_t>();
+      }
+      sender_.AddPacketAndGenerateFec(packet);
+      media_packets_.push_back(ToReceived(packet));
+    }
+    for (const auto& fec_packet : sender_.GetFecPackets()) {
+      fec_packets_.push_back(ToReceived(*fec_packet));
+    }
+  }
+
+  // Delivers the media packets that are not `lost`, then the FEC packets, and
+  // expects the lost packets to be recovered exactly.
+  void ExpectRecovery(const std::set<int>& lost) {
+    std::vector<RtpPacketReceived> recovered;
+    EXPECT_CALL(recovered_packet_receiver_, OnRecoveredPacket)
+        .Times(lost.size())
+        .WillRepeatedly(Invoke([&](const RtpPacketReceived& packet) {
+          EXPECT_TRUE(packet.recovered());
+          recovered.push_back(packet);
+        }));
+    for (size_t i = 0; i < media_packets_.size(); ++i) {
+      if (lost.count(i) == 0) {
+        receiver_.OnRtpPacket(media_packets_[i]);
+      }
+    }
+    for (const RtpPacketReceived& packet : fec_packets_) {
+      receiver_.OnRtpPacket(packet);
+    }
+    ASSERT_EQ(recovered.size(), lost.size());
+    auto it = lost.begin();
+    for (const RtpPacketReceived& packet : recovered) {
+      const RtpPacketReceived& expected = media_packets_[*it++];
+      EXPECT_EQ(packet.SequenceNumber(), expected.SequenceNumber());
+      EXPECT_EQ(packet.Ssrc(), kMediaSsrc);
+      EXPECT_EQ(packet.Marker(), expected.Marker());
+      EXPECT_EQ(packet.Buffer(), expected.Buffer());
+    }
+    ::testing::Mock::VerifyAndClearExpectations(&recovered_packet_receiver_);
+  }
+
+  SimulatedClock clock_;
+  Random random_;
+  ReedSolomonFecSender sender_;
+  ::testing::StrictMock<MockRecoveredPacketReceiver>
+      recovered_packet_receiver_;
+  ReedSolomonFecReceiver receiver_;
+  std::vector<RtpPacketReceived> media_packets_;
+  std::vector<RtpPacketReceived> fec_packets_;
+};
+
+TEST_F(ReedSolomonFecReceiverTest, DoesNotReturnReceivedMediaPackets) {
+  SendFrame(100, 10);
+  ExpectRecovery({});
+  EXPECT_EQ(receiver_.GetPacketCounter().num_packets, 15u);
+  EXPECT_EQ(receiver_.GetPacketCounter().num_fec_packets, 5u);
+  EXPECT_EQ(receiver_.GetPacketCounter().num_recovered_packets, 0u);
+}
+
+TEST_F(ReedSolomonFecReceiverTest, RecoversBurstAsLongAsFecPackets) {
+  SendFrame(100, 10);
+  ExpectRecovery({3, 4, 5, 6, 7});
+  EXPECT_EQ(receiver_.GetPacketCounter().num_recovered_packets, 5u);
+}
+
+TEST_F(ReedSolomonFecReceiverTest, RecoversScatteredLosses) {
+  SendFrame(100, 10);
+  ExpectRecovery({0, 2, 9});
+}
+
+TEST_F(ReedSolomonFecReceiverTest, RecoversWithFecBeforeMedia) {
+  SendFrame(100, 10);
+  receiver_.OnRtpPacket(fec_packets_[4]);
+  receiver_.OnRtpPacket(fec_packets_[1]);
+  for (int i = 0; i < 7; ++i) {
+    receiver_.OnRtpPacket(media_packets_[i]);
+  }
+  // The last of the 8 media packets needed completes the block.
+  EXPECT_CALL(recovered_packet_receiver_, OnRecoveredPacket).Times(2);
+  receiver_.OnRtpPacket(media_packets_[9]);
+  // The other packets of the block are not recovered again.
+  receiver_.OnRtpPacket(fec_packets_[0]);
+  receiver_.OnRtpPacket(media_packets_[8]);
+}
+
+TEST_F(ReedSolomonFecReceiverTest, DoesNotRecoverLongerBurstThanFecPackets) {
+  SendFrame(100, 10);
+  for (const RtpPacketReceived& packet : fec_packets_) {
+    receiver_.OnRtpPacket(packet);
+  }
+  for (int i = 6; i < 10; ++i) {
+    receiver_.OnRtpPacket(media_packets_[i]);
+  }
+  EXPECT_EQ(receiver_.GetPacketCounter().num_recovered_packets, 0u);
+}
+
+TEST_F(ReedSolomonFecReceiverTest, RecoversAcrossSequenceNumberWrap) {
+  SendFrame(0xfffb, 10);
+  ExpectRecovery({4, 5, 6});
+  SendFrame(5, 10);
+  ExpectRecovery({0, 1});
+}
+
+TEST_F(ReedSolomonFecReceiverTest, IgnoresRecoveredPackets) {
+  SendFrame(100, 10);
+  for (RtpPacketReceived& packet : fec_packets_) {
+    packet.set_recovered(true);
+  }
+  for (const RtpPacketReceived& packet : fec_packets_) {
+    receiver_.OnRtpPacket(packet);
+  }
+  EXPECT_EQ(receiver_.GetPacketCounter().num_packets, 0u);
+}
+
+TEST_F(ReedSolomonFecReceiverTest, DiscardsTruncatedFecPacket) {
+  SendFrame(100, 10);
+  RtpPacketReceived truncated = fec_packets_[0];
+  truncated.SetPayloadSize(truncated.payload_size() - 1);
+  receiver_.OnRtpPacket(truncated);
+  EXPECT_EQ(receiver_.GetPacketCounter().num_fec_packets, 0u);
+}
+
+TEST_F(ReedSolomonFecReceiverTest, IgnoresOtherStreams) {
+  SendFrame(100, 10);
+  RtpPacketReceived other = media_packets_[0];
+  other.SetSsrc(kMediaSsrc + 1);
+  receiver_.OnRtpPacket(other);
+  EXPECT_EQ(receiver_.GetPacketCounter().num_packets, 0u);
+}
+
+TEST_F(ReedSolomonFecReceiverTest, DropsOldestBlocksBeyondLimit) {
+  // Frames whose media packets are all lost leave incomplete blocks behind.
+  std::vector<std::vector<RtpPacketReceived>> frames;
+  for (int i = 0; i < 100; ++i) {
+    SendFrame(100 + 2 * i, 2);
+    frames.push_back(media_packets_);
+    for (const RtpPacketReceived& packet : fec_packets_) {
+      receiver_.OnRtpPacket(packet);
+    }
+  }
+  // The block of the first frame was dropped to make room for newer ones.
+  receiver_.OnRtpPacket(frames.front()[1]);
+  // The block of the last frame is still there.
+  EXPECT_CALL(recovered_packet_receiver_, OnRecoveredPacket);
+  receiver_.OnRtpPacket(frames.back()[1]);
+}
+
+TEST_F(ReedSolomonFecReceiverTest, DiscardsFecFarAheadOfMediaPackets) {
+  SendFrame(100, 10);
+  ExpectRecovery({});
+  SendFrame(5000, 10);
+  for (const RtpPacketReceived& packet : fec_packets_) {
+    receiver_.OnRtpPacket(packet);
+  }
+  EXPECT_EQ(receiver_.GetPacketCounter().num_fec_packets, 10u);
+  // The FEC packets were not kept, so the lost packet is not recovered.
+  for (int i = 1; i < 10; ++i) {
+    receiver_.OnRtpPacket(media_packets_[i]);
+  }
+  EXPECT_EQ(receiver_.GetPacketCounter().num_recovered_packets, 0u);
+}
+
+}  // namespace
+}  // namespace webrtc
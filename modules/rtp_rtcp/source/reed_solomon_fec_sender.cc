@@ -0,0 +1,264 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/include/reed_solomon_fec_sender.h"
+
+#include <string.h>
+
+#include <algorithm>
+#include <utility>
+
+#include "absl/strings/string_view.h"
+#include "api/units/time_delta.h"
+#include "modules/rtp_rtcp/source/forward_error_correction.h"
+#include "modules/rtp_rtcp/source/reed_solomon_code.h"
+#include "modules/rtp_rtcp/source/reed_solomon_fec_packet.h"
+#include "modules/rtp_rtcp/source/rtp_header_extensions.h"
+#include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+#include "system_wrappers/include/clock.h"
+
+namespace webrtc {
+
+namespace {
+
+// Let first sequence number be in the first half of the interval.
+constexpr uint16_t kMaxInitRtpSeqNumber = 0x7fff;
+
+// As FlexfecSender, use the 90 kHz clock of the protected video stream.
+constexpr int kMsToRtpTimestamp = kVideoPayloadTypeFrequency / 1000;
+
+// How often to log the generated FEC packets to the text log.
+constexpr TimeDelta kPacketLogInterval = TimeDelta::Seconds(10);
+
+RtpHeaderExtensionMap RegisterSupportedExtensions(
+    const std::vector<RtpExtension>& rtp_header_extensions) {
+  RtpHeaderExtensionMap map;
+  for (const auto& extension : rtp_header_extensions) {
+    if (extension.uri == TransportSequenceNumber::Uri()) {
+      map.Register<TransportSequenceNumber>(extension.id);
+    } else if (extension.uri == AbsoluteSendTime::Uri()) {
+      map.Register<AbsoluteSendTime>(extension.id);
+    } else if (extension.uri == TransmissionOffset::Uri()) {
+      map.Register<TransmissionOffset>(extension.id);
+    } else if (extension.uri == RtpMid::Uri()) {
+      map.Register<RtpMid>(extension.id);
+    } else {
+      RTC_LOG(LS_INFO)
+          << "ReedSolomonFecSender only supports RTP header extensions for "
+             "BWE and MID, so the extension "
+          << extension.ToString() << " will not be used.";
+    }
+  }
+  return map;
+}
+
+}  // namespace
+
+ReedSolomonFecSender::ReedSolomonFecSender(
+    int payload_type,
+    uint32_t ssrc,
+    uint32_t protected_media_ssrc,
+    absl::string_view mid,
+    const std::vector<RtpExtension>& rtp_header_extensions,
+    rtc::ArrayView<const RtpExtensionSize> extension_sizes,
+    const RtpState* rtp_state,
+    Clock* clock)
+    : clock_(clock),
+      random_(clock_->TimeInMicroseconds()),
+      payload_type_(payload_type),
+      timestamp_offset_(rtp_state ? rtp_state->start_timestamp
+                                  : random_.Rand<uint32_t>()),
+      ssrc_(ssrc),
+      protected_media_ssrc_(protected_media_ssrc),
+      mid_(mid),
+      rtp_header_extension_map_(
+          RegisterSupportedExtensions(rtp_header_extensions)),
+      header_extensions_size_(
+          RtpHeaderExtensionSize(extension_sizes, rtp_header_extension_map_)),
+      seq_num_(rtp_state ? rtp_state->sequence_number
+                         : random_.Rand(1, kMaxInitRtpSeqNumber)),
+      fec_bitrate_(/*max_window_size=*/TimeDelta::Seconds(1)) {
+  RTC_DCHECK_GE(payload_type, 0);
+  RTC_DCHECK_LE(payload_type, 127);
+  media_packets_.reserve(kMaxMediaPackets);
+}
+
+ReedSolomonFecSender::~ReedSolomonFecSender() = default;
+
+void ReedSolomonFecSender::SetProtectionParameters(
+    const FecProtectionParams& delta_params,
+    const FecProtectionParams& key_params) {
+  RTC_DCHECK_GE(delta_params.fec_rate, 0);
+  RTC_DCHECK_LE(delta_params.fec_rate, 255);
+  RTC_DCHECK_GE(key_params.fec_rate, 0);
+  RTC_DCHECK_LE(key_params.fec_rate, 255);
+  MutexLock lock(&mutex_);
+  pending_params_.emplace(delta_params, key_params);
+}
+
+void ReedSolomonFecSender::AddPacketAndGenerateFec(
+    const RtpPacketToSend& packet) {
+  RTC_DCHECK_EQ(packet.Ssrc(), protected_media_ssrc_);
+  RTC_DCHECK(fec_payloads_.empty());
+  {
+    MutexLock lock(&mutex_);
+    if (pending_params_) {
+      std::tie(delta_params_, key_params_) = *pending_params_;
+      pending_params_.reset();
+    }
+  }
+
+  // A block covers consecutive sequence numbers. Should a packet be skipped,
+  // the packets so far are left unprotected.
+  if (!media_packets_.empty() &&
+      packet.SequenceNumber() !=
+          static_cast<uint16_t>(seq_num_base_ + media_packets_.size())) {
+    ResetState();
+  }
+  if (media_packets_.empty()) {
+    seq_num_base_ = packet.SequenceNumber();
+  }
+  media_packets_.push_back(packet.Buffer());
+  if (packet.is_key_frame()) {
+    media_contains_keyframe_ = true;
+  }
+  if (packet.Marker()) {
+    ++num_protected_frames_;
+  }
+
+  const FecProtectionParams& params =
+      media_contains_keyframe_ ? key_params_ : delta_params_;
+  if ((packet.Marker() && num_protected_frames_ >= params.max_fec_frames) ||
+      media_packets_.size() == kMaxMediaPackets) {
+    GenerateFec(params.fec_rate);
+    ResetState();
+  }
+}
+
+void ReedSolomonFecSender::GenerateFec(int fec_rate) {
+  const int num_media_packets = media_packets_.size();
+  const int num_fec_packets =
+      ForwardErrorCorrection::NumFecPackets(num_media_packets, fec_rate);
+  if (num_fec_packets == 0) {
+    return;
+  }
+  RTC_DCHECK_LE(num_media_packets + num_fec_packets,
+                ReedSolomonCode::kMaxShards);
+
+  size_t shard_length = 0;
+  for (const rtc::CopyOnWriteBuffer& media_packet : media_packets_) {
+    shard_length = std::max(shard_length, media_packet.size());
+  }
+  std::vector<uint8_t> shards(num_media_packets * shard_length);
+  std::vector<const uint8_t*> data(num_media_packets);
+  for (int i = 0; i < num_media_packets; ++i) {
+    rtc::ArrayView<uint8_t> shard(&shards[i * shard_length], shard_length);
+    MediaPacketToShard(media_packets_[i], shard);
+    data[i] = shard.data();
+  }
+
+  ReedSolomonFecHeader header;
+  header.seq_num_base = seq_num_base_;
+  header.num_media_packets = num_media_packets;
+  header.num_fec_packets = num_fec_packets;
+  header.shard_length = shard_length;
+  std::vector<uint8_t*> parity(num_fec_packets);
+  fec_payloads_.reserve(num_fec_packets);
+  for (int j = 0; j < num_fec_packets; ++j) {
+    rtc::Buffer& payload = fec_payloads_.emplace_back(
+        ReedSolomonFecHeader::kSize + shard_length);
+    header.fec_index = j;
+    header.Write(payload.data());
+    parity[j] = payload.data() + ReedSolomonFecHeader::kSize;
+  }
+  ReedSolomonCode::Encode(data, shard_length, parity);
+}
+
+void ReedSolomonFecSender::ResetState() {
+  media_packets_.clear();
+  num_protected_frames_ = 0;
+  media_contains_keyframe_ = false;
+}
+
+std::vector<std::unique_ptr<RtpPacketToSend>>
+ReedSolomonFecSender::GetFecPackets() {
+  std::vector<std::unique_ptr<RtpPacketToSend>> fec_packets_to_send;
+  fec_packets_to_send.reserve(fec_payloads_.size());
+  size_t total_fec_data_bytes = 0;
+  for (const rtc::Buffer& fec_payload : fec_payloads_) {
+    auto fec_packet_to_send =
+        std::make_unique<RtpPacketToSend>(&rtp_header_extension_map_);
+    fec_packet_to_send->set_packet_type(
+        RtpPacketMediaType::kForwardErrorCorrection);
+    fec_packet_to_send->set_allow_retransmission(false);
+
+    // RTP header.
+    fec_packet_to_send->SetMarker(false);
+    fec_packet_to_send->SetPayloadType(payload_type_);
+    fec_packet_to_send->SetSequenceNumber(seq_num_++);
+    fec_packet_to_send->SetTimestamp(
+        timestamp_offset_ +
+        static_cast<uint32_t>(kMsToRtpTimestamp *
+                              clock_->TimeInMilliseconds()));
+    fec_packet_to_send->set_capture_time(clock_->CurrentTime());
+    fec_packet_to_send->SetSsrc(ssrc_);
+    // Reserve extensions, if registered. These will be set by the RTPSender.
+    fec_packet_to_send->ReserveExtension<AbsoluteSendTime>();
+    fec_packet_to_send->ReserveExtension<TransmissionOffset>();
+    fec_packet_to_send->ReserveExtension<TransportSequenceNumber>();
+    if (!mid_.empty()) {
+      // This is a no-op if the MID header extension is not registered.
+      fec_packet_to_send->SetExtension<RtpMid>(mid_);
+    }
+
+    // RTP payload.
+    uint8_t* payload = fec_packet_to_send->AllocatePayload(fec_payload.size());
+    memcpy(payload, fec_payload.data(), fec_payload.size());
+
+    total_fec_data_bytes += fec_packet_to_send->size();
+    fec_packets_to_send.push_back(std::move(fec_packet_to_send));
+  }
+  fec_payloads_.clear();
+
+  Timestamp now = clock_->CurrentTime();
+  if (!fec_packets_to_send.empty() &&
+      now - last_generated_packet_ > kPacketLogInterval) {
+    RTC_LOG(LS_VERBOSE) << "Generated " << fec_packets_to_send.size()
+                        << " Reed-Solomon FEC packets with payload type: "
+                        << payload_type_ << " and SSRC: " << ssrc_ << ".";
+    last_generated_packet_ = now;
+  }
+
+  MutexLock lock(&mutex_);
+  fec_bitrate_.Update(total_fec_data_bytes, now);
+
+  return fec_packets_to_send;
+}
+
+// The overhead is BWE RTP header extensions and the FEC header.
+size_t ReedSolomonFecSender::MaxPacketOverhead() const {
+  return header_extensions_size_ + ReedSolomonFecHeader::kSize;
+}
+
+DataRate ReedSolomonFecSender::CurrentFecRate() const {
+  MutexLock lock(&mutex_);
+  return fec_bitrate_.Rate(clock_->CurrentTime()).value_or(DataRate::Zero());
+}
+
+absl::optional<RtpState> ReedSolomonFecSender::GetRtpState() {
+  RtpState rtp_state;
+  rtp_state.sequence_number = seq_num_;
+  rtp_state.start_timestamp = timestamp_offset_;
+  return rtp_state;
+}
+
+}  // namespace webrtc
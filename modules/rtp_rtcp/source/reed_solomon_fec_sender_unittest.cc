@@ -0,0 +1,199 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/include/reed_solomon_fec_sender.h"
+
+#include <memory>
+#include <vector>
+
+#include "api/rtp_parameters.h"
+#include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
+#include "modules/rtp_rtcp/source/fec_test_helper.h"
+#include "modules/rtp_rtcp/source/reed_solomon_fec_packet.h"
+#include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
+#include "system_wrappers/include/clock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using test::fec::AugmentedPacket;
+using test::fec::AugmentedPacketGenerator;
+
+constexpr int kFecPayloadType = 123;
+constexpr uint32_t kMediaSsrc = 1234;
+constexpr uint32_t kFecSsrc = 5678;
+const char kNoMid[] = "";
+const std::vector<RtpExtension> kNoRtpHeaderExtensions;
+const std::vector<RtpExtensionSize> kNoRtpHeaderExtensionSizes;
+constexpr size_t kPayloadLength = 50;
+constexpr int64_t kInitialSimulatedClockTime = 1;
+
+class ReedSolomonFecSenderTest : public ::testing::Test {
+ protected:
+  ReedSolomonFecSenderTest()
+      : clock_(kInitialSimulatedClockTime),
+        sender_(kFecPayloadType,
+                kFecSsrc,
+                kMediaSsrc,
+                kNoMid,
+                kNoRtpHeaderExtensions,
+                kNoRtpHeaderExtensionSizes,
+                /*rtp_state=*/nullptr,
+                &clock_),
+        packet_generator_(kMediaSsrc) {}
+
+  void SetProtectionParameters(int fec_rate, int max_fec_frames) {
+    FecProtectionParams params;
+    params.fec_rate = fec_rate;
+    params.max_fec_frames = max_fec_frames;
+    params.fec_mask_type = kFecMaskBursty;
+    sender_.SetProtectionParameters(params, params);
+  }
+
+  // Adds the packets of a frame, and returns the FEC packets generated after
+  // the last one.
+  std::vector<std::unique_ptr<RtpPacketToSend>> AddFrame(size_t num_packets) {
+    packet_generator_.NewFrame(num_packets);
+    for (size_t i = 0; i < num_packets; ++i) {
+      std::unique_ptr<AugmentedPacket> packet =
+          packet_generator_.NextPacket(i, kPayloadLength + i);
+      RtpPacketToSend rtp_packet(nullptr);
+      EXPECT_TRUE(rtp_packet.Parse(packet->data));
+      sender_.AddPacketAndGenerateFec(rtp_packet);
+      if (i + 1 < num_packets) {
+        EXPECT_TRUE(sender_.GetFecPackets().empty());
+      }
+    }
+    return sender_.GetFecPackets();
+  }
+
+  SimulatedClock clock_;
+  ReedSolomonFecSender sender_;
+  AugmentedPacketGenerator packet_generator_;
+};
+
+TEST_F(ReedSolomonFecSenderTest, Ssrc) {
+  EXPECT_EQ(sender_.FecSsrc(), kFecSsrc);
+  EXPECT_EQ(sender_.GetFecType(), VideoFecGenerator::FecType::kFlexFec);
+}
+
+TEST_F(ReedSolomonFecSenderTest, NoFecAvailableBeforeMediaAdded) {
+  EXPECT_TRUE(sender_.GetFecPackets().empty());
+}
+
+TEST_F(ReedSolomonFecSenderTest, NoFecWithoutProtection) {
+  SetProtectionParameters(/*fec_rate=*/0, /*max_fec_frames=*/1);
+  EXPECT_TRUE(AddFrame(10).empty());
+}
+
+TEST_F(ReedSolomonFecSenderTest, ProtectsFrameWithFecPackets) {
+  // 10 media packets at half rate give 5 FEC packets.
+  SetProtectionParameters(/*fec_rate=*/128, /*max_fec_frames=*/1);
+  std::vector<std::unique_ptr<RtpPacketToSend>> fec_packets = AddFrame(10);
+  ASSERT_EQ(fec_packets.size(), 5u);
+
+  for (size_t j = 0; j < fec_packets.size(); ++j) {
+    const RtpPacketToSend& fec_packet = *fec_packets[j];
+    EXPECT_EQ(fec_packet.headers_size(), kRtpHeaderSize);
+    EXPECT_FALSE(fec_packet.Marker());
+    EXPECT_EQ(fec_packet.PayloadType(), kFecPayloadType);
+    EXPECT_EQ(fec_packet.Ssrc(), kFecSsrc);
+    EXPECT_EQ(fec_packet.SequenceNumber(),
+              static_cast<uint16_t>(fec_packets[0]->SequenceNumber() + j));
+
+    absl::optional<ReedSolomonFecHeader> header =
+        ReedSolomonFecHeader::Parse(fec_packet.payload());
+    ASSERT_TRUE(header);
+    EXPECT_EQ(header->seq_num_base, 0);
+    EXPECT_EQ(header->num_media_packets, 10);
+    EXPECT_EQ(header->num_fec_packets, 5);
+    EXPECT_EQ(header->fec_index, j);
+    // The largest media packet.
+    EXPECT_EQ(header->shard_length, kRtpHeaderSize + kPayloadLength + 9);
+  }
+}
+
+TEST_F(ReedSolomonFecSenderTest, ProtectsMaxFecFramesTogether) {
+  SetProtectionParameters(/*fec_rate=*/64, /*max_fec_frames=*/3);
+  EXPECT_TRUE(AddFrame(4).empty());
+  EXPECT_TRUE(AddFrame(4).empty());
+  std::vector<std::unique_ptr<RtpPacketToSend>> fec_packets = AddFrame(4);
+  ASSERT_EQ(fec_packets.size(), 3u);
+
+  absl::optional<ReedSolomonFecHeader> header =
+      ReedSolomonFecHeader::Parse(fec_packets[0]->payload());
+  ASSERT_TRUE(header);
+  EXPECT_EQ(header->seq_num_base, 0);
+  EXPECT_EQ(header->num_media_packets, 12);
+
+  // The next block starts after the protected packets.
+  SetProtectionParameters(/*fec_rate=*/64, /*max_fec_frames=*/1);
+  fec_packets = AddFrame(4);
+  ASSERT_EQ(fec_packets.size(), 1u);
+  header = ReedSolomonFecHeader::Parse(fec_packets[0]->payload());
+  ASSERT_TRUE(header);
+  EXPECT_EQ(header->seq_num_base, 12);
+  EXPECT_EQ(header->num_media_packets, 4);
+}
+
+TEST_F(ReedSolomonFecSenderTest, StartsNewBlockAfterSequenceNumberGap) {
+  SetProtectionParameters(/*fec_rate=*/64, /*max_fec_frames=*/2);
+  EXPECT_TRUE(AddFrame(4).empty());
+  packet_generator_.NextPacketSeqNum();
+  EXPECT_TRUE(AddFrame(4).empty());
+  std::vector<std::unique_ptr<RtpPacketToSend>> fec_packets = AddFrame(4);
+  ASSERT_EQ(fec_packets.size(), 2u);
+
+  absl::optional<ReedSolomonFecHeader> header =
+      ReedSolomonFecHeader::Parse(fec_packets[0]->payload());
+  ASSERT_TRUE(header);
+  EXPECT_EQ(header->seq_num_base, 5);
+  EXPECT_EQ(header->num_media_packets, 8);
+}
+
+TEST_F(ReedSolomonFecSenderTest, LimitsBlockToMaxMediaPackets) {
+  SetProtectionParameters(/*fec_rate=*/32, /*max_fec_frames=*/10);
+  packet_generator_.NewFrame(ReedSolomonFecSender::kMaxMediaPackets + 1);
+  std::vector<std::unique_ptr<RtpPacketToSend>> fec_packets;
+  for (size_t i = 0; i < ReedSolomonFecSender::kMaxMediaPackets; ++i) {
+    std::unique_ptr<AugmentedPacket> packet =
+        packet_generator_.NextPacket(i, kPayloadLength);
+    RtpPacketToSend rtp_packet(nullptr);
+    ASSERT_TRUE(rtp_packet.Parse(packet->data));
+    sender_.AddPacketAndGenerateFec(rtp_packet);
+    fec_packets = sender_.GetFecPackets();
+  }
+  ASSERT_EQ(fec_packets.size(), 16u);
+  absl::optional<ReedSolomonFecHeader> header =
+      ReedSolomonFecHeader::Parse(fec_packets[0]->payload());
+  ASSERT_TRUE(header);
+  EXPECT_EQ(header->num_media_packets, ReedSolomonFecSender::kMaxMediaPackets);
+}
+
+TEST_F(ReedSolomonFecSenderTest, MaxPacketOverheadIsFecHeaderSize) {
+  EXPECT_EQ(sender_.MaxPacketOverhead(), ReedSolomonFecHeader::kSize);
+}
+
+TEST_F(ReedSolomonFecSenderTest, ContinuesSequenceNumbersFromRtpState) {
+  RtpState rtp_state;
+  rtp_state.sequence_number = 0xffff;
+  rtp_state.start_timestamp = 1000;
+  ReedSolomonFecSender sender(kFecPayloadType, kFecSsrc, kMediaSsrc, kNoMid,
+                              kNoRtpHeaderExtensions,
+                              kNoRtpHeaderExtensionSizes, &rtp_state, &clock_);
+  absl::optional<RtpState> state = sender.GetRtpState();
+  ASSERT_TRUE(state);
+  EXPECT_EQ(state->sequence_number, 0xffff);
+  EXPECT_EQ(state->start_timestamp, 1000u);
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -282,7 +282,8 @@ TransportFeedback::TransportFeedback(bool include_timestamps)
       feedback_seq_(0),
       include_timestamps_(include_timestamps),
       last_timestamp_(Timestamp::Zero()),
-      size_bytes_(kTransportFeedbackHeaderSizeBytes) {}
+      size_bytes_(kTransportFeedbackHeaderSizeBytes),
+      max_size_bytes_(kMaxSizeBytes) {}
 
 TransportFeedback::TransportFeedback(const TransportFeedback&) = default;
 
@@ -297,7 +298,8 @@ TransportFeedback::TransportFeedback(TransportFeedback&& other)
       all_packets_(std::move(other.all_packets_)),
       encoded_chunks_(std::move(other.encoded_chunks_)),
       last_chunk_(other.last_chunk_),
-      size_bytes_(other.size_bytes_) {
+      size_bytes_(other.size_bytes_),
+      max_size_bytes_(other.max_size_bytes_) {
   other.Clear();
 }
 
@@ -316,6 +318,11 @@ void TransportFeedback::SetFeedbackSequenceNumber(uint8_t feedback_sequence) {
   feedback_seq_ = feedback_sequence;
 }
 
+void TransportFeedback::SetMaxSize(size_t max_size_bytes) {
+  RTC_DCHECK_GE(max_size_bytes, size_bytes_);
+  max_size_bytes_ = std::min(max_size_bytes, kMaxSizeBytes) & ~size_t{3};
+}
+
 bool TransportFeedback::AddReceivedPacket(uint16_t sequence_number,
                                           Timestamp timestamp) {
   // Set delta to zero if timestamps are not included, this will simplify the
@@ -443,7 +450,8 @@ bool TransportFeedback::Parse(const CommonHeader& packet) {
     return false;
   }
 
-  std::vector<uint8_t> delta_sizes;
+  std::vector<DeltaSize>& delta_sizes = parsed_delta_sizes_;
+  delta_sizes.clear();
   delta_sizes.reserve(status_count);
   while (delta_sizes.size() < status_count) {
     if (index + kChunkSizeBytes > end_index) {
@@ -468,6 +476,7 @@ bool TransportFeedback::Parse(const CommonHeader& packet) {
 
   // Determine if timestamps, that is, recv_delta are included in the packet.
   if (end_index >= index + recv_delta_size) {
+    include_timestamps_ = true;
     for (size_t delta_size : delta_sizes) {
       RTC_DCHECK_LE(index + delta_size, end_index);
       switch (delta_size) {
@@ -681,7 +690,7 @@ bool TransportFeedback::AddDeltaSize(DeltaSize delta_size) {
   if (num_seq_no_ == kMaxReportedPackets)
     return false;
   size_t add_chunk_size = last_chunk_.Empty() ? kChunkSizeBytes : 0;
-  if (size_bytes_ + delta_size + add_chunk_size > kMaxSizeBytes)
+  if (size_bytes_ + delta_size + add_chunk_size > max_size_bytes_)
     return false;
 
   if (last_chunk_.CanAdd(delta_size)) {
@@ -690,7 +699,7 @@ bool TransportFeedback::AddDeltaSize(DeltaSize delta_size) {
     ++num_seq_no_;
     return true;
   }
-  if (size_bytes_ + delta_size + kChunkSizeBytes > kMaxSizeBytes)
+  if (size_bytes_ + delta_size + kChunkSizeBytes > max_size_bytes_)
     return false;
 
   encoded_chunks_.push_back(last_chunk_.Emit());
@@ -721,7 +730,7 @@ bool TransportFeedback::AddMissingPackets(size_t num_missing_packets) {
   size_t full_chunks = num_missing_packets / LastChunk::kMaxRunLengthCapacity;
   size_t partial_chunk = num_missing_packets % LastChunk::kMaxRunLengthCapacity;
   size_t num_chunks = full_chunks + (partial_chunk > 0 ? 1 : 0);
-  if (size_bytes_ + kChunkSizeBytes * num_chunks > kMaxSizeBytes) {
+  if (size_bytes_ + kChunkSizeBytes * num_chunks > max_size_bytes_) {
     num_seq_no_ = (new_num_seq_no - num_missing_packets);
     return false;
   }
@@ -63,6 +63,10 @@ class TransportFeedback : public Rtpfb {
                Timestamp ref_timestamp);  // Reference timestamp for this msg.
 
   void SetFeedbackSequenceNumber(uint8_t feedback_sequence);
+  // Limits the size of the packet, so that AddReceivedPacket fails once the
+  // next packet no longer fits. `max_size_bytes` is rounded down to a multiple
+  // of 32 bits and capped at the largest size the format allows.
+  void SetMaxSize(size_t max_size_bytes);
   // NOTE: This method requires increasing sequence numbers (excepting wraps).
   bool AddReceivedPacket(uint16_t sequence_number, Timestamp timestamp);
   const std::vector<ReceivedPacket>& GetReceivedPackets() const;
@@ -177,7 +181,11 @@ class TransportFeedback : public Rtpfb {
   // All but last encoded packet chunks.
   std::vector<uint16_t> encoded_chunks_;
   LastChunk last_chunk_;
+  // Delta sizes decoded by Parse(), kept so that parsing into the same object
+  // again reuses their storage.
+  std::vector<DeltaSize> parsed_delta_sizes_;
   size_t size_bytes_;
+  size_t max_size_bytes_;
 };
 
 }  // namespace rtcp
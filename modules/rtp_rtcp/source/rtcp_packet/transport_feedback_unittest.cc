@@ -456,9 +456,26 @@ TEST(RtcpPacketTest, TransportFeedbackLimits) {
   EXPECT_FALSE(packet->AddReceivedPacket(
       1, kBaseTime + kMaxNegativeTimeDelta - TransportFeedback::kDeltaTick));
   EXPECT_TRUE(packet->AddReceivedPacket(1, kBaseTime + kMaxNegativeTimeDelta));
+}
 
-  // TODO(sprang): Once we support max length lower than RTCP length limit,
-  // add back test for max size in bytes.
+TEST(RtcpPacketTest, TransportFeedbackMaxSize) {
+  constexpr size_t kMaxSize = 40;
+  TransportFeedback packet;
+  packet.SetMaxSize(kMaxSize);
+  packet.SetBase(0, Timestamp::Zero());
+  uint16_t sequence_number = 0;
+  while (packet.AddReceivedPacket(sequence_number, Timestamp::Zero())) {
+    ++sequence_number;
+  }
+  EXPECT_GT(sequence_number, 0);
+  EXPECT_LE(packet.BlockLength(), kMaxSize);
+  EXPECT_GT(packet.BlockLength(), kMaxSize - 4);
+
+  rtc::Buffer buffer = packet.Build();
+  std::unique_ptr<TransportFeedback> parsed =
+      TransportFeedback::ParseFrom(buffer.data(), buffer.size());
+  ASSERT_TRUE(parsed);
+  EXPECT_EQ(parsed->GetReceivedPackets().size(), sequence_number);
 }
 
 TEST(RtcpPacketTest, BaseTimeIsConsistentAcrossMultiplePackets) {
@@ -87,6 +87,14 @@ bool ResetTimestampIfExpired(const Timestamp now,
   return true;
 }
 
+// If a sender report is received but no DLRR, we need to reset the
+// roundTripTime stat according to the standard, see
+// https://www.w3.org/TR/webrtc-stats/#dom-rtcremoteoutboundrtpstreamstats-roundtriptime
+struct RtcpReceivedBlock {
+  bool sender_report = false;
+  bool dlrr = false;
+};
+
 }  // namespace
 
 constexpr size_t RTCPReceiver::RegisteredSsrcs::kMediaSsrcIndex;
@@ -140,6 +148,22 @@ struct RTCPReceiver::PacketInformation {
   std::unique_ptr<rtcp::LossNotification> loss_notification;
 };
 
+// The most frequent blocks of a compound packet, reports, NACK and transport
+// feedback, are parsed into these objects, whose vectors keep their capacity
+// from one packet to the next.
+struct RTCPReceiver::ParseScratch {
+  rtcp::SenderReport sender_report;
+  rtcp::ReceiverReport receiver_report;
+  rtcp::Nack nack;
+  std::unique_ptr<rtcp::TransportFeedback> transport_feedback;
+  // For each remote SSRC we store if we've received a sender report or a DLRR
+  // block.
+  flat_map<uint32_t, RtcpReceivedBlock> received_blocks;
+  // Swapped with the (empty) vectors of the PacketInformation being filled.
+  std::vector<uint16_t> nack_sequence_numbers;
+  std::vector<ReportBlockData> report_block_datas;
+};
+
 RTCPReceiver::RTCPReceiver(const RtpRtcpInterface::Configuration& config,
                            ModuleRtpRtcpImpl2* owner)
     : clock_(config.clock),
@@ -159,6 +183,7 @@ RTCPReceiver::RTCPReceiver(const RtpRtcpInterface::Configuration& config,
                                            : kDefaultVideoReportInterval)),
       // TODO(bugs.webrtc.org/10774): Remove fallback.
       remote_ssrc_(0),
+      parse_scratch_(std::make_unique<ParseScratch>()),
       xr_rrtr_status_(config.non_sender_rtt_measurement),
       oldest_tmmbr_info_(Timestamp::Zero()),
       cname_callback_(config.rtcp_cname_callback),
@@ -188,6 +213,7 @@ RTCPReceiver::RTCPReceiver(const RtpRtcpInterface::Configuration& config,
                                            : kDefaultVideoReportInterval)),
       // TODO(bugs.webrtc.org/10774): Remove fallback.
       remote_ssrc_(0),
+      parse_scratch_(std::make_unique<ParseScratch>()),
       xr_rrtr_status_(config.non_sender_rtt_measurement),
       oldest_tmmbr_info_(Timestamp::Zero()),
       cname_callback_(config.rtcp_cname_callback),
@@ -220,9 +246,24 @@ void RTCPReceiver::IncomingPacket(rtc::ArrayView<const uint8_t> packet) {
   }
 
   PacketInformation packet_information;
-  if (!ParseCompoundPacket(packet, &packet_information))
-    return;
-  TriggerCallbacksFromRtcpPacket(packet_information);
+  if (ParseCompoundPacket(packet, &packet_information))
+    TriggerCallbacksFromRtcpPacket(packet_information);
+  RecyclePacketInformation(packet_information);
+}
+
+void RTCPReceiver::RecyclePacketInformation(
+    PacketInformation& packet_information) {
+  packet_information.nack_sequence_numbers.clear();
+  packet_information.report_block_datas.clear();
+  MutexLock lock(&rtcp_receiver_lock_);
+  parse_scratch_->nack_sequence_numbers.swap(
+      packet_information.nack_sequence_numbers);
+  parse_scratch_->report_block_datas.swap(
+      packet_information.report_block_datas);
+  if (parse_scratch_->transport_feedback == nullptr) {
+    parse_scratch_->transport_feedback =
+        std::move(packet_information.transport_feedback);
+  }
 }
 
 // This method is only used by test and legacy code, so we should be able to
@@ -382,16 +423,13 @@ bool RTCPReceiver::ParseCompoundPacket(rtc::ArrayView<const uint8_t> packet,
   MutexLock lock(&rtcp_receiver_lock_);
 
   CommonHeader rtcp_block;
-  // If a sender report is received but no DLRR, we need to reset the
-  // roundTripTime stat according to the standard, see
-  // https://www.w3.org/TR/webrtc-stats/#dom-rtcremoteoutboundrtpstreamstats-roundtriptime
-  struct RtcpReceivedBlock {
-    bool sender_report = false;
-    bool dlrr = false;
-  };
-  // For each remote SSRC we store if we've received a sender report or a DLRR
-  // block.
-  flat_map<uint32_t, RtcpReceivedBlock> received_blocks;
+  flat_map<uint32_t, RtcpReceivedBlock>& received_blocks =
+      parse_scratch_->received_blocks;
+  received_blocks.clear();
+  packet_information->nack_sequence_numbers.swap(
+      parse_scratch_->nack_sequence_numbers);
+  packet_information->report_block_datas.swap(
+      parse_scratch_->report_block_datas);
   bool valid = true;
   for (const uint8_t* next_block = packet.begin();
        valid && next_block != packet.end();
@@ -516,7 +554,7 @@ bool RTCPReceiver::ParseCompoundPacket(rtc::ArrayView<const uint8_t> packet,
 
 bool RTCPReceiver::HandleSenderReport(const CommonHeader& rtcp_block,
                                       PacketInformation* packet_information) {
-  rtcp::SenderReport sender_report;
+  rtcp::SenderReport& sender_report = parse_scratch_->sender_report;
   if (!sender_report.Parse(rtcp_block)) {
     return false;
   }
@@ -553,7 +591,7 @@ bool RTCPReceiver::HandleSenderReport(const CommonHeader& rtcp_block,
 
 bool RTCPReceiver::HandleReceiverReport(const CommonHeader& rtcp_block,
                                         PacketInformation* packet_information) {
-  rtcp::ReceiverReport receiver_report;
+  rtcp::ReceiverReport& receiver_report = parse_scratch_->receiver_report;
   if (!receiver_report.Parse(rtcp_block)) {
     return false;
   }
@@ -733,7 +771,7 @@ bool RTCPReceiver::HandleSdes(const CommonHeader& rtcp_block,
 
 bool RTCPReceiver::HandleNack(const CommonHeader& rtcp_block,
                               PacketInformation* packet_information) {
-  rtcp::Nack nack;
+  rtcp::Nack& nack = parse_scratch_->nack;
   if (!nack.Parse(rtcp_block)) {
     return false;
   }
@@ -1046,8 +1084,11 @@ bool RTCPReceiver::HandleFir(const CommonHeader& rtcp_block,
 void RTCPReceiver::HandleTransportFeedback(
     const CommonHeader& rtcp_block,
     PacketInformation* packet_information) {
-  std::unique_ptr<rtcp::TransportFeedback> transport_feedback(
-      new rtcp::TransportFeedback());
+  std::unique_ptr<rtcp::TransportFeedback>& transport_feedback =
+      parse_scratch_->transport_feedback;
+  if (transport_feedback == nullptr) {
+    transport_feedback = std::make_unique<rtcp::TransportFeedback>();
+  }
   if (!transport_feedback->Parse(rtcp_block)) {
     ++num_skipped_packets_;
     // Application layer feedback message doesn't have a standard format.
@@ -13,6 +13,7 @@
 
 #include <list>
 #include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -198,6 +199,7 @@ class RTCPReceiver final {
   };
 
   struct PacketInformation;
+  struct ParseScratch;
 
   // Structure for handing TMMBR and TMMBN rtcp messages (RFC5104,
   // section 3.5.4).
@@ -261,6 +263,10 @@ class RTCPReceiver final {
   void TriggerCallbacksFromRtcpPacket(
       const PacketInformation& packet_information);
 
+  // Returns the storage of `packet_information` to `parse_scratch_`, so that
+  // the next packet can be parsed without allocating.
+  void RecyclePacketInformation(PacketInformation& packet_information);
+
   TmmbrInformation* FindOrCreateTmmbrInfo(uint32_t remote_ssrc)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(rtcp_receiver_lock_);
   // Update TmmbrInformation (if present) is alive.
@@ -369,6 +375,10 @@ class RTCPReceiver final {
   mutable Mutex rtcp_receiver_lock_;
   uint32_t remote_ssrc_ RTC_GUARDED_BY(rtcp_receiver_lock_);
 
+  // Parsed packets and output buffers reused across incoming packets.
+  const std::unique_ptr<ParseScratch> parse_scratch_
+      RTC_GUARDED_BY(rtcp_receiver_lock_);
+
   // Received sender report.
   RtpRtcpInterface::SenderReportStats remote_sender_
       RTC_GUARDED_BY(rtcp_receiver_lock_);
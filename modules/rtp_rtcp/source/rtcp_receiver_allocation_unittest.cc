@@ -0,0 +1,207 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Counts heap allocations made while RTCPReceiver handles incoming packets.
+// This replaces the global operator new, so it is built as a test binary of
+// its own.
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include "api/array_view.h"
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "modules/rtp_rtcp/include/report_block_data.h"
+#include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/common_header.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/compound_packet.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/nack.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/receiver_report.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/report_block.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/transport_feedback.h"
+#include "modules/rtp_rtcp/source/rtcp_receiver.h"
+#include "modules/rtp_rtcp/source/rtp_rtcp_interface.h"
+#include "rtc_base/buffer.h"
+#include "system_wrappers/include/clock.h"
+#include "test/gtest.h"
+
+namespace {
+
+std::atomic<int64_t> g_allocations{0};
+
+void* CountedAllocation(std::size_t size) {
+  g_allocations.fetch_add(1, std::memory_order_relaxed);
+  void* ptr = std::malloc(size == 0 ? 1 : size);
+  if (ptr == nullptr) {
+    std::abort();
+  }
+  return ptr;
+}
+
+}  // namespace
+
+void* operator new(std::size_t size) {
+  return CountedAllocation(size);
+}
+
+void* operator new[](std::size_t size) {
+  return CountedAllocation(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+  return CountedAllocation(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+  return CountedAllocation(size);
+}
+
+void operator delete(void* ptr) noexcept {
+  std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+  std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+  std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept {
+  std::free(ptr);
+}
+
+namespace webrtc {
+namespace {
+
+constexpr uint32_t kRemoteSsrc = 0x1000;
+constexpr uint32_t kLocalSsrc = 0x2000;
+constexpr int kTransportFeedbackPackets = 60;
+
+// Number of heap allocations made on any thread since the object was created.
+class AllocationCounter {
+ public:
+  AllocationCounter() : start_(g_allocations.load()) {}
+  int64_t count() const { return g_allocations.load() - start_; }
+
+ private:
+  const int64_t start_;
+};
+
+class NullModuleRtpRtcp : public RTCPReceiver::ModuleRtpRtcp {
+ public:
+  void SetTmmbn(std::vector<rtcp::TmmbItem> bounding_set) override {}
+  void OnRequestSendReport() override {}
+  void OnReceivedNack(
+      const std::vector<uint16_t>& nack_sequence_numbers) override {}
+  void OnReceivedRtcpReportBlocks(
+      rtc::ArrayView<const ReportBlockData> report_blocks) override {}
+};
+
+std::unique_ptr<rtcp::TransportFeedback> CreateTransportFeedback(
+    uint16_t base_sequence_number,
+    Timestamp base_time) {
+  auto feedback = std::make_unique<rtcp::TransportFeedback>();
+  feedback->SetSenderSsrc(kRemoteSsrc);
+  feedback->SetMediaSsrc(kLocalSsrc);
+  feedback->SetBase(base_sequence_number, base_time);
+  for (int i = 0; i < kTransportFeedbackPackets; ++i) {
+    // Every 20th packet is lost.
+    if (i % 20 != 19) {
+      feedback->AddReceivedPacket(base_sequence_number + i,
+                                  base_time + TimeDelta::Micros(1500 * i));
+    }
+  }
+  return feedback;
+}
+
+// Compound packets with a receiver report, transport feedback and a NACK.
+std::vector<rtc::Buffer> CompoundPackets(int count) {
+  std::vector<rtc::Buffer> packets;
+  for (int i = 0; i < count; ++i) {
+    rtcp::CompoundPacket compound;
+    auto receiver_report = std::make_unique<rtcp::ReceiverReport>();
+    receiver_report->SetSenderSsrc(kRemoteSsrc);
+    rtcp::ReportBlock report_block;
+    report_block.SetMediaSsrc(kLocalSsrc);
+    report_block.SetExtHighestSeqNum(1000 * i);
+    receiver_report->AddReportBlock(report_block);
+    compound.Append(std::move(receiver_report));
+
+    const uint16_t base = kTransportFeedbackPackets * i;
+    compound.Append(CreateTransportFeedback(base, Timestamp::Millis(100 * i)));
+
+    auto nack = std::make_unique<rtcp::Nack>();
+    nack->SetSenderSsrc(kRemoteSsrc);
+    nack->SetMediaSsrc(kLocalSsrc);
+    const uint16_t nacked[] = {static_cast<uint16_t>(base + 19),
+                               static_cast<uint16_t>(base + 39)};
+    nack->SetPacketIds(nacked, 2);
+    compound.Append(std::move(nack));
+    packets.push_back(compound.Build());
+  }
+  return packets;
+}
+
+TEST(TransportFeedbackAllocationTest, ParsingAgainReusesStorage) {
+  const rtc::Buffer first =
+      CreateTransportFeedback(0, Timestamp::Millis(100))->Build();
+  const rtc::Buffer second =
+      CreateTransportFeedback(kTransportFeedbackPackets, Timestamp::Millis(200))
+          ->Build();
+  rtcp::CommonHeader first_header;
+  rtcp::CommonHeader second_header;
+  ASSERT_TRUE(first_header.Parse(first.data(), first.size()));
+  ASSERT_TRUE(second_header.Parse(second.data(), second.size()));
+
+  rtcp::TransportFeedback feedback;
+  ASSERT_TRUE(feedback.Parse(first_header));
+
+  AllocationCounter allocations;
+  ASSERT_TRUE(feedback.Parse(second_header));
+  EXPECT_EQ(allocations.count(), 0);
+  EXPECT_EQ(feedback.GetBaseSequence(), kTransportFeedbackPackets);
+  EXPECT_EQ(feedback.GetReceivedPackets().size(), 57u);
+}
+
+TEST(RtcpReceiverAllocationTest, SteadyStateCompoundPacketsDoNotAllocate) {
+  SimulatedClock clock(Timestamp::Seconds(1000));
+  NullModuleRtpRtcp rtp_rtcp;
+  NetworkLinkRtcpObserver network_link_rtcp_observer;
+  RtpRtcpInterface::Configuration config;
+  config.clock = &clock;
+  config.network_link_rtcp_observer = &network_link_rtcp_observer;
+  config.local_media_ssrc = kLocalSsrc;
+  RTCPReceiver receiver(config, &rtp_rtcp);
+  receiver.SetRemoteSSRC(kRemoteSsrc);
+  const std::vector<rtc::Buffer> packets = CompoundPackets(20);
+
+  // Let the reused storage grow to its steady-state size.
+  for (int i = 0; i < 10; ++i) {
+    receiver.IncomingPacket(packets[i]);
+    clock.AdvanceTime(TimeDelta::Millis(100));
+  }
+
+  AllocationCounter allocations;
+  for (int i = 10; i < 20; ++i) {
+    receiver.IncomingPacket(packets[i]);
+    clock.AdvanceTime(TimeDelta::Millis(100));
+  }
+  EXPECT_EQ(allocations.count(), 0);
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -0,0 +1,140 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "api/array_view.h"
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "benchmark/benchmark.h"
+#include "modules/rtp_rtcp/include/report_block_data.h"
+#include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/compound_packet.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/nack.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/receiver_report.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/report_block.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/sdes.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/sender_report.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/transport_feedback.h"
+#include "modules/rtp_rtcp/source/rtcp_receiver.h"
+#include "modules/rtp_rtcp/source/rtp_rtcp_interface.h"
+#include "rtc_base/buffer.h"
+#include "system_wrappers/include/clock.h"
+
+namespace webrtc {
+namespace {
+
+constexpr uint32_t kRemoteSsrc = 0x1000;
+constexpr uint32_t kLocalSsrcs[] = {0x2000, 0x2001, 0x2002};
+constexpr int kReportBlocks = 3;
+constexpr int kTransportFeedbackPackets = 60;
+constexpr int kNackEvery = 5;
+constexpr int kSenderReportEvery = 10;
+
+class NullModuleRtpRtcp : public RTCPReceiver::ModuleRtpRtcp {
+ public:
+  void SetTmmbn(std::vector<rtcp::TmmbItem> bounding_set) override {}
+  void OnRequestSendReport() override {}
+  void OnReceivedNack(
+      const std::vector<uint16_t>& nack_sequence_numbers) override {}
+  void OnReceivedRtcpReportBlocks(
+      rtc::ArrayView<const ReportBlockData> report_blocks) override {}
+};
+
+// Compound packets as a video receiver sends them to a simulcast sender:
+// a receiver report, or now and then a sender report, with one report block
+// per simulcast layer, a CNAME, transport feedback and now and then a NACK.
+std::vector<rtc::Buffer> CompoundPacketTrace() {
+  std::vector<rtc::Buffer> packets;
+  uint16_t transport_sequence_number = 0;
+  for (int i = 0; i < 100; ++i) {
+    rtcp::CompoundPacket compound;
+    std::vector<rtcp::ReportBlock> report_blocks(kReportBlocks);
+    for (int j = 0; j < kReportBlocks; ++j) {
+      report_blocks[j].SetMediaSsrc(kLocalSsrcs[j]);
+      report_blocks[j].SetExtHighestSeqNum(1000 * i);
+      report_blocks[j].SetJitter(j);
+    }
+    if (i % kSenderReportEvery == 0) {
+      auto sender_report = std::make_unique<rtcp::SenderReport>();
+      sender_report->SetSenderSsrc(kRemoteSsrc);
+      sender_report->SetReportBlocks(std::move(report_blocks));
+      compound.Append(std::move(sender_report));
+    } else {
+      auto receiver_report = std::make_unique<rtcp::ReceiverReport>();
+      receiver_report->SetSenderSsrc(kRemoteSsrc);
+      receiver_report->SetReportBlocks(std::move(report_blocks));
+      compound.Append(std::move(receiver_report));
+    }
+
+    auto sdes = std::make_unique<rtcp::Sdes>();
+    sdes->AddCName(kRemoteSsrc, "remote@cname");
+    compound.Append(std::move(sdes));
+
+    auto transport_feedback = std::make_unique<rtcp::TransportFeedback>();
+    transport_feedback->SetSenderSsrc(kRemoteSsrc);
+    transport_feedback->SetMediaSsrc(kLocalSsrcs[0]);
+    transport_feedback->SetBase(transport_sequence_number,
+                                Timestamp::Millis(100 * i));
+    for (int j = 0; j < kTransportFeedbackPackets; ++j) {
+      // Every 20th packet is lost.
+      if (j % 20 != 19) {
+        transport_feedback->AddReceivedPacket(
+            transport_sequence_number,
+            Timestamp::Millis(100 * i) + TimeDelta::Micros(1500 * j));
+      }
+      ++transport_sequence_number;
+    }
+    compound.Append(std::move(transport_feedback));
+
+    if (i % kNackEvery == 0) {
+      auto nack = std::make_unique<rtcp::Nack>();
+      nack->SetSenderSsrc(kRemoteSsrc);
+      nack->SetMediaSsrc(kLocalSsrcs[0]);
+      const uint16_t nacked[] = {static_cast<uint16_t>(30 * i),
+                                 static_cast<uint16_t>(30 * i + 2),
+                                 static_cast<uint16_t>(30 * i + 3)};
+      nack->SetPacketIds(nacked, 3);
+      compound.Append(std::move(nack));
+    }
+    packets.push_back(compound.Build());
+  }
+  return packets;
+}
+
+void BM_IncomingCompoundPackets(benchmark::State& state) {
+  SimulatedClock clock(Timestamp::Seconds(1000));
+  NullModuleRtpRtcp rtp_rtcp;
+  NetworkLinkRtcpObserver network_link_rtcp_observer;
+  RtpRtcpInterface::Configuration config;
+  config.clock = &clock;
+  config.network_link_rtcp_observer = &network_link_rtcp_observer;
+  config.local_media_ssrc = kLocalSsrcs[0];
+  config.rtx_send_ssrc = kLocalSsrcs[1];
+  RTCPReceiver receiver(config, &rtp_rtcp);
+  receiver.SetRemoteSSRC(kRemoteSsrc);
+  const std::vector<rtc::Buffer> packets = CompoundPacketTrace();
+
+  for (auto _ : state) {
+    for (const rtc::Buffer& packet : packets) {
+      receiver.IncomingPacket(packet);
+    }
+    clock.AdvanceTime(TimeDelta::Millis(100));
+  }
+  state.SetItemsProcessed(state.iterations() * packets.size());
+}
+
+BENCHMARK(BM_IncomingCompoundPackets);
+
+}  // namespace
+}  // namespace webrtc
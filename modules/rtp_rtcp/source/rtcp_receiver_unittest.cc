@@ -1743,6 +1743,44 @@ TEST(RtcpReceiverTest, NotifiesNetworkLinkObserverOnTransportFeedback) {
   receiver.IncomingPacket(packet.Build());
 }
 
+TEST(RtcpReceiverTest, ParsesEachTransportFeedbackIndependently) {
+  ReceiverMocks mocks;
+  RtpRtcpInterface::Configuration config = DefaultConfiguration(&mocks);
+  RTCPReceiver receiver(config, &mocks.rtp_rtcp_impl);
+  receiver.SetRemoteSSRC(kSenderSsrc);
+
+  rtcp::TransportFeedback without_timestamps(/*include_timestamps=*/false);
+  without_timestamps.SetMediaSsrc(config.local_media_ssrc);
+  without_timestamps.SetSenderSsrc(kSenderSsrc);
+  without_timestamps.SetBase(1, Timestamp::Millis(1));
+  without_timestamps.AddReceivedPacket(1, Timestamp::Millis(1));
+  without_timestamps.AddReceivedPacket(3, Timestamp::Millis(1));
+
+  rtcp::TransportFeedback with_timestamps;
+  with_timestamps.SetMediaSsrc(config.local_media_ssrc);
+  with_timestamps.SetSenderSsrc(kSenderSsrc);
+  with_timestamps.SetBase(10, Timestamp::Millis(1));
+  with_timestamps.AddReceivedPacket(10, Timestamp::Millis(1));
+
+  InSequence s;
+  EXPECT_CALL(
+      mocks.network_link_rtcp_observer,
+      OnTransportFeedback(
+          _, AllOf(Property(&rtcp::TransportFeedback::IncludeTimestamps, false),
+                   Property(&rtcp::TransportFeedback::GetReceivedPackets,
+                            SizeIs(2)))));
+  EXPECT_CALL(
+      mocks.network_link_rtcp_observer,
+      OnTransportFeedback(
+          _, AllOf(Property(&rtcp::TransportFeedback::IncludeTimestamps, true),
+                   Property(&rtcp::TransportFeedback::GetBaseSequence, 10),
+                   Property(&rtcp::TransportFeedback::GetReceivedPackets,
+                            SizeIs(1)))));
+
+  receiver.IncomingPacket(without_timestamps.Build());
+  receiver.IncomingPacket(with_timestamps.Build());
+}
+
 TEST(RtcpReceiverTest, NotifiesNetworkLinkObserverOnCongestionControlFeedback) {
   ScopedKeyValueConfig trials(
       "WebRTC-RFC8888CongestionControlFeedback/Enabled/");
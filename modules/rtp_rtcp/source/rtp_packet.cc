@@ -10,6 +10,7 @@
 
 #include "modules/rtp_rtcp/source/rtp_packet.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <cstring>
 #include <utility>
@@ -92,7 +93,12 @@ bool RtpPacket::Parse(rtc::ArrayView<const uint8_t> packet) {
 }
 
 bool RtpPacket::Parse(rtc::CopyOnWriteBuffer buffer) {
-  if (!ParseBuffer(buffer.cdata(), buffer.size())) {
+  return Parse(std::move(buffer), /*layout_cache=*/nullptr);
+}
+
+bool RtpPacket::Parse(rtc::CopyOnWriteBuffer buffer,
+                      ExtensionLayoutCache* layout_cache) {
+  if (!ParseBuffer(buffer.cdata(), buffer.size(), layout_cache)) {
     Clear();
     return false;
   }
@@ -129,6 +135,14 @@ void RtpPacket::CopyHeaderFrom(const RtpPacket& packet) {
   padding_size_ = 0;
 }
 
+void RtpPacket::UnshareBuffer(rtc::CopyOnWriteBuffer storage) {
+  // Clear first, so that growing `storage` does not copy its old contents.
+  storage.Clear();
+  storage.EnsureCapacity(capacity());
+  storage.AppendData(data(), size());
+  buffer_ = std::move(storage);
+}
+
 void RtpPacket::SetMarker(bool marker_bit) {
   marker_ = marker_bit;
   if (marker_) {
@@ -442,7 +456,9 @@ void RtpPacket::Clear() {
   WriteAt(0, kRtpVersion << 6);
 }
 
-bool RtpPacket::ParseBuffer(const uint8_t* buffer, size_t size) {
+bool RtpPacket::ParseBuffer(const uint8_t* buffer,
+                            size_t size,
+                            ExtensionLayoutCache* layout_cache) {
   if (size < kFixedHeaderSize) {
     return false;
   }
@@ -496,49 +512,67 @@ bool RtpPacket::ParseBuffer(const uint8_t* buffer, size_t size) {
       size_t extension_header_length = profile == kOneByteExtensionProfileId
                                            ? kOneByteExtensionHeaderLength
                                            : kTwoByteExtensionHeaderLength;
-      constexpr uint8_t kPaddingByte = 0;
-      constexpr uint8_t kPaddingId = 0;
-      constexpr uint8_t kOneByteHeaderExtensionReservedId = 15;
-      while (extensions_size_ + extension_header_length < extensions_capacity) {
-        if (buffer[extension_offset + extensions_size_] == kPaddingByte) {
-          extensions_size_++;
-          continue;
-        }
-        int id;
-        uint8_t length;
-        if (profile == kOneByteExtensionProfileId) {
-          id = buffer[extension_offset + extensions_size_] >> 4;
-          length = 1 + (buffer[extension_offset + extensions_size_] & 0xf);
-          if (id == kOneByteHeaderExtensionReservedId ||
-              (id == kPaddingId && length != 1)) {
+      const ExtensionLayoutCache::Layout* layout =
+          layout_cache != nullptr
+              ? layout_cache->Find(profile, extension_offset,
+                                   &buffer[extension_offset],
+                                   extensions_capacity)
+              : nullptr;
+      if (layout != nullptr) {
+        extension_entries_ = layout->entries;
+        extensions_size_ = layout->extensions_size;
+      } else {
+        constexpr uint8_t kPaddingByte = 0;
+        constexpr uint8_t kPaddingId = 0;
+        constexpr uint8_t kOneByteHeaderExtensionReservedId = 15;
+        while (extensions_size_ + extension_header_length <
+               extensions_capacity) {
+          if (buffer[extension_offset + extensions_size_] == kPaddingByte) {
+            extensions_size_++;
+            continue;
+          }
+          int id;
+          uint8_t length;
+          if (profile == kOneByteExtensionProfileId) {
+            id = buffer[extension_offset + extensions_size_] >> 4;
+            length = 1 + (buffer[extension_offset + extensions_size_] & 0xf);
+            if (id == kOneByteHeaderExtensionReservedId ||
+                (id == kPaddingId && length != 1)) {
+              break;
+            }
+          } else {
+            id = buffer[extension_offset + extensions_size_];
+            length = buffer[extension_offset + extensions_size_ + 1];
+          }
+
+          if (extensions_size_ + extension_header_length + length >
+              extensions_capacity) {
+            RTC_LOG(LS_WARNING) << "Oversized rtp header extension.";
             break;
           }
-        } else {
-          id = buffer[extension_offset + extensions_size_];
-          length = buffer[extension_offset + extensions_size_ + 1];
-        }
 
-        if (extensions_size_ + extension_header_length + length >
-            extensions_capacity) {
-          RTC_LOG(LS_WARNING) << "Oversized rtp header extension.";
-          break;
-        }
+          ExtensionInfo& extension_info = FindOrCreateExtensionInfo(id);
+          if (extension_info.length != 0) {
+            RTC_LOG(LS_VERBOSE) << "Duplicate rtp header extension id " << id
+                                << ". Overwriting.";
+          }
 
-        ExtensionInfo& extension_info = FindOrCreateExtensionInfo(id);
-        if (extension_info.length != 0) {
-          RTC_LOG(LS_VERBOSE)
-              << "Duplicate rtp header extension id " << id << ". Overwriting.";
+          size_t offset =
+              extension_offset + extensions_size_ + extension_header_length;
+          if (!rtc::IsValueInRangeForNumericType<uint16_t>(offset)) {
+            RTC_DLOG(LS_WARNING) << "Oversized rtp header extension.";
+            break;
+          }
+          extension_info.offset = static_cast<uint16_t>(offset);
+          extension_info.length = length;
+          extensions_size_ += extension_header_length + length;
         }
-
-        size_t offset =
-            extension_offset + extensions_size_ + extension_header_length;
-        if (!rtc::IsValueInRangeForNumericType<uint16_t>(offset)) {
-          RTC_DLOG(LS_WARNING) << "Oversized rtp header extension.";
-          break;
+        if (layout_cache != nullptr) {
+          layout_cache->Add(profile, extension_offset,
+                            &buffer[extension_offset], extensions_capacity,
+                            extensions_size_, extension_header_length,
+                            extension_entries_);
         }
-        extension_info.offset = static_cast<uint16_t>(offset);
-        extension_info.length = length;
-        extensions_size_ += extension_header_length + length;
       }
     }
     payload_offset_ = extension_offset + extensions_capacity;
@@ -561,6 +595,69 @@ bool RtpPacket::ParseBuffer(const uint8_t* buffer, size_t size) {
   return true;
 }
 
+RtpPacket::ExtensionLayoutCache::ExtensionLayoutCache() = default;
+RtpPacket::ExtensionLayoutCache::~ExtensionLayoutCache() = default;
+
+RtpPacket::ExtensionLayoutCache::Layout::Layout() = default;
+RtpPacket::ExtensionLayoutCache::Layout::~Layout() = default;
+
+const RtpPacket::ExtensionLayoutCache::Layout*
+RtpPacket::ExtensionLayoutCache::Find(uint16_t profile,
+                                      size_t extensions_offset,
+                                      const uint8_t* extensions,
+                                      size_t extensions_capacity) const {
+  for (const Layout& layout : layouts_) {
+    if (layout.extensions_capacity != extensions_capacity ||
+        layout.extensions_offset != extensions_offset ||
+        layout.profile != profile) {
+      continue;
+    }
+    // Compares the whole block without branching, so that it vectorizes.
+    uint8_t difference = 0;
+    for (size_t i = 0; i < extensions_capacity; ++i) {
+      difference |= (extensions[i] & layout.mask[i]) ^ layout.expected[i];
+    }
+    if (difference == 0) {
+      return &layout;
+    }
+  }
+  return nullptr;
+}
+
+void RtpPacket::ExtensionLayoutCache::Add(
+    uint16_t profile,
+    size_t extensions_offset,
+    const uint8_t* extensions,
+    size_t extensions_capacity,
+    size_t extensions_size,
+    size_t extension_header_length,
+    const std::vector<ExtensionInfo>& entries) {
+  if (extensions_capacity > kMaxExtensionsSize) {
+    return;
+  }
+  Layout& layout = layouts_[next_layout_];
+  next_layout_ = (next_layout_ + 1) % kMaxLayouts;
+  layout.profile = profile;
+  layout.extensions_offset = extensions_offset;
+  layout.extensions_capacity = extensions_capacity;
+  layout.extensions_size = extensions_size;
+  // The parser read every byte up to the header of the extension following
+  // the last one, except for the extension values.
+  layout.mask.fill(0);
+  std::fill_n(layout.mask.begin(),
+              std::min(extensions_size + extension_header_length,
+                       extensions_capacity),
+              0xff);
+  for (const ExtensionInfo& entry : entries) {
+    std::fill_n(layout.mask.begin() + (entry.offset - extensions_offset),
+                entry.length, 0);
+  }
+  for (size_t i = 0; i < extensions_capacity; ++i) {
+    layout.expected[i] = extensions[i] & layout.mask[i];
+  }
+  layout.entries = entries;
+}
+
 const RtpPacket::ExtensionInfo* RtpPacket::FindExtensionInfo(int id) const {
   for (const ExtensionInfo& extension : extension_entries_) {
     if (extension.id == id) {
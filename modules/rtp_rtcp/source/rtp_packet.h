@@ -10,6 +10,7 @@
 #ifndef MODULES_RTP_RTCP_SOURCE_RTP_PACKET_H_
 #define MODULES_RTP_RTCP_SOURCE_RTP_PACKET_H_
 
+#include <array>
 #include <string>
 #include <utility>
 #include <vector>
@@ -54,6 +55,14 @@ class RtpPacket {
   // Parse and move given buffer into Packet.
   bool Parse(rtc::CopyOnWriteBuffer packet);
 
+  class ExtensionLayoutCache;
+
+  // Same as above, but reuses the header extension layout of a packet parsed
+  // before with `layout_cache` if this packet has the same layout, as is
+  // usually the case for packets of the same stream. This saves walking the
+  // header extensions one by one.
+  bool Parse(rtc::CopyOnWriteBuffer packet, ExtensionLayoutCache* layout_cache);
+
   // Maps extensions id to their types.
   void IdentifyExtensions(ExtensionManager extensions);
 
@@ -167,6 +176,12 @@ class RtpPacket {
   // Returns debug string of RTP packet (without detailed extension info).
   std::string ToString() const;
 
+ protected:
+  // Copies the contents of the packet into `storage` and makes that the buffer
+  // of the packet, so that it is no longer shared with copies of the packet.
+  // The memory of `storage` is reused if it is not shared and large enough.
+  void UnshareBuffer(rtc::CopyOnWriteBuffer storage);
+
  private:
   struct ExtensionInfo {
     explicit ExtensionInfo(uint8_t id) : ExtensionInfo(id, 0, 0) {}
@@ -179,7 +194,9 @@ class RtpPacket {
 
   // Helper function for Parse. Fill header fields using data in given buffer,
   // but does not touch packet own buffer, leaving packet in invalid state.
-  bool ParseBuffer(const uint8_t* buffer, size_t size);
+  bool ParseBuffer(const uint8_t* buffer,
+                   size_t size,
+                   ExtensionLayoutCache* layout_cache = nullptr);
 
   // Returns pointer to extension info for a given id. Returns nullptr if not
   // found.
@@ -221,6 +238,63 @@ class RtpPacket {
   rtc::CopyOnWriteBuffer buffer_;
 };
 
+// Remembers the layout of the header extensions of the last few packets parsed
+// with it: the bytes that the generic parser reads, i.e. the extension ids,
+// lengths and padding, and where each extension was found. A new packet whose
+// extension block has the same size and the same bytes at those positions has
+// the same extensions at the same offsets.
+class RtpPacket::ExtensionLayoutCache {
+ public:
+  // Number of layouts kept, e.g. one each for the audio, video and RTX streams
+  // of a transport.
+  static constexpr size_t kMaxLayouts = 4;
+  // Layouts of larger extension blocks are not cached.
+  static constexpr size_t kMaxExtensionsSize = 64;
+
+  ExtensionLayoutCache();
+  ExtensionLayoutCache(const ExtensionLayoutCache&) = delete;
+  ExtensionLayoutCache& operator=(const ExtensionLayoutCache&) = delete;
+  ~ExtensionLayoutCache();
+
+ private:
+  friend class RtpPacket;
+
+  struct Layout {
+    Layout();
+    Layout(const Layout&) = delete;
+    Layout& operator=(const Layout&) = delete;
+    ~Layout();
+
+    uint16_t profile = 0;
+    // Offset and size of the extension block, zero if the layout is unused.
+    size_t extensions_offset = 0;
+    size_t extensions_capacity = 0;
+    size_t extensions_size = 0;
+    // Bits of the extension block the parser reads, and their expected value.
+    std::array<uint8_t, kMaxExtensionsSize> mask;
+    std::array<uint8_t, kMaxExtensionsSize> expected;
+    std::vector<ExtensionInfo> entries;
+  };
+
+  // Returns the layout matching the given extension block, if any.
+  const Layout* Find(uint16_t profile,
+                     size_t extensions_offset,
+                     const uint8_t* extensions,
+                     size_t extensions_capacity) const;
+  // Adds the layout of the given extension block, replacing the oldest one.
+  // `extensions_size` and `entries` are as found by the parser.
+  void Add(uint16_t profile,
+           size_t extensions_offset,
+           const uint8_t* extensions,
+           size_t extensions_capacity,
+           size_t extensions_size,
+           size_t extension_header_length,
+           const std::vector<ExtensionInfo>& entries);
+
+  std::array<Layout, kMaxLayouts> layouts_;
+  size_t next_layout_ = 0;
+};
+
 template <typename Extension>
 bool RtpPacket::HasExtension() const {
   return HasExtension(Extension::kId);
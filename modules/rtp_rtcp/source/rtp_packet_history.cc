@@ -29,6 +29,14 @@ namespace {
 constexpr size_t kOldPayloadPaddingSizeHysteresis = 100;
 constexpr uint16_t kMaxOldPayloadPaddingSequenceNumber = 1 << 13;
 
+size_t RingSizeFor(size_t num_entries) {
+  size_t ring_size = 1;
+  while (ring_size < num_entries) {
+    ring_size *= 2;
+  }
+  return ring_size;
+}
+
 }  // namespace
 
 RtpPacketHistory::StoredPacket::StoredPacket(
@@ -50,12 +58,17 @@ void RtpPacketHistory::StoredPacket::IncrementTimesRetransmitted() {
   ++times_retransmitted_;
 }
 
-RtpPacketHistory::RtpPacketHistory(Clock* clock, PaddingMode padding_mode)
+RtpPacketHistory::RtpPacketHistory(Clock* clock,
+                                   PaddingMode padding_mode,
+                                   RtpPacketToSendPool* packet_pool)
     : clock_(clock),
       padding_mode_(padding_mode),
+      packet_pool_(packet_pool),
       number_to_store_(0),
       mode_(StorageMode::kDisabled),
       rtt_(TimeDelta::MinusInfinity()),
+      first_entry_(0),
+      num_entries_(0),
       packets_inserted_(0) {}
 
 RtpPacketHistory::~RtpPacketHistory() {}
@@ -70,6 +83,12 @@ void RtpPacketHistory::SetStorePacketsStatus(StorageMode mode,
   Reset();
   mode_ = mode;
   number_to_store_ = std::min(kMaxCapacity, number_to_store);
+  if (mode_ == StorageMode::kDisabled) {
+    packet_history_ = std::vector<StoredPacket>();
+  } else {
+    packet_history_.resize(std::max(packet_history_.size(),
+                                    RingSizeFor(number_to_store_)));
+  }
 }
 
 RtpPacketHistory::StorageMode RtpPacketHistory::GetStorageMode() const {
@@ -94,6 +113,7 @@ void RtpPacketHistory::PutRtpPacket(std::unique_ptr<RtpPacketToSend> packet,
   RTC_DCHECK(packet);
   MutexLock lock(&lock_);
   if (mode_ == StorageMode::kDisabled) {
+    ReleasePacket(std::move(packet));
     return;
   }
 
@@ -103,27 +123,38 @@ void RtpPacketHistory::PutRtpPacket(std::unique_ptr<RtpPacketToSend> packet,
   // Store packet.
   const uint16_t rtp_seq_no = packet->SequenceNumber();
   int packet_index = GetPacketIndex(rtp_seq_no);
-  if (packet_index >= 0 &&
-      static_cast<size_t>(packet_index) < packet_history_.size() &&
-      packet_history_[packet_index].packet_ != nullptr) {
+  if (packet_index >= 0 && static_cast<size_t>(packet_index) < num_entries_ &&
+      Entry(packet_index).packet_ != nullptr) {
     RTC_LOG(LS_WARNING) << "Duplicate packet inserted: " << rtp_seq_no;
     // Remove previous packet to avoid inconsistent state.
     RemovePacket(packet_index);
     packet_index = GetPacketIndex(rtp_seq_no);
   }
 
-  // Packet to be inserted ahead of first packet, expand front.
-  for (; packet_index < 0; ++packet_index) {
-    packet_history_.emplace_front();
-  }
-  // Packet to be inserted behind last packet, expand back.
-  while (static_cast<int>(packet_history_.size()) <= packet_index) {
-    packet_history_.emplace_back();
+  if (packet_index < 0) {
+    // Packet to be inserted ahead of first packet, expand front.
+    if (!Reserve(num_entries_ - packet_index)) {
+      RTC_LOG(LS_WARNING) << "Packet too old to be stored: " << rtp_seq_no;
+      ReleasePacket(std::move(packet));
+      return;
+    }
+    first_entry_ = (first_entry_ + packet_index) & (packet_history_.size() - 1);
+    num_entries_ -= packet_index;
+    packet_index = 0;
+  } else if (static_cast<size_t>(packet_index) >= num_entries_) {
+    // Packet to be inserted behind last packet, expand back. Remove the oldest
+    // packets if the sequence number jumped too far ahead to keep them.
+    while (static_cast<size_t>(packet_index) >= kMaxRingSize) {
+      RemovePacket(0);
+      packet_index = GetPacketIndex(rtp_seq_no);
+    }
+    Reserve(packet_index + 1);
+    num_entries_ = packet_index + 1;
   }
 
   RTC_DCHECK_GE(packet_index, 0);
-  RTC_DCHECK_LT(packet_index, packet_history_.size());
-  RTC_DCHECK(packet_history_[packet_index].packet_ == nullptr);
+  RTC_DCHECK_LT(packet_index, num_entries_);
+  RTC_DCHECK(Entry(packet_index).packet_ == nullptr);
 
   if (padding_mode_ == PaddingMode::kRecentLargePacket) {
     if ((!large_payload_packet_ ||
@@ -136,7 +167,7 @@ void RtpPacketHistory::PutRtpPacket(std::unique_ptr<RtpPacketToSend> packet,
     }
   }
 
-  packet_history_[packet_index] =
+  Entry(packet_index) =
       StoredPacket(std::move(packet), send_time, packets_inserted_++);
 }
 
@@ -152,31 +183,46 @@ std::unique_ptr<RtpPacketToSend> RtpPacketHistory::GetPacketAndMarkAsPending(
     uint16_t sequence_number,
     rtc::FunctionView<std::unique_ptr<RtpPacketToSend>(const RtpPacketToSend&)>
         encapsulate) {
-  MutexLock lock(&lock_);
-  if (mode_ == StorageMode::kDisabled) {
-    return nullptr;
-  }
+  absl::optional<RtpPacketToSend> stored_packet;
+  uint64_t insert_order;
+  {
+    MutexLock lock(&lock_);
+    if (mode_ == StorageMode::kDisabled) {
+      return nullptr;
+    }
 
-  StoredPacket* packet = GetStoredPacket(sequence_number);
-  if (packet == nullptr) {
-    return nullptr;
-  }
+    StoredPacket* packet = GetStoredPacket(sequence_number);
+    if (packet == nullptr) {
+      return nullptr;
+    }
 
-  if (packet->pending_transmission_) {
-    // Packet already in pacer queue, ignore this request.
-    return nullptr;
-  }
+    if (packet->pending_transmission_) {
+      // Packet already in pacer queue, ignore this request.
+      return nullptr;
+    }
 
-  if (!VerifyRtt(*packet)) {
-    // Packet already resent within too short a time window, ignore.
-    return nullptr;
+    if (!VerifyRtt(*packet)) {
+      // Packet already resent within too short a time window, ignore.
+      return nullptr;
+    }
+
+    // Mark the packet as pending while it is encapsulated, so that it is
+    // neither culled nor retransmitted twice. The copy shares its buffer with
+    // the stored packet.
+    packet->pending_transmission_ = true;
+    stored_packet.emplace(*packet->packet_);
+    insert_order = packet->insert_order();
   }
 
   // Copy and/or encapsulate packet.
   std::unique_ptr<RtpPacketToSend> encapsulated_packet =
-      encapsulate(*packet->packet_);
-  if (encapsulated_packet) {
-    packet->pending_transmission_ = true;
+      encapsulate(*stored_packet);
+  if (encapsulated_packet == nullptr) {
+    MutexLock lock(&lock_);
+    StoredPacket* packet = GetStoredPacket(sequence_number);
+    if (packet != nullptr && packet->insert_order() == insert_order) {
+      packet->pending_transmission_ = false;
+    }
   }
 
   return encapsulated_packet;
@@ -207,11 +253,10 @@ bool RtpPacketHistory::GetPacketState(uint16_t sequence_number) const {
   }
 
   int packet_index = GetPacketIndex(sequence_number);
-  if (packet_index < 0 ||
-      static_cast<size_t>(packet_index) >= packet_history_.size()) {
+  if (packet_index < 0 || static_cast<size_t>(packet_index) >= num_entries_) {
     return false;
   }
-  const StoredPacket& packet = packet_history_[packet_index];
+  const StoredPacket& packet = Entry(packet_index);
   if (packet.packet_ == nullptr) {
     return false;
   }
@@ -256,14 +301,11 @@ std::unique_ptr<RtpPacketToSend> RtpPacketHistory::GetPayloadPaddingPacket(
   }
 
   StoredPacket* best_packet = nullptr;
-  if (!packet_history_.empty()) {
-    // Pick the last packet.
-    for (auto it = packet_history_.rbegin(); it != packet_history_.rend();
-         ++it) {
-      if (it->packet_ != nullptr) {
-        best_packet = &(*it);
-        break;
-      }
+  // Pick the last packet.
+  for (int i = static_cast<int>(num_entries_) - 1; i >= 0; --i) {
+    if (Entry(i).packet_ != nullptr) {
+      best_packet = &Entry(i);
+      break;
     }
   }
   if (best_packet == nullptr) {
@@ -294,8 +336,7 @@ void RtpPacketHistory::CullAcknowledgedPackets(
   MutexLock lock(&lock_);
   for (uint16_t sequence_number : sequence_numbers) {
     int packet_index = GetPacketIndex(sequence_number);
-    if (packet_index < 0 ||
-        static_cast<size_t>(packet_index) >= packet_history_.size()) {
+    if (packet_index < 0 || static_cast<size_t>(packet_index) >= num_entries_) {
       continue;
     }
     RemovePacket(packet_index);
@@ -308,7 +349,11 @@ void RtpPacketHistory::Clear() {
 }
 
 void RtpPacketHistory::Reset() {
-  packet_history_.clear();
+  for (size_t i = 0; i < num_entries_; ++i) {
+    ReleasePacket(std::move(Entry(i).packet_));
+  }
+  first_entry_ = 0;
+  num_entries_ = 0;
   large_payload_packet_ = absl::nullopt;
 }
 
@@ -318,15 +363,15 @@ void RtpPacketHistory::CullOldPackets() {
       rtt_.IsFinite()
           ? std::max(kMinPacketDurationRtt * rtt_, kMinPacketDuration)
           : kMinPacketDuration;
-  while (!packet_history_.empty()) {
-    if (packet_history_.size() >= kMaxCapacity) {
+  while (num_entries_ > 0) {
+    if (num_entries_ >= kMaxCapacity) {
       // We have reached the absolute max capacity, remove one packet
       // unconditionally.
       RemovePacket(0);
       continue;
     }
 
-    const StoredPacket& stored_packet = packet_history_.front();
+    const StoredPacket& stored_packet = Entry(0);
     if (stored_packet.pending_transmission_) {
       // Don't remove packets in the pacer queue, pending tranmission.
       return;
@@ -337,7 +382,7 @@ void RtpPacketHistory::CullOldPackets() {
       return;
     }
 
-    if (packet_history_.size() >= number_to_store_ ||
+    if (num_entries_ >= number_to_store_ ||
         stored_packet.send_time() +
                 (packet_duration * kPacketCullingDelayFactor) <=
             now) {
@@ -351,28 +396,60 @@ void RtpPacketHistory::CullOldPackets() {
   }
 }
 
-std::unique_ptr<RtpPacketToSend> RtpPacketHistory::RemovePacket(
-    int packet_index) {
+void RtpPacketHistory::RemovePacket(int packet_index) {
   // Move the packet out from the StoredPacket container.
-  std::unique_ptr<RtpPacketToSend> rtp_packet =
-      std::move(packet_history_[packet_index].packet_);
+  ReleasePacket(std::move(Entry(packet_index).packet_));
   if (packet_index == 0) {
-    while (!packet_history_.empty() &&
-           packet_history_.front().packet_ == nullptr) {
-      packet_history_.pop_front();
+    while (num_entries_ > 0 && Entry(0).packet_ == nullptr) {
+      first_entry_ = (first_entry_ + 1) & (packet_history_.size() - 1);
+      --num_entries_;
     }
   }
+}
+
+void RtpPacketHistory::ReleasePacket(std::unique_ptr<RtpPacketToSend> packet) {
+  if (packet_pool_ != nullptr) {
+    packet_pool_->Release(std::move(packet));
+  }
+}
+
+bool RtpPacketHistory::Reserve(size_t num_entries) {
+  if (num_entries <= packet_history_.size()) {
+    return true;
+  }
+  if (num_entries > kMaxRingSize) {
+    return false;
+  }
+  // Move the entries to the start of a larger buffer, oldest first.
+  std::vector<StoredPacket> entries(RingSizeFor(num_entries));
+  for (size_t i = 0; i < num_entries_; ++i) {
+    entries[i] = std::move(Entry(i));
+  }
+  packet_history_ = std::move(entries);
+  first_entry_ = 0;
+  return true;
+}
 
-  return rtp_packet;
+RtpPacketHistory::StoredPacket& RtpPacketHistory::Entry(int packet_index) {
+  RTC_DCHECK_GE(packet_index, 0);
+  return packet_history_[(first_entry_ + packet_index) &
+                         (packet_history_.size() - 1)];
+}
+
+const RtpPacketHistory::StoredPacket& RtpPacketHistory::Entry(
+    int packet_index) const {
+  RTC_DCHECK_GE(packet_index, 0);
+  return packet_history_[(first_entry_ + packet_index) &
+                         (packet_history_.size() - 1)];
 }
 
 int RtpPacketHistory::GetPacketIndex(uint16_t sequence_number) const {
-  if (packet_history_.empty()) {
+  if (num_entries_ == 0) {
     return 0;
   }
 
-  RTC_DCHECK(packet_history_.front().packet_ != nullptr);
-  int first_seq = packet_history_.front().packet_->SequenceNumber();
+  RTC_DCHECK(Entry(0).packet_ != nullptr);
+  int first_seq = Entry(0).packet_->SequenceNumber();
   if (first_seq == sequence_number) {
     return 0;
   }
@@ -396,11 +473,11 @@ int RtpPacketHistory::GetPacketIndex(uint16_t sequence_number) const {
 RtpPacketHistory::StoredPacket* RtpPacketHistory::GetStoredPacket(
     uint16_t sequence_number) {
   int index = GetPacketIndex(sequence_number);
-  if (index < 0 || static_cast<size_t>(index) >= packet_history_.size() ||
-      packet_history_[index].packet_ == nullptr) {
+  if (index < 0 || static_cast<size_t>(index) >= num_entries_ ||
+      Entry(index).packet_ == nullptr) {
     return nullptr;
   }
-  return &packet_history_[index];
+  return &Entry(index);
 }
 
 }  // namespace webrtc
@@ -11,7 +11,6 @@
 #ifndef MODULES_RTP_RTCP_SOURCE_RTP_PACKET_HISTORY_H_
 #define MODULES_RTP_RTCP_SOURCE_RTP_PACKET_HISTORY_H_
 
-#include <deque>
 #include <map>
 #include <memory>
 #include <set>
@@ -24,6 +23,7 @@
 #include "api/units/timestamp.h"
 #include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
 #include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
+#include "modules/rtp_rtcp/source/rtp_packet_to_send_pool.h"
 #include "rtc_base/synchronization/mutex.h"
 #include "rtc_base/thread_annotations.h"
 
@@ -48,6 +48,9 @@ class RtpPacketHistory {
 
   // Maximum number of packets we ever allow in the history.
   static constexpr size_t kMaxCapacity = 9600;
+  // Maximum number of entries in the ring buffer, a power of two large enough
+  // to span kMaxCapacity sequence numbers.
+  static constexpr size_t kMaxRingSize = 16384;
   // Maximum number of entries in prioritized queue of padding packets.
   static constexpr size_t kMaxPaddingHistory = 63;
   // Don't remove packets within max(1 second, 3x RTT).
@@ -56,7 +59,10 @@ class RtpPacketHistory {
   // With kStoreAndCull, always remove packets after 3x max(1000ms, 3x rtt).
   static constexpr int kPacketCullingDelayFactor = 3;
 
-  RtpPacketHistory(Clock* clock, PaddingMode padding_mode);
+  // Packets removed from the history are given back to `packet_pool`, if set.
+  RtpPacketHistory(Clock* clock,
+                   PaddingMode padding_mode,
+                   RtpPacketToSendPool* packet_pool = nullptr);
 
   RtpPacketHistory() = delete;
   RtpPacketHistory(const RtpPacketHistory&) = delete;
@@ -88,6 +94,8 @@ class RtpPacketHistory {
   // copy that may be wrapped in a container, eg RTX.
   // If the the encapsulator returns nullptr, the retransmit is aborted and the
   // packet will not be marked as pending.
+  // The encapsulator runs on a copy of the stored packet without holding the
+  // history lock, so that packets can be stored meanwhile.
   std::unique_ptr<RtpPacketToSend> GetPacketAndMarkAsPending(
       uint16_t sequence_number,
       rtc::FunctionView<std::unique_ptr<RtpPacketToSend>(
@@ -164,8 +172,15 @@ class RtpPacketHistory {
   void Reset() RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
   void CullOldPackets() RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
   // Removes the packet from the history, and context/mapping that has been
-  // stored. Returns the RTP packet instance contained within the StoredPacket.
-  std::unique_ptr<RtpPacketToSend> RemovePacket(int packet_index)
+  // stored. The RTP packet instance is given back to the packet pool, if any.
+  void RemovePacket(int packet_index) RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  void ReleasePacket(std::unique_ptr<RtpPacketToSend> packet);
+  // Makes room for `num_entries` entries in the ring buffer. Returns false if
+  // that would exceed kMaxRingSize.
+  bool Reserve(size_t num_entries) RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  // Returns the entry `packet_index` places after the oldest one.
+  StoredPacket& Entry(int packet_index) RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  const StoredPacket& Entry(int packet_index) const
       RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
   int GetPacketIndex(uint16_t sequence_number) const
       RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
@@ -174,18 +189,24 @@ class RtpPacketHistory {
 
   Clock* const clock_;
   const PaddingMode padding_mode_;
+  RtpPacketToSendPool* const packet_pool_;
   mutable Mutex lock_;
   size_t number_to_store_ RTC_GUARDED_BY(lock_);
   StorageMode mode_ RTC_GUARDED_BY(lock_);
   TimeDelta rtt_ RTC_GUARDED_BY(lock_);
 
-  // Queue of stored packets, ordered by sequence number, with older packets in
-  // the front and new packets being added to the back. Note that there may be
-  // wrap-arounds so the back may have a lower sequence number.
+  // Ring buffer of stored packets, ordered by sequence number, holding
+  // `num_entries_` entries starting with the oldest packet at `first_entry_`.
+  // Each entry is for the sequence number following that of the previous one,
+  // so that packets are looked up in constant time. Note that there may be
+  // wrap-arounds so the newest entry may have a lower sequence number.
   // Packets may also be removed out-of-order, in which case there will be
-  // instances of StoredPacket with `packet_` set to nullptr. The first and last
-  // entry in the queue will however always be populated.
-  std::deque<StoredPacket> packet_history_ RTC_GUARDED_BY(lock_);
+  // instances of StoredPacket with `packet_` set to nullptr. The oldest entry
+  // will however always be populated. The size of the buffer is a power of two
+  // and only grows, up to kMaxRingSize, while the history is enabled.
+  std::vector<StoredPacket> packet_history_ RTC_GUARDED_BY(lock_);
+  size_t first_entry_ RTC_GUARDED_BY(lock_);
+  size_t num_entries_ RTC_GUARDED_BY(lock_);
 
   // Total number of packets with inserted.
   uint64_t packets_inserted_ RTC_GUARDED_BY(lock_);
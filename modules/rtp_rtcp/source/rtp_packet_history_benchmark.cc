@@ -0,0 +1,76 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <cstdint>
+#include <memory>
+
+#include "api/units/data_rate.h"
+#include "api/units/data_size.h"
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "benchmark/benchmark.h"
+#include "modules/rtp_rtcp/source/rtp_packet_history.h"
+#include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
+#include "rtc_base/random.h"
+#include "system_wrappers/include/clock.h"
+
+namespace webrtc {
+namespace {
+
+constexpr DataRate kSendRate = DataRate::KilobitsPerSec(20'000);
+constexpr DataSize kPacketSize = DataSize::Bytes(1200);
+constexpr TimeDelta kRtt = TimeDelta::Millis(100);
+constexpr int kNackPercent = 5;
+// As RTPSender configures the history for video.
+constexpr size_t kNumberToStore = 600;
+
+// Sends one packet per iteration at 20 Mbps, storing it in the history as
+// RtpSenderEgress does. For 5% of the packets, a NACK arrives one RTT later
+// and the packet is retransmitted as RTPSender and RtpSenderEgress do.
+void BM_PacketHistoryWithNacks(benchmark::State& state) {
+  const TimeDelta packet_interval = kPacketSize / kSendRate;
+  const int64_t nack_delay = kRtt / packet_interval;
+  SimulatedClock clock(Timestamp::Seconds(1000));
+  RtpPacketHistory history(&clock, RtpPacketHistory::PaddingMode::kDefault);
+  history.SetStorePacketsStatus(RtpPacketHistory::StorageMode::kStoreAndCull,
+                                kNumberToStore);
+  history.SetRtt(kRtt);
+  Random random(0x5eed);
+
+  RtpPacketToSend packet_template(/*extensions=*/nullptr);
+  packet_template.SetPayloadSize(kPacketSize.bytes() - 12);
+  packet_template.set_allow_retransmission(true);
+  uint16_t sequence_number = 0;
+  int64_t retransmissions = 0;
+  for (auto _ : state) {
+    auto packet = std::make_unique<RtpPacketToSend>(packet_template);
+    packet->SetSequenceNumber(sequence_number);
+    history.PutRtpPacket(std::move(packet), clock.CurrentTime());
+
+    if (random.Rand(1, 100) <= kNackPercent) {
+      const uint16_t nacked_sequence_number = sequence_number - nack_delay;
+      std::unique_ptr<RtpPacketToSend> retransmission =
+          history.GetPacketAndMarkAsPending(nacked_sequence_number);
+      if (retransmission) {
+        history.MarkPacketAsSent(nacked_sequence_number);
+        ++retransmissions;
+      }
+    }
+    ++sequence_number;
+    clock.AdvanceTime(packet_interval);
+  }
+  state.SetItemsProcessed(state.iterations());
+  state.counters["retransmissions"] = retransmissions;
+}
+
+BENCHMARK(BM_PacketHistoryWithNacks);
+
+}  // namespace
+}  // namespace webrtc
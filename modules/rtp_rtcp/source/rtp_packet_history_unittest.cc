@@ -575,6 +575,63 @@ TEST_P(RtpPacketHistoryTest, OutOfOrderInsertRemoval) {
   }
 }
 
+TEST_P(RtpPacketHistoryTest, KeepsRecentPacketsBeyondNumberToStore) {
+  hist_.SetStorePacketsStatus(StorageMode::kStoreAndCull, 10);
+
+  for (size_t i = 0; i < 1000; ++i) {
+    hist_.PutRtpPacket(CreateRtpPacket(To16u(kStartSeqNum + i)),
+                       fake_clock_.CurrentTime());
+  }
+
+  // Packets are not culled before kMinPacketDuration, so the history grows.
+  for (size_t i = 0; i < 1000; ++i) {
+    EXPECT_TRUE(hist_.GetPacketState(To16u(kStartSeqNum + i)));
+  }
+}
+
+TEST_P(RtpPacketHistoryTest, HandlesSequenceNumberJumps) {
+  hist_.SetStorePacketsStatus(StorageMode::kStoreAndCull, 10);
+  hist_.PutRtpPacket(CreateRtpPacket(kStartSeqNum), fake_clock_.CurrentTime());
+
+  // Within the span of the history, older packets are kept.
+  const uint16_t kSeqNum2 = To16u(kStartSeqNum + 5000);
+  hist_.PutRtpPacket(CreateRtpPacket(kSeqNum2), fake_clock_.CurrentTime());
+  EXPECT_TRUE(hist_.GetPacketState(kStartSeqNum));
+  EXPECT_TRUE(hist_.GetPacketState(kSeqNum2));
+
+  // Beyond it, they make room for the new packet.
+  const uint16_t kSeqNum3 = To16u(kSeqNum2 + 20000);
+  hist_.PutRtpPacket(CreateRtpPacket(kSeqNum3), fake_clock_.CurrentTime());
+  EXPECT_FALSE(hist_.GetPacketState(kStartSeqNum));
+  EXPECT_FALSE(hist_.GetPacketState(kSeqNum2));
+  EXPECT_TRUE(hist_.GetPacketState(kSeqNum3));
+
+  // Packets older than the history can span are dropped.
+  const uint16_t kSeqNum4 = To16u(kSeqNum3 - 20000);
+  hist_.PutRtpPacket(CreateRtpPacket(kSeqNum4), fake_clock_.CurrentTime());
+  EXPECT_FALSE(hist_.GetPacketState(kSeqNum4));
+  EXPECT_TRUE(hist_.GetPacketState(kSeqNum3));
+}
+
+TEST_P(RtpPacketHistoryTest, StoresPacketsWhileEncapsulating) {
+  hist_.SetStorePacketsStatus(StorageMode::kStoreAndCull, 10);
+  hist_.PutRtpPacket(CreateRtpPacket(kStartSeqNum), fake_clock_.CurrentTime());
+
+  // The encapsulator runs without holding the history lock.
+  const uint16_t kSeqNum2 = To16u(kStartSeqNum + 1);
+  std::unique_ptr<RtpPacketToSend> packet = hist_.GetPacketAndMarkAsPending(
+      kStartSeqNum, [&](const RtpPacketToSend& stored_packet) {
+        hist_.PutRtpPacket(CreateRtpPacket(kSeqNum2),
+                           fake_clock_.CurrentTime());
+        return std::make_unique<RtpPacketToSend>(stored_packet);
+      });
+  ASSERT_TRUE(packet);
+  EXPECT_EQ(packet->SequenceNumber(), kStartSeqNum);
+  EXPECT_TRUE(hist_.GetPacketState(kSeqNum2));
+  // Still pending.
+  EXPECT_FALSE(hist_.GetPacketAndMarkAsPending(kStartSeqNum));
+}
+
 TEST_P(RtpPacketHistoryTest, UsesLastPacketAsPaddingWithDefaultMode) {
   if (GetParam() != RtpPacketHistory::PaddingMode::kDefault) {
     GTEST_SKIP() << "Default padding prioritization required for this test";
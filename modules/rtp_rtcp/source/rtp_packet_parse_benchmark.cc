@@ -0,0 +1,94 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <cstdint>
+#include <vector>
+
+#include "api/rtp_headers.h"
+#include "api/video/video_rotation.h"
+#include "benchmark/benchmark.h"
+#include "modules/rtp_rtcp/include/rtp_header_extension_map.h"
+#include "modules/rtp_rtcp/source/rtp_header_extensions.h"
+#include "modules/rtp_rtcp/source/rtp_packet.h"
+#include "modules/rtp_rtcp/source/rtp_packet_received.h"
+#include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
+#include "rtc_base/copy_on_write_buffer.h"
+
+namespace webrtc {
+namespace {
+
+constexpr uint32_t kAudioSsrc = 1111;
+constexpr uint32_t kVideoSsrc = 2222;
+constexpr int kVideoPacketsPerAudioPacket = 10;
+
+RtpHeaderExtensionMap ExtensionMap() {
+  RtpHeaderExtensionMap extensions;
+  extensions.Register<AudioLevelExtension>(1);
+  extensions.Register<AbsoluteSendTime>(2);
+  extensions.Register<TransportSequenceNumber>(3);
+  extensions.Register<RtpMid>(4);
+  extensions.Register<VideoOrientation>(5);
+  extensions.Register<PlayoutDelayLimits>(6);
+  extensions.Register<VideoContentTypeExtension>(7);
+  extensions.Register<VideoTimingExtension>(8);
+  return extensions;
+}
+
+// Packets of an audio and a video stream, with the extensions a browser sends
+// once the MID has been acknowledged, as seen by a receiving transport.
+std::vector<rtc::CopyOnWriteBuffer> PacketTrace(
+    const RtpHeaderExtensionMap& extensions) {
+  std::vector<rtc::CopyOnWriteBuffer> packets;
+  uint16_t transport_sequence_number = 0;
+  for (int i = 0; i < 1000; ++i) {
+    RtpPacketToSend packet(&extensions);
+    packet.SetSequenceNumber(i);
+    packet.SetTimestamp(i * 3000);
+    packet.SetExtension<AbsoluteSendTime>(i * 1000);
+    packet.SetExtension<TransportSequenceNumber>(transport_sequence_number++);
+    if (i % kVideoPacketsPerAudioPacket == 0) {
+      packet.SetPayloadType(111);
+      packet.SetSsrc(kAudioSsrc);
+      packet.SetExtension<AudioLevelExtension>(AudioLevel(true, i % 128));
+      packet.SetPayloadSize(60);
+    } else {
+      packet.SetPayloadType(96);
+      packet.SetSsrc(kVideoSsrc);
+      packet.SetExtension<VideoOrientation>(kVideoRotation_0);
+      packet.SetExtension<VideoContentTypeExtension>(
+          VideoContentType::UNSPECIFIED);
+      packet.SetPayloadSize(1100);
+    }
+    packets.push_back(packet.Buffer());
+  }
+  return packets;
+}
+
+void BM_ParseRtpPackets(benchmark::State& state) {
+  const bool use_layout_cache = state.range(0);
+  const RtpHeaderExtensionMap extensions = ExtensionMap();
+  const std::vector<rtc::CopyOnWriteBuffer> packets = PacketTrace(extensions);
+  RtpPacket::ExtensionLayoutCache layout_cache;
+
+  for (auto _ : state) {
+    for (const rtc::CopyOnWriteBuffer& buffer : packets) {
+      // As RtpTransport does before demuxing.
+      RtpPacketReceived packet(&extensions);
+      packet.Parse(buffer, use_layout_cache ? &layout_cache : nullptr);
+      benchmark::DoNotOptimize(packet.GetExtension<TransportSequenceNumber>());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * packets.size());
+}
+
+BENCHMARK(BM_ParseRtpPackets)->ArgName("layout_cache")->Arg(0)->Arg(1);
+
+}  // namespace
+}  // namespace webrtc
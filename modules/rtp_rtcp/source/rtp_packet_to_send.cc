@@ -11,8 +11,10 @@
 #include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
 
 #include <cstdint>
+#include <utility>
 
 #include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
+#include "rtc_base/copy_on_write_buffer.h"
 
 namespace webrtc {
 
@@ -30,6 +32,12 @@ RtpPacketToSend& RtpPacketToSend::operator=(RtpPacketToSend&& packet) = default;
 
 RtpPacketToSend::~RtpPacketToSend() = default;
 
+void RtpPacketToSend::CopyFrom(const RtpPacketToSend& packet) {
+  rtc::CopyOnWriteBuffer storage = Buffer();
+  *this = packet;
+  UnshareBuffer(std::move(storage));
+}
+
 void RtpPacketToSend::set_packet_type(RtpPacketMediaType type) {
   if (packet_type_ == RtpPacketMediaType::kAudio) {
     original_packet_type_ = OriginalType::kAudio;
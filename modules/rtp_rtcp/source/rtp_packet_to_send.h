@@ -45,6 +45,12 @@ class RtpPacketToSend : public RtpPacket {
 
   ~RtpPacketToSend();
 
+  // Makes this packet a copy of `packet`. Unlike the copy assignment, which
+  // shares the buffer of `packet` until one of them is modified, this copies
+  // the contents into the buffer this packet already has, so that neither of
+  // them allocates when modified later.
+  void CopyFrom(const RtpPacketToSend& packet);
+
   // Time in local time base as close as it can to frame capture time.
   webrtc::Timestamp capture_time() const { return capture_time_; }
   void set_capture_time(webrtc::Timestamp time) { capture_time_ = time; }
@@ -0,0 +1,106 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/rtp_packet_to_send_pool.h"
+
+#include <memory>
+#include <utility>
+
+#include "modules/rtp_rtcp/include/rtp_header_extension_map.h"
+#include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
+#include "rtc_base/synchronization/mutex.h"
+
+namespace webrtc {
+namespace {
+
+// Size of an RTP header without CSRCs and extensions.
+constexpr size_t kFixedHeaderSize = 12;
+
+}  // namespace
+
+RtpPacketToSendPool::RtpPacketToSendPool(size_t max_free_packets)
+    : max_free_packets_(max_free_packets),
+      empty_packet_(/*extensions=*/nullptr, kFixedHeaderSize) {}
+
+RtpPacketToSendPool::~RtpPacketToSendPool() = default;
+
+std::unique_ptr<RtpPacketToSend> RtpPacketToSendPool::Acquire(
+    const RtpHeaderExtensionMap* extensions,
+    size_t capacity) {
+  std::unique_ptr<RtpPacketToSend> packet = TakeFreePacket();
+  if (packet == nullptr || packet->capacity() < capacity) {
+    CountAllocation();
+    return std::make_unique<RtpPacketToSend>(extensions, capacity);
+  }
+  const uint8_t* const storage = packet->data();
+  packet->CopyFrom(empty_packet_);
+  packet->IdentifyExtensions(extensions ? *extensions
+                                        : RtpHeaderExtensionMap());
+  if (packet->data() != storage) {
+    CountAllocation();
+  }
+  return packet;
+}
+
+std::unique_ptr<RtpPacketToSend> RtpPacketToSendPool::Copy(
+    const RtpPacketToSend& packet) {
+  std::unique_ptr<RtpPacketToSend> copy = TakeFreePacket();
+  if (copy == nullptr) {
+    // Copied into fresh storage of the same capacity, so that the copy does
+    // not share the buffer of `packet`.
+    CountAllocation();
+    copy = std::make_unique<RtpPacketToSend>(/*extensions=*/nullptr,
+                                             packet.capacity());
+    copy->CopyFrom(packet);
+    return copy;
+  }
+  const uint8_t* const storage = copy->data();
+  copy->CopyFrom(packet);
+  if (copy->data() != storage) {
+    CountAllocation();
+  }
+  return copy;
+}
+
+void RtpPacketToSendPool::Release(std::unique_ptr<RtpPacketToSend> packet) {
+  if (packet == nullptr) {
+    return;
+  }
+  // Don't keep application data alive while the packet waits for reuse.
+  packet->set_additional_data(nullptr);
+  MutexLock lock(&mutex_);
+  ++stats_.released;
+  if (free_packets_.size() < max_free_packets_) {
+    free_packets_.push_back(std::move(packet));
+  }
+}
+
+RtpPacketToSendPool::Stats RtpPacketToSendPool::stats() const {
+  MutexLock lock(&mutex_);
+  return stats_;
+}
+
+std::unique_ptr<RtpPacketToSend> RtpPacketToSendPool::TakeFreePacket() {
+  MutexLock lock(&mutex_);
+  ++stats_.acquired;
+  if (free_packets_.empty()) {
+    return nullptr;
+  }
+  std::unique_ptr<RtpPacketToSend> packet = std::move(free_packets_.back());
+  free_packets_.pop_back();
+  return packet;
+}
+
+void RtpPacketToSendPool::CountAllocation() {
+  MutexLock lock(&mutex_);
+  ++stats_.allocated;
+}
+
+}  // namespace webrtc
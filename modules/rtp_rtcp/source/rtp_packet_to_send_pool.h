@@ -0,0 +1,86 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_RTP_RTCP_SOURCE_RTP_PACKET_TO_SEND_POOL_H_
+#define MODULES_RTP_RTCP_SOURCE_RTP_PACKET_TO_SEND_POOL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+#include <vector>
+
+#include "modules/rtp_rtcp/include/rtp_header_extension_map.h"
+#include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+// Recycles outgoing RTP packets together with their buffers, so that creating
+// packets does not allocate once the send pipeline has reached steady state.
+// Packets are taken with Acquire() or Copy() and given back with Release()
+// when they have been sent and are no longer kept for retransmission. Packets
+// that are not given back are simply destroyed.
+//
+// Packets are created on the encoder queue and released on the network
+// queue, so this class is thread safe.
+class RtpPacketToSendPool {
+ public:
+  // Enough for the packets of a few large frames in flight.
+  static constexpr size_t kDefaultMaxFreePackets = 256;
+
+  struct Stats {
+    // Number of packets handed out by Acquire() and Copy().
+    int64_t acquired = 0;
+    // Number of packets or packet buffers that had to be allocated to do so.
+    int64_t allocated = 0;
+    // Number of packets given back with Release().
+    int64_t released = 0;
+  };
+
+  explicit RtpPacketToSendPool(
+      size_t max_free_packets = kDefaultMaxFreePackets);
+  ~RtpPacketToSendPool();
+
+  RtpPacketToSendPool(const RtpPacketToSendPool&) = delete;
+  RtpPacketToSendPool& operator=(const RtpPacketToSendPool&) = delete;
+
+  // Returns an empty packet, as if constructed with the same arguments.
+  std::unique_ptr<RtpPacketToSend> Acquire(
+      const RtpHeaderExtensionMap* extensions,
+      size_t capacity);
+
+  // Returns a copy of `packet` that does not share its buffer, see
+  // RtpPacketToSend::CopyFrom().
+  std::unique_ptr<RtpPacketToSend> Copy(const RtpPacketToSend& packet);
+
+  // Gives `packet` back for reuse. Packets beyond `max_free_packets` are
+  // destroyed.
+  void Release(std::unique_ptr<RtpPacketToSend> packet);
+
+  Stats stats() const;
+
+ private:
+  std::unique_ptr<RtpPacketToSend> TakeFreePacket();
+  void CountAllocation();
+
+  const size_t max_free_packets_;
+  // Copied into reused packets by Acquire(), to reset them.
+  const RtpPacketToSend empty_packet_;
+  mutable Mutex mutex_;
+  std::vector<std::unique_ptr<RtpPacketToSend>> free_packets_
+      RTC_GUARDED_BY(mutex_);
+  Stats stats_ RTC_GUARDED_BY(mutex_);
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_RTP_RTCP_SOURCE_RTP_PACKET_TO_SEND_POOL_H_
@@ -0,0 +1,100 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <utility>
+
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "benchmark/benchmark.h"
+#include "modules/rtp_rtcp/include/rtp_header_extension_map.h"
+#include "modules/rtp_rtcp/source/rtp_header_extensions.h"
+#include "modules/rtp_rtcp/source/rtp_packet_history.h"
+#include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
+#include "modules/rtp_rtcp/source/rtp_packet_to_send_pool.h"
+#include "system_wrappers/include/clock.h"
+
+namespace webrtc {
+namespace {
+
+constexpr size_t kMaxPacketSize = 1200;
+constexpr size_t kPayloadSize = 1100;
+constexpr int kPacketsPerFrame = 30;
+constexpr int kFramesPerSecond = 30;
+constexpr int kWarmupFrames = 2 * kFramesPerSecond;
+
+// Runs the packets of one video frame through the send path: copied from a
+// template as RTPSenderVideo does, given a payload and transport sequence
+// number, then stored in the history once sent, which culls old packets.
+void SendFrame(RtpPacketToSendPool* pool,
+               RtpPacketHistory& history,
+               SimulatedClock& clock,
+               const RtpPacketToSend& packet_template,
+               uint16_t& sequence_number) {
+  for (int i = 0; i < kPacketsPerFrame; ++i) {
+    std::unique_ptr<RtpPacketToSend> packet =
+        pool ? pool->Copy(packet_template)
+             : std::make_unique<RtpPacketToSend>(packet_template);
+    packet->SetSequenceNumber(sequence_number++);
+    packet->SetMarker(i == kPacketsPerFrame - 1);
+    std::memset(packet->AllocatePayload(kPayloadSize), i, kPayloadSize);
+    packet->SetExtension<TransportSequenceNumber>(sequence_number);
+    packet->set_packet_type(RtpPacketMediaType::kVideo);
+    packet->set_allow_retransmission(true);
+    benchmark::DoNotOptimize(packet->data());
+    history.PutRtpPacket(std::move(packet), clock.CurrentTime());
+  }
+  clock.AdvanceTime(TimeDelta::Seconds(1) / kFramesPerSecond);
+}
+
+// Reports the packet allocations per simulated second once the history has
+// filled up, which should be zero with the pool.
+void BM_SendPackets(benchmark::State& state) {
+  const bool use_pool = state.range(0);
+  SimulatedClock clock(Timestamp::Seconds(1000));
+  RtpPacketToSendPool pool;
+  RtpPacketToSendPool* const packet_pool = use_pool ? &pool : nullptr;
+  RtpPacketHistory history(&clock, RtpPacketHistory::PaddingMode::kDefault,
+                           packet_pool);
+  history.SetStorePacketsStatus(RtpPacketHistory::StorageMode::kStoreAndCull,
+                                /*number_to_store=*/600);
+  RtpHeaderExtensionMap extensions;
+  extensions.Register<TransportSequenceNumber>(1);
+  RtpPacketToSend packet_template(&extensions, kMaxPacketSize);
+  packet_template.SetPayloadType(96);
+  packet_template.SetSsrc(0x1234);
+  packet_template.SetTimestamp(90000);
+  packet_template.ReserveExtension<TransportSequenceNumber>();
+  uint16_t sequence_number = 0;
+
+  for (int i = 0; i < kWarmupFrames; ++i) {
+    SendFrame(packet_pool, history, clock, packet_template, sequence_number);
+  }
+  const int64_t warmup_allocations = pool.stats().allocated;
+  int64_t frames = 0;
+  for (auto _ : state) {
+    SendFrame(packet_pool, history, clock, packet_template, sequence_number);
+    ++frames;
+  }
+
+  state.SetItemsProcessed(frames * kPacketsPerFrame);
+  if (use_pool) {
+    state.counters["allocations_per_second"] =
+        static_cast<double>(pool.stats().allocated - warmup_allocations) *
+        kFramesPerSecond / frames;
+  }
+}
+
+BENCHMARK(BM_SendPackets)->ArgName("pool")->Arg(0)->Arg(1);
+
+}  // namespace
+}  // namespace webrtc
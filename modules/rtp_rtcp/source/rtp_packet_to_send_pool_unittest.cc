@@ -0,0 +1,189 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/rtp_packet_to_send_pool.h"
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <utility>
+
+#include "api/make_ref_counted.h"
+#include "api/ref_counted_base.h"
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "modules/rtp_rtcp/include/rtp_header_extension_map.h"
+#include "modules/rtp_rtcp/source/rtp_header_extensions.h"
+#include "modules/rtp_rtcp/source/rtp_packet_history.h"
+#include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
+#include "rtc_base/copy_on_write_buffer.h"
+#include "system_wrappers/include/clock.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::ElementsAreArray;
+
+constexpr size_t kCapacity = 1200;
+constexpr uint8_t kPayload[] = {1, 2, 3, 4, 5, 6, 7, 8};
+constexpr int kTransportSequenceNumberId = 1;
+
+class ApplicationData : public rtc::RefCountedBase {
+ public:
+  using rtc::RefCountedBase::HasOneRef;
+};
+
+RtpHeaderExtensionMap ExtensionMap() {
+  RtpHeaderExtensionMap extensions;
+  extensions.Register<TransportSequenceNumber>(kTransportSequenceNumberId);
+  return extensions;
+}
+
+void FillPacket(RtpPacketToSend& packet, uint16_t sequence_number) {
+  packet.SetSequenceNumber(sequence_number);
+  packet.SetSsrc(0x1234);
+  packet.set_packet_type(RtpPacketMediaType::kVideo);
+  packet.set_allow_retransmission(true);
+  packet.set_capture_time(Timestamp::Millis(1000));
+  std::memcpy(packet.AllocatePayload(sizeof(kPayload)), kPayload,
+              sizeof(kPayload));
+}
+
+TEST(RtpPacketToSendPoolTest, AcquiresEmptyPacketsWithGivenExtensions) {
+  RtpPacketToSendPool pool;
+  const RtpHeaderExtensionMap extensions = ExtensionMap();
+  std::unique_ptr<RtpPacketToSend> packet =
+      pool.Acquire(&extensions, kCapacity);
+  FillPacket(*packet, 1);
+  packet->SetExtension<TransportSequenceNumber>(1);
+  pool.Release(std::move(packet));
+
+  packet = pool.Acquire(&extensions, kCapacity);
+  EXPECT_EQ(packet->size(), 12u);
+  EXPECT_EQ(packet->payload_size(), 0u);
+  EXPECT_EQ(packet->SequenceNumber(), 0);
+  EXPECT_FALSE(packet->HasExtension<TransportSequenceNumber>());
+  EXPECT_TRUE(packet->IsRegistered<TransportSequenceNumber>());
+  EXPECT_EQ(packet->packet_type(), absl::nullopt);
+  EXPECT_FALSE(packet->allow_retransmission());
+  EXPECT_EQ(packet->capture_time(), Timestamp::Zero());
+  EXPECT_GE(packet->capacity(), kCapacity);
+  EXPECT_EQ(pool.stats().acquired, 2);
+  EXPECT_EQ(pool.stats().allocated, 1);
+}
+
+TEST(RtpPacketToSendPoolTest, AllocatesWhenReleasedPacketIsTooSmall) {
+  RtpPacketToSendPool pool;
+  pool.Release(pool.Acquire(nullptr, 100));
+
+  EXPECT_GE(pool.Acquire(nullptr, kCapacity)->capacity(), kCapacity);
+  EXPECT_EQ(pool.stats().allocated, 2);
+}
+
+TEST(RtpPacketToSendPoolTest, CopiesDoNotShareBuffer) {
+  RtpPacketToSendPool pool;
+  RtpPacketToSend packet(nullptr, kCapacity);
+  FillPacket(packet, 1);
+
+  std::unique_ptr<RtpPacketToSend> copy = pool.Copy(packet);
+  EXPECT_NE(copy->data(), packet.data());
+  EXPECT_EQ(copy->capacity(), packet.capacity());
+  EXPECT_EQ(copy->SequenceNumber(), 1);
+  EXPECT_EQ(copy->packet_type(), RtpPacketMediaType::kVideo);
+  EXPECT_EQ(copy->capture_time(), Timestamp::Millis(1000));
+  EXPECT_THAT(copy->payload(), ElementsAreArray(kPayload));
+
+  copy->SetSequenceNumber(2);
+  copy->AllocatePayload(1)[0] = 0xff;
+  EXPECT_EQ(packet.SequenceNumber(), 1);
+  EXPECT_THAT(packet.payload(), ElementsAreArray(kPayload));
+}
+
+TEST(RtpPacketToSendPoolTest, ReusesReleasedPacketsWithoutAllocating) {
+  RtpPacketToSendPool pool;
+  RtpPacketToSend packet(nullptr, kCapacity);
+  FillPacket(packet, 1);
+  pool.Release(pool.Copy(packet));
+
+  for (int i = 0; i < 100; ++i) {
+    std::unique_ptr<RtpPacketToSend> copy = pool.Copy(packet);
+    copy->SetSequenceNumber(i);
+    std::memset(copy->AllocatePayload(kCapacity / 2), i, kCapacity / 2);
+    pool.Release(std::move(copy));
+  }
+  EXPECT_EQ(pool.stats().acquired, 101);
+  EXPECT_EQ(pool.stats().allocated, 1);
+  EXPECT_EQ(pool.stats().released, 101);
+}
+
+TEST(RtpPacketToSendPoolTest, DoesNotOverwriteBufferStillInUse) {
+  RtpPacketToSendPool pool;
+  RtpPacketToSend packet(nullptr, kCapacity);
+  FillPacket(packet, 1);
+  std::unique_ptr<RtpPacketToSend> copy = pool.Copy(packet);
+  // As when a FEC generator keeps a reference to a sent packet.
+  const rtc::CopyOnWriteBuffer kept = copy->Buffer();
+  pool.Release(std::move(copy));
+
+  packet.SetSequenceNumber(2);
+  copy = pool.Copy(packet);
+  EXPECT_NE(copy->data(), kept.cdata());
+  EXPECT_EQ(copy->SequenceNumber(), 2);
+  EXPECT_EQ(kept[3], 1);
+  EXPECT_EQ(pool.stats().allocated, 2);
+}
+
+TEST(RtpPacketToSendPoolTest, DropsApplicationDataOnRelease) {
+  RtpPacketToSendPool pool;
+  std::unique_ptr<RtpPacketToSend> packet = pool.Acquire(nullptr, kCapacity);
+  auto data = rtc::make_ref_counted<ApplicationData>();
+  packet->set_additional_data(data);
+  pool.Release(std::move(packet));
+
+  EXPECT_TRUE(data->HasOneRef());
+}
+
+TEST(RtpPacketToSendPoolTest, KeepsAtMostMaxFreePackets) {
+  RtpPacketToSendPool pool(/*max_free_packets=*/1);
+  std::unique_ptr<RtpPacketToSend> packet1 = pool.Acquire(nullptr, kCapacity);
+  std::unique_ptr<RtpPacketToSend> packet2 = pool.Acquire(nullptr, kCapacity);
+  pool.Release(std::move(packet1));
+  pool.Release(std::move(packet2));
+
+  pool.Acquire(nullptr, kCapacity);
+  pool.Acquire(nullptr, kCapacity);
+  EXPECT_EQ(pool.stats().allocated, 3);
+}
+
+TEST(RtpPacketToSendPoolTest, PacketHistoryGivesBackCulledPackets) {
+  SimulatedClock clock(Timestamp::Seconds(10));
+  RtpPacketToSendPool pool;
+  RtpPacketHistory history(&clock, RtpPacketHistory::PaddingMode::kDefault,
+                           &pool);
+  history.SetStorePacketsStatus(RtpPacketHistory::StorageMode::kStoreAndCull,
+                                /*number_to_store=*/10);
+  RtpPacketToSend packet(nullptr, kCapacity);
+
+  // Once the history is full, every packet stored culls the oldest one, which
+  // the next packet then reuses.
+  for (uint16_t sequence_number = 0; sequence_number < 100;
+       ++sequence_number) {
+    FillPacket(packet, sequence_number);
+    history.PutRtpPacket(pool.Copy(packet), clock.CurrentTime());
+    clock.AdvanceTime(RtpPacketHistory::kMinPacketDuration / 10);
+  }
+  EXPECT_EQ(pool.stats().released, 90);
+  EXPECT_EQ(pool.stats().allocated, 11);
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -865,6 +865,91 @@ TEST(RtpPacketTest, ParseWithMid) {
   EXPECT_EQ(mid, kMid);
 }
 
+TEST(RtpPacketTest, ParseWithLayoutCacheReadsNewExtensionValues) {
+  RtpPacketToSend::ExtensionManager extensions;
+  extensions.Register<TransmissionOffset>(kTransmissionOffsetExtensionId);
+  extensions.Register<AudioLevelExtension>(kAudioLevelExtensionId);
+  RtpPacket::ExtensionLayoutCache layout_cache;
+  RtpPacketReceived packet(&extensions);
+  rtc::CopyOnWriteBuffer buffer(kPacketWithTOAndAL);
+  ASSERT_TRUE(packet.Parse(buffer, &layout_cache));
+
+  // Same layout, other values.
+  buffer.MutableData()[19] = 0x42;
+  buffer.MutableData()[21] = 0x17;
+  ASSERT_TRUE(packet.Parse(buffer, &layout_cache));
+  EXPECT_EQ(packet.GetExtension<TransmissionOffset>(), 0x5642);
+  absl::optional<AudioLevel> audio_level =
+      packet.GetExtension<AudioLevelExtension>();
+  ASSERT_TRUE(audio_level);
+  EXPECT_FALSE(audio_level->voice_activity());
+  EXPECT_EQ(audio_level->level(), 0x17);
+}
+
+TEST(RtpPacketTest, ParseWithLayoutCacheDetectsOtherLayout) {
+  RtpPacketToSend::ExtensionManager extensions;
+  extensions.Register<TransmissionOffset>(kTransmissionOffsetExtensionId);
+  extensions.Register<AudioLevelExtension>(kAudioLevelExtensionId);
+  extensions.Register<RtpMid>(kRtpMidExtensionId);
+  RtpPacket::ExtensionLayoutCache layout_cache;
+  RtpPacketReceived packet(&extensions);
+  rtc::CopyOnWriteBuffer buffer(kPacketWithTOAndAL);
+  ASSERT_TRUE(packet.Parse(buffer, &layout_cache));
+
+  // Same size of extension block, but mid instead of audio level.
+  buffer.MutableData()[20] = (kRtpMidExtensionId << 4) | 1;
+  ASSERT_TRUE(packet.Parse(buffer, &layout_cache));
+  EXPECT_TRUE(packet.HasExtension<TransmissionOffset>());
+  EXPECT_FALSE(packet.HasExtension<AudioLevelExtension>());
+  EXPECT_TRUE(packet.HasExtension<RtpMid>());
+}
+
+TEST(RtpPacketTest, ParseWithLayoutCacheMatchesParseWithoutIt) {
+  RtpPacketToSend::ExtensionManager extensions(/*extmap_allow_mixed=*/true);
+  extensions.Register<TransmissionOffset>(kTransmissionOffsetExtensionId);
+  extensions.Register<AudioLevelExtension>(kAudioLevelExtensionId);
+  extensions.Register<RtpStreamId>(kRtpStreamIdExtensionId);
+  extensions.Register<RtpMid>(kRtpMidExtensionId);
+  extensions.Register<VideoTimingExtension>(kVideoTimingExtensionId);
+  extensions.Register<PlayoutDelayLimits>(kTwoByteExtensionId);
+  const rtc::ArrayView<const uint8_t> kPackets[] = {
+      kPacketWithTO,
+      kPacketWithTOAndAL,
+      kPacketWithTOAndALInvalidPadding,
+      kPacketWithTOAndALReservedExtensionId,
+      kPacketWithTwoByteExtensionIdFirst,
+      kPacketWithTwoByteExtensionIdLast,
+      kPacketWithRsid,
+      kPacketWithMid,
+      kPacket,
+      kPacketWithTwoByteHeaderExtension,
+      kPacketWithLongTwoByteHeaderExtension,
+      kPacketWithTwoByteHeaderExtensionWithPadding,
+      kPacketWithInvalidExtension,
+      kPacketWithLegacyTimingExtension};
+  const RTPExtensionType kTypes[] = {
+      kRtpExtensionTransmissionTimeOffset, kRtpExtensionAudioLevel,
+      kRtpExtensionRtpStreamId,           kRtpExtensionMid,
+      kRtpExtensionVideoTiming,           kRtpExtensionPlayoutDelay};
+
+  // Parses the packets in an order that both hits and misses the cache.
+  RtpPacket::ExtensionLayoutCache layout_cache;
+  Random random(0x1234);
+  for (int i = 0; i < 1000; ++i) {
+    rtc::ArrayView<const uint8_t> buffer =
+        kPackets[random.Rand(0, std::size(kPackets) - 1)];
+    RtpPacketReceived expected(&extensions);
+    RtpPacketReceived packet(&extensions);
+    ASSERT_TRUE(expected.Parse(buffer));
+    ASSERT_TRUE(packet.Parse(rtc::CopyOnWriteBuffer(buffer), &layout_cache));
+    EXPECT_EQ(packet.headers_size(), expected.headers_size());
+    for (RTPExtensionType type : kTypes) {
+      EXPECT_THAT(packet.FindExtension(type),
+                  ElementsAreArray(expected.FindExtension(type)));
+    }
+  }
+}
+
 struct UncopyableValue {
   UncopyableValue() = default;
   UncopyableValue(const UncopyableValue&) = delete;
@@ -38,6 +38,7 @@ class FrameEncryptorInterface;
 class RateLimiter;
 class RtcEventLog;
 class RTPSender;
+class RtpPacketToSendPool;
 class Transport;
 class VideoBitrateAllocationObserver;
 
@@ -95,6 +96,10 @@ class RtpRtcpInterface : public RtcpFeedbackSenderInterface {
     // Spread any bursts of packets into smaller bursts to minimize packet loss.
     RtpPacketSender* paced_sender = nullptr;
 
+    // If set, outgoing packets are taken from and given back to this pool.
+    // Must outlive the RTP module and any packets it has sent.
+    RtpPacketToSendPool* packet_pool = nullptr;
+
     // Generates FEC packets.
     // TODO(sprang): Wire up to RtpSenderEgress.
     VideoFecGenerator* fec_generator = nullptr;
@@ -27,6 +27,7 @@
 #include "modules/rtp_rtcp/include/rtp_packet_sender.h"
 #include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
 #include "modules/rtp_rtcp/source/rtp_packet_history.h"
+#include "modules/rtp_rtcp/source/rtp_packet_to_send_pool.h"
 #include "modules/rtp_rtcp/source/rtp_rtcp_config.h"
 #include "modules/rtp_rtcp/source/rtp_rtcp_interface.h"
 #include "rtc_base/random.h"
@@ -130,6 +131,14 @@ class RTPSender {
       rtc::ArrayView<const uint32_t> csrcs = {})
       RTC_LOCKS_EXCLUDED(send_mutex_);
 
+  // Copies a packet to be sent. The copy reuses a packet from the packet pool,
+  // if one is configured, and does not share the buffer of `packet`.
+  std::unique_ptr<RtpPacketToSend> CopyPacket(
+      const RtpPacketToSend& packet) const;
+
+  // Gives a packet that will not be sent back to the packet pool, if any.
+  void ReleasePacket(std::unique_ptr<RtpPacketToSend> packet) const;
+
   // Maximum header overhead per fec/padding packet.
   size_t FecOrPaddingPacketMaxRtpHeaderLength() const
       RTC_LOCKS_EXCLUDED(send_mutex_);
@@ -177,6 +186,7 @@ class RTPSender {
 
   RtpPacketHistory* const packet_history_;
   RtpPacketSender* const paced_sender_;
+  RtpPacketToSendPool* const packet_pool_;
 
   mutable Mutex send_mutex_;
 
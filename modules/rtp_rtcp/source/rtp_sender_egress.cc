@@ -97,6 +97,7 @@ RtpSenderEgress::RtpSenderEgress(const RtpRtcpInterface::Configuration& config,
                                          : absl::nullopt),
       populate_network2_timestamp_(config.populate_network2_timestamp),
       clock_(config.clock),
+      packet_pool_(config.packet_pool),
       packet_history_(packet_history),
       transport_(config.outgoing_transport),
       event_log_(config.event_log),
@@ -254,7 +255,7 @@ void RtpSenderEgress::OnBatchComplete() {
   packets_to_send_.clear();
 }
 
-void RtpSenderEgress::CompleteSendPacket(const Packet& compound_packet,
+void RtpSenderEgress::CompleteSendPacket(Packet& compound_packet,
                                          bool last_in_batch) {
   RTC_DCHECK_RUN_ON(worker_queue_);
   auto& [packet, pacing_info, now] = compound_packet;
@@ -295,15 +296,6 @@ void RtpSenderEgress::CompleteSendPacket(const Packet& compound_packet,
   options.last_packet_in_batch = last_in_batch;
   const bool send_success = SendPacketToNetwork(*packet, options, pacing_info);
 
-  // Put packet in retransmission history or update pending status even if
-  // actual sending fails.
-  if (is_media && packet->allow_retransmission()) {
-    packet_history_->PutRtpPacket(std::make_unique<RtpPacketToSend>(*packet),
-                                  now);
-  } else if (packet->retransmitted_sequence_number()) {
-    packet_history_->MarkPacketAsSent(*packet->retransmitted_sequence_number());
-  }
-
   if (send_success) {
     // `media_has_been_sent_` is used by RTPSender to figure out if it can send
     // padding in the absence of transport-cc or abs-send-time.
@@ -319,6 +311,20 @@ void RtpSenderEgress::CompleteSendPacket(const Packet& compound_packet,
     UpdateRtpStats(now, packet->Ssrc(), packet_type, std::move(counter),
                    packet->size());
   }
+
+  // Put packet in retransmission history or update pending status even if
+  // actual sending fails. The packet is not needed here any more, so it is
+  // handed over rather than copied.
+  if (is_media && packet->allow_retransmission()) {
+    packet_history_->PutRtpPacket(std::move(packet), now);
+    return;
+  }
+  if (packet->retransmitted_sequence_number()) {
+    packet_history_->MarkPacketAsSent(*packet->retransmitted_sequence_number());
+  }
+  if (packet_pool_) {
+    packet_pool_->Release(std::move(packet));
+  }
 }
 
 RtpSendRates RtpSenderEgress::GetSendRates(Timestamp now) const {
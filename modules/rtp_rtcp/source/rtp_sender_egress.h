@@ -29,6 +29,7 @@
 #include "modules/rtp_rtcp/source/packet_sequencer.h"
 #include "modules/rtp_rtcp/source/rtp_packet_history.h"
 #include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
+#include "modules/rtp_rtcp/source/rtp_packet_to_send_pool.h"
 #include "modules/rtp_rtcp/source/rtp_rtcp_interface.h"
 #include "modules/rtp_rtcp/source/rtp_sequence_number_map.h"
 #include "rtc_base/bitrate_tracker.h"
@@ -107,7 +108,7 @@ class RtpSenderEgress {
     PacedPacketInfo info;
     Timestamp now;
   };
-  void CompleteSendPacket(const Packet& compound_packet, bool last_in_batch);
+  void CompleteSendPacket(Packet& compound_packet, bool last_in_batch);
   bool HasCorrectSsrc(const RtpPacketToSend& packet) const;
 
   // Sends packet on to `transport_`, leaving the RTP module.
@@ -130,6 +131,7 @@ class RtpSenderEgress {
   const absl::optional<uint32_t> flexfec_ssrc_;
   const bool populate_network2_timestamp_;
   Clock* const clock_;
+  RtpPacketToSendPool* const packet_pool_;
   RtpPacketHistory* const packet_history_ RTC_GUARDED_BY(worker_queue_);
   Transport* const transport_;
   RtcEventLog* const event_log_;
@@ -552,9 +552,9 @@ bool RTPSenderVideo::SendVideo(int payload_type,
             video_header.absolute_capture_time->estimated_capture_clock_offset);
   }
 
-  auto first_packet = std::make_unique<RtpPacketToSend>(*single_packet);
-  auto middle_packet = std::make_unique<RtpPacketToSend>(*single_packet);
-  auto last_packet = std::make_unique<RtpPacketToSend>(*single_packet);
+  auto first_packet = rtp_sender_->CopyPacket(*single_packet);
+  auto middle_packet = rtp_sender_->CopyPacket(*single_packet);
+  auto last_packet = rtp_sender_->CopyPacket(*single_packet);
   // Simplest way to estimate how much extensions would occupy is to set them.
   AddRtpHeaderExtensions(video_header,
                          /*first_packet=*/true, /*last_packet=*/true,
@@ -666,7 +666,7 @@ bool RTPSenderVideo::SendVideo(int payload_type,
       expected_payload_capacity =
           limits.max_payload_len - limits.last_packet_reduction_len;
     } else {
-      packet = std::make_unique<RtpPacketToSend>(*middle_packet);
+      packet = rtp_sender_->CopyPacket(*middle_packet);
       expected_payload_capacity = limits.max_payload_len;
     }
 
@@ -690,7 +690,8 @@ bool RTPSenderVideo::SendVideo(int payload_type,
     if (red_enabled()) {
       // TODO(sprang): Consider packetizing directly into packets with the RED
       // header already in place, to avoid this copy.
-      std::unique_ptr<RtpPacketToSend> red_packet(new RtpPacketToSend(*packet));
+      std::unique_ptr<RtpPacketToSend> red_packet =
+          rtp_sender_->CopyPacket(*packet);
       BuildRedPayload(*packet, red_packet.get());
       red_packet->SetPayloadType(*red_payload_type_);
       red_packet->set_is_red(true);
@@ -699,6 +700,7 @@ bool RTPSenderVideo::SendVideo(int payload_type,
       red_packet->set_packet_type(RtpPacketMediaType::kVideo);
       red_packet->set_allow_retransmission(packet->allow_retransmission());
       rtp_packets.emplace_back(std::move(red_packet));
+      rtp_sender_->ReleasePacket(std::move(packet));
     } else {
       packet->set_packet_type(RtpPacketMediaType::kVideo);
       rtp_packets.emplace_back(std::move(packet));
@@ -716,6 +718,12 @@ bool RTPSenderVideo::SendVideo(int payload_type,
     }
   }
 
+  // Give back the packet templates that were not used for sending.
+  rtp_sender_->ReleasePacket(std::move(single_packet));
+  rtp_sender_->ReleasePacket(std::move(first_packet));
+  rtp_sender_->ReleasePacket(std::move(middle_packet));
+  rtp_sender_->ReleasePacket(std::move(last_packet));
+
   LogAndSendToNetwork(std::move(rtp_packets), encoder_output_size);
 
   // Update details about the last sent frame.
@@ -0,0 +1,357 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/video_coding/adaptive_fec_controller.h"
+
+#include <math.h>
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+
+#include "modules/rtp_rtcp/source/forward_error_correction.h"
+#include "modules/rtp_rtcp/source/forward_error_correction_internal.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+namespace {
+
+// Number of most recent packets whose loss is remembered, and the number
+// needed before the loss history is used.
+constexpr size_t kLossHistorySize = 2000;
+constexpr size_t kMinLossHistorySize = 200;
+
+// FEC rates, in Q8, to choose from.
+constexpr int kCandidateFecRates[] = {16, 32, 48, 64, 96, 128, 192, 255};
+
+// Mean length of loss runs, in packets, from which the bursty mask is used.
+// It recovers runs of three or more lost packets better than the random mask,
+// which recovers shorter runs better.
+constexpr double kMinBurstyLossRunLength = 2.0;
+
+// Upper bound on the number of frames protected together, as for
+// VCMNackFecMethod.
+constexpr int kMaxFecFrames = 6;
+
+double MeanLossRunLength(const std::deque<bool>& loss_history) {
+  int num_lost_packets = 0;
+  int num_loss_runs = 0;
+  bool previous_lost = false;
+  for (bool lost : loss_history) {
+    if (lost) {
+      ++num_lost_packets;
+      if (!previous_lost) {
+        ++num_loss_runs;
+      }
+    }
+    previous_lost = lost;
+  }
+  return num_loss_runs > 0
+             ? static_cast<double>(num_lost_packets) / num_loss_runs
+             : 0.0;
+}
+
+// As UlpfecGenerator, which protects the packets of up to `max_fec_frames`
+// frames together, but fewer frames once there are enough media packets and
+// the FEC packets for them come close enough to the FEC rate.
+constexpr int kMaxExcessOverhead = 50;  // Q8.
+constexpr int kMinMediaPackets = 4;
+constexpr int kHighProtectionThreshold = 80;
+
+// Returns the number of frames of `packets_per_frame` packets that
+// UlpfecGenerator protects together at `fec_rate`.
+int NumFramesProtectedTogether(int packets_per_frame,
+                               int fec_rate,
+                               int max_fec_frames) {
+  int min_num_media_packets =
+      fec_rate > kHighProtectionThreshold ? kMinMediaPackets : 1;
+  if (packets_per_frame >= 2) {
+    ++min_num_media_packets;
+  }
+  for (int num_frames = 1; num_frames < max_fec_frames; ++num_frames) {
+    const int num_media_packets = num_frames * packets_per_frame;
+    if (num_media_packets + packets_per_frame >
+        static_cast<int>(kUlpfecMaxMediaPackets)) {
+      return num_frames;
+    }
+    const int num_fec_packets =
+        ForwardErrorCorrection::NumFecPackets(num_media_packets, fec_rate);
+    if ((num_fec_packets << 8) / num_media_packets - fec_rate <
+            kMaxExcessOverhead &&
+        num_media_packets >= min_num_media_packets) {
+      return num_frames;
+    }
+  }
+  return max_fec_frames;
+}
+
+// Returns the share of frames that would have lost media packets left after
+// FEC recovery, if sent when `loss_history` was seen. Frames have
+// `packets_per_frame` media packets, and the media packets of `num_frames`
+// frames are followed by `num_fec_packets` FEC packets protecting them.
+// ULPFEC and FlexFEC recover a packet from each received FEC packet that
+// protects exactly one missing packet, until no such FEC packet is left.
+// The history holds few loss events, so one more lost frame is counted than
+// seen. Of rates that leave no frame lost in the history, the cheapest one
+// then gives the lowest share.
+double ResidualFrameLoss(const std::deque<bool>& loss_history,
+                         int packets_per_frame,
+                         int num_frames,
+                         int num_fec_packets,
+                         FecMaskType fec_mask_type) {
+  const int num_media_packets = packets_per_frame * num_frames;
+  RTC_DCHECK_LE(num_media_packets, kUlpfecMaxMediaPackets);
+  uint64_t protected_packets[kUlpfecMaxMediaPackets] = {};
+  if (num_fec_packets > 0) {
+    internal::PacketMaskTable mask_table(fec_mask_type, num_media_packets);
+    uint8_t packet_masks[kFECPacketMaskMaxSize];
+    internal::GeneratePacketMasks(num_media_packets, num_fec_packets,
+                                  /*num_imp_packets=*/0,
+                                  /*use_unequal_protection=*/false,
+                                  &mask_table, packet_masks);
+    const size_t mask_size = internal::PacketMaskSize(num_media_packets);
+    for (int j = 0; j < num_fec_packets; ++j) {
+      for (int i = 0; i < num_media_packets; ++i) {
+        if (packet_masks[j * mask_size + i / 8] & (0x80 >> (i % 8))) {
+          protected_packets[j] |= uint64_t{1} << i;
+        }
+      }
+    }
+  }
+
+  const uint64_t frame_packets = (uint64_t{1} << packets_per_frame) - 1;
+  const size_t block_size = num_media_packets + num_fec_packets;
+  int num_frames_sent = 0;
+  int num_frames_lost = 0;
+  for (size_t start = 0; start + block_size <= loss_history.size();
+       start += block_size) {
+    uint64_t lost_media_packets = 0;
+    for (int i = 0; i < num_media_packets; ++i) {
+      if (loss_history[start + i]) {
+        lost_media_packets |= uint64_t{1} << i;
+      }
+    }
+    bool recovered_any = true;
+    while (lost_media_packets != 0 && recovered_any) {
+      recovered_any = false;
+      for (int j = 0; j < num_fec_packets; ++j) {
+        if (loss_history[start + num_media_packets + j]) {
+          continue;
+        }
+        const uint64_t missing = lost_media_packets & protected_packets[j];
+        if (missing != 0 && (missing & (missing - 1)) == 0) {
+          lost_media_packets &= ~missing;
+          recovered_any = true;
+        }
+      }
+    }
+    num_frames_sent += num_frames;
+    for (int i = 0; i < num_frames; ++i) {
+      if (lost_media_packets & (frame_packets << (i * packets_per_frame))) {
+        ++num_frames_lost;
+      }
+    }
+  }
+  return static_cast<double>(num_frames_lost + 1) / (num_frames_sent + 1);
+}
+
+}  // namespace
+
+AdaptiveFecController::AdaptiveFecController(
+    const Environment& env,
+    VCMProtectionCallback* protection_callback)
+    : fallback_(env, protection_callback),
+      protection_callback_(protection_callback),
+      overhead_threshold_(fallback_.GetProtectionOverheadRateThreshold()),
+      packets_per_delta_frame_(0.9f),
+      packets_per_key_frame_(0.9f) {}
+
+AdaptiveFecController::AdaptiveFecController(const Environment& env)
+    : AdaptiveFecController(env, nullptr) {}
+
+AdaptiveFecController::~AdaptiveFecController() = default;
+
+void AdaptiveFecController::SetProtectionCallback(
+    VCMProtectionCallback* protection_callback) {
+  protection_callback_ = protection_callback;
+  fallback_.SetProtectionCallback(protection_callback);
+}
+
+void AdaptiveFecController::SetProtectionMethod(bool enable_fec,
+                                                bool enable_nack) {
+  fallback_.SetProtectionMethod(enable_fec, enable_nack);
+  MutexLock lock(&mutex_);
+  enable_fec_ = enable_fec;
+  enable_nack_ = enable_nack;
+}
+
+void AdaptiveFecController::SetEncodingData(size_t width,
+                                            size_t height,
+                                            size_t num_temporal_layers,
+                                            size_t max_payload_size) {
+  fallback_.SetEncodingData(width, height, num_temporal_layers,
+                            max_payload_size);
+  MutexLock lock(&mutex_);
+  max_payload_size_ = max_payload_size;
+}
+
+uint32_t AdaptiveFecController::UpdateFecRates(
+    uint32_t estimated_bitrate_bps,
+    int actual_framerate_fps,
+    uint8_t fraction_lost,
+    std::vector<bool> loss_mask_vector,
+    int64_t round_trip_time_ms) {
+  FecProtectionParams delta_fec_params;
+  FecProtectionParams key_fec_params;
+  bool use_fallback = false;
+  {
+    MutexLock lock(&mutex_);
+    loss_history_.insert(loss_history_.end(), loss_mask_vector.begin(),
+                         loss_mask_vector.end());
+    if (loss_history_.size() > kLossHistorySize) {
+      loss_history_.erase(loss_history_.begin(),
+                          loss_history_.end() - kLossHistorySize);
+    }
+    if (loss_history_.size() < kMinLossHistorySize) {
+      // Not enough history of the loss pattern yet, e.g. since there is no
+      // transport feedback.
+      use_fallback = true;
+    } else if (!enable_fec_ && !enable_nack_) {
+      return estimated_bitrate_bps;
+    } else if (enable_fec_ &&
+               !(enable_nack_ && round_trip_time_ms < kMaxNackOnlyRttMs)) {
+      const float packets_per_delta_frame =
+          packets_per_delta_frame_.filtered() !=
+                  rtc::ExpFilter::kValueUndefined
+              ? packets_per_delta_frame_.filtered()
+              : 1.0f;
+      const float packets_per_key_frame =
+          packets_per_key_frame_.filtered() != rtc::ExpFilter::kValueUndefined
+              ? packets_per_key_frame_.filtered()
+              : packets_per_delta_frame;
+      // As VCMNackFecMethod, protect up to the frames sent in two round
+      // trips together, for complete frames within one round trip on
+      // average.
+      const int max_fec_frames = std::clamp(
+          static_cast<int>(2 * actual_framerate_fps * round_trip_time_ms /
+                               1000.0 +
+                           0.5),
+          1, kMaxFecFrames);
+      delta_fec_params =
+          SelectParams(packets_per_delta_frame, max_fec_frames);
+      key_fec_params = SelectParams(packets_per_key_frame, max_fec_frames);
+      // Key frames are at least as well protected as delta frames.
+      if (key_fec_params.fec_rate < delta_fec_params.fec_rate) {
+        key_fec_params = delta_fec_params;
+      }
+    }
+  }
+  if (use_fallback) {
+    return fallback_.UpdateFecRates(estimated_bitrate_bps, actual_framerate_fps,
+                                    fraction_lost, std::move(loss_mask_vector),
+                                    round_trip_time_ms);
+  }
+
+  // Update protection callback with protection settings.
+  uint32_t sent_video_rate_bps = 0;
+  uint32_t sent_nack_rate_bps = 0;
+  uint32_t sent_fec_rate_bps = 0;
+  protection_callback_->ProtectionRequest(
+      &delta_fec_params, &key_fec_params, &sent_video_rate_bps,
+      &sent_nack_rate_bps, &sent_fec_rate_bps);
+  // As FecControllerDefault, estimate the overhead of the next second as the
+  // share of protection in what was sent, capped to a threshold.
+  float protection_overhead_rate = 0.0f;
+  uint32_t sent_total_rate_bps =
+      sent_video_rate_bps + sent_nack_rate_bps + sent_fec_rate_bps;
+  if (sent_total_rate_bps > 0) {
+    protection_overhead_rate =
+        static_cast<float>(sent_nack_rate_bps + sent_fec_rate_bps) /
+        sent_total_rate_bps;
+  }
+  protection_overhead_rate =
+      std::min(protection_overhead_rate, overhead_threshold_);
+  return estimated_bitrate_bps * (1.0 - protection_overhead_rate);
+}
+
+void AdaptiveFecController::UpdateWithEncodedData(
+    size_t encoded_image_length,
+    VideoFrameType encoded_image_frametype) {
+  fallback_.UpdateWithEncodedData(encoded_image_length,
+                                  encoded_image_frametype);
+  MutexLock lock(&mutex_);
+  if (encoded_image_length == 0 || max_payload_size_ == 0) {
+    return;
+  }
+  const float num_packets =
+      ceilf(encoded_image_length / static_cast<float>(max_payload_size_));
+  if (encoded_image_frametype == VideoFrameType::kVideoFrameKey) {
+    packets_per_key_frame_.Apply(1.0f, num_packets);
+  } else {
+    packets_per_delta_frame_.Apply(1.0f, num_packets);
+  }
+}
+
+bool AdaptiveFecController::UseLossVectorMask() {
+  return true;
+}
+
+FecProtectionParams AdaptiveFecController::SelectParams(
+    float packets_per_frame,
+    int max_fec_frames) const {
+  const int num_packets_per_frame =
+      std::clamp(static_cast<int>(lroundf(packets_per_frame)), 1,
+                 static_cast<int>(kUlpfecMaxMediaPackets));
+  // The bursty mask recovers consecutive losses better, and the random one
+  // scattered losses. Telling them apart by replaying the history would take
+  // far more loss events than it holds.
+  const FecMaskType fec_mask_type =
+      MeanLossRunLength(loss_history_) >= kMinBurstyLossRunLength
+          ? kFecMaskBursty
+          : kFecMaskRandom;
+  FecProtectionParams params;
+  params.fec_rate = 0;
+  params.max_fec_frames = max_fec_frames;
+  params.fec_mask_type = fec_mask_type;
+  double residual_frame_loss =
+      ResidualFrameLoss(loss_history_, num_packets_per_frame, /*num_frames=*/1,
+                        /*num_fec_packets=*/0, fec_mask_type);
+
+  // Use the rate that leaves the fewest frames with unrecovered packets.
+  for (int fec_rate : kCandidateFecRates) {
+    const int num_frames = NumFramesProtectedTogether(num_packets_per_frame,
+                                                      fec_rate, max_fec_frames);
+    const int num_media_packets = num_frames * num_packets_per_frame;
+    const int num_fec_packets =
+        ForwardErrorCorrection::NumFecPackets(num_media_packets, fec_rate);
+    // As FecControllerDefault, the threshold caps the share of FEC in all
+    // that is sent.
+    if (num_fec_packets >
+        overhead_threshold_ * (num_media_packets + num_fec_packets)) {
+      break;
+    }
+    double residual =
+        ResidualFrameLoss(loss_history_, num_packets_per_frame, num_frames,
+                          num_fec_packets, fec_mask_type);
+    if (residual < residual_frame_loss) {
+      residual_frame_loss = residual;
+      params.fec_rate = fec_rate;
+    }
+  }
+  return params;
+}
+
+std::unique_ptr<FecController>
+AdaptiveFecControllerFactory::CreateFecController(const Environment& env) {
+  return std::make_unique<AdaptiveFecController>(env);
+}
+
+}  // namespace webrtc
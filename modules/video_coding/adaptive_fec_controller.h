@@ -0,0 +1,100 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_VIDEO_CODING_ADAPTIVE_FEC_CONTROLLER_H_
+#define MODULES_VIDEO_CODING_ADAPTIVE_FEC_CONTROLLER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <deque>
+#include <memory>
+#include <vector>
+
+#include "api/environment/environment.h"
+#include "api/fec_controller.h"
+#include "modules/include/module_fec_types.h"
+#include "modules/video_coding/fec_controller_default.h"
+#include "rtc_base/numerics/exp_filter.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+// FecController that picks the FEC mask type and rate from the loss pattern
+// seen in transport feedback, instead of from tables keyed on the loss rate.
+// The bursty mask is used when losses come in runs. The candidate rates are
+// replayed against the recent loss history, which captures the loss bursts,
+// and the one that leaves the fewest frames with unrecovered packets is used.
+// As in FecControllerDefault, the frames sent in about two round trips are
+// protected together. With NACK enabled and a low RTT, FEC is off and
+// retransmissions are relied on.
+//
+// Until enough loss history is received, e.g. without transport feedback, it
+// behaves as FecControllerDefault.
+class AdaptiveFecController : public FecController {
+ public:
+  // The RTT below which NACK alone is used, when enabled.
+  static constexpr int64_t kMaxNackOnlyRttMs = 50;
+
+  AdaptiveFecController(const Environment& env,
+                        VCMProtectionCallback* protection_callback);
+  explicit AdaptiveFecController(const Environment& env);
+
+  AdaptiveFecController(const AdaptiveFecController&) = delete;
+  AdaptiveFecController& operator=(const AdaptiveFecController&) = delete;
+
+  ~AdaptiveFecController() override;
+
+  void SetProtectionCallback(
+      VCMProtectionCallback* protection_callback) override;
+  void SetProtectionMethod(bool enable_fec, bool enable_nack) override;
+  void SetEncodingData(size_t width,
+                       size_t height,
+                       size_t num_temporal_layers,
+                       size_t max_payload_size) override;
+  uint32_t UpdateFecRates(uint32_t estimated_bitrate_bps,
+                          int actual_framerate_fps,
+                          uint8_t fraction_lost,
+                          std::vector<bool> loss_mask_vector,
+                          int64_t round_trip_time_ms) override;
+  void UpdateWithEncodedData(size_t encoded_image_length,
+                             VideoFrameType encoded_image_frametype) override;
+  bool UseLossVectorMask() override;
+
+ private:
+  // Returns the parameters for frames of `packets_per_frame` packets, given
+  // the loss history, protecting up to `max_fec_frames` frames together.
+  FecProtectionParams SelectParams(float packets_per_frame,
+                                   int max_fec_frames) const
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  FecControllerDefault fallback_;
+  VCMProtectionCallback* protection_callback_;
+  const float overhead_threshold_;
+
+  Mutex mutex_;
+  bool enable_fec_ RTC_GUARDED_BY(mutex_) = false;
+  bool enable_nack_ RTC_GUARDED_BY(mutex_) = false;
+  size_t max_payload_size_ RTC_GUARDED_BY(mutex_) = 1460;
+  rtc::ExpFilter packets_per_delta_frame_ RTC_GUARDED_BY(mutex_);
+  rtc::ExpFilter packets_per_key_frame_ RTC_GUARDED_BY(mutex_);
+  // Whether each of the most recent packets was lost, oldest first.
+  std::deque<bool> loss_history_ RTC_GUARDED_BY(mutex_);
+};
+
+class AdaptiveFecControllerFactory : public FecControllerFactoryInterface {
+ public:
+  std::unique_ptr<FecController> CreateFecController(
+      const Environment& env) override;
+};
+
+}  // namespace webrtc
+#endif  // MODULES_VIDEO_CODING_ADAPTIVE_FEC_CONTROLLER_H_
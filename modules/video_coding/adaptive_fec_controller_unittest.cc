@@ -0,0 +1,223 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/video_coding/adaptive_fec_controller.h"
+
+#include <stdint.h>
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "api/environment/environment_factory.h"
+#include "modules/include/module_fec_types.h"
+#include "rtc_base/random.h"
+#include "system_wrappers/include/clock.h"
+#include "test/explicit_key_value_config.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+constexpr uint32_t kCodecBitrateBps = 100000;
+constexpr uint32_t kMaxBitrateBps = 130000;
+constexpr size_t kMaxPayloadSize = 1000;
+constexpr int kPacketsPerFrame = 10;
+
+class ProtectionCallback : public VCMProtectionCallback {
+ public:
+  int ProtectionRequest(const FecProtectionParams* delta_params,
+                        const FecProtectionParams* key_params,
+                        uint32_t* sent_video_rate_bps,
+                        uint32_t* sent_nack_rate_bps,
+                        uint32_t* sent_fec_rate_bps) override {
+    delta_params_ = *delta_params;
+    key_params_ = *key_params;
+    ++num_requests_;
+    *sent_video_rate_bps = kCodecBitrateBps;
+    *sent_nack_rate_bps = 0;
+    *sent_fec_rate_bps = fec_rate_bps_;
+    return 0;
+  }
+  void SetRetransmissionMode(int retransmission_mode) override {}
+
+  FecProtectionParams delta_params_;
+  FecProtectionParams key_params_;
+  int num_requests_ = 0;
+  uint32_t fec_rate_bps_ = 0;
+};
+
+// Loss of packets in bursts of `burst_length` that start with
+// `burst_probability`.
+std::vector<bool> BurstyLoss(Random& random,
+                             int num_packets,
+                             double burst_probability,
+                             int burst_length) {
+  std::vector<bool> loss_mask(num_packets, false);
+  for (int i = 0; i < num_packets; ++i) {
+    if (random.Rand<double>() < burst_probability) {
+      for (int j = i; j < i + burst_length && j < num_packets; ++j) {
+        loss_mask[j] = true;
+      }
+      i += burst_length;
+    }
+  }
+  return loss_mask;
+}
+
+class AdaptiveFecControllerTest : public ::testing::Test {
+ protected:
+  AdaptiveFecControllerTest()
+      : clock_(1000),
+        random_(0x1234),
+        fec_controller_(CreateEnvironment(&clock_), &protection_callback_) {
+    fec_controller_.SetEncodingData(640, 480, 1, kMaxPayloadSize);
+    for (int i = 0; i < 10; ++i) {
+      fec_controller_.UpdateWithEncodedData(kPacketsPerFrame * kMaxPayloadSize,
+                                            VideoFrameType::kVideoFrameDelta);
+    }
+  }
+
+  uint32_t Update(std::vector<bool> loss_mask, int64_t rtt_ms = 100) {
+    return fec_controller_.UpdateFecRates(kMaxBitrateBps, 30, 0,
+                                          std::move(loss_mask), rtt_ms);
+  }
+
+  SimulatedClock clock_;
+  Random random_;
+  ProtectionCallback protection_callback_;
+  AdaptiveFecController fec_controller_;
+};
+
+TEST_F(AdaptiveFecControllerTest, UsesLossVectorMask) {
+  EXPECT_TRUE(fec_controller_.UseLossVectorMask());
+}
+
+TEST_F(AdaptiveFecControllerTest, BehavesAsDefaultWithoutLossHistory) {
+  fec_controller_.SetProtectionMethod(/*enable_fec=*/true,
+                                      /*enable_nack=*/false);
+  protection_callback_.fec_rate_bps_ = kCodecBitrateBps / 10;
+  uint32_t target_bitrate = Update({});
+  EXPECT_EQ(protection_callback_.num_requests_, 1);
+  EXPECT_GT(target_bitrate, 0u);
+  EXPECT_GT(kMaxBitrateBps, target_bitrate);
+}
+
+TEST_F(AdaptiveFecControllerTest, NoFecWithoutLoss) {
+  fec_controller_.SetProtectionMethod(/*enable_fec=*/true,
+                                      /*enable_nack=*/false);
+  EXPECT_EQ(Update(std::vector<bool>(1000, false)), kMaxBitrateBps);
+  EXPECT_EQ(protection_callback_.delta_params_.fec_rate, 0);
+  EXPECT_EQ(protection_callback_.key_params_.fec_rate, 0);
+}
+
+TEST_F(AdaptiveFecControllerTest, NoProtection) {
+  fec_controller_.SetProtectionMethod(/*enable_fec=*/false,
+                                      /*enable_nack=*/false);
+  EXPECT_EQ(Update(BurstyLoss(random_, 1000, 0.05, 1)), kMaxBitrateBps);
+  EXPECT_EQ(protection_callback_.num_requests_, 0);
+}
+
+TEST_F(AdaptiveFecControllerTest, ProtectsIsolatedLossesWithRandomMask) {
+  fec_controller_.SetProtectionMethod(/*enable_fec=*/true,
+                                      /*enable_nack=*/false);
+  protection_callback_.fec_rate_bps_ = kCodecBitrateBps / 10;
+  uint32_t target_bitrate = Update(BurstyLoss(random_, 2000, 0.02, 1));
+  EXPECT_GT(protection_callback_.delta_params_.fec_rate, 0);
+  EXPECT_LE(protection_callback_.delta_params_.fec_rate, 64);
+  EXPECT_EQ(protection_callback_.delta_params_.fec_mask_type, kFecMaskRandom);
+  EXPECT_LT(target_bitrate, kMaxBitrateBps);
+}
+
+TEST_F(AdaptiveFecControllerTest, ProtectsLossBurstsWithBurstyMask) {
+  fec_controller_.SetProtectionMethod(/*enable_fec=*/true,
+                                      /*enable_nack=*/false);
+  Update(BurstyLoss(random_, 2000, 0.01, 3));
+  EXPECT_GT(protection_callback_.delta_params_.fec_rate, 0);
+  EXPECT_EQ(protection_callback_.delta_params_.fec_mask_type, kFecMaskBursty);
+}
+
+TEST_F(AdaptiveFecControllerTest, ProtectsKeyFramesAtLeastAsDeltaFrames) {
+  fec_controller_.SetProtectionMethod(/*enable_fec=*/true,
+                                      /*enable_nack=*/false);
+  fec_controller_.UpdateWithEncodedData(40 * kMaxPayloadSize,
+                                        VideoFrameType::kVideoFrameKey);
+  Update(BurstyLoss(random_, 2000, 0.02, 2));
+  EXPECT_GT(protection_callback_.delta_params_.fec_rate, 0);
+  EXPECT_GE(protection_callback_.key_params_.fec_rate,
+            protection_callback_.delta_params_.fec_rate);
+}
+
+TEST_F(AdaptiveFecControllerTest, LimitsOverheadToThreshold) {
+  test::ExplicitKeyValueConfig field_trials(
+      "WebRTC-ProtectionOverheadRateThreshold/0.2/");
+  AdaptiveFecController fec_controller(CreateEnvironment(&field_trials),
+                                       &protection_callback_);
+  fec_controller.SetEncodingData(640, 480, 1, kMaxPayloadSize);
+  for (int i = 0; i < 10; ++i) {
+    fec_controller.UpdateWithEncodedData(kPacketsPerFrame * kMaxPayloadSize,
+                                         VideoFrameType::kVideoFrameDelta);
+  }
+  fec_controller.SetProtectionMethod(/*enable_fec=*/true,
+                                     /*enable_nack=*/false);
+  fec_controller.UpdateFecRates(kMaxBitrateBps, 30, 0,
+                                BurstyLoss(random_, 2000, 0.2, 2),
+                                /*round_trip_time_ms=*/100);
+  // At most 2 FEC packets for 10 media packets.
+  EXPECT_GT(protection_callback_.delta_params_.fec_rate, 0);
+  EXPECT_LE(protection_callback_.delta_params_.fec_rate, 64);
+}
+
+TEST_F(AdaptiveFecControllerTest, ProtectsFramesOfTwoRoundTripsTogether) {
+  fec_controller_.SetProtectionMethod(/*enable_fec=*/true,
+                                      /*enable_nack=*/false);
+  std::vector<bool> loss_mask = BurstyLoss(random_, 2000, 0.02, 2);
+  Update(loss_mask, /*rtt_ms=*/10);
+  EXPECT_EQ(protection_callback_.delta_params_.max_fec_frames, 1);
+
+  // Three frames are sent in two round trips of 50 ms at 30 fps.
+  Update(loss_mask, /*rtt_ms=*/50);
+  EXPECT_EQ(protection_callback_.delta_params_.max_fec_frames, 3);
+
+  Update(loss_mask, /*rtt_ms=*/500);
+  EXPECT_EQ(protection_callback_.delta_params_.max_fec_frames, 6);
+}
+
+TEST_F(AdaptiveFecControllerTest, ProtectsSinglePacketFrames) {
+  for (int i = 0; i < 50; ++i) {
+    fec_controller_.UpdateWithEncodedData(kMaxPayloadSize / 2,
+                                          VideoFrameType::kVideoFrameDelta);
+  }
+  fec_controller_.SetProtectionMethod(/*enable_fec=*/true,
+                                      /*enable_nack=*/false);
+  Update(BurstyLoss(random_, 2000, 0.02, 1));
+  EXPECT_GT(protection_callback_.delta_params_.fec_rate, 0);
+}
+
+TEST_F(AdaptiveFecControllerTest, UsesNackAloneAtLowRtt) {
+  fec_controller_.SetProtectionMethod(/*enable_fec=*/true,
+                                      /*enable_nack=*/true);
+  std::vector<bool> loss_mask = BurstyLoss(random_, 2000, 0.02, 1);
+  Update(loss_mask, /*rtt_ms=*/20);
+  EXPECT_EQ(protection_callback_.delta_params_.fec_rate, 0);
+
+  Update(loss_mask, /*rtt_ms=*/200);
+  EXPECT_GT(protection_callback_.delta_params_.fec_rate, 0);
+}
+
+TEST_F(AdaptiveFecControllerTest, FactoryCreatesAdaptiveFecController) {
+  AdaptiveFecControllerFactory factory;
+  std::unique_ptr<FecController> fec_controller =
+      factory.CreateFecController(CreateEnvironment(&clock_));
+  EXPECT_TRUE(fec_controller->UseLossVectorMask());
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -21,16 +21,33 @@
 #include "rtc_base/async_tcp_socket.h"
 #include "rtc_base/async_udp_socket.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/experiments/field_trial_parser.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/socket.h"
 #include "rtc_base/socket_adapters.h"
 #include "rtc_base/ssl_adapter.h"
 
 namespace rtc {
+namespace {
+
+size_t UdpReceiveBatchSize(const webrtc::FieldTrialsView* field_trials) {
+  if (!field_trials) {
+    return 1;
+  }
+  webrtc::FieldTrialFlag enabled("Enabled");
+  webrtc::FieldTrialConstrained<int> size("size", 16, 1, 64);
+  webrtc::ParseFieldTrial({&enabled, &size},
+                          field_trials->Lookup("WebRTC-UdpReceiveBatching"));
+  return enabled ? size.Get() : 1;
+}
+
+}  // namespace
 
 BasicPacketSocketFactory::BasicPacketSocketFactory(
-    SocketFactory* socket_factory)
-    : socket_factory_(socket_factory) {}
+    SocketFactory* socket_factory,
+    const webrtc::FieldTrialsView* field_trials)
+    : socket_factory_(socket_factory),
+      udp_receive_batch_size_(UdpReceiveBatchSize(field_trials)) {}
 
 BasicPacketSocketFactory::~BasicPacketSocketFactory() {}
 
@@ -48,7 +65,11 @@ AsyncPacketSocket* BasicPacketSocketFactory::CreateUdpSocket(
     delete socket;
     return NULL;
   }
-  return new AsyncUDPSocket(socket);
+  AsyncUDPSocket* udp_socket = new AsyncUDPSocket(socket);
+  if (udp_receive_batch_size_ > 1) {
+    udp_socket->SetMaxReceiveBatchSize(udp_receive_batch_size_);
+  }
+  return udp_socket;
 }
 
 AsyncListenSocket* BasicPacketSocketFactory::CreateServerTcpSocket(
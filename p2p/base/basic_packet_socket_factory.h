@@ -17,6 +17,7 @@
 #include <string>
 
 #include "api/async_dns_resolver.h"
+#include "api/field_trials_view.h"
 #include "api/packet_socket_factory.h"
 #include "rtc_base/async_packet_socket.h"
 #include "rtc_base/socket.h"
@@ -30,7 +31,12 @@ class SocketFactory;
 
 class RTC_EXPORT BasicPacketSocketFactory : public PacketSocketFactory {
  public:
-  explicit BasicPacketSocketFactory(SocketFactory* socket_factory);
+  // With the "WebRTC-UdpReceiveBatching" field trial enabled in
+  // `field_trials`, UDP sockets read up to "size" (default 16) datagrams per
+  // read event, see AsyncUDPSocket::SetMaxReceiveBatchSize.
+  explicit BasicPacketSocketFactory(
+      SocketFactory* socket_factory,
+      const webrtc::FieldTrialsView* field_trials = nullptr);
   ~BasicPacketSocketFactory() override;
 
   AsyncPacketSocket* CreateUdpSocket(const SocketAddress& local_address,
@@ -55,6 +61,7 @@ class RTC_EXPORT BasicPacketSocketFactory : public PacketSocketFactory {
                  uint16_t max_port);
 
   SocketFactory* socket_factory_;
+  const size_t udp_receive_batch_size_;
 };
 
 }  // namespace rtc
@@ -0,0 +1,94 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "p2p/base/basic_packet_socket_factory.h"
+
+#include <memory>
+#include <vector>
+
+#include "api/array_view.h"
+#include "api/field_trials_view.h"
+#include "rtc_base/async_packet_socket.h"
+#include "rtc_base/gunit.h"
+#include "rtc_base/ip_address.h"
+#include "rtc_base/network/received_packet.h"
+#include "rtc_base/physical_socket_server.h"
+#include "rtc_base/socket.h"
+#include "rtc_base/socket_address.h"
+#include "rtc_base/thread.h"
+#include "test/gtest.h"
+#include "test/scoped_key_value_config.h"
+
+namespace rtc {
+namespace {
+
+constexpr int kTimeoutMs = 5000;
+constexpr int kNumPackets = 3;
+
+class BasicPacketSocketFactoryTest : public ::testing::Test {
+ protected:
+  BasicPacketSocketFactoryTest() : thread_(&socket_server_) {}
+
+  // Sends `kNumPackets` datagrams to a UDP socket from a factory created with
+  // `field_trials`, and returns the sizes of the batches they arrive in.
+  std::vector<size_t> ReceiveBatchSizes(
+      const webrtc::FieldTrialsView* field_trials) {
+    BasicPacketSocketFactory factory(&socket_server_, field_trials);
+    std::unique_ptr<AsyncPacketSocket> receiver(factory.CreateUdpSocket(
+        SocketAddress(IPAddress(INADDR_LOOPBACK), 0), 0, 0));
+    std::unique_ptr<Socket> sender(
+        socket_server_.CreateSocket(AF_INET, SOCK_DGRAM));
+    EXPECT_TRUE(receiver);
+    EXPECT_TRUE(sender);
+    if (!receiver || !sender ||
+        sender->Bind(SocketAddress(IPAddress(INADDR_LOOPBACK), 0)) != 0) {
+      return {};
+    }
+
+    std::vector<size_t> batch_sizes;
+    int received = 0;
+    receiver->RegisterReceivedPacketBatchCallback(
+        [&](AsyncPacketSocket* socket,
+            rtc::ArrayView<const ReceivedPacket> packets) {
+          batch_sizes.push_back(packets.size());
+          received += packets.size();
+        });
+    const char kData[] = "data";
+    for (int i = 0; i < kNumPackets; ++i) {
+      EXPECT_EQ(static_cast<int>(sizeof(kData)),
+                sender->SendTo(kData, sizeof(kData),
+                               receiver->GetLocalAddress()));
+    }
+    EXPECT_EQ_WAIT(kNumPackets, received, kTimeoutMs);
+    return batch_sizes;
+  }
+
+  PhysicalSocketServer socket_server_;
+  AutoSocketServerThread thread_;
+};
+
+TEST_F(BasicPacketSocketFactoryTest, ReadsOneDatagramPerEventByDefault) {
+  webrtc::test::ScopedKeyValueConfig field_trials;
+  EXPECT_EQ(ReceiveBatchSizes(&field_trials),
+            std::vector<size_t>(kNumPackets, 1));
+  EXPECT_EQ(ReceiveBatchSizes(nullptr), std::vector<size_t>(kNumPackets, 1));
+}
+
+#if defined(WEBRTC_LINUX)
+TEST_F(BasicPacketSocketFactoryTest, BatchesUdpReceivesWithFieldTrial) {
+  webrtc::test::ScopedKeyValueConfig field_trials(
+      "WebRTC-UdpReceiveBatching/Enabled,size:8/");
+  EXPECT_EQ(ReceiveBatchSizes(&field_trials),
+            std::vector<size_t>({kNumPackets}));
+}
+#endif
+
+}  // namespace
+}  // namespace rtc
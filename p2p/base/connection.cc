@@ -247,6 +247,7 @@ Connection::~Connection() {
   RTC_DCHECK_RUN_ON(network_thread_);
   RTC_DCHECK(!port_);
   RTC_DCHECK(!received_packet_callback_);
+  RTC_DCHECK(!received_packet_batch_callback_);
 }
 
 webrtc::TaskQueueBase* Connection::network_thread() const {
@@ -459,6 +460,42 @@ void Connection::DeregisterReceivedPacketCallback() {
   received_packet_callback_ = nullptr;
 }
 
+void Connection::RegisterReceivedPacketBatchCallback(
+    absl::AnyInvocable<void(Connection*,
+                            rtc::ArrayView<const rtc::ReceivedPacket>)>
+        received_packet_batch_callback) {
+  RTC_DCHECK_RUN_ON(network_thread_);
+  RTC_CHECK(!received_packet_batch_callback_);
+  received_packet_batch_callback_ = std::move(received_packet_batch_callback);
+}
+
+void Connection::DeregisterReceivedPacketBatchCallback() {
+  RTC_DCHECK_RUN_ON(network_thread_);
+  received_packet_batch_callback_ = nullptr;
+}
+
+void Connection::OnReadPackets(
+    rtc::ArrayView<const rtc::ReceivedPacket> packets) {
+  RTC_DCHECK_RUN_ON(network_thread_);
+  RTC_DCHECK(!collect_data_packets_);
+  collect_data_packets_ = true;
+  for (const rtc::ReceivedPacket& packet : packets) {
+    OnReadPacket(packet);
+  }
+  collect_data_packets_ = false;
+  DeliverCollectedDataPackets();
+}
+
+void Connection::DeliverCollectedDataPackets() {
+  if (collected_data_packets_.empty()) {
+    return;
+  }
+  if (received_packet_batch_callback_) {
+    received_packet_batch_callback_(this, collected_data_packets_);
+  }
+  collected_data_packets_.clear();
+}
+
 void Connection::OnReadPacket(const char* data,
                               size_t size,
                               int64_t packet_time_us) {
@@ -479,7 +516,13 @@ void Connection::OnReadPacket(const rtc::ReceivedPacket& packet) {
     UpdateReceiving(last_data_received_);
     recv_rate_tracker_.AddSamples(packet.payload().size());
     stats_.packets_received++;
-    if (received_packet_callback_) {
+    if (received_packet_batch_callback_) {
+      if (collect_data_packets_) {
+        collected_data_packets_.push_back(packet);
+      } else {
+        received_packet_batch_callback_(this, rtc::MakeArrayView(&packet, 1));
+      }
+    } else if (received_packet_callback_) {
       received_packet_callback_(this, packet);
     }
     // If timed out sending writability checks, start up again
@@ -495,6 +538,9 @@ void Connection::OnReadPacket(const rtc::ReceivedPacket& packet) {
     return;
   }
 
+  // Deliver data packets that arrived before this STUN message first.
+  DeliverCollectedDataPackets();
+
   // The packet is STUN and passed the Port checks.
   // Perform our own checks to ensure this packet is valid.
   // If this is a STUN request, then update the receiving bit and respond.
@@ -24,6 +24,7 @@
 #include "absl/functional/any_invocable.h"
 #include "absl/strings/string_view.h"
 #include "absl/types/optional.h"
+#include "api/array_view.h"
 #include "api/candidate.h"
 #include "api/rtc_error.h"
 #include "api/sequence_checker.h"
@@ -153,10 +154,21 @@ class RTC_EXPORT Connection : public CandidatePairInterface {
           received_packet_callback);
   void DeregisterReceivedPacketCallback();
 
+  // Register as a recipient of received data packets in batches. Takes
+  // precedence over the per-packet callback. There can only be one.
+  void RegisterReceivedPacketBatchCallback(
+      absl::AnyInvocable<void(Connection*,
+                              rtc::ArrayView<const rtc::ReceivedPacket>)>
+          received_packet_batch_callback);
+  void DeregisterReceivedPacketBatchCallback();
+
   sigslot::signal1<Connection*> SignalReadyToSend;
 
   // Called when a packet is received on this connection.
   void OnReadPacket(const rtc::ReceivedPacket& packet);
+  // Called when several packets are received on this connection at once. The
+  // data packets among them are delivered together to the batch callback.
+  void OnReadPackets(rtc::ArrayView<const rtc::ReceivedPacket> packets);
   [[deprecated("Pass a rtc::ReceivedPacket")]] void
   OnReadPacket(const char* data, size_t size, int64_t packet_time_us);
 
@@ -414,6 +426,9 @@ class RTC_EXPORT Connection : public CandidatePairInterface {
   int64_t last_send_data_ = 0;
 
  private:
+  // Hands the data packets collected by OnReadPackets() to the batch callback.
+  void DeliverCollectedDataPackets() RTC_RUN_ON(network_thread_);
+
   // Update the local candidate based on the mapped address attribute.
   // If the local candidate changed, fires SignalStateChange.
   void MaybeUpdateLocalCandidate(StunRequest* request, StunMessage* response)
@@ -512,6 +527,13 @@ class RTC_EXPORT Connection : public CandidatePairInterface {
       goog_delta_ack_consumer_;
   absl::AnyInvocable<void(Connection*, const rtc::ReceivedPacket&)>
       received_packet_callback_;
+  absl::AnyInvocable<void(Connection*,
+                          rtc::ArrayView<const rtc::ReceivedPacket>)>
+      received_packet_batch_callback_;
+  // Data packets collected by OnReadPackets().
+  bool collect_data_packets_ RTC_GUARDED_BY(network_thread_) = false;
+  std::vector<rtc::ReceivedPacket> collected_data_packets_
+      RTC_GUARDED_BY(network_thread_);
 };
 
 // ProxyConnection defers all the interesting work to the port.
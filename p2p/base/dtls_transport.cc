@@ -152,7 +152,7 @@ DtlsTransport::DtlsTransport(IceTransportInternal* ice_transport,
 
 DtlsTransport::~DtlsTransport() {
   if (ice_transport_) {
-    ice_transport_->DeregisterReceivedPacketCallback(this);
+    ice_transport_->DeregisterReceivedPacketBatchCallback(this);
   }
 }
 
@@ -523,10 +523,10 @@ void DtlsTransport::ConnectToIceTransport() {
   RTC_DCHECK(ice_transport_);
   ice_transport_->SignalWritableState.connect(this,
                                               &DtlsTransport::OnWritableState);
-  ice_transport_->RegisterReceivedPacketCallback(
+  ice_transport_->RegisterReceivedPacketBatchCallback(
       this, [&](rtc::PacketTransportInternal* transport,
-                const rtc::ReceivedPacket& packet) {
-        OnReadPacket(transport, packet);
+                rtc::ArrayView<const rtc::ReceivedPacket> packets) {
+        OnReadPackets(transport, packets);
       });
 
   ice_transport_->SignalSentPacket.connect(this, &DtlsTransport::OnSentPacket);
@@ -686,6 +686,45 @@ void DtlsTransport::OnReadPacket(rtc::PacketTransportInternal* transport,
   }
 }
 
+void DtlsTransport::OnReadPackets(
+    rtc::PacketTransportInternal* transport,
+    rtc::ArrayView<const rtc::ReceivedPacket> packets) {
+  RTC_DCHECK_RUN_ON(&thread_checker_);
+  RTC_DCHECK(transport == ice_transport_);
+
+  if (packets.size() == 1) {
+    OnReadPacket(transport, packets[0]);
+    return;
+  }
+  if (!dtls_active_) {
+    // Not doing DTLS.
+    NotifyPacketsReceived(packets);
+    return;
+  }
+
+  // Once the handshake is complete, consecutive SRTP packets are signalled
+  // upwards together. Everything else goes through OnReadPacket().
+  RTC_DCHECK(srtp_packets_.empty());
+  for (const rtc::ReceivedPacket& packet : packets) {
+    if (dtls_state() == webrtc::DtlsTransportState::kConnected &&
+        !IsDtlsPacket(packet.payload()) && IsRtpPacket(packet.payload())) {
+      RTC_DCHECK(!srtp_ciphers_.empty());
+      srtp_packets_.push_back(
+          packet.CopyAndSet(rtc::ReceivedPacket::kSrtpEncrypted));
+      continue;
+    }
+    if (!srtp_packets_.empty()) {
+      NotifyPacketsReceived(srtp_packets_);
+      srtp_packets_.clear();
+    }
+    OnReadPacket(transport, packet);
+  }
+  if (!srtp_packets_.empty()) {
+    NotifyPacketsReceived(srtp_packets_);
+    srtp_packets_.clear();
+  }
+}
+
 void DtlsTransport::OnSentPacket(rtc::PacketTransportInternal* transport,
                                  const rtc::SentPacket& sent_packet) {
   RTC_DCHECK_RUN_ON(&thread_checker_);
@@ -16,6 +16,7 @@
 #include <vector>
 
 #include "absl/strings/string_view.h"
+#include "api/array_view.h"
 #include "api/crypto/crypto_options.h"
 #include "api/dtls_transport_interface.h"
 #include "api/sequence_checker.h"
@@ -217,6 +218,8 @@ class DtlsTransport : public DtlsTransportInternal {
   void OnWritableState(rtc::PacketTransportInternal* transport);
   void OnReadPacket(rtc::PacketTransportInternal* transport,
                     const rtc::ReceivedPacket& packet);
+  void OnReadPackets(rtc::PacketTransportInternal* transport,
+                     rtc::ArrayView<const rtc::ReceivedPacket> packets);
   void OnSentPacket(rtc::PacketTransportInternal* transport,
                     const rtc::SentPacket& sent_packet);
   void OnReadyToSend(rtc::PacketTransportInternal* transport);
@@ -256,6 +259,9 @@ class DtlsTransport : public DtlsTransportInternal {
   // ice transport became writable, or before a remote fingerprint was received.
   rtc::Buffer cached_client_hello_;
 
+  // SRTP packets of a received batch that are passed on together.
+  std::vector<rtc::ReceivedPacket> srtp_packets_;
+
   bool receiving_ = false;
   bool writable_ = false;
 
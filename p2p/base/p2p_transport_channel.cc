@@ -258,9 +258,10 @@ void P2PTransportChannel::AddConnection(Connection* connection) {
   connection->set_unwritable_timeout(config_.ice_unwritable_timeout);
   connection->set_unwritable_min_checks(config_.ice_unwritable_min_checks);
   connection->set_inactive_timeout(config_.ice_inactive_timeout);
-  connection->RegisterReceivedPacketCallback(
-      [&](Connection* connection, const rtc::ReceivedPacket& packet) {
-        OnReadPacket(connection, packet);
+  connection->RegisterReceivedPacketBatchCallback(
+      [&](Connection* connection,
+          rtc::ArrayView<const rtc::ReceivedPacket> packets) {
+        OnReadPackets(connection, packets);
       });
   connection->SignalReadyToSend.connect(this,
                                         &P2PTransportChannel::OnReadyToSend);
@@ -2111,7 +2112,7 @@ void P2PTransportChannel::RemoveConnection(Connection* connection) {
   RTC_DCHECK_RUN_ON(network_thread_);
   auto it = absl::c_find(connections_, connection);
   RTC_DCHECK(it != connections_.end());
-  connection->DeregisterReceivedPacketCallback();
+  connection->DeregisterReceivedPacketBatchCallback();
   connections_.erase(it);
   connection->ClearStunDictConsumer();
   ice_controller_->OnConnectionDestroyed(connection);
@@ -2183,8 +2184,9 @@ bool P2PTransportChannel::PrunePort(PortInterface* port) {
 }
 
 // We data is available, let listeners know
-void P2PTransportChannel::OnReadPacket(Connection* connection,
-                                       const rtc::ReceivedPacket& packet) {
+void P2PTransportChannel::OnReadPackets(
+    Connection* connection,
+    rtc::ArrayView<const rtc::ReceivedPacket> packets) {
   RTC_DCHECK_RUN_ON(network_thread_);
   if (connection != selected_connection_ && !FindConnection(connection)) {
     // Do not deliver, if packet doesn't belong to the correct transport
@@ -2193,21 +2195,23 @@ void P2PTransportChannel::OnReadPacket(Connection* connection,
     return;
   }
 
-    // Let the client know of an incoming packet
-    packets_received_++;
+  // Let the client know of incoming packets
+  packets_received_ += packets.size();
+  for (const rtc::ReceivedPacket& packet : packets) {
     bytes_received_ += packet.payload().size();
-    RTC_DCHECK(connection->last_data_received() >= last_data_received_ms_);
-    last_data_received_ms_ =
-        std::max(last_data_received_ms_, connection->last_data_received());
+  }
+  RTC_DCHECK(connection->last_data_received() >= last_data_received_ms_);
+  last_data_received_ms_ =
+      std::max(last_data_received_ms_, connection->last_data_received());
 
-    NotifyPacketReceived(packet);
+  NotifyPacketsReceived(packets);
 
-    // May need to switch the sending connection based on the receiving media
-    // path if this is the controlled side.
-    if (ice_role_ == ICEROLE_CONTROLLED && connection != selected_connection_) {
-      ice_controller_->OnImmediateSwitchRequest(IceSwitchReason::DATA_RECEIVED,
-                                                connection);
-    }
+  // May need to switch the sending connection based on the receiving media
+  // path if this is the controlled side.
+  if (ice_role_ == ICEROLE_CONTROLLED && connection != selected_connection_) {
+    ice_controller_->OnImmediateSwitchRequest(IceSwitchReason::DATA_RECEIVED,
+                                              connection);
+  }
 }
 
 void P2PTransportChannel::OnSentPacket(const rtc::SentPacket& sent_packet) {
@@ -333,7 +333,8 @@ class RTC_EXPORT P2PTransportChannel : public IceTransportInternal,
   void OnRoleConflict(PortInterface* port);
 
   void OnConnectionStateChange(Connection* connection);
-  void OnReadPacket(Connection* connection, const rtc::ReceivedPacket& packet);
+  void OnReadPackets(Connection* connection,
+                     rtc::ArrayView<const rtc::ReceivedPacket> packets);
   void OnSentPacket(const rtc::SentPacket& sent_packet);
   void OnReadyToSend(Connection* connection);
   void OnConnectionDestroyed(Connection* connection);
@@ -10,6 +10,7 @@
 
 #include "p2p/base/packet_transport_internal.h"
 
+#include "api/array_view.h"
 #include "api/sequence_checker.h"
 #include "rtc_base/network/received_packet.h"
 
@@ -40,6 +41,20 @@ void PacketTransportInternal::DeregisterReceivedPacketCallback(void* id) {
   received_packet_callback_list_.RemoveReceivers(id);
 }
 
+void PacketTransportInternal::RegisterReceivedPacketBatchCallback(
+    void* id,
+    absl::AnyInvocable<void(PacketTransportInternal*,
+                            rtc::ArrayView<const rtc::ReceivedPacket>)>
+        callback) {
+  RTC_DCHECK_RUN_ON(&network_checker_);
+  received_packet_batch_callback_list_.AddReceiver(id, std::move(callback));
+}
+
+void PacketTransportInternal::DeregisterReceivedPacketBatchCallback(void* id) {
+  RTC_DCHECK_RUN_ON(&network_checker_);
+  received_packet_batch_callback_list_.RemoveReceivers(id);
+}
+
 void PacketTransportInternal::SetOnCloseCallback(
     absl::AnyInvocable<void() &&> callback) {
   RTC_DCHECK_RUN_ON(&network_checker_);
@@ -51,6 +66,17 @@ void PacketTransportInternal::NotifyPacketReceived(
     const rtc::ReceivedPacket& packet) {
   RTC_DCHECK_RUN_ON(&network_checker_);
   received_packet_callback_list_.Send(this, packet);
+  received_packet_batch_callback_list_.Send(this,
+                                            rtc::MakeArrayView(&packet, 1));
+}
+
+void PacketTransportInternal::NotifyPacketsReceived(
+    rtc::ArrayView<const rtc::ReceivedPacket> packets) {
+  RTC_DCHECK_RUN_ON(&network_checker_);
+  for (const rtc::ReceivedPacket& packet : packets) {
+    received_packet_callback_list_.Send(this, packet);
+  }
+  received_packet_batch_callback_list_.Send(this, packets);
 }
 
 void PacketTransportInternal::NotifyOnClose() {
@@ -17,6 +17,7 @@
 
 #include "absl/functional/any_invocable.h"
 #include "absl/types/optional.h"
+#include "api/array_view.h"
 #include "p2p/base/port.h"
 #include "rtc_base/async_packet_socket.h"
 #include "rtc_base/callback_list.h"
@@ -90,6 +91,18 @@ class RTC_EXPORT PacketTransportInternal : public sigslot::has_slots<> {
 
   void DeregisterReceivedPacketCallback(void* id);
 
+  // Callback is invoked with all packets that arrived together, e.g. from one
+  // batched socket read. Packets received one at a time are delivered as
+  // batches of one. Receivers register either this or the per-packet
+  // callback.
+  void RegisterReceivedPacketBatchCallback(
+      void* id,
+      absl::AnyInvocable<void(PacketTransportInternal*,
+                              rtc::ArrayView<const rtc::ReceivedPacket>)>
+          callback);
+
+  void DeregisterReceivedPacketBatchCallback(void* id);
+
   // Signalled each time a packet is sent on this channel.
   sigslot::signal2<PacketTransportInternal*, const rtc::SentPacket&>
       SignalSentPacket;
@@ -105,6 +118,7 @@ class RTC_EXPORT PacketTransportInternal : public sigslot::has_slots<> {
   ~PacketTransportInternal() override;
 
   void NotifyPacketReceived(const rtc::ReceivedPacket& packet);
+  void NotifyPacketsReceived(rtc::ArrayView<const rtc::ReceivedPacket> packets);
   void NotifyOnClose();
 
   webrtc::SequenceChecker network_checker_{webrtc::SequenceChecker::kDetached};
@@ -112,6 +126,9 @@ class RTC_EXPORT PacketTransportInternal : public sigslot::has_slots<> {
  private:
   webrtc::CallbackList<PacketTransportInternal*, const rtc::ReceivedPacket&>
       received_packet_callback_list_ RTC_GUARDED_BY(&network_checker_);
+  webrtc::CallbackList<PacketTransportInternal*,
+                       rtc::ArrayView<const rtc::ReceivedPacket>>
+      received_packet_batch_callback_list_ RTC_GUARDED_BY(&network_checker_);
   absl::AnyInvocable<void() &&> on_close_;
 };
 
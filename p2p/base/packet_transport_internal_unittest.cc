@@ -10,6 +10,9 @@
 
 #include "p2p/base/packet_transport_internal.h"
 
+#include <vector>
+
+#include "api/array_view.h"
 #include "p2p/base/fake_packet_transport.h"
 #include "rtc_base/gunit.h"
 #include "rtc_base/network/received_packet.h"
@@ -41,6 +44,42 @@ TEST(PacketTransportInternal,
   packet_transport.DeregisterReceivedPacketCallback(&receiver);
 }
 
+TEST(PacketTransportInternal, NotifyPacketsReceivedPassesBatchToBatchListener) {
+  rtc::FakePacketTransport packet_transport("test");
+  MockFunction<void(rtc::PacketTransportInternal*, const rtc::ReceivedPacket&)>
+      receiver;
+  MockFunction<void(rtc::PacketTransportInternal*,
+                    rtc::ArrayView<const rtc::ReceivedPacket>)>
+      batch_receiver;
+  packet_transport.RegisterReceivedPacketCallback(&receiver,
+                                                  receiver.AsStdFunction());
+  packet_transport.RegisterReceivedPacketBatchCallback(
+      &batch_receiver, batch_receiver.AsStdFunction());
+
+  const rtc::SocketAddress address;
+  const std::vector<rtc::ReceivedPacket> packets(
+      3, rtc::ReceivedPacket({}, address));
+  EXPECT_CALL(receiver, Call).Times(3);
+  EXPECT_CALL(batch_receiver, Call)
+      .WillOnce([](rtc::PacketTransportInternal*,
+                   rtc::ArrayView<const rtc::ReceivedPacket> batch) {
+        EXPECT_EQ(batch.size(), 3u);
+      });
+  packet_transport.NotifyPacketsReceived(packets);
+
+  // Single packets are passed to batch listeners as batches of one.
+  EXPECT_CALL(receiver, Call);
+  EXPECT_CALL(batch_receiver, Call)
+      .WillOnce([](rtc::PacketTransportInternal*,
+                   rtc::ArrayView<const rtc::ReceivedPacket> batch) {
+        EXPECT_EQ(batch.size(), 1u);
+      });
+  packet_transport.NotifyPacketReceived(packets[0]);
+
+  packet_transport.DeregisterReceivedPacketCallback(&receiver);
+  packet_transport.DeregisterReceivedPacketBatchCallback(&batch_receiver);
+}
+
 TEST(PacketTransportInternal, NotifiesOnceOnClose) {
   rtc::FakePacketTransport packet_transport("test");
   int call_count = 0;
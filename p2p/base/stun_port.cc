@@ -208,6 +208,11 @@ bool UDPPort::Init() {
         [&](rtc::AsyncPacketSocket* socket, const rtc::ReceivedPacket& packet) {
           OnReadPacket(socket, packet);
         });
+    socket_->RegisterReceivedPacketBatchCallback(
+        [&](rtc::AsyncPacketSocket* socket,
+            rtc::ArrayView<const rtc::ReceivedPacket> packets) {
+          OnReadPackets(socket, packets);
+        });
   }
   socket_->SignalSentPacket.connect(this, &UDPPort::OnSentPacket);
   socket_->SignalReadyToSend.connect(this, &UDPPort::OnReadyToSend);
@@ -333,6 +338,12 @@ bool UDPPort::HandleIncomingPacket(rtc::AsyncPacketSocket* socket,
   return true;
 }
 
+void UDPPort::HandleIncomingPackets(
+    rtc::AsyncPacketSocket* socket,
+    rtc::ArrayView<const rtc::ReceivedPacket> packets) {
+  OnReadPackets(socket, packets);
+}
+
 bool UDPPort::SupportsProtocol(absl::string_view protocol) const {
   return protocol == UDP_PROTOCOL_NAME;
 }
@@ -395,6 +406,35 @@ void UDPPort::OnReadPacket(rtc::AsyncPacketSocket* socket,
   }
 }
 
+void UDPPort::OnReadPackets(rtc::AsyncPacketSocket* socket,
+                            rtc::ArrayView<const rtc::ReceivedPacket> packets) {
+  if (packets.size() == 1) {
+    OnReadPacket(socket, packets[0]);
+    return;
+  }
+  // Packets from the same remote address are handed to their connection
+  // together so that a batch read from the socket stays a batch further up.
+  size_t begin = 0;
+  while (begin < packets.size()) {
+    const rtc::SocketAddress& address = packets[begin].source_address();
+    Connection* conn = nullptr;
+    if (server_addresses_.find(address) == server_addresses_.end()) {
+      conn = GetConnection(address);
+    }
+    if (!conn) {
+      OnReadPacket(socket, packets[begin]);
+      ++begin;
+      continue;
+    }
+    size_t end = begin + 1;
+    while (end < packets.size() && packets[end].source_address() == address) {
+      ++end;
+    }
+    conn->OnReadPackets(packets.subview(begin, end - begin));
+    begin = end;
+  }
+}
+
 void UDPPort::OnSentPacket(rtc::AsyncPacketSocket* socket,
                            const rtc::SentPacket& sent_packet) {
   PortInterface::SignalSentPacket(sent_packet);
@@ -18,6 +18,7 @@
 
 #include "absl/memory/memory.h"
 #include "absl/strings/string_view.h"
+#include "api/array_view.h"
 #include "api/task_queue/pending_task_safety_flag.h"
 #include "p2p/base/port.h"
 #include "p2p/base/stun_request.h"
@@ -129,6 +130,11 @@ class RTC_EXPORT UDPPort : public Port {
 
   bool HandleIncomingPacket(rtc::AsyncPacketSocket* socket,
                             const rtc::ReceivedPacket& packet) override;
+  // Like HandleIncomingPacket(), for a batch of packets read at once from a
+  // shared socket. Packets from the same remote address reach their
+  // connection together.
+  void HandleIncomingPackets(rtc::AsyncPacketSocket* socket,
+                             rtc::ArrayView<const rtc::ReceivedPacket> packets);
 
   bool SupportsProtocol(absl::string_view protocol) const override;
   ProtocolType GetProtocol() const override;
@@ -175,6 +181,8 @@ class RTC_EXPORT UDPPort : public Port {
 
   void OnReadPacket(rtc::AsyncPacketSocket* socket,
                     const rtc::ReceivedPacket& packet);
+  void OnReadPackets(rtc::AsyncPacketSocket* socket,
+                     rtc::ArrayView<const rtc::ReceivedPacket> packets);
 
   void OnSentPacket(rtc::AsyncPacketSocket* socket,
                     const rtc::SentPacket& sent_packet) override;
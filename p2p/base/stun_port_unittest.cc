@@ -11,7 +11,9 @@
 #include "p2p/base/stun_port.h"
 
 #include <memory>
+#include <vector>
 
+#include "api/array_view.h"
 #include "api/test/mock_async_dns_resolver.h"
 #include "p2p/base/basic_packet_socket_factory.h"
 #include "p2p/base/mock_dns_resolving_packet_socket_factory.h"
@@ -409,6 +411,34 @@ TEST_F(StunPortTest, TestSharedSocketPrepareAddress) {
   EXPECT_TRUE(kLocalAddr.EqualIPs(port()->Candidates()[0].address()));
 }
 
+// Test that a UDPPort on a shared socket hands a batch of packets from one
+// remote address to their connection together.
+TEST_F(StunPortTest, TestSharedSocketDeliversPacketBatches) {
+  CreateSharedUdpPort(kStunAddr1, nullptr);
+  PrepareAddress();
+  EXPECT_TRUE_SIMULATED_WAIT(done(), kTimeoutMs, fake_clock);
+  ASSERT_FALSE(port()->Candidates().empty());
+  const rtc::SocketAddress kRemoteAddr("22.22.22.22", 2222);
+  cricket::Candidate remote_candidate = port()->Candidates()[0];
+  remote_candidate.set_address(kRemoteAddr);
+  cricket::Connection* conn = port()->CreateConnection(
+      remote_candidate, cricket::PortInterface::ORIGIN_MESSAGE);
+  ASSERT_TRUE(conn != nullptr);
+  std::vector<size_t> batch_sizes;
+  conn->RegisterReceivedPacketBatchCallback(
+      [&](cricket::Connection* connection,
+          rtc::ArrayView<const rtc::ReceivedPacket> packets) {
+        batch_sizes.push_back(packets.size());
+      });
+
+  const uint8_t kData[] = "data";
+  std::vector<rtc::ReceivedPacket> packets(
+      3, rtc::ReceivedPacket(kData, kRemoteAddr));
+  port()->HandleIncomingPackets(socket(), packets);
+  EXPECT_EQ(batch_sizes, std::vector<size_t>({3}));
+  conn->DeregisterReceivedPacketBatchCallback();
+}
+
 // Test that we still get a local candidate with invalid stun server hostname.
 // Also verifing that UDPPort can receive packets when stun address can't be
 // resolved.
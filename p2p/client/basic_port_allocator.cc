@@ -1301,6 +1301,11 @@ void AllocationSequence::Init() {
               const rtc::ReceivedPacket& packet) {
             OnReadPacket(socket, packet);
           });
+      udp_socket_->RegisterReceivedPacketBatchCallback(
+          [&](rtc::AsyncPacketSocket* socket,
+              rtc::ArrayView<const rtc::ReceivedPacket> packets) {
+            OnReadPackets(socket, packets);
+          });
     }
     // Continuing if `udp_socket_` is NULL, as local TCP and RelayPort using TCP
     // are next available options to setup a communication channel.
@@ -1708,6 +1713,37 @@ void AllocationSequence::OnReadPacket(rtc::AsyncPacketSocket* socket,
   }
 }
 
+void AllocationSequence::OnReadPackets(
+    rtc::AsyncPacketSocket* socket,
+    rtc::ArrayView<const rtc::ReceivedPacket> packets) {
+  RTC_DCHECK(socket == udp_socket_.get());
+  auto maybe_from_turn_server = [&](const rtc::SocketAddress& address) {
+    return absl::c_any_of(relay_ports_, [&](Port* port) {
+      return port->CanHandleIncomingPacketsFrom(address);
+    });
+  };
+
+  // Runs of packets that no TurnPort may handle go to the UDPPort together,
+  // so that a batch read from the shared socket stays a batch.
+  size_t begin = 0;
+  while (begin < packets.size()) {
+    size_t end = begin;
+    while (udp_port_ && end < packets.size() &&
+           !maybe_from_turn_server(packets[end].source_address())) {
+      ++end;
+    }
+    if (end == begin) {
+      OnReadPacket(socket, packets[begin]);
+      ++begin;
+      continue;
+    }
+    RTC_DCHECK(udp_port_->SharedSocket());
+    udp_port_->HandleIncomingPackets(socket,
+                                     packets.subview(begin, end - begin));
+    begin = end;
+  }
+}
+
 void AllocationSequence::OnPortDestroyed(PortInterface* port) {
   if (udp_port_ == port) {
     udp_port_ = NULL;
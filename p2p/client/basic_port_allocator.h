@@ -16,6 +16,7 @@
 #include <vector>
 
 #include "absl/strings/string_view.h"
+#include "api/array_view.h"
 #include "api/field_trials_view.h"
 #include "api/task_queue/pending_task_safety_flag.h"
 #include "api/turn_customizer.h"
@@ -385,6 +386,8 @@ class AllocationSequence {
 
   void OnReadPacket(rtc::AsyncPacketSocket* socket,
                     const rtc::ReceivedPacket& packet);
+  void OnReadPackets(rtc::AsyncPacketSocket* socket,
+                     rtc::ArrayView<const rtc::ReceivedPacket> packets);
 
   void OnPortDestroyed(PortInterface* port);
 
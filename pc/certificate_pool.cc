@@ -0,0 +1,205 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "pc/certificate_pool.h"
+
+#include <cstdint>
+#include <utility>
+
+#include "absl/types/optional.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/time_utils.h"
+#include "system_wrappers/include/metrics.h"
+
+namespace webrtc {
+namespace {
+
+// Pooled certificates closer than this to their expiration are discarded
+// rather than handed to a new PeerConnection.
+constexpr uint64_t kMinRemainingLifetimeMs = 7 * 24 * 60 * 60 * 1000ull;
+
+bool SameKeyParams(const rtc::KeyParams& a, const rtc::KeyParams& b) {
+  if (a.type() != b.type()) {
+    return false;
+  }
+  if (a.type() == rtc::KT_RSA) {
+    return a.rsa_params().mod_size == b.rsa_params().mod_size &&
+           a.rsa_params().pub_exp == b.rsa_params().pub_exp;
+  }
+  return a.ec_curve() == b.ec_curve();
+}
+
+// Serves requests for certificates with the default lifetime from the pool,
+// and all other requests and pool misses from `fallback_`.
+class PooledCertificateGenerator
+    : public rtc::RTCCertificateGeneratorInterface {
+ public:
+  PooledCertificateGenerator(
+      CertificatePool* pool,
+      rtc::Thread* signaling_thread,
+      std::unique_ptr<rtc::RTCCertificateGeneratorInterface> fallback)
+      : pool_(pool),
+        signaling_thread_(signaling_thread),
+        fallback_(std::move(fallback)) {
+    RTC_DCHECK(fallback_);
+  }
+
+  void GenerateCertificateAsync(const rtc::KeyParams& key_params,
+                                const absl::optional<uint64_t>& expires_ms,
+                                Callback callback) override {
+    RTC_DCHECK_RUN_ON(signaling_thread_);
+    if (!expires_ms) {
+      rtc::scoped_refptr<rtc::RTCCertificate> certificate =
+          pool_->Take(key_params);
+      RTC_HISTOGRAM_BOOLEAN("WebRTC.PeerConnection.CertificatePoolHit",
+                            certificate != nullptr);
+      if (certificate) {
+        // Complete asynchronously, like a generated certificate would.
+        signaling_thread_->PostTask(
+            [certificate = std::move(certificate),
+             callback = std::move(callback)]() mutable {
+              std::move(callback)(std::move(certificate));
+            });
+        return;
+      }
+    }
+    fallback_->GenerateCertificateAsync(key_params, expires_ms,
+                                        std::move(callback));
+  }
+
+ private:
+  CertificatePool* const pool_;
+  rtc::Thread* const signaling_thread_;
+  const std::unique_ptr<rtc::RTCCertificateGeneratorInterface> fallback_;
+};
+
+}  // namespace
+
+CertificatePool::CertificatePool(rtc::Thread* signaling_thread,
+                                 rtc::Thread* network_thread)
+    : signaling_thread_(signaling_thread), network_thread_(network_thread) {
+  RTC_DCHECK(signaling_thread_);
+  RTC_DCHECK(network_thread_);
+}
+
+CertificatePool::~CertificatePool() {
+  RTC_DCHECK_RUN_ON(signaling_thread_);
+}
+
+void CertificatePool::Reserve(const rtc::KeyParams& key_params, size_t size) {
+  RTC_DCHECK_RUN_ON(signaling_thread_);
+  RTC_DCHECK(key_params.IsValid());
+  Entry* entry = FindEntry(key_params);
+  if (!entry) {
+    entries_.emplace_back();
+    entry = &entries_.back();
+    entry->key_params = key_params;
+  }
+  entry->size = size;
+  Refill(entry - entries_.data());
+}
+
+rtc::scoped_refptr<rtc::RTCCertificate> CertificatePool::Take(
+    const rtc::KeyParams& key_params) {
+  RTC_DCHECK_RUN_ON(signaling_thread_);
+  Entry* entry = FindEntry(key_params);
+  if (entry) {
+    const uint64_t now = rtc::TimeUTCMillis();
+    while (!entry->certificates.empty() &&
+           entry->certificates.front()->Expires() <
+               now + kMinRemainingLifetimeMs) {
+      entry->certificates.pop_front();
+    }
+  }
+  if (!entry || entry->certificates.empty()) {
+    if (entry) {
+      // Make sure a previous generation failure does not keep the pool empty.
+      Refill(entry - entries_.data());
+    }
+    return nullptr;
+  }
+  rtc::scoped_refptr<rtc::RTCCertificate> certificate =
+      std::move(entry->certificates.front());
+  entry->certificates.pop_front();
+  Refill(entry - entries_.data());
+  return certificate;
+}
+
+size_t CertificatePool::available(const rtc::KeyParams& key_params) const {
+  RTC_DCHECK_RUN_ON(signaling_thread_);
+  const Entry* entry = FindEntry(key_params);
+  return entry ? entry->certificates.size() : 0;
+}
+
+std::unique_ptr<rtc::RTCCertificateGeneratorInterface>
+CertificatePool::CreateGenerator(
+    std::unique_ptr<rtc::RTCCertificateGeneratorInterface> fallback) {
+  return std::make_unique<PooledCertificateGenerator>(this, signaling_thread_,
+                                                      std::move(fallback));
+}
+
+CertificatePool::Entry* CertificatePool::FindEntry(
+    const rtc::KeyParams& key_params) {
+  for (Entry& entry : entries_) {
+    if (SameKeyParams(entry.key_params, key_params)) {
+      return &entry;
+    }
+  }
+  return nullptr;
+}
+
+const CertificatePool::Entry* CertificatePool::FindEntry(
+    const rtc::KeyParams& key_params) const {
+  for (const Entry& entry : entries_) {
+    if (SameKeyParams(entry.key_params, key_params)) {
+      return &entry;
+    }
+  }
+  return nullptr;
+}
+
+void CertificatePool::Refill(size_t index) {
+  Entry& entry = entries_[index];
+  while (entry.certificates.size() + entry.pending < entry.size) {
+    ++entry.pending;
+    network_thread_->PostTask([key_params = entry.key_params,
+                              signaling_thread = signaling_thread_,
+                              safety = safety_.flag(), this, index] {
+      rtc::scoped_refptr<rtc::RTCCertificate> certificate =
+          rtc::RTCCertificateGenerator::GenerateCertificate(key_params,
+                                                            absl::nullopt);
+      signaling_thread->PostTask(SafeTask(
+          safety, [this, index, certificate = std::move(certificate)]() {
+            RTC_DCHECK_RUN_ON(signaling_thread_);
+            OnCertificateGenerated(index, std::move(certificate));
+          }));
+    });
+  }
+}
+
+void CertificatePool::OnCertificateGenerated(
+    size_t index,
+    rtc::scoped_refptr<rtc::RTCCertificate> certificate) {
+  Entry& entry = entries_[index];
+  RTC_DCHECK_GT(entry.pending, 0);
+  --entry.pending;
+  if (!certificate) {
+    // Refilling is retried on the next miss rather than right away, which
+    // could spin on a persistent failure.
+    RTC_LOG(LS_WARNING) << "Failed to generate a pooled certificate.";
+    return;
+  }
+  if (entry.certificates.size() < entry.size) {
+    entry.certificates.push_back(std::move(certificate));
+  }
+}
+
+}  // namespace webrtc
@@ -0,0 +1,94 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef PC_CERTIFICATE_POOL_H_
+#define PC_CERTIFICATE_POOL_H_
+
+#include <stddef.h>
+
+#include <deque>
+#include <memory>
+#include <vector>
+
+#include "api/scoped_refptr.h"
+#include "api/task_queue/pending_task_safety_flag.h"
+#include "rtc_base/rtc_certificate.h"
+#include "rtc_base/rtc_certificate_generator.h"
+#include "rtc_base/ssl_identity.h"
+#include "rtc_base/thread.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+// Keeps a number of certificates generated ahead of time, so that creating a
+// PeerConnection does not have to wait for key generation. Certificates are
+// generated on the network thread, where the default RTCCertificateGenerator
+// generates them too, and the pool is refilled in the background whenever a
+// certificate is taken. Each certificate is generated in a task of its own, so
+// packets are handled in between; an ECDSA key takes well under a millisecond,
+// while each RSA key holds the network thread for tens to hundreds of
+// milliseconds, which is why RSA pooling is a separate, opt-in size.
+//
+// This class must be created, used and destroyed on the signaling thread.
+class CertificatePool {
+ public:
+  CertificatePool(rtc::Thread* signaling_thread, rtc::Thread* network_thread);
+  ~CertificatePool();
+
+  CertificatePool(const CertificatePool&) = delete;
+  CertificatePool& operator=(const CertificatePool&) = delete;
+
+  // Keeps `size` certificates with `key_params` available, starting their
+  // generation right away.
+  void Reserve(const rtc::KeyParams& key_params, size_t size);
+
+  // Returns the oldest certificate with `key_params` and the default lifetime,
+  // and starts generating its replacement. Certificates close to expiring are
+  // dropped. Returns null if none is available.
+  rtc::scoped_refptr<rtc::RTCCertificate> Take(
+      const rtc::KeyParams& key_params);
+
+  // Number of certificates with `key_params` ready to be taken.
+  size_t available(const rtc::KeyParams& key_params) const;
+
+  // Returns a generator for one PeerConnection that takes certificates from
+  // the pool and asks `fallback` for those the pool cannot provide. The pool
+  // must outlive the generator.
+  std::unique_ptr<rtc::RTCCertificateGeneratorInterface> CreateGenerator(
+      std::unique_ptr<rtc::RTCCertificateGeneratorInterface> fallback);
+
+ private:
+  struct Entry {
+    rtc::KeyParams key_params;
+    size_t size = 0;
+    size_t pending = 0;
+    // Oldest first.
+    std::deque<rtc::scoped_refptr<rtc::RTCCertificate>> certificates;
+  };
+
+  Entry* FindEntry(const rtc::KeyParams& key_params)
+      RTC_RUN_ON(signaling_thread_);
+  const Entry* FindEntry(const rtc::KeyParams& key_params) const
+      RTC_RUN_ON(signaling_thread_);
+  void Refill(size_t index) RTC_RUN_ON(signaling_thread_);
+  void OnCertificateGenerated(
+      size_t index,
+      rtc::scoped_refptr<rtc::RTCCertificate> certificate)
+      RTC_RUN_ON(signaling_thread_);
+
+  rtc::Thread* const signaling_thread_;
+  rtc::Thread* const network_thread_;
+  std::vector<Entry> entries_ RTC_GUARDED_BY(signaling_thread_);
+  ScopedTaskSafety safety_;
+};
+
+}  // namespace webrtc
+
+#endif  // PC_CERTIFICATE_POOL_H_
@@ -0,0 +1,103 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "pc/certificate_pool.h"
+
+#include <memory>
+#include <utility>
+
+#include "absl/types/optional.h"
+#include "api/scoped_refptr.h"
+#include "rtc_base/gunit.h"
+#include "rtc_base/rtc_certificate.h"
+#include "rtc_base/rtc_certificate_generator.h"
+#include "rtc_base/ssl_identity.h"
+#include "rtc_base/thread.h"
+#include "system_wrappers/include/metrics.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+constexpr int kGenerationTimeoutMs = 10000;
+
+class CertificatePoolTest : public ::testing::Test {
+ protected:
+  CertificatePoolTest() : network_thread_(rtc::Thread::Create()) {
+    metrics::Reset();
+    network_thread_->Start();
+    pool_ = std::make_unique<CertificatePool>(rtc::Thread::Current(),
+                                              network_thread_.get());
+  }
+
+  rtc::AutoThread main_thread_;
+  std::unique_ptr<rtc::Thread> network_thread_;
+  std::unique_ptr<CertificatePool> pool_;
+};
+
+TEST_F(CertificatePoolTest, TakeFromEmptyPoolMisses) {
+  EXPECT_EQ(pool_->Take(rtc::KeyParams::ECDSA()), nullptr);
+}
+
+TEST_F(CertificatePoolTest, TakeReturnsPooledCertificateAndRefills) {
+  pool_->Reserve(rtc::KeyParams::ECDSA(), 2);
+  EXPECT_EQ_WAIT(pool_->available(rtc::KeyParams::ECDSA()), 2u,
+                 kGenerationTimeoutMs);
+
+  rtc::scoped_refptr<rtc::RTCCertificate> certificate =
+      pool_->Take(rtc::KeyParams::ECDSA());
+  ASSERT_TRUE(certificate);
+  EXPECT_EQ(pool_->available(rtc::KeyParams::ECDSA()), 1u);
+
+  EXPECT_EQ_WAIT(pool_->available(rtc::KeyParams::ECDSA()), 2u,
+                 kGenerationTimeoutMs);
+}
+
+TEST_F(CertificatePoolTest, KeepsKeyTypesApart) {
+  pool_->Reserve(rtc::KeyParams::ECDSA(), 1);
+  EXPECT_EQ_WAIT(pool_->available(rtc::KeyParams::ECDSA()), 1u,
+                 kGenerationTimeoutMs);
+
+  EXPECT_EQ(pool_->Take(rtc::KeyParams::RSA()), nullptr);
+  EXPECT_EQ(pool_->available(rtc::KeyParams::ECDSA()), 1u);
+}
+
+TEST_F(CertificatePoolTest, GeneratorUsesPoolForDefaultLifetime) {
+  pool_->Reserve(rtc::KeyParams::ECDSA(), 1);
+  EXPECT_EQ_WAIT(pool_->available(rtc::KeyParams::ECDSA()), 1u,
+                 kGenerationTimeoutMs);
+  std::unique_ptr<rtc::RTCCertificateGeneratorInterface> generator =
+      pool_->CreateGenerator(std::make_unique<rtc::RTCCertificateGenerator>(
+          rtc::Thread::Current(), network_thread_.get()));
+
+  rtc::scoped_refptr<rtc::RTCCertificate> pooled;
+  generator->GenerateCertificateAsync(
+      rtc::KeyParams::ECDSA(), absl::nullopt,
+      [&](rtc::scoped_refptr<rtc::RTCCertificate> certificate) {
+        pooled = std::move(certificate);
+      });
+  EXPECT_TRUE_WAIT(pooled != nullptr, kGenerationTimeoutMs);
+  EXPECT_METRIC_EQ(
+      1, metrics::NumEvents("WebRTC.PeerConnection.CertificatePoolHit", 1));
+
+  // A custom lifetime bypasses the pool.
+  rtc::scoped_refptr<rtc::RTCCertificate> generated;
+  generator->GenerateCertificateAsync(
+      rtc::KeyParams::ECDSA(), 60 * 60 * 1000,
+      [&](rtc::scoped_refptr<rtc::RTCCertificate> certificate) {
+        generated = std::move(certificate);
+      });
+  EXPECT_TRUE_WAIT(generated != nullptr, kGenerationTimeoutMs);
+  EXPECT_METRIC_EQ(
+      1, metrics::NumSamples("WebRTC.PeerConnection.CertificatePoolHit"));
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -10,6 +10,7 @@
 
 #include "pc/connection_context.h"
 
+#include <string>
 #include <type_traits>
 #include <utility>
 #include <vector>
@@ -20,6 +21,7 @@
 #include "pc/media_factory.h"
 #include "rtc_base/helpers.h"
 #include "rtc_base/internal/default_socket_server.h"
+#include "rtc_base/logging.h"
 #include "rtc_base/socket_server.h"
 #include "rtc_base/time_utils.h"
 
@@ -44,6 +46,26 @@ rtc::Thread* MaybeStartNetworkThread(
   return thread_holder.get();
 }
 
+// Returns how many network threads to run. Injected socket factories, network
+// managers and SCTP factories are bound to a single network thread, so
+// sharding is only possible when the context creates all of those itself.
+int NumNetworkThreads(const PeerConnectionFactoryDependencies& dependencies) {
+  if (dependencies.num_network_threads <= 1) {
+    return 1;
+  }
+  if (dependencies.network_thread || dependencies.socket_factory ||
+      dependencies.packet_socket_factory || dependencies.network_manager ||
+      dependencies.sctp_factory) {
+    RTC_LOG(LS_WARNING) << "Ignoring num_network_threads="
+                        << dependencies.num_network_threads
+                        << " because one of network_thread, socket_factory,"
+                           " packet_socket_factory, network_manager or"
+                           " sctp_factory was injected.";
+    return 1;
+  }
+  return dependencies.num_network_threads;
+}
+
 rtc::Thread* MaybeWrapThread(rtc::Thread* signaling_thread,
                              bool& wraps_current_thread) {
   wraps_current_thread = false;
@@ -86,7 +108,8 @@ rtc::scoped_refptr<ConnectionContext> ConnectionContext::Create(
 ConnectionContext::ConnectionContext(
     const Environment& env,
     PeerConnectionFactoryDependencies* dependencies)
-    : network_thread_(MaybeStartNetworkThread(dependencies->network_thread,
+    : num_network_threads_(NumNetworkThreads(*dependencies)),
+      network_thread_(MaybeStartNetworkThread(dependencies->network_thread,
                                               owned_socket_factory_,
                                               owned_network_thread_)),
       worker_thread_(dependencies->worker_thread,
@@ -157,9 +180,46 @@ ConnectionContext::ConnectionContext(
         network_monitor_factory_.get(), socket_factory, &env_.field_trials());
   }
   if (!default_socket_factory_) {
-    default_socket_factory_ =
-        std::make_unique<rtc::BasicPacketSocketFactory>(socket_factory);
+    default_socket_factory_ = std::make_unique<rtc::BasicPacketSocketFactory>(
+        socket_factory, &env_.field_trials());
+  }
+
+  for (int i = 1; i < num_network_threads_; ++i) {
+    OwnedNetworkShard shard;
+    shard.socket_server = rtc::CreateDefaultSocketServer();
+    shard.thread = std::make_unique<rtc::Thread>(shard.socket_server.get());
+    shard.thread->SetName("pc_network_thread_" + std::to_string(i), nullptr);
+    shard.thread->Start();
+    signaling_thread_->AllowInvokesToThread(shard.thread.get());
+    worker_thread_->AllowInvokesToThread(shard.thread.get());
+    shard.thread->PostTask([thread = shard.thread.get()] {
+      thread->DisallowBlockingCalls();
+      thread->DisallowAllInvokes();
+    });
+    shard.thread->SetDispatchWarningMs(10);
+    shard.network_manager = std::make_unique<rtc::BasicNetworkManager>(
+        network_monitor_factory_.get(), shard.socket_server.get(),
+        &env_.field_trials());
+    shard.packet_socket_factory =
+        std::make_unique<rtc::BasicPacketSocketFactory>(
+            shard.socket_server.get(), &env_.field_trials());
+    shard.sctp_factory = MaybeCreateSctpFactory(nullptr, shard.thread.get());
+    extra_network_shards_.push_back(std::move(shard));
+  }
+  if (dependencies->certificate_pool_size > 0 ||
+      dependencies->rsa_certificate_pool_size > 0) {
+    certificate_pool_ =
+        std::make_unique<CertificatePool>(signaling_thread_, network_thread_);
+    if (dependencies->certificate_pool_size > 0) {
+      certificate_pool_->Reserve(rtc::KeyParams::ECDSA(),
+                                 dependencies->certificate_pool_size);
+    }
+    if (dependencies->rsa_certificate_pool_size > 0) {
+      certificate_pool_->Reserve(rtc::KeyParams::RSA(),
+                                 dependencies->rsa_certificate_pool_size);
+    }
   }
+
   // Set warning levels on the threads, to give warnings when response
   // may be slower than is expected of the thread.
   // Since some of the threads may be the same, start with the least
@@ -178,9 +238,18 @@ ConnectionContext::ConnectionContext(
 
 ConnectionContext::~ConnectionContext() {
   RTC_DCHECK_RUN_ON(signaling_thread_);
+  certificate_pool_ = nullptr;
   // `media_engine_` requires destruction to happen on the worker thread.
   worker_thread_->PostTask([media_engine = std::move(media_engine_)] {});
 
+  // Destroys each shard's objects before stopping its thread.
+  for (OwnedNetworkShard& shard : extra_network_shards_) {
+    shard.sctp_factory = nullptr;
+    shard.packet_socket_factory = nullptr;
+    shard.network_manager = nullptr;
+    shard.thread = nullptr;
+  }
+
   // Make sure `worker_thread()` and `signaling_thread()` outlive
   // `default_socket_factory_` and `default_network_manager_`.
   default_socket_factory_ = nullptr;
@@ -190,4 +259,21 @@ ConnectionContext::~ConnectionContext() {
     rtc::ThreadManager::Instance()->UnwrapCurrentThread();
 }
 
+ConnectionContext::NetworkShard ConnectionContext::NextNetworkShard() {
+  RTC_DCHECK_RUN_ON(signaling_thread_);
+  size_t index = next_network_shard_;
+  next_network_shard_ = (next_network_shard_ + 1) % num_network_shards();
+  if (index == 0) {
+    return {.network_thread = network_thread_,
+            .network_manager = default_network_manager_.get(),
+            .packet_socket_factory = default_socket_factory_.get(),
+            .sctp_transport_factory = sctp_factory_.get()};
+  }
+  OwnedNetworkShard& shard = extra_network_shards_[index - 1];
+  return {.network_thread = shard.thread.get(),
+          .network_manager = shard.network_manager.get(),
+          .packet_socket_factory = shard.packet_socket_factory.get(),
+          .sctp_transport_factory = shard.sctp_factory.get()};
+}
+
 }  // namespace webrtc
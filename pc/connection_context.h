@@ -13,6 +13,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "api/environment/environment.h"
 #include "api/media_stream_interface.h"
@@ -23,6 +24,7 @@
 #include "api/transport/sctp_transport_factory_interface.h"
 #include "media/base/media_engine.h"
 #include "p2p/base/basic_packet_socket_factory.h"
+#include "pc/certificate_pool.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/network.h"
 #include "rtc_base/network_monitor_factory.h"
@@ -74,6 +76,19 @@ class ConnectionContext final
   rtc::Thread* network_thread() { return network_thread_; }
   const rtc::Thread* network_thread() const { return network_thread_; }
 
+  // A network thread together with the objects bound to it. PeerConnections
+  // keep all their transports on the network thread of a single shard.
+  struct NetworkShard {
+    rtc::Thread* network_thread = nullptr;
+    rtc::NetworkManager* network_manager = nullptr;
+    rtc::PacketSocketFactory* packet_socket_factory = nullptr;
+    SctpTransportFactoryInterface* sctp_transport_factory = nullptr;
+  };
+  // Returns the shard for a new PeerConnection. Shards are handed out round
+  // robin; shard 0 consists of network_thread() and the default objects.
+  NetworkShard NextNetworkShard();
+  size_t num_network_shards() const { return 1 + extra_network_shards_.size(); }
+
   // Environment associated with the PeerConnectionFactory.
   // Note: environments are different for different PeerConnections,
   // but they are not supposed to change after creating the PeerConnection.
@@ -92,6 +107,12 @@ class ConnectionContext final
     RTC_DCHECK_RUN_ON(worker_thread());
     return call_factory_.get();
   }
+  // Certificates generated ahead of time, or null if
+  // PeerConnectionFactoryDependencies did not ask for any.
+  CertificatePool* certificate_pool() {
+    RTC_DCHECK_RUN_ON(signaling_thread_);
+    return certificate_pool_.get();
+  }
   rtc::UniqueRandomIdGenerator* ssrc_generator() { return &ssrc_generator_; }
   // Note: There is lots of code that wants to know whether or not we
   // use RTX, but so far, no code has been found that sets it to false.
@@ -116,6 +137,9 @@ class ConnectionContext final
   std::unique_ptr<rtc::SocketFactory> owned_socket_factory_;
   std::unique_ptr<rtc::Thread> owned_network_thread_
       RTC_GUARDED_BY(signaling_thread_);
+  // Computed first, as the injected network objects it looks at are moved out
+  // of the dependencies further down the initializer list.
+  const int num_network_threads_;
   rtc::Thread* const network_thread_;
   AlwaysValidPointer<rtc::Thread> const worker_thread_;
   rtc::Thread* const signaling_thread_;
@@ -142,6 +166,21 @@ class ConnectionContext final
       RTC_GUARDED_BY(signaling_thread_);
   std::unique_ptr<SctpTransportFactoryInterface> const sctp_factory_;
 
+  // Network threads beyond `network_thread_`, created when
+  // PeerConnectionFactoryDependencies::num_network_threads is above 1.
+  struct OwnedNetworkShard {
+    std::unique_ptr<rtc::SocketServer> socket_server;
+    std::unique_ptr<rtc::Thread> thread;
+    std::unique_ptr<rtc::NetworkManager> network_manager;
+    std::unique_ptr<rtc::PacketSocketFactory> packet_socket_factory;
+    std::unique_ptr<SctpTransportFactoryInterface> sctp_factory;
+  };
+  std::vector<OwnedNetworkShard> extra_network_shards_;
+  size_t next_network_shard_ RTC_GUARDED_BY(signaling_thread_) = 0;
+
+  std::unique_ptr<CertificatePool> certificate_pool_
+      RTC_GUARDED_BY(signaling_thread_);
+
   // Controls whether to announce support for the the rfc4588 payload format
   // for retransmitted video packets.
   bool use_rtx_;
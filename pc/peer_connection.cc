@@ -517,6 +517,7 @@ bool PeerConnectionInterface::RTCConfiguration::operator!=(
 RTCErrorOr<rtc::scoped_refptr<PeerConnection>> PeerConnection::Create(
     const Environment& env,
     rtc::scoped_refptr<ConnectionContext> context,
+    const ConnectionContext::NetworkShard& network_shard,
     const PeerConnectionFactoryInterface::Options& options,
     std::unique_ptr<Call> call,
     const PeerConnectionInterface::RTCConfiguration& configuration,
@@ -563,8 +564,8 @@ RTCErrorOr<rtc::scoped_refptr<PeerConnection>> PeerConnection::Create(
 
   // The PeerConnection constructor consumes some, but not all, dependencies.
   auto pc = rtc::make_ref_counted<PeerConnection>(
-      env, context, options, is_unified_plan, std::move(call), dependencies,
-      dtls_enabled);
+      env, context, network_shard, options, is_unified_plan, std::move(call),
+      dependencies, dtls_enabled);
   RTCError init_error = pc->Initialize(configuration, std::move(dependencies));
   if (!init_error.ok()) {
     RTC_LOG(LS_ERROR) << "PeerConnection initialization failed";
@@ -576,6 +577,7 @@ RTCErrorOr<rtc::scoped_refptr<PeerConnection>> PeerConnection::Create(
 PeerConnection::PeerConnection(
     const Environment& env,
     rtc::scoped_refptr<ConnectionContext> context,
+    const ConnectionContext::NetworkShard& network_shard,
     const PeerConnectionFactoryInterface::Options& options,
     bool is_unified_plan,
     std::unique_ptr<Call> call,
@@ -583,6 +585,7 @@ PeerConnection::PeerConnection(
     bool dtls_enabled)
     : env_(env),
       context_(context),
+      network_shard_(network_shard),
       options_(options),
       observer_(dependencies.observer),
       is_unified_plan_(is_unified_plan),
@@ -705,8 +708,8 @@ RTCError PeerConnection::Initialize(
                                                dependencies, context_.get());
 
   rtp_manager_ = std::make_unique<RtpTransmissionManager>(
-      IsUnifiedPlan(), context_.get(), &usage_pattern_, observer_,
-      legacy_stats_.get(), [this]() {
+      IsUnifiedPlan(), context_.get(), network_thread(), &usage_pattern_,
+      observer_, legacy_stats_.get(), [this]() {
         RTC_DCHECK_RUN_ON(signaling_thread());
         sdp_handler_->UpdateNegotiationNeeded();
       });
@@ -715,12 +718,14 @@ RTCError PeerConnection::Initialize(
   if (!IsUnifiedPlan()) {
     rtp_manager()->transceivers()->Add(
         RtpTransceiverProxyWithInternal<RtpTransceiver>::Create(
-            signaling_thread(), rtc::make_ref_counted<RtpTransceiver>(
-                                    cricket::MEDIA_TYPE_AUDIO, context())));
+            signaling_thread(),
+            rtc::make_ref_counted<RtpTransceiver>(
+                cricket::MEDIA_TYPE_AUDIO, context(), network_thread())));
     rtp_manager()->transceivers()->Add(
         RtpTransceiverProxyWithInternal<RtpTransceiver>::Create(
-            signaling_thread(), rtc::make_ref_counted<RtpTransceiver>(
-                                    cricket::MEDIA_TYPE_VIDEO, context())));
+            signaling_thread(),
+            rtc::make_ref_counted<RtpTransceiver>(
+                cricket::MEDIA_TYPE_VIDEO, context(), network_thread())));
   }
 
   int delay_ms = configuration.report_usage_pattern_delay_ms
@@ -762,7 +767,7 @@ JsepTransportController* PeerConnection::InitializeTransportController_n(
 
   // DTLS has to be enabled to use SCTP.
   if (dtls_enabled_) {
-    config.sctp_factory = context_->sctp_transport_factory();
+    config.sctp_factory = network_shard_.sctp_transport_factory;
   }
 
   config.ice_transport_factory = ice_transport_factory_.get();
@@ -110,9 +110,12 @@ class PeerConnection : public PeerConnectionInternal,
   //
   // Note that the function takes ownership of dependencies, and will
   // either use them or release them, whether it succeeds or fails.
+  // `network_shard` selects the network thread, and the objects bound to it,
+  // that this PeerConnection runs its transports on.
   static RTCErrorOr<rtc::scoped_refptr<PeerConnection>> Create(
       const Environment& env,
       rtc::scoped_refptr<ConnectionContext> context,
+      const ConnectionContext::NetworkShard& network_shard,
       const PeerConnectionFactoryInterface::Options& options,
       std::unique_ptr<Call> call,
       const PeerConnectionInterface::RTCConfiguration& configuration,
@@ -263,7 +266,7 @@ class PeerConnection : public PeerConnectionInternal,
   }
 
   rtc::Thread* network_thread() const final {
-    return context_->network_thread();
+    return network_shard_.network_thread;
   }
   rtc::Thread* worker_thread() const final { return context_->worker_thread(); }
 
@@ -443,6 +446,7 @@ class PeerConnection : public PeerConnectionInternal,
   // Available for rtc::scoped_refptr creation
   PeerConnection(const Environment& env,
                  rtc::scoped_refptr<ConnectionContext> context,
+                 const ConnectionContext::NetworkShard& network_shard,
                  const PeerConnectionFactoryInterface::Options& options,
                  bool is_unified_plan,
                  std::unique_ptr<Call> call,
@@ -599,6 +603,7 @@ class PeerConnection : public PeerConnectionInternal,
 
   const Environment env_;
   const rtc::scoped_refptr<ConnectionContext> context_;
+  const ConnectionContext::NetworkShard network_shard_;
   const PeerConnectionFactoryInterface::Options options_;
   PeerConnectionObserver* observer_ RTC_GUARDED_BY(signaling_thread()) =
       nullptr;
@@ -32,6 +32,7 @@
 #include "p2p/base/port_allocator.h"
 #include "p2p/client/basic_port_allocator.h"
 #include "pc/audio_track.h"
+#include "pc/certificate_pool.h"
 #include "pc/local_audio_source.h"
 #include "pc/media_factory.h"
 #include "pc/media_stream.h"
@@ -229,16 +230,22 @@ PeerConnectionFactory::CreatePeerConnectionOrError(
   }
 
   const Environment env = env_factory.Create();
+  const ConnectionContext::NetworkShard network_shard =
+      context_->NextNetworkShard();
 
   // Set internal defaults if optional dependencies are not set.
   if (!dependencies.cert_generator) {
     dependencies.cert_generator =
-        std::make_unique<rtc::RTCCertificateGenerator>(signaling_thread(),
-                                                       network_thread());
+        std::make_unique<rtc::RTCCertificateGenerator>(
+            signaling_thread(), network_shard.network_thread);
+    if (CertificatePool* pool = context_->certificate_pool()) {
+      dependencies.cert_generator =
+          pool->CreateGenerator(std::move(dependencies.cert_generator));
+    }
   }
   if (!dependencies.allocator) {
     dependencies.allocator = std::make_unique<cricket::BasicPortAllocator>(
-        context_->default_network_manager(), context_->default_socket_factory(),
+        network_shard.network_manager, network_shard.packet_socket_factory,
         configuration.turn_customizer, /*relay_port_factory=*/nullptr,
         &env.field_trials());
     dependencies.allocator->SetPortRange(
@@ -257,12 +264,14 @@ PeerConnectionFactory::CreatePeerConnectionOrError(
   dependencies.allocator->SetVpnList(configuration.vpn_list);
 
   std::unique_ptr<Call> call =
-      worker_thread()->BlockingCall([this, &env, &configuration] {
-        return CreateCall_w(env, configuration);
+      worker_thread()->BlockingCall([this, &env, &configuration,
+                                     &network_shard] {
+        return CreateCall_w(env, configuration, network_shard.network_thread);
       });
 
-  auto result = PeerConnection::Create(env, context_, options_, std::move(call),
-                                       configuration, std::move(dependencies));
+  auto result = PeerConnection::Create(env, context_, network_shard, options_,
+                                       std::move(call), configuration,
+                                       std::move(dependencies));
   if (!result.ok()) {
     return result.MoveError();
   }
@@ -273,7 +282,8 @@ PeerConnectionFactory::CreatePeerConnectionOrError(
   // worker_thread()).  All such methods have thread checks though, so the code
   // should still be clear (outside of macro expansion).
   rtc::scoped_refptr<PeerConnectionInterface> result_proxy =
-      PeerConnectionProxy::Create(signaling_thread(), network_thread(),
+      PeerConnectionProxy::Create(signaling_thread(),
+                                  network_shard.network_thread,
                                   result.MoveValue());
   return result_proxy;
 }
@@ -305,10 +315,11 @@ rtc::scoped_refptr<AudioTrackInterface> PeerConnectionFactory::CreateAudioTrack(
 
 std::unique_ptr<Call> PeerConnectionFactory::CreateCall_w(
     const Environment& env,
-    const PeerConnectionInterface::RTCConfiguration& configuration) {
+    const PeerConnectionInterface::RTCConfiguration& configuration,
+    rtc::Thread* network_thread) {
   RTC_DCHECK_RUN_ON(worker_thread());
 
-  CallConfig call_config(env, network_thread());
+  CallConfig call_config(env, network_thread);
   if (!media_engine() || !context_->call_factory()) {
     return nullptr;
   }
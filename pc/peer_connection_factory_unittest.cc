@@ -43,6 +43,7 @@
 #include "p2p/base/port.h"
 #include "p2p/base/port_allocator.h"
 #include "p2p/base/port_interface.h"
+#include "pc/connection_context.h"
 #include "pc/test/fake_audio_capture_module.h"
 #include "pc/test/fake_video_track_source.h"
 #include "pc/test/mock_peer_connection_observers.h"
@@ -53,6 +54,7 @@
 #include "rtc_base/time_utils.h"
 #include "test/gmock.h"
 #include "test/gtest.h"
+#include "test/pc/sctp/fake_sctp_transport.h"
 #include "test/scoped_key_value_config.h"
 
 #ifdef WEBRTC_ANDROID
@@ -720,5 +722,48 @@ TEST(PeerConnectionFactoryDependenciesTest, UsesPacketSocketFactory) {
   called.Wait(kWaitTimeout);
 }
 
+TEST(PeerConnectionFactoryDependenciesTest,
+     ShardsPeerConnectionsOverNetworkThreads) {
+  PeerConnectionFactoryDependencies pcf_dependencies;
+  pcf_dependencies.num_network_threads = 2;
+  rtc::scoped_refptr<ConnectionContext> context =
+      ConnectionContext::Create(CreateEnvironment(), &pcf_dependencies);
+  ASSERT_EQ(context->num_network_shards(), 2u);
+
+  ConnectionContext::NetworkShard first = context->NextNetworkShard();
+  ConnectionContext::NetworkShard second = context->NextNetworkShard();
+  ConnectionContext::NetworkShard third = context->NextNetworkShard();
+  EXPECT_EQ(first.network_thread, context->network_thread());
+  EXPECT_NE(second.network_thread, first.network_thread);
+  EXPECT_NE(second.network_manager, first.network_manager);
+  EXPECT_NE(second.packet_socket_factory, first.packet_socket_factory);
+  EXPECT_EQ(third.network_thread, first.network_thread);
+}
+
+TEST(PeerConnectionFactoryDependenciesTest,
+     IgnoresNetworkThreadCountWithInjectedNetworkManager) {
+  PeerConnectionFactoryDependencies pcf_dependencies;
+  pcf_dependencies.num_network_threads = 2;
+  pcf_dependencies.network_manager =
+      std::make_unique<NiceMock<MockNetworkManager>>();
+  rtc::scoped_refptr<ConnectionContext> context =
+      ConnectionContext::Create(CreateEnvironment(), &pcf_dependencies);
+  EXPECT_EQ(context->num_network_shards(), 1u);
+}
+
+TEST(PeerConnectionFactoryDependenciesTest,
+     IgnoresNetworkThreadCountWithInjectedSctpFactory) {
+  PeerConnectionFactoryDependencies pcf_dependencies;
+  pcf_dependencies.num_network_threads = 2;
+  auto sctp_factory = std::make_unique<FakeSctpTransportFactory>();
+  FakeSctpTransportFactory* sctp_factory_ptr = sctp_factory.get();
+  pcf_dependencies.sctp_factory = std::move(sctp_factory);
+  rtc::scoped_refptr<ConnectionContext> context =
+      ConnectionContext::Create(CreateEnvironment(), &pcf_dependencies);
+  ASSERT_EQ(context->num_network_shards(), 1u);
+  EXPECT_EQ(context->NextNetworkShard().sctp_transport_factory,
+            sctp_factory_ptr);
+}
+
 }  // namespace
 }  // namespace webrtc
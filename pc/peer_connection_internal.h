@@ -41,6 +41,10 @@ class PeerConnectionSdpMethods {
   // The SDP session ID as defined by RFC 3264.
   virtual std::string session_id() const = 0;
 
+  // The network thread this PeerConnection runs its transports on. This is
+  // not necessarily the ConnectionContext's network thread.
+  virtual rtc::Thread* network_thread() const = 0;
+
   // Returns true if the ICE restart flag above was set, and no ICE restart has
   // occurred yet for this transport (by applying a local description with
   // changed ufrag/password). If the transport has been deleted as a result of
@@ -134,7 +138,6 @@ class PeerConnectionSdpMethods {
 class PeerConnectionInternal : public PeerConnectionInterface,
                                public PeerConnectionSdpMethods {
  public:
-  virtual rtc::Thread* network_thread() const = 0;
   virtual rtc::Thread* worker_thread() const = 0;
 
   // Returns true if we were the initial offerer.
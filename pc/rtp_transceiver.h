@@ -91,7 +91,12 @@ class RtpTransceiver : public RtpTransceiverInterface {
   // channel set.
   // `media_type` specifies the type of RtpTransceiver (and, by transitivity,
   // the type of senders, receivers, and channel). Can either by audio or video.
-  RtpTransceiver(cricket::MediaType media_type, ConnectionContext* context);
+  // `network_thread` is the network thread of the owning PeerConnection, which
+  // may differ from `context->network_thread()` when the factory runs several
+  // network threads.
+  RtpTransceiver(cricket::MediaType media_type,
+                 ConnectionContext* context,
+                 rtc::Thread* network_thread);
   // Construct a Unified Plan-style RtpTransceiver with the given sender and
   // receiver. The media type will be derived from the media types of the sender
   // and receiver. The sender and receiver should have the same media type.
@@ -102,6 +107,7 @@ class RtpTransceiver : public RtpTransceiverInterface {
       rtc::scoped_refptr<RtpReceiverProxyWithInternal<RtpReceiverInternal>>
           receiver,
       ConnectionContext* context,
+      rtc::Thread* network_thread,
       std::vector<RtpHeaderExtensionCapability> HeaderExtensionsToNegotiate,
       std::function<void()> on_negotiation_needed);
   ~RtpTransceiver() override;
@@ -301,6 +307,7 @@ class RtpTransceiver : public RtpTransceiverInterface {
     return context_->media_engine();
   }
   ConnectionContext* context() const { return context_; }
+  rtc::Thread* network_thread() const { return network_thread_; }
   void OnFirstPacketReceived();
   void StopSendingAndReceiving();
   // Delete a channel, and ensure that references to its media channel
@@ -336,6 +343,7 @@ class RtpTransceiver : public RtpTransceiverInterface {
   // from thread_.
   std::unique_ptr<cricket::ChannelInterface> channel_ = nullptr;
   ConnectionContext* const context_;
+  rtc::Thread* const network_thread_;
   std::vector<RtpCodecCapability> codec_preferences_;
   std::vector<RtpHeaderExtensionCapability> header_extensions_to_negotiate_;
 
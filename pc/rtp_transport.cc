@@ -26,6 +26,34 @@
 #include "rtc_base/trace_event.h"
 
 namespace webrtc {
+namespace {
+
+// Returns the type of `received_packet`, or kUnknown if it is neither RTP nor
+// RTCP or has an invalid size and should be dropped.
+cricket::RtpPacketType ClassifyPacket(
+    const rtc::ReceivedPacket& received_packet) {
+  // When using RTCP multiplexing we might get RTCP packets on the RTP
+  // transport. We check the RTP payload type to determine if it is RTCP.
+  cricket::RtpPacketType packet_type =
+      cricket::InferRtpPacketType(received_packet.payload());
+  // Filter out the packet that is neither RTP nor RTCP.
+  if (packet_type == cricket::RtpPacketType::kUnknown) {
+    return packet_type;
+  }
+
+  // Protect ourselves against crazy data.
+  if (!cricket::IsValidRtpPacketSize(packet_type,
+                                     received_packet.payload().size())) {
+    RTC_LOG(LS_ERROR) << "Dropping incoming "
+                      << cricket::RtpPacketTypeToString(packet_type)
+                      << " packet: wrong size="
+                      << received_packet.payload().size();
+    return cricket::RtpPacketType::kUnknown;
+  }
+  return packet_type;
+}
+
+}  // namespace
 
 void RtpTransport::SetRtcpMuxEnabled(bool enable) {
   rtcp_mux_enabled_ = enable;
@@ -54,7 +82,7 @@ void RtpTransport::SetRtpPacketTransport(
   }
   if (rtp_packet_transport_) {
     rtp_packet_transport_->SignalReadyToSend.disconnect(this);
-    rtp_packet_transport_->DeregisterReceivedPacketCallback(this);
+    rtp_packet_transport_->DeregisterReceivedPacketBatchCallback(this);
     rtp_packet_transport_->SignalNetworkRouteChanged.disconnect(this);
     rtp_packet_transport_->SignalWritableState.disconnect(this);
     rtp_packet_transport_->SignalSentPacket.disconnect(this);
@@ -64,10 +92,10 @@ void RtpTransport::SetRtpPacketTransport(
   if (new_packet_transport) {
     new_packet_transport->SignalReadyToSend.connect(
         this, &RtpTransport::OnReadyToSend);
-    new_packet_transport->RegisterReceivedPacketCallback(
+    new_packet_transport->RegisterReceivedPacketBatchCallback(
         this, [&](rtc::PacketTransportInternal* transport,
-                  const rtc::ReceivedPacket& packet) {
-          OnReadPacket(transport, packet);
+                  rtc::ArrayView<const rtc::ReceivedPacket> packets) {
+          OnReadPackets(transport, packets);
         });
     new_packet_transport->SignalNetworkRouteChanged.connect(
         this, &RtpTransport::OnNetworkRouteChanged);
@@ -93,7 +121,7 @@ void RtpTransport::SetRtcpPacketTransport(
   }
   if (rtcp_packet_transport_) {
     rtcp_packet_transport_->SignalReadyToSend.disconnect(this);
-    rtcp_packet_transport_->DeregisterReceivedPacketCallback(this);
+    rtcp_packet_transport_->DeregisterReceivedPacketBatchCallback(this);
     rtcp_packet_transport_->SignalNetworkRouteChanged.disconnect(this);
     rtcp_packet_transport_->SignalWritableState.disconnect(this);
     rtcp_packet_transport_->SignalSentPacket.disconnect(this);
@@ -103,10 +131,10 @@ void RtpTransport::SetRtcpPacketTransport(
   if (new_packet_transport) {
     new_packet_transport->SignalReadyToSend.connect(
         this, &RtpTransport::OnReadyToSend);
-    new_packet_transport->RegisterReceivedPacketCallback(
+    new_packet_transport->RegisterReceivedPacketBatchCallback(
         this, [&](rtc::PacketTransportInternal* transport,
-                  const rtc::ReceivedPacket& packet) {
-          OnReadPacket(transport, packet);
+                  rtc::ArrayView<const rtc::ReceivedPacket> packets) {
+          OnReadPackets(transport, packets);
         });
     new_packet_transport->SignalNetworkRouteChanged.connect(
         this, &RtpTransport::OnNetworkRouteChanged);
@@ -197,7 +225,7 @@ void RtpTransport::DemuxPacket(rtc::CopyOnWriteBuffer packet,
   parsed_packet.set_arrival_time(arrival_time);
   parsed_packet.set_ecn(ecn);
 
-  if (!parsed_packet.Parse(std::move(packet))) {
+  if (!parsed_packet.Parse(std::move(packet), &extension_layout_cache_)) {
     RTC_LOG(LS_ERROR)
         << "Failed to parse the incoming RTP packet before demuxing. Drop it.";
     return;
@@ -249,16 +277,23 @@ void RtpTransport::OnSentPacket(rtc::PacketTransportInternal* packet_transport,
 
 void RtpTransport::OnRtpPacketReceived(
     const rtc::ReceivedPacket& received_packet) {
-  rtc::CopyOnWriteBuffer payload(received_packet.payload());
   DemuxPacket(
-      payload,
+      rtc::ReceivedPacket(received_packet).TakePayload(),
       received_packet.arrival_time().value_or(Timestamp::MinusInfinity()),
       received_packet.ecn());
 }
 
+void RtpTransport::OnRtpPacketsReceived(
+    rtc::ArrayView<const rtc::ReceivedPacket> packets) {
+  for (const rtc::ReceivedPacket& packet : packets) {
+    OnRtpPacketReceived(packet);
+  }
+}
+
 void RtpTransport::OnRtcpPacketReceived(
     const rtc::ReceivedPacket& received_packet) {
-  rtc::CopyOnWriteBuffer payload(received_packet.payload());
+  rtc::CopyOnWriteBuffer payload =
+      rtc::ReceivedPacket(received_packet).TakePayload();
   // TODO(bugs.webrtc.org/15368): Propagate timestamp and maybe received packet
   // further.
   SendRtcpPacketReceived(&payload, received_packet.arrival_time()
@@ -270,29 +305,41 @@ void RtpTransport::OnReadPacket(rtc::PacketTransportInternal* transport,
                                 const rtc::ReceivedPacket& received_packet) {
   TRACE_EVENT0("webrtc", "RtpTransport::OnReadPacket");
 
-  // When using RTCP multiplexing we might get RTCP packets on the RTP
-  // transport. We check the RTP payload type to determine if it is RTCP.
-  cricket::RtpPacketType packet_type =
-      cricket::InferRtpPacketType(received_packet.payload());
-  // Filter out the packet that is neither RTP nor RTCP.
-  if (packet_type == cricket::RtpPacketType::kUnknown) {
-    return;
+  cricket::RtpPacketType packet_type = ClassifyPacket(received_packet);
+  if (packet_type == cricket::RtpPacketType::kRtcp) {
+    OnRtcpPacketReceived(received_packet);
+  } else if (packet_type == cricket::RtpPacketType::kRtp) {
+    OnRtpPacketReceived(received_packet);
   }
+}
 
-  // Protect ourselves against crazy data.
-  if (!cricket::IsValidRtpPacketSize(packet_type,
-                                     received_packet.payload().size())) {
-    RTC_LOG(LS_ERROR) << "Dropping incoming "
-                      << cricket::RtpPacketTypeToString(packet_type)
-                      << " packet: wrong size="
-                      << received_packet.payload().size();
+void RtpTransport::OnReadPackets(
+    rtc::PacketTransportInternal* transport,
+    rtc::ArrayView<const rtc::ReceivedPacket> packets) {
+  if (packets.size() == 1) {
+    OnReadPacket(transport, packets[0]);
     return;
   }
-
-  if (packet_type == cricket::RtpPacketType::kRtcp) {
-    OnRtcpPacketReceived(received_packet);
-  } else {
-    OnRtpPacketReceived(received_packet);
+  TRACE_EVENT1("webrtc", "RtpTransport::OnReadPackets", "count",
+               packets.size());
+
+  // Consecutive RTP packets are passed on together.
+  size_t rtp_begin = 0;
+  for (size_t i = 0; i < packets.size(); ++i) {
+    cricket::RtpPacketType packet_type = ClassifyPacket(packets[i]);
+    if (packet_type == cricket::RtpPacketType::kRtp) {
+      continue;
+    }
+    if (rtp_begin < i) {
+      OnRtpPacketsReceived(packets.subview(rtp_begin, i - rtp_begin));
+    }
+    rtp_begin = i + 1;
+    if (packet_type == cricket::RtpPacketType::kRtcp) {
+      OnRtcpPacketReceived(packets[i]);
+    }
+  }
+  if (rtp_begin < packets.size()) {
+    OnRtpPacketsReceived(packets.subview(rtp_begin));
   }
 }
 
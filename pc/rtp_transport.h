@@ -17,11 +17,13 @@
 #include <string>
 
 #include "absl/types/optional.h"
+#include "api/array_view.h"
 #include "api/task_queue/pending_task_safety_flag.h"
 #include "api/units/timestamp.h"
 #include "call/rtp_demuxer.h"
 #include "call/video_receive_stream.h"
 #include "modules/rtp_rtcp/include/rtp_header_extension_map.h"
+#include "modules/rtp_rtcp/source/rtp_packet.h"
 #include "p2p/base/packet_transport_internal.h"
 #include "pc/rtp_transport_internal.h"
 #include "pc/session_description.h"
@@ -106,6 +108,9 @@ class RtpTransport : public RtpTransportInternal {
   virtual void OnNetworkRouteChanged(
       absl::optional<rtc::NetworkRoute> network_route);
   virtual void OnRtpPacketReceived(const rtc::ReceivedPacket& packet);
+  // Called with RTP packets that were received together.
+  virtual void OnRtpPacketsReceived(
+      rtc::ArrayView<const rtc::ReceivedPacket> packets);
   virtual void OnRtcpPacketReceived(const rtc::ReceivedPacket& packet);
   // Overridden by SrtpTransport and DtlsSrtpTransport.
   virtual void OnWritableState(rtc::PacketTransportInternal* packet_transport);
@@ -116,6 +121,8 @@ class RtpTransport : public RtpTransportInternal {
                     const rtc::SentPacket& sent_packet);
   void OnReadPacket(rtc::PacketTransportInternal* transport,
                     const rtc::ReceivedPacket& received_packet);
+  void OnReadPackets(rtc::PacketTransportInternal* transport,
+                     rtc::ArrayView<const rtc::ReceivedPacket> packets);
 
   // Updates "ready to send" for an individual channel and fires
   // SignalReadyToSend.
@@ -138,6 +145,8 @@ class RtpTransport : public RtpTransportInternal {
 
   // Used for identifying the MID for RtpDemuxer.
   RtpHeaderExtensionMap header_extension_map_;
+  // Speeds up parsing the header extensions of incoming packets.
+  RtpPacket::ExtensionLayoutCache extension_layout_cache_;
   // Guard against recursive "ready to send" signals
   bool processing_ready_to_send_ = false;
   bool processing_sent_packet_ = false;
@@ -17,6 +17,8 @@
 #include "rtc_base/buffer.h"
 #include "rtc_base/containers/flat_set.h"
 #include "rtc_base/gunit.h"
+#include "rtc_base/network/received_packet.h"
+#include "rtc_base/socket_address.h"
 #include "rtc_base/third_party/sigslot/sigslot.h"
 #include "test/gtest.h"
 #include "test/run_loop.h"
@@ -324,6 +326,29 @@ TEST(RtpTransportTest, ReceivedPacketEcnMarkingPropagatedToDemuxedPacket) {
   transport.UnregisterRtpDemuxerSink(&observer);
 }
 
+TEST(RtpTransportTest, DemuxedPacketTakesOverReceiveBuffer) {
+  RtpTransport transport(kMuxDisabled);
+  rtc::FakePacketTransport fake_rtp("fake_rtp");
+  transport.SetRtpPacketTransport(&fake_rtp);
+  TransportObserver observer(&transport);
+  RtpDemuxerCriteria demuxer_criteria;
+  // Add a payload type of kRtpData.
+  demuxer_criteria.payload_types().insert(0x11);
+  transport.RegisterRtpDemuxerSink(demuxer_criteria, &observer);
+
+  rtc::Buffer receive_buffer(kRtpData, kRtpLen);
+  const uint8_t* receive_data = receive_buffer.data();
+  rtc::ReceivedPacket packet(receive_buffer, rtc::SocketAddress());
+  packet.SetTakeableBuffer(&receive_buffer);
+  fake_rtp.NotifyPacketReceived(packet);
+  ASSERT_EQ(observer.rtp_count(), 1);
+  // The demuxed packet uses the memory that the packet was received into.
+  EXPECT_EQ(observer.last_recv_rtp_packet().data(), receive_data);
+  EXPECT_TRUE(receive_buffer.empty());
+
+  transport.UnregisterRtpDemuxerSink(&observer);
+}
+
 // Test that SignalPacketReceived does not fire when a RTP packet with an
 // unhandled payload type is received.
 TEST(RtpTransportTest, DontSignalUnhandledRtpPayloadType) {
@@ -1519,7 +1519,7 @@ rtc::Thread* SdpOfferAnswerHandler::signaling_thread() const {
 }
 
 rtc::Thread* SdpOfferAnswerHandler::network_thread() const {
-  return context_->network_thread();
+  return pc_->network_thread();
 }
 
 void SdpOfferAnswerHandler::CreateOffer(
@@ -1755,7 +1755,7 @@ RTCError SdpOfferAnswerHandler::ApplyLocalDescription(
         // information about DTLS transports.
         if (transceiver->mid()) {
           auto dtls_transport = LookupDtlsTransportByMid(
-              context_->network_thread(), transport_controller_s(),
+              pc_->network_thread(), transport_controller_s(),
               *transceiver->mid());
           transceiver->sender_internal()->set_transport(dtls_transport);
           transceiver->receiver_internal()->set_transport(dtls_transport);
@@ -2219,7 +2219,7 @@ void SdpOfferAnswerHandler::ApplyRemoteDescriptionUpdateTransceiverState(
       // 2.2.8.1.11.[3-6]: Set the transport internal slots.
       if (transceiver->mid()) {
         auto dtls_transport = LookupDtlsTransportByMid(
-            context_->network_thread(), transport_controller_s(),
+            pc_->network_thread(), transport_controller_s(),
             *transceiver->mid());
         transceiver->sender_internal()->set_transport(dtls_transport);
         transceiver->receiver_internal()->set_transport(dtls_transport);
@@ -2400,7 +2400,7 @@ void SdpOfferAnswerHandler::DoSetLocalDescription(
 
     // TODO(deadbeef): We already had to hop to the network thread for
     // MaybeStartGathering...
-    context_->network_thread()->BlockingCall(
+    pc_->network_thread()->BlockingCall(
         [this] { port_allocator()->DiscardCandidatePool(); });
   }
 
@@ -2602,7 +2602,7 @@ void SdpOfferAnswerHandler::SetRemoteDescriptionPostProcess(bool was_answer) {
   if (was_answer) {
     // TODO(deadbeef): We already had to hop to the network thread for
     // MaybeStartGathering...
-    context_->network_thread()->BlockingCall(
+    pc_->network_thread()->BlockingCall(
         [this] { port_allocator()->DiscardCandidatePool(); });
   }
 
@@ -4136,7 +4136,7 @@ void SdpOfferAnswerHandler::GetOptionsForOffer(
   session_options->rtcp_cname = rtcp_cname_;
   session_options->crypto_options = pc_->GetCryptoOptions();
   session_options->pooled_ice_credentials =
-      context_->network_thread()->BlockingCall(
+      pc_->network_thread()->BlockingCall(
           [this] { return port_allocator()->GetPooledIceCredentials(); });
   session_options->offer_extmap_allow_mixed =
       pc_->configuration()->offer_extmap_allow_mixed;
@@ -4419,7 +4419,7 @@ void SdpOfferAnswerHandler::GetOptionsForAnswer(
   session_options->rtcp_cname = rtcp_cname_;
   session_options->crypto_options = pc_->GetCryptoOptions();
   session_options->pooled_ice_credentials =
-      context_->network_thread()->BlockingCall(
+      pc_->network_thread()->BlockingCall(
           [this] { return port_allocator()->GetPooledIceCredentials(); });
 }
 
@@ -196,6 +196,65 @@ bool SrtpSession::ProtectRtp(void* p, int in_len, int max_len, int* out_len) {
   return true;
 }
 
+int SrtpSession::ProtectRtpBatch(rtc::ArrayView<PacketBuffer> packets) {
+  RTC_DCHECK(thread_checker_.IsCurrent());
+  if (!session_) {
+    RTC_LOG(LS_WARNING) << "Failed to protect " << packets.size()
+                        << " SRTP packets: no SRTP Session";
+    for (PacketBuffer& packet : packets) {
+      packet.ok = false;
+    }
+    return 0;
+  }
+
+  int protected_packets = 0;
+  int failures = 0;
+  const PacketBuffer* first_failed = nullptr;
+  int first_err = srtp_err_status_ok;
+  const PacketBuffer* last_protected = nullptr;
+  for (PacketBuffer& packet : packets) {
+    // See ProtectRtp() for the needed length.
+    int err = srtp_err_status_bad_param;
+    int len = packet.len;
+    if (packet.max_len >= packet.len + rtp_auth_tag_len_) {
+      if (dump_plain_rtp_) {
+        DumpPacket(packet.data, packet.len, /*outbound=*/true);
+      }
+      err = srtp_protect(session_, packet.data, &len);
+    }
+    packet.ok = err == srtp_err_status_ok;
+    if (!packet.ok) {
+      if (failures++ == 0) {
+        first_failed = &packet;
+        first_err = err;
+      }
+      continue;
+    }
+    packet.len = len;
+    last_protected = &packet;
+    ++protected_packets;
+  }
+
+  // The RTP header stays in the clear, so the sequence numbers can be read
+  // from the protected packets.
+  if (last_protected) {
+    last_send_seq_num_ = ParseRtpSequenceNumber(rtc::MakeArrayView(
+        static_cast<const uint8_t*>(last_protected->data),
+        last_protected->len));
+  }
+  if (failures > 0) {
+    RTC_LOG(LS_WARNING) << "Failed to protect " << failures << " of "
+                        << packets.size()
+                        << " SRTP packets, first seqnum="
+                        << ParseRtpSequenceNumber(rtc::MakeArrayView(
+                               static_cast<const uint8_t*>(first_failed->data),
+                               first_failed->len))
+                        << ", err=" << first_err
+                        << ", last seqnum=" << last_send_seq_num_;
+  }
+  return protected_packets;
+}
+
 bool SrtpSession::ProtectRtp(void* p,
                              int in_len,
                              int max_len,
@@ -266,6 +325,56 @@ bool SrtpSession::UnprotectRtp(void* p, int in_len, int* out_len) {
   return true;
 }
 
+int SrtpSession::UnprotectRtpBatch(rtc::ArrayView<PacketBuffer> packets) {
+  RTC_DCHECK(thread_checker_.IsCurrent());
+  if (!session_) {
+    RTC_LOG(LS_WARNING) << "Failed to unprotect " << packets.size()
+                        << " SRTP packets: no SRTP Session";
+    for (PacketBuffer& packet : packets) {
+      packet.ok = false;
+    }
+    return 0;
+  }
+
+  int unprotected_packets = 0;
+  int failures = 0;
+  int first_err = srtp_err_status_ok;
+  for (PacketBuffer& packet : packets) {
+    int len = packet.len;
+    int err = srtp_unprotect(session_, packet.data, &len);
+    packet.ok = err == srtp_err_status_ok;
+    if (!packet.ok) {
+      if (failures++ == 0) {
+        first_err = err;
+      }
+      RTC_HISTOGRAM_ENUMERATION("WebRTC.PeerConnection.SrtpUnprotectError",
+                                static_cast<int>(err), kSrtpErrorCodeBoundary);
+      continue;
+    }
+    packet.len = len;
+    if (dump_plain_rtp_) {
+      DumpPacket(packet.data, packet.len, /*outbound=*/false);
+    }
+    ++unprotected_packets;
+  }
+
+  if (failures > 0) {
+    // Throttled like in UnprotectRtp(), but with one line for the batch.
+    const int kFailureLogThrottleCount = 100;
+    if (decryption_failure_count_ % kFailureLogThrottleCount == 0 ||
+        decryption_failure_count_ % kFailureLogThrottleCount + failures >
+            kFailureLogThrottleCount) {
+      RTC_LOG(LS_WARNING) << "Failed to unprotect " << failures << " of "
+                          << packets.size()
+                          << " SRTP packets, first err=" << first_err
+                          << ", previous failure count: "
+                          << decryption_failure_count_;
+    }
+    decryption_failure_count_ += failures;
+  }
+  return unprotected_packets;
+}
+
 bool SrtpSession::UnprotectRtcp(void* p, int in_len, int* out_len) {
   RTC_DCHECK(thread_checker_.IsCurrent());
   if (!session_) {
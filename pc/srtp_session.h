@@ -16,6 +16,7 @@
 
 #include <vector>
 
+#include "api/array_view.h"
 #include "api/field_trials_view.h"
 #include "api/scoped_refptr.h"
 #include "api/sequence_checker.h"
@@ -79,6 +80,27 @@ class SrtpSession {
   bool UnprotectRtp(void* data, int in_len, int* out_len);
   bool UnprotectRtcp(void* data, int in_len, int* out_len);
 
+  // A packet that is protected or unprotected in place by the batch methods.
+  struct PacketBuffer {
+    void* data = nullptr;
+    // Length of the packet, updated when it has been processed.
+    int len = 0;
+    // Capacity of `data`. Only used when protecting.
+    int max_len = 0;
+    // Whether the packet was processed successfully.
+    bool ok = false;
+  };
+
+  // Protects/unprotects RTP `packets` in place and in order, with the same
+  // results as the methods above. libsrtp has no multi-packet entry point, so
+  // every packet still costs one srtp_protect() or srtp_unprotect() call.
+  // What the batch saves is the work around those calls: the session state is
+  // checked once, the sequence number kept for logging is parsed for the last
+  // protected packet only, and failures are logged once per batch.
+  // Returns the number of packets that were processed successfully.
+  int ProtectRtpBatch(rtc::ArrayView<PacketBuffer> packets);
+  int UnprotectRtpBatch(rtc::ArrayView<PacketBuffer> packets);
+
   // Helper method to get authentication params.
   bool GetRtpAuthParams(uint8_t** key, int* key_len, int* tag_len);
 
@@ -0,0 +1,169 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <string.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "pc/srtp_session.h"
+#include "rtc_base/byte_order.h"
+#include "rtc_base/ssl_stream_adapter.h"
+
+namespace cricket {
+namespace {
+
+// Number of packets protected or unprotected per iteration, roughly one pacer
+// burst of video.
+constexpr int kPacketsPerIteration = 32;
+constexpr size_t kRtpHeaderSize = 12;
+// Room for the largest auth tag (AES-GCM).
+constexpr size_t kMaxAuthTagSize = 16;
+constexpr uint32_t kSsrc = 0x12345678;
+// Long enough for the key and salt of any supported crypto suite.
+constexpr uint8_t kKey[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqr";
+
+int KeyLength(int crypto_suite) {
+  int key_length = 0;
+  int salt_length = 0;
+  rtc::GetSrtpKeyAndSaltLengths(crypto_suite, &key_length, &salt_length);
+  return key_length + salt_length;
+}
+
+class Packets {
+ public:
+  explicit Packets(size_t payload_size)
+      : packet_size_(kRtpHeaderSize + payload_size),
+        buffers_(kPacketsPerIteration,
+                 std::vector<uint8_t>(packet_size_ + kMaxAuthTagSize)),
+        batch_(kPacketsPerIteration) {}
+
+  // Writes fresh plain RTP packets with consecutive sequence numbers.
+  void Fill() {
+    for (int i = 0; i < kPacketsPerIteration; ++i) {
+      uint8_t* data = buffers_[i].data();
+      memset(data, 0x5a, packet_size_);
+      data[0] = 0x80;
+      data[1] = 96;
+      rtc::SetBE16(data + 2, sequence_number_++);
+      rtc::SetBE32(data + 4, timestamp_);
+      rtc::SetBE32(data + 8, kSsrc);
+      batch_[i].data = data;
+      batch_[i].len = packet_size_;
+      batch_[i].max_len = buffers_[i].size();
+    }
+    timestamp_ += 3000;
+  }
+
+  size_t packet_size() const { return packet_size_; }
+  std::vector<SrtpSession::PacketBuffer>& batch() { return batch_; }
+
+ private:
+  const size_t packet_size_;
+  std::vector<std::vector<uint8_t>> buffers_;
+  std::vector<SrtpSession::PacketBuffer> batch_;
+  uint16_t sequence_number_ = 0;
+  uint32_t timestamp_ = 0;
+};
+
+// Protects `kPacketsPerIteration` packets with the crypto suite given by the
+// first argument, one ProtectRtp() call per packet or, when the second
+// argument is non-zero, with one ProtectRtpBatch() call. The third argument is
+// the RTP payload size.
+void BM_SrtpProtect(benchmark::State& state) {
+  const int crypto_suite = state.range(0);
+  const bool batch = state.range(1) != 0;
+  SrtpSession session;
+  if (!session.SetSend(crypto_suite, kKey, KeyLength(crypto_suite), {})) {
+    state.SkipWithError("Failed to set up the SRTP session.");
+    return;
+  }
+
+  Packets packets(state.range(2));
+  int64_t protected_packets = 0;
+  for (auto _ : state) {
+    packets.Fill();
+    if (batch) {
+      protected_packets += session.ProtectRtpBatch(packets.batch());
+    } else {
+      for (SrtpSession::PacketBuffer& packet : packets.batch()) {
+        int out_len = 0;
+        if (session.ProtectRtp(packet.data, packet.len, packet.max_len,
+                               &out_len)) {
+          ++protected_packets;
+        }
+      }
+    }
+  }
+  if (protected_packets != state.iterations() * kPacketsPerIteration) {
+    state.SkipWithError("Failed to protect packets.");
+  }
+  state.SetBytesProcessed(protected_packets * packets.packet_size());
+  state.counters["packets_per_second"] =
+      benchmark::Counter(protected_packets, benchmark::Counter::kIsRate);
+}
+
+// Unprotects `kPacketsPerIteration` packets with the crypto suite given by the
+// first argument, one UnprotectRtp() call per packet or, when the second
+// argument is non-zero, with one UnprotectRtpBatch() call. The third argument
+// is the RTP payload size. Protecting the packets is not timed.
+void BM_SrtpUnprotect(benchmark::State& state) {
+  const int crypto_suite = state.range(0);
+  const bool batch = state.range(1) != 0;
+  SrtpSession sender;
+  SrtpSession receiver;
+  if (!sender.SetSend(crypto_suite, kKey, KeyLength(crypto_suite), {}) ||
+      !receiver.SetRecv(crypto_suite, kKey, KeyLength(crypto_suite), {})) {
+    state.SkipWithError("Failed to set up the SRTP sessions.");
+    return;
+  }
+
+  Packets packets(state.range(2));
+  int64_t unprotected_packets = 0;
+  for (auto _ : state) {
+    state.PauseTiming();
+    packets.Fill();
+    sender.ProtectRtpBatch(packets.batch());
+    state.ResumeTiming();
+
+    if (batch) {
+      unprotected_packets += receiver.UnprotectRtpBatch(packets.batch());
+    } else {
+      for (SrtpSession::PacketBuffer& packet : packets.batch()) {
+        int out_len = 0;
+        if (receiver.UnprotectRtp(packet.data, packet.len, &out_len)) {
+          ++unprotected_packets;
+        }
+      }
+    }
+  }
+  if (unprotected_packets != state.iterations() * kPacketsPerIteration) {
+    state.SkipWithError("Failed to unprotect packets.");
+  }
+  state.SetBytesProcessed(unprotected_packets * packets.packet_size());
+  state.counters["packets_per_second"] =
+      benchmark::Counter(unprotected_packets, benchmark::Counter::kIsRate);
+}
+
+// Audio-sized and video-sized payloads for every SRTP crypto suite.
+void SrtpArguments(benchmark::internal::Benchmark* benchmark) {
+  benchmark->ArgNames({"suite", "batch", "payload"})
+      ->ArgsProduct({{rtc::kSrtpAes128CmSha1_80, rtc::kSrtpAes128CmSha1_32,
+                      rtc::kSrtpAeadAes128Gcm, rtc::kSrtpAeadAes256Gcm},
+                     {0, 1},
+                     {160, 1200}});
+}
+
+BENCHMARK(BM_SrtpProtect)->Apply(SrtpArguments);
+BENCHMARK(BM_SrtpUnprotect)->Apply(SrtpArguments);
+
+}  // namespace
+}  // namespace cricket
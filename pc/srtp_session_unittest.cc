@@ -14,6 +14,7 @@
 
 #include <string>
 
+#include "api/array_view.h"
 #include "media/base/fake_rtp.h"
 #include "pc/test/srtp_test_util.h"
 #include "rtc_base/byte_order.h"
@@ -194,6 +195,98 @@ TEST_F(SrtpSessionTest, TestBuffersTooSmall) {
                                sizeof(rtcp_packet_) - 14, &out_len));
 }
 
+// Test that a batch of RTP packets is protected and unprotected like the same
+// packets one at a time, and that a bad packet doesn't fail the whole batch.
+TEST_F(SrtpSessionTest, TestProtectAndUnprotectRtpBatch) {
+  EXPECT_TRUE(s1_.SetSend(kSrtpAes128CmSha1_80, kTestKey1, kTestKeyLen,
+                          kEncryptedHeaderExtensionIds));
+  EXPECT_TRUE(s2_.SetRecv(kSrtpAes128CmSha1_80, kTestKey1, kTestKeyLen,
+                          kEncryptedHeaderExtensionIds));
+  constexpr int kNumPackets = 4;
+  char packets[kNumPackets][sizeof(rtp_packet_)];
+  cricket::SrtpSession::PacketBuffer batch[kNumPackets];
+  for (int i = 0; i < kNumPackets; ++i) {
+    memcpy(packets[i], kPcmuFrame, rtp_len_);
+    SetBE16(reinterpret_cast<uint8_t*>(packets[i]) + 2, i + 1);
+    batch[i].data = packets[i];
+    batch[i].len = rtp_len_;
+    batch[i].max_len = sizeof(packets[i]);
+  }
+
+  EXPECT_EQ(kNumPackets, s1_.ProtectRtpBatch(batch));
+  for (int i = 0; i < kNumPackets; ++i) {
+    EXPECT_TRUE(batch[i].ok);
+    EXPECT_EQ(rtp_len_ + rtp_auth_tag_len(kCsAesCm128HmacSha1_80),
+              batch[i].len);
+  }
+
+  // Tamper with the payload of the second packet.
+  packets[1][rtp_len_ - 1] ^= 0x01;
+  EXPECT_EQ(kNumPackets - 1, s2_.UnprotectRtpBatch(batch));
+  for (int i = 0; i < kNumPackets; ++i) {
+    if (i == 1) {
+      EXPECT_FALSE(batch[i].ok);
+      continue;
+    }
+    EXPECT_TRUE(batch[i].ok);
+    EXPECT_EQ(rtp_len_, batch[i].len);
+    // Everything but the sequence number matches the original packet.
+    EXPECT_EQ(0, memcmp(packets[i] + 4, kPcmuFrame + 4, rtp_len_ - 4));
+  }
+}
+
+// Test that failures in a batch are reported per packet.
+TEST_F(SrtpSessionTest, TestRtpBatchReportsEachFailure) {
+  EXPECT_TRUE(s1_.SetSend(kSrtpAes128CmSha1_80, kTestKey1, kTestKeyLen,
+                          kEncryptedHeaderExtensionIds));
+  EXPECT_TRUE(s2_.SetRecv(kSrtpAes128CmSha1_80, kTestKey1, kTestKeyLen,
+                          kEncryptedHeaderExtensionIds));
+  constexpr int kNumPackets = 4;
+  char packets[kNumPackets][sizeof(rtp_packet_)];
+  cricket::SrtpSession::PacketBuffer batch[kNumPackets];
+  for (int i = 0; i < kNumPackets; ++i) {
+    memcpy(packets[i], kPcmuFrame, rtp_len_);
+    SetBE16(reinterpret_cast<uint8_t*>(packets[i]) + 2, i + 1);
+    batch[i].data = packets[i];
+    batch[i].len = rtp_len_;
+    batch[i].max_len = sizeof(packets[i]);
+  }
+  // No room for the auth tag of the third packet.
+  batch[2].max_len = rtp_len_;
+
+  EXPECT_EQ(kNumPackets - 1, s1_.ProtectRtpBatch(batch));
+  EXPECT_TRUE(batch[0].ok);
+  EXPECT_TRUE(batch[1].ok);
+  EXPECT_FALSE(batch[2].ok);
+  EXPECT_EQ(rtp_len_, batch[2].len);
+  EXPECT_TRUE(batch[3].ok);
+
+  // Tamper with the first two packets and leave out the unprotected one.
+  packets[0][rtp_len_ - 1] ^= 0x01;
+  packets[1][rtp_len_ - 1] ^= 0x01;
+  batch[2] = batch[3];
+  EXPECT_EQ(1, s2_.UnprotectRtpBatch(rtc::MakeArrayView(batch, 3)));
+  EXPECT_FALSE(batch[0].ok);
+  EXPECT_FALSE(batch[1].ok);
+  EXPECT_TRUE(batch[2].ok);
+  EXPECT_THAT(
+      webrtc::metrics::Samples("WebRTC.PeerConnection.SrtpUnprotectError"),
+      ElementsAre(Pair(srtp_err_status_auth_fail, 2)));
+}
+
+// Test that batches fail as a whole without keys.
+TEST_F(SrtpSessionTest, TestRtpBatchWithoutSession) {
+  cricket::SrtpSession::PacketBuffer batch[1];
+  batch[0].data = rtp_packet_;
+  batch[0].len = rtp_len_;
+  batch[0].max_len = sizeof(rtp_packet_);
+  batch[0].ok = true;
+  EXPECT_EQ(0, s1_.ProtectRtpBatch(batch));
+  EXPECT_FALSE(batch[0].ok);
+  EXPECT_EQ(0, s2_.UnprotectRtpBatch(batch));
+  EXPECT_FALSE(batch[0].ok);
+}
+
 TEST_F(SrtpSessionTest, TestReplay) {
   static const uint16_t kMaxSeqnum = static_cast<uint16_t>(-1);
   static const uint16_t seqnum_big = 62275;
@@ -17,6 +17,7 @@
 #include <vector>
 
 #include "absl/strings/match.h"
+#include "api/array_view.h"
 #include "media/base/rtp_utils.h"
 #include "modules/rtp_rtcp/source/rtp_util.h"
 #include "pc/rtp_transport.h"
@@ -35,7 +36,9 @@ namespace webrtc {
 
 SrtpTransport::SrtpTransport(bool rtcp_mux_enabled,
                              const FieldTrialsView& field_trials)
-    : RtpTransport(rtcp_mux_enabled), field_trials_(field_trials) {}
+    : RtpTransport(rtcp_mux_enabled),
+      field_trials_(field_trials),
+      send_batch_(kMaxSendBatchSize, [this] { FlushSendBatch(); }) {}
 
 bool SrtpTransport::SendRtpPacket(rtc::CopyOnWriteBuffer* packet,
                                   const rtc::PacketOptions& options,
@@ -45,6 +48,12 @@ bool SrtpTransport::SendRtpPacket(rtc::CopyOnWriteBuffer* packet,
         << "Failed to send the packet because SRTP transport is inactive.";
     return false;
   }
+  if (options.batchable && !IsExternalAuthActive()) {
+    return AddToSendBatch(packet, options, flags);
+  }
+  // Keep packets in order.
+  FlushSendBatch();
+
   rtc::PacketOptions updated_options = options;
   TRACE_EVENT0("webrtc", "SRTP Encode");
   bool res;
@@ -93,6 +102,85 @@ bool SrtpTransport::SendRtpPacket(rtc::CopyOnWriteBuffer* packet,
   return SendPacket(/*rtcp=*/false, packet, updated_options, flags);
 }
 
+bool SrtpTransport::AddToSendBatch(rtc::CopyOnWriteBuffer* packet,
+                                   const rtc::PacketOptions& options,
+                                   int flags) {
+  PendingRtpPacket* pending = send_batch_.Add();
+  if (!pending) {
+    rtc::PacketOptions unbatched_options = options;
+    unbatched_options.batchable = false;
+    return SendRtpPacket(packet, unbatched_options, flags);
+  }
+  // The packet is protected in place later, so take it over rather than
+  // sharing the caller's buffer.
+  pending->packet = std::move(*packet);
+  pending->options = options;
+  pending->flags = flags;
+  if (options.last_packet_in_batch || send_batch_.full()) {
+    return FlushSendBatch();
+  }
+  // A packet that is held back is reported as sent. If it fails once the
+  // batch is flushed at the end of the task, that shows in
+  // GetSendBatchStats().
+  return true;
+}
+
+bool SrtpTransport::FlushSendBatch() {
+  if (send_batch_.empty()) {
+    return true;
+  }
+  rtc::ArrayView<PendingRtpPacket> batch = send_batch_.entries();
+  send_batch_.Clear();
+  TRACE_EVENT1("webrtc", "SRTP Encode Batch", "count", batch.size());
+  if (!IsSrtpActive()) {
+    RTC_LOG(LS_ERROR) << "Failed to send " << batch.size()
+                      << " packets because SRTP transport is inactive.";
+    send_batch_stats_.inactive_drops += batch.size();
+    for (PendingRtpPacket& pending : batch) {
+      pending.packet = rtc::CopyOnWriteBuffer();
+    }
+    return false;
+  }
+
+  srtp_packets_.resize(batch.size());
+  for (size_t i = 0; i < batch.size(); ++i) {
+    rtc::CopyOnWriteBuffer& packet = batch[i].packet;
+    srtp_packets_[i].data = packet.MutableData();
+    srtp_packets_[i].len = rtc::checked_cast<int>(packet.size());
+    srtp_packets_[i].max_len = static_cast<int>(packet.capacity());
+  }
+  send_session_->ProtectRtpBatch(srtp_packets_);
+
+  bool sent_all = true;
+  for (size_t i = 0; i < batch.size(); ++i) {
+    PendingRtpPacket& pending = batch[i];
+    if (!srtp_packets_[i].ok) {
+      RTC_LOG(LS_ERROR) << "Failed to protect RTP packet: size="
+                        << pending.packet.size()
+                        << ", seqnum=" << ParseRtpSequenceNumber(pending.packet)
+                        << ", SSRC=" << ParseRtpSsrc(pending.packet);
+      ++send_batch_stats_.protect_failures;
+      sent_all = false;
+    } else {
+      pending.packet.SetSize(srtp_packets_[i].len);
+      if (SendPacket(/*rtcp=*/false, &pending.packet, pending.options,
+                     pending.flags)) {
+        ++send_batch_stats_.sent_packets;
+      } else {
+        ++send_batch_stats_.send_failures;
+        sent_all = false;
+      }
+    }
+    // Entries are reused, so drop the reference to the packet's buffer.
+    pending.packet = rtc::CopyOnWriteBuffer();
+  }
+  return sent_all;
+}
+
+SrtpTransport::SendBatchStats SrtpTransport::GetSendBatchStats() const {
+  return send_batch_stats_;
+}
+
 bool SrtpTransport::SendRtcpPacket(rtc::CopyOnWriteBuffer* packet,
                                    const rtc::PacketOptions& options,
                                    int flags) {
@@ -102,6 +190,9 @@ bool SrtpTransport::SendRtcpPacket(rtc::CopyOnWriteBuffer* packet,
     return false;
   }
 
+  // Keep packets in order.
+  FlushSendBatch();
+
   TRACE_EVENT0("webrtc", "SRTP Encode");
   uint8_t* data = packet->MutableData();
   int len = rtc::checked_cast<int>(packet->size());
@@ -126,21 +217,14 @@ void SrtpTransport::OnRtpPacketReceived(const rtc::ReceivedPacket& packet) {
     return;
   }
 
-  rtc::CopyOnWriteBuffer payload(packet.payload());
+  // Decrypts in place in the socket's receive buffer when the packet allows
+  // taking it over, so that the payload is not copied on its way to the
+  // demuxer.
+  rtc::CopyOnWriteBuffer payload = rtc::ReceivedPacket(packet).TakePayload();
   char* data = payload.MutableData<char>();
   int len = rtc::checked_cast<int>(payload.size());
   if (!UnprotectRtp(data, len, &len)) {
-    // Limit the error logging to avoid excessive logs when there are lots of
-    // bad packets.
-    const int kFailureLogThrottleCount = 100;
-    if (decryption_failure_count_ % kFailureLogThrottleCount == 0) {
-      RTC_LOG(LS_ERROR) << "Failed to unprotect RTP packet: size=" << len
-                        << ", seqnum=" << ParseRtpSequenceNumber(payload)
-                        << ", SSRC=" << ParseRtpSsrc(payload)
-                        << ", previous failure count: "
-                        << decryption_failure_count_;
-    }
-    ++decryption_failure_count_;
+    LogUnprotectRtpFailure(payload, len);
     return;
   }
   payload.SetSize(len);
@@ -149,6 +233,55 @@ void SrtpTransport::OnRtpPacketReceived(const rtc::ReceivedPacket& packet) {
               packet.ecn());
 }
 
+void SrtpTransport::OnRtpPacketsReceived(
+    rtc::ArrayView<const rtc::ReceivedPacket> packets) {
+  TRACE_EVENT1("webrtc", "SrtpTransport::OnRtpPacketsReceived", "count",
+               packets.size());
+  if (!IsSrtpActive()) {
+    RTC_LOG(LS_WARNING) << "Inactive SRTP transport received " << packets.size()
+                        << " RTP packets. Drop them.";
+    return;
+  }
+
+  received_payloads_.clear();
+  srtp_packets_.resize(packets.size());
+  for (size_t i = 0; i < packets.size(); ++i) {
+    received_payloads_.push_back(rtc::ReceivedPacket(packets[i]).TakePayload());
+    rtc::CopyOnWriteBuffer& payload = received_payloads_.back();
+    srtp_packets_[i].data = payload.MutableData();
+    srtp_packets_[i].len = rtc::checked_cast<int>(payload.size());
+  }
+  recv_session_->UnprotectRtpBatch(srtp_packets_);
+
+  for (size_t i = 0; i < packets.size(); ++i) {
+    rtc::CopyOnWriteBuffer& payload = received_payloads_[i];
+    if (!srtp_packets_[i].ok) {
+      LogUnprotectRtpFailure(payload, srtp_packets_[i].len);
+      continue;
+    }
+    payload.SetSize(srtp_packets_[i].len);
+    DemuxPacket(std::move(payload),
+                packets[i].arrival_time().value_or(Timestamp::MinusInfinity()),
+                packets[i].ecn());
+  }
+  received_payloads_.clear();
+}
+
+void SrtpTransport::LogUnprotectRtpFailure(const rtc::CopyOnWriteBuffer& packet,
+                                           int len) {
+  // Limit the error logging to avoid excessive logs when there are lots of
+  // bad packets.
+  const int kFailureLogThrottleCount = 100;
+  if (decryption_failure_count_ % kFailureLogThrottleCount == 0) {
+    RTC_LOG(LS_ERROR) << "Failed to unprotect RTP packet: size=" << len
+                      << ", seqnum=" << ParseRtpSequenceNumber(packet)
+                      << ", SSRC=" << ParseRtpSsrc(packet)
+                      << ", previous failure count: "
+                      << decryption_failure_count_;
+  }
+  ++decryption_failure_count_;
+}
+
 void SrtpTransport::OnRtcpPacketReceived(const rtc::ReceivedPacket& packet) {
   TRACE_EVENT0("webrtc", "SrtpTransport::OnRtcpPacketReceived");
   if (!IsSrtpActive()) {
@@ -156,7 +289,7 @@ void SrtpTransport::OnRtcpPacketReceived(const rtc::ReceivedPacket& packet) {
         << "Inactive SRTP transport received an RTCP packet. Drop it.";
     return;
   }
-  rtc::CopyOnWriteBuffer payload(packet.payload());
+  rtc::CopyOnWriteBuffer payload = rtc::ReceivedPacket(packet).TakePayload();
   char* data = payload.MutableData<char>();
   int len = rtc::checked_cast<int>(payload.size());
   if (!UnprotectRtcp(data, len, &len)) {
@@ -197,6 +330,9 @@ bool SrtpTransport::SetRtpParams(int send_crypto_suite,
                                  const uint8_t* recv_key,
                                  int recv_key_len,
                                  const std::vector<int>& recv_extension_ids) {
+  // Packets queued before the update are protected with the old keys.
+  FlushSendBatch();
+
   // If parameters are being set for the first time, we should create new SRTP
   // sessions and call "SetSend/SetRecv". Otherwise we should call
   // "UpdateSend"/"UpdateRecv" on the existing sessions, which will internally
@@ -279,6 +415,7 @@ bool SrtpTransport::IsWritable(bool rtcp) const {
 }
 
 void SrtpTransport::ResetParams() {
+  FlushSendBatch();
   send_session_ = nullptr;
   recv_session_ = nullptr;
   send_rtcp_session_ = nullptr;
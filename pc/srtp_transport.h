@@ -19,6 +19,7 @@
 #include <vector>
 
 #include "absl/types/optional.h"
+#include "api/array_view.h"
 #include "api/field_trials_view.h"
 #include "api/rtc_error.h"
 #include "p2p/base/packet_transport_internal.h"
@@ -28,14 +29,34 @@
 #include "rtc_base/buffer.h"
 #include "rtc_base/copy_on_write_buffer.h"
 #include "rtc_base/network_route.h"
+#include "rtc_base/send_batch.h"
 
 namespace webrtc {
 
 // This subclass of the RtpTransport is used for SRTP which is reponsible for
 // protecting/unprotecting the packets. It provides interfaces to set the crypto
 // parameters for the SrtpSession underneath.
+// RTP packets sent with PacketOptions::batchable are held back until the
+// packet with `last_packet_in_batch` is sent or the current task ends, and are
+// then protected with one SrtpSession::ProtectRtpBatch call. A send that
+// flushes the batch fails if any packet of the batch could not be protected
+// or sent; failures of batches flushed at the end of a task are only counted
+// in GetSendBatchStats(). RTP packets
+// received together are unprotected with one SrtpSession::UnprotectRtpBatch
+// call.
 class SrtpTransport : public RtpTransport {
  public:
+  struct SendBatchStats {
+    // Batched RTP packets that were protected and handed to the transport.
+    int64_t sent_packets = 0;
+    // Batched RTP packets that SRTP failed to protect.
+    int64_t protect_failures = 0;
+    // Protected batched RTP packets that the transport failed to send.
+    int64_t send_failures = 0;
+    // Batched RTP packets dropped because SRTP was no longer active.
+    int64_t inactive_drops = 0;
+  };
+
   SrtpTransport(bool rtcp_mux_enabled, const FieldTrialsView& field_trials);
 
   virtual ~SrtpTransport() = default;
@@ -105,6 +126,8 @@ class SrtpTransport : public RtpTransport {
     rtp_abs_sendtime_extn_id_ = rtp_abs_sendtime_extn_id;
   }
 
+  SendBatchStats GetSendBatchStats() const;
+
   // In addition to unregistering the sink, the SRTP transport
   // disassociates all SSRCs of the sink from libSRTP.
   bool UnregisterRtpDemuxerSink(RtpPacketSinkInterface* sink) override;
@@ -118,6 +141,8 @@ class SrtpTransport : public RtpTransport {
   void CreateSrtpSessions();
 
   void OnRtpPacketReceived(const rtc::ReceivedPacket& packet) override;
+  void OnRtpPacketsReceived(
+      rtc::ArrayView<const rtc::ReceivedPacket> packets) override;
   void OnRtcpPacketReceived(const rtc::ReceivedPacket& packet) override;
   void OnNetworkRouteChanged(
       absl::optional<rtc::NetworkRoute> network_route) override;
@@ -141,6 +166,16 @@ class SrtpTransport : public RtpTransport {
 
   bool UnprotectRtcp(void* data, int in_len, int* out_len);
 
+  void LogUnprotectRtpFailure(const rtc::CopyOnWriteBuffer& packet, int len);
+
+  // Queues a batchable RTP packet until the end of its batch.
+  bool AddToSendBatch(rtc::CopyOnWriteBuffer* packet,
+                      const rtc::PacketOptions& options,
+                      int flags);
+  // Protects and sends the queued RTP packets. Returns false if any of them
+  // failed.
+  bool FlushSendBatch();
+
   bool MaybeSetKeyParams();
   bool ParseKeyParams(const std::string& key_params, uint8_t* key, size_t len);
 
@@ -165,6 +200,19 @@ class SrtpTransport : public RtpTransport {
   int decryption_failure_count_ = 0;
 
   const FieldTrialsView& field_trials_;
+
+  struct PendingRtpPacket {
+    rtc::CopyOnWriteBuffer packet;
+    rtc::PacketOptions options;
+    int flags = 0;
+  };
+  static constexpr size_t kMaxSendBatchSize = 64;
+  rtc::SendBatch<PendingRtpPacket> send_batch_;
+  SendBatchStats send_batch_stats_;
+
+  // Scratch space for the batch calls into the SRTP sessions.
+  std::vector<cricket::SrtpSession::PacketBuffer> srtp_packets_;
+  std::vector<rtc::CopyOnWriteBuffer> received_payloads_;
 };
 
 }  // namespace webrtc
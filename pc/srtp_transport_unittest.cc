@@ -18,14 +18,17 @@
 #include "media/base/fake_rtp.h"
 #include "p2p/base/dtls_transport_internal.h"
 #include "p2p/base/fake_packet_transport.h"
+#include "pc/srtp_session.h"
 #include "pc/test/rtp_transport_test_util.h"
 #include "pc/test/srtp_test_util.h"
 #include "rtc_base/async_packet_socket.h"
 #include "rtc_base/byte_order.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/containers/flat_set.h"
+#include "rtc_base/network/received_packet.h"
 #include "rtc_base/ssl_stream_adapter.h"
 #include "rtc_base/third_party/sigslot/sigslot.h"
+#include "rtc_base/thread.h"
 #include "test/gtest.h"
 #include "test/scoped_key_value_config.h"
 
@@ -414,6 +417,114 @@ INSTANTIATE_TEST_SUITE_P(ExternalAuth,
                          SrtpTransportTestWithExternalAuth,
                          ::testing::Values(true, false));
 
+TEST_F(SrtpTransportTest, SendsBatchablePacketsAtEndOfBatch) {
+  rtc::AutoThread main_thread;
+  std::vector<int> extension_ids;
+  ASSERT_TRUE(srtp_transport1_->SetRtpParams(
+      rtc::kSrtpAes128CmSha1_80, kTestKey1, kTestKeyLen, extension_ids,
+      rtc::kSrtpAes128CmSha1_80, kTestKey2, kTestKeyLen, extension_ids));
+  ASSERT_TRUE(srtp_transport2_->SetRtpParams(
+      rtc::kSrtpAes128CmSha1_80, kTestKey2, kTestKeyLen, extension_ids,
+      rtc::kSrtpAes128CmSha1_80, kTestKey1, kTestKeyLen, extension_ids));
+
+  const size_t packet_size =
+      sizeof(kPcmuFrame) + rtc::rtp_auth_tag_len(rtc::kCsAesCm128HmacSha1_80);
+  rtc::PacketOptions options;
+  options.batchable = true;
+  for (int i = 0; i < 3; ++i) {
+    rtc::CopyOnWriteBuffer packet(kPcmuFrame, sizeof(kPcmuFrame), packet_size);
+    rtc::SetBE16(packet.MutableData() + 2, ++sequence_number_);
+    options.last_packet_in_batch = i == 2;
+    EXPECT_TRUE(srtp_transport1_->SendRtpPacket(&packet, options,
+                                                cricket::PF_SRTP_BYPASS));
+    EXPECT_EQ(i == 2 ? 3 : 0, rtp_sink2_.rtp_count());
+  }
+
+  // A batch without a last packet is sent once the current task is done.
+  options.last_packet_in_batch = false;
+  rtc::CopyOnWriteBuffer packet(kPcmuFrame, sizeof(kPcmuFrame), packet_size);
+  rtc::SetBE16(packet.MutableData() + 2, ++sequence_number_);
+  EXPECT_TRUE(srtp_transport1_->SendRtpPacket(&packet, options,
+                                              cricket::PF_SRTP_BYPASS));
+  EXPECT_EQ(3, rtp_sink2_.rtp_count());
+  main_thread.ProcessMessages(0);
+  EXPECT_EQ(4, rtp_sink2_.rtp_count());
+  EXPECT_EQ(sequence_number_,
+            rtp_sink2_.last_recv_rtp_packet().SequenceNumber());
+}
+
+TEST_F(SrtpTransportTest, ReportsBatchedPacketsThatFailToProtect) {
+  rtc::AutoThread main_thread;
+  std::vector<int> extension_ids;
+  ASSERT_TRUE(srtp_transport1_->SetRtpParams(
+      rtc::kSrtpAes128CmSha1_80, kTestKey1, kTestKeyLen, extension_ids,
+      rtc::kSrtpAes128CmSha1_80, kTestKey2, kTestKeyLen, extension_ids));
+  ASSERT_TRUE(srtp_transport2_->SetRtpParams(
+      rtc::kSrtpAes128CmSha1_80, kTestKey2, kTestKeyLen, extension_ids,
+      rtc::kSrtpAes128CmSha1_80, kTestKey1, kTestKeyLen, extension_ids));
+
+  const size_t packet_size =
+      sizeof(kPcmuFrame) + rtc::rtp_auth_tag_len(rtc::kCsAesCm128HmacSha1_80);
+  rtc::PacketOptions options;
+  options.batchable = true;
+  for (int i = 0; i < 3; ++i) {
+    // The second packet has no room for the auth tag.
+    rtc::CopyOnWriteBuffer packet(kPcmuFrame, sizeof(kPcmuFrame),
+                                  i == 1 ? sizeof(kPcmuFrame) : packet_size);
+    rtc::SetBE16(packet.MutableData() + 2, ++sequence_number_);
+    options.last_packet_in_batch = i == 2;
+    // The send that flushes the batch reports the failure.
+    EXPECT_EQ(i < 2, srtp_transport1_->SendRtpPacket(&packet, options,
+                                                     cricket::PF_SRTP_BYPASS));
+  }
+  EXPECT_EQ(2, rtp_sink2_.rtp_count());
+  SrtpTransport::SendBatchStats stats = srtp_transport1_->GetSendBatchStats();
+  EXPECT_EQ(stats.sent_packets, 2);
+  EXPECT_EQ(stats.protect_failures, 1);
+  EXPECT_EQ(stats.send_failures, 0);
+  EXPECT_EQ(stats.inactive_drops, 0);
+}
+
+TEST_F(SrtpTransportTest, UnprotectsPacketsReceivedTogether) {
+  std::vector<int> extension_ids;
+  ASSERT_TRUE(srtp_transport2_->SetRtpParams(
+      rtc::kSrtpAes128CmSha1_80, kTestKey2, kTestKeyLen, extension_ids,
+      rtc::kSrtpAes128CmSha1_80, kTestKey1, kTestKeyLen, extension_ids));
+  cricket::SrtpSession sender(field_trials_);
+  ASSERT_TRUE(sender.SetSend(rtc::kSrtpAes128CmSha1_80, kTestKey1, kTestKeyLen,
+                             extension_ids));
+
+  constexpr int kNumPackets = 4;
+  const size_t packet_size =
+      sizeof(kPcmuFrame) + rtc::rtp_auth_tag_len(rtc::kCsAesCm128HmacSha1_80);
+  std::vector<rtc::Buffer> buffers;
+  for (int i = 0; i < kNumPackets; ++i) {
+    rtc::Buffer buffer(kPcmuFrame, sizeof(kPcmuFrame), packet_size);
+    rtc::SetBE16(buffer.data() + 2, ++sequence_number_);
+    int len = 0;
+    ASSERT_TRUE(sender.ProtectRtp(buffer.data(),
+                                  static_cast<int>(buffer.size()),
+                                  static_cast<int>(packet_size), &len));
+    buffer.SetSize(len);
+    buffers.push_back(std::move(buffer));
+  }
+  // Corrupt the third packet; the others must still get through.
+  buffers[2][buffers[2].size() - 1] ^= 0x01;
+
+  const rtc::SocketAddress address;
+  std::vector<rtc::ReceivedPacket> packets;
+  for (const rtc::Buffer& buffer : buffers) {
+    packets.emplace_back(buffer, address, /*arrival_time=*/absl::nullopt,
+                         rtc::EcnMarking::kNotEct,
+                         rtc::ReceivedPacket::kSrtpEncrypted);
+  }
+  rtp_packet_transport2_->NotifyPacketsReceived(packets);
+
+  EXPECT_EQ(kNumPackets - 1, rtp_sink2_.rtp_count());
+  EXPECT_EQ(sequence_number_,
+            rtp_sink2_.last_recv_rtp_packet().SequenceNumber());
+}
+
 // Test directly setting the params with bogus keys.
 TEST_F(SrtpTransportTest, TestSetParamsKeyTooShort) {
   std::vector<int> extension_ids;
@@ -530,7 +530,8 @@ class FakePeerConnectionForStats : public FakePeerConnectionBase {
   CreateTransceiverOfType(cricket::MediaType media_type) {
     auto transceiver = RtpTransceiverProxyWithInternal<RtpTransceiver>::Create(
         signaling_thread_,
-        rtc::make_ref_counted<RtpTransceiver>(media_type, context_.get()));
+        rtc::make_ref_counted<RtpTransceiver>(media_type, context_.get(),
+                                              network_thread_));
     transceivers_.push_back(transceiver);
     return transceiver;
   }
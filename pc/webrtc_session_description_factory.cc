@@ -32,7 +32,9 @@
 #include "rtc_base/ssl_identity.h"
 #include "rtc_base/ssl_stream_adapter.h"
 #include "rtc_base/string_encode.h"
+#include "rtc_base/time_utils.h"
 #include "rtc_base/unique_id_generator.h"
+#include "system_wrappers/include/metrics.h"
 
 using cricket::MediaSessionOptions;
 using rtc::UniqueRandomIdGenerator;
@@ -124,7 +126,8 @@ WebRtcSessionDescriptionFactory::WebRtcSessionDescriptionFactory(
       sdp_info_(sdp_info),
       session_id_(session_id),
       certificate_request_state_(CERTIFICATE_NOT_NEEDED),
-      on_certificate_ready_(on_certificate_ready) {
+      on_certificate_ready_(on_certificate_ready),
+      creation_time_ms_(rtc::TimeMillis()) {
   RTC_DCHECK(signaling_thread_);
 
   if (!dtls_enabled) {
@@ -302,6 +305,13 @@ void WebRtcSessionDescriptionFactory::InternalCreateOffer(
       }
     }
   }
+  if (creation_time_ms_) {
+    // Includes waiting for the certificate, which dominates when it has to be
+    // generated.
+    RTC_HISTOGRAM_COUNTS_10000("WebRTC.PeerConnection.TimeToFirstOfferMs",
+                               rtc::TimeMillis() - *creation_time_ms_);
+    creation_time_ms_ = absl::nullopt;
+  }
   PostCreateSessionDescriptionSucceeded(request.observer.get(),
                                         std::move(offer));
 }
@@ -19,6 +19,7 @@
 #include <string>
 
 #include "absl/functional/any_invocable.h"
+#include "absl/types/optional.h"
 #include "api/jsep.h"
 #include "api/peer_connection_interface.h"
 #include "api/scoped_refptr.h"
@@ -145,6 +146,10 @@ class WebRtcSessionDescriptionFactory {
   std::function<void(const rtc::scoped_refptr<rtc::RTCCertificate>&)>
       on_certificate_ready_;
 
+  // Creation time, for the time-to-first-offer metric. Unset once the metric
+  // has been reported.
+  absl::optional<int64_t> creation_time_ms_;
+
   rtc::WeakPtrFactory<WebRtcSessionDescriptionFactory> weak_factory_{this};
 };
 }  // namespace webrtc
@@ -53,15 +53,47 @@ void AsyncPacketSocket::DeregisterReceivedPacketCallback() {
   received_packet_callback_ = nullptr;
 }
 
+void AsyncPacketSocket::RegisterReceivedPacketBatchCallback(
+    absl::AnyInvocable<void(AsyncPacketSocket*,
+                            rtc::ArrayView<const rtc::ReceivedPacket>)>
+        received_packet_batch_callback) {
+  RTC_DCHECK_RUN_ON(&network_checker_);
+  RTC_CHECK(!received_packet_batch_callback_);
+  received_packet_batch_callback_ = std::move(received_packet_batch_callback);
+}
+
+void AsyncPacketSocket::DeregisterReceivedPacketBatchCallback() {
+  RTC_DCHECK_RUN_ON(&network_checker_);
+  received_packet_batch_callback_ = nullptr;
+}
+
 void AsyncPacketSocket::NotifyPacketReceived(
     const rtc::ReceivedPacket& packet) {
   RTC_DCHECK_RUN_ON(&network_checker_);
+  if (received_packet_batch_callback_) {
+    received_packet_batch_callback_(this, rtc::MakeArrayView(&packet, 1));
+    return;
+  }
   if (received_packet_callback_) {
     received_packet_callback_(this, packet);
     return;
   }
 }
 
+void AsyncPacketSocket::NotifyPacketsReceived(
+    rtc::ArrayView<const rtc::ReceivedPacket> packets) {
+  RTC_DCHECK_RUN_ON(&network_checker_);
+  if (received_packet_batch_callback_) {
+    received_packet_batch_callback_(this, packets);
+    return;
+  }
+  if (received_packet_callback_) {
+    for (const rtc::ReceivedPacket& packet : packets) {
+      received_packet_callback_(this, packet);
+    }
+  }
+}
+
 void CopySocketInformationToPacketInfo(size_t packet_size_bytes,
                                        const AsyncPacketSocket& socket_from,
                                        bool is_connectionless,
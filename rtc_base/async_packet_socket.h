@@ -14,6 +14,7 @@
 #include <cstdint>
 #include <vector>
 
+#include "api/array_view.h"
 #include "api/sequence_checker.h"
 #include "rtc_base/callback_list.h"
 #include "rtc_base/dscp.h"
@@ -65,8 +66,8 @@ struct RTC_EXPORT PacketOptions {
   // PacketInfo is passed to SentPacket when signaling this packet is sent.
   PacketInfo info_signaled_after_sent;
   // True if this is a batchable packet. Batchable packets are collected at low
-  // levels and sent first when their AsyncPacketSocket receives a
-  // OnSendBatchComplete call.
+  // levels and sent together once the packet marked `last_packet_in_batch` is
+  // sent. AsyncUDPSocket sends them with a single Socket::SendToBatch call.
   bool batchable = false;
   // True if this is the last packet of a batch.
   bool last_packet_in_batch = false;
@@ -130,6 +131,16 @@ class RTC_EXPORT AsyncPacketSocket : public sigslot::has_slots<> {
           received_packet_callback);
   void DeregisterReceivedPacketCallback();
 
+  // Registers a callback that receives all packets read from the underlying
+  // socket in one go. While registered, it takes precedence over the
+  // per-packet callback; sockets that don't read in batches deliver batches
+  // of one packet.
+  void RegisterReceivedPacketBatchCallback(
+      absl::AnyInvocable<void(AsyncPacketSocket*,
+                              rtc::ArrayView<const rtc::ReceivedPacket>)>
+          received_packet_batch_callback);
+  void DeregisterReceivedPacketBatchCallback();
+
   // Emitted each time a packet is sent.
   sigslot::signal2<AsyncPacketSocket*, const SentPacket&> SignalSentPacket;
 
@@ -160,6 +171,7 @@ class RTC_EXPORT AsyncPacketSocket : public sigslot::has_slots<> {
   }
 
   void NotifyPacketReceived(const rtc::ReceivedPacket& packet);
+  void NotifyPacketsReceived(rtc::ArrayView<const rtc::ReceivedPacket> packets);
 
   RTC_NO_UNIQUE_ADDRESS webrtc::SequenceChecker network_checker_{
       webrtc::SequenceChecker::kDetached};
@@ -169,6 +181,9 @@ class RTC_EXPORT AsyncPacketSocket : public sigslot::has_slots<> {
       RTC_GUARDED_BY(&network_checker_);
   absl::AnyInvocable<void(AsyncPacketSocket*, const rtc::ReceivedPacket&)>
       received_packet_callback_ RTC_GUARDED_BY(&network_checker_);
+  absl::AnyInvocable<void(AsyncPacketSocket*,
+                          rtc::ArrayView<const rtc::ReceivedPacket>)>
+      received_packet_batch_callback_ RTC_GUARDED_BY(&network_checker_);
 };
 
 // Listen socket, producing an AsyncPacketSocket when a peer connects.
@@ -49,6 +49,7 @@ class MockAsyncPacketSocket : public rtc::AsyncPacketSocket {
   MOCK_METHOD(void, SetError, (int error), (override));
 
   using AsyncPacketSocket::NotifyPacketReceived;
+  using AsyncPacketSocket::NotifyPacketsReceived;
 };
 
 TEST(AsyncPacketSocket, RegisteredCallbackReceivePacketsFromNotify) {
@@ -61,5 +62,38 @@ TEST(AsyncPacketSocket, RegisteredCallbackReceivePacketsFromNotify) {
   mock_socket.NotifyPacketReceived(ReceivedPacket({}, SocketAddress()));
 }
 
+TEST(AsyncPacketSocket, BatchIsDeliveredPerPacketWithoutBatchCallback) {
+  MockAsyncPacketSocket mock_socket;
+  MockFunction<void(AsyncPacketSocket*, const rtc::ReceivedPacket&)>
+      received_packet;
+  SocketAddress address;
+  const ReceivedPacket packets[] = {ReceivedPacket({}, address),
+                                    ReceivedPacket({}, address)};
+
+  EXPECT_CALL(received_packet, Call).Times(2);
+  mock_socket.RegisterReceivedPacketCallback(received_packet.AsStdFunction());
+  mock_socket.NotifyPacketsReceived(packets);
+}
+
+TEST(AsyncPacketSocket, BatchCallbackTakesPrecedence) {
+  MockAsyncPacketSocket mock_socket;
+  MockFunction<void(AsyncPacketSocket*, const rtc::ReceivedPacket&)>
+      received_packet;
+  MockFunction<void(AsyncPacketSocket*, rtc::ArrayView<const ReceivedPacket>)>
+      received_batch;
+  SocketAddress address;
+  const ReceivedPacket packets[] = {ReceivedPacket({}, address),
+                                    ReceivedPacket({}, address)};
+
+  EXPECT_CALL(received_packet, Call).Times(0);
+  EXPECT_CALL(received_batch, Call(&mock_socket, ::testing::SizeIs(2)));
+  EXPECT_CALL(received_batch, Call(&mock_socket, ::testing::SizeIs(1)));
+  mock_socket.RegisterReceivedPacketCallback(received_packet.AsStdFunction());
+  mock_socket.RegisterReceivedPacketBatchCallback(
+      received_batch.AsStdFunction());
+  mock_socket.NotifyPacketsReceived(packets);
+  mock_socket.NotifyPacketReceived(packets[0]);
+}
+
 }  // namespace
 }  // namespace rtc
@@ -10,6 +10,9 @@
 
 #include "rtc_base/async_udp_socket.h"
 
+#include <algorithm>
+#include <utility>
+
 #include "absl/types/optional.h"
 #include "api/units/time_delta.h"
 #include "rtc_base/checks.h"
@@ -39,7 +42,15 @@ AsyncUDPSocket* AsyncUDPSocket::Create(SocketFactory* factory,
   return Create(socket, bind_address);
 }
 
-AsyncUDPSocket::AsyncUDPSocket(Socket* socket) : socket_(socket) {
+AsyncUDPSocket::AsyncUDPSocket(Socket* socket)
+    : socket_(socket),
+      use_receive_buffer_pool_(socket_->ReceivesIntoPayloadCapacity()),
+      send_batch_(kMaxSendBatchSize,
+                  [this] {
+                    RTC_DCHECK_RUN_ON(&send_sequence_checker_);
+                    FlushSendBatchOrDeferError();
+                  }),
+      syscalls_saved_(/*bucket_milliseconds=*/500, /*bucket_count=*/10) {
   sequence_checker_.Detach();
   // The socket should start out readable but not writable.
   socket_->SignalReadEvent.connect(this, &AsyncUDPSocket::OnReadEvent);
@@ -57,6 +68,8 @@ SocketAddress AsyncUDPSocket::GetRemoteAddress() const {
 int AsyncUDPSocket::Send(const void* pv,
                          size_t cb,
                          const rtc::PacketOptions& options) {
+  RTC_DCHECK_RUN_ON(&send_sequence_checker_);
+  FlushSendBatchOrDeferError();
   rtc::SentPacket sent_packet(options.packet_id, rtc::TimeMillis(),
                               options.info_signaled_after_sent);
   CopySocketInformationToPacketInfo(cb, *this, false, &sent_packet.info);
@@ -69,6 +82,14 @@ int AsyncUDPSocket::SendTo(const void* pv,
                            size_t cb,
                            const SocketAddress& addr,
                            const rtc::PacketOptions& options) {
+  RTC_DCHECK_RUN_ON(&send_sequence_checker_);
+  if (options.batchable) {
+    return AddToSendBatch(pv, cb, addr, options);
+  }
+  // Keep packets in order. This packet may belong to another flow, e.g. STUN
+  // or RTCP, so it is sent even if the socket did not take the held back
+  // packets.
+  FlushSendBatchOrDeferError();
   rtc::SentPacket sent_packet(options.packet_id, rtc::TimeMillis(),
                               options.info_signaled_after_sent);
   CopySocketInformationToPacketInfo(cb, *this, true, &sent_packet.info);
@@ -77,6 +98,111 @@ int AsyncUDPSocket::SendTo(const void* pv,
   return ret;
 }
 
+int AsyncUDPSocket::AddToSendBatch(const void* pv,
+                                   size_t cb,
+                                   const SocketAddress& addr,
+                                   const rtc::PacketOptions& options) {
+  if (!send_batch_.empty() && send_batch_address_ != addr &&
+      !FlushSendBatch()) {
+    return -1;
+  }
+  if (!TakeDeferredSendError()) {
+    return -1;
+  }
+  const bool first_in_batch = send_batch_.empty();
+  PendingPacket* pending = send_batch_.Add();
+  if (!pending) {
+    rtc::PacketOptions unbatched_options = options;
+    unbatched_options.batchable = false;
+    return SendTo(pv, cb, addr, unbatched_options);
+  }
+  if (first_in_batch) {
+    send_batch_address_ = addr;
+  }
+  pending->data.SetData(static_cast<const uint8_t*>(pv), cb);
+  pending->sent_packet =
+      rtc::SentPacket(options.packet_id, /*send_time_ms=*/-1,
+                      options.info_signaled_after_sent);
+  CopySocketInformationToPacketInfo(cb, *this, true,
+                                    &pending->sent_packet.info);
+
+  if ((options.last_packet_in_batch || send_batch_.full()) &&
+      !FlushSendBatch()) {
+    return -1;
+  }
+  return static_cast<int>(cb);
+}
+
+bool AsyncUDPSocket::FlushSendBatch() {
+  if (send_batch_.empty()) {
+    return true;
+  }
+  rtc::ArrayView<PendingPacket> batch = send_batch_.entries();
+  send_batch_views_.clear();
+  for (const PendingPacket& pending : batch) {
+    send_batch_views_.push_back(pending.data);
+  }
+  const size_t sent = static_cast<size_t>(std::max(
+      socket_->SendToBatch(send_batch_views_, send_batch_address_), 0));
+  const bool sent_all = sent == batch.size();
+  if (!sent_all) {
+    RTC_LOG(LS_WARNING) << "AsyncUDPSocket sent " << sent << " of "
+                        << batch.size()
+                        << " batched packets, error: " << socket_->GetError();
+    send_batch_stats_.dropped_packets += batch.size() - sent;
+  }
+  send_batch_stats_.batched_packets += sent;
+  ++send_batch_stats_.batches;
+  if (socket_->SendsBatchesInOneCall() && sent > 1) {
+    syscalls_saved_.AddSamples(sent - 1);
+  }
+
+  // Only the packets that the socket took are reported as sent, so that
+  // bandwidth estimation does not count the dropped ones. The batch is ended
+  // before signaling, as handlers may send and thereby start a new one. A
+  // flush from such a send gets an empty `sent_packets_` and allocates.
+  std::vector<rtc::SentPacket> sent_packets = std::move(sent_packets_);
+  sent_packets.clear();
+  const int64_t send_time_ms = rtc::TimeMillis();
+  for (size_t i = 0; i < sent; ++i) {
+    sent_packets.push_back(batch[i].sent_packet);
+    sent_packets.back().send_time_ms = send_time_ms;
+  }
+  send_batch_.Clear();
+  for (const rtc::SentPacket& sent_packet : sent_packets) {
+    SignalSentPacket(this, sent_packet);
+  }
+  sent_packets_ = std::move(sent_packets);
+  return sent_all;
+}
+
+void AsyncUDPSocket::FlushSendBatchOrDeferError() {
+  if (!FlushSendBatch()) {
+    deferred_send_error_ = socket_->GetError();
+  }
+}
+
+bool AsyncUDPSocket::TakeDeferredSendError() {
+  if (!deferred_send_error_) {
+    return true;
+  }
+  socket_->SetError(*deferred_send_error_);
+  deferred_send_error_ = absl::nullopt;
+  return false;
+}
+
+AsyncUDPSocket::SendBatchStats AsyncUDPSocket::GetSendBatchStats() const {
+  RTC_DCHECK_RUN_ON(&send_sequence_checker_);
+  SendBatchStats stats = send_batch_stats_;
+  stats.syscalls_saved_per_second = syscalls_saved_.ComputeRate();
+  return stats;
+}
+
+ReceiveBufferPool::Stats AsyncUDPSocket::GetReceiveBufferStats() const {
+  RTC_DCHECK_RUN_ON(&sequence_checker_);
+  return receive_buffer_pool_.stats();
+}
+
 int AsyncUDPSocket::Close() {
   return socket_->Close();
 }
@@ -101,12 +227,49 @@ void AsyncUDPSocket::SetError(int error) {
   return socket_->SetError(error);
 }
 
+void AsyncUDPSocket::SetMaxReceiveBatchSize(size_t max_batch_size) {
+  RTC_DCHECK_RUN_ON(&sequence_checker_);
+  RTC_DCHECK_GE(max_batch_size, 1);
+  batch_buffers_.resize(max_batch_size > 1 ? max_batch_size : 0);
+  batch_receive_buffers_.reserve(batch_buffers_.size());
+  batch_packets_.reserve(batch_buffers_.size());
+}
+
+webrtc::Timestamp AsyncUDPSocket::ArrivalTime(
+    absl::optional<webrtc::Timestamp> socket_arrival_time) {
+  if (!socket_arrival_time) {
+    // Timestamp from socket is not available.
+    return webrtc::Timestamp::Micros(rtc::TimeMicros());
+  }
+  if (!socket_time_offset_) {
+    // Estimate timestamp offset from first packet arrival time.
+    socket_time_offset_ =
+        webrtc::Timestamp::Micros(rtc::TimeMicros()) - *socket_arrival_time;
+  }
+  return *socket_arrival_time + *socket_time_offset_;
+}
+
 void AsyncUDPSocket::OnReadEvent(Socket* socket) {
   RTC_DCHECK(socket_.get() == socket);
   RTC_DCHECK_RUN_ON(&sequence_checker_);
 
-  Socket::ReceiveBuffer receive_buffer(buffer_);
+  if (!batch_buffers_.empty()) {
+    ReadBatch();
+    return;
+  }
+
+  // Sockets that cannot read into the capacity of a pooled buffer would grow
+  // it to 64 KiB, so those read into `buffer_` and receivers copy what they
+  // keep.
+  Buffer buffer =
+      use_receive_buffer_pool_ ? receive_buffer_pool_.Acquire() : Buffer();
+  Buffer& read_buffer = use_receive_buffer_pool_ ? buffer : buffer_;
+  Socket::ReceiveBuffer receive_buffer(read_buffer);
+  receive_buffer.use_payload_capacity = use_receive_buffer_pool_;
   int len = socket_->RecvFrom(receive_buffer);
+  if (len <= 0) {
+    receive_buffer_pool_.Release(std::move(buffer));
+  }
   if (len < 0) {
     // An error here typically means we got an ICMP error in response to our
     // send datagram, indicating the remote address was unreachable.
@@ -122,20 +285,56 @@ void AsyncUDPSocket::OnReadEvent(Socket* socket) {
     return;
   }
 
-  if (!receive_buffer.arrival_time) {
-    // Timestamp from socket is not available.
-    receive_buffer.arrival_time = webrtc::Timestamp::Micros(rtc::TimeMicros());
-  } else {
-    if (!socket_time_offset_) {
-      // Estimate timestamp offset from first packet arrival time.
-      socket_time_offset_ = webrtc::Timestamp::Micros(rtc::TimeMicros()) -
-                            *receive_buffer.arrival_time;
+  receive_buffer.arrival_time = ArrivalTime(receive_buffer.arrival_time);
+  ReceivedPacket packet(receive_buffer.payload, receive_buffer.source_address,
+                        receive_buffer.arrival_time, receive_buffer.ecn);
+  if (use_receive_buffer_pool_) {
+    // Lets the receiver keep the payload without copying it. A taken buffer
+    // is not returned to the pool.
+    packet.SetTakeableBuffer(&buffer);
+  }
+  NotifyPacketReceived(packet);
+  receive_buffer_pool_.Release(std::move(buffer));
+}
+
+void AsyncUDPSocket::ReadBatch() {
+  batch_receive_buffers_.clear();
+  for (rtc::Buffer& buffer : batch_buffers_) {
+    if (use_receive_buffer_pool_ && buffer.capacity() == 0) {
+      // New slot, or a receiver took over the slot's last buffer.
+      buffer = receive_buffer_pool_.Acquire();
     }
-    *receive_buffer.arrival_time += *socket_time_offset_;
+    batch_receive_buffers_.emplace_back(buffer);
+    batch_receive_buffers_.back().use_payload_capacity =
+        use_receive_buffer_pool_;
+  }
+  int count = socket_->RecvFromBatch(batch_receive_buffers_);
+  if (count < 0) {
+    // See OnReadEvent for why errors are only logged.
+    SocketAddress local_addr = socket_->GetLocalAddress();
+    RTC_LOG(LS_INFO) << "AsyncUDPSocket[" << local_addr.ToSensitiveString()
+                     << "] batched receive failed with error "
+                     << socket_->GetError();
+    return;
+  }
+
+  batch_packets_.clear();
+  for (int i = 0; i < count; ++i) {
+    Socket::ReceiveBuffer& receive_buffer = batch_receive_buffers_[i];
+    if (receive_buffer.payload.empty()) {
+      continue;
+    }
+    receive_buffer.arrival_time = ArrivalTime(receive_buffer.arrival_time);
+    batch_packets_.emplace_back(
+        receive_buffer.payload, receive_buffer.source_address,
+        receive_buffer.arrival_time, receive_buffer.ecn);
+    if (use_receive_buffer_pool_) {
+      batch_packets_.back().SetTakeableBuffer(&batch_buffers_[i]);
+    }
+  }
+  if (!batch_packets_.empty()) {
+    NotifyPacketsReceived(batch_packets_);
   }
-  NotifyPacketReceived(
-      ReceivedPacket(receive_buffer.payload, receive_buffer.source_address,
-                     receive_buffer.arrival_time, receive_buffer.ecn));
 }
 
 void AsyncUDPSocket::OnWriteEvent(Socket* socket) {
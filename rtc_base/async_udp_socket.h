@@ -15,11 +15,19 @@
 
 #include <cstdint>
 #include <memory>
+#include <vector>
 
 #include "absl/types/optional.h"
+#include "api/array_view.h"
 #include "api/sequence_checker.h"
 #include "api/units/time_delta.h"
 #include "rtc_base/async_packet_socket.h"
+#include "rtc_base/buffer.h"
+#include "rtc_base/network/received_packet.h"
+#include "rtc_base/network/sent_packet.h"
+#include "rtc_base/rate_tracker.h"
+#include "rtc_base/receive_buffer_pool.h"
+#include "rtc_base/send_batch.h"
 #include "rtc_base/socket.h"
 #include "rtc_base/socket_address.h"
 #include "rtc_base/socket_factory.h"
@@ -30,8 +38,30 @@ namespace rtc {
 
 // Provides the ability to receive packets asynchronously.  Sends are not
 // buffered since it is acceptable to drop packets under high load.
+// Packets sent with PacketOptions::batchable are held back until a packet with
+// `last_packet_in_batch` is sent, the destination changes or the current task
+// ends, and are then handed to the socket with one Socket::SendToBatch call.
+// If the socket does not take the whole batch, the batchable send that flushed
+// it fails with the socket's error. When the batch was flushed at the end of
+// the task or by a send that is not batchable, the next batchable send fails
+// instead, so that the caller still sees the error and waits for
+// SignalReadyToSend. Sends that are not batchable, e.g. STUN or RTCP, are
+// always attempted.
 class AsyncUDPSocket : public AsyncPacketSocket {
  public:
+  struct SendBatchStats {
+    // Packets sent through Socket::SendToBatch.
+    int64_t batched_packets = 0;
+    // Batched packets that Socket::SendToBatch did not send.
+    int64_t dropped_packets = 0;
+    // Calls to Socket::SendToBatch.
+    int64_t batches = 0;
+    // Send calls avoided by batching, per second over the last few seconds.
+    // Zero for sockets that do not send a batch with one call, see
+    // Socket::SendsBatchesInOneCall().
+    double syscalls_saved_per_second = 0;
+  };
+
   // Binds `socket` and creates AsyncUDPSocket for it. Takes ownership
   // of `socket`. Returns null if bind() fails (`socket` is destroyed
   // in that case).
@@ -61,17 +91,87 @@ class AsyncUDPSocket : public AsyncPacketSocket {
   int GetError() const override;
   void SetError(int error) override;
 
+  // Drains up to `max_batch_size` datagrams per read event using
+  // Socket::RecvFromBatch and delivers them through NotifyPacketsReceived.
+  // Each batch slot holds its own receive buffer, which receivers may take
+  // over like the buffer of a single datagram. A value of 1 (the default)
+  // reads one datagram per event.
+  // Slots keep their buffer between reads, so a socket holds on to up to
+  // `max_batch_size` pooled buffers of 2 KiB. PhysicalSocket also keeps up to
+  // PhysicalSocket::kMaxRecvSpillSize (1 MiB) for datagrams that do not fit in
+  // them. Without the pool, slots grow to the largest datagram they received.
+  void SetMaxReceiveBatchSize(size_t max_batch_size);
+
+  // Must be called on the sending thread.
+  SendBatchStats GetSendBatchStats() const;
+
+  // Allocation counts for the buffers that datagrams are received into.
+  // Receivers take over buffers of packets they keep, so in steady state one
+  // buffer is allocated per kept packet and none per dropped or consumed one.
+  // Batch slots keep their buffer between reads and only acquire a new one
+  // once a receiver took it. The pool is only used with sockets whose
+  // Socket::ReceivesIntoPayloadCapacity() returns true.
+  // Must be called on the receiving thread.
+  ReceiveBufferPool::Stats GetReceiveBufferStats() const;
+
  private:
+  // Upper bound on the number of packets held back for one batch.
+  static constexpr size_t kMaxSendBatchSize = 64;
+
+  int AddToSendBatch(const void* pv,
+                     size_t cb,
+                     const SocketAddress& addr,
+                     const rtc::PacketOptions& options);
+  // Returns false, with the socket's error set, if not all held back packets
+  // were sent.
+  bool FlushSendBatch();
+  // Flushes the batch and keeps a failure for the next batchable send.
+  void FlushSendBatchOrDeferError();
+  // Returns false, and sets the socket's error, if the flush at the end of the
+  // last task failed and has not been reported yet.
+  bool TakeDeferredSendError();
+
   // Called when the underlying socket is ready to be read from.
   void OnReadEvent(Socket* socket);
+  void ReadBatch();
+  // Translates a socket timestamp to the rtc::TimeMicros() clock.
+  webrtc::Timestamp ArrivalTime(
+      absl::optional<webrtc::Timestamp> socket_arrival_time);
   // Called when the underlying socket is ready to send.
   void OnWriteEvent(Socket* socket);
 
   RTC_NO_UNIQUE_ADDRESS webrtc::SequenceChecker sequence_checker_;
   std::unique_ptr<Socket> socket_;
+  const bool use_receive_buffer_pool_;
+  ReceiveBufferPool receive_buffer_pool_;
+  // Single datagrams are read into this when the pool is not used.
   rtc::Buffer buffer_ RTC_GUARDED_BY(sequence_checker_);
+  // Storage for batched reads, reused between read events.
+  std::vector<rtc::Buffer> batch_buffers_ RTC_GUARDED_BY(sequence_checker_);
+  std::vector<Socket::ReceiveBuffer> batch_receive_buffers_
+      RTC_GUARDED_BY(sequence_checker_);
+  std::vector<ReceivedPacket> batch_packets_ RTC_GUARDED_BY(sequence_checker_);
   absl::optional<webrtc::TimeDelta> socket_time_offset_
       RTC_GUARDED_BY(sequence_checker_);
+
+  RTC_NO_UNIQUE_ADDRESS webrtc::SequenceChecker send_sequence_checker_{
+      webrtc::SequenceChecker::kDetached};
+  // A packet held back for the next Socket::SendToBatch call.
+  struct PendingPacket {
+    rtc::Buffer data;
+    rtc::SentPacket sent_packet;
+  };
+  SendBatch<PendingPacket> send_batch_ RTC_GUARDED_BY(send_sequence_checker_);
+  std::vector<rtc::ArrayView<const uint8_t>> send_batch_views_
+      RTC_GUARDED_BY(send_sequence_checker_);
+  SocketAddress send_batch_address_ RTC_GUARDED_BY(send_sequence_checker_);
+  // Reused by FlushSendBatch() to signal the packets of a batch.
+  std::vector<rtc::SentPacket> sent_packets_
+      RTC_GUARDED_BY(send_sequence_checker_);
+  SendBatchStats send_batch_stats_ RTC_GUARDED_BY(send_sequence_checker_);
+  absl::optional<int> deferred_send_error_
+      RTC_GUARDED_BY(send_sequence_checker_);
+  RateTracker syscalls_saved_ RTC_GUARDED_BY(send_sequence_checker_);
 };
 
 }  // namespace rtc
@@ -10,21 +10,86 @@
 
 #include "rtc_base/async_udp_socket.h"
 
+#include <errno.h>
+
+#include <algorithm>
+#include <functional>
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
+#include "rtc_base/copy_on_write_buffer.h"
 #include "rtc_base/gunit.h"
-#include "rtc_base/physical_socket_server.h"
+#include "rtc_base/thread.h"
 #include "rtc_base/virtual_socket_server.h"
 
 namespace rtc {
+namespace {
+
+// Sends at most `batch_limit` packets of a batch, like a socket whose send
+// buffer fills up in the middle of a sendmmsg call.
+class PartialBatchSocket : public Socket {
+ public:
+  explicit PartialBatchSocket(int batch_limit) : batch_limit_(batch_limit) {}
+
+  SocketAddress GetLocalAddress() const override { return SocketAddress(); }
+  SocketAddress GetRemoteAddress() const override { return SocketAddress(); }
+  int Bind(const SocketAddress& addr) override { return 0; }
+  int Connect(const SocketAddress& addr) override { return 0; }
+  int Send(const void* pv, size_t cb) override { return static_cast<int>(cb); }
+  int SendTo(const void* pv, size_t cb, const SocketAddress& addr) override {
+    return static_cast<int>(cb);
+  }
+  int SendToBatch(rtc::ArrayView<const rtc::ArrayView<const uint8_t>> packets,
+                  const SocketAddress& addr) override {
+    int sent = std::min(static_cast<int>(packets.size()), batch_limit_);
+    if (sent < static_cast<int>(packets.size())) {
+      error_ = EWOULDBLOCK;
+    }
+    return sent > 0 ? sent : -1;
+  }
+  int Recv(void* pv, size_t cb, int64_t* timestamp) override { return -1; }
+  int RecvFrom(void* pv,
+               size_t cb,
+               SocketAddress* paddr,
+               int64_t* timestamp) override {
+    return -1;
+  }
+  int Listen(int backlog) override { return -1; }
+  Socket* Accept(SocketAddress* paddr) override { return nullptr; }
+  int Close() override { return 0; }
+  int GetError() const override { return error_; }
+  void SetError(int error) override { error_ = error; }
+  ConnState GetState() const override { return CS_CLOSED; }
+  int GetOption(Option opt, int* value) override { return -1; }
+  int SetOption(Option opt, int value) override { return -1; }
+
+ private:
+  const int batch_limit_;
+  int error_ = 0;
+};
+
+class SentPacketCallback : public sigslot::has_slots<> {
+ public:
+  explicit SentPacketCallback(std::function<void(const SentPacket&)> callback)
+      : callback_(std::move(callback)) {}
+
+  void OnSent(AsyncPacketSocket* socket, const SentPacket& sent_packet) {
+    callback_(sent_packet);
+  }
+
+ private:
+  std::function<void(const SentPacket&)> callback_;
+};
+
+}  // namespace
 
 class AsyncUdpSocketTest : public ::testing::Test, public sigslot::has_slots<> {
  public:
   AsyncUdpSocketTest()
-      : pss_(new rtc::PhysicalSocketServer),
-        vss_(new rtc::VirtualSocketServer(pss_.get())),
-        socket_(vss_->CreateSocket(SOCK_DGRAM)),
+      : vss_(new rtc::VirtualSocketServer()),
+        socket_(vss_->CreateSocket(AF_INET, SOCK_DGRAM)),
         udp_socket_(new AsyncUDPSocket(socket_)),
         ready_to_send_(false) {
     udp_socket_->SignalReadyToSend.connect(this,
@@ -34,7 +99,6 @@ class AsyncUdpSocketTest : public ::testing::Test, public sigslot::has_slots<> {
   void OnReadyToSend(rtc::AsyncPacketSocket* socket) { ready_to_send_ = true; }
 
  protected:
-  std::unique_ptr<PhysicalSocketServer> pss_;
   std::unique_ptr<VirtualSocketServer> vss_;
   Socket* socket_;
   std::unique_ptr<AsyncUDPSocket> udp_socket_;
@@ -47,4 +111,167 @@ TEST_F(AsyncUdpSocketTest, OnWriteEvent) {
   EXPECT_TRUE(ready_to_send_);
 }
 
+TEST(AsyncUdpSocketReceiveTest, DoesNotPoolBuffersForVirtualSockets) {
+  VirtualSocketServer vss;
+  AutoSocketServerThread thread(&vss);
+  std::unique_ptr<AsyncUDPSocket> receiver(
+      AsyncUDPSocket::Create(&vss, SocketAddress("1.1.1.1", 0)));
+  std::unique_ptr<AsyncUDPSocket> sender(
+      AsyncUDPSocket::Create(&vss, SocketAddress("2.2.2.2", 0)));
+  ASSERT_TRUE(receiver);
+  ASSERT_TRUE(sender);
+  CopyOnWriteBuffer kept;
+  receiver->RegisterReceivedPacketCallback(
+      [&](AsyncPacketSocket* socket, const ReceivedPacket& packet) {
+        kept = ReceivedPacket(packet).TakePayload();
+      });
+
+  const char kData[] = "0123456789";
+  ASSERT_EQ(10, sender->SendTo(kData, 10, receiver->GetLocalAddress(),
+                               PacketOptions()));
+  EXPECT_EQ_WAIT(kept, CopyOnWriteBuffer(kData, 10), 1000);
+  // Virtual sockets read into a 64 KiB buffer, so the payload is copied out
+  // of it rather than handing out a pooled buffer.
+  EXPECT_LT(kept.capacity(), 1024u);
+  EXPECT_EQ(receiver->GetReceiveBufferStats().acquired, 0);
+}
+
+class AsyncUdpSocketBatchTest : public ::testing::Test,
+                                public sigslot::has_slots<> {
+ public:
+  void OnSentPacket(AsyncPacketSocket* socket, const SentPacket& sent_packet) {
+    sent_packet_ids_.push_back(sent_packet.packet_id);
+  }
+
+ protected:
+  AutoThread main_thread_;
+  std::vector<int64_t> sent_packet_ids_;
+};
+
+TEST_F(AsyncUdpSocketBatchTest, ReportsPacketsNotSentByShortBatchSend) {
+  AsyncUDPSocket socket(new PartialBatchSocket(/*batch_limit=*/2));
+  socket.SignalSentPacket.connect(
+      static_cast<AsyncUdpSocketBatchTest*>(this),
+      &AsyncUdpSocketBatchTest::OnSentPacket);
+
+  const char kData[] = "0123456789";
+  const SocketAddress kAddress("1.2.3.4", 5000);
+  PacketOptions options;
+  options.batchable = true;
+  for (int i = 0; i < 3; ++i) {
+    options.packet_id = i;
+    options.last_packet_in_batch = i == 2;
+    int result = socket.SendTo(kData, 10, kAddress, options);
+    if (i < 2) {
+      EXPECT_EQ(result, 10);
+    } else {
+      // The last packet flushed the batch, which the socket did not take.
+      EXPECT_EQ(result, -1);
+      EXPECT_EQ(socket.GetError(), EWOULDBLOCK);
+    }
+  }
+  EXPECT_EQ(sent_packet_ids_, (std::vector<int64_t>{0, 1}));
+  EXPECT_EQ(socket.GetSendBatchStats().batched_packets, 2);
+  EXPECT_EQ(socket.GetSendBatchStats().dropped_packets, 1);
+}
+
+TEST_F(AsyncUdpSocketBatchTest, ReportsShortBatchSendAtEndOfTaskOnNextSend) {
+  AsyncUDPSocket socket(new PartialBatchSocket(/*batch_limit=*/1));
+  socket.SignalSentPacket.connect(
+      static_cast<AsyncUdpSocketBatchTest*>(this),
+      &AsyncUdpSocketBatchTest::OnSentPacket);
+
+  const char kData[] = "0123456789";
+  const SocketAddress kAddress("1.2.3.4", 5000);
+  PacketOptions options;
+  options.batchable = true;
+  EXPECT_EQ(socket.SendTo(kData, 10, kAddress, options), 10);
+  EXPECT_EQ(socket.SendTo(kData, 10, kAddress, options), 10);
+  // Runs the flush posted at the end of the task.
+  main_thread_.ProcessMessages(0);
+  EXPECT_EQ(sent_packet_ids_.size(), 1u);
+
+  socket.SetError(0);
+  EXPECT_EQ(socket.SendTo(kData, 10, kAddress, options), -1);
+  EXPECT_EQ(socket.GetError(), EWOULDBLOCK);
+  // The error is only reported once.
+  EXPECT_EQ(socket.SendTo(kData, 10, kAddress, options), 10);
+}
+
+TEST_F(AsyncUdpSocketBatchTest, SendsUnbatchedPacketAfterShortBatchSend) {
+  AsyncUDPSocket socket(new PartialBatchSocket(/*batch_limit=*/1));
+  socket.SignalSentPacket.connect(
+      static_cast<AsyncUdpSocketBatchTest*>(this),
+      &AsyncUdpSocketBatchTest::OnSentPacket);
+
+  const char kData[] = "0123456789";
+  const SocketAddress kAddress("1.2.3.4", 5000);
+  PacketOptions options;
+  options.batchable = true;
+  options.packet_id = 0;
+  EXPECT_EQ(socket.SendTo(kData, 10, kAddress, options), 10);
+  options.packet_id = 1;
+  EXPECT_EQ(socket.SendTo(kData, 10, kAddress, options), 10);
+
+  // E.g. STUN or RTCP. Flushes the batch first, but is sent although the
+  // socket did not take all of it.
+  PacketOptions unbatched_options;
+  unbatched_options.packet_id = 2;
+  EXPECT_EQ(socket.SendTo(kData, 10, kAddress, unbatched_options), 10);
+  EXPECT_EQ(sent_packet_ids_, (std::vector<int64_t>{0, 2}));
+
+  // The next batchable send reports the error.
+  socket.SetError(0);
+  EXPECT_EQ(socket.SendTo(kData, 10, kAddress, options), -1);
+  EXPECT_EQ(socket.GetError(), EWOULDBLOCK);
+}
+
+TEST_F(AsyncUdpSocketBatchTest, SendsFromSentPacketHandlerStartNewBatch) {
+  AsyncUDPSocket socket(new PartialBatchSocket(/*batch_limit=*/64));
+  const char kData[] = "0123456789";
+  const SocketAddress kAddress("1.2.3.4", 5000);
+  std::vector<int64_t> sent_packet_ids;
+  SentPacketCallback callback([&](const SentPacket& sent_packet) {
+    sent_packet_ids.push_back(sent_packet.packet_id);
+    if (sent_packet.packet_id == 0) {
+      // Sends two packets into the next batch while the first one is being
+      // reported.
+      PacketOptions options;
+      options.batchable = true;
+      for (int64_t id : {10, 11}) {
+        options.packet_id = id;
+        EXPECT_EQ(socket.SendTo(kData, 10, kAddress, options), 10);
+      }
+    }
+  });
+  socket.SignalSentPacket.connect(&callback, &SentPacketCallback::OnSent);
+
+  PacketOptions options;
+  options.batchable = true;
+  for (int i = 0; i < 3; ++i) {
+    options.packet_id = i;
+    options.last_packet_in_batch = i == 2;
+    EXPECT_EQ(socket.SendTo(kData, 10, kAddress, options), 10);
+  }
+  EXPECT_EQ(sent_packet_ids, (std::vector<int64_t>{0, 1, 2}));
+  main_thread_.ProcessMessages(0);
+  EXPECT_EQ(sent_packet_ids, (std::vector<int64_t>{0, 1, 2, 10, 11}));
+}
+
+TEST_F(AsyncUdpSocketBatchTest, DoesNotCountSavedCallsForPerPacketSends) {
+  // PartialBatchSocket sends with the default Socket::SendToBatch contract,
+  // which does not promise a single call.
+  AsyncUDPSocket socket(new PartialBatchSocket(/*batch_limit=*/64));
+  const char kData[] = "0123456789";
+  const SocketAddress kAddress("1.2.3.4", 5000);
+  PacketOptions options;
+  options.batchable = true;
+  for (int i = 0; i < 3; ++i) {
+    options.last_packet_in_batch = i == 2;
+    EXPECT_EQ(socket.SendTo(kData, 10, kAddress, options), 10);
+  }
+  EXPECT_EQ(socket.GetSendBatchStats().batched_packets, 3);
+  EXPECT_EQ(socket.GetSendBatchStats().syscalls_saved_per_second, 0);
+}
+
 }  // namespace rtc
@@ -41,6 +41,9 @@ class RTC_EXPORT CopyOnWriteBuffer {
   // Construct a buffer from a string, convenient for unittests.
   explicit CopyOnWriteBuffer(absl::string_view s);
 
+  // Take ownership of the memory of `buffer`, without copying its contents.
+  explicit CopyOnWriteBuffer(Buffer&& buffer);
+
   // Construct a buffer with the specified number of uninitialized bytes.
   explicit CopyOnWriteBuffer(size_t size);
   CopyOnWriteBuffer(size_t size, size_t capacity);
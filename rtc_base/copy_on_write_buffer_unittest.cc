@@ -79,6 +79,18 @@ TEST(CopyOnWriteBufferTest, TestMoveConstruct) {
   EXPECT_EQ(buf2.data(), buf1_data);
 }
 
+TEST(CopyOnWriteBufferTest, TakesOverBufferWithoutCopying) {
+  Buffer buffer(kTestData, 3, 10);
+  const uint8_t* buffer_data = buffer.data();
+
+  CopyOnWriteBuffer buf(std::move(buffer));
+  EXPECT_EQ(buf.size(), 3u);
+  EXPECT_EQ(buf.capacity(), 10u);
+  EXPECT_EQ(buf.cdata(), buffer_data);
+  // The new buffer is not shared, so writing to it does not copy.
+  EXPECT_EQ(buf.MutableData(), buffer_data);
+}
+
 TEST(CopyOnWriteBufferTest, TestMoveAssign) {
   CopyOnWriteBuffer buf1(kTestData, 3, 10);
   size_t buf1_size = buf1.size();
@@ -13,6 +13,7 @@
 #include <utility>
 
 #include "absl/types/optional.h"
+#include "rtc_base/checks.h"
 #include "rtc_base/socket_address.h"
 
 namespace rtc {
@@ -30,8 +31,33 @@ ReceivedPacket::ReceivedPacket(rtc::ArrayView<const uint8_t> payload,
 
 ReceivedPacket ReceivedPacket::CopyAndSet(
     DecryptionInfo decryption_info) const {
-  return ReceivedPacket(payload_, source_address_, arrival_time_, ecn_,
+  ReceivedPacket packet(payload_, source_address_, arrival_time_, ecn_,
                         decryption_info);
+  packet.takeable_buffer_ = takeable_buffer_;
+  return packet;
+}
+
+CopyOnWriteBuffer ReceivedPacket::TakePayload() {
+  RTC_DCHECK(!payload_taken_) << "Payload was already taken.";
+  // The takeable buffer holds the payload until it is taken, so an empty one
+  // means that a copy of this packet already took it.
+  RTC_DCHECK(takeable_buffer_ == nullptr || payload_.empty() ||
+             !takeable_buffer_->empty())
+      << "Payload was already taken from a copy of this packet.";
+  payload_taken_ = true;
+  if (takeable_buffer_ == nullptr || payload_.empty() ||
+      takeable_buffer_->empty() ||
+      payload_.data() < takeable_buffer_->data() ||
+      payload_.data() + payload_.size() >
+          takeable_buffer_->data() + takeable_buffer_->size()) {
+    return CopyOnWriteBuffer(payload_.data(), payload_.size());
+  }
+  size_t offset = payload_.data() - takeable_buffer_->data();
+  CopyOnWriteBuffer buffer(std::move(*takeable_buffer_));
+  // Leave the sender with a valid, empty buffer.
+  *takeable_buffer_ = Buffer();
+  takeable_buffer_ = nullptr;
+  return buffer.Slice(offset, payload_.size());
 }
 
 // static
@@ -15,6 +15,8 @@
 #include "absl/types/optional.h"
 #include "api/array_view.h"
 #include "api/units/timestamp.h"
+#include "rtc_base/buffer.h"
+#include "rtc_base/copy_on_write_buffer.h"
 #include "rtc_base/network/ecn_marking.h"
 #include "rtc_base/socket_address.h"
 #include "rtc_base/system/rtc_export.h"
@@ -44,6 +46,19 @@ class RTC_EXPORT ReceivedPacket {
 
   ReceivedPacket CopyAndSet(DecryptionInfo decryption_info) const;
 
+  // Allows the receiver of this packet to take over `buffer`, which must hold
+  // the payload, instead of copying the payload. `buffer` must outlive this
+  // packet and its copies.
+  void SetTakeableBuffer(Buffer* buffer) { takeable_buffer_ = buffer; }
+
+  // Returns the payload in a buffer that the caller owns. If the sender set a
+  // takeable buffer, that buffer is moved into the result and the payload is
+  // not copied. Since the result then shares memory with payload(), only the
+  // final receiver of a packet should call this, and nobody should read
+  // payload() afterwards. May be called at most once for a packet and its
+  // copies; receivers that are handed a const packet take from a copy.
+  CopyOnWriteBuffer TakePayload();
+
   // Address/port of the packet sender.
   const SocketAddress& source_address() const { return source_address_; }
   rtc::ArrayView<const uint8_t> payload() const { return payload_; }
@@ -80,6 +95,8 @@ class RTC_EXPORT ReceivedPacket {
   const SocketAddress& source_address_;
   EcnMarking ecn_;
   DecryptionInfo decryption_info_;
+  Buffer* takeable_buffer_ = nullptr;
+  bool payload_taken_ = false;
 };
 
 }  // namespace rtc
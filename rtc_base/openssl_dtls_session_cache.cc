@@ -0,0 +1,113 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/openssl_dtls_session_cache.h"
+
+#include <openssl/rand.h>
+#include <openssl/ssl.h>
+
+#include "absl/strings/string_view.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/openssl.h"
+
+namespace rtc {
+namespace {
+
+// Enough for the peers of a busy media server, while bounding the memory held
+// by sessions that are never resumed.
+constexpr size_t kMaxGlobalSessions = 1024;
+
+constexpr char kSessionIdContext[] = "WebRTC DTLS";
+
+}  // namespace
+
+OpenSSLDtlsSessionCache::OpenSSLDtlsSessionCache(size_t max_sessions)
+    : max_sessions_(max_sessions) {
+  RTC_DCHECK_GT(max_sessions_, 0);
+  RTC_CHECK_EQ(RAND_bytes(ticket_keys_, sizeof(ticket_keys_)), 1);
+}
+
+OpenSSLDtlsSessionCache::~OpenSSLDtlsSessionCache() {
+  for (const auto& it : sessions_) {
+    SSL_SESSION_free(it.second.session);
+  }
+}
+
+// static
+OpenSSLDtlsSessionCache* OpenSSLDtlsSessionCache::Get() {
+  static OpenSSLDtlsSessionCache* const cache =
+      new OpenSSLDtlsSessionCache(kMaxGlobalSessions);
+  return cache;
+}
+
+bool OpenSSLDtlsSessionCache::ConfigureContext(SSL_CTX* ctx) const {
+  // Servers that verify the peer certificate refuse to resume sessions
+  // without a session id context.
+  if (SSL_CTX_set_session_id_context(
+          ctx, reinterpret_cast<const uint8_t*>(kSessionIdContext),
+          sizeof(kSessionIdContext) - 1) != 1) {
+    return false;
+  }
+  // The SSL library only reads the keys.
+  return SSL_CTX_set_tlsext_ticket_keys(
+             ctx, const_cast<uint8_t*>(ticket_keys_), sizeof(ticket_keys_)) ==
+         1;
+}
+
+SSL_SESSION* OpenSSLDtlsSessionCache::LookupSession(absl::string_view key) {
+  webrtc::MutexLock lock(&mutex_);
+  auto it = sessions_.find(key);
+  if (it == sessions_.end()) {
+    return nullptr;
+  }
+  lru_.splice(lru_.begin(), lru_, it->second.lru_position);
+  SSL_SESSION_up_ref(it->second.session);
+  return it->second.session;
+}
+
+void OpenSSLDtlsSessionCache::AddSession(absl::string_view key,
+                                         SSL_SESSION* session) {
+  RTC_DCHECK(session);
+  SSL_SESSION_up_ref(session);
+  webrtc::MutexLock lock(&mutex_);
+  auto it = sessions_.find(key);
+  if (it != sessions_.end()) {
+    SSL_SESSION_free(it->second.session);
+    it->second.session = session;
+    lru_.splice(lru_.begin(), lru_, it->second.lru_position);
+    return;
+  }
+  if (sessions_.size() == max_sessions_) {
+    auto oldest = sessions_.find(lru_.back());
+    SSL_SESSION_free(oldest->second.session);
+    sessions_.erase(oldest);
+    lru_.pop_back();
+  }
+  lru_.emplace_front(key);
+  sessions_.emplace(lru_.front(), Entry{session, lru_.begin()});
+}
+
+void OpenSSLDtlsSessionCache::RemoveSession(absl::string_view key) {
+  webrtc::MutexLock lock(&mutex_);
+  auto it = sessions_.find(key);
+  if (it == sessions_.end()) {
+    return;
+  }
+  SSL_SESSION_free(it->second.session);
+  lru_.erase(it->second.lru_position);
+  sessions_.erase(it);
+}
+
+size_t OpenSSLDtlsSessionCache::size() const {
+  webrtc::MutexLock lock(&mutex_);
+  return sessions_.size();
+}
+
+}  // namespace rtc
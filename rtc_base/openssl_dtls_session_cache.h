@@ -0,0 +1,94 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_OPENSSL_DTLS_SESSION_CACHE_H_
+#define RTC_BASE_OPENSSL_DTLS_SESSION_CACHE_H_
+
+#include <openssl/ossl_typ.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <list>
+#include <map>
+#include <string>
+
+#include "absl/strings/string_view.h"
+#include "rtc_base/string_utils.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/thread_annotations.h"
+
+#ifndef OPENSSL_IS_BORINGSSL
+typedef struct ssl_session_st SSL_SESSION;
+#endif
+
+namespace rtc {
+
+// The OpenSSLDtlsSessionCache lets OpenSSLStreamAdapters in DTLS mode resume
+// earlier sessions with the same peer instead of running a full handshake.
+// Clients look sessions up by a key naming both endpoints' certificates.
+// Servers accept the session tickets of any adapter configured with the same
+// cache, since they share the ticket encryption keys.
+//
+// Resuming a session skips the certificate exchange, so the adapter must still
+// check the peer certificate stored in the session against the signaled
+// digest.
+//
+// This class is thread safe.
+class OpenSSLDtlsSessionCache final {
+ public:
+  // Keeps at most `max_sessions`, evicting the least recently used.
+  explicit OpenSSLDtlsSessionCache(size_t max_sessions);
+  // Frees the cached SSL_SESSIONs.
+  ~OpenSSLDtlsSessionCache();
+
+  OpenSSLDtlsSessionCache(const OpenSSLDtlsSessionCache&) = delete;
+  OpenSSLDtlsSessionCache& operator=(const OpenSSLDtlsSessionCache&) = delete;
+
+  // The cache shared by all OpenSSLStreamAdapters in the process.
+  static OpenSSLDtlsSessionCache* Get();
+
+  // Makes `ctx` issue and accept session tickets encrypted with this cache's
+  // keys. Returns false on failure.
+  bool ConfigureContext(SSL_CTX* ctx) const;
+
+  // Looks up a session by key. The returned SSL_SESSION is up_refed and must
+  // be freed by the caller.
+  SSL_SESSION* LookupSession(absl::string_view key);
+  // Adds a session to the cache, and up_refs it. Any existing session with the
+  // same key is replaced.
+  void AddSession(absl::string_view key, SSL_SESSION* session);
+  void RemoveSession(absl::string_view key);
+
+  size_t size() const;
+
+ private:
+  struct Entry {
+    SSL_SESSION* session;
+    // Position in `lru_`.
+    std::list<std::string>::iterator lru_position;
+  };
+
+  const size_t max_sessions_;
+  // Key name, HMAC secret and AES key, in the layout the SSL library expects.
+#ifdef OPENSSL_IS_BORINGSSL
+  uint8_t ticket_keys_[48];
+#else
+  uint8_t ticket_keys_[80];
+#endif
+  mutable webrtc::Mutex mutex_;
+  std::map<std::string, Entry, rtc::AbslStringViewCmp> sessions_
+      RTC_GUARDED_BY(mutex_);
+  // Keys of `sessions_`, most recently used first.
+  std::list<std::string> lru_ RTC_GUARDED_BY(mutex_);
+};
+
+}  // namespace rtc
+
+#endif  // RTC_BASE_OPENSSL_DTLS_SESSION_CACHE_H_
@@ -0,0 +1,105 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/openssl_dtls_session_cache.h"
+
+#include <openssl/ssl.h>
+
+#include "rtc_base/gunit.h"
+#include "rtc_base/openssl.h"
+
+namespace {
+SSL_CTX* NewDtlsContext() {
+#ifdef OPENSSL_IS_BORINGSSL
+  return SSL_CTX_new(DTLS_with_buffers_method());
+#else
+  return SSL_CTX_new(DTLS_method());
+#endif
+}
+}  // namespace
+
+namespace rtc {
+
+TEST(OpenSSLDtlsSessionCache, InvalidLookupReturnsNullptr) {
+  OpenSSLDtlsSessionCache session_cache(4);
+  EXPECT_EQ(session_cache.LookupSession("Invalid"), nullptr);
+  EXPECT_EQ(session_cache.LookupSession(""), nullptr);
+}
+
+TEST(OpenSSLDtlsSessionCache, AddLookupAndRemove) {
+  SSL_CTX* ssl_ctx = NewDtlsContext();
+  OpenSSLDtlsSessionCache session_cache(4);
+  SSL_SESSION* session = SSL_SESSION_new(ssl_ctx);
+
+  session_cache.AddSession("key", session);
+  SSL_SESSION* found = session_cache.LookupSession("key");
+  EXPECT_EQ(found, session);
+  SSL_SESSION_free(found);
+
+  session_cache.RemoveSession("key");
+  EXPECT_EQ(session_cache.LookupSession("key"), nullptr);
+  EXPECT_EQ(session_cache.size(), 0u);
+
+  SSL_SESSION_free(session);
+  SSL_CTX_free(ssl_ctx);
+}
+
+TEST(OpenSSLDtlsSessionCache, AddReplacesSessionWithSameKey) {
+  SSL_CTX* ssl_ctx = NewDtlsContext();
+  OpenSSLDtlsSessionCache session_cache(4);
+  SSL_SESSION* first = SSL_SESSION_new(ssl_ctx);
+  SSL_SESSION* second = SSL_SESSION_new(ssl_ctx);
+
+  session_cache.AddSession("key", first);
+  session_cache.AddSession("key", second);
+  EXPECT_EQ(session_cache.size(), 1u);
+  SSL_SESSION* found = session_cache.LookupSession("key");
+  EXPECT_EQ(found, second);
+  SSL_SESSION_free(found);
+
+  SSL_SESSION_free(first);
+  SSL_SESSION_free(second);
+  SSL_CTX_free(ssl_ctx);
+}
+
+TEST(OpenSSLDtlsSessionCache, EvictsLeastRecentlyUsed) {
+  SSL_CTX* ssl_ctx = NewDtlsContext();
+  OpenSSLDtlsSessionCache session_cache(2);
+  SSL_SESSION* session = SSL_SESSION_new(ssl_ctx);
+
+  session_cache.AddSession("a", session);
+  session_cache.AddSession("b", session);
+  // Makes "b" the least recently used.
+  SSL_SESSION_free(session_cache.LookupSession("a"));
+  session_cache.AddSession("c", session);
+
+  EXPECT_EQ(session_cache.size(), 2u);
+  EXPECT_EQ(session_cache.LookupSession("b"), nullptr);
+  SSL_SESSION* found = session_cache.LookupSession("a");
+  EXPECT_EQ(found, session);
+  SSL_SESSION_free(found);
+  found = session_cache.LookupSession("c");
+  EXPECT_EQ(found, session);
+  SSL_SESSION_free(found);
+
+  SSL_SESSION_free(session);
+  SSL_CTX_free(ssl_ctx);
+}
+
+TEST(OpenSSLDtlsSessionCache, ConfiguresContext) {
+  SSL_CTX* ssl_ctx = NewDtlsContext();
+
+  OpenSSLDtlsSessionCache session_cache(4);
+  EXPECT_TRUE(session_cache.ConfigureContext(ssl_ctx));
+
+  SSL_CTX_free(ssl_ctx);
+}
+
+}  // namespace rtc
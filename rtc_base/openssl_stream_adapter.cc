@@ -35,6 +35,7 @@
 #include "rtc_base/openssl.h"
 #include "rtc_base/openssl_adapter.h"
 #include "rtc_base/openssl_digest.h"
+#include "rtc_base/openssl_dtls_session_cache.h"
 #ifdef OPENSSL_IS_BORINGSSL
 #include "rtc_base/boringssl_identity.h"
 #else
@@ -295,6 +296,10 @@ OpenSSLStreamAdapter::OpenSSLStreamAdapter(
           webrtc::field_trial::IsEnabled("WebRTC-PermuteTlsClientHello")),
 #endif
       ssl_mode_(SSL_MODE_TLS),
+      session_cache_(
+          webrtc::field_trial::IsEnabled("WebRTC-DtlsSessionResumption")
+              ? OpenSSLDtlsSessionCache::Get()
+              : nullptr),
       ssl_max_version_(SSL_PROTOCOL_TLS_12) {
   stream_->SetEventCallback(
       [this](int events, int err) { OnEvent(events, err); });
@@ -366,6 +371,7 @@ bool OpenSSLStreamAdapter::SetPeerCertificateDigest(
   }
 
   if (state_ == SSL_CONNECTED) {
+    MaybeCacheSession();
     // Post the event asynchronously to unwind the stack. The caller
     // of ContinueSSL may be the same object listening for these
     // events and may not be prepared for reentrancy.
@@ -523,6 +529,10 @@ bool OpenSSLStreamAdapter::IsTlsConnected() {
   return state_ == SSL_CONNECTED;
 }
 
+bool OpenSSLStreamAdapter::IsSessionResumed() const {
+  return state_ == SSL_CONNECTED && SSL_session_reused(ssl_);
+}
+
 int OpenSSLStreamAdapter::StartSSL() {
   // Don't allow StartSSL to be called twice.
   if (state_ != SSL_NONE) {
@@ -880,6 +890,8 @@ int OpenSSLStreamAdapter::BeginSSL() {
   SSL_set_mode(ssl_, SSL_MODE_ENABLE_PARTIAL_WRITE |
                          SSL_MODE_ACCEPT_MOVING_WRITE_BUFFER);
 
+  MaybeResumeSession();
+
   // Do the connect
   return ContinueSSL();
 }
@@ -898,11 +910,15 @@ int OpenSSLStreamAdapter::ContinueSSL() {
   switch (ssl_error) {
     case SSL_ERROR_NONE:
       RTC_DLOG(LS_VERBOSE) << " -- success";
+      if (SSL_session_reused(ssl_) && !OnSessionResumed()) {
+        return -1;
+      }
       // By this point, OpenSSL should have given us a certificate, or errored
       // out if one was missing.
       RTC_DCHECK(peer_cert_chain_ || !GetClientAuthEnabled());
 
       state_ = SSL_CONNECTED;
+      MaybeCacheSession();
       if (!WaitingToVerifyPeerCertificate()) {
         // We have everything we need to start the connection, so signal
         // SE_OPEN. If we need a client certificate fingerprint and don't have
@@ -1078,6 +1094,11 @@ SSL_CTX* OpenSSLStreamAdapter::SetupSSLContext() {
   SSL_CTX_set_permute_extensions(ctx, permute_extension_);
 #endif
 
+  if (session_cache_ && ssl_mode_ == SSL_MODE_DTLS &&
+      !session_cache_->ConfigureContext(ctx)) {
+    RTC_LOG(LS_WARNING) << "Failed to set session ticket keys.";
+  }
+
   return ctx;
 }
 
@@ -1114,6 +1135,88 @@ bool OpenSSLStreamAdapter::VerifyPeerCertificate() {
   return true;
 }
 
+std::string OpenSSLStreamAdapter::SessionCacheKey() const {
+  if (!identity_ || !HasPeerCertificateDigest()) {
+    return std::string();
+  }
+  unsigned char digest[EVP_MAX_MD_SIZE];
+  size_t digest_length;
+  if (!identity_->certificate().ComputeDigest(DIGEST_SHA_256, digest,
+                                              sizeof(digest), &digest_length)) {
+    return std::string();
+  }
+  return rtc::hex_encode(absl::string_view(
+             reinterpret_cast<const char*>(digest), digest_length)) +
+         " " + peer_certificate_digest_algorithm_ + " " +
+         rtc::hex_encode(absl::string_view(
+             reinterpret_cast<const char*>(
+                 peer_certificate_digest_value_.data()),
+             peer_certificate_digest_value_.size()));
+}
+
+void OpenSSLStreamAdapter::MaybeResumeSession() {
+  if (!session_cache_ || ssl_mode_ != SSL_MODE_DTLS || role_ != SSL_CLIENT) {
+    return;
+  }
+  const std::string key = SessionCacheKey();
+  if (key.empty()) {
+    return;
+  }
+  SSL_SESSION* session = session_cache_->LookupSession(key);
+  if (!session) {
+    return;
+  }
+  RTC_DLOG(LS_INFO) << "Offering to resume a cached DTLS session.";
+  SSL_set_session(ssl_, session);
+  SSL_SESSION_free(session);
+}
+
+void OpenSSLStreamAdapter::MaybeCacheSession() {
+  if (!session_cache_ || ssl_mode_ != SSL_MODE_DTLS || role_ != SSL_CLIENT ||
+      !peer_certificate_verified_) {
+    return;
+  }
+  const std::string key = SessionCacheKey();
+  SSL_SESSION* session = SSL_get_session(ssl_);
+  if (key.empty() || !session || !SSL_SESSION_is_resumable(session)) {
+    return;
+  }
+  session_cache_->AddSession(key, session);
+}
+
+bool OpenSSLStreamAdapter::OnSessionResumed() {
+  RTC_LOG(LS_INFO) << "Resumed DTLS session.";
+#ifdef OPENSSL_IS_BORINGSSL
+  const STACK_OF(CRYPTO_BUFFER)* chain = SSL_get0_peer_certificates(ssl_);
+  if (chain) {
+    std::vector<std::unique_ptr<SSLCertificate>> cert_chain;
+    for (CRYPTO_BUFFER* cert : chain) {
+      cert_chain.emplace_back(new BoringSSLCertificate(bssl::UpRef(cert)));
+    }
+    peer_cert_chain_.reset(new SSLCertChain(std::move(cert_chain)));
+  }
+#else
+  X509* cert = SSL_get_peer_certificate(ssl_);
+  if (cert) {
+    peer_cert_chain_.reset(
+        new SSLCertChain(std::make_unique<OpenSSLCertificate>(cert)));
+    X509_free(cert);
+  }
+#endif
+  if (!peer_cert_chain_) {
+    return !GetClientAuthEnabled();
+  }
+  // If the digest isn't known yet, verification happens when it is set, as
+  // after a full handshake.
+  if (HasPeerCertificateDigest() && !VerifyPeerCertificate()) {
+    if (session_cache_ && role_ == SSL_CLIENT) {
+      session_cache_->RemoveSession(SessionCacheKey());
+    }
+    return false;
+  }
+  return true;
+}
+
 std::unique_ptr<SSLCertChain> OpenSSLStreamAdapter::GetPeerSSLCertChain()
     const {
   return peer_cert_chain_ ? peer_cert_chain_->Clone() : nullptr;
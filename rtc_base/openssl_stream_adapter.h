@@ -62,6 +62,7 @@ namespace rtc {
 
 // Look in sslstreamadapter.h for documentation of the methods.
 
+class OpenSSLDtlsSessionCache;
 class SSLCertChain;
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -125,6 +126,7 @@ class OpenSSLStreamAdapter final : public SSLStreamAdapter,
   bool GetDtlsSrtpCryptoSuite(int* crypto_suite) override;
 
   bool IsTlsConnected() override;
+  bool IsSessionResumed() const override;
 
   // Capabilities interfaces.
   static bool IsBoringSsl();
@@ -183,6 +185,19 @@ class OpenSSLStreamAdapter final : public SSLStreamAdapter,
   // Verify the peer certificate matches the signaled digest.
   bool VerifyPeerCertificate();
 
+  // Key of the session with the current peer in `session_cache_`, or empty if
+  // either certificate is not known yet.
+  std::string SessionCacheKey() const;
+  // Offers a cached session with the current peer, if any. Client side only.
+  void MaybeResumeSession();
+  // Caches the established session once the peer has been verified. Client
+  // side only.
+  void MaybeCacheSession();
+  // Recovers and verifies the peer certificate of a resumed session, since
+  // the verification callback does not run when resuming. Returns false if
+  // the peer is not the expected one.
+  bool OnSessionResumed();
+
 #ifdef OPENSSL_IS_BORINGSSL
   // SSL certificate verification callback. See SSL_CTX_set_custom_verify.
   static enum ssl_verify_result_t SSLVerifyCallback(SSL* ssl,
@@ -244,6 +259,10 @@ class OpenSSLStreamAdapter final : public SSLStreamAdapter,
   // Do DTLS or not
   SSLMode ssl_mode_;
 
+  // Sessions to resume in DTLS mode, or null if session resumption is
+  // disabled. Enabled by the `WebRTC-DtlsSessionResumption` field trial.
+  OpenSSLDtlsSessionCache* const session_cache_;
+
   // Max. allowed protocol version
   SSLProtocolVersion ssl_max_version_;
 
@@ -9,6 +9,8 @@
  */
 #include "rtc_base/physical_socket_server.h"
 
+#include <algorithm>
+#include <array>
 #include <cstdint>
 #include <utility>
 
@@ -56,6 +58,12 @@
 
 #if defined(WEBRTC_LINUX)
 #include <linux/sockios.h>
+#include <netinet/udp.h>
+
+// UDP generic segmentation offload, see linux/udp.h. Available since 4.18.
+#if !defined(UDP_SEGMENT)
+#define UDP_SEGMENT 103
+#endif
 #endif
 
 #if defined(WEBRTC_WIN)
@@ -113,6 +121,9 @@ namespace {
 // RFC-3168, Section 5. ECN is the two least significant bits.
 static constexpr uint8_t kEcnMask = 0x03;
 
+// Largest datagram that RecvFrom(ReceiveBuffer&) and RecvFromBatch() read.
+static constexpr size_t kMaxDatagramSize = 64 * 1024;
+
 #if defined(WEBRTC_POSIX)
 
 rtc::EcnMarking EcnFromDs(uint8_t ds) {
@@ -134,6 +145,30 @@ rtc::EcnMarking EcnFromDs(uint8_t ds) {
   return rtc::EcnMarking::kNotEct;
 }
 
+// Reads the receive timestamp and ECN marking from the ancillary data of a
+// received message.
+void ParseControlMessages(msghdr* msg,
+                          int64_t* timestamp,
+                          rtc::EcnMarking* ecn) {
+  for (cmsghdr* cmsg = CMSG_FIRSTHDR(msg); cmsg;
+       cmsg = CMSG_NXTHDR(msg, cmsg)) {
+    if (ecn) {
+      if ((cmsg->cmsg_type == IPV6_TCLASS &&
+           cmsg->cmsg_level == IPPROTO_IPV6) ||
+          (cmsg->cmsg_type == IP_TOS && cmsg->cmsg_level == IPPROTO_IP)) {
+        *ecn = EcnFromDs(CMSG_DATA(cmsg)[0]);
+      }
+    }
+    if (cmsg->cmsg_level != SOL_SOCKET)
+      continue;
+    if (timestamp && cmsg->cmsg_type == SCM_TIMESTAMP) {
+      timeval* ts = reinterpret_cast<timeval*>(CMSG_DATA(cmsg));
+      *timestamp = rtc::kNumMicrosecsPerSec * static_cast<int64_t>(ts->tv_sec) +
+                   static_cast<int64_t>(ts->tv_usec);
+    }
+  }
+}
+
 #endif
 
 class ScopedSetTrue {
@@ -319,6 +354,10 @@ Socket::ConnState PhysicalSocket::GetState() const {
 }
 
 int PhysicalSocket::GetOption(Option opt, int* value) {
+  if (opt == OPT_UDP_GSO) {
+    *value = udp_gso_ ? 1 : 0;
+    return 0;
+  }
   int slevel;
   int sopt;
   if (TranslateOption(opt, &slevel, &sopt) == -1)
@@ -353,6 +392,16 @@ int PhysicalSocket::GetOption(Option opt, int* value) {
 }
 
 int PhysicalSocket::SetOption(Option opt, int value) {
+  if (opt == OPT_UDP_GSO) {
+#if defined(WEBRTC_LINUX) && !defined(WEBRTC_ANDROID)
+    if (udp_) {
+      udp_gso_ = value != 0;
+      return 0;
+    }
+#endif
+    RTC_LOG(LS_WARNING) << "Socket::OPT_UDP_GSO not supported.";
+    return -1;
+  }
   int slevel;
   int sopt;
   if (TranslateOption(opt, &slevel, &sopt) == -1)
@@ -436,9 +485,135 @@ int PhysicalSocket::SendTo(const void* buffer,
   return sent;
 }
 
+int PhysicalSocket::SendToBatch(
+    rtc::ArrayView<const rtc::ArrayView<const uint8_t>> packets,
+    const SocketAddress& addr) {
+#if defined(WEBRTC_LINUX) || defined(WEBRTC_ANDROID)
+  if (!udp_ || packets.size() <= 1) {
+    return Socket::SendToBatch(packets, addr);
+  }
+  sockaddr_storage saddr;
+  socklen_t saddr_len = addr.ToSockAddrStorage(&saddr);
+  int sent = 0;
+  while (sent < static_cast<int>(packets.size())) {
+    int result = DoSendBatch(packets.subview(sent), &saddr, saddr_len);
+    if (result <= 0) {
+      break;
+    }
+    sent += result;
+  }
+  UpdateLastError();
+  MaybeRemapSendError();
+  if (sent < static_cast<int>(packets.size()) && IsBlockingError(GetError())) {
+    EnableEvents(DE_WRITE);
+  }
+  return sent > 0 ? sent : -1;
+#else
+  return Socket::SendToBatch(packets, addr);
+#endif
+}
+
+bool PhysicalSocket::SendsBatchesInOneCall() const {
+#if defined(WEBRTC_LINUX) || defined(WEBRTC_ANDROID)
+  return udp_;
+#else
+  return false;
+#endif
+}
+
+#if defined(WEBRTC_LINUX) || defined(WEBRTC_ANDROID)
+int PhysicalSocket::DoSendBatch(
+    rtc::ArrayView<const rtc::ArrayView<const uint8_t>> packets,
+    sockaddr_storage* addr,
+    socklen_t addr_len) {
+  // The kernel rejects GSO sends of more than 64 segments or 64 KiB.
+  static constexpr size_t kMaxGsoSegments = 64;
+  static constexpr size_t kMaxGsoBytes = 65000;
+
+  std::array<mmsghdr, kMaxSendBatchSize> msgs;
+  std::array<iovec, kMaxSendBatchSize> iovs;
+  std::array<std::array<char, CMSG_SPACE(sizeof(uint16_t))>, kMaxSendBatchSize>
+      controls;
+  // Number of packets carried by each message.
+  std::array<int, kMaxSendBatchSize> packets_per_msg;
+
+  // With GSO, runs of packets of the same size (the last one may be shorter)
+  // are merged into one message that the kernel or NIC splits into separate
+  // datagrams. Otherwise every packet is a message of its own.
+  size_t num_msgs = 0;
+  size_t num_packets = 0;
+  while (num_packets < packets.size() && num_packets < kMaxSendBatchSize) {
+    const size_t first = num_packets;
+    const size_t segment_size = packets[first].size();
+    size_t total_size = segment_size;
+    iovs[num_packets] = {.iov_base = const_cast<uint8_t*>(packets[first].data()),
+                         .iov_len = segment_size};
+    ++num_packets;
+    while (udp_gso_ && segment_size > 0 && num_packets < packets.size() &&
+           num_packets < kMaxSendBatchSize &&
+           num_packets - first < kMaxGsoSegments &&
+           packets[num_packets - 1].size() == segment_size &&
+           packets[num_packets].size() <= segment_size &&
+           total_size + packets[num_packets].size() <= kMaxGsoBytes) {
+      total_size += packets[num_packets].size();
+      iovs[num_packets] = {
+          .iov_base = const_cast<uint8_t*>(packets[num_packets].data()),
+          .iov_len = packets[num_packets].size()};
+      ++num_packets;
+    }
+
+    mmsghdr& msg = msgs[num_msgs];
+    msg = {};
+    msg.msg_hdr.msg_name = addr;
+    msg.msg_hdr.msg_namelen = addr_len;
+    msg.msg_hdr.msg_iov = &iovs[first];
+    msg.msg_hdr.msg_iovlen = num_packets - first;
+    if (num_packets - first > 1) {
+      msg.msg_hdr.msg_control = controls[num_msgs].data();
+      msg.msg_hdr.msg_controllen = controls[num_msgs].size();
+      cmsghdr* cmsg = CMSG_FIRSTHDR(&msg.msg_hdr);
+      cmsg->cmsg_level = SOL_UDP;
+      cmsg->cmsg_type = UDP_SEGMENT;
+      cmsg->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+      const uint16_t gso_size = static_cast<uint16_t>(segment_size);
+      memcpy(CMSG_DATA(cmsg), &gso_size, sizeof(gso_size));
+    }
+    packets_per_msg[num_msgs] = static_cast<int>(num_packets - first);
+    ++num_msgs;
+  }
+
+  int sent_msgs = ::sendmmsg(s_, msgs.data(), static_cast<unsigned int>(num_msgs),
+#if defined(WEBRTC_LINUX) && !defined(WEBRTC_ANDROID)
+                             // Suppress SIGPIPE. See PhysicalSocket::Send.
+                             MSG_NOSIGNAL
+#else
+                             0
+#endif
+  );
+  if (sent_msgs <= 0) {
+    if (udp_gso_ && num_msgs < num_packets &&
+        (errno == EINVAL || errno == EIO || errno == ENOPROTOOPT)) {
+      // Either the kernel or the outgoing device lacks GSO support. Fall back
+      // to one datagram per message.
+      RTC_LOG(LS_WARNING) << "UDP GSO send failed with error " << errno
+                          << ", disabling GSO.";
+      udp_gso_ = false;
+      return DoSendBatch(packets, addr, addr_len);
+    }
+    return sent_msgs;
+  }
+  int sent_packets = 0;
+  for (int i = 0; i < sent_msgs; ++i) {
+    sent_packets += packets_per_msg[i];
+  }
+  return sent_packets;
+}
+#endif
+
 int PhysicalSocket::Recv(void* buffer, size_t length, int64_t* timestamp) {
-  int received = DoReadFromSocket(buffer, length, /*out_addr*/ nullptr,
-                                  timestamp, /*ecn=*/nullptr);
+  int received = DoReadFromSocket(buffer, length, /*spill=*/{},
+                                  /*out_addr*/ nullptr, timestamp,
+                                  /*ecn=*/nullptr);
   if ((received == 0) && (length != 0)) {
     // Note: on graceful shutdown, recv can return 0.  In this case, we
     // pretend it is blocking, and then signal close, so that simplifying
@@ -467,7 +642,8 @@ int PhysicalSocket::RecvFrom(void* buffer,
                              size_t length,
                              SocketAddress* out_addr,
                              int64_t* timestamp) {
-  int received = DoReadFromSocket(buffer, length, out_addr, timestamp, nullptr);
+  int received = DoReadFromSocket(buffer, length, /*spill=*/{}, out_addr,
+                                  timestamp, nullptr);
 
   UpdateLastError();
   int error = GetError();
@@ -483,13 +659,28 @@ int PhysicalSocket::RecvFrom(void* buffer,
 
 int PhysicalSocket::RecvFrom(ReceiveBuffer& buffer) {
   int64_t timestamp = -1;
-  static constexpr int BUF_SIZE = 64 * 1024;
-  buffer.payload.EnsureCapacity(BUF_SIZE);
-
-  int received = DoReadFromSocket(
-      buffer.payload.data(), buffer.payload.capacity(), &buffer.source_address,
-      &timestamp, ecn_ ? &buffer.ecn : nullptr);
-  buffer.payload.SetSize(received > 0 ? received : 0);
+  rtc::ArrayView<uint8_t> spill;
+  if (ReceivesIntoPayloadCapacity() && buffer.use_payload_capacity &&
+      buffer.payload.capacity() > 0 &&
+      buffer.payload.capacity() < kMaxDatagramSize) {
+    recv_spill_.EnsureCapacity(kMaxDatagramSize - buffer.payload.capacity());
+    spill = rtc::ArrayView<uint8_t>(recv_spill_.data(), recv_spill_.capacity());
+  }
+  if (spill.empty()) {
+    buffer.payload.EnsureCapacity(kMaxDatagramSize);
+  }
+  const size_t capacity = buffer.payload.capacity();
+
+  int received = DoReadFromSocket(buffer.payload.data(), capacity, spill,
+                                  &buffer.source_address, &timestamp,
+                                  ecn_ ? &buffer.ecn : nullptr);
+  if (received > 0 && static_cast<size_t>(received) > capacity) {
+    // Rare: the datagram did not fit and the payload has to grow.
+    buffer.payload.SetSize(capacity);
+    buffer.payload.AppendData(recv_spill_.data(), received - capacity);
+  } else {
+    buffer.payload.SetSize(received > 0 ? received : 0);
+  }
   if (received > 0 && timestamp != -1) {
     buffer.arrival_time = webrtc::Timestamp::Micros(timestamp);
   }
@@ -505,8 +696,107 @@ int PhysicalSocket::RecvFrom(ReceiveBuffer& buffer) {
   return received;
 }
 
+int PhysicalSocket::RecvFromBatch(rtc::ArrayView<ReceiveBuffer> buffers) {
+#if defined(WEBRTC_LINUX) || defined(WEBRTC_ANDROID)
+  if (!udp_ || buffers.size() <= 1) {
+    return Socket::RecvFromBatch(buffers);
+  }
+  // TODO(bugs.webrtc.org/15368): See DoReadFromSocket for the control size.
+  static constexpr size_t kControlSize =
+      CMSG_SPACE(sizeof(struct timeval) + 5 * sizeof(int));
+  size_t count = std::min(buffers.size(), kMaxRecvBatchSize);
+
+  // As in RecvFrom(ReceiveBuffer&), payloads that use their own capacity get a
+  // spill iovec for the tail of larger datagrams. Each datagram needs its own
+  // slice, since all of them are written before any is copied out. Datagrams
+  // whose slice would not fit in `kMaxRecvSpillSize` are left for the next
+  // read.
+  std::array<size_t, kMaxRecvBatchSize> spill_sizes;
+  size_t total_spill_size = 0;
+  for (size_t i = 0; i < count; ++i) {
+    const size_t capacity = buffers[i].payload.capacity();
+    const size_t spill_size = buffers[i].use_payload_capacity &&
+                                      capacity > 0 &&
+                                      capacity < kMaxDatagramSize
+                                  ? kMaxDatagramSize - capacity
+                                  : 0;
+    if (i > 0 && total_spill_size + spill_size > kMaxRecvSpillSize) {
+      count = i;
+      break;
+    }
+    spill_sizes[i] = spill_size;
+    total_spill_size += spill_size;
+  }
+  recv_spill_.EnsureCapacity(total_spill_size);
+
+  std::array<mmsghdr, kMaxRecvBatchSize> msgs;
+  std::array<std::array<iovec, 2>, kMaxRecvBatchSize> iovs;
+  std::array<uint8_t*, kMaxRecvBatchSize> spills;
+  std::array<sockaddr_storage, kMaxRecvBatchSize> addrs;
+  std::array<std::array<char, kControlSize>, kMaxRecvBatchSize> controls;
+  uint8_t* next_spill = recv_spill_.data();
+  for (size_t i = 0; i < count; ++i) {
+    Buffer& payload = buffers[i].payload;
+    if (spill_sizes[i] == 0) {
+      payload.EnsureCapacity(kMaxDatagramSize);
+    }
+    spills[i] = next_spill;
+    next_spill += spill_sizes[i];
+    iovs[i][0] = {.iov_base = payload.data(), .iov_len = payload.capacity()};
+    iovs[i][1] = {.iov_base = spills[i], .iov_len = spill_sizes[i]};
+    msgs[i] = {};
+    msgs[i].msg_hdr.msg_name = &addrs[i];
+    msgs[i].msg_hdr.msg_namelen = sizeof(addrs[i]);
+    msgs[i].msg_hdr.msg_iov = iovs[i].data();
+    msgs[i].msg_hdr.msg_iovlen = spill_sizes[i] > 0 ? 2 : 1;
+    msgs[i].msg_hdr.msg_control = controls[i].data();
+    msgs[i].msg_hdr.msg_controllen = controls[i].size();
+  }
+
+  int received = ::recvmmsg(s_, msgs.data(), static_cast<unsigned int>(count),
+                            0, nullptr);
+  for (int i = 0; i < received; ++i) {
+    ReceiveBuffer& buffer = buffers[i];
+    int64_t timestamp = -1;
+    ParseControlMessages(&msgs[i].msg_hdr, &timestamp,
+                         ecn_ ? &buffer.ecn : nullptr);
+    const size_t capacity = iovs[i][0].iov_len;
+    if (msgs[i].msg_len > capacity) {
+      // Rare: the datagram did not fit and the payload has to grow.
+      buffer.payload.SetSize(capacity);
+      buffer.payload.AppendData(spills[i], msgs[i].msg_len - capacity);
+    } else {
+      buffer.payload.SetSize(msgs[i].msg_len);
+    }
+    SocketAddressFromSockAddrStorage(addrs[i], &buffer.source_address);
+    if (timestamp != -1) {
+      buffer.arrival_time = webrtc::Timestamp::Micros(timestamp);
+    }
+  }
+  UpdateLastError();
+  int error = GetError();
+  bool success = (received >= 0) || IsBlockingError(error);
+  EnableEvents(DE_READ);
+  if (!success) {
+    RTC_LOG_F(LS_VERBOSE) << "Error = " << error;
+  }
+  return received;
+#else
+  return Socket::RecvFromBatch(buffers);
+#endif
+}
+
+bool PhysicalSocket::ReceivesIntoPayloadCapacity() const {
+#if defined(WEBRTC_POSIX)
+  return true;
+#else
+  return false;
+#endif
+}
+
 int PhysicalSocket::DoReadFromSocket(void* buffer,
                                      size_t length,
+                                     rtc::ArrayView<uint8_t> spill,
                                      SocketAddress* out_addr,
                                      int64_t* timestamp,
                                      EcnMarking* ecn) {
@@ -516,8 +806,12 @@ int PhysicalSocket::DoReadFromSocket(void* buffer,
 
 #if defined(WEBRTC_POSIX)
   int received = 0;
-  iovec iov = {.iov_base = buffer, .iov_len = length};
-  msghdr msg = {.msg_iov = &iov, .msg_iovlen = 1};
+  iovec iov[2] = {{.iov_base = buffer, .iov_len = length},
+                  {.iov_base = spill.data(), .iov_len = spill.size()}};
+  msghdr msg = {.msg_iov = iov, .msg_iovlen = 1};
+  if (!spill.empty()) {
+    msg.msg_iovlen = 2;
+  }
   if (out_addr) {
     out_addr->Clear();
     msg.msg_name = addr;
@@ -537,24 +831,7 @@ int PhysicalSocket::DoReadFromSocket(void* buffer,
       return received;
     }
     if (timestamp || ecn) {
-      struct cmsghdr* cmsg;
-      for (cmsg = CMSG_FIRSTHDR(&msg); cmsg; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
-        if (ecn) {
-          if ((cmsg->cmsg_type == IPV6_TCLASS &&
-               cmsg->cmsg_level == IPPROTO_IPV6) ||
-              (cmsg->cmsg_type == IP_TOS && cmsg->cmsg_level == IPPROTO_IP)) {
-            *ecn = EcnFromDs(CMSG_DATA(cmsg)[0]);
-          }
-        }
-        if (cmsg->cmsg_level != SOL_SOCKET)
-          continue;
-        if (timestamp && cmsg->cmsg_type == SCM_TIMESTAMP) {
-          timeval* ts = reinterpret_cast<timeval*>(CMSG_DATA(cmsg));
-          *timestamp =
-              rtc::kNumMicrosecsPerSec * static_cast<int64_t>(ts->tv_sec) +
-              static_cast<int64_t>(ts->tv_usec);
-        }
-      }
+      ParseControlMessages(&msg, timestamp, ecn);
     }
     if (out_addr) {
       SocketAddressFromSockAddrStorage(addr_storage, out_addr);
@@ -761,6 +1038,8 @@ int PhysicalSocket::TranslateOption(Option opt, int* slevel, int* sopt) {
 #endif
     case OPT_RTP_SENDTIME_EXTN_ID:
       return -1;  // No logging is necessary as this not a OS socket option.
+    case OPT_UDP_GSO:
+      return -1;  // Handled in GetOption/SetOption, applied per SendToBatch.
     case OPT_KEEPALIVE:
       *slevel = SOL_SOCKET;
       *sopt = SO_KEEPALIVE;
@@ -183,6 +183,13 @@ class PhysicalSocket : public Socket, public sigslot::has_slots<> {
   int SendTo(const void* buffer,
              size_t length,
              const SocketAddress& addr) override;
+  // On Linux, UDP sockets send the batch with sendmmsg(). With OPT_UDP_GSO
+  // enabled, runs of equal-size packets additionally share a message using
+  // UDP_SEGMENT.
+  int SendToBatch(rtc::ArrayView<const rtc::ArrayView<const uint8_t>> packets,
+                  const SocketAddress& addr) override;
+  // True for UDP sockets on Linux.
+  bool SendsBatchesInOneCall() const override;
 
   int Recv(void* buffer, size_t length, int64_t* timestamp) override;
   // TODO(webrtc:15368): Deprecate and remove.
@@ -191,6 +198,12 @@ class PhysicalSocket : public Socket, public sigslot::has_slots<> {
                SocketAddress* out_addr,
                int64_t* timestamp) override;
   int RecvFrom(ReceiveBuffer& buffer) override;
+  // On Linux, UDP sockets read up to `kMaxRecvBatchSize` datagrams with a
+  // single recvmmsg() call.
+  int RecvFromBatch(rtc::ArrayView<ReceiveBuffer> buffers) override;
+  // True on POSIX, where datagrams that do not fit the payload's capacity are
+  // read into a second iovec.
+  bool ReceivesIntoPayloadCapacity() const override;
 
   int Listen(int backlog) override;
   Socket* Accept(SocketAddress* out_addr) override;
@@ -201,6 +214,15 @@ class PhysicalSocket : public Socket, public sigslot::has_slots<> {
 
   SOCKET GetSocketFD() const { return s_; }
 
+  // Upper bound on the number of datagrams read by one RecvFromBatch() call.
+  static constexpr size_t kMaxRecvBatchSize = 64;
+  // Upper bound on the memory that RecvFromBatch() keeps for the tails of
+  // datagrams that do not fit in their payload's capacity. With 2 KiB
+  // payloads, this limits a batch to 16 datagrams.
+  static constexpr size_t kMaxRecvSpillSize = 1024 * 1024;
+  // Upper bound on the number of datagrams passed to one sendmmsg() call.
+  static constexpr size_t kMaxSendBatchSize = 64;
+
  protected:
   int DoConnect(const SocketAddress& connect_addr);
 
@@ -218,8 +240,19 @@ class PhysicalSocket : public Socket, public sigslot::has_slots<> {
                        const struct sockaddr* dest_addr,
                        socklen_t addrlen);
 
+#if defined(WEBRTC_LINUX) || defined(WEBRTC_ANDROID)
+  // Sends a prefix of `packets` with one sendmmsg() call. Returns the number
+  // of packets sent or a negative value on error.
+  int DoSendBatch(rtc::ArrayView<const rtc::ArrayView<const uint8_t>> packets,
+                  sockaddr_storage* addr,
+                  socklen_t addr_len);
+#endif
+
+  // Reads into `buffer`. On POSIX, data beyond `length` bytes continues into
+  // `spill` when it is not empty.
   int DoReadFromSocket(void* buffer,
                        size_t length,
+                       rtc::ArrayView<uint8_t> spill,
                        SocketAddress* out_addr,
                        int64_t* timestamp,
                        EcnMarking* ecn);
@@ -246,6 +279,11 @@ class PhysicalSocket : public Socket, public sigslot::has_slots<> {
   std::unique_ptr<webrtc::AsyncDnsResolverInterface> resolver_;
   uint8_t dscp_ = 0;  // 6bit.
   uint8_t ecn_ = 0;   // 2bits.
+  bool udp_gso_ = false;
+  // Receives the tail of datagrams that do not fit in the capacity of a
+  // ReceiveBuffer with `use_payload_capacity` set. Batched reads use a
+  // separate slice per datagram, up to `kMaxRecvSpillSize` in total.
+  Buffer recv_spill_;
 
 #if !defined(NDEBUG)
   std::string dbg_addr_;
@@ -0,0 +1,145 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "api/array_view.h"
+#include "benchmark/benchmark.h"
+#include "rtc_base/buffer.h"
+#include "rtc_base/ip_address.h"
+#include "rtc_base/physical_socket_server.h"
+#include "rtc_base/socket.h"
+#include "rtc_base/socket_address.h"
+
+namespace rtc {
+namespace {
+
+// Number of datagrams queued on the loopback socket per iteration. Small
+// enough to fit in the default socket receive buffer.
+constexpr int kPacketsPerIteration = 32;
+constexpr size_t kPacketSize = 1200;
+
+// Sends `kPacketsPerIteration` datagrams over loopback and drains them with
+// RecvFromBatch() using a batch size given by the benchmark argument. A batch
+// size of 1 is the one-recvmsg-per-datagram path.
+void BM_UdpReceive(benchmark::State& state) {
+  const size_t batch_size = state.range(0);
+  PhysicalSocketServer pss;
+  std::unique_ptr<Socket> receiver(pss.CreateSocket(AF_INET, SOCK_DGRAM));
+  std::unique_ptr<Socket> sender(pss.CreateSocket(AF_INET, SOCK_DGRAM));
+  if (receiver->Bind(SocketAddress(IPAddress(INADDR_LOOPBACK), 0)) != 0 ||
+      sender->Bind(SocketAddress(IPAddress(INADDR_LOOPBACK), 0)) != 0) {
+    state.SkipWithError("Failed to bind loopback sockets.");
+    return;
+  }
+  const SocketAddress destination = receiver->GetLocalAddress();
+  const std::vector<uint8_t> payload(kPacketSize, 0x5a);
+
+  std::vector<Buffer> payloads(batch_size);
+  std::vector<Socket::ReceiveBuffer> buffers;
+  int64_t packets = 0;
+  int64_t receive_calls = 0;
+  for (auto _ : state) {
+    state.PauseTiming();
+    for (int i = 0; i < kPacketsPerIteration; ++i) {
+      sender->SendTo(payload.data(), payload.size(), destination);
+    }
+    state.ResumeTiming();
+
+    int received = 0;
+    while (received < kPacketsPerIteration) {
+      buffers.clear();
+      for (Buffer& buffer : payloads) {
+        buffers.emplace_back(buffer);
+      }
+      int count = receiver->RecvFromBatch(buffers);
+      ++receive_calls;
+      if (count <= 0) {
+        // The loopback interface dropped a datagram.
+        break;
+      }
+      received += count;
+    }
+    packets += received;
+  }
+  state.counters["packets_per_second"] =
+      benchmark::Counter(packets, benchmark::Counter::kIsRate);
+  state.counters["syscalls_per_packet"] =
+      packets > 0 ? static_cast<double>(receive_calls) / packets : 0;
+}
+
+BENCHMARK(BM_UdpReceive)->Arg(1)->Arg(8)->Arg(32)->UseRealTime();
+
+// Sends `kPacketsPerIteration` datagrams over loopback with SendToBatch()
+// calls of the batch size given by the first argument, with UDP GSO enabled
+// when the second argument is non-zero.
+void BM_UdpSend(benchmark::State& state) {
+  const size_t batch_size = state.range(0);
+  PhysicalSocketServer pss;
+  std::unique_ptr<Socket> receiver(pss.CreateSocket(AF_INET, SOCK_DGRAM));
+  std::unique_ptr<Socket> sender(pss.CreateSocket(AF_INET, SOCK_DGRAM));
+  if (receiver->Bind(SocketAddress(IPAddress(INADDR_LOOPBACK), 0)) != 0 ||
+      sender->Bind(SocketAddress(IPAddress(INADDR_LOOPBACK), 0)) != 0) {
+    state.SkipWithError("Failed to bind loopback sockets.");
+    return;
+  }
+  if (state.range(1) && sender->SetOption(Socket::OPT_UDP_GSO, 1) != 0) {
+    state.SkipWithError("UDP GSO not supported.");
+    return;
+  }
+  const SocketAddress destination = receiver->GetLocalAddress();
+  const std::vector<uint8_t> payload(kPacketSize, 0x5a);
+  const std::vector<rtc::ArrayView<const uint8_t>> packets(
+      kPacketsPerIteration, payload);
+
+  Buffer drain_buffer;
+  Socket::ReceiveBuffer drain(drain_buffer);
+  int64_t sent_packets = 0;
+  int64_t send_calls = 0;
+  for (auto _ : state) {
+    size_t sent = 0;
+    while (sent < packets.size()) {
+      size_t count = std::min(batch_size, packets.size() - sent);
+      int result = sender->SendToBatch(
+          rtc::ArrayView<const rtc::ArrayView<const uint8_t>>(packets).subview(
+              sent, count),
+          destination);
+      ++send_calls;
+      if (result <= 0) {
+        break;
+      }
+      sent += result;
+    }
+    sent_packets += sent;
+
+    state.PauseTiming();
+    while (receiver->RecvFrom(drain) > 0) {
+    }
+    state.ResumeTiming();
+  }
+  state.counters["packets_per_second"] =
+      benchmark::Counter(sent_packets, benchmark::Counter::kIsRate);
+  state.counters["syscalls_per_packet"] =
+      sent_packets > 0 ? static_cast<double>(send_calls) / sent_packets : 0;
+}
+
+BENCHMARK(BM_UdpSend)
+    ->Args({1, 0})
+    ->Args({8, 0})
+    ->Args({32, 0})
+    ->Args({8, 1})
+    ->Args({32, 1})
+    ->UseRealTime();
+
+}  // namespace
+}  // namespace rtc
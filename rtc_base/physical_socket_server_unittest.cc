@@ -14,13 +14,19 @@
 
 #include <algorithm>
 #include <memory>
+#include <vector>
 
+#include "rtc_base/async_udp_socket.h"
+#include "rtc_base/buffer.h"
+#include "rtc_base/copy_on_write_buffer.h"
 #include "rtc_base/gunit.h"
 #include "rtc_base/ip_address.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/net_helpers.h"
 #include "rtc_base/net_test_helpers.h"
+#include "rtc_base/network/received_packet.h"
 #include "rtc_base/network_monitor.h"
+#include "rtc_base/receive_buffer_pool.h"
 #include "rtc_base/socket_unittest.h"
 #include "rtc_base/test_utils.h"
 #include "rtc_base/thread.h"
@@ -523,6 +529,290 @@ TEST_F(PhysicalSocketTest,
 
 #endif
 
+TEST_F(PhysicalSocketTest, UdpRecvFromBatchReadsQueuedDatagramsIPv4) {
+  MAYBE_SKIP_IPV4;
+  std::unique_ptr<Socket> receiver(server_.CreateSocket(AF_INET, SOCK_DGRAM));
+  std::unique_ptr<Socket> sender(server_.CreateSocket(AF_INET, SOCK_DGRAM));
+  ASSERT_EQ(0, receiver->Bind(SocketAddress(kIPv4Loopback, 0)));
+  ASSERT_EQ(0, sender->Bind(SocketAddress(kIPv4Loopback, 0)));
+
+  constexpr int kNumPackets = 5;
+  for (int i = 0; i < kNumPackets; ++i) {
+    const uint8_t payload[] = {static_cast<uint8_t>(i), 1, 2, 3};
+    ASSERT_EQ(static_cast<int>(sizeof(payload)),
+              sender->SendTo(payload, sizeof(payload),
+                             receiver->GetLocalAddress()));
+  }
+
+  std::vector<Buffer> payloads(8);
+  std::vector<Socket::ReceiveBuffer> buffers;
+  for (Buffer& payload : payloads) {
+    buffers.emplace_back(payload);
+  }
+  int received = 0;
+  while (received < kNumPackets) {
+    int count = receiver->RecvFromBatch(
+        rtc::ArrayView<Socket::ReceiveBuffer>(buffers).subview(received));
+    ASSERT_GT(count, 0);
+    received += count;
+  }
+  for (int i = 0; i < kNumPackets; ++i) {
+    EXPECT_EQ(buffers[i].payload.size(), 4u);
+    EXPECT_EQ(buffers[i].payload[0], i);
+    EXPECT_EQ(buffers[i].source_address, sender->GetLocalAddress());
+  }
+  EXPECT_LT(receiver->RecvFromBatch(buffers), 0);
+  EXPECT_TRUE(receiver->IsBlocking());
+}
+
+TEST_F(PhysicalSocketTest, AsyncUdpSocketDeliversReceiveBatchesIPv4) {
+  MAYBE_SKIP_IPV4;
+  std::unique_ptr<AsyncUDPSocket> receiver(
+      AsyncUDPSocket::Create(&server_, SocketAddress(kIPv4Loopback, 0)));
+  std::unique_ptr<AsyncUDPSocket> sender(
+      AsyncUDPSocket::Create(&server_, SocketAddress(kIPv4Loopback, 0)));
+  ASSERT_TRUE(receiver);
+  ASSERT_TRUE(sender);
+
+  std::vector<size_t> received_sizes;
+  receiver->SetMaxReceiveBatchSize(8);
+  receiver->RegisterReceivedPacketBatchCallback(
+      [&](AsyncPacketSocket* socket,
+          rtc::ArrayView<const ReceivedPacket> packets) {
+        for (const ReceivedPacket& packet : packets) {
+          EXPECT_EQ(packet.source_address(), sender->GetLocalAddress());
+          received_sizes.push_back(packet.payload().size());
+        }
+      });
+
+  const char kData[] = "0123456789";
+  for (size_t size = 1; size <= 3; ++size) {
+    ASSERT_EQ(static_cast<int>(size),
+              sender->SendTo(kData, size, receiver->GetLocalAddress(),
+                             PacketOptions()));
+  }
+  EXPECT_EQ_WAIT(3u, received_sizes.size(), kTimeout);
+  EXPECT_EQ(received_sizes, std::vector<size_t>({1, 2, 3}));
+}
+
+void SendToBatchReceivesAllPackets(Socket* sender, Socket* receiver) {
+  const std::vector<uint8_t> packets[] = {
+      std::vector<uint8_t>(1000, 0), std::vector<uint8_t>(1000, 1),
+      std::vector<uint8_t>(1000, 2), std::vector<uint8_t>(500, 3),
+      std::vector<uint8_t>(1200, 4), std::vector<uint8_t>(7, 5)};
+  std::vector<rtc::ArrayView<const uint8_t>> views;
+  for (const std::vector<uint8_t>& packet : packets) {
+    views.push_back(packet);
+  }
+  ASSERT_EQ(6, sender->SendToBatch(views, receiver->GetLocalAddress()));
+
+  std::vector<Buffer> payloads(8);
+  std::vector<Socket::ReceiveBuffer> buffers;
+  for (Buffer& payload : payloads) {
+    buffers.emplace_back(payload);
+  }
+  int received = 0;
+  while (received < 6) {
+    int count = receiver->RecvFromBatch(
+        rtc::ArrayView<Socket::ReceiveBuffer>(buffers).subview(received));
+    ASSERT_GT(count, 0);
+    received += count;
+  }
+  for (int i = 0; i < 6; ++i) {
+    EXPECT_EQ(buffers[i].payload.size(), packets[i].size());
+    EXPECT_EQ(buffers[i].payload[0], i);
+  }
+}
+
+TEST_F(PhysicalSocketTest, UdpSendToBatchIPv4) {
+  MAYBE_SKIP_IPV4;
+  std::unique_ptr<Socket> receiver(server_.CreateSocket(AF_INET, SOCK_DGRAM));
+  std::unique_ptr<Socket> sender(server_.CreateSocket(AF_INET, SOCK_DGRAM));
+  ASSERT_EQ(0, receiver->Bind(SocketAddress(kIPv4Loopback, 0)));
+  ASSERT_EQ(0, sender->Bind(SocketAddress(kIPv4Loopback, 0)));
+  SendToBatchReceivesAllPackets(sender.get(), receiver.get());
+}
+
+#if defined(WEBRTC_LINUX) && !defined(WEBRTC_ANDROID)
+TEST_F(PhysicalSocketTest, UdpSendToBatchWithGsoIPv4) {
+  MAYBE_SKIP_IPV4;
+  std::unique_ptr<Socket> receiver(server_.CreateSocket(AF_INET, SOCK_DGRAM));
+  std::unique_ptr<Socket> sender(server_.CreateSocket(AF_INET, SOCK_DGRAM));
+  ASSERT_EQ(0, receiver->Bind(SocketAddress(kIPv4Loopback, 0)));
+  ASSERT_EQ(0, sender->Bind(SocketAddress(kIPv4Loopback, 0)));
+  ASSERT_EQ(0, sender->SetOption(Socket::OPT_UDP_GSO, 1));
+  // Kernels without GSO support fall back to one datagram per packet.
+  SendToBatchReceivesAllPackets(sender.get(), receiver.get());
+}
+#endif
+
+TEST_F(PhysicalSocketTest, AsyncUdpSocketSendsBatchablePacketsTogetherIPv4) {
+  MAYBE_SKIP_IPV4;
+  std::unique_ptr<AsyncUDPSocket> receiver(
+      AsyncUDPSocket::Create(&server_, SocketAddress(kIPv4Loopback, 0)));
+  std::unique_ptr<AsyncUDPSocket> sender(
+      AsyncUDPSocket::Create(&server_, SocketAddress(kIPv4Loopback, 0)));
+  ASSERT_TRUE(receiver);
+  ASSERT_TRUE(sender);
+  int received = 0;
+  receiver->RegisterReceivedPacketCallback(
+      [&](AsyncPacketSocket* socket, const ReceivedPacket& packet) {
+        ++received;
+      });
+
+  const char kData[] = "0123456789";
+  PacketOptions options;
+  options.batchable = true;
+  for (int i = 0; i < 3; ++i) {
+    options.last_packet_in_batch = i == 2;
+    EXPECT_EQ(10, sender->SendTo(kData, 10, receiver->GetLocalAddress(),
+                                 options));
+  }
+  // Without a packet marking the end of the batch, the batch is flushed when
+  // the current task is done.
+  options.last_packet_in_batch = false;
+  EXPECT_EQ(10,
+            sender->SendTo(kData, 10, receiver->GetLocalAddress(), options));
+  EXPECT_EQ_WAIT(4, received, kTimeout);
+
+  AsyncUDPSocket::SendBatchStats stats = sender->GetSendBatchStats();
+  EXPECT_EQ(stats.batched_packets, 4);
+  EXPECT_EQ(stats.batches, 2);
+}
+
+TEST_F(PhysicalSocketTest, UdpRecvFromUsesPayloadCapacityIPv4) {
+  MAYBE_SKIP_IPV4;
+  std::unique_ptr<Socket> receiver(server_.CreateSocket(AF_INET, SOCK_DGRAM));
+  std::unique_ptr<Socket> sender(server_.CreateSocket(AF_INET, SOCK_DGRAM));
+  ASSERT_EQ(0, receiver->Bind(SocketAddress(kIPv4Loopback, 0)));
+  ASSERT_EQ(0, sender->Bind(SocketAddress(kIPv4Loopback, 0)));
+
+  const std::vector<uint8_t> small(100, 1);
+  std::vector<uint8_t> large(5000);
+  for (size_t i = 0; i < large.size(); ++i) {
+    large[i] = static_cast<uint8_t>(i);
+  }
+  ASSERT_EQ(100, sender->SendTo(small.data(), small.size(),
+                                receiver->GetLocalAddress()));
+  ASSERT_EQ(5000, sender->SendTo(large.data(), large.size(),
+                                 receiver->GetLocalAddress()));
+
+  Buffer payload(0, 1000);
+  const uint8_t* data = payload.data();
+  Socket::ReceiveBuffer buffer(payload);
+  buffer.use_payload_capacity = true;
+  ASSERT_EQ(100, receiver->RecvFrom(buffer));
+  EXPECT_EQ(payload.data(), data);
+  EXPECT_EQ(payload.capacity(), 1000u);
+  EXPECT_EQ(std::vector<uint8_t>(payload.begin(), payload.end()), small);
+
+  // Datagrams that do not fit are still received in full.
+  ASSERT_EQ(5000, receiver->RecvFrom(buffer));
+  EXPECT_EQ(std::vector<uint8_t>(payload.begin(), payload.end()), large);
+}
+
+#if defined(WEBRTC_LINUX)
+TEST_F(PhysicalSocketTest, UdpRecvFromBatchUsesPayloadCapacityIPv4) {
+  MAYBE_SKIP_IPV4;
+  std::unique_ptr<Socket> receiver(server_.CreateSocket(AF_INET, SOCK_DGRAM));
+  std::unique_ptr<Socket> sender(server_.CreateSocket(AF_INET, SOCK_DGRAM));
+  ASSERT_EQ(0, receiver->Bind(SocketAddress(kIPv4Loopback, 0)));
+  ASSERT_EQ(0, sender->Bind(SocketAddress(kIPv4Loopback, 0)));
+
+  // Two oversized datagrams in one batch must not share a spill area.
+  std::vector<std::vector<uint8_t>> datagrams = {std::vector<uint8_t>(100, 1),
+                                                 std::vector<uint8_t>(5000, 2),
+                                                 std::vector<uint8_t>(3000, 3)};
+  for (const std::vector<uint8_t>& datagram : datagrams) {
+    ASSERT_EQ(static_cast<int>(datagram.size()),
+              sender->SendTo(datagram.data(), datagram.size(),
+                             receiver->GetLocalAddress()));
+  }
+
+  std::vector<Buffer> payloads;
+  std::vector<Socket::ReceiveBuffer> buffers;
+  for (size_t i = 0; i < datagrams.size(); ++i) {
+    payloads.emplace_back(0, 1000);
+  }
+  const uint8_t* small_data = payloads[0].data();
+  for (Buffer& payload : payloads) {
+    buffers.emplace_back(payload);
+    buffers.back().use_payload_capacity = true;
+  }
+  ASSERT_EQ(3, receiver->RecvFromBatch(buffers));
+  EXPECT_EQ(payloads[0].data(), small_data);
+  EXPECT_EQ(payloads[0].capacity(), 1000u);
+  for (size_t i = 0; i < datagrams.size(); ++i) {
+    EXPECT_EQ(std::vector<uint8_t>(payloads[i].begin(), payloads[i].end()),
+              datagrams[i]);
+  }
+}
+
+TEST_F(PhysicalSocketTest, UdpRecvFromBatchLimitsSpillMemoryIPv4) {
+  MAYBE_SKIP_IPV4;
+  std::unique_ptr<Socket> receiver(server_.CreateSocket(AF_INET, SOCK_DGRAM));
+  std::unique_ptr<Socket> sender(server_.CreateSocket(AF_INET, SOCK_DGRAM));
+  ASSERT_EQ(0, receiver->Bind(SocketAddress(kIPv4Loopback, 0)));
+  ASSERT_EQ(0, sender->Bind(SocketAddress(kIPv4Loopback, 0)));
+
+  constexpr size_t kNumPackets = 20;
+  const uint8_t kData[] = {1, 2, 3, 4};
+  for (size_t i = 0; i < kNumPackets; ++i) {
+    ASSERT_EQ(static_cast<int>(sizeof(kData)),
+              sender->SendTo(kData, sizeof(kData),
+                             receiver->GetLocalAddress()));
+  }
+
+  // Each 2 KiB payload needs a spill slice of 62 KiB, of which 1 MiB fits
+  // 16.
+  std::vector<Buffer> payloads;
+  std::vector<Socket::ReceiveBuffer> buffers;
+  for (size_t i = 0; i < kNumPackets; ++i) {
+    payloads.emplace_back(0, 2048);
+  }
+  for (Buffer& payload : payloads) {
+    buffers.emplace_back(payload);
+    buffers.back().use_payload_capacity = true;
+  }
+  EXPECT_EQ(16, receiver->RecvFromBatch(buffers));
+  EXPECT_EQ(4, receiver->RecvFromBatch(buffers));
+}
+#endif
+
+TEST_F(PhysicalSocketTest, AsyncUdpSocketLetsReceiverTakePayloadIPv4) {
+  MAYBE_SKIP_IPV4;
+  std::unique_ptr<AsyncUDPSocket> receiver(
+      AsyncUDPSocket::Create(&server_, SocketAddress(kIPv4Loopback, 0)));
+  std::unique_ptr<AsyncUDPSocket> sender(
+      AsyncUDPSocket::Create(&server_, SocketAddress(kIPv4Loopback, 0)));
+  ASSERT_TRUE(receiver);
+  ASSERT_TRUE(sender);
+  // Keeps the odd packets and only inspects the even ones.
+  std::vector<CopyOnWriteBuffer> kept;
+  int received = 0;
+  receiver->RegisterReceivedPacketCallback(
+      [&](AsyncPacketSocket* socket, const ReceivedPacket& packet) {
+        if (received++ % 2 == 1) {
+          kept.push_back(ReceivedPacket(packet).TakePayload());
+        }
+      });
+
+  const char kData[] = "0123456789";
+  for (int i = 0; i < 6; ++i) {
+    ASSERT_EQ(10, sender->SendTo(kData, 10, receiver->GetLocalAddress(),
+                                 PacketOptions()));
+    EXPECT_EQ_WAIT(i + 1, received, kTimeout);
+  }
+  ASSERT_EQ(kept.size(), 3u);
+  EXPECT_EQ(kept[0], CopyOnWriteBuffer(kData, 10));
+
+  // Buffers of packets that were only inspected are reused, so one buffer is
+  // allocated per kept packet.
+  ReceiveBufferPool::Stats stats = receiver->GetReceiveBufferStats();
+  EXPECT_EQ(stats.acquired, 6);
+  EXPECT_EQ(stats.allocated, 3);
+}
+
 TEST_F(PhysicalSocketTest, UdpSocketRecvTimestampUseRtcEpochIPv4) {
   MAYBE_SKIP_IPV4;
   SocketTest::TestUdpSocketRecvTimestampUseRtcEpochIPv4();
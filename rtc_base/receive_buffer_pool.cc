@@ -0,0 +1,54 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/receive_buffer_pool.h"
+
+#include <utility>
+
+#include "rtc_base/checks.h"
+
+namespace rtc {
+
+ReceiveBufferPool::ReceiveBufferPool(size_t buffer_capacity,
+                                     size_t max_free_buffers)
+    : buffer_capacity_(buffer_capacity), max_free_buffers_(max_free_buffers) {
+  RTC_DCHECK_GT(buffer_capacity_, 0);
+}
+
+ReceiveBufferPool::~ReceiveBufferPool() = default;
+
+Buffer ReceiveBufferPool::Acquire() {
+  RTC_DCHECK_RUN_ON(&sequence_checker_);
+  ++stats_.acquired;
+  if (free_buffers_.empty()) {
+    ++stats_.allocated;
+    return Buffer(0, buffer_capacity_);
+  }
+  Buffer buffer = std::move(free_buffers_.back());
+  free_buffers_.pop_back();
+  return buffer;
+}
+
+void ReceiveBufferPool::Release(Buffer buffer) {
+  RTC_DCHECK_RUN_ON(&sequence_checker_);
+  if (buffer.capacity() < buffer_capacity_ ||
+      free_buffers_.size() >= max_free_buffers_) {
+    return;
+  }
+  buffer.Clear();
+  free_buffers_.push_back(std::move(buffer));
+}
+
+ReceiveBufferPool::Stats ReceiveBufferPool::stats() const {
+  RTC_DCHECK_RUN_ON(&sequence_checker_);
+  return stats_;
+}
+
+}  // namespace rtc
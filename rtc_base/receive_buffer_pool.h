@@ -0,0 +1,75 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_RECEIVE_BUFFER_POOL_H_
+#define RTC_BASE_RECEIVE_BUFFER_POOL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+#include "api/sequence_checker.h"
+#include "rtc_base/buffer.h"
+#include "rtc_base/system/no_unique_address.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace rtc {
+
+// Hands out buffers of a fixed capacity for a socket to receive datagrams
+// into. A receiver that keeps a payload takes over its buffer (see
+// ReceivedPacket::TakePayload()), so the datagram is never copied after the
+// kernel wrote it. Buffers that were not taken are returned to the pool and
+// reused for the next datagram.
+class ReceiveBufferPool final {
+ public:
+  // Fits a full-MTU datagram including TURN and SRTP overhead, without
+  // holding on to much more memory than that for every packet that a receiver
+  // keeps.
+  static constexpr size_t kDefaultBufferCapacity = 2048;
+
+  struct Stats {
+    // Number of buffers handed out by Acquire().
+    int64_t acquired = 0;
+    // Number of buffers that had to be allocated. The difference to
+    // `acquired` is the number of buffers that were reused.
+    int64_t allocated = 0;
+  };
+
+  explicit ReceiveBufferPool(size_t buffer_capacity = kDefaultBufferCapacity,
+                             size_t max_free_buffers = 8);
+  ~ReceiveBufferPool();
+
+  ReceiveBufferPool(const ReceiveBufferPool&) = delete;
+  ReceiveBufferPool& operator=(const ReceiveBufferPool&) = delete;
+
+  size_t buffer_capacity() const { return buffer_capacity_; }
+
+  // Returns an empty buffer with a capacity of at least `buffer_capacity()`.
+  Buffer Acquire();
+
+  // Gives `buffer` back for reuse. Buffers that a receiver took over have no
+  // capacity left and are dropped, as are buffers beyond `max_free_buffers`.
+  void Release(Buffer buffer);
+
+  Stats stats() const;
+
+ private:
+  RTC_NO_UNIQUE_ADDRESS webrtc::SequenceChecker sequence_checker_{
+      webrtc::SequenceChecker::kDetached};
+  const size_t buffer_capacity_;
+  const size_t max_free_buffers_;
+  std::vector<Buffer> free_buffers_ RTC_GUARDED_BY(sequence_checker_);
+  Stats stats_ RTC_GUARDED_BY(sequence_checker_);
+};
+
+}  // namespace rtc
+
+#endif  // RTC_BASE_RECEIVE_BUFFER_POOL_H_
@@ -0,0 +1,105 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/receive_buffer_pool.h"
+
+#include <cstdint>
+#include <utility>
+
+#include "rtc_base/buffer.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/copy_on_write_buffer.h"
+#include "rtc_base/network/received_packet.h"
+#include "rtc_base/socket_address.h"
+#include "test/gtest.h"
+
+namespace rtc {
+namespace {
+
+constexpr uint8_t kPayload[] = {0x80, 0x11, 0x00, 0x01, 0x02, 0x03};
+
+TEST(ReceiveBufferPoolTest, ReusesReleasedBuffers) {
+  ReceiveBufferPool pool(/*buffer_capacity=*/100);
+  Buffer buffer = pool.Acquire();
+  EXPECT_TRUE(buffer.empty());
+  EXPECT_GE(buffer.capacity(), 100u);
+  const uint8_t* data = buffer.data();
+  buffer.SetData(kPayload);
+  pool.Release(std::move(buffer));
+
+  Buffer reused = pool.Acquire();
+  EXPECT_TRUE(reused.empty());
+  EXPECT_EQ(reused.data(), data);
+  EXPECT_EQ(pool.stats().acquired, 2);
+  EXPECT_EQ(pool.stats().allocated, 1);
+}
+
+TEST(ReceiveBufferPoolTest, DropsBuffersTakenByReceiver) {
+  ReceiveBufferPool pool(/*buffer_capacity=*/100);
+  Buffer buffer = pool.Acquire();
+  buffer.SetData(kPayload);
+  const uint8_t* data = buffer.data();
+
+  ReceivedPacket packet(buffer, SocketAddress());
+  packet.SetTakeableBuffer(&buffer);
+  CopyOnWriteBuffer payload = packet.TakePayload();
+  EXPECT_EQ(payload.cdata(), data);
+  EXPECT_EQ(payload.size(), sizeof(kPayload));
+  pool.Release(std::move(buffer));
+
+  Buffer next = pool.Acquire();
+  EXPECT_NE(next.data(), data);
+  EXPECT_EQ(pool.stats().allocated, 2);
+}
+
+TEST(ReceiveBufferPoolTest, TakePayloadSlicesAtPayloadOffset) {
+  Buffer buffer(kPayload);
+  ReceivedPacket packet(rtc::ArrayView<const uint8_t>(buffer).subview(2),
+                        SocketAddress());
+  packet.SetTakeableBuffer(&buffer);
+  ReceivedPacket forwarded = packet.CopyAndSet(ReceivedPacket::kSrtpEncrypted);
+
+  const uint8_t* data = buffer.data();
+  CopyOnWriteBuffer payload = forwarded.TakePayload();
+  EXPECT_EQ(payload.cdata(), data + 2);
+  EXPECT_EQ(payload.size(), sizeof(kPayload) - 2);
+  EXPECT_TRUE(buffer.empty());
+  // Not shared with anything else, so it can be modified in place.
+  EXPECT_EQ(payload.MutableData(), data + 2);
+}
+
+TEST(ReceiveBufferPoolTest, TakePayloadCopiesWithoutTakeableBuffer) {
+  ReceivedPacket packet(kPayload, SocketAddress());
+  CopyOnWriteBuffer payload = packet.TakePayload();
+  EXPECT_NE(payload.cdata(), kPayload);
+  EXPECT_EQ(payload.size(), sizeof(kPayload));
+}
+
+#if RTC_DCHECK_IS_ON && GTEST_HAS_DEATH_TEST && !defined(WEBRTC_ANDROID)
+TEST(ReceiveBufferPoolDeathTest, TakePayloadTwice) {
+  Buffer buffer(kPayload);
+  ReceivedPacket packet(buffer, SocketAddress());
+  packet.SetTakeableBuffer(&buffer);
+  packet.TakePayload();
+  EXPECT_DEATH(packet.TakePayload(), "");
+}
+
+TEST(ReceiveBufferPoolDeathTest, TakePayloadFromTwoCopies) {
+  Buffer buffer(kPayload);
+  ReceivedPacket packet(buffer, SocketAddress());
+  packet.SetTakeableBuffer(&buffer);
+  ReceivedPacket forwarded = packet.CopyAndSet(ReceivedPacket::kSrtpEncrypted);
+  forwarded.TakePayload();
+  EXPECT_DEATH(packet.TakePayload(), "");
+}
+#endif
+
+}  // namespace
+}  // namespace rtc
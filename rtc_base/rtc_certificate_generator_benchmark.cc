@@ -0,0 +1,57 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "absl/types/optional.h"
+#include "api/scoped_refptr.h"
+#include "benchmark/benchmark.h"
+#include "rtc_base/rtc_certificate.h"
+#include "rtc_base/rtc_certificate_generator.h"
+#include "rtc_base/ssl_identity.h"
+
+namespace rtc {
+namespace {
+
+void GenerateCertificates(benchmark::State& state,
+                          const KeyParams& key_params) {
+  for (auto _ : state) {
+    scoped_refptr<RTCCertificate> certificate =
+        RTCCertificateGenerator::GenerateCertificate(key_params,
+                                                     absl::nullopt);
+    if (!certificate) {
+      state.SkipWithError("Failed to generate a certificate.");
+      break;
+    }
+    benchmark::DoNotOptimize(certificate);
+  }
+  state.counters["certificates_per_second"] =
+      benchmark::Counter(state.iterations(), benchmark::Counter::kIsRate);
+}
+
+// Generates an ECDSA P-256 key and self-signed certificate, the default for
+// new PeerConnections.
+void BM_GenerateEcdsaCertificate(benchmark::State& state) {
+  GenerateCertificates(state, KeyParams::ECDSA(EC_NIST_P256));
+}
+
+BENCHMARK(BM_GenerateEcdsaCertificate)->Unit(benchmark::kMicrosecond);
+
+// Generates an RSA key of the modulus size given by the benchmark argument and
+// a self-signed certificate.
+void BM_GenerateRsaCertificate(benchmark::State& state) {
+  GenerateCertificates(state, KeyParams::RSA(state.range(0)));
+}
+
+BENCHMARK(BM_GenerateRsaCertificate)
+    ->Arg(1024)
+    ->Arg(2048)
+    ->Unit(benchmark::kMillisecond);
+
+}  // namespace
+}  // namespace rtc
@@ -0,0 +1,92 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_SEND_BATCH_H_
+#define RTC_BASE_SEND_BATCH_H_
+
+#include <stddef.h>
+
+#include <utility>
+#include <vector>
+
+#include "absl/functional/any_invocable.h"
+#include "api/array_view.h"
+#include "api/task_queue/pending_task_safety_flag.h"
+#include "api/task_queue/task_queue_base.h"
+#include "rtc_base/checks.h"
+
+namespace rtc {
+
+// Packets held back by a sender so that they can be processed together, e.g.
+// with one system call or one call into a crypto library. The owner flushes
+// the batch when the last packet of a burst arrives or the batch is full; in
+// case the last packet never arrives, the batch also flushes itself once the
+// task that added the first packet has finished.
+//
+// Entries are reused between batches, so that buffers inside `T` keep their
+// allocations. Must be used on a single task queue.
+template <typename T>
+class SendBatch {
+ public:
+  // `flush` is called at the end of the task that started a batch, unless the
+  // owner flushed and cleared the batch before that.
+  SendBatch(size_t max_size, absl::AnyInvocable<void()> flush)
+      : max_size_(max_size), flush_(std::move(flush)) {
+    RTC_DCHECK_GT(max_size_, 0);
+    entries_.reserve(max_size_);
+  }
+
+  SendBatch(const SendBatch&) = delete;
+  SendBatch& operator=(const SendBatch&) = delete;
+
+  bool empty() const { return size_ == 0; }
+  bool full() const { return size_ == max_size_; }
+  size_t size() const { return size_; }
+
+  // Returns the entry for one more packet, to be filled in by the caller. The
+  // entry may hold data of an earlier batch. Returns null if there is no
+  // current task queue, as nothing would then guarantee a later flush; such
+  // packets should be sent unbatched.
+  T* Add() {
+    RTC_DCHECK(!full());
+    if (empty()) {
+      webrtc::TaskQueueBase* current = webrtc::TaskQueueBase::Current();
+      if (!current) {
+        return nullptr;
+      }
+      current->PostTask(webrtc::SafeTask(safety_.flag(), [this] {
+        if (!empty()) {
+          flush_();
+        }
+      }));
+    }
+    if (size_ == entries_.size()) {
+      entries_.emplace_back();
+    }
+    return &entries_[size_++];
+  }
+
+  // The entries of the current batch, in the order they were added.
+  ArrayView<T> entries() { return ArrayView<T>(entries_.data(), size_); }
+
+  // Ends the current batch. Call this when flushing.
+  void Clear() { size_ = 0; }
+
+ private:
+  const size_t max_size_;
+  absl::AnyInvocable<void()> flush_;
+  std::vector<T> entries_;
+  size_t size_ = 0;
+  webrtc::ScopedTaskSafety safety_;
+};
+
+}  // namespace rtc
+
+#endif  // RTC_BASE_SEND_BATCH_H_
@@ -0,0 +1,73 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/send_batch.h"
+
+#include <vector>
+
+#include "rtc_base/thread.h"
+#include "test/gtest.h"
+
+namespace rtc {
+namespace {
+
+TEST(SendBatchTest, FlushesAtEndOfTask) {
+  AutoThread main_thread;
+  std::vector<int> flushed;
+  SendBatch<int> batch(/*max_size=*/4, [&] {
+    for (int value : batch.entries()) {
+      flushed.push_back(value);
+    }
+    batch.Clear();
+  });
+
+  *batch.Add() = 1;
+  *batch.Add() = 2;
+  EXPECT_EQ(batch.size(), 2u);
+  EXPECT_TRUE(flushed.empty());
+  main_thread.ProcessMessages(0);
+  EXPECT_EQ(flushed, (std::vector<int>{1, 2}));
+  EXPECT_TRUE(batch.empty());
+}
+
+TEST(SendBatchTest, DoesNotFlushBatchThatOwnerFlushed) {
+  AutoThread main_thread;
+  int flushes = 0;
+  SendBatch<int> batch(/*max_size=*/2, [&] {
+    ++flushes;
+    batch.Clear();
+  });
+
+  *batch.Add() = 1;
+  *batch.Add() = 2;
+  EXPECT_TRUE(batch.full());
+  batch.Clear();
+  main_thread.ProcessMessages(0);
+  EXPECT_EQ(flushes, 0);
+}
+
+TEST(SendBatchTest, ReusesEntries) {
+  AutoThread main_thread;
+  SendBatch<std::vector<int>> batch(/*max_size=*/2, [] {});
+  batch.Add()->push_back(1);
+  batch.Clear();
+  std::vector<int>* entry = batch.Add();
+  EXPECT_EQ(*entry, std::vector<int>{1});
+  EXPECT_EQ(entry, batch.entries().data());
+}
+
+TEST(SendBatchTest, DoesNotBatchWithoutTaskQueue) {
+  SendBatch<int> batch(/*max_size=*/2, [] {});
+  EXPECT_EQ(batch.Add(), nullptr);
+  EXPECT_TRUE(batch.empty());
+}
+
+}  // namespace
+}  // namespace rtc
@@ -30,4 +30,25 @@ int Socket::RecvFrom(ReceiveBuffer& buffer) {
   return len;
 }
 
+int Socket::SendToBatch(
+    rtc::ArrayView<const rtc::ArrayView<const uint8_t>> packets,
+    const SocketAddress& addr) {
+  int sent = 0;
+  for (rtc::ArrayView<const uint8_t> packet : packets) {
+    if (SendTo(packet.data(), packet.size(), addr) < 0) {
+      return sent > 0 ? sent : -1;
+    }
+    ++sent;
+  }
+  return sent;
+}
+
+int Socket::RecvFromBatch(rtc::ArrayView<ReceiveBuffer> buffers) {
+  if (buffers.empty()) {
+    return 0;
+  }
+  int len = RecvFrom(buffers[0]);
+  return len <= 0 ? len : 1;
+}
+
 }  // namespace rtc
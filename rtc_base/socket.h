@@ -28,6 +28,7 @@
 #include "rtc_base/win32.h"
 #endif
 
+#include "api/array_view.h"
 #include "api/units/timestamp.h"
 #include "rtc_base/buffer.h"
 #include "rtc_base/network/ecn_marking.h"
@@ -94,6 +95,12 @@ class RTC_EXPORT Socket {
     SocketAddress source_address;
     EcnMarking ecn = EcnMarking::kNotEct;
     Buffer& payload;
+    // If true, datagrams are read into the capacity that `payload` already
+    // has rather than growing it to the maximum datagram size first. Larger
+    // datagrams are still received in full. Lets callers hand out the payload
+    // buffer without it pinning 64 KiB of memory. Ignored by sockets whose
+    // ReceivesIntoPayloadCapacity() returns false.
+    bool use_payload_capacity = false;
   };
   virtual ~Socket() {}
 
@@ -112,6 +119,16 @@ class RTC_EXPORT Socket {
   virtual int Connect(const SocketAddress& addr) = 0;
   virtual int Send(const void* pv, size_t cb) = 0;
   virtual int SendTo(const void* pv, size_t cb, const SocketAddress& addr) = 0;
+  // Sends `packets` to `addr` with as few system calls as the implementation
+  // allows. Returns the number of packets sent, which may be less than
+  // `packets.size()`, or a negative value if not even the first packet could
+  // be sent. Default implementation calls SendTo() for each packet.
+  virtual int SendToBatch(
+      rtc::ArrayView<const rtc::ArrayView<const uint8_t>> packets,
+      const SocketAddress& addr);
+  // Returns true if SendToBatch() hands a batch to the system in one call
+  // rather than calling SendTo() for each packet.
+  virtual bool SendsBatchesInOneCall() const { return false; }
   // `timestamp` is in units of microseconds.
   virtual int Recv(void* pv, size_t cb, int64_t* timestamp) = 0;
   // TODO(webrtc:15368): Deprecate and remove.
@@ -126,6 +143,16 @@ class RTC_EXPORT Socket {
   // Default implementation calls RecvFrom(void* ...) with 64Kbyte buffer.
   // Returns number of bytes received or a negative value on error.
   virtual int RecvFrom(ReceiveBuffer& buffer);
+  // Receives up to `buffers.size()` datagrams with as few system calls as the
+  // implementation allows. Datagram i is written to `buffers[i]`. Returns the
+  // number of datagrams received, 0 if nothing was read, or a negative value
+  // on error. Default implementation reads a single datagram with
+  // RecvFrom(ReceiveBuffer&).
+  virtual int RecvFromBatch(rtc::ArrayView<ReceiveBuffer> buffers);
+  // Returns true if RecvFrom(ReceiveBuffer&) and RecvFromBatch() honour
+  // ReceiveBuffer::use_payload_capacity. Other sockets grow every payload to
+  // the maximum datagram size before reading into it.
+  virtual bool ReceivesIntoPayloadCapacity() const { return false; }
   virtual int Listen(int backlog) = 0;
   virtual Socket* Accept(SocketAddress* paddr) = 0;
   virtual int Close() = 0;
@@ -153,6 +180,8 @@ class RTC_EXPORT Socket {
     OPT_TCP_KEEPIDLE,      // Set TCP keep alive idle time in seconds
     OPT_TCP_KEEPINTVL,     // Set TCP keep alive interval in seconds
     OPT_TCP_USER_TIMEOUT,  // Set TCP user timeout
+    OPT_UDP_GSO,           // Use UDP generic segmentation offload (Linux)
+                           // in SendToBatch for runs of equal-size packets.
   };
   virtual int GetOption(Option opt, int* value) = 0;
   virtual int SetOption(Option opt, int value) = 0;
@@ -235,6 +235,10 @@ class SSLStreamAdapter : public StreamInterface {
   // SS_OPENING but IsTlsConnected should return true.
   virtual bool IsTlsConnected() = 0;
 
+  // Returns true if the connection resumed an earlier session with the peer
+  // instead of running a full handshake.
+  virtual bool IsSessionResumed() const { return false; }
+
   // Capabilities testing.
   // Used to have "DTLS supported", "DTLS-SRTP supported" etc. methods, but now
   // that's assumed.
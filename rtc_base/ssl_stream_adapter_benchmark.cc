@@ -0,0 +1,169 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <string.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <utility>
+
+#include "api/array_view.h"
+#include "api/sequence_checker.h"
+#include "api/task_queue/pending_task_safety_flag.h"
+#include "benchmark/benchmark.h"
+#include "rtc_base/buffer.h"
+#include "rtc_base/message_digest.h"
+#include "rtc_base/ssl_identity.h"
+#include "rtc_base/ssl_stream_adapter.h"
+#include "rtc_base/stream.h"
+#include "rtc_base/thread.h"
+#include "test/field_trial.h"
+
+namespace rtc {
+namespace {
+
+// Upper bound on the message loop turns a handshake may take before the
+// benchmark gives up.
+constexpr int kMaxHandshakeTurns = 1000;
+
+// One end of an in-memory datagram pipe. Every Write() is delivered as one
+// datagram to the peer, which is signalled readable from the message loop.
+// Writes after the peer is gone, such as a closing alert, are dropped.
+class LoopbackStream : public StreamInterface {
+ public:
+  ~LoopbackStream() override {
+    if (peer_) {
+      peer_->peer_ = nullptr;
+    }
+  }
+
+  void set_peer(LoopbackStream* peer) { peer_ = peer; }
+
+  StreamState GetState() const override { return SS_OPEN; }
+
+  StreamResult Read(ArrayView<uint8_t> buffer,
+                    size_t& read,
+                    int& error) override {
+    if (datagrams_.empty()) {
+      return SR_BLOCK;
+    }
+    const Buffer& datagram = datagrams_.front();
+    read = std::min(buffer.size(), datagram.size());
+    memcpy(buffer.data(), datagram.data(), read);
+    datagrams_.pop_front();
+    return SR_SUCCESS;
+  }
+
+  StreamResult Write(ArrayView<const uint8_t> data,
+                     size_t& written,
+                     int& error) override {
+    if (peer_) {
+      peer_->Deliver(data);
+    }
+    written = data.size();
+    return SR_SUCCESS;
+  }
+
+  void Close() override {}
+
+ private:
+  void Deliver(ArrayView<const uint8_t> data) {
+    datagrams_.emplace_back(data.data(), data.size());
+    if (datagrams_.size() == 1) {
+      Thread::Current()->PostTask(
+          webrtc::SafeTask(task_safety_.flag(), [this] {
+            RTC_DCHECK_RUN_ON(&callback_sequence_);
+            FireEvent(SE_READ, 0);
+          }));
+    }
+  }
+
+  webrtc::ScopedTaskSafety task_safety_;
+  LoopbackStream* peer_ = nullptr;
+  std::deque<Buffer> datagrams_;
+};
+
+bool SetPeerDigest(SSLStreamAdapter& adapter, const SSLIdentity& peer) {
+  unsigned char digest[MessageDigest::kMaxSize];
+  size_t digest_len = 0;
+  return peer.certificate().ComputeDigest(DIGEST_SHA_256, digest,
+                                          sizeof(digest), &digest_len) &&
+         adapter.SetPeerCertificateDigest(DIGEST_SHA_256, digest, digest_len);
+}
+
+// Runs DTLS 1.2 handshakes between two OpenSSLStreamAdapters connected by an
+// in-memory pipe, with identities of the key type given by the first benchmark
+// argument. If the second argument is set, session resumption is enabled and
+// all handshakes but the first resume the previous session. Key generation is
+// done once up front and is not timed.
+void BM_DtlsHandshake(benchmark::State& state) {
+  const KeyParams key_params = state.range(0) == KT_RSA
+                                   ? KeyParams::RSA(2048)
+                                   : KeyParams::ECDSA(EC_NIST_P256);
+  webrtc::test::ScopedFieldTrials field_trials(
+      state.range(1) ? "WebRTC-DtlsSessionResumption/Enabled/" : "");
+  AutoThread main_thread;
+  std::unique_ptr<SSLIdentity> client_identity =
+      SSLIdentity::Create("client", key_params);
+  std::unique_ptr<SSLIdentity> server_identity =
+      SSLIdentity::Create("server", key_params);
+  if (!client_identity || !server_identity) {
+    state.SkipWithError("Failed to create identities.");
+    return;
+  }
+
+  for (auto _ : state) {
+    auto client_stream = std::make_unique<LoopbackStream>();
+    auto server_stream = std::make_unique<LoopbackStream>();
+    client_stream->set_peer(server_stream.get());
+    server_stream->set_peer(client_stream.get());
+    std::unique_ptr<SSLStreamAdapter> client =
+        SSLStreamAdapter::Create(std::move(client_stream));
+    std::unique_ptr<SSLStreamAdapter> server =
+        SSLStreamAdapter::Create(std::move(server_stream));
+
+    client->SetIdentity(client_identity->Clone());
+    server->SetIdentity(server_identity->Clone());
+    if (!SetPeerDigest(*client, *server_identity) ||
+        !SetPeerDigest(*server, *client_identity)) {
+      state.SkipWithError("Failed to set peer certificate digests.");
+      break;
+    }
+    client->SetMode(SSL_MODE_DTLS);
+    server->SetMode(SSL_MODE_DTLS);
+    server->SetServerRole();
+    if (server->StartSSL() != 0 || client->StartSSL() != 0) {
+      state.SkipWithError("Failed to start the handshake.");
+      break;
+    }
+
+    int turns = 0;
+    while ((client->GetState() != SS_OPEN || server->GetState() != SS_OPEN) &&
+           turns++ < kMaxHandshakeTurns) {
+      main_thread.ProcessMessages(0);
+    }
+    if (turns > kMaxHandshakeTurns) {
+      state.SkipWithError("Handshake did not complete.");
+      break;
+    }
+  }
+  state.counters["handshakes_per_second"] =
+      benchmark::Counter(state.iterations(), benchmark::Counter::kIsRate);
+}
+
+BENCHMARK(BM_DtlsHandshake)
+    ->ArgNames({"key", "resume"})
+    ->ArgsProduct({{KT_ECDSA, KT_RSA}, {0, 1}})
+    ->Unit(benchmark::kMicrosecond);
+
+}  // namespace
+}  // namespace rtc
@@ -1711,3 +1711,61 @@ TEST_F(SSLStreamAdapterTestDTLSExtensionPermutation,
   TestHandshake();
 }
 #endif  // OPENSSL_IS_BORINGSSL
+
+// Tests for resuming a DTLS session with a peer that was connected before.
+class SSLStreamAdapterTestDTLSResumption
+    : public SSLStreamAdapterTestDTLSBase {
+ public:
+  SSLStreamAdapterTestDTLSResumption()
+      : SSLStreamAdapterTestDTLSBase(rtc::KeyParams::ECDSA(rtc::EC_NIST_P256),
+                                     rtc::KeyParams::ECDSA(rtc::EC_NIST_P256)) {
+  }
+
+  void SetUp() override {
+    client_identity_ = rtc::SSLIdentity::Create("client", client_key_type_);
+    server_identity_ = rtc::SSLIdentity::Create("server", server_key_type_);
+  }
+
+  // Runs a new handshake between adapters using the same identities as the
+  // previous ones.
+  void Connect(absl::string_view experiment) {
+    InitializeClientAndServerStreams(experiment, experiment);
+    client_ssl_->SetIdentity(client_identity_->Clone());
+    server_ssl_->SetIdentity(server_identity_->Clone());
+    identities_set_ = false;
+    TestHandshake();
+  }
+
+ protected:
+  std::unique_ptr<rtc::SSLIdentity> client_identity_;
+  std::unique_ptr<rtc::SSLIdentity> server_identity_;
+};
+
+TEST_F(SSLStreamAdapterTestDTLSResumption, ResumesWhenEnabled) {
+  Connect("WebRTC-DtlsSessionResumption/Enabled/");
+  EXPECT_FALSE(client_ssl_->IsSessionResumed());
+  EXPECT_FALSE(server_ssl_->IsSessionResumed());
+
+  Connect("WebRTC-DtlsSessionResumption/Enabled/");
+  EXPECT_TRUE(client_ssl_->IsSessionResumed());
+  EXPECT_TRUE(server_ssl_->IsSessionResumed());
+  EXPECT_TRUE(client_ssl_->GetPeerSSLCertChain());
+  EXPECT_TRUE(server_ssl_->GetPeerSSLCertChain());
+  TestTransfer(100);
+}
+
+TEST_F(SSLStreamAdapterTestDTLSResumption, DoesNotResumeWhenDisabled) {
+  Connect("");
+  Connect("");
+  EXPECT_FALSE(client_ssl_->IsSessionResumed());
+  EXPECT_FALSE(server_ssl_->IsSessionResumed());
+}
+
+TEST_F(SSLStreamAdapterTestDTLSResumption, DoesNotResumeWithNewPeer) {
+  Connect("WebRTC-DtlsSessionResumption/Enabled/");
+  server_identity_ = rtc::SSLIdentity::Create("server", server_key_type_);
+
+  Connect("WebRTC-DtlsSessionResumption/Enabled/");
+  EXPECT_FALSE(client_ssl_->IsSessionResumed());
+  EXPECT_FALSE(server_ssl_->IsSessionResumed());
+}
@@ -0,0 +1,84 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_SYNCHRONIZATION_SEQ_LOCK_H_
+#define RTC_BASE_SYNCHRONIZATION_SEQ_LOCK_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <atomic>
+#include <type_traits>
+
+namespace webrtc {
+
+// Holds a value of type T that one writer stores and any number of readers
+// load, without the writer ever waiting for the readers. Readers retry while
+// a store is in progress, so stores should be short and not too frequent
+// compared to how long a load takes.
+//
+// Stores must not be made concurrently with each other, e.g. by making them
+// from a single thread or under a lock.
+template <typename T>
+class SeqLock {
+  static_assert(std::is_trivially_copyable_v<T>,
+                "SeqLock copies the value as bytes.");
+  static_assert(std::is_default_constructible_v<T>);
+
+ public:
+  SeqLock() : SeqLock(T()) {}
+  explicit SeqLock(const T& value) { Store(value); }
+
+  SeqLock(const SeqLock&) = delete;
+  SeqLock& operator=(const SeqLock&) = delete;
+
+  void Store(const T& value) {
+    uint64_t words[kNumWords] = {};
+    memcpy(words, &value, sizeof(T));
+    const uint32_t sequence = sequence_.load(std::memory_order_relaxed);
+    // An odd sequence number marks a store in progress.
+    sequence_.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (size_t i = 0; i < kNumWords; ++i) {
+      words_[i].store(words[i], std::memory_order_relaxed);
+    }
+    sequence_.store(sequence + 2, std::memory_order_release);
+  }
+
+  T Load() const {
+    uint64_t words[kNumWords];
+    uint32_t sequence_before;
+    uint32_t sequence_after;
+    do {
+      sequence_before = sequence_.load(std::memory_order_acquire);
+      for (size_t i = 0; i < kNumWords; ++i) {
+        words[i] = words_[i].load(std::memory_order_relaxed);
+      }
+      std::atomic_thread_fence(std::memory_order_acquire);
+      sequence_after = sequence_.load(std::memory_order_relaxed);
+    } while (sequence_before != sequence_after || (sequence_before & 1) != 0);
+    T value;
+    memcpy(&value, words, sizeof(T));
+    return value;
+  }
+
+ private:
+  static constexpr size_t kNumWords =
+      (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+  std::atomic<uint32_t> sequence_{0};
+  // The value is kept in atomic words, as it is read while being written.
+  std::atomic<uint64_t> words_[kNumWords];
+};
+
+}  // namespace webrtc
+
+#endif  // RTC_BASE_SYNCHRONIZATION_SEQ_LOCK_H_
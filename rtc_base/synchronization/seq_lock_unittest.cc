@@ -0,0 +1,75 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/synchronization/seq_lock.h"
+
+#include <stdint.h>
+
+#include <atomic>
+
+#include "rtc_base/platform_thread.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+struct Value {
+  int64_t a = 0;
+  int64_t b = 0;
+  int32_t c = 0;
+};
+
+TEST(SeqLockTest, LoadsDefaultValue) {
+  SeqLock<Value> seq_lock;
+  Value value = seq_lock.Load();
+  EXPECT_EQ(value.a, 0);
+  EXPECT_EQ(value.b, 0);
+  EXPECT_EQ(value.c, 0);
+}
+
+TEST(SeqLockTest, LoadsStoredValue) {
+  SeqLock<Value> seq_lock(Value{1, 2, 3});
+  EXPECT_EQ(seq_lock.Load().c, 3);
+
+  seq_lock.Store(Value{4, 5, 6});
+  Value value = seq_lock.Load();
+  EXPECT_EQ(value.a, 4);
+  EXPECT_EQ(value.b, 5);
+  EXPECT_EQ(value.c, 6);
+}
+
+TEST(SeqLockTest, LoadsConsistentValuesWhileStoring) {
+  constexpr int kNumStores = 100000;
+  SeqLock<Value> seq_lock;
+  std::atomic<bool> done(false);
+  auto writer = rtc::PlatformThread::SpawnJoinable(
+      [&] {
+        for (int i = 1; i <= kNumStores; ++i) {
+          seq_lock.Store(Value{i, -i, i});
+        }
+        done.store(true);
+      },
+      "SeqLockWriter");
+
+  int64_t last_a = 0;
+  bool consistent = true;
+  while (!done.load()) {
+    Value value = seq_lock.Load();
+    consistent &= value.b == -value.a && value.c == value.a;
+    consistent &= value.a >= last_a;
+    last_a = value.a;
+  }
+  writer.Finalize();
+  EXPECT_TRUE(consistent);
+  EXPECT_EQ(seq_lock.Load().a, kNumStores);
+}
+
+}  // namespace
+}  // namespace webrtc
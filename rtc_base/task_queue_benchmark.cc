@@ -0,0 +1,118 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "api/task_queue/task_queue_base.h"
+#include "api/task_queue/task_queue_factory.h"
+#include "benchmark/benchmark.h"
+#include "rtc_base/event.h"
+#include "rtc_base/platform_thread.h"
+#include "rtc_base/task_queue_mpsc.h"
+#include "rtc_base/task_queue_stdlib.h"
+#if defined(WEBRTC_TASK_QUEUE_BENCHMARK_LIBEVENT)
+#include "rtc_base/task_queue_libevent.h"
+#endif
+
+namespace webrtc {
+namespace {
+
+// Number of tasks posted per benchmark iteration, split between the
+// producer threads.
+constexpr int kTasksPerIteration = 10000;
+
+enum TaskQueueImplementation { kStdlib, kMpsc, kLibevent };
+
+std::unique_ptr<TaskQueueFactory> CreateFactory(int implementation) {
+  switch (implementation) {
+    case kStdlib:
+      return CreateTaskQueueStdlibFactory();
+    case kMpsc:
+      return CreateTaskQueueMpscFactory();
+#if defined(WEBRTC_TASK_QUEUE_BENCHMARK_LIBEVENT)
+    case kLibevent:
+      return CreateTaskQueueLibeventFactory();
+#endif
+  }
+  return nullptr;
+}
+
+// Measures the time from posting a task to an idle queue until it has run and
+// the poster has been woken up, i.e. one round trip through the queue.
+void BM_TaskQueuePostLatency(benchmark::State& state) {
+  std::unique_ptr<TaskQueueFactory> factory = CreateFactory(state.range(0));
+  auto queue =
+      factory->CreateTaskQueue("Latency", TaskQueueFactory::Priority::NORMAL);
+  rtc::Event done;
+  for (auto _ : state) {
+    queue->PostTask([&done] { done.Set(); });
+    done.Wait(rtc::Event::kForever);
+  }
+}
+
+// Posts `kTasksPerIteration` empty tasks from a number of producer threads
+// given by the second benchmark argument, and waits for all of them to run.
+void BM_TaskQueuePostThroughput(benchmark::State& state) {
+  std::unique_ptr<TaskQueueFactory> factory = CreateFactory(state.range(0));
+  const int num_producers = state.range(1);
+  auto queue = factory->CreateTaskQueue("Throughput",
+                                        TaskQueueFactory::Priority::NORMAL);
+  std::atomic<int> remaining(0);
+  rtc::Event done;
+  auto task = [&remaining, &done] {
+    if (remaining.fetch_sub(1, std::memory_order_relaxed) == 1) {
+      done.Set();
+    }
+  };
+
+  for (auto _ : state) {
+    remaining.store(kTasksPerIteration, std::memory_order_relaxed);
+    std::vector<rtc::PlatformThread> producers;
+    for (int i = 0; i < num_producers; ++i) {
+      const int count = kTasksPerIteration / num_producers +
+                        (i < kTasksPerIteration % num_producers ? 1 : 0);
+      producers.push_back(rtc::PlatformThread::SpawnJoinable(
+          [&queue, &task, count] {
+            for (int j = 0; j < count; ++j) {
+              queue->PostTask(task);
+            }
+          },
+          "Producer"));
+    }
+    done.Wait(rtc::Event::kForever);
+    producers.clear();
+  }
+  state.SetItemsProcessed(state.iterations() * kTasksPerIteration);
+}
+
+std::vector<int64_t> Implementations() {
+  std::vector<int64_t> implementations = {kStdlib, kMpsc};
+#if defined(WEBRTC_TASK_QUEUE_BENCHMARK_LIBEVENT)
+  implementations.push_back(kLibevent);
+#endif
+  return implementations;
+}
+
+BENCHMARK(BM_TaskQueuePostLatency)
+    ->ArgName("impl")
+    ->ArgsProduct({Implementations()})
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK(BM_TaskQueuePostThroughput)
+    ->ArgNames({"impl", "producers"})
+    ->ArgsProduct({Implementations(), {1, 2, 4, 8}})
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+}  // namespace
+}  // namespace webrtc
@@ -0,0 +1,324 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/task_queue_mpsc.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "absl/functional/any_invocable.h"
+#include "absl/strings/string_view.h"
+#include "api/task_queue/task_queue_base.h"
+#include "api/units/time_delta.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/event.h"
+#include "rtc_base/numerics/divide_round.h"
+#include "rtc_base/platform_thread.h"
+#include "rtc_base/time_utils.h"
+
+namespace webrtc {
+namespace {
+
+rtc::ThreadPriority TaskQueuePriorityToThreadPriority(
+    TaskQueueFactory::Priority priority) {
+  switch (priority) {
+    case TaskQueueFactory::Priority::HIGH:
+      return rtc::ThreadPriority::kRealtime;
+    case TaskQueueFactory::Priority::LOW:
+      return rtc::ThreadPriority::kLow;
+    case TaskQueueFactory::Priority::NORMAL:
+      return rtc::ThreadPriority::kNormal;
+  }
+}
+
+// A posted task, linked into the incoming list of a TaskQueueMpsc.
+struct TaskNode {
+  std::atomic<TaskNode*> next{nullptr};
+  absl::AnyInvocable<void() &&> task;
+  // When the task should run, or 0 for tasks to run right away.
+  // TODO(bugs.webrtc.org/13756): Migrate to Timestamp.
+  int64_t fire_at_us = 0;
+  // Breaks ties between delayed tasks due at the same time, in FIFO order.
+  uint64_t order = 0;
+};
+
+// Intrusive multi-producer single-consumer FIFO list, after Dmitry Vyukov's
+// non-blocking MPSC node-based queue. Push() is wait-free. Pop() may only be
+// called from one thread, and may return null while a Push() that has not
+// completed yet is the only one ahead of it; the caller sees that push once it
+// completes.
+class MpscTaskList {
+ public:
+  MpscTaskList() : head_(&stub_), tail_(&stub_) {}
+
+  MpscTaskList(const MpscTaskList&) = delete;
+  MpscTaskList& operator=(const MpscTaskList&) = delete;
+
+  void Push(TaskNode* node) {
+    node->next.store(nullptr, std::memory_order_relaxed);
+    TaskNode* prev = head_.exchange(node, std::memory_order_acq_rel);
+    prev->next.store(node, std::memory_order_release);
+  }
+
+  TaskNode* Pop() {
+    TaskNode* tail = tail_;
+    TaskNode* next = tail->next.load(std::memory_order_acquire);
+    if (tail == &stub_) {
+      if (next == nullptr) {
+        return nullptr;
+      }
+      tail_ = next;
+      tail = next;
+      next = next->next.load(std::memory_order_acquire);
+    }
+    if (next != nullptr) {
+      tail_ = next;
+      return tail;
+    }
+    if (tail != head_.load(std::memory_order_acquire)) {
+      // A producer has swapped the head but not linked its node yet.
+      return nullptr;
+    }
+    // `tail` is the last node. Put the stub behind it so it can be unlinked.
+    Push(&stub_);
+    next = tail->next.load(std::memory_order_acquire);
+    if (next != nullptr) {
+      tail_ = next;
+      return tail;
+    }
+    return nullptr;
+  }
+
+ private:
+  // Producers append behind `head_`; the consumer takes from `tail_`.
+  std::atomic<TaskNode*> head_;
+  TaskNode* tail_;
+  TaskNode stub_;
+};
+
+class TaskQueueMpsc final : public TaskQueueBase {
+ public:
+  TaskQueueMpsc(absl::string_view queue_name, rtc::ThreadPriority priority);
+  ~TaskQueueMpsc() override = default;
+
+  void Delete() override;
+
+ protected:
+  void PostTaskImpl(absl::AnyInvocable<void() &&> task,
+                    const PostTaskTraits& traits,
+                    const Location& location) override;
+  void PostDelayedTaskImpl(absl::AnyInvocable<void() &&> task,
+                           TimeDelta delay,
+                           const PostDelayedTaskTraits& traits,
+                           const Location& location) override;
+
+ private:
+  // Orders the delayed task heap so that the earliest task is at the front.
+  struct FiresLater {
+    bool operator()(const TaskNode* a, const TaskNode* b) const {
+      return std::tie(a->fire_at_us, a->order) >
+             std::tie(b->fire_at_us, b->order);
+    }
+  };
+
+  static rtc::PlatformThread InitializeThread(TaskQueueMpsc* me,
+                                              absl::string_view queue_name,
+                                              rtc::ThreadPriority priority);
+
+  void Enqueue(std::unique_ptr<TaskNode> node);
+
+  void ProcessTasks();
+
+  // Takes incoming tasks until an immediate one, which is kept in
+  // `next_task_`. Delayed tasks taken on the way go to `delayed_tasks_`.
+  // Returns true if any task was taken.
+  bool TakeIncomingTasks();
+
+  // Signaled when a task is posted while the thread is waiting, and on
+  // deletion.
+  rtc::Event flag_notify_;
+
+  // Set by the thread before it waits on `flag_notify_`, and cleared by the
+  // first producer to post afterwards, which then signals the event.
+  std::atomic<bool> waiting_{false};
+
+  // Indicates if the worker thread needs to shutdown now.
+  std::atomic<bool> thread_should_quit_{false};
+
+  // Tasks posted from any thread, in posting order.
+  MpscTaskList incoming_;
+
+  // The following are only accessed on the worker thread.
+
+  // The oldest immediate task taken from `incoming_`.
+  std::unique_ptr<TaskNode> next_task_;
+
+  // Min-heap of delayed tasks that have been taken from `incoming_`, by time
+  // and then posting order.
+  std::vector<TaskNode*> delayed_tasks_;
+  uint64_t next_delayed_order_ = 0;
+
+  // Contains the active worker thread assigned to processing
+  // tasks (including delayed tasks).
+  // Placing this last ensures the thread doesn't touch uninitialized attributes
+  // throughout it's lifetime.
+  rtc::PlatformThread thread_;
+};
+
+TaskQueueMpsc::TaskQueueMpsc(absl::string_view queue_name,
+                             rtc::ThreadPriority priority)
+    : flag_notify_(/*manual_reset=*/false, /*initially_signaled=*/false),
+      thread_(InitializeThread(this, queue_name, priority)) {}
+
+// static
+rtc::PlatformThread TaskQueueMpsc::InitializeThread(
+    TaskQueueMpsc* me,
+    absl::string_view queue_name,
+    rtc::ThreadPriority priority) {
+  rtc::Event started;
+  auto thread = rtc::PlatformThread::SpawnJoinable(
+      [&started, me] {
+        CurrentTaskQueueSetter set_current(me);
+        started.Set();
+        me->ProcessTasks();
+      },
+      queue_name, rtc::ThreadAttributes().SetPriority(priority));
+  started.Wait(rtc::Event::kForever);
+  return thread;
+}
+
+void TaskQueueMpsc::Delete() {
+  RTC_DCHECK(!IsCurrent());
+
+  thread_should_quit_.store(true, std::memory_order_release);
+  flag_notify_.Set();
+
+  delete this;
+}
+
+void TaskQueueMpsc::PostTaskImpl(absl::AnyInvocable<void() &&> task,
+                                 const PostTaskTraits& traits,
+                                 const Location& location) {
+  auto node = std::make_unique<TaskNode>();
+  node->task = std::move(task);
+  Enqueue(std::move(node));
+}
+
+void TaskQueueMpsc::PostDelayedTaskImpl(absl::AnyInvocable<void() &&> task,
+                                        TimeDelta delay,
+                                        const PostDelayedTaskTraits& traits,
+                                        const Location& location) {
+  auto node = std::make_unique<TaskNode>();
+  node->task = std::move(task);
+  // Never 0, which marks immediate tasks.
+  node->fire_at_us = std::max<int64_t>(rtc::TimeMicros() + delay.us(), 1);
+  Enqueue(std::move(node));
+}
+
+void TaskQueueMpsc::Enqueue(std::unique_ptr<TaskNode> node) {
+  incoming_.Push(node.release());
+  // The exchange is ordered after the push, so a thread that sets `waiting_`
+  // before looking at `incoming_` either sees the task or gets signaled.
+  if (waiting_.exchange(false, std::memory_order_seq_cst)) {
+    flag_notify_.Set();
+  }
+}
+
+bool TaskQueueMpsc::TakeIncomingTasks() {
+  bool took_task = false;
+  while (!next_task_) {
+    TaskNode* node = incoming_.Pop();
+    if (!node) {
+      break;
+    }
+    took_task = true;
+    if (node->fire_at_us == 0) {
+      next_task_.reset(node);
+    } else {
+      node->order = next_delayed_order_++;
+      delayed_tasks_.push_back(node);
+      std::push_heap(delayed_tasks_.begin(), delayed_tasks_.end(),
+                     FiresLater());
+    }
+  }
+  return took_task;
+}
+
+void TaskQueueMpsc::ProcessTasks() {
+  while (!thread_should_quit_.load(std::memory_order_acquire)) {
+    TakeIncomingTasks();
+
+    TimeDelta sleep_time = rtc::Event::kForever;
+    if (!delayed_tasks_.empty()) {
+      // The delayed tasks were all posted before `next_task_`, so a due one
+      // runs first.
+      const int64_t tick_us = rtc::TimeMicros();
+      const int64_t fire_at_us = delayed_tasks_.front()->fire_at_us;
+      if (tick_us >= fire_at_us) {
+        std::pop_heap(delayed_tasks_.begin(), delayed_tasks_.end(),
+                      FiresLater());
+        std::unique_ptr<TaskNode> node(delayed_tasks_.back());
+        delayed_tasks_.pop_back();
+        std::move(node->task)();
+        continue;
+      }
+      sleep_time =
+          TimeDelta::Millis(DivideRoundUp(fire_at_us - tick_us, 1'000));
+    }
+
+    if (next_task_) {
+      std::unique_ptr<TaskNode> node = std::move(next_task_);
+      std::move(node->task)();
+      continue;
+    }
+
+    // Announce that the thread is about to wait, then look again so that a
+    // task posted in between is not missed.
+    waiting_.exchange(true, std::memory_order_seq_cst);
+    if (!TakeIncomingTasks()) {
+      flag_notify_.Wait(sleep_time);
+    }
+    waiting_.store(false, std::memory_order_relaxed);
+  }
+
+  // Ensure remaining deleted tasks are destroyed with Current() set up to this
+  // task queue.
+  next_task_ = nullptr;
+  while (TaskNode* node = incoming_.Pop()) {
+    delete node;
+  }
+  for (TaskNode* node : delayed_tasks_) {
+    delete node;
+  }
+  delayed_tasks_.clear();
+}
+
+class TaskQueueMpscFactory final : public TaskQueueFactory {
+ public:
+  std::unique_ptr<TaskQueueBase, TaskQueueDeleter> CreateTaskQueue(
+      absl::string_view name,
+      Priority priority) const override {
+    return std::unique_ptr<TaskQueueBase, TaskQueueDeleter>(
+        new TaskQueueMpsc(name, TaskQueuePriorityToThreadPriority(priority)));
+  }
+};
+
+}  // namespace
+
+std::unique_ptr<TaskQueueFactory> CreateTaskQueueMpscFactory() {
+  return std::make_unique<TaskQueueMpscFactory>();
+}
+
+}  // namespace webrtc
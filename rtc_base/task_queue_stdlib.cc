@@ -16,12 +16,15 @@
 #include <map>
 #include <memory>
 #include <queue>
+#include <tuple>
 #include <utility>
 
 #include "absl/functional/any_invocable.h"
 #include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
 #include "api/task_queue/task_queue_base.h"
 #include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/event.h"
 #include "rtc_base/logging.h"
@@ -30,10 +33,15 @@
 #include "rtc_base/synchronization/mutex.h"
 #include "rtc_base/thread_annotations.h"
 #include "rtc_base/time_utils.h"
+#include "rtc_base/timer_wheel.h"
 
 namespace webrtc {
 namespace {
 
+// Delayed tasks without high precision may run up to this much later than
+// requested. The worker thread sleeps in whole milliseconds anyway.
+constexpr TimeDelta kDelayedTaskResolution = TimeDelta::Millis(1);
+
 rtc::ThreadPriority TaskQueuePriorityToThreadPriority(
     TaskQueueFactory::Priority priority) {
   switch (priority) {
@@ -109,13 +117,19 @@ class TaskQueueStdlib final : public TaskQueueBase {
   std::queue<std::pair<OrderId, absl::AnyInvocable<void() &&>>> pending_queue_
       RTC_GUARDED_BY(pending_lock_);
 
-  // The list of all pending tasks that need to be processed at a future
-  // time based upon a delay. On the off change the delayed task should
+  // The list of all high precision tasks that need to be processed at a
+  // future time based upon a delay. On the off change the delayed task should
   // happen at exactly the same time interval as another task then the
   // task is processed based on FIFO ordering. std::priority_queue was
   // considered but rejected due to its inability to extract the
   // move-only value out of the queue without the presence of a hack.
-  std::map<DelayedEntryTimeout, absl::AnyInvocable<void() &&>> delayed_queue_
+  std::map<DelayedEntryTimeout, absl::AnyInvocable<void() &&>>
+      high_precision_delayed_queue_ RTC_GUARDED_BY(pending_lock_);
+
+  // The other delayed tasks, which may run up to kDelayedTaskResolution late.
+  // A timer wheel keeps inserting and taking out tasks O(1) with many timers
+  // pending.
+  TimerWheel<std::pair<OrderId, absl::AnyInvocable<void() &&>>> delayed_queue_
       RTC_GUARDED_BY(pending_lock_);
 
   // Contains the active worker thread assigned to processing
@@ -128,6 +142,8 @@ class TaskQueueStdlib final : public TaskQueueBase {
 TaskQueueStdlib::TaskQueueStdlib(absl::string_view queue_name,
                                  rtc::ThreadPriority priority)
     : flag_notify_(/*manual_reset=*/false, /*initially_signaled=*/false),
+      delayed_queue_(kDelayedTaskResolution,
+                     Timestamp::Micros(rtc::TimeMicros())),
       thread_(InitializeThread(this, queue_name, priority)) {}
 
 // static
@@ -176,13 +192,19 @@ void TaskQueueStdlib::PostDelayedTaskImpl(absl::AnyInvocable<void() &&> task,
                                           TimeDelta delay,
                                           const PostDelayedTaskTraits& traits,
                                           const Location& location) {
-  DelayedEntryTimeout delayed_entry;
-  delayed_entry.next_fire_at_us = rtc::TimeMicros() + delay.us();
+  const Timestamp fire_at = Timestamp::Micros(rtc::TimeMicros()) + delay;
 
   {
     MutexLock lock(&pending_lock_);
-    delayed_entry.order = ++thread_posting_order_;
-    delayed_queue_[delayed_entry] = std::move(task);
+    if (traits.high_precision) {
+      DelayedEntryTimeout delayed_entry;
+      delayed_entry.next_fire_at_us = fire_at.us();
+      delayed_entry.order = ++thread_posting_order_;
+      high_precision_delayed_queue_[delayed_entry] = std::move(task);
+    } else {
+      delayed_queue_.Schedule(
+          fire_at, std::make_pair(++thread_posting_order_, std::move(task)));
+    }
   }
 
   NotifyWake();
@@ -191,7 +213,7 @@ void TaskQueueStdlib::PostDelayedTaskImpl(absl::AnyInvocable<void() &&> task,
 TaskQueueStdlib::NextTask TaskQueueStdlib::GetNextTask() {
   NextTask result;
 
-  const int64_t tick_us = rtc::TimeMicros();
+  const Timestamp tick = Timestamp::Micros(rtc::TimeMicros());
 
   MutexLock lock(&pending_lock_);
 
@@ -200,29 +222,52 @@ TaskQueueStdlib::NextTask TaskQueueStdlib::GetNextTask() {
     return result;
   }
 
-  if (delayed_queue_.size() > 0) {
-    auto delayed_entry = delayed_queue_.begin();
-    const auto& delay_info = delayed_entry->first;
-    auto& delay_run = delayed_entry->second;
-    if (tick_us >= delay_info.next_fire_at_us) {
-      if (pending_queue_.size() > 0) {
-        auto& entry = pending_queue_.front();
-        auto& entry_order = entry.first;
-        auto& entry_run = entry.second;
-        if (entry_order < delay_info.order) {
-          result.run_task = std::move(entry_run);
-          pending_queue_.pop();
-          return result;
-        }
+  // Of the delayed tasks that are due, the one posted first runs first.
+  auto high_precision_entry = high_precision_delayed_queue_.begin();
+  const bool high_precision_due =
+      high_precision_entry != high_precision_delayed_queue_.end() &&
+      tick.us() >= high_precision_entry->first.next_fire_at_us;
+  auto* delayed_entry = delayed_queue_.Front(tick);
+  if (high_precision_due &&
+      (!delayed_entry ||
+       high_precision_entry->first.order < delayed_entry->first)) {
+    delayed_entry = nullptr;
+  }
+  if (high_precision_due || delayed_entry) {
+    const OrderId delayed_order = delayed_entry
+                                      ? delayed_entry->first
+                                      : high_precision_entry->first.order;
+    if (pending_queue_.size() > 0) {
+      auto& entry = pending_queue_.front();
+      auto& entry_order = entry.first;
+      auto& entry_run = entry.second;
+      if (entry_order < delayed_order) {
+        result.run_task = std::move(entry_run);
+        pending_queue_.pop();
+        return result;
       }
+    }
 
-      result.run_task = std::move(delay_run);
-      delayed_queue_.erase(delayed_entry);
-      return result;
+    if (delayed_entry) {
+      result.run_task = std::move(delayed_queue_.PopFront().second);
+    } else {
+      result.run_task = std::move(high_precision_entry->second);
+      high_precision_delayed_queue_.erase(high_precision_entry);
     }
+    return result;
+  }
 
+  absl::optional<Timestamp> next_fire_at = delayed_queue_.NextDueTime();
+  if (high_precision_entry != high_precision_delayed_queue_.end()) {
+    const Timestamp high_precision_fire_at =
+        Timestamp::Micros(high_precision_entry->first.next_fire_at_us);
+    next_fire_at = next_fire_at
+                       ? std::min(*next_fire_at, high_precision_fire_at)
+                       : high_precision_fire_at;
+  }
+  if (next_fire_at) {
     result.sleep_time = TimeDelta::Millis(
-        DivideRoundUp(delay_info.next_fire_at_us - tick_us, 1'000));
+        DivideRoundUp((*next_fire_at - tick).us(), 1'000));
   }
 
   if (pending_queue_.size() > 0) {
@@ -11,6 +11,10 @@
 #include "rtc_base/task_queue_stdlib.h"
 
 #include "api/task_queue/task_queue_test.h"
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "rtc_base/event.h"
+#include "rtc_base/fake_clock.h"
 #include "test/gtest.h"
 
 namespace webrtc {
@@ -25,5 +29,21 @@ INSTANTIATE_TEST_SUITE_P(TaskQueueStdlib,
                          TaskQueueTest,
                          ::testing::Values(CreateTaskQueueFactory));
 
+TEST(TaskQueueStdlibTest, RunsHighPrecisionTaskAtItsDeadline) {
+  rtc::ScopedBaseFakeClock clock;
+  clock.SetTime(Timestamp::Seconds(1));
+  auto queue = CreateTaskQueueStdlibFactory()->CreateTaskQueue(
+      "test", TaskQueueFactory::Priority::NORMAL);
+  // A deadline within a millisecond, which a low precision task may miss.
+  const TimeDelta kDelay = TimeDelta::Micros(2'500);
+  rtc::Event done;
+  queue->PostDelayedHighPrecisionTask([&done] { done.Set(); }, kDelay);
+
+  clock.AdvanceTime(kDelay - TimeDelta::Micros(1));
+  EXPECT_FALSE(done.Wait(TimeDelta::Millis(20)));
+  clock.AdvanceTime(TimeDelta::Micros(1));
+  EXPECT_TRUE(done.Wait(TimeDelta::Seconds(5)));
+}
+
 }  // namespace
 }  // namespace webrtc
@@ -13,6 +13,7 @@
 #include "absl/strings/string_view.h"
 #include "api/task_queue/task_queue_base.h"
 #include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
 #include "rtc_base/socket_server.h"
 
 #if defined(WEBRTC_WIN)
@@ -35,6 +36,7 @@
 
 #include "absl/algorithm/container.h"
 #include "absl/cleanup/cleanup.h"
+#include "absl/types/optional.h"
 #include "api/sequence_checker.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/event.h"
@@ -316,7 +318,8 @@ Thread::Thread(std::unique_ptr<SocketServer> ss)
     : Thread(std::move(ss), /*do_init=*/true) {}
 
 Thread::Thread(SocketServer* ss, bool do_init)
-    : delayed_next_num_(0),
+    : delayed_messages_(webrtc::TimeDelta::Millis(1),
+                        webrtc::Timestamp::Millis(TimeMillis())),
       fInitialized_(false),
       fDestroyed_(false),
       stop_(0),
@@ -364,7 +367,7 @@ void Thread::DoDestroy() {
   // Clear.
   CurrentTaskQueueSetter set_current(this);
   messages_ = {};
-  delayed_messages_ = {};
+  delayed_messages_.Clear();
 }
 
 SocketServer* Thread::socketserver() {
@@ -404,14 +407,13 @@ absl::AnyInvocable<void() &&> Thread::Get(int cmsWait) {
       MutexLock lock(&mutex_);
       // Check for delayed messages that have been triggered and calculate the
       // next trigger time.
-      while (!delayed_messages_.empty()) {
-        if (msCurrent < delayed_messages_.top().run_time_ms) {
-          cmsDelayNext =
-              TimeDiff(delayed_messages_.top().run_time_ms, msCurrent);
-          break;
-        }
-        messages_.push(std::move(delayed_messages_.top().functor));
-        delayed_messages_.pop();
+      const webrtc::Timestamp now = webrtc::Timestamp::Millis(msCurrent);
+      while (delayed_messages_.Front(now)) {
+        messages_.push(delayed_messages_.PopFront());
+      }
+      if (absl::optional<webrtc::Timestamp> next_run_time =
+              delayed_messages_.NextDueTime()) {
+        cmsDelayNext = (*next_run_time - now).ms();
       }
       // Pull a message off the message queue, if available.
       if (!messages_.empty()) {
@@ -489,15 +491,8 @@ void Thread::PostDelayedTaskImpl(absl::AnyInvocable<void() &&> task,
   int64_t run_time_ms = TimeAfter(delay_ms);
   {
     MutexLock lock(&mutex_);
-    delayed_messages_.push({.delay_ms = delay_ms,
-                            .run_time_ms = run_time_ms,
-                            .message_number = delayed_next_num_,
-                            .functor = std::move(task)});
-    // If this message queue processes 1 message every millisecond for 50 days,
-    // we will wrap this number.  Even then, only messages with identical times
-    // will be misordered, and then only briefly.  This is probably ok.
-    ++delayed_next_num_;
-    RTC_DCHECK_NE(0, delayed_next_num_);
+    delayed_messages_.Schedule(webrtc::Timestamp::Millis(run_time_ms),
+                               std::move(task));
   }
   WakeUpSocketServer();
 }
@@ -508,8 +503,9 @@ int Thread::GetDelay() {
   if (!messages_.empty())
     return 0;
 
-  if (!delayed_messages_.empty()) {
-    int delay = TimeUntil(delayed_messages_.top().run_time_ms);
+  if (absl::optional<webrtc::Timestamp> next_run_time =
+          delayed_messages_.NextDueTime()) {
+    int delay = TimeUntil(next_run_time->ms());
     if (delay < 0)
       delay = 0;
     return delay;
@@ -40,6 +40,7 @@
 #include "rtc_base/synchronization/mutex.h"
 #include "rtc_base/system/rtc_export.h"
 #include "rtc_base/thread_annotations.h"
+#include "rtc_base/timer_wheel.h"
 
 #if defined(WEBRTC_WIN)
 #include "rtc_base/win32.h"
@@ -394,26 +395,6 @@ class RTC_LOCKABLE RTC_EXPORT Thread : public webrtc::TaskQueueBase {
     rtc::Thread* const previous_;
   };
 
-  // DelayedMessage goes into a priority queue, sorted by trigger time. Messages
-  // with the same trigger time are processed in num_ (FIFO) order.
-  struct DelayedMessage {
-    bool operator<(const DelayedMessage& dmsg) const {
-      return (dmsg.run_time_ms < run_time_ms) ||
-             ((dmsg.run_time_ms == run_time_ms) &&
-              (dmsg.message_number < message_number));
-    }
-
-    int64_t delay_ms;  // for debugging
-    int64_t run_time_ms;
-    // Monotonicaly incrementing number used for ordering of messages
-    // targeted to execute at the same time.
-    uint32_t message_number;
-    // std::priority_queue doesn't allow to extract elements, but functor
-    // is move-only and thus need to be changed when pulled out of the
-    // priority queue. That is ok because `functor` doesn't affect operator<
-    mutable absl::AnyInvocable<void() &&> functor;
-  };
-
   // TaskQueueBase implementation.
   void PostTaskImpl(absl::AnyInvocable<void() &&> task,
                     const PostTaskTraits& traits,
@@ -486,8 +467,10 @@ class RTC_LOCKABLE RTC_EXPORT Thread : public webrtc::TaskQueueBase {
   void ClearCurrentTaskQueue();
 
   std::queue<absl::AnyInvocable<void() &&>> messages_ RTC_GUARDED_BY(mutex_);
-  std::priority_queue<DelayedMessage> delayed_messages_ RTC_GUARDED_BY(mutex_);
-  uint32_t delayed_next_num_ RTC_GUARDED_BY(mutex_);
+  // Delayed messages by trigger time. Messages with the same trigger time are
+  // processed in FIFO order.
+  webrtc::TimerWheel<absl::AnyInvocable<void() &&>> delayed_messages_
+      RTC_GUARDED_BY(mutex_);
 #if RTC_DCHECK_IS_ON
   uint32_t blocking_call_count_ RTC_GUARDED_BY(this) = 0;
   uint32_t could_be_blocking_call_count_ RTC_GUARDED_BY(this) = 0;
@@ -0,0 +1,418 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_TIMER_WHEEL_H_
+#define RTC_BASE_TIMER_WHEEL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <array>
+#include <utility>
+#include <vector>
+
+#include "absl/numeric/bits.h"
+#include "absl/types/optional.h"
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+// A hierarchical timer wheel holding values of type T that become due at given
+// times. Scheduling and cancelling a timer are O(1); expired timers are handed
+// out in order of their due time, and timers due at the same time in the order
+// they were scheduled.
+//
+// Time is divided into ticks of `resolution`, which is the slack of the wheel:
+// a timer is never reported before its due time, but may be reported up to one
+// tick after it. The wheel has five levels of 64 slots, covering 2^30 ticks
+// (12 days with a 1 ms resolution). Timers further away are parked in the
+// outermost level and moved inwards as time passes. If time goes backwards,
+// the wheel is rebuilt around the new time.
+//
+// T must be default constructible and movable. This class is not thread safe.
+template <typename T>
+class TimerWheel {
+ public:
+  // Identifies a scheduled timer. Ids are not reused while the wheel exists,
+  // apart from after 2^32 reuses of the same storage slot.
+  using TimerId = uint64_t;
+  static constexpr TimerId kInvalidTimerId = 0;
+
+  TimerWheel(TimeDelta resolution, Timestamp start)
+      : resolution_us_(resolution.us()), origin_(start) {
+    RTC_DCHECK_GT(resolution_us_, 0);
+    lists_.fill(List());
+  }
+
+  TimerWheel(const TimerWheel&) = delete;
+  TimerWheel& operator=(const TimerWheel&) = delete;
+
+  // Schedules `value` to become due at `due`, which must be finite.
+  TimerId Schedule(Timestamp due, T value) {
+    RTC_DCHECK(due.IsFinite());
+    const int32_t index = Allocate();
+    Entry& entry = entries_[index];
+    entry.due = due;
+    entry.sequence = next_sequence_++;
+    entry.value = std::move(value);
+    Place(index);
+    ++size_;
+    return MakeId(index, entry.generation);
+  }
+
+  // Cancels a scheduled timer, destroying its value. Returns false if the
+  // timer has already been popped or cancelled.
+  bool Cancel(TimerId id) {
+    const uint32_t index = static_cast<uint32_t>(id);
+    if (id == kInvalidTimerId || index >= entries_.size()) {
+      return false;
+    }
+    Entry& entry = entries_[index];
+    if (entry.list == kFree || entry.generation != (id >> 32)) {
+      return false;
+    }
+    Unlink(index);
+    Release(index);
+    --size_;
+    return true;
+  }
+
+  // Returns the earliest timer that is due at `now`, or null if there is none.
+  // The returned value stays valid until the wheel is next modified.
+  T* Front(Timestamp now) {
+    AdvanceTo(now);
+    const int32_t index = lists_[kReadyList].head;
+    return index == kNone ? nullptr : &entries_[index].value;
+  }
+
+  // Removes and returns the timer that Front() returned. There must be one.
+  T PopFront() {
+    const int32_t index = lists_[kReadyList].head;
+    RTC_DCHECK_NE(index, kNone);
+    T value = std::move(entries_[index].value);
+    Unlink(index);
+    Release(index);
+    --size_;
+    return value;
+  }
+
+  // Returns a time at which the next timer may become due. Waking up at this
+  // time is enough to not miss any timer, but the timer may be later; call
+  // Front() and NextDueTime() again then. Returns nullopt if the wheel is
+  // empty.
+  absl::optional<Timestamp> NextDueTime() const {
+    if (size_ == 0) {
+      return absl::nullopt;
+    }
+    if (lists_[kReadyList].head != kNone) {
+      return entries_[lists_[kReadyList].head].due;
+    }
+    return TickTime(NextEventTick());
+  }
+
+  // Cancels all timers.
+  void Clear() {
+    for (int32_t index = 0; index < static_cast<int32_t>(entries_.size());
+         ++index) {
+      if (entries_[index].list != kFree) {
+        Unlink(index);
+        Release(index);
+      }
+    }
+    size_ = 0;
+  }
+
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+ private:
+  static constexpr int kSlotBits = 6;
+  static constexpr int kSlots = 1 << kSlotBits;
+  static constexpr int kLevels = 5;
+  static constexpr int64_t kMaxTicksAhead = int64_t{1} << (kSlotBits * kLevels);
+  // Lists are the slots of each level, followed by the list of due timers.
+  static constexpr int kReadyList = kLevels * kSlots;
+  static constexpr int kFree = -1;
+  static constexpr int32_t kNone = -1;
+
+  struct Entry {
+    Timestamp due = Timestamp::MinusInfinity();
+    uint64_t sequence = 0;
+    uint32_t generation = 0;
+    // Index into `lists_`, or kFree.
+    int32_t list = kFree;
+    int32_t prev = kNone;
+    // Next entry in the same list, or in the free list.
+    int32_t next = kNone;
+    T value;
+  };
+
+  struct List {
+    int32_t head = kNone;
+    int32_t tail = kNone;
+  };
+
+  static TimerId MakeId(int32_t index, uint32_t generation) {
+    return (static_cast<uint64_t>(generation) << 32) |
+           static_cast<uint32_t>(index);
+  }
+
+  // The first tick at which a timer due at `due` may be reported.
+  int64_t DueTick(Timestamp due) const {
+    const int64_t us = (due - origin_).us();
+    return us <= 0 ? 0 : (us + resolution_us_ - 1) / resolution_us_;
+  }
+
+  Timestamp TickTime(int64_t tick) const {
+    return origin_ + TimeDelta::Micros(tick * resolution_us_);
+  }
+
+  int32_t Allocate() {
+    int32_t index = free_head_;
+    if (index == kNone) {
+      index = static_cast<int32_t>(entries_.size());
+      entries_.emplace_back();
+    } else {
+      free_head_ = entries_[index].next;
+    }
+    // Generation 0 is never used, so that no id equals kInvalidTimerId.
+    if (++entries_[index].generation == 0) {
+      entries_[index].generation = 1;
+    }
+    return index;
+  }
+
+  void Release(int32_t index) {
+    Entry& entry = entries_[index];
+    entry.value = T();
+    entry.list = kFree;
+    entry.prev = kNone;
+    entry.next = free_head_;
+    free_head_ = index;
+  }
+
+  // Puts an unlinked entry in the slot matching its due time, or in the
+  // ready list if it is already due.
+  void Place(int32_t index) {
+    Entry& entry = entries_[index];
+    const int64_t due_tick = DueTick(entry.due);
+    if (due_tick <= current_tick_) {
+      InsertReady(index);
+      return;
+    }
+    // Timers too far away are parked in the outermost slot that is in range
+    // and placed again when it is cascaded.
+    const int64_t tick =
+        std::min(due_tick, current_tick_ + kMaxTicksAhead - 1);
+    const int64_t delta = tick - current_tick_;
+    int level = 0;
+    while (delta >= (int64_t{1} << (kSlotBits * (level + 1)))) {
+      ++level;
+    }
+    const int slot = (tick >> (kSlotBits * level)) & (kSlots - 1);
+    Append(level * kSlots + slot, index);
+    occupied_[level] |= uint64_t{1} << slot;
+  }
+
+  // Inserts a due entry into the ready list, which is sorted by due time and
+  // then sequence.
+  void InsertReady(int32_t index) {
+    const Entry& entry = entries_[index];
+    int32_t after = lists_[kReadyList].tail;
+    while (after != kNone && !Before(entries_[after], entry)) {
+      after = entries_[after].prev;
+    }
+    InsertAfter(kReadyList, after, index);
+  }
+
+  static bool Before(const Entry& a, const Entry& b) {
+    return a.due < b.due || (a.due == b.due && a.sequence < b.sequence);
+  }
+
+  void Append(int list, int32_t index) {
+    InsertAfter(list, lists_[list].tail, index);
+  }
+
+  // Inserts `index` after `after` in `list`, or at the front if `after` is
+  // kNone.
+  void InsertAfter(int list, int32_t after, int32_t index) {
+    Entry& entry = entries_[index];
+    List& l = lists_[list];
+    entry.list = list;
+    entry.prev = after;
+    entry.next = after == kNone ? l.head : entries_[after].next;
+    if (entry.next == kNone) {
+      l.tail = index;
+    } else {
+      entries_[entry.next].prev = index;
+    }
+    if (after == kNone) {
+      l.head = index;
+    } else {
+      entries_[after].next = index;
+    }
+  }
+
+  void Unlink(int32_t index) {
+    Entry& entry = entries_[index];
+    List& l = lists_[entry.list];
+    if (entry.prev == kNone) {
+      l.head = entry.next;
+    } else {
+      entries_[entry.prev].next = entry.next;
+    }
+    if (entry.next == kNone) {
+      l.tail = entry.prev;
+    } else {
+      entries_[entry.next].prev = entry.prev;
+    }
+    if (l.head == kNone && entry.list != kReadyList) {
+      occupied_[entry.list / kSlots] &= ~(uint64_t{1} << (entry.list % kSlots));
+    }
+    entry.prev = kNone;
+    entry.next = kNone;
+  }
+
+  // Detaches all entries of a slot and returns the first of them, still
+  // linked through `next`.
+  int32_t TakeSlot(int level, int slot) {
+    List& l = lists_[level * kSlots + slot];
+    const int32_t head = l.head;
+    l = List();
+    occupied_[level] &= ~(uint64_t{1} << slot);
+    return head;
+  }
+
+  // The next tick at which a slot of any level needs to be processed.
+  int64_t NextEventTick() const {
+    int64_t next = current_tick_ + kMaxTicksAhead;
+    for (int level = 0; level < kLevels; ++level) {
+      if (occupied_[level] == 0) {
+        continue;
+      }
+      const int shift = kSlotBits * level;
+      const int64_t current = current_tick_ >> shift;
+      const int current_slot = current & (kSlots - 1);
+      // Slots after the current one come first, then the ones that wrapped
+      // around, including the current one.
+      const int rotate = (current_slot + 1) & (kSlots - 1);
+      const uint64_t rotated = absl::rotr(occupied_[level], rotate);
+      const int offset = absl::countr_zero(rotated) + 1;
+      next = std::min(next, (current + offset) << shift);
+    }
+    return next;
+  }
+
+  // Processes all ticks up to the one containing `now`.
+  void AdvanceTo(Timestamp now) {
+    if (now < TickTime(current_tick_)) {
+      Rebase(now);
+      return;
+    }
+    const int64_t target = (now - origin_).us() / resolution_us_;
+    while (current_tick_ < target) {
+      const int64_t next = NextEventTick();
+      if (next > target) {
+        current_tick_ = target;
+        break;
+      }
+      current_tick_ = next;
+      ProcessTick();
+    }
+  }
+
+  // Cascades the outer levels into the inner ones where the current tick
+  // starts a new slot, then moves the timers of the current innermost slot to
+  // the ready list.
+  void ProcessTick() {
+    int level = 1;
+    while (level < kLevels &&
+           (current_tick_ & ((int64_t{1} << (kSlotBits * level)) - 1)) == 0) {
+      ++level;
+    }
+    // Cascade from the outermost level affected, so that timers moved down
+    // can be moved further down by the inner levels.
+    for (int l = level - 1; l >= 1; --l) {
+      const int slot = (current_tick_ >> (kSlotBits * l)) & (kSlots - 1);
+      int32_t index = TakeSlot(l, slot);
+      while (index != kNone) {
+        const int32_t next = entries_[index].next;
+        entries_[index].prev = kNone;
+        entries_[index].next = kNone;
+        Place(index);
+        index = next;
+      }
+    }
+
+    int32_t index = TakeSlot(0, current_tick_ & (kSlots - 1));
+    if (index == kNone) {
+      return;
+    }
+    scratch_.clear();
+    while (index != kNone) {
+      scratch_.push_back(index);
+      index = entries_[index].next;
+    }
+    std::sort(scratch_.begin(), scratch_.end(), [this](int32_t a, int32_t b) {
+      return Before(entries_[a], entries_[b]);
+    });
+    for (int32_t i : scratch_) {
+      entries_[i].prev = kNone;
+      entries_[i].next = kNone;
+      InsertReady(i);
+    }
+  }
+
+  // Restarts the wheel at `now`, which is before the current tick. This
+  // happens when the clock is replaced, e.g. by a fake clock in tests.
+  void Rebase(Timestamp now) {
+    std::vector<int32_t> indices;
+    indices.reserve(size_);
+    for (int32_t index = 0; index < static_cast<int32_t>(entries_.size());
+         ++index) {
+      if (entries_[index].list != kFree) {
+        indices.push_back(index);
+      }
+    }
+    lists_.fill(List());
+    occupied_.fill(0);
+    origin_ = now;
+    current_tick_ = 0;
+    std::sort(indices.begin(), indices.end(), [this](int32_t a, int32_t b) {
+      return Before(entries_[a], entries_[b]);
+    });
+    for (int32_t index : indices) {
+      entries_[index].prev = kNone;
+      entries_[index].next = kNone;
+      Place(index);
+    }
+  }
+
+  const int64_t resolution_us_;
+  // Time of tick 0.
+  Timestamp origin_;
+  // All ticks up to and including this one have been processed.
+  int64_t current_tick_ = 0;
+  size_t size_ = 0;
+  uint64_t next_sequence_ = 0;
+  std::vector<Entry> entries_;
+  int32_t free_head_ = kNone;
+  std::array<List, kLevels * kSlots + 1> lists_;
+  // Bit i of `occupied_[level]` is set if slot i of the level is not empty.
+  std::array<uint64_t, kLevels> occupied_ = {};
+  std::vector<int32_t> scratch_;
+};
+
+}  // namespace webrtc
+
+#endif  // RTC_BASE_TIMER_WHEEL_H_
@@ -0,0 +1,107 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <cstdint>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "benchmark/benchmark.h"
+#include "rtc_base/random.h"
+#include "rtc_base/timer_wheel.h"
+
+namespace webrtc {
+namespace {
+
+constexpr TimeDelta kResolution = TimeDelta::Millis(1);
+constexpr Timestamp kStart = Timestamp::Seconds(1000);
+
+// Delays typical of RTCP, NACK, STUN and SCTP timers: mostly tens to hundreds
+// of milliseconds, with some of several seconds.
+TimeDelta RandomDelay(Random& random) {
+  return random.Rand(0, 9) == 0 ? TimeDelta::Millis(random.Rand(1000, 30'000))
+                                : TimeDelta::Millis(random.Rand(1, 500));
+}
+
+// The delayed task queue that TaskQueueStdlib used before the wheel, ordered
+// by due time and then posting order.
+class MapTimers {
+ public:
+  using TimerId = std::pair<Timestamp, uint64_t>;
+
+  TimerId Schedule(Timestamp due, int value) {
+    TimerId id(due, next_order_++);
+    timers_.emplace(id, value);
+    return id;
+  }
+  bool Cancel(TimerId id) { return timers_.erase(id) > 0; }
+  int* Front(Timestamp now) {
+    if (timers_.empty() || timers_.begin()->first.first > now) {
+      return nullptr;
+    }
+    return &timers_.begin()->second;
+  }
+  int PopFront() {
+    int value = timers_.begin()->second;
+    timers_.erase(timers_.begin());
+    return value;
+  }
+
+ private:
+  std::map<TimerId, int> timers_;
+  uint64_t next_order_ = 0;
+};
+
+class WheelTimers : public TimerWheel<int> {
+ public:
+  WheelTimers() : TimerWheel<int>(kResolution, kStart) {}
+};
+
+// Keeps `state.range(0)` timers scheduled while time advances one millisecond
+// per iteration. Each iteration reschedules the timers that expired and
+// cancels and reschedules one more, as a timer restarted on activity would be.
+template <typename Timers>
+void BM_ConcurrentTimers(benchmark::State& state) {
+  const int num_timers = state.range(0);
+  Random random(0x5eed);
+  Timers timers;
+  std::vector<typename Timers::TimerId> ids;
+  Timestamp now = kStart;
+  for (int i = 0; i < num_timers; ++i) {
+    ids.push_back(timers.Schedule(now + RandomDelay(random), i));
+  }
+
+  int64_t operations = 0;
+  for (auto _ : state) {
+    now += TimeDelta::Millis(1);
+    while (timers.Front(now)) {
+      const int i = timers.PopFront();
+      ids[i] = timers.Schedule(now + RandomDelay(random), i);
+      operations += 2;
+    }
+    const int i = random.Rand(0, num_timers - 1);
+    timers.Cancel(ids[i]);
+    ids[i] = timers.Schedule(now + RandomDelay(random), i);
+    operations += 2;
+  }
+  state.SetItemsProcessed(operations);
+}
+
+BENCHMARK_TEMPLATE(BM_ConcurrentTimers, MapTimers)
+    ->RangeMultiplier(10)
+    ->Range(1'000, 100'000);
+BENCHMARK_TEMPLATE(BM_ConcurrentTimers, WheelTimers)
+    ->RangeMultiplier(10)
+    ->Range(1'000, 100'000);
+
+}  // namespace
+}  // namespace webrtc
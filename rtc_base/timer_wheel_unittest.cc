@@ -0,0 +1,236 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/timer_wheel.h"
+
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "rtc_base/random.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::ElementsAre;
+
+constexpr TimeDelta kResolution = TimeDelta::Millis(1);
+constexpr Timestamp kStart = Timestamp::Seconds(1000);
+
+std::vector<int> PopAll(TimerWheel<int>& wheel, Timestamp now) {
+  std::vector<int> values;
+  while (wheel.Front(now)) {
+    values.push_back(wheel.PopFront());
+  }
+  return values;
+}
+
+TEST(TimerWheelTest, IsEmptyInitially) {
+  TimerWheel<int> wheel(kResolution, kStart);
+  EXPECT_TRUE(wheel.empty());
+  EXPECT_EQ(wheel.Front(kStart + TimeDelta::Seconds(1)), nullptr);
+  EXPECT_EQ(wheel.NextDueTime(), absl::nullopt);
+}
+
+TEST(TimerWheelTest, ReportsTimerOnlyWhenDue) {
+  TimerWheel<int> wheel(kResolution, kStart);
+  wheel.Schedule(kStart + TimeDelta::Millis(10), 1);
+
+  EXPECT_EQ(wheel.Front(kStart + TimeDelta::Millis(9)), nullptr);
+  ASSERT_NE(wheel.Front(kStart + TimeDelta::Millis(10)), nullptr);
+  EXPECT_EQ(wheel.PopFront(), 1);
+  EXPECT_TRUE(wheel.empty());
+}
+
+TEST(TimerWheelTest, NeverReportsTimerEarlyWithinTick) {
+  TimerWheel<int> wheel(kResolution, kStart);
+  wheel.Schedule(kStart + TimeDelta::Micros(10'500), 1);
+
+  EXPECT_EQ(wheel.Front(kStart + TimeDelta::Micros(10'499)), nullptr);
+  // Up to one tick late.
+  EXPECT_THAT(PopAll(wheel, kStart + TimeDelta::Millis(11)), ElementsAre(1));
+}
+
+TEST(TimerWheelTest, ReportsTimersInDueOrderThenScheduleOrder) {
+  TimerWheel<int> wheel(kResolution, kStart);
+  wheel.Schedule(kStart + TimeDelta::Millis(5'000), 1);
+  wheel.Schedule(kStart + TimeDelta::Micros(200), 2);
+  wheel.Schedule(kStart + TimeDelta::Micros(100), 3);
+  wheel.Schedule(kStart + TimeDelta::Millis(5'000), 4);
+  wheel.Schedule(kStart + TimeDelta::Millis(70), 5);
+
+  EXPECT_THAT(PopAll(wheel, kStart + TimeDelta::Seconds(10)),
+              ElementsAre(3, 2, 5, 1, 4));
+}
+
+TEST(TimerWheelTest, ReportsPastTimersRightAway) {
+  TimerWheel<int> wheel(kResolution, kStart);
+  EXPECT_EQ(wheel.Front(kStart + TimeDelta::Millis(100)), nullptr);
+  wheel.Schedule(kStart + TimeDelta::Millis(50), 1);
+  wheel.Schedule(kStart - TimeDelta::Millis(50), 2);
+
+  EXPECT_EQ(wheel.NextDueTime(), kStart - TimeDelta::Millis(50));
+  EXPECT_THAT(PopAll(wheel, kStart + TimeDelta::Millis(100)),
+              ElementsAre(2, 1));
+}
+
+TEST(TimerWheelTest, CancelsTimers) {
+  TimerWheel<int> wheel(kResolution, kStart);
+  auto id1 = wheel.Schedule(kStart + TimeDelta::Millis(10), 1);
+  auto id2 = wheel.Schedule(kStart + TimeDelta::Seconds(100), 2);
+  wheel.Schedule(kStart + TimeDelta::Millis(20), 3);
+
+  EXPECT_TRUE(wheel.Cancel(id1));
+  EXPECT_FALSE(wheel.Cancel(id1));
+  EXPECT_TRUE(wheel.Cancel(id2));
+  EXPECT_FALSE(wheel.Cancel(TimerWheel<int>::kInvalidTimerId));
+  EXPECT_EQ(wheel.size(), 1u);
+  EXPECT_THAT(PopAll(wheel, kStart + TimeDelta::Seconds(200)), ElementsAre(3));
+}
+
+TEST(TimerWheelTest, DoesNotCancelTimerReusingStorage) {
+  TimerWheel<int> wheel(kResolution, kStart);
+  auto id1 = wheel.Schedule(kStart + TimeDelta::Millis(10), 1);
+  EXPECT_TRUE(wheel.Cancel(id1));
+  auto id2 = wheel.Schedule(kStart + TimeDelta::Millis(10), 2);
+
+  EXPECT_NE(id1, id2);
+  EXPECT_FALSE(wheel.Cancel(id1));
+  EXPECT_EQ(wheel.size(), 1u);
+}
+
+TEST(TimerWheelTest, DestroysValuesWhenCancelled) {
+  TimerWheel<std::shared_ptr<int>> wheel(kResolution, kStart);
+  auto value = std::make_shared<int>(1);
+  std::weak_ptr<int> weak = value;
+  auto id = wheel.Schedule(kStart + TimeDelta::Millis(1), std::move(value));
+
+  EXPECT_FALSE(weak.expired());
+  wheel.Cancel(id);
+  EXPECT_TRUE(weak.expired());
+}
+
+TEST(TimerWheelTest, HandlesTimeGoingBackwards) {
+  TimerWheel<int> wheel(kResolution, kStart);
+  EXPECT_EQ(wheel.Front(kStart + TimeDelta::Seconds(10)), nullptr);
+  // As when a fake clock starting at zero is installed.
+  const Timestamp now = Timestamp::Zero();
+  wheel.Schedule(now + TimeDelta::Millis(20), 1);
+  wheel.Schedule(now + TimeDelta::Millis(10), 2);
+
+  EXPECT_EQ(wheel.Front(now), nullptr);
+  EXPECT_THAT(PopAll(wheel, now + TimeDelta::Millis(10)), ElementsAre(2));
+  EXPECT_THAT(PopAll(wheel, now + TimeDelta::Millis(20)), ElementsAre(1));
+}
+
+TEST(TimerWheelTest, ClearCancelsAllTimers) {
+  TimerWheel<int> wheel(kResolution, kStart);
+  auto id = wheel.Schedule(kStart + TimeDelta::Millis(10), 1);
+  wheel.Schedule(kStart - TimeDelta::Millis(10), 2);
+  wheel.Clear();
+
+  EXPECT_TRUE(wheel.empty());
+  EXPECT_FALSE(wheel.Cancel(id));
+  EXPECT_EQ(wheel.Front(kStart + TimeDelta::Seconds(1)), nullptr);
+}
+
+TEST(TimerWheelTest, HandlesTimersBeyondTheWheelRange) {
+  TimerWheel<int> wheel(kResolution, kStart);
+  const Timestamp far = kStart + TimeDelta::Seconds(30 * 24 * 3600);
+  wheel.Schedule(far, 1);
+  wheel.Schedule(kStart + TimeDelta::Seconds(1), 2);
+
+  EXPECT_THAT(PopAll(wheel, kStart + TimeDelta::Seconds(2)), ElementsAre(2));
+  EXPECT_THAT(PopAll(wheel, far - TimeDelta::Millis(1)), ElementsAre());
+  EXPECT_THAT(PopAll(wheel, far), ElementsAre(1));
+}
+
+TEST(TimerWheelTest, NextDueTimeIsNotAfterNextTimer) {
+  TimerWheel<int> wheel(kResolution, kStart);
+  const Timestamp due = kStart + TimeDelta::Millis(12'345);
+  wheel.Schedule(due, 1);
+
+  Timestamp now = kStart;
+  int wakeups = 0;
+  while (!wheel.Front(now)) {
+    absl::optional<Timestamp> next = wheel.NextDueTime();
+    ASSERT_TRUE(next);
+    ASSERT_LE(*next, due);
+    ASSERT_GT(*next, now);
+    now = *next;
+    ++wakeups;
+  }
+  EXPECT_EQ(now, due);
+  // One wakeup per level crossed, rather than one per tick.
+  EXPECT_LE(wakeups, 5);
+}
+
+// Compares the wheel with a simple reference over random operations.
+TEST(TimerWheelTest, MatchesReferenceImplementation) {
+  Random random(0x1234);
+  TimerWheel<int> wheel(kResolution, kStart);
+  std::map<std::pair<Timestamp, int>, TimerWheel<int>::TimerId> reference;
+  Timestamp now = kStart;
+  int next_value = 0;
+
+  for (int step = 0; step < 20000; ++step) {
+    switch (random.Rand(0, 3)) {
+      case 0:
+      case 1: {
+        // Mostly short timers, some long.
+        const uint32_t max_delay_us =
+            random.Rand(0, 9) == 0 ? 600'000'000 : 200'000;
+        const Timestamp due =
+            now + TimeDelta::Micros(random.Rand<uint32_t>() % max_delay_us);
+        const int value = next_value++;
+        reference[{due, value}] = wheel.Schedule(due, value);
+        break;
+      }
+      case 2: {
+        if (reference.empty()) {
+          break;
+        }
+        auto it = reference.begin();
+        std::advance(it, random.Rand<uint32_t>() % reference.size());
+        EXPECT_TRUE(wheel.Cancel(it->second));
+        reference.erase(it);
+        break;
+      }
+      case 3: {
+        now += TimeDelta::Micros(random.Rand(0, 5'000));
+        if (random.Rand(0, 99) == 0) {
+          now += TimeDelta::Seconds(random.Rand(0, 3'000));
+        }
+        // Everything due is reported at most one tick late.
+        while (int* value = wheel.Front(now)) {
+          ASSERT_FALSE(reference.empty());
+          const auto& [due, expected] = reference.begin()->first;
+          EXPECT_EQ(*value, expected);
+          EXPECT_LE(due, now);
+          reference.erase(reference.begin());
+          wheel.PopFront();
+        }
+        if (!reference.empty()) {
+          EXPECT_GT(reference.begin()->first.first, now - kResolution);
+        }
+        break;
+      }
+    }
+    ASSERT_EQ(wheel.size(), reference.size());
+  }
+}
+
+}  // namespace
+}  // namespace webrtc
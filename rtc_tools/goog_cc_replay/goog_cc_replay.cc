@@ -0,0 +1,197 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_tools/goog_cc_replay/goog_cc_replay.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/algorithm/container.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_split.h"
+#include "absl/strings/string_view.h"
+#include "api/array_view.h"
+#include "api/transport/goog_cc_factory.h"
+#include "api/transport/network_control.h"
+#include "api/units/data_rate.h"
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "logging/rtc_event_log/rtc_event_log_parser.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/platform_thread.h"
+#include "rtc_tools/rtc_event_log_visualizer/log_simulation.h"
+#include "test/explicit_key_value_config.h"
+
+namespace webrtc {
+namespace {
+
+struct HeldRate {
+  DataRate rate;
+  TimeDelta duration;
+};
+
+// `held_rates` must be sorted by rate.
+DataRate Percentile(const std::vector<HeldRate>& held_rates,
+                    TimeDelta total_duration,
+                    double fraction) {
+  const TimeDelta threshold = total_duration * fraction;
+  TimeDelta accumulated = TimeDelta::Zero();
+  for (const HeldRate& held : held_rates) {
+    accumulated += held.duration;
+    if (accumulated >= threshold && held.duration > TimeDelta::Zero()) {
+      return held.rate;
+    }
+  }
+  return held_rates.back().rate;
+}
+
+}  // namespace
+
+std::vector<std::string> ExpandFieldTrialSweep(absl::string_view field_trials) {
+  std::vector<std::string> expanded = {""};
+  size_t pos = 0;
+  while (pos < field_trials.size()) {
+    const size_t open = field_trials.find_first_of("{}", pos);
+    const absl::string_view literal = field_trials.substr(pos, open - pos);
+    for (std::string& prefix : expanded) {
+      prefix.append(literal.data(), literal.size());
+    }
+    if (open == absl::string_view::npos) {
+      break;
+    }
+    const size_t close = field_trials.find_first_of("{}", open + 1);
+    if (field_trials[open] != '{' || close == absl::string_view::npos ||
+        field_trials[close] != '}') {
+      return {};
+    }
+    const std::vector<absl::string_view> alternatives =
+        absl::StrSplit(field_trials.substr(open + 1, close - open - 1), '|');
+    std::vector<std::string> next;
+    next.reserve(expanded.size() * alternatives.size());
+    for (const std::string& prefix : expanded) {
+      for (absl::string_view alternative : alternatives) {
+        next.push_back(absl::StrCat(prefix, alternative));
+      }
+    }
+    expanded = std::move(next);
+    pos = close + 1;
+  }
+  return expanded;
+}
+
+TargetRateSummary SummarizeTargetRates(
+    rtc::ArrayView<const TargetRateSample> target_rates,
+    Timestamp end_time) {
+  TargetRateSummary summary;
+  if (target_rates.empty()) {
+    return summary;
+  }
+  summary.min = target_rates[0].target_rate;
+  summary.max = target_rates[0].target_rate;
+
+  std::vector<HeldRate> held_rates;
+  held_rates.reserve(target_rates.size());
+  TimeDelta total_duration = TimeDelta::Zero();
+  // Bits sent at the target rate, as a double to not overflow on long logs.
+  double total_bits = 0;
+  for (size_t i = 0; i < target_rates.size(); ++i) {
+    const TargetRateSample& sample = target_rates[i];
+    if (i > 0) {
+      ++summary.num_changes;
+      if (sample.target_rate < target_rates[i - 1].target_rate) {
+        ++summary.num_decreases;
+      }
+    }
+    summary.min = std::min(summary.min, sample.target_rate);
+    summary.max = std::max(summary.max, sample.target_rate);
+
+    const Timestamp held_until = i + 1 < target_rates.size()
+                                     ? target_rates[i + 1].at_time
+                                     : std::max(end_time, sample.at_time);
+    const TimeDelta duration = held_until - sample.at_time;
+    held_rates.push_back({sample.target_rate, duration});
+    total_duration += duration;
+    total_bits += sample.target_rate.bps<double>() * duration.seconds<double>();
+  }
+
+  if (total_duration <= TimeDelta::Zero()) {
+    const DataRate last = target_rates[target_rates.size() - 1].target_rate;
+    summary.mean = last;
+    summary.p5 = last;
+    summary.p50 = last;
+    summary.p95 = last;
+    return summary;
+  }
+  summary.mean =
+      DataRate::BitsPerSec(total_bits / total_duration.seconds<double>());
+  absl::c_sort(held_rates, [](const HeldRate& a, const HeldRate& b) {
+    return a.rate < b.rate;
+  });
+  summary.p5 = Percentile(held_rates, total_duration, 0.05);
+  summary.p50 = Percentile(held_rates, total_duration, 0.5);
+  summary.p95 = Percentile(held_rates, total_duration, 0.95);
+  return summary;
+}
+
+GoogCcReplayResult ReplayGoogCc(const ParsedRtcEventLog& parsed_log,
+                                absl::string_view field_trials) {
+  GoogCcReplayResult result;
+  result.field_trials = std::string(field_trials);
+  test::ExplicitKeyValueConfig field_trials_config(field_trials);
+  LogBasedNetworkControllerSimulation simulation(
+      std::make_unique<GoogCcNetworkControllerFactory>(),
+      [&](const NetworkControlUpdate& update, Timestamp at_time) {
+        if (!update.target_rate) {
+          return;
+        }
+        const DataRate target_rate = update.target_rate->target_rate;
+        if (result.target_rates.empty() ||
+            result.target_rates.back().target_rate != target_rate) {
+          result.target_rates.push_back({at_time, target_rate});
+        }
+      },
+      &field_trials_config);
+  simulation.ProcessEventsInLog(parsed_log);
+  result.summary =
+      SummarizeTargetRates(result.target_rates, parsed_log.last_timestamp());
+  return result;
+}
+
+std::vector<GoogCcReplayResult> ReplayGoogCcSweep(
+    const ParsedRtcEventLog& parsed_log,
+    const std::vector<std::string>& field_trials,
+    int num_threads) {
+  RTC_DCHECK_GT(num_threads, 0);
+  std::vector<GoogCcReplayResult> results(field_trials.size());
+  // Each simulation owns its controller and field trials, and only reads the
+  // parsed log, so the threads share nothing but the next index.
+  std::atomic<size_t> next_index(0);
+  auto replay = [&] {
+    for (size_t i = next_index++; i < field_trials.size(); i = next_index++) {
+      results[i] = ReplayGoogCc(parsed_log, field_trials[i]);
+    }
+  };
+  std::vector<rtc::PlatformThread> threads;
+  const size_t max_threads = std::max<size_t>(field_trials.size(), 1);
+  for (size_t i = 0; i < std::min<size_t>(num_threads, max_threads); ++i) {
+    threads.push_back(
+        rtc::PlatformThread::SpawnJoinable(replay, "GoogCcReplay"));
+  }
+  for (rtc::PlatformThread& thread : threads) {
+    thread.Finalize();
+  }
+  return results;
+}
+
+}  // namespace webrtc
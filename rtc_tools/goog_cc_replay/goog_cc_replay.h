@@ -0,0 +1,75 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_TOOLS_GOOG_CC_REPLAY_GOOG_CC_REPLAY_H_
+#define RTC_TOOLS_GOOG_CC_REPLAY_GOOG_CC_REPLAY_H_
+
+#include <string>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "api/array_view.h"
+#include "api/units/data_rate.h"
+#include "api/units/timestamp.h"
+#include "logging/rtc_event_log/rtc_event_log_parser.h"
+
+namespace webrtc {
+
+struct TargetRateSample {
+  Timestamp at_time = Timestamp::MinusInfinity();
+  DataRate target_rate = DataRate::Zero();
+};
+
+// Summary of a target rate trace. Rates are weighted by the time they were
+// held, from the first sample to the end of the log.
+struct TargetRateSummary {
+  // Changes after the first target rate.
+  int num_changes = 0;
+  int num_decreases = 0;
+  DataRate mean = DataRate::Zero();
+  DataRate min = DataRate::Zero();
+  DataRate p5 = DataRate::Zero();
+  DataRate p50 = DataRate::Zero();
+  DataRate p95 = DataRate::Zero();
+  DataRate max = DataRate::Zero();
+};
+
+struct GoogCcReplayResult {
+  std::string field_trials;
+  // The target rate each time it changed.
+  std::vector<TargetRateSample> target_rates;
+  TargetRateSummary summary;
+};
+
+// Expands every `{a|b|...}` group in `field_trials` to each of its
+// alternatives, and returns one field trial string per combination. E.g.
+// "Foo/x:{1|2},y:{3|4}/" gives "Foo/x:1,y:3/", "Foo/x:1,y:4/", "Foo/x:2,y:3/"
+// and "Foo/x:2,y:4/". Returns an empty vector if the braces are unbalanced.
+std::vector<std::string> ExpandFieldTrialSweep(absl::string_view field_trials);
+
+TargetRateSummary SummarizeTargetRates(
+    rtc::ArrayView<const TargetRateSample> target_rates,
+    Timestamp end_time);
+
+// Feeds the packets sent and the feedback received in `parsed_log` to a new
+// GoogCcNetworkController using `field_trials`, and records its target rate.
+GoogCcReplayResult ReplayGoogCc(const ParsedRtcEventLog& parsed_log,
+                                absl::string_view field_trials);
+
+// Replays `parsed_log` once per entry of `field_trials`, on `num_threads`
+// threads. Results are in the order of `field_trials`.
+std::vector<GoogCcReplayResult> ReplayGoogCcSweep(
+    const ParsedRtcEventLog& parsed_log,
+    const std::vector<std::string>& field_trials,
+    int num_threads);
+
+}  // namespace webrtc
+
+#endif  // RTC_TOOLS_GOOG_CC_REPLAY_GOOG_CC_REPLAY_H_
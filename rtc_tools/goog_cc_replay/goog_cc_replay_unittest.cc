@@ -0,0 +1,134 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_tools/goog_cc_replay/goog_cc_replay.h"
+
+#include <string>
+#include <vector>
+
+#include "api/units/data_rate.h"
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "logging/rtc_event_log/rtc_event_log_parser.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+#include "test/testsupport/file_utils.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+using ::testing::SizeIs;
+
+constexpr Timestamp kStartTime = Timestamp::Seconds(100);
+
+TEST(ExpandFieldTrialSweepTest, KeepsStringWithoutGroups) {
+  EXPECT_THAT(ExpandFieldTrialSweep("Foo/Enabled:true/"),
+              ElementsAre("Foo/Enabled:true/"));
+  EXPECT_THAT(ExpandFieldTrialSweep(""), ElementsAre(""));
+}
+
+TEST(ExpandFieldTrialSweepTest, ExpandsEveryCombination) {
+  EXPECT_THAT(ExpandFieldTrialSweep("Foo/x:{1|2},y:{3|4}/Bar/{a|b}/"),
+              ElementsAre("Foo/x:1,y:3/Bar/a/", "Foo/x:1,y:3/Bar/b/",
+                          "Foo/x:1,y:4/Bar/a/", "Foo/x:1,y:4/Bar/b/",
+                          "Foo/x:2,y:3/Bar/a/", "Foo/x:2,y:3/Bar/b/",
+                          "Foo/x:2,y:4/Bar/a/", "Foo/x:2,y:4/Bar/b/"));
+}
+
+TEST(ExpandFieldTrialSweepTest, FailsOnUnbalancedBraces) {
+  EXPECT_THAT(ExpandFieldTrialSweep("Foo/x:{1|2/"), IsEmpty());
+  EXPECT_THAT(ExpandFieldTrialSweep("Foo/x:1|2}/"), IsEmpty());
+  EXPECT_THAT(ExpandFieldTrialSweep("Foo/x:{{1|2}}/"), IsEmpty());
+}
+
+TEST(SummarizeTargetRatesTest, WeighsRatesByTimeHeld) {
+  const std::vector<TargetRateSample> target_rates = {
+      {kStartTime, DataRate::KilobitsPerSec(300)},
+      {kStartTime + TimeDelta::Seconds(1), DataRate::KilobitsPerSec(1000)},
+      {kStartTime + TimeDelta::Seconds(9), DataRate::KilobitsPerSec(500)}};
+  TargetRateSummary summary =
+      SummarizeTargetRates(target_rates, kStartTime + TimeDelta::Seconds(10));
+
+  EXPECT_EQ(summary.num_changes, 2);
+  EXPECT_EQ(summary.num_decreases, 1);
+  // (300 * 1 + 1000 * 8 + 500 * 1) / 10.
+  EXPECT_EQ(summary.mean, DataRate::KilobitsPerSec(880));
+  EXPECT_EQ(summary.min, DataRate::KilobitsPerSec(300));
+  EXPECT_EQ(summary.p5, DataRate::KilobitsPerSec(300));
+  EXPECT_EQ(summary.p50, DataRate::KilobitsPerSec(1000));
+  EXPECT_EQ(summary.p95, DataRate::KilobitsPerSec(1000));
+  EXPECT_EQ(summary.max, DataRate::KilobitsPerSec(1000));
+}
+
+TEST(SummarizeTargetRatesTest, HandlesTraceEndingAtEndOfLog) {
+  const std::vector<TargetRateSample> target_rates = {
+      {kStartTime, DataRate::KilobitsPerSec(300)}};
+  TargetRateSummary summary = SummarizeTargetRates(target_rates, kStartTime);
+  EXPECT_EQ(summary.num_changes, 0);
+  EXPECT_EQ(summary.mean, DataRate::KilobitsPerSec(300));
+  EXPECT_EQ(summary.p50, DataRate::KilobitsPerSec(300));
+
+  summary = SummarizeTargetRates({}, kStartTime);
+  EXPECT_EQ(summary.num_changes, 0);
+  EXPECT_EQ(summary.mean, DataRate::Zero());
+}
+
+class GoogCcReplayTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    ASSERT_TRUE(parsed_log_
+                    .ParseFile(test::ResourcePath(
+                        "rtc_event_log/rtc_event_log_500kbps", "binarypb"))
+                    .ok());
+  }
+
+  ParsedRtcEventLog parsed_log_;
+};
+
+TEST_F(GoogCcReplayTest, RecordsTargetRateChanges) {
+  GoogCcReplayResult result = ReplayGoogCc(parsed_log_, "");
+  ASSERT_THAT(result.target_rates, SizeIs(::testing::Gt(1u)));
+  for (size_t i = 1; i < result.target_rates.size(); ++i) {
+    EXPECT_GE(result.target_rates[i].at_time,
+              result.target_rates[i - 1].at_time);
+    EXPECT_NE(result.target_rates[i].target_rate,
+              result.target_rates[i - 1].target_rate);
+  }
+  EXPECT_EQ(result.summary.num_changes,
+            static_cast<int>(result.target_rates.size()) - 1);
+  EXPECT_GT(result.summary.mean, DataRate::Zero());
+}
+
+TEST_F(GoogCcReplayTest, SweepMatchesSequentialReplays) {
+  const std::vector<std::string> field_trials = ExpandFieldTrialSweep(
+      "WebRTC-Bwe-LossBasedBweV2/Enabled:{true|false}/"
+      "WebRTC-Bwe-ProbingConfiguration/alr_scale:{1.5|3}/");
+  ASSERT_THAT(field_trials, SizeIs(4));
+
+  std::vector<GoogCcReplayResult> results =
+      ReplayGoogCcSweep(parsed_log_, field_trials, /*num_threads=*/3);
+  ASSERT_THAT(results, SizeIs(field_trials.size()));
+  for (size_t i = 0; i < field_trials.size(); ++i) {
+    GoogCcReplayResult expected = ReplayGoogCc(parsed_log_, field_trials[i]);
+    EXPECT_EQ(results[i].field_trials, field_trials[i]);
+    ASSERT_EQ(results[i].target_rates.size(), expected.target_rates.size());
+    for (size_t j = 0; j < expected.target_rates.size(); ++j) {
+      EXPECT_EQ(results[i].target_rates[j].at_time,
+                expected.target_rates[j].at_time);
+      EXPECT_EQ(results[i].target_rates[j].target_rate,
+                expected.target_rates[j].target_rate);
+    }
+  }
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -0,0 +1,178 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "absl/flags/flag.h"
+#include "absl/flags/parse.h"
+#include "absl/flags/usage.h"
+#include "absl/strings/str_cat.h"
+#include "logging/rtc_event_log/rtc_event_log_parser.h"
+#include "rtc_base/logging.h"
+#include "rtc_tools/goog_cc_replay/goog_cc_replay.h"
+#include "system_wrappers/include/cpu_info.h"
+
+ABSL_FLAG(std::string,
+          field_trials,
+          "",
+          "Field trials used by every configuration, e.g. "
+          "WebRTC-Bwe-LossBasedBweV2/Enabled:true/.");
+ABSL_FLAG(std::string,
+          sweep,
+          "",
+          "Field trials to sweep. Every {a|b|...} group is expanded to each of "
+          "its alternatives, and every combination is replayed, e.g. "
+          "WebRTC-Bwe-ProbingConfiguration/alr_scale:{1.5|2|3}/.");
+ABSL_FLAG(std::string,
+          sweep_file,
+          "",
+          "File with one field trial string to sweep per line, expanded like "
+          "--sweep.");
+ABSL_FLAG(int,
+          threads,
+          0,
+          "Number of configurations replayed in parallel. 0 uses all cores.");
+ABSL_FLAG(std::string,
+          trace_dir,
+          "",
+          "If set, the target rate trace of every replay is written to "
+          "<trace_dir>/<log index>_<config index>.csv.");
+
+namespace {
+
+bool AddSweep(const std::string& base,
+              const std::string& sweep,
+              std::vector<std::string>* configs) {
+  std::vector<std::string> expanded = webrtc::ExpandFieldTrialSweep(sweep);
+  if (expanded.empty()) {
+    std::cerr << "Unbalanced braces in \"" << sweep << "\"" << std::endl;
+    return false;
+  }
+  for (const std::string& field_trials : expanded) {
+    configs->push_back(base + field_trials);
+  }
+  return true;
+}
+
+bool WriteTrace(const std::string& filename,
+                const webrtc::ParsedRtcEventLog& parsed_log,
+                const webrtc::GoogCcReplayResult& result) {
+  std::ofstream trace(filename);
+  if (!trace) {
+    std::cerr << "Failed to open " << filename << std::endl;
+    return false;
+  }
+  trace << "time_s,target_rate_bps\n";
+  for (const webrtc::TargetRateSample& sample : result.target_rates) {
+    trace << (sample.at_time - parsed_log.first_timestamp()).seconds<double>()
+          << "," << sample.target_rate.bps() << "\n";
+  }
+  return true;
+}
+
+}  // namespace
+
+// Replays the sent packets and the received feedback of RTC event logs
+// through GoogCcNetworkController, once per field trial configuration, and
+// prints summary metrics of the simulated target rate as CSV.
+int main(int argc, char* argv[]) {
+  absl::SetProgramUsageMessage(
+      "A tool for replaying WebRTC event logs through GoogCC with different\n"
+      "field trials. Prints one CSV line of target rate metrics per log and\n"
+      "configuration.\n"
+      "\n"
+      "Example usage:\n"
+      "./goog_cc_replay --sweep=\"WebRTC-Bwe-LossBasedBweV2/Enabled:true,"
+      "BwRampupUpperBoundFactor:{1.1|1.5|2}/\" <logfile> [<logfile> ...]\n");
+  std::vector<char*> args = absl::ParseCommandLine(argc, argv);
+  if (args.size() < 2) {
+    std::cerr << absl::ProgramUsageMessage();
+    return 1;
+  }
+
+  // Print RTC_LOG warnings and errors even in release builds.
+  if (rtc::LogMessage::GetLogToDebug() > rtc::LS_WARNING) {
+    rtc::LogMessage::LogToDebug(rtc::LS_WARNING);
+  }
+  rtc::LogMessage::SetLogToStderr(true);
+
+  const std::string base = absl::GetFlag(FLAGS_field_trials);
+  std::vector<std::string> configs;
+  if (!absl::GetFlag(FLAGS_sweep).empty() &&
+      !AddSweep(base, absl::GetFlag(FLAGS_sweep), &configs)) {
+    return 1;
+  }
+  if (!absl::GetFlag(FLAGS_sweep_file).empty()) {
+    std::ifstream sweep_file(absl::GetFlag(FLAGS_sweep_file));
+    if (!sweep_file) {
+      std::cerr << "Failed to open " << absl::GetFlag(FLAGS_sweep_file)
+                << std::endl;
+      return 1;
+    }
+    std::string line;
+    while (std::getline(sweep_file, line)) {
+      if (!line.empty() && !AddSweep(base, line, &configs)) {
+        return 1;
+      }
+    }
+  }
+  if (configs.empty()) {
+    configs.push_back(base);
+  }
+
+  int num_threads = absl::GetFlag(FLAGS_threads);
+  if (num_threads <= 0) {
+    num_threads = webrtc::CpuInfo::DetectNumberOfCores();
+  }
+  const std::string trace_dir = absl::GetFlag(FLAGS_trace_dir);
+
+  std::cout << "log,config,field_trials,changes,decreases,mean_kbps,min_kbps,"
+               "p5_kbps,p50_kbps,p95_kbps,max_kbps"
+            << std::endl;
+  for (size_t log_index = 1; log_index < args.size(); ++log_index) {
+    const std::string filename = args[log_index];
+    webrtc::ParsedRtcEventLog parsed_log(
+        webrtc::ParsedRtcEventLog::UnconfiguredHeaderExtensions::
+            kAttemptWebrtcDefaultConfig,
+        /*allow_incomplete_logs*/ true);
+    auto status = parsed_log.ParseFile(filename);
+    if (!status.ok()) {
+      std::cerr << "Failed to parse " << filename << ": " << status.message()
+                << std::endl;
+      return 1;
+    }
+
+    std::vector<webrtc::GoogCcReplayResult> results =
+        webrtc::ReplayGoogCcSweep(parsed_log, configs, num_threads);
+    for (size_t config_index = 0; config_index < results.size();
+         ++config_index) {
+      const webrtc::GoogCcReplayResult& result = results[config_index];
+      const webrtc::TargetRateSummary& summary = result.summary;
+      std::cout << filename << "," << config_index << ",\""
+                << result.field_trials << "\"," << summary.num_changes << ","
+                << summary.num_decreases << "," << summary.mean.kbps<double>()
+                << "," << summary.min.kbps<double>() << ","
+                << summary.p5.kbps<double>() << ","
+                << summary.p50.kbps<double>() << ","
+                << summary.p95.kbps<double>() << ","
+                << summary.max.kbps<double>() << std::endl;
+      if (!trace_dir.empty() &&
+          !WriteTrace(absl::StrCat(trace_dir, "/", log_index - 1, "_",
+                                   config_index, ".csv"),
+                      parsed_log, result)) {
+        return 1;
+      }
+    }
+  }
+  return 0;
+}
@@ -16,6 +16,7 @@
 #include <utility>
 
 #include "api/environment/environment_factory.h"
+#include "api/field_trials_view.h"
 #include "api/transport/network_control.h"
 #include "api/transport/network_types.h"
 #include "api/units/data_rate.h"
@@ -35,8 +36,11 @@ namespace webrtc {
 
 LogBasedNetworkControllerSimulation::LogBasedNetworkControllerSimulation(
     std::unique_ptr<NetworkControllerFactoryInterface> factory,
-    std::function<void(const NetworkControlUpdate&, Timestamp)> update_handler)
-    : update_handler_(update_handler), factory_(std::move(factory)) {}
+    std::function<void(const NetworkControlUpdate&, Timestamp)> update_handler,
+    const FieldTrialsView* field_trials)
+    : update_handler_(update_handler),
+      field_trials_(field_trials),
+      factory_(std::move(factory)) {}
 
 LogBasedNetworkControllerSimulation::~LogBasedNetworkControllerSimulation() {}
 
@@ -47,7 +51,8 @@ void LogBasedNetworkControllerSimulation::HandleStateUpdate(
 
 void LogBasedNetworkControllerSimulation::ProcessUntil(Timestamp to_time) {
   if (last_process_.IsInfinite()) {
-    NetworkControllerConfig config(CreateEnvironment(&null_event_log_));
+    NetworkControllerConfig config(
+        CreateEnvironment(&null_event_log_, field_trials_));
     config.constraints.at_time = to_time;
     config.constraints.min_data_rate = DataRate::KilobitsPerSec(30);
     config.constraints.starting_rate = DataRate::KilobitsPerSec(300);
@@ -17,6 +17,7 @@
 #include <map>
 #include <memory>
 
+#include "api/field_trials_view.h"
 #include "api/rtc_event_log/rtc_event_log.h"
 #include "api/transport/network_control.h"
 #include "api/transport/network_types.h"
@@ -32,10 +33,13 @@ namespace webrtc {
 
 class LogBasedNetworkControllerSimulation {
  public:
+  // The controller reads `field_trials`, if set, instead of the global field
+  // trials. It must outlive the simulation.
   explicit LogBasedNetworkControllerSimulation(
       std::unique_ptr<NetworkControllerFactoryInterface> factory,
       std::function<void(const NetworkControlUpdate&, Timestamp)>
-          update_handler);
+          update_handler,
+      const FieldTrialsView* field_trials = nullptr);
   ~LogBasedNetworkControllerSimulation();
   void ProcessEventsInLog(const ParsedRtcEventLog& parsed_log_);
 
@@ -57,6 +61,7 @@ class LogBasedNetworkControllerSimulation {
 
   const std::function<void(const NetworkControlUpdate&, Timestamp)>
       update_handler_;
+  const FieldTrialsView* const field_trials_;
   std::unique_ptr<NetworkControllerFactoryInterface> factory_;
   std::unique_ptr<NetworkControllerInterface> controller_;
 
@@ -27,6 +27,7 @@ SimulatedNetwork::Config CreateSimulationConfig(
   SimulatedNetwork::Config sim_config;
   sim_config.link_capacity = config.bandwidth;
   sim_config.loss_percent = config.loss_rate * 100;
+  sim_config.avg_burst_loss_length = config.avg_burst_loss_length.value_or(-1);
   sim_config.queue_delay_ms = config.delay.ms();
   sim_config.delay_standard_deviation_ms = config.delay_std_dev.ms();
   sim_config.packet_overhead = config.packet_overhead.bytes<int>();
@@ -221,6 +221,8 @@ struct NetworkSimulationConfig {
   TimeDelta delay = TimeDelta::Zero();
   TimeDelta delay_std_dev = TimeDelta::Zero();
   double loss_rate = 0;
+  // If set, packets are lost in bursts of this average length.
+  absl::optional<int> avg_burst_loss_length;
   absl::optional<int> packet_queue_length_limit;
   DataSize packet_overhead = DataSize::Zero();
 };
@@ -572,13 +572,15 @@ ReceiveVideoStream::ReceiveVideoStream(CallClient* receiver,
       FlexfecReceiveStream::Config flexfec(feedback_transport);
       flexfec.payload_type = VideoTestConstants::kFlexfecPayloadType;
       flexfec.rtp.remote_ssrc = VideoTestConstants::kFlexfecSendSsrc;
-      flexfec.protected_media_ssrcs = send_stream->rtx_ssrcs_;
+      flexfec.protected_media_ssrcs = {send_stream->ssrcs_[i]};
       flexfec.rtp.local_ssrc = recv_config.rtp.local_ssrc;
       receiver_->ssrc_media_types_[flexfec.rtp.remote_ssrc] = MediaType::VIDEO;
 
       receiver_->SendTask([this, &flexfec] {
         flecfec_stream_ = receiver_->call_->CreateFlexfecReceiveStream(flexfec);
       });
+      // Media packets must reach the FlexFEC receiver for it to recover any.
+      recv_config.rtp.packet_sink_ = flecfec_stream_;
     }
     receiver_->ssrc_media_types_[recv_config.rtp.remote_ssrc] =
         MediaType::VIDEO;
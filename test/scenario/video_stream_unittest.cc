@@ -11,9 +11,11 @@
 
 #include "api/test/network_emulation/create_cross_traffic.h"
 #include "api/test/network_emulation/cross_traffic.h"
+#include "modules/video_coding/adaptive_fec_controller.h"
 #include "test/field_trial.h"
 #include "test/gtest.h"
 #include "test/scenario/scenario.h"
+#include "test/scenario/stats_collection.h"
 
 namespace webrtc {
 namespace test {
@@ -179,6 +181,72 @@ TEST(VideoStreamTest, SendsFecWithFlexFec) {
   EXPECT_GT(video_stats.substreams.begin()->second.rtp_stats.fec.packets, 0u);
 }
 
+TEST(VideoStreamTest, AdaptiveFecControllerReducesFreezesOnBurstyLoss) {
+  // Tolerance for matching the FEC overhead of the default controller, given
+  // as a share of all sent bytes.
+  constexpr double kFecOverheadTolerance = 0.01;
+
+  struct Result {
+    TimeDelta freeze_time = TimeDelta::Zero();
+    int lost_frames = 0;
+    double fec_overhead = 0;
+  };
+  // Runs the same bursty loss route with the given FEC controller, or with
+  // FecControllerDefault if `fec_controller_factory` is null.
+  auto run = [](FecControllerFactoryInterface* fec_controller_factory) {
+    VideoQualityAnalyzer analyzer;
+    VideoSendStream::Stats video_stats;
+    {
+      Scenario s;
+      auto route = s.CreateRoutes(
+          s.CreateClient("caller", CallClientConfig()),
+          {s.CreateSimulationNode([](NetworkSimulationConfig* c) {
+            c->loss_rate = 0.05;
+            c->avg_burst_loss_length = 3;
+            c->delay = TimeDelta::Millis(100);
+          })},
+          s.CreateClient("callee", CallClientConfig()),
+          {s.CreateSimulationNode(NetworkSimulationConfig())});
+      auto video =
+          s.CreateVideoStream(route->forward(), [&](VideoStreamConfig* c) {
+            c->hooks.frame_pair_handlers = {analyzer.Handler()};
+            c->stream.use_flexfec = true;
+            c->stream.fec_controller_factory = fec_controller_factory;
+          });
+      s.RunFor(TimeDelta::Seconds(120));
+      route->first()->SendTask(
+          [&]() { video_stats = video->send()->GetStats(); });
+    }
+    Result result;
+    SampleStats<TimeDelta>& freezes = analyzer.stats().freeze_duration;
+    if (!freezes.IsEmpty()) {
+      result.freeze_time = freezes.Mean() * freezes.Count();
+    }
+    result.lost_frames = analyzer.stats().lost_count;
+    size_t fec_bytes = 0;
+    size_t total_bytes = 0;
+    for (const auto& [ssrc, substream] : video_stats.substreams) {
+      fec_bytes += substream.rtp_stats.fec.TotalBytes();
+      total_bytes += substream.rtp_stats.transmitted.TotalBytes();
+    }
+    EXPECT_GT(fec_bytes, 0u);
+    if (total_bytes > 0) {
+      result.fec_overhead = static_cast<double>(fec_bytes) / total_bytes;
+    }
+    return result;
+  };
+
+  Result default_result = run(nullptr);
+  AdaptiveFecControllerFactory adaptive_factory;
+  Result adaptive_result = run(&adaptive_factory);
+
+  EXPECT_LT(adaptive_result.freeze_time, default_result.freeze_time)
+      << "Lost frames: " << adaptive_result.lost_frames << " vs "
+      << default_result.lost_frames;
+  EXPECT_LE(adaptive_result.fec_overhead,
+            default_result.fec_overhead + kFecOverheadTolerance);
+}
+
 TEST(VideoStreamTest, ResolutionAdaptsToAvailableBandwidth) {
   // Declared before scenario to avoid use after free.
   std::atomic<size_t> num_qvga_frames_(0);